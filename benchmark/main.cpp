@@ -1,5 +1,6 @@
 #include <cmath>
 #include <cstdio>
+#include <cstdlib>
 #include <memory>
 #include "src/CCbenchmark.h"
 #include "src/MGEbenchmark.h"
@@ -12,10 +13,20 @@ int main(int argc, char** argv) {
         fprintf(stderr, "benchmarker <input_model> [options] ... \n");
         fprintf(stderr,
                 "tips:\n\t you can use --profile and --mge to profile model "
-                "and enable megengine framework (\"megcc\" is default)\n");
+                "and enable megengine framework (\"megcc\" is default)\n"
+                "\t --warmup <n> and --iter <n> set the warmup and timed "
+                "iterations, --json <file> dumps the latency distribution, cold "
+                "start and memory usage of megcc to file\n"
+                "\t --compare <mge_model> profiles the tiny model and the megengine "
+                "model per layer into megcc_profile.json and mge_profile.json, "
+                "compare them with tools/layer_compare.py\n");
         return -1;
     }
     int log_level = 3;
+    int warmup = 10;
+    int number = 50;
+    std::string json_path;
+    std::string mge_model_path;
     std::string framework = "megcc";
     std::string model_path = argv[1];
     int idx = 2;
@@ -25,6 +36,15 @@ int main(int argc, char** argv) {
             log_level = 0;
         } else if (args == "--mge") {
             framework = "mge";
+        } else if (args == "--warmup" && idx + 1 < argc) {
+            warmup = atoi(argv[++idx]);
+        } else if (args == "--iter" && idx + 1 < argc) {
+            number = atoi(argv[++idx]);
+        } else if (args == "--json" && idx + 1 < argc) {
+            json_path = argv[++idx];
+        } else if (args == "--compare" && idx + 1 < argc) {
+            framework = "compare";
+            mge_model_path = argv[++idx];
         } else {
             fprintf(stderr, "invalid option: %s\n", argv[idx]);
         }
@@ -32,11 +52,18 @@ int main(int argc, char** argv) {
     }
     std::vector<std::shared_ptr<Benchmarker>> benchmarkers;
     if (framework == "megcc") {
-        benchmarkers.push_back(std::make_shared<CCBenchmarker>(model_path, log_level));
+        benchmarkers.push_back(std::make_shared<CCBenchmarker>(
+                model_path, log_level, warmup, number, json_path));
     }
 #if ENABLE_MEGENGINE_FRAMEWORK
     else if (framework == "mge") {
         benchmarkers.push_back(std::make_shared<MGEBenchmarker>(model_path, log_level));
+    } else if (framework == "compare") {
+        //! both run with kernel profile, the layers are aligned by operator name
+        benchmarkers.push_back(std::make_shared<CCBenchmarker>(
+                model_path, 0, warmup, number, json_path, "megcc_profile.json"));
+        benchmarkers.push_back(std::make_shared<MGEBenchmarker>(
+                mge_model_path, 0, "mge_profile.json"));
     }
 #endif
     else {
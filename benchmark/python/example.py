@@ -4,7 +4,9 @@ import os
 import numpy as np
 import yaml
 from common import *
-from src.benchmark import BenchMarkRunnerBase, ValidModel, ValidOutputDir
+from src.benchmark import (BenchMarkRunnerBase, ValidModel, ValidOutputDir,
+                           aggregate_results, check_regression,
+                           save_baseline)
 from src.models import *
 import logging
 
@@ -44,6 +46,8 @@ class BenchmarkRunner(BenchMarkRunnerBase):
         run_options = ""
         if self.log_level == 0:
             run_options += " --profile"
+        if self.need_json_result():
+            run_options += " --json {}".format(self.json_result_name())
         config_name = "benchmark-{}-{}-{}".format(self.benchmark_framework,
                                                   self.benchmark_arch,
                                                   self.model.name)
@@ -58,6 +62,13 @@ class BenchmarkRunner(BenchMarkRunnerBase):
                               shell=True,
                               stdout=logfile,
                               stderr=subprocess.STDOUT)
+        if self.need_json_result():
+            cmd = "rsync -aP -zz {}:{}/{} {}/{}".format(
+                ssh_host, ssh_workdir, self.json_result_name(),
+                self.output_dir.local_path,
+                self.json_result_name().replace(
+                    "-result.json", "-{}-result.json".format(ssh_name)))
+            subprocess.check_call(cmd, shell=True)
 
 
 # build benchmarker
@@ -118,6 +129,13 @@ def main():
                       arch_str=arch_list,
                       benchmarkers=benchmarker_list)
     set_config_and_run(arch_list)
+    output_dir = "{}/benchmark/output".format(megcc_path)
+    results = aggregate_results(output_dir)
+    baseline_path = "{}/baseline.json".format(output_dir)
+    if os.path.exists(baseline_path):
+        check_regression(results, baseline_path)
+    else:
+        save_baseline(results, baseline_path)
 
 
 if __name__ == "__main__":
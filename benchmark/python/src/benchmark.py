@@ -1,4 +1,7 @@
 #!/usr/bin/env python3
+import glob
+import json
+import logging
 import os
 import subprocess
 from pathlib import Path
@@ -73,6 +76,16 @@ class BenchMarkRunnerBase:
         self.benchmark_exec_func = "{}/install/bin/benchmarker".format(
             self.benchmark_build_dir)
 
+    def json_result_name(self):
+        return "{}-{}-{}-result.json".format(self.benchmark_framework,
+                                             self.benchmark_arch,
+                                             self.model.name)
+
+    # the latency distribution, cold start and memory usage only dumped by
+    # megcc without kernel profile
+    def need_json_result(self):
+        return self.benchmark_framework == "megcc" and self.log_level != 0
+
     def run_local(self):
         if not os.path.exists(self.output_dir.local_path) or os.path.isfile(
                 self.output_dir.local_path):
@@ -92,9 +105,55 @@ class BenchMarkRunnerBase:
             run_options += " --profile"
         if self.benchmark_framework == "mge":
             run_options += " --mge"
+        if self.need_json_result():
+            run_options += " --json {}/{}".format(self.output_dir.local_path,
+                                                  self.json_result_name())
         cmd = "{} {} {}".format(self.benchmark_exec_func, self.model.path,
                                 run_options)
         subprocess.check_call(cmd,
                               shell=True,
                               stdout=logfile,
                               stderr=subprocess.STDOUT)
+
+
+def aggregate_results(output_dir):
+    """collect all json results in output_dir, keyed by framework-arch-model"""
+    results = {}
+    for path in sorted(glob.glob("{}/*-result.json".format(output_dir))):
+        with open(path) as f:
+            result = json.load(f)
+        key = os.path.basename(path)[:-len("-result.json")]
+        results[key] = result
+    return results
+
+
+def save_baseline(results, baseline_path):
+    with open(baseline_path, "w") as f:
+        json.dump(results, f, indent=4, sort_keys=True)
+
+
+# compare the p50, p99, cold start and memory with the stored baseline, the
+# metric larger than baseline * (1 + threshold) is reported as regression
+def check_regression(results,
+                     baseline_path,
+                     threshold=0.05,
+                     metrics=("p50_ms", "p99_ms", "load_ms",
+                              "first_inference_ms", "tensor_memory_bytes",
+                              "weight_memory_bytes")):
+    with open(baseline_path) as f:
+        baseline = json.load(f)
+    regressions = []
+    for key, result in results.items():
+        if key not in baseline:
+            logging.warning("no baseline of {}".format(key))
+            continue
+        for metric in metrics:
+            base = baseline[key].get(metric, 0)
+            value = result.get(metric, 0)
+            if base > 0 and value > base * (1 + threshold):
+                regressions.append((key, metric, base, value))
+    for key, metric, base, value in regressions:
+        logging.error("regression of {} {}: baseline {:.4f}, now {:.4f}, +{:.2f}%"
+                      .format(key, metric, base, value,
+                              (value / base - 1) * 100))
+    return regressions
@@ -2,14 +2,14 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <sys/resource.h>
 #include <sys/time.h>
+#include <time.h>
+#include <algorithm>
 #include <map>
 #include "lite-c/common_enum_c.h"
 #include "lite-c/global_c.h"
 #include "lite-c/tensor_c.h"
-const int number = 50;
-const int warmup = 10;
-
 #define LITE_CAPI_CHECK(error_, msg_)  \
     if (error_) {                      \
         printf(msg_);                  \
@@ -26,6 +26,32 @@ const int warmup = 10;
 using namespace megcc;
 using namespace Benchmark;
 
+namespace {
+//! monotonic clock in ms, not affected by the adjustment of the system time
+double now_ms() {
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return t.tv_sec * 1e3 + t.tv_nsec * 1e-6;
+}
+
+//! nearest rank percentile of the sorted latency
+double percentile(const std::vector<double>& sorted, double p) {
+    if (sorted.empty()) {
+        return 0;
+    }
+    size_t rank = static_cast<size_t>(p / 100 * sorted.size() + 0.5);
+    rank = std::min(std::max(rank, (size_t)1), sorted.size());
+    return sorted[rank - 1];
+}
+
+//! peak resident set size of the process in KB
+long peak_rss_kb() {
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_maxrss;
+}
+}  // namespace
+
 #if TINYNN_CALLBACK_ENABLE
 #include <malloc.h>
 #include "tinynn_callback.h"
@@ -58,9 +84,16 @@ void CCBenchmarker::load_model() {
             LITE_make_network(&m_model, *default_config(), *default_network_io()),
             "create model error. \n");
 
+    double start = now_ms();
     LITE_CAPI_CHECK(
             LITE_load_model_from_path(m_model, m_model_path.c_str()),
             "load model error. \n");
+    m_load_ms = now_ms() - start;
+    if (!m_profile_path.empty()) {
+        LITE_CAPI_CHECK(
+                LITE_enable_profile_performance(m_model, m_profile_path.c_str()),
+                "enable profile failed, build runtime with TINYNN_PROFILE_KERNEL\n");
+    }
 }
 
 void CCBenchmarker::profile() {
@@ -90,30 +123,82 @@ void CCBenchmarker::profile() {
         LITE_CAPI_CHECK(LITE_destroy_tensor(input), "destory input tensor");
     }
 
-    for (int i = 0; i < warmup; i++) {
+    //! the first inference is part of the cold start, it is not counted in
+    //! the warmup
+    double start = now_ms();
+    LITE_CAPI_CHECK(LITE_forward(m_model), "run model failed\n");
+    LITE_CAPI_CHECK(LITE_wait(m_model), "wait model failed\n");
+    m_first_inference_ms = now_ms() - start;
+
+    for (int i = 0; i < m_warmup; i++) {
         LITE_CAPI_CHECK(LITE_forward(m_model), "run model failed\n");
         LITE_CAPI_CHECK(LITE_wait(m_model), "wait model failed\n");
     }
 
-    struct timeval start;
-    struct timeval end;
-    gettimeofday(&start, NULL);
-    for (int i = 0; i < number; i++) {
+    std::vector<double> latency(m_number);
+    for (int i = 0; i < m_number; i++) {
+        start = now_ms();
         LITE_CAPI_CHECK(LITE_forward(m_model), "run model failed\n");
         LITE_CAPI_CHECK(LITE_wait(m_model), "wait model failed\n");
+        latency[i] = now_ms() - start;
     }
-    gettimeofday(&end, NULL);
 
     for (size_t i = 0; i < nr_input; ++i) {
         free(input_data[i]);
     }
 
-    unsigned long diff =
-            1000000 * (end.tv_sec - start.tv_sec) + end.tv_usec - start.tv_usec;
-    float average_time = ((float)diff) / number / 1000;
+    std::vector<double> sorted = latency;
+    std::sort(sorted.begin(), sorted.end());
+    double total = 0;
+    for (auto t : latency) {
+        total += t;
+    }
+    double average_time = m_number > 0 ? total / m_number : 0;
     if (m_log_level == 3) {
         printf("the inference average time=%.3f ms\n", average_time);
+        printf("the inference latency p50=%.3f ms, p90=%.3f ms, p99=%.3f ms, "
+               "max=%.3f ms\n",
+               percentile(sorted, 50), percentile(sorted, 90), percentile(sorted, 99),
+               sorted.empty() ? 0 : sorted.back());
+        printf("cold start: load model=%.3f ms, first inference=%.3f ms\n", m_load_ms,
+               m_first_inference_ms);
+    }
+    if (!m_json_path.empty()) {
+        dump_json(latency, sorted, average_time);
+    }
+}
+
+void CCBenchmarker::dump_json(
+        const std::vector<double>& latency, const std::vector<double>& sorted,
+        double average_time) {
+    size_t tensor_memory = 0, weight_memory = 0;
+    LITE_CAPI_CHECK(
+            LITE_get_network_memory_usage(m_model, &tensor_memory, &weight_memory),
+            "get memory usage failed\n");
+    FILE* fout = fopen(m_json_path.c_str(), "w");
+    EXAMPLE_ASSERT(fout, "open %s failed\n", m_json_path.c_str());
+    fprintf(fout, "{\n");
+    fprintf(fout, "    \"framework\": \"megcc\",\n");
+    fprintf(fout, "    \"model\": \"%s\",\n", m_model_path.c_str());
+    fprintf(fout, "    \"warmup\": %d,\n", m_warmup);
+    fprintf(fout, "    \"iterations\": %d,\n", m_number);
+    fprintf(fout, "    \"load_ms\": %.4f,\n", m_load_ms);
+    fprintf(fout, "    \"first_inference_ms\": %.4f,\n", m_first_inference_ms);
+    fprintf(fout, "    \"mean_ms\": %.4f,\n", average_time);
+    fprintf(fout, "    \"min_ms\": %.4f,\n", sorted.empty() ? 0 : sorted.front());
+    fprintf(fout, "    \"p50_ms\": %.4f,\n", percentile(sorted, 50));
+    fprintf(fout, "    \"p90_ms\": %.4f,\n", percentile(sorted, 90));
+    fprintf(fout, "    \"p99_ms\": %.4f,\n", percentile(sorted, 99));
+    fprintf(fout, "    \"max_ms\": %.4f,\n", sorted.empty() ? 0 : sorted.back());
+    fprintf(fout, "    \"peak_rss_kb\": %ld,\n", peak_rss_kb());
+    fprintf(fout, "    \"tensor_memory_bytes\": %zu,\n", tensor_memory);
+    fprintf(fout, "    \"weight_memory_bytes\": %zu,\n", weight_memory);
+    fprintf(fout, "    \"latency_ms\": [");
+    for (size_t i = 0; i < latency.size(); ++i) {
+        fprintf(fout, "%s%.4f", i ? ", " : "", latency[i]);
     }
+    fprintf(fout, "]\n}\n");
+    fclose(fout);
 }
 
 CCBenchmarker::~CCBenchmarker() {
@@ -8,8 +8,15 @@ namespace megcc {
 namespace Benchmark {
 class CCBenchmarker final : public Benchmarker {
 public:
-    CCBenchmarker(std::string model, int log_level)
-            : m_model_path(model), m_log_level(log_level) {
+    CCBenchmarker(
+            std::string model, int log_level, int warmup = 10, int number = 50,
+            std::string json_path = "", std::string profile_path = "")
+            : m_log_level(log_level),
+              m_warmup(warmup),
+              m_number(number),
+              m_model_path(model),
+              m_json_path(json_path),
+              m_profile_path(profile_path) {
         LITE_set_log_level(static_cast<LiteLogLevel>(log_level));
     };
     virtual void load_model() override;
@@ -17,9 +24,23 @@ public:
     ~CCBenchmarker();
 
 private:
+    void dump_json(
+            const std::vector<double>& latency, const std::vector<double>& sorted,
+            double average_time);
+
     int m_log_level;
+    int m_warmup;
+    int m_number;
     std::string m_model_path;
+    std::string m_json_path;
+    //! per kernel profile result written by runtime when destroy the network
+    std::string m_profile_path;
     LiteNetwork m_model;
+    //! cold start cost in ms, load is LITE_load_model_from_path which reads
+    //! the model and preprocesses the weights, the first inference allocates
+    //! the tensor memory
+    double m_load_ms = 0;
+    double m_first_inference_ms = 0;
 };
 }  // namespace Benchmark
 
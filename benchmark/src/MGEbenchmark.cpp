@@ -85,7 +85,14 @@ void MGEBenchmarker::profile() {
     if (m_log_level == 0) {
         std::string profile_ret;
         m_profiler->to_json_full(m_func.get())->writeto(profile_ret, 4);
-        printf("%s\n", profile_ret.c_str());
+        if (m_profile_path.empty()) {
+            printf("%s\n", profile_ret.c_str());
+        } else {
+            FILE* fout = fopen(m_profile_path.c_str(), "w");
+            mgb_assert(fout, "open %s failed", m_profile_path.c_str());
+            fwrite(profile_ret.c_str(), 1, profile_ret.size(), fout);
+            fclose(fout);
+        }
     } else {
         printf("the inference average time=%.3f ms\n", average_time);
     }
@@ -10,8 +10,10 @@ namespace megcc {
 namespace Benchmark {
 class MGEBenchmarker final : public Benchmarker {
 public:
-    MGEBenchmarker(std::string model, int log_level)
-            : m_model_path(model), m_log_level(log_level) {
+    MGEBenchmarker(std::string model, int log_level, std::string profile_path = "")
+            : m_log_level(log_level),
+              m_model_path(model),
+              m_profile_path(profile_path) {
         m_load_config.comp_graph = mgb::ComputingGraph::make();
     };
     virtual void load_model() override;
@@ -20,6 +22,8 @@ public:
 private:
     int m_log_level;
     std::string m_model_path;
+    //! write the profile result to file rather than stdout if not empty
+    std::string m_profile_path;
     mgb::serialization::GraphLoadConfig m_load_config;
     mgb::serialization::GraphLoader::LoadResult m_model;
     std::unique_ptr<mgb::cg::AsyncExecutable> m_func;
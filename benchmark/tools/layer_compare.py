@@ -0,0 +1,129 @@
+#! /usr/bin/env python3
+import argparse
+import csv
+import json
+
+
+# the kernel profile of megcc runtime, written by LITE_enable_profile_performance
+def load_megcc_profile(path):
+    with open(path, "r") as f:
+        prof = json.load(f)
+    layers = {}
+    for opr in prof["oprs"]:
+        name = opr["name"]
+        if name not in layers:
+            layers[name] = {"time_ms": 0.0, "types": []}
+        layers[name]["time_ms"] += opr["time_ms"]
+        layers[name]["types"].append(opr["type"])
+    return layers
+
+
+# the full json of megengine GraphProfiler, the device time and the footprint
+# of every operator are indexed by operator id
+def load_mge_profile(path):
+    with open(path, "r") as f:
+        prof = json.load(f)
+    opr_info = prof["graph_exec"]["operator"]
+    footprint = prof.get("opr_footprint", {})
+    device = prof["profiler"]["device"]
+    layers = {}
+    for opr_id, info in opr_info.items():
+        if opr_id not in device:
+            continue
+        time_s = 0.0
+        for dev_time in device[opr_id].values():
+            start = dev_time.get("kern", dev_time.get("start", 0))
+            time_s += dev_time["end"] - start
+        fp = footprint.get(opr_id, {})
+        name = info["name"]
+        if name not in layers:
+            layers[name] = {
+                "time_ms": 0.0,
+                "type": info["type"],
+                "flops": 0,
+                "memory": 0
+            }
+        layers[name]["time_ms"] += time_s * 1e3
+        layers[name]["flops"] += fp.get("computation", 0)
+        layers[name]["memory"] += fp.get("memory", 0)
+    return layers
+
+
+def compare(megcc_layers, mge_layers):
+    rows = []
+    for name, cc in megcc_layers.items():
+        if name not in mge_layers:
+            continue
+        mge = mge_layers[name]
+        row = {
+            "name": name,
+            "type": mge["type"],
+            "megcc_kernel": ";".join(cc["types"]),
+            "megcc_ms": cc["time_ms"],
+            "mge_ms": mge["time_ms"],
+            "speedup": mge["time_ms"] / cc["time_ms"] if cc["time_ms"] > 0 else 0,
+        }
+        # flops and memory footprint come from megengine, the same layer
+        # does the same work in both framework
+        for fw in ["megcc", "mge"]:
+            time_s = row["{}_ms".format(fw)] / 1e3
+            row["{}_gflops".format(fw)] = (mge["flops"] / time_s /
+                                           1e9 if time_s > 0 else 0)
+            row["{}_gbps".format(fw)] = (mge["memory"] / time_s /
+                                         1e9 if time_s > 0 else 0)
+        rows.append(row)
+    rows.sort(key=lambda r: r["megcc_ms"] - r["mge_ms"], reverse=True)
+    unmatched_cc = [n for n in megcc_layers if n not in mge_layers]
+    unmatched_mge = [n for n in mge_layers if n not in megcc_layers]
+    return rows, unmatched_cc, unmatched_mge
+
+
+def main(passed_args=None):
+    parser = argparse.ArgumentParser(
+        description="compare the per layer performance of megcc and megengine, "
+        "the profile files are generated by `benchmarker model.tiny --compare "
+        "model.mge`",
+        formatter_class=argparse.ArgumentDefaultsHelpFormatter,
+    )
+    parser.add_argument("megcc_profile")
+    parser.add_argument("mge_profile")
+    parser.add_argument("--csv", "-c", default="", type=str)
+    parser.add_argument("--top", "-t", default=30, type=int)
+    args = parser.parse_args(passed_args)
+
+    megcc_layers = load_megcc_profile(args.megcc_profile)
+    mge_layers = load_mge_profile(args.mge_profile)
+    rows, unmatched_cc, unmatched_mge = compare(megcc_layers, mge_layers)
+
+    header = "{:<40} {:<20} {:>10} {:>10} {:>8} {:>10} {:>10} {:>9} {:>9}".format(
+        "name", "type", "megcc ms", "mge ms", "speedup", "cc GFLOPS",
+        "mge GFLOPS", "cc GB/s", "mge GB/s")
+    print(header)
+    for row in rows[:args.top]:
+        print(
+            "{:<40} {:<20} {:>10.4f} {:>10.4f} {:>8.2f} {:>10.2f} {:>10.2f} {:>9.2f} {:>9.2f}"
+            .format(row["name"][:40], row["type"][:20], row["megcc_ms"],
+                    row["mge_ms"], row["speedup"], row["megcc_gflops"],
+                    row["mge_gflops"], row["megcc_gbps"], row["mge_gbps"]))
+    total_cc = sum(r["megcc_ms"] for r in rows)
+    total_mge = sum(r["mge_ms"] for r in rows)
+    print("matched {} layers, megcc {:.4f} ms, megengine {:.4f} ms".format(
+        len(rows), total_cc, total_mge))
+    if unmatched_cc:
+        print("megcc only layers: {:.4f} ms, {}".format(
+            sum(megcc_layers[n]["time_ms"] for n in unmatched_cc),
+            ", ".join(unmatched_cc)))
+    if unmatched_mge:
+        print("megengine only layers: {:.4f} ms, {}".format(
+            sum(mge_layers[n]["time_ms"] for n in unmatched_mge),
+            ", ".join(unmatched_mge)))
+
+    if args.csv:
+        with open(args.csv, "w", newline="") as f:
+            writer = csv.DictWriter(f, fieldnames=list(rows[0].keys()) if rows else ["name"])
+            writer.writeheader()
+            writer.writerows(rows)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,51 @@
+# coding: utf-8
+import os
+from argparse import ArgumentParser
+
+import megengine as mge
+import megengine.functional as F
+import megengine.module as M
+import numpy as np
+from megengine.jit import trace
+
+
+class FirstConvNet(M.Module):
+    def __init__(self, padding):
+        super().__init__()
+        self.conv0 = M.Conv2d(3, 8, 3, stride=2, padding=padding)
+        self.conv1 = M.Conv2d(8, 16, 3, padding=1)
+
+    def forward(self, data):
+        return self.conv1(F.relu(self.conv0(data)))
+
+
+if __name__ == "__main__":
+    parser = ArgumentParser(
+        description="dump a model whose input normalize is checked against "
+        "the one folded by mgb-to-tinynn, with the raw and normalized input")
+    parser.add_argument("output_dir", type=str)
+    parser.add_argument("--padding", type=int, default=0)
+    parser.add_argument("--shape", type=int, nargs=4, default=[1, 3, 32, 32])
+    parser.add_argument("--mean", type=float, nargs=3, required=True)
+    parser.add_argument("--std", type=float, nargs=3, required=True)
+    args = parser.parse_args()
+    os.makedirs(args.output_dir, exist_ok=True)
+    np.random.seed(args.padding)
+
+    net = FirstConvNet(args.padding)
+    net.eval()
+
+    @trace(symbolic=True, capture_as_const=True)
+    def fun(data):
+        return net(data)
+
+    raw = np.random.randint(0, 256, args.shape).astype(np.float32)
+    mean = np.array(args.mean, dtype=np.float32).reshape(1, 3, 1, 1)
+    std = np.array(args.std, dtype=np.float32).reshape(1, 3, 1, 1)
+    normalized = ((raw - mean) / std).astype(np.float32)
+    fun(mge.tensor(normalized))
+    fun.dump(os.path.join(args.output_dir, "model.mge"),
+             arg_names=["data"],
+             optimize_for_inference=False)
+    raw.tofile(os.path.join(args.output_dir, "raw.bin"))
+    normalized.tofile(os.path.join(args.output_dir, "normalized.bin"))
@@ -0,0 +1,44 @@
+#!/bin/bash -e
+
+set -x
+if [[ $# -lt 2 ]] ; then
+  echo "Usage: $0 <compiler_build_dir> <work_dir>"
+  exit 1
+fi
+PROJECT_PATH="$(dirname $(readlink -f $0))/.."
+source ${PROJECT_PATH}/ci/test_tools.sh
+COMPILER_BUILD_DIR="$(readlink -f ${1})"
+WORK_DIR="$(readlink -f ${2})"
+MEAN="103.53 116.28 123.675"
+STD="57.375 57.12 58.395"
+INPUT_SHAPE_STR="data=(1,3,32,32)"
+TINYNN_SHAPE_STR="data=1,3,32,32"
+
+## the unpadded dense NCHW first conv folds the normalize, the padded one keeps
+## it as elemwise, both of them feed the raw input to the tinynn model and the
+## normalized input to the mgb model
+function check_input_normalize(){
+  PADDING="${1}"
+  EXPECT_LOG="${2}"
+  OUTPUT_DIR="${WORK_DIR}/pad${PADDING}"
+  rm -rf "${OUTPUT_DIR}"
+  mkdir -p "${OUTPUT_DIR}"
+  python3 ${PROJECT_PATH}/ci/gen_input_normalize_model.py "${OUTPUT_DIR}" --padding ${PADDING} --mean ${MEAN} --std ${STD}
+  MODEL_PATH="${OUTPUT_DIR}/model.mge"
+  $COMPILER_BUILD_DIR/tools/mgb-to-tinynn/mgb-to-tinynn "$MODEL_PATH" "$OUTPUT_DIR" --input-shapes="${INPUT_SHAPE_STR}" \
+    --input-mean="$(echo ${MEAN} | tr ' ' ',')" --input-std="$(echo ${STD} | tr ' ' ',')" --verbose 2>&1 | tee "${OUTPUT_DIR}/dump.log"
+  grep "${EXPECT_LOG}" "${OUTPUT_DIR}/dump.log"
+  RUNTIME_BUILD_DIR="$OUTPUT_DIR/runtime"
+  build_runtime $RUNTIME_BUILD_DIR
+  TINYNN_OUTPUT_DIR="$OUTPUT_DIR/tinynn_out/"
+  mkdir -p "${TINYNN_OUTPUT_DIR}"
+  TINYMODEL_PATH=`find ${OUTPUT_DIR} -name "*.tiny"`
+  $RUNTIME_BUILD_DIR/tinynn_test_lite -m ${TINYMODEL_PATH} -o "$TINYNN_OUTPUT_DIR" -l 0 -d "data=${OUTPUT_DIR}/raw.bin" -s ${TINYNN_SHAPE_STR}
+  MGB_OUTPUT_DIR="$OUTPUT_DIR/mgb_out/"
+  mkdir -p "${MGB_OUTPUT_DIR}"
+  $COMPILER_BUILD_DIR/tools/mgb-runner/mgb-runner "$MODEL_PATH" "$MGB_OUTPUT_DIR" --input-shapes="${INPUT_SHAPE_STR}" --input-data="data=${OUTPUT_DIR}/normalized.bin"
+  python3 $PROJECT_PATH/ci/compare_output_bin.py $TINYNN_OUTPUT_DIR $MGB_OUTPUT_DIR --eps=1e-4
+}
+
+check_input_normalize 0 "fold input normalize of data into"
+check_input_normalize 1 "can not be folded into convolution as reader"
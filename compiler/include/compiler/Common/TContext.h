@@ -12,6 +12,9 @@ struct CCOperand {
     std::vector<size_t> shape;
     std::string dtype;
     float scale = -1.f;
+    //! the operand is a quantized weight with per output channel or per group
+    //! scales, which are read from the runtime dtype param
+    bool per_channel_scale = false;
     size_t nr_elem() {
         if (shape.size() == 0) {
             return 0;
@@ -33,6 +36,9 @@ struct CCOperand {
         if (scale >= 0) {
             ss << ":" << scale;
         }
+        if (per_channel_scale) {
+            ss << ":per_channel";
+        }
         ss << "]";
         return ss.str();
     }
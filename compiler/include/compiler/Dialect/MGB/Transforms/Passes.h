@@ -5,6 +5,10 @@
 namespace mlir {
 
 std::unique_ptr<OperationPass<FuncOp>> createMGBFuseKernelPass();
+std::unique_ptr<OperationPass<ModuleOp>> createMGBHorizontalFusePass();
+std::unique_ptr<OperationPass<ModuleOp>> createMGBConstantFoldPass();
+std::unique_ptr<OperationPass<ModuleOp>> createMGBAffineFoldPass();
+std::unique_ptr<OperationPass<FuncOp>> createMGBRelayoutFoldPass();
 
 #define GEN_PASS_REGISTRATION
 #include "compiler/Dialect/MGB/Transforms/Passes.h.inc"
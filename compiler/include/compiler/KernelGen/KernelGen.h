@@ -183,6 +183,7 @@ struct KernelPack {
         CvtColorKernel,
         ArgSortKernel,
         ArgmaxKernel,
+        ArgminKernel,
         ConcatKernel,
         InternelKernel,
         ConvBackDataKernel,
@@ -190,6 +191,9 @@ struct KernelPack {
         CVGaussianBlur,
         GaussianBlurKernel,
         PaddingKernel,
+        CVPreprocessKernel,
+        NMSKeepKernel,
+        CVSepFilterKernel,
     };
     static std::pair<std::vector<const KernelFunc*>, const DeduceFunc*> GetKernel(
             KernelPack::KernType kernel_type, Arch arch);
@@ -0,0 +1,335 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iterator>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "compiler/Common/Logger.h"
+
+#include "megbrain/graph.h"
+#include "megbrain/opr/basic_arith.h"
+#include "megbrain/opr/blas.h"
+#include "megbrain/opr/dnn/convolution.h"
+#include "megbrain/opr/dnn/pooling.h"
+#include "megbrain/opr/tensor_manip.h"
+#include "megbrain/serialization/opr_shallow_copy.h"
+#include "megbrain/serialization/serializer.h"
+
+namespace mlir {
+namespace MGB {
+
+//! the raw binary calibration inputs of every calibration set
+using Fp16CalibData = std::vector<std::map<std::string, std::vector<char>>>;
+using Fp16CalibTensorMap = mgb::serialization::GraphLoader::LoadResult::TensorMap;
+
+//! the oprs which have fp16 kernels and are not sensitive to the precision,
+//! the others such as Reduce and Softmax always compute in fp32
+static inline bool is_fp16_storage_opr(mgb::cg::OperatorNodeBase* opr) {
+    using namespace mgb;
+    using Mode = opr::Elemwise::Mode;
+    if (opr->output(0)->dtype() != dtype::Float32()) {
+        return false;
+    }
+    if (auto elemwise = opr->try_cast_final<opr::Elemwise>()) {
+        auto mode = elemwise->param().mode;
+        return mode != Mode::EXP && mode != Mode::LOG && mode != Mode::POW &&
+               mode != Mode::TRUE_DIV;
+    }
+    return opr->same_type<opr::Convolution>() ||
+           opr->same_type<opr::ConvBiasForward>() ||
+           opr->same_type<opr::MatrixMul>() || opr->same_type<opr::PoolingForward>() ||
+           opr->same_type<opr::Reshape>() || opr->same_type<opr::Dimshuffle>() ||
+           opr->same_type<opr::Concat>() || opr->same_type<opr::Subtensor>() ||
+           opr->same_type<opr::AxisAddRemove>();
+}
+
+//! the fp16 storage candidates of the graph, the first and the last
+//! convolution or matmul are kept in fp32
+static inline std::vector<mgb::cg::OperatorNodeBase*> get_fp16_storage_candidates(
+        const mgb::SymbolVarArray& dest_vars) {
+    using namespace mgb;
+    std::vector<cg::OperatorNodeBase*> candidates;
+    std::vector<cg::OperatorNodeBase*> computes;
+    cg::DepOprIter dep([&](cg::OperatorNodeBase* opr) {
+        if (!is_fp16_storage_opr(opr)) {
+            return;
+        }
+        candidates.push_back(opr);
+        if (opr->same_type<opr::Convolution>() ||
+            opr->same_type<opr::ConvBiasForward>() ||
+            opr->same_type<opr::MatrixMul>()) {
+            computes.push_back(opr);
+        }
+    });
+    for (auto&& i : dest_vars)
+        dep.add(i);
+    if (!computes.empty()) {
+        for (auto keep : {computes.front(), computes.back()}) {
+            candidates.erase(
+                    std::remove(candidates.begin(), candidates.end(), keep),
+                    candidates.end());
+        }
+    }
+    return candidates;
+}
+
+//! the channel wise convolution only reduces FH * FW products, it keeps the
+//! DEFAULT compute mode and runs on the fp16 channel wise kernel
+template <typename Param>
+static inline bool is_channel_wise_conv(
+        const Param& param, mgb::cg::OperatorNodeBase* opr) {
+    auto&& filter = opr->input(1)->shape();
+    return param.sparse == Param::Sparse::GROUP && filter.ndim == 5 &&
+           filter[1] == 1 && filter[2] == 1;
+}
+
+//! rebuild the graph with the activations of fp16_oprs stored in fp16, the
+//! TypeCvt oprs are inserted where fp16 and fp32 oprs meet and the outputs
+//! are converted back to fp32. Convolution and matmul accumulate in fp32
+static inline mgb::SymbolVarArray convert_to_fp16_storage(
+        const mgb::SymbolVarArray& dest_vars,
+        const mgb::ThinHashSet<mgb::cg::OperatorNodeBase*>& fp16_oprs) {
+    using namespace mgb;
+    ThinHashMap<VarNode*, VarNode*> varmap;
+    auto get_var = [&](VarNode* var, bool fp16) {
+        auto iter = varmap.find(var);
+        VarNode* ret = iter == varmap.end() ? var : iter->second;
+        if (var->dtype() != dtype::Float32()) {
+            return ret;
+        }
+        DType dtype = fp16 ? DType(dtype::Float16()) : DType(dtype::Float32());
+        if (ret->dtype() != dtype) {
+            ret = opr::TypeCvt::make(ret, dtype).node();
+        }
+        return ret;
+    };
+    cg::DepOprIter dep([&](cg::OperatorNodeBase* opr) {
+        bool fp16 = fp16_oprs.count(opr);
+        VarNodeArray inputs;
+        bool changed = false;
+        for (auto&& var : opr->input()) {
+            inputs.push_back(get_var(var, fp16));
+            changed |= inputs.back() != var;
+        }
+        if (!changed) {
+            return;
+        }
+        cg::OperatorNodeBase* new_opr = nullptr;
+        if (fp16 && opr->same_type<opr::Convolution>()) {
+            auto param = opr->cast_final<opr::Convolution>().param();
+            if (!is_channel_wise_conv(param, opr)) {
+                param.compute_mode = opr::Convolution::Param::ComputeMode::FLOAT32;
+            }
+            new_opr = opr::Convolution::make(
+                              inputs[0], inputs[1], param, {}, opr->config())
+                              .node()
+                              ->owner_opr();
+        } else if (fp16 && opr->same_type<opr::ConvBiasForward>()) {
+            auto param = opr->cast_final<opr::ConvBiasForward>().param();
+            if (!is_channel_wise_conv(param, opr)) {
+                param.compute_mode = opr::ConvBiasForward::Param::ComputeMode::FLOAT32;
+            }
+            SymbolVarArray vars(inputs.begin(), inputs.end());
+            SymbolVar conv;
+            if (vars.size() == 2) {
+                conv = opr::ConvBiasForward::make(
+                        vars[0], vars[1], param, {}, opr->config());
+            } else if (vars.size() == 3) {
+                conv = opr::ConvBiasForward::make(
+                        vars[0], vars[1], vars[2], param, {}, opr->config());
+            } else {
+                conv = opr::ConvBiasForward::make(
+                        vars[0], vars[1], vars[2], vars[3], param, {}, opr->config());
+            }
+            new_opr = conv.node()->owner_opr();
+        } else if (fp16 && opr->same_type<opr::MatrixMul>()) {
+            auto param = opr->cast_final<opr::MatrixMul>().param();
+            param.compute_mode = opr::MatrixMul::Param::ComputeMode::FLOAT32;
+            new_opr = opr::MatrixMul::make(
+                              inputs[0], inputs[1], param, {}, opr->config())
+                              .node()
+                              ->owner_opr();
+        } else {
+            new_opr = serialization::copy_opr_shallow(*opr, inputs, opr->config());
+        }
+        auto&& outputs = opr->output();
+        auto&& new_outputs = new_opr->output();
+        CC_ASSERT(outputs.size() == new_outputs.size());
+        for (size_t i = 0; i < outputs.size(); ++i) {
+            varmap[outputs[i]] = new_outputs[i];
+        }
+    });
+    for (auto&& i : dest_vars)
+        dep.add(i);
+    SymbolVarArray ret;
+    for (auto&& i : dest_vars) {
+        ret.push_back(get_var(i.node(), false));
+    }
+    return ret;
+}
+
+//! load the raw binary calibration inputs of format
+//! `name0=file0;name1=file1:name0=file2;name1=file3`, every group separated
+//! by colon is a calibration input set
+static inline Fp16CalibData load_fp16_calib_data(const std::string& calib_data) {
+    auto split = [](const std::string& str, char delim) {
+        std::vector<std::string> ret;
+        std::stringstream ss(str);
+        std::string item;
+        while (std::getline(ss, item, delim)) {
+            if (!item.empty()) {
+                ret.push_back(item);
+            }
+        }
+        return ret;
+    };
+    Fp16CalibData ret;
+    for (auto&& group : split(calib_data, ':')) {
+        std::map<std::string, std::vector<char>> data;
+        for (auto&& item : split(group, ';')) {
+            auto pos = item.find('=');
+            CC_ASSERT(pos != std::string::npos)
+                    << "invalid calibration data " << item << "\n";
+            auto file = item.substr(pos + 1);
+            std::ifstream in(file, std::ios::binary);
+            CC_ASSERT(in.good()) << "can not open calibration data " << file << "\n";
+            data[item.substr(0, pos)] = std::vector<char>(
+                    std::istreambuf_iterator<char>(in),
+                    std::istreambuf_iterator<char>());
+        }
+        ret.push_back(std::move(data));
+    }
+    return ret;
+}
+
+//! run the graph on every calibration set and copy the outputs to host
+static inline std::vector<std::vector<mgb::HostTensorND>> run_fp16_calib(
+        const mgb::SymbolVarArray& vars, const Fp16CalibData& calib_data,
+        const Fp16CalibTensorMap& tensor_map) {
+    using namespace mgb;
+    std::vector<HostTensorND> outputs(vars.size());
+    cg::ComputingGraph::OutputSpec output_spec;
+    for (size_t i = 0; i < vars.size(); ++i) {
+        output_spec.push_back({vars[i], [&outputs, i](DeviceTensorND& dv) {
+                                   outputs[i].copy_from(dv).sync();
+                               }});
+    }
+    auto func = vars[0].node()->owner_graph()->compile(output_spec);
+    std::vector<std::vector<HostTensorND>> ret;
+    for (auto&& data : calib_data) {
+        for (auto&& i : data) {
+            auto iter = tensor_map.find(i.first);
+            CC_ASSERT(iter != tensor_map.end())
+                    << "unknown calibration input " << i.first << "\n";
+            auto&& tensor = iter->second;
+            CC_ASSERT(tensor->layout().span().dist_byte() == i.second.size())
+                    << "the size of calibration input " << i.first
+                    << " mismatches the shape " << tensor->shape().to_string()
+                    << "\n";
+            memcpy(tensor->raw_ptr(), i.second.data(), i.second.size());
+        }
+        func->execute().wait();
+        //! the outputs share the storage across the sets, so copy them out
+        std::vector<HostTensorND> set_outputs(outputs.size());
+        for (size_t i = 0; i < outputs.size(); ++i) {
+            set_outputs[i].copy_from(outputs[i]);
+        }
+        ret.push_back(std::move(set_outputs));
+    }
+    return ret;
+}
+
+//! the max relative l2 error of the float outputs
+static inline float get_fp16_calib_error(
+        const std::vector<std::vector<mgb::HostTensorND>>& ref,
+        const std::vector<std::vector<mgb::HostTensorND>>& val) {
+    using namespace mgb;
+    float max_error = 0.f;
+    for (size_t set = 0; set < ref.size(); ++set) {
+        for (size_t i = 0; i < ref[set].size(); ++i) {
+            auto&& x = ref[set][i];
+            auto&& y = val[set][i];
+            if (x.dtype() != dtype::Float32() || y.dtype() != dtype::Float32()) {
+                continue;
+            }
+            double diff = 0, norm = 0;
+            auto px = x.ptr<float>(), py = y.ptr<float>();
+            for (size_t j = 0; j < x.shape().total_nr_elems(); ++j) {
+                diff += (px[j] - py[j]) * (px[j] - py[j]);
+                norm += px[j] * px[j];
+            }
+            float error = std::sqrt(diff / std::max(norm, 1e-12));
+            max_error = std::max(max_error, error);
+        }
+    }
+    return max_error;
+}
+
+//! store the activations of the candidate oprs in fp16. With calibration
+//! data, the oprs are sorted by the output error when each of them is fp16
+//! alone, and the longest prefix within the error budget is selected
+static inline mgb::SymbolVarArray fp16_storage(
+        const mgb::SymbolVarArray& dest_vars, const Fp16CalibData& calib_data,
+        float error_budget, const Fp16CalibTensorMap& tensor_map) {
+    using namespace mgb;
+    using OprSet = ThinHashSet<cg::OperatorNodeBase*>;
+    auto candidates = get_fp16_storage_candidates(dest_vars);
+    if (calib_data.empty()) {
+        LOG_INFO << "store " << candidates.size()
+                 << " oprs in fp16 without calibration\n";
+        return convert_to_fp16_storage(
+                dest_vars, OprSet(candidates.begin(), candidates.end()));
+    }
+    auto ref = run_fp16_calib(dest_vars, calib_data, tensor_map);
+    auto error_of = [&](size_t nr, const std::vector<cg::OperatorNodeBase*>& oprs) {
+        auto vars = convert_to_fp16_storage(
+                dest_vars, OprSet(oprs.begin(), oprs.begin() + nr));
+        return get_fp16_calib_error(ref, run_fp16_calib(vars, calib_data, tensor_map));
+    };
+    std::vector<std::pair<float, cg::OperatorNodeBase*>> sensitivity;
+    for (auto opr : candidates) {
+        sensitivity.push_back({error_of(1, {opr}), opr});
+    }
+    std::stable_sort(
+            sensitivity.begin(), sensitivity.end(),
+            [](const std::pair<float, cg::OperatorNodeBase*>& a,
+               const std::pair<float, cg::OperatorNodeBase*>& b) {
+                return a.first < b.first;
+            });
+    std::vector<cg::OperatorNodeBase*> sorted;
+    for (auto&& i : sensitivity) {
+        sorted.push_back(i.second);
+    }
+    //! binary search the longest prefix within the budget, the error is
+    //! assumed to grow with the number of fp16 oprs
+    size_t lo = 0, hi = sorted.size();
+    float error = 0.f;
+    while (lo < hi) {
+        size_t mid = (lo + hi + 1) / 2;
+        float mid_error = error_of(mid, sorted);
+        if (mid_error <= error_budget) {
+            lo = mid;
+            error = mid_error;
+        } else {
+            hi = mid - 1;
+        }
+    }
+    for (size_t i = lo; i < sorted.size(); ++i) {
+        LOG_INFO << "keep " << sorted[i]->name() << " in fp32, error "
+                 << sensitivity[i].first << "\n";
+    }
+    LOG_INFO << "store " << lo << " of " << sorted.size()
+             << " oprs in fp16 with calibration error " << error << "\n";
+    return convert_to_fp16_storage(
+            dest_vars, OprSet(sorted.begin(), sorted.begin() + lo));
+}
+
+}  // namespace MGB
+}  // namespace mlir
+
+// vim: syntax=cpp.doxygen
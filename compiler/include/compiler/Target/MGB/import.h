@@ -20,6 +20,23 @@ struct MGBImporterOptions {
     bool add_nhwc2nchw_to_input = false;
     bool enable_ioc16 = false;
     bool enable_nchw88 = false;
+    //! feed the 4-dim float inputs as uint8 and convert them in the model
+    bool input_uint8 = false;
+    //! convert the float convolutions of a QAT model with FakeQuant to int8,
+    //! the filters keep their per output channel scales
+    bool quantize_fake_quant = false;
+    //! store the float weights of MatrixMul as "int8" or packed "int4" with a
+    //! scale for every weight_quant_group elements along K, empty to disable
+    std::string weight_quant;
+    int weight_quant_group = 32;
+    //! store the activations of the precision insensitive oprs as fp16, the
+    //! other oprs and the first and the last convolution stay in fp32
+    bool enable_fp16_storage = false;
+    //! raw binary inputs `name=file;...:name=file;...` to select the fp16 oprs
+    //! within fp16_error_budget, all the candidates are fp16 if empty
+    std::string fp16_calib_data;
+    //! the max relative l2 error of the outputs on the calibration inputs
+    float fp16_error_budget = 1e-3f;
     int8_t graph_opt_level = 2;
     std::string module_name;
     std::string extern_opr_output_shape;
@@ -27,6 +44,10 @@ struct MGBImporterOptions {
     std::string extern_opr_loader_env;
     std::string extern_opr_loader_path_with_interface;
     std::vector<std::map<std::string, megdnn::TensorShape>> input_map_vec;
+    //! per channel `(x - mean) / std` of the 4-dim inputs, folded into the
+    //! first convolution when possible
+    std::vector<float> input_mean;
+    std::vector<float> input_std;
 };
 
 mlir::LogicalResult import_mgb(
@@ -36,6 +57,9 @@ mlir::LogicalResult import_mgb(
 mlir::LogicalResult parseInputShapes(
         std::string s, mlir::MGB::MGBImporterOptions& options);
 
+mlir::LogicalResult parseInputNormalize(
+        std::string mean, std::string std, mlir::MGB::MGBImporterOptions& options);
+
 }  // namespace MGB
 }  // namespace mlir
 
@@ -97,8 +97,7 @@ LogicalResult createOp(
         llvm::ArrayRef<NamedAttribute> attributes = {}) {
     SmallVector<Value> newOperands(operands.begin(), operands.end());
     if (succeeded(prepareOperands(op, newOperands, rewriter))) {
-        rewriter.create<OpType>(
-                rewriter.getUnknownLoc(), llvm::None, newOperands, attributes);
+        rewriter.create<OpType>(op->getLoc(), llvm::None, newOperands, attributes);
         rewriter.replaceOp(
                 op, llvm::makeArrayRef(
                             newOperands.begin() + operands.size(), newOperands.end()));
@@ -127,7 +126,8 @@ public:
                      "opr name: "
                   << op.getName().str() << "\n";
         rewriter.replaceOpWithNewOp<Kernel::WeightStorage>(
-                op, op.sym_name(), op.value(), op.type(), op.user_count());
+                op, op.sym_name(), op.value(), op.type(), op.user_count(),
+                op.scalesAttr());
         return success();
     }
 };
@@ -563,7 +563,9 @@ void populateMGBToKernelConversionPatterns(
             MemRefConverter<MGB::Dimshuffle, Kernel::Dimshuffle, Kernel::DimshuffleIns>,
             GenericConverter<MGB::Argsort, Kernel::ArgsortKernel>,
             GenericConverter<MGB::Argmax, Kernel::ArgmaxKernel>,
+            GenericConverter<MGB::Argmin, Kernel::ArgminKernel>,
             GenericConverter<MGB::TopK, Kernel::TopkKernel>,
+            GenericConverter<MGB::NMSKeep, Kernel::NMSKeepKernel>,
             GenericConverter<MGB::Broadcast, Kernel::BroadcastIns>,
             GenericConverter<MGB::TypeCvt, Kernel::TypeCvtKernel>,
             GenericConverter<MGB::BatchedMatrixMul, Kernel::BatchedMatrixMulKernel>,
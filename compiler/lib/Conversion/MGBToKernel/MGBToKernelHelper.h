@@ -187,6 +187,15 @@ SmallVector<NamedAttribute, 4> ConvertAttr<MGB::TopK>(
     return attrs;
 }
 
+template <>
+SmallVector<NamedAttribute, 4> ConvertAttr<MGB::NMSKeep>(
+        DictionaryAttr direct_attr, MLIRContext* context) {
+    SmallVector<NamedAttribute, 4> attrs;
+    GetParam("iou_thresh");
+    GetParam("max_output");
+    return attrs;
+}
+
 template <>
 SmallVector<NamedAttribute, 4> ConvertAttr<MGB::Argmax>(
         DictionaryAttr direct_attr, MLIRContext* context) {
@@ -195,6 +204,14 @@ SmallVector<NamedAttribute, 4> ConvertAttr<MGB::Argmax>(
     return attrs;
 }
 
+template <>
+SmallVector<NamedAttribute, 4> ConvertAttr<MGB::Argmin>(
+        DictionaryAttr direct_attr, MLIRContext* context) {
+    SmallVector<NamedAttribute, 4> attrs;
+    GetParam("axis");
+    return attrs;
+}
+
 template <>
 SmallVector<NamedAttribute, 4> ConvertAttr<MGB::IndexingMultiAxisVec>(
         DictionaryAttr direct_attr, MLIRContext* context) {
@@ -36,6 +36,13 @@ llvm::cl::opt<megcc::KernelGen::Arch> target_arch(
                         "compiler for device arm64 and armv7 with dotprod feature.")),
         llvm::cl::init(megcc::KernelGen::BAREMETAL));
 
+llvm::cl::opt<std::string> fast_math(
+        "fast-math",
+        llvm::cl::desc(
+                "Trade the precision of exp, log and sigmoid kernels for speed, the "
+                "format is ulp:N, where N is the max ulp error allowed"),
+        llvm::cl::init(""));
+
 namespace mlir {
 namespace {
 #define GEN_PASS_CLASSES
@@ -130,8 +137,31 @@ std::unordered_map<std::string, CCAttr> convertAttrToKernelAttr(
     return attr_map;
 }
 
+int32_t getFastMathUlp() {
+    llvm::StringRef option(fast_math);
+    int32_t ulp = 0;
+    CC_ASSERT(option.consume_front("ulp:") && !option.getAsInteger(10, ulp) && ulp >= 0)
+            << "invalid fast-math option " << fast_math.getValue()
+            << ", which should be ulp:N\n";
+    return ulp;
+}
+
+//! whether the value is a weight quantized with per output channel scales
+bool isPerChannelWeight(Value value) {
+    auto weight = value.getDefiningOp<Kernel::GetWeight>();
+    if (!weight) {
+        return false;
+    }
+    auto storage = SymbolTable::lookupNearestSymbolFrom<Kernel::WeightStorage>(
+            weight, weight.nameAttr());
+    return storage && storage.scalesAttr();
+}
+
 std::unordered_map<std::string, CCAttr> getKernelAttr(Operation* op) {
     auto attrs = convertAttrToKernelAttr(op->getAttrDictionary());
+    if (!fast_math.empty()) {
+        attrs["fast_math_ulp"] = getFastMathUlp();
+    }
     auto nr_operands = op->getNumOperands();
     //! nr_operands attribute is of type uint32_t
     attrs["nr_operands"] = static_cast<uint32_t>(nr_operands);
@@ -147,6 +177,8 @@ std::unordered_map<std::string, CCAttr> getKernelAttr(Operation* op) {
                     shapedType.getShape().begin(), shapedType.getShape().end()};
             if (dtype.isa<IntegerType>() && dtype.dyn_cast<IntegerType>().isQuant()) {
                 cc_operand.scale = dtype.dyn_cast<IntegerType>().getScale();
+                cc_operand.per_channel_scale =
+                        isPerChannelWeight(op->getOperands()[i]);
             }
             attrs[llvm::formatv("operand:{0}", i)] = cc_operand;
         }
@@ -48,10 +48,12 @@ INSTANCE_GET_KERNELS(mlir::Kernel::ElemwiseKernelInterface, KernType::ElemwiseKe
 INSTANCE_GET_KERNELS(mlir::Kernel::ElemwiseMultiType, KernType::ElemwiseMultiKernel)
 INSTANCE_GET_KERNELS(mlir::Kernel::ArgsortKernel, KernType::ArgSortKernel)
 INSTANCE_GET_KERNELS(mlir::Kernel::ArgmaxKernel, KernType::ArgmaxKernel)
+INSTANCE_GET_KERNELS(mlir::Kernel::ArgminKernel, KernType::ArgminKernel)
 INSTANCE_GET_KERNELS(mlir::Kernel::IndexingOneHotKernel, KernType::IndexingOneHotKernel)
 INSTANCE_GET_KERNELS(mlir::Kernel::FusedElemwiseKernel, KernType::FusedElemwiseKernel)
 INSTANCE_GET_KERNELS(mlir::Kernel::GaussianBlurKernel, KernType::GaussianBlurKernel)
 INSTANCE_GET_KERNELS(mlir::Kernel::PaddingKernel, KernType::PaddingKernel)
+INSTANCE_GET_KERNELS(mlir::Kernel::NMSKeepKernel, KernType::NMSKeepKernel)
 
 template <class T, typename... Args>
 void addBuiltinTemplatesOpr(
@@ -98,10 +100,12 @@ void addBuiltinTemplatesByOperator(
     addBuiltinTemplatesOpr<mlir::Kernel::IndexingOneHotKernel>(registry, arch);
     addBuiltinTemplatesOpr<mlir::Kernel::ArgsortKernel>(registry, arch);
     addBuiltinTemplatesOpr<mlir::Kernel::ArgmaxKernel>(registry, arch);
+    addBuiltinTemplatesOpr<mlir::Kernel::ArgminKernel>(registry, arch);
     addBuiltinTemplatesOpr<mlir::Kernel::ConvBackDataKernel>(registry, arch);
     addBuiltinTemplatesOpr<mlir::Kernel::FusedElemwiseKernel>(registry, arch);
     addBuiltinTemplatesOpr<mlir::Kernel::GaussianBlurKernel>(registry, arch);
     addBuiltinTemplatesOpr<mlir::Kernel::PaddingKernel>(registry, arch);
+    addBuiltinTemplatesOpr<mlir::Kernel::NMSKeepKernel>(registry, arch);
 }
 }  // namespace Kernel
 }  // namespace mlir
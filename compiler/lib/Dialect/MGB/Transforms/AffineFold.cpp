@@ -0,0 +1,496 @@
+#include <cstring>
+#include <string>
+#include <vector>
+#include "compiler/Common/Logger.h"
+#include "compiler/Dialect/MGB/IR/MGBDialect.h"
+#include "compiler/Dialect/MGB/Transforms/Passes.h"
+#include "ParamHelper.h"
+#include "llvm/Support/Casting.h"
+#include "mlir/IR/BuiltinAttributes.h"
+#include "mlir/IR/BuiltinTypes.h"
+
+#include "mlir/Dialect/StandardOps/IR/Ops.h"
+using namespace megcc;
+namespace mlir {
+namespace {
+
+#define GEN_PASS_CLASSES
+#include "compiler/Dialect/MGB/Transforms/Passes.h.inc"
+
+using ElemMode = ::megdnn::param::Elemwise::Mode;
+
+//! a float param without the quantize scales
+bool is_f32_param(Value value) {
+    if (!MGB::is_static_param(value)) {
+        return false;
+    }
+    auto storage =
+            MGB::get_param_storage(value.getDefiningOp<MGB::ParamProvider>());
+    return !storage.scalesAttr() &&
+           storage.type().cast<RankedTensorType>().getElementType().isF32();
+}
+
+std::vector<float> get_f32(Value value) {
+    auto raw = MGB::get_param_raw(
+            MGB::get_param_storage(value.getDefiningOp<MGB::ParamProvider>()));
+    std::vector<float> data(raw.size() / sizeof(float));
+    memcpy(data.data(), raw.data(), raw.size());
+    return data;
+}
+
+//! a new param of the data with the name derived from `like`
+Value create_f32_param(
+        ModuleOp module, OpBuilder& builder, Value like, const std::string& suffix,
+        ArrayRef<int64_t> shape, const std::vector<float>& data) {
+    std::string name = "affine";
+    if (auto provider = like.getDefiningOp<MGB::ParamProvider>()) {
+        name = MGB::get_param_storage(provider).sym_name().str();
+    }
+    auto type = RankedTensorType::get(shape, builder.getF32Type());
+    auto storage = MGB::create_param_storage(
+            module, name, suffix, type,
+            ArrayRef<char>(
+                    reinterpret_cast<const char*>(data.data()),
+                    data.size() * sizeof(float)));
+    return builder.create<MGB::ParamProvider>(builder.getUnknownLoc(), storage);
+}
+
+void release_value(ModuleOp module, Value value) {
+    if (auto provider = value.getDefiningOp<MGB::ParamProvider>()) {
+        MGB::release_param(module, provider);
+    }
+}
+
+bool is_static_f32(Value value) {
+    auto type = value.getType().dyn_cast<RankedTensorType>();
+    return type && type.hasStaticShape() && type.getElementType().isF32();
+}
+
+//! an elemwise MUL or ADD of a runtime value and a constant, the SUB of a
+//! constant is an ADD of the negated constant
+struct AffineOp {
+    MGB::Elemwise op;
+    bool is_mul;
+    bool negate;
+    Value input;
+    Value param;
+};
+
+Optional<AffineOp> get_affine(Operation* op) {
+    auto elem = llvm::dyn_cast_or_null<MGB::Elemwise>(op);
+    if (!elem || elem->getNumOperands() != 2 || !is_static_f32(elem.getResult())) {
+        return {};
+    }
+    auto mode = elem.mode();
+    if (mode != ElemMode::MUL && mode != ElemMode::ADD && mode != ElemMode::SUB) {
+        return {};
+    }
+    for (int i = 1; i >= 0; --i) {
+        Value param = elem->getOperand(i), input = elem->getOperand(1 - i);
+        if (mode == ElemMode::SUB && i == 0) {
+            continue;
+        }
+        if (is_f32_param(param) && !is_f32_param(input) && is_static_f32(input) &&
+            input.getType() == elem.getResult().getType()) {
+            return AffineOp{elem, mode == ElemMode::MUL, mode == ElemMode::SUB, input,
+                            param};
+        }
+    }
+    return {};
+}
+
+//! the per channel value of the constant broadcasted along `axis` of `type`,
+//! all the other axes of the constant should be 1
+Optional<std::vector<float>> get_channel(
+        Value param, RankedTensorType type, int axis, bool negate) {
+    auto shape = param.getType().cast<RankedTensorType>().getShape();
+    if (static_cast<int64_t>(shape.size()) > type.getRank()) {
+        return {};
+    }
+    int64_t offset = type.getRank() - shape.size();
+    int64_t nr_channel = type.getDimSize(axis);
+    bool per_channel = false;
+    for (size_t i = 0; i < shape.size(); ++i) {
+        if (shape[i] == 1) {
+            continue;
+        }
+        if (static_cast<int64_t>(i) + offset != axis || shape[i] != nr_channel) {
+            return {};
+        }
+        per_channel = true;
+    }
+    auto data = get_f32(param);
+    if (!per_channel) {
+        data.assign(nr_channel, data[0]);
+    }
+    if (negate) {
+        for (auto& val : data) {
+            val = -val;
+        }
+    }
+    return data;
+}
+
+/*!
+ * the filter of the dense conv is (OC, IC, FH, FW) and of the group conv is
+ * (G, OCPG, ICPG, FH, FW), the output channel of the filter element at
+ * (g, oc, ic, fh, fw) is g * OCPG + oc and the input channel is g * ICPG + ic
+ */
+struct ConvInfo {
+    Operation* op;
+    int64_t group, ocpg, icpg, spatial;
+    bool has_pad;
+    bool has_bias;
+};
+
+template <typename Op, typename Param>
+Optional<ConvInfo> get_conv_info(Op conv) {
+    auto operands = conv->getOperands();
+    if (conv.format() != Param::Format::NCHW || operands.size() < 2 ||
+        operands.size() > 3 || !is_f32_param(operands[1]) ||
+        (operands.size() == 3 && !is_f32_param(operands[2])) ||
+        !is_static_f32(operands[0]) || !is_static_f32(conv->getResult(0))) {
+        return {};
+    }
+    auto filter = operands[1].getType().template cast<RankedTensorType>();
+    auto dst = conv->getResult(0).getType().template cast<RankedTensorType>();
+    ConvInfo info{conv, 1, 0, 0, 0, conv.pad_h() != 0 || conv.pad_w() != 0,
+                  operands.size() == 3};
+    if (conv.sparse() == Param::Sparse::DENSE && filter.getRank() == 4) {
+        info.ocpg = filter.getDimSize(0);
+        info.icpg = filter.getDimSize(1);
+    } else if (conv.sparse() == Param::Sparse::GROUP && filter.getRank() == 5) {
+        info.group = filter.getDimSize(0);
+        info.ocpg = filter.getDimSize(1);
+        info.icpg = filter.getDimSize(2);
+    } else {
+        return {};
+    }
+    info.spatial = filter.getNumElements() / (info.group * info.ocpg * info.icpg);
+    if (dst.getRank() != 4 || dst.getDimSize(1) != info.group * info.ocpg) {
+        return {};
+    }
+    if (info.has_bias &&
+        operands[2].getType().template cast<RankedTensorType>().getNumElements() !=
+                info.group * info.ocpg) {
+        return {};
+    }
+    return info;
+}
+
+//! the nonline of the ConvBias only matters when its output is folded
+Optional<ConvInfo> get_conv_info(Operation* op, bool fold_output) {
+    if (auto conv = llvm::dyn_cast_or_null<MGB::ConvBias>(op)) {
+        if (fold_output &&
+            conv.nonlineMode() != ::megdnn::param::ConvBias::NonlineMode::IDENTITY) {
+            return {};
+        }
+        return get_conv_info<MGB::ConvBias, ::megdnn::param::ConvBias>(conv);
+    }
+    if (auto conv = llvm::dyn_cast_or_null<MGB::Convolution>(op)) {
+        return get_conv_info<MGB::Convolution, ::megdnn::param::Convolution>(conv);
+    }
+    return {};
+}
+
+//! set the filter and bias of the conv, the empty one is kept, a Convolution
+//! is turned into a ConvBias when it gets a bias
+void update_conv(
+        ModuleOp module, const ConvInfo& info, const std::vector<float>& filter,
+        const std::vector<float>& bias) {
+    Operation* op = info.op;
+    OpBuilder builder(op);
+    Value old_filter = op->getOperand(1);
+    Value old_bias = info.has_bias ? op->getOperand(2) : Value();
+    if (!filter.empty()) {
+        Value new_filter = create_f32_param(
+                module, builder, old_filter, "_affine",
+                old_filter.getType().cast<RankedTensorType>().getShape(), filter);
+        op->setOperand(1, new_filter);
+        release_value(module, old_filter);
+    }
+    if (bias.empty()) {
+        return;
+    }
+    int64_t nr_channel = info.group * info.ocpg;
+    Value new_bias = old_bias ? create_f32_param(
+                                        module, builder, old_bias, "_affine",
+                                        {1, nr_channel, 1, 1}, bias)
+                              : create_f32_param(
+                                        module, builder, op->getOperand(1), "_bias",
+                                        {1, nr_channel, 1, 1}, bias);
+    if (old_bias) {
+        op->setOperand(2, new_bias);
+        release_value(module, old_bias);
+        return;
+    }
+    auto conv = llvm::cast<MGB::Convolution>(op);
+    auto conv_bias = builder.create<MGB::ConvBias>(
+            op->getLoc(), op->getResult(0).getType(),
+            std::vector<Value>{op->getOperand(0), op->getOperand(1), new_bias},
+            ::megdnn::param::ConvBias::NonlineMode::IDENTITY, conv.mode(),
+            conv.sparse(), conv.format(), conv.pad_h(), conv.pad_w(), conv.stride_h(),
+            conv.stride_w(), conv.dilate_h(), conv.dilate_w(), conv.compute_mode());
+    op->getResult(0).replaceAllUsesWith(conv_bias.getResult());
+    op->erase();
+}
+
+std::vector<float> conv_bias_data(const ConvInfo& info) {
+    if (info.has_bias) {
+        return get_f32(info.op->getOperand(2));
+    }
+    return std::vector<float>(info.group * info.ocpg, 0.f);
+}
+
+//! conv(x) * c + d => conv'(x), the filter of every output channel is scaled
+bool fold_affine_after_conv(ModuleOp module, const AffineOp& affine) {
+    auto info = get_conv_info(affine.input.getDefiningOp(), true);
+    if (!info || !affine.input.hasOneUse()) {
+        return false;
+    }
+    auto dst = affine.input.getType().cast<RankedTensorType>();
+    auto channel = get_channel(affine.param, dst, 1, affine.negate);
+    if (!channel) {
+        return false;
+    }
+    auto& value = channel.getValue();
+    auto filter = get_f32(info->op->getOperand(1));
+    auto bias = conv_bias_data(info.getValue());
+    int64_t per_channel = info->icpg * info->spatial;
+    for (size_t oc = 0; oc < value.size(); ++oc) {
+        if (affine.is_mul) {
+            for (int64_t i = 0; i < per_channel; ++i) {
+                filter[oc * per_channel + i] *= value[oc];
+            }
+            bias[oc] *= value[oc];
+        } else {
+            bias[oc] += value[oc];
+        }
+    }
+    //! the shift keeps the filter and the scale of a Convolution needs no bias
+    if (!affine.is_mul) {
+        filter.clear();
+    } else if (!info->has_bias) {
+        bias.clear();
+    }
+    Value param = affine.param;
+    affine.op.getResult().replaceAllUsesWith(affine.input);
+    affine.op->erase();
+    release_value(module, param);
+    update_conv(module, info.getValue(), filter, bias);
+    LOG_DEBUG << "Fold per output channel "
+              << (affine.is_mul ? "scale" : "shift") << " into conv\n";
+    return true;
+}
+
+//! conv(x * c + d) => conv'(x), the filter of every input channel is scaled,
+//! the shift is folded into the bias and it is only exact without padding, as
+//! the padded zeros are not shifted
+bool fold_affine_before_conv(ModuleOp module, const AffineOp& affine) {
+    Value out = affine.op.getResult();
+    if (!out.hasOneUse()) {
+        return false;
+    }
+    auto& use = *out.getUses().begin();
+    auto info = get_conv_info(use.getOwner(), false);
+    if (!info || use.getOperandNumber() != 0 || (!affine.is_mul && info->has_pad)) {
+        return false;
+    }
+    auto src = out.getType().cast<RankedTensorType>();
+    auto channel = get_channel(affine.param, src, 1, affine.negate);
+    if (!channel || src.getDimSize(1) != info->group * info->icpg) {
+        return false;
+    }
+    auto& value = channel.getValue();
+    auto filter = get_f32(info->op->getOperand(1));
+    std::vector<float> bias;
+    if (!affine.is_mul) {
+        bias = conv_bias_data(info.getValue());
+    }
+    for (int64_t g = 0; g < info->group; ++g) {
+        for (int64_t oc = 0; oc < info->ocpg; ++oc) {
+            float sum = 0.f;
+            for (int64_t ic = 0; ic < info->icpg; ++ic) {
+                float val = value[g * info->icpg + ic];
+                float* ptr = filter.data() +
+                             ((g * info->ocpg + oc) * info->icpg + ic) * info->spatial;
+                for (int64_t k = 0; k < info->spatial; ++k) {
+                    if (affine.is_mul) {
+                        ptr[k] *= val;
+                    } else {
+                        sum += ptr[k] * val;
+                    }
+                }
+            }
+            if (!affine.is_mul) {
+                bias[g * info->ocpg + oc] += sum;
+            }
+        }
+    }
+    if (!affine.is_mul) {
+        filter.clear();
+    }
+    Value param = affine.param;
+    info->op->setOperand(0, affine.input);
+    affine.op->erase();
+    release_value(module, param);
+    update_conv(module, info.getValue(), filter, bias);
+    LOG_DEBUG << "Fold per input channel " << (affine.is_mul ? "scale" : "shift")
+              << " into conv\n";
+    return true;
+}
+
+//! the MatrixMul without bias only takes the scale, the output channel is the
+//! column of the dst and the input channel is the column of A
+bool fold_affine_matmul(ModuleOp module, const AffineOp& affine) {
+    if (!affine.is_mul) {
+        return false;
+    }
+    MGB::MatrixMul matmul;
+    int axis = 0;
+    bool after = false;
+    if ((matmul = llvm::dyn_cast_or_null<MGB::MatrixMul>(
+                 affine.input.getDefiningOp())) &&
+        affine.input.hasOneUse()) {
+        after = true;
+        axis = 1;
+    } else if (affine.op.getResult().hasOneUse()) {
+        auto& use = *affine.op.getResult().getUses().begin();
+        matmul = llvm::dyn_cast<MGB::MatrixMul>(use.getOwner());
+        if (!matmul || use.getOperandNumber() != 0) {
+            return false;
+        }
+        axis = matmul.transposeA() ? 0 : 1;
+    } else {
+        return false;
+    }
+    if (matmul.format() != ::megdnn::param::MatrixMul::Format::DEFAULT ||
+        !is_f32_param(matmul.b()) || !is_static_f32(matmul.a()) ||
+        !is_static_f32(matmul.getResult())) {
+        return false;
+    }
+    auto type = (after ? affine.input : affine.op.getResult())
+                        .getType()
+                        .cast<RankedTensorType>();
+    if (type.getRank() != 2) {
+        return false;
+    }
+    auto channel = get_channel(affine.param, type, axis, false);
+    if (!channel) {
+        return false;
+    }
+    //! the output channel is N and the input channel is K, B is (K, N) or
+    //! (N, K) when transposed
+    auto b_type = matmul.b().getType().cast<RankedTensorType>();
+    bool scale_col = after != matmul.transposeB();
+    int64_t cols = b_type.getDimSize(1);
+    auto& value = channel.getValue();
+    auto filter = get_f32(matmul.b());
+    for (size_t i = 0; i < filter.size(); ++i) {
+        filter[i] *= value[scale_col ? i % cols : i / cols];
+    }
+    Value param = affine.param;
+    if (after) {
+        affine.op.getResult().replaceAllUsesWith(affine.input);
+    } else {
+        matmul->setOperand(0, affine.input);
+    }
+    affine.op->erase();
+    release_value(module, param);
+    OpBuilder builder(matmul);
+    Value old_b = matmul.b();
+    matmul->setOperand(
+            1, create_f32_param(
+                       module, builder, old_b, "_affine", b_type.getShape(), filter));
+    release_value(module, old_b);
+    LOG_DEBUG << "Fold per channel scale into matmul\n";
+    return true;
+}
+
+//! (x * a) * b => x * (a * b) and (x + a) + b => x + (a + b), the pair is
+//! removed when the combined constant is the identity
+bool merge_affine(ModuleOp module, const AffineOp& second) {
+    auto first = get_affine(second.input.getDefiningOp());
+    if (!first || first->is_mul != second.is_mul || !second.input.hasOneUse()) {
+        return false;
+    }
+    auto lhs_type = first->param.getType().cast<RankedTensorType>();
+    auto rhs_type = second.param.getType().cast<RankedTensorType>();
+    bool same_shape = lhs_type == rhs_type;
+    if (!same_shape && lhs_type.getNumElements() != 1 &&
+        rhs_type.getNumElements() != 1) {
+        return false;
+    }
+    auto lhs = get_f32(first->param), rhs = get_f32(second.param);
+    auto type = lhs.size() >= rhs.size() ? lhs_type : rhs_type;
+    std::vector<float> data(std::max(lhs.size(), rhs.size()));
+    bool identity = true;
+    for (size_t i = 0; i < data.size(); ++i) {
+        float a = lhs[lhs.size() == 1 ? 0 : i], b = rhs[rhs.size() == 1 ? 0 : i];
+        if (first->negate) {
+            a = -a;
+        }
+        if (second.negate) {
+            b = -b;
+        }
+        data[i] = first->is_mul ? a * b : a + b;
+        identity &= data[i] == (first->is_mul ? 1.f : 0.f);
+    }
+    Value input = first->input;
+    Value result = input;
+    if (!identity) {
+        OpBuilder builder(second.op);
+        Value param = create_f32_param(
+                module, builder, first->param, "_affine", type.getShape(), data);
+        result = builder.create<MGB::Elemwise>(
+                second.op->getLoc(), second.op.getResult().getType(),
+                std::vector<Value>{input, param},
+                first->is_mul ? ElemMode::MUL : ElemMode::ADD);
+    }
+    Value lhs_param = first->param, rhs_param = second.param;
+    second.op.getResult().replaceAllUsesWith(result);
+    second.op->erase();
+    first->op->erase();
+    release_value(module, lhs_param);
+    release_value(module, rhs_param);
+    LOG_DEBUG << (identity ? "Cancel" : "Merge") << " consecutive constant "
+              << (first->is_mul ? "scale" : "shift") << "\n";
+    return true;
+}
+
+bool fold_affine(ModuleOp module, Operation* op) {
+    auto affine = get_affine(op);
+    if (!affine) {
+        return false;
+    }
+    return merge_affine(module, affine.getValue()) ||
+           fold_affine_after_conv(module, affine.getValue()) ||
+           fold_affine_before_conv(module, affine.getValue()) ||
+           fold_affine_matmul(module, affine.getValue());
+}
+
+class MGBAffineFoldPass final : public MGBAffineFoldPassBase<MGBAffineFoldPass> {
+    void runOnOperation() override {
+        ModuleOp module = getOperation();
+        //! the walk is restarted after every fold, as the ops around the
+        //! folded one are erased or replaced
+        bool changed = true;
+        while (changed) {
+            changed = false;
+            module.walk([&](MGB::Elemwise op) {
+                if (fold_affine(module, op)) {
+                    changed = true;
+                    return WalkResult::interrupt();
+                }
+                return WalkResult::advance();
+            });
+        }
+    }
+};
+
+}  // namespace
+
+std::unique_ptr<OperationPass<ModuleOp>> createMGBAffineFoldPass() {
+    return std::make_unique<MGBAffineFoldPass>();
+}
+}  // namespace mlir
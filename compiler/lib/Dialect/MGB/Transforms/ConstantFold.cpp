@@ -0,0 +1,581 @@
+#include <cmath>
+#include <cstring>
+#include <string>
+#include <vector>
+#include "compiler/Common/Logger.h"
+#include "compiler/Dialect/MGB/IR/MGBDialect.h"
+#include "compiler/Dialect/MGB/Transforms/Passes.h"
+#include "ParamHelper.h"
+#include "llvm/ADT/SetVector.h"
+#include "llvm/Support/Casting.h"
+#include "mlir/IR/BuiltinAttributes.h"
+#include "mlir/IR/BuiltinTypes.h"
+
+#include "mlir/Dialect/StandardOps/IR/Ops.h"
+using namespace megcc;
+namespace mlir {
+namespace {
+
+#define GEN_PASS_CLASSES
+#include "compiler/Dialect/MGB/Transforms/Passes.h.inc"
+
+//! a folded result larger than all of its inputs is only kept when it is
+//! small, so that broadcasting a scalar does not blow up the model
+constexpr size_t kMaxFoldGrowBytes = 64 * 1024;
+
+template <typename T>
+T load(const char* ptr) {
+    T val;
+    memcpy(&val, ptr, sizeof(T));
+    return val;
+}
+
+template <typename T>
+void store(char* ptr, T val) {
+    memcpy(ptr, &val, sizeof(T));
+}
+
+bool is_quant(Type type) {
+    auto int_type = type.dyn_cast<IntegerType>();
+    return int_type && int_type.isQuant();
+}
+
+//! f32 and the integers of 8, 16 and 32 bits, a quantized integer holds the
+//! stored value and its scale is only applied by TypeCvt
+bool is_numeric(Type type) {
+    if (type.isF32()) {
+        return true;
+    }
+    auto int_type = type.dyn_cast<IntegerType>();
+    return int_type && (int_type.getWidth() == 8 || int_type.getWidth() == 16 ||
+                        int_type.getWidth() == 32);
+}
+
+/*!
+ * a constant evaluated on the host, the data is kept as the raw bytes of the
+ * element type, so the layout oprs work for every dtype and only the
+ * arithmetic is limited to the numeric types
+ */
+struct HostTensor {
+    RankedTensorType type;
+    std::vector<char> raw;
+
+    size_t elem_bytes() const { return type.getElementTypeBitWidth() / 8; }
+    size_t size() const { return type.getNumElements(); }
+
+    double get(size_t idx) const {
+        auto elem = type.getElementType();
+        const char* ptr = raw.data() + idx * elem_bytes();
+        if (elem.isF32()) {
+            return load<float>(ptr);
+        }
+        bool is_unsigned = elem.cast<IntegerType>().isUnsigned();
+        switch (elem.getIntOrFloatBitWidth()) {
+            case 8:
+                return is_unsigned ? load<uint8_t>(ptr) : load<int8_t>(ptr);
+            case 16:
+                return is_unsigned ? load<uint16_t>(ptr) : load<int16_t>(ptr);
+            default:
+                CC_ASSERT(elem.getIntOrFloatBitWidth() == 32);
+                return is_unsigned ? load<uint32_t>(ptr) : load<int32_t>(ptr);
+        }
+    }
+
+    //! the integer is truncated and wrapped as the C conversion of the kernel,
+    //! return false when the value can not be represented at all
+    bool set(size_t idx, double val) {
+        auto elem = type.getElementType();
+        char* ptr = raw.data() + idx * elem_bytes();
+        if (elem.isF32()) {
+            store<float>(ptr, val);
+            return true;
+        }
+        if (!std::isfinite(val) || std::fabs(val) >= 9.2e18) {
+            return false;
+        }
+        int64_t int_val = static_cast<int64_t>(val);
+        switch (elem.getIntOrFloatBitWidth()) {
+            case 8:
+                store<uint8_t>(ptr, static_cast<uint8_t>(int_val));
+                break;
+            case 16:
+                store<uint16_t>(ptr, static_cast<uint16_t>(int_val));
+                break;
+            default:
+                store<uint32_t>(ptr, static_cast<uint32_t>(int_val));
+                break;
+        }
+        return true;
+    }
+
+    static HostTensor empty(RankedTensorType type) {
+        size_t nr_bytes = type.getNumElements() * type.getElementTypeBitWidth() / 8;
+        return {type, std::vector<char>(nr_bytes)};
+    }
+};
+
+Optional<RankedTensorType> get_static_type(Value value) {
+    auto type = value.getType().dyn_cast<RankedTensorType>();
+    if (!type || !type.hasStaticShape() || type.getNumElements() == 0 ||
+        type.getElementTypeBitWidth() % 8 != 0) {
+        return {};
+    }
+    return type;
+}
+
+Optional<HostTensor> get_constant(Value value) {
+    if (!MGB::is_static_param(value)) {
+        return {};
+    }
+    auto storage =
+            MGB::get_param_storage(value.getDefiningOp<MGB::ParamProvider>());
+    //! the per channel scales are bound to the layout of the param
+    if (storage.scalesAttr()) {
+        return {};
+    }
+    return HostTensor{
+            storage.type().cast<RankedTensorType>(), MGB::get_param_raw(storage)};
+}
+
+SmallVector<int64_t> contiguous_stride(ArrayRef<int64_t> shape) {
+    SmallVector<int64_t> stride(shape.size(), 1);
+    for (int i = static_cast<int>(shape.size()) - 2; i >= 0; --i) {
+        stride[i] = stride[i + 1] * shape[i + 1];
+    }
+    return stride;
+}
+
+//! the src index of every dst element in order, the dst element at
+//! (i0, i1, ...) reads the src element sum(ik * stride[k])
+std::vector<size_t> gather_index(ArrayRef<int64_t> shape, ArrayRef<int64_t> stride) {
+    int64_t nr_elem = 1;
+    for (auto dim : shape) {
+        nr_elem *= dim;
+    }
+    std::vector<size_t> index(nr_elem);
+    SmallVector<int64_t> pos(shape.size(), 0);
+    int64_t offset = 0;
+    for (int64_t i = 0; i < nr_elem; ++i) {
+        index[i] = offset;
+        for (int k = static_cast<int>(shape.size()) - 1; k >= 0; --k) {
+            ++pos[k];
+            offset += stride[k];
+            if (pos[k] < shape[k]) {
+                break;
+            }
+            offset -= pos[k] * stride[k];
+            pos[k] = 0;
+        }
+    }
+    return index;
+}
+
+//! broadcast src to dst in numpy style, the trailing axes are aligned
+Optional<std::vector<size_t>> broadcast_index(
+        ArrayRef<int64_t> src, ArrayRef<int64_t> dst) {
+    if (src.size() > dst.size()) {
+        return {};
+    }
+    size_t offset = dst.size() - src.size();
+    SmallVector<int64_t> stride(dst.size(), 0);
+    int64_t step = 1;
+    for (int i = static_cast<int>(src.size()) - 1; i >= 0; --i) {
+        if (src[i] != 1 && src[i] != dst[i + offset]) {
+            return {};
+        }
+        stride[i + offset] = src[i] == 1 ? 0 : step;
+        step *= src[i];
+    }
+    return gather_index(dst, stride);
+}
+
+HostTensor gather(
+        const HostTensor& src, const std::vector<size_t>& index, RankedTensorType dst) {
+    auto ret = HostTensor::empty(dst);
+    size_t elem_bytes = src.elem_bytes();
+    for (size_t i = 0; i < index.size(); ++i) {
+        memcpy(ret.raw.data() + i * elem_bytes, src.raw.data() + index[i] * elem_bytes,
+               elem_bytes);
+    }
+    return ret;
+}
+
+Optional<HostTensor> fold_reshape(
+        const std::vector<HostTensor>& inputs, RankedTensorType dst) {
+    auto& src = inputs[0];
+    if (src.type.getElementType() != dst.getElementType() ||
+        src.size() != static_cast<size_t>(dst.getNumElements())) {
+        return {};
+    }
+    return HostTensor{dst, src.raw};
+}
+
+//! the axis of pattern -1 is a new axis of size 1, the axes of size 1 missing
+//! in pattern are removed
+Optional<HostTensor> fold_dimshuffle(
+        MGB::Dimshuffle op, const std::vector<HostTensor>& inputs,
+        RankedTensorType dst) {
+    auto& src = inputs[0];
+    auto pattern = op.pattern();
+    auto src_shape = src.type.getShape();
+    if (src.type.getElementType() != dst.getElementType() ||
+        pattern.size() != static_cast<size_t>(dst.getRank()) ||
+        src.size() != static_cast<size_t>(dst.getNumElements())) {
+        return {};
+    }
+    auto src_stride = contiguous_stride(src_shape);
+    SmallVector<int64_t> stride;
+    for (size_t i = 0; i < pattern.size(); ++i) {
+        if (pattern[i] >= src.type.getRank() ||
+            (pattern[i] < 0 ? 1 : src_shape[pattern[i]]) != dst.getDimSize(i)) {
+            return {};
+        }
+        stride.push_back(pattern[i] < 0 ? 0 : src_stride[pattern[i]]);
+    }
+    return gather(src, gather_index(dst.getShape(), stride), dst);
+}
+
+Optional<HostTensor> fold_broadcast(
+        const std::vector<HostTensor>& inputs, RankedTensorType dst) {
+    auto& src = inputs[0];
+    auto index = broadcast_index(src.type.getShape(), dst.getShape());
+    if (src.type.getElementType() != dst.getElementType() || !index) {
+        return {};
+    }
+    return gather(src, index.getValue(), dst);
+}
+
+Optional<HostTensor> fold_concat(
+        MGB::Concat op, const std::vector<HostTensor>& inputs, RankedTensorType dst) {
+    int axis = op.axis() < 0 ? op.axis() + dst.getRank() : op.axis();
+    if (axis < 0 || axis >= dst.getRank()) {
+        return {};
+    }
+    int64_t axis_size = 0;
+    for (auto&& input : inputs) {
+        if (input.type.getElementType() != dst.getElementType() ||
+            input.type.getRank() != dst.getRank()) {
+            return {};
+        }
+        axis_size += input.type.getDimSize(axis);
+    }
+    if (axis_size != dst.getDimSize(axis)) {
+        return {};
+    }
+    int64_t outer = 1;
+    for (int i = 0; i < axis; ++i) {
+        outer *= dst.getDimSize(i);
+    }
+    HostTensor ret{dst, {}};
+    ret.raw.reserve(dst.getNumElements() * ret.elem_bytes());
+    for (int64_t o = 0; o < outer; ++o) {
+        for (auto&& input : inputs) {
+            size_t chunk = input.raw.size() / outer;
+            auto begin = input.raw.begin() + o * chunk;
+            ret.raw.insert(ret.raw.end(), begin, begin + chunk);
+        }
+    }
+    return ret;
+}
+
+//! the same conversion as the TypeCvt kernel: the quantized value is scaled in
+//! float, the result is rounded and saturated to the range of the signedness
+//! and the bit width when the dst is quantized and truncated when the dst is a
+//! plain integer
+Optional<HostTensor> fold_typecvt(
+        MGB::TypeCvt op, const std::vector<HostTensor>& inputs,
+        RankedTensorType dst) {
+    auto& src = inputs[0];
+    auto src_elem = src.type.getElementType(), dst_elem = dst.getElementType();
+    if (op.i_zero() != 0 || op.o_zero() != 0 || !is_numeric(src_elem) ||
+        !is_numeric(dst_elem) ||
+        src.size() != static_cast<size_t>(dst.getNumElements())) {
+        return {};
+    }
+    double qmin = 0, qmax = 0;
+    if (is_quant(dst_elem)) {
+        unsigned width = dst_elem.getIntOrFloatBitWidth();
+        if (dst_elem.cast<IntegerType>().isUnsigned()) {
+            qmax = std::ldexp(1.0, width) - 1;
+        } else {
+            qmin = -std::ldexp(1.0, width - 1);
+            qmax = std::ldexp(1.0, width - 1) - 1;
+        }
+    }
+    auto ret = HostTensor::empty(dst);
+    for (size_t i = 0; i < src.size(); ++i) {
+        double val = src.get(i);
+        if (is_quant(src_elem)) {
+            val = static_cast<float>(val) *
+                  static_cast<float>(src_elem.cast<IntegerType>().getScale());
+        }
+        if (is_quant(dst_elem)) {
+            auto int_type = dst_elem.cast<IntegerType>();
+            val = std::round(static_cast<float>(val) / int_type.getScale());
+            val = std::min(std::max(val, qmin), qmax);
+        }
+        if (!ret.set(i, val)) {
+            return {};
+        }
+    }
+    return ret;
+}
+
+Optional<double> eval_elemwise(
+        ::megdnn::param::Elemwise::Mode mode, const double* x, bool is_int) {
+    using Mode = ::megdnn::param::Elemwise::Mode;
+    auto sigmoid = [](double v) { return 1 / (1 + std::exp(-v)); };
+    auto h_swish = [](double v) { return v * std::min(std::max(v + 3, 0.0), 6.0) / 6; };
+    switch (mode) {
+        case Mode::RELU:
+            return std::max(x[0], 0.0);
+        case Mode::ABS:
+            return std::fabs(x[0]);
+        case Mode::NEGATE:
+            return -x[0];
+        case Mode::CEIL:
+            return std::ceil(x[0]);
+        case Mode::FLOOR:
+            return std::floor(x[0]);
+        case Mode::ROUND:
+            return std::round(x[0]);
+        case Mode::EXP:
+            return std::exp(x[0]);
+        case Mode::LOG:
+            return std::log(x[0]);
+        case Mode::SIGMOID:
+            return sigmoid(x[0]);
+        case Mode::TANH:
+            return std::tanh(x[0]);
+        case Mode::H_SWISH:
+            return h_swish(x[0]);
+        case Mode::ADD:
+            return x[0] + x[1];
+        case Mode::SUB:
+            return x[0] - x[1];
+        case Mode::MUL:
+            return x[0] * x[1];
+        case Mode::MAX:
+            return std::max(x[0], x[1]);
+        case Mode::MIN:
+            return std::min(x[0], x[1]);
+        case Mode::POW:
+            return std::pow(x[0], x[1]);
+        case Mode::TRUE_DIV:
+            if (is_int && x[1] == 0) {
+                return {};
+            }
+            return x[0] / x[1];
+        case Mode::FLOOR_DIV:
+        case Mode::MOD: {
+            if (!is_int) {
+                return mode == Mode::MOD ? std::fmod(x[0], x[1])
+                                         : std::floor(x[0] / x[1]);
+            }
+            int64_t a = x[0], b = x[1];
+            if (b == 0) {
+                return {};
+            }
+            if (mode == Mode::MOD) {
+                return static_cast<double>(a % b);
+            }
+            int64_t quot = a / b;
+            return static_cast<double>(
+                    quot - (a % b != 0 && ((a < 0) != (b < 0)) ? 1 : 0));
+        }
+        case Mode::FUSE_ADD_RELU:
+            return std::max(x[0] + x[1], 0.0);
+        case Mode::FUSE_ADD_SIGMOID:
+            return sigmoid(x[0] + x[1]);
+        case Mode::FUSE_ADD_TANH:
+            return std::tanh(x[0] + x[1]);
+        case Mode::FUSE_ADD_H_SWISH:
+            return h_swish(x[0] + x[1]);
+        case Mode::FUSE_MUL_ADD3:
+            return x[0] * x[1] + x[2];
+        default:
+            return {};
+    }
+}
+
+Optional<HostTensor> fold_elemwise(
+        MGB::Elemwise op, const std::vector<HostTensor>& inputs,
+        RankedTensorType dst) {
+    if (inputs.empty() || inputs.size() > 3 || !is_numeric(dst.getElementType()) ||
+        is_quant(dst.getElementType())) {
+        return {};
+    }
+    bool is_int = true;
+    std::vector<std::vector<size_t>> index;
+    for (auto&& input : inputs) {
+        auto elem = input.type.getElementType();
+        auto input_index = broadcast_index(input.type.getShape(), dst.getShape());
+        if (!is_numeric(elem) || is_quant(elem) || !input_index) {
+            return {};
+        }
+        is_int &= elem.isa<IntegerType>();
+        index.push_back(std::move(input_index.getValue()));
+    }
+    auto ret = HostTensor::empty(dst);
+    double x[3];
+    for (size_t i = 0; i < ret.size(); ++i) {
+        for (size_t k = 0; k < inputs.size(); ++k) {
+            x[k] = inputs[k].get(index[k][i]);
+        }
+        auto val = eval_elemwise(op.mode(), x, is_int);
+        if (!val || !ret.set(i, val.getValue())) {
+            return {};
+        }
+    }
+    return ret;
+}
+
+Optional<HostTensor> fold_powc(
+        MGB::PowC op, const std::vector<HostTensor>& inputs, RankedTensorType dst) {
+    auto& src = inputs[0];
+    if (!src.type.getElementType().isF32() || !dst.getElementType().isF32() ||
+        src.size() != static_cast<size_t>(dst.getNumElements())) {
+        return {};
+    }
+    auto ret = HostTensor::empty(dst);
+    for (size_t i = 0; i < src.size(); ++i) {
+        ret.set(i, std::pow(static_cast<float>(src.get(i)), op.exp()));
+    }
+    return ret;
+}
+
+//! the shape of a static value is known at compile time even though the
+//! value itself is computed at runtime
+Optional<HostTensor> fold_get_var_shape(MGB::GetVarShape op, RankedTensorType dst) {
+    auto src = op->getOperand(0).getType().dyn_cast<RankedTensorType>();
+    if (!src || !src.hasStaticShape() || !dst.getElementType().isa<IntegerType>() ||
+        is_quant(dst.getElementType())) {
+        return {};
+    }
+    SmallVector<int64_t> shape(src.getShape().begin(), src.getShape().end());
+    if (op.axis() != ::megdnn::param::OptionalAxisV1::INVALID_AXIS) {
+        int axis = op.axis() < 0 ? op.axis() + src.getRank() : op.axis();
+        if (axis < 0 || axis >= src.getRank()) {
+            return {};
+        }
+        shape = {src.getDimSize(axis)};
+    }
+    if (static_cast<int64_t>(shape.size()) != dst.getNumElements()) {
+        return {};
+    }
+    auto ret = HostTensor::empty(dst);
+    for (size_t i = 0; i < shape.size(); ++i) {
+        ret.set(i, shape[i]);
+    }
+    return ret;
+}
+
+Optional<HostTensor> fold_op(
+        Operation* op, const std::vector<HostTensor>& inputs, RankedTensorType dst) {
+    if (llvm::isa<MGB::Reshape>(op)) {
+        return fold_reshape(inputs, dst);
+    }
+    if (auto dimshuffle = llvm::dyn_cast<MGB::Dimshuffle>(op)) {
+        return fold_dimshuffle(dimshuffle, inputs, dst);
+    }
+    if (llvm::isa<MGB::Broadcast>(op)) {
+        return fold_broadcast(inputs, dst);
+    }
+    if (auto concat = llvm::dyn_cast<MGB::Concat>(op)) {
+        return fold_concat(concat, inputs, dst);
+    }
+    if (auto typecvt = llvm::dyn_cast<MGB::TypeCvt>(op)) {
+        return fold_typecvt(typecvt, inputs, dst);
+    }
+    if (auto elemwise = llvm::dyn_cast<MGB::Elemwise>(op)) {
+        return fold_elemwise(elemwise, inputs, dst);
+    }
+    if (auto powc = llvm::dyn_cast<MGB::PowC>(op)) {
+        return fold_powc(powc, inputs, dst);
+    }
+    return {};
+}
+
+//! replace the op by a new param when all the inputs are params, return
+//! whether the op is folded
+bool fold_constant(ModuleOp module, Operation* op) {
+    if (op->getNumResults() != 1 || op->getNumOperands() == 0 ||
+        !llvm::isa<
+                MGB::Reshape, MGB::Dimshuffle, MGB::Broadcast, MGB::Concat,
+                MGB::TypeCvt, MGB::Elemwise, MGB::PowC, MGB::GetVarShape>(op)) {
+        return false;
+    }
+    auto dst = get_static_type(op->getResult(0));
+    if (!dst) {
+        return false;
+    }
+    Optional<HostTensor> result;
+    std::string name = "shape";
+    if (auto get_var_shape = llvm::dyn_cast<MGB::GetVarShape>(op)) {
+        result = fold_get_var_shape(get_var_shape, dst.getValue());
+    } else {
+        std::vector<HostTensor> inputs;
+        size_t input_bytes = 0;
+        for (auto operand : op->getOperands()) {
+            auto input = get_constant(operand);
+            if (!input) {
+                return false;
+            }
+            input_bytes += input->raw.size();
+            inputs.push_back(std::move(input.getValue()));
+        }
+        size_t dst_bytes = dst->getNumElements() * dst->getElementTypeBitWidth() / 8;
+        if (dst_bytes > std::max(input_bytes, kMaxFoldGrowBytes)) {
+            return false;
+        }
+        name = MGB::get_param_storage(
+                       op->getOperand(0).getDefiningOp<MGB::ParamProvider>())
+                       .sym_name()
+                       .str();
+        result = fold_op(op, inputs, dst.getValue());
+    }
+    if (!result) {
+        return false;
+    }
+    auto storage = MGB::create_param_storage(
+            module, name, "_fold", result->type, result->raw);
+    LOG_DEBUG << "Fold constant " << op->getName().getStringRef().str() << " to "
+              << storage.sym_name().str() << "\n";
+    OpBuilder builder(op);
+    Value value = builder.create<MGB::ParamProvider>(op->getLoc(), storage);
+    op->getResult(0).replaceAllUsesWith(value);
+    llvm::SetVector<Operation*> params;
+    for (auto operand : op->getOperands()) {
+        if (auto provider = operand.getDefiningOp<MGB::ParamProvider>()) {
+            params.insert(provider);
+        }
+    }
+    op->erase();
+    for (auto param : params) {
+        MGB::release_param(module, llvm::cast<MGB::ParamProvider>(param));
+    }
+    return true;
+}
+
+class MGBConstantFoldPass final : public MGBConstantFoldPassBase<MGBConstantFoldPass> {
+    void runOnOperation() override {
+        ModuleOp module = getOperation();
+        //! the ops are visited in order, so a folded result is already a param
+        //! when its users are visited and the whole constant subgraph is folded
+        //! in one walk
+        for (auto func : module.getOps<FuncOp>()) {
+            for (auto& block : func.getBody()) {
+                for (auto& op : llvm::make_early_inc_range(block)) {
+                    fold_constant(module, &op);
+                }
+            }
+        }
+    }
+};
+
+}  // namespace
+
+std::unique_ptr<OperationPass<ModuleOp>> createMGBConstantFoldPass() {
+    return std::make_unique<MGBConstantFoldPass>();
+}
+}  // namespace mlir
@@ -0,0 +1,324 @@
+#include <string>
+#include <vector>
+#include "compiler/Common/Logger.h"
+#include "compiler/Dialect/MGB/IR/MGBDialect.h"
+#include "compiler/Dialect/MGB/Transforms/Passes.h"
+#include "ParamHelper.h"
+#include "llvm/ADT/SetVector.h"
+#include "llvm/Support/Casting.h"
+#include "mlir/IR/BuiltinAttributes.h"
+#include "mlir/IR/BuiltinTypes.h"
+#include "mlir/IR/SymbolTable.h"
+
+#include "mlir/Dialect/StandardOps/IR/Ops.h"
+using namespace megcc;
+namespace mlir {
+namespace {
+
+#define GEN_PASS_CLASSES
+#include "compiler/Dialect/MGB/Transforms/Passes.h.inc"
+
+//! a sibling conv or matmul reading the same input, the params of the group
+//! are concatenated along the output channel axis, which is `axis[i]` of the
+//! i-th param and `out_axis` of the result
+struct SiblingOp {
+    Operation* op;
+    SmallVector<MGB::ParamProvider, 2> params;
+    SmallVector<int, 2> axis;
+    int out_axis;
+};
+
+bool is_static_value(Value value) {
+    auto type = value.getType().dyn_cast<RankedTensorType>();
+    return type && type.hasStaticShape();
+}
+
+//! the per channel or per group scales are laid out along the output channel,
+//! so they can only be concatenated when the output channel is the first axis
+bool scales_ok(MGB::ParamProvider provider, int axis) {
+    return axis == 0 || !MGB::get_param_storage(provider).scalesAttr();
+}
+
+Optional<SiblingOp> get_sibling(OpOperand& use) {
+    auto op = use.getOwner();
+    if (use.getOperandNumber() != 0 || !is_static_value(op->getResult(0))) {
+        return {};
+    }
+    if (auto conv = llvm::dyn_cast<MGB::ConvBias>(op)) {
+        //! the dense filter of the NCHW and NCHWxx formats is (OC[/pack],
+        //! IC[/pack], FH, FW, ...) and the output channel is axis 1 of the
+        //! result, the z input of the ConvBias is not fused
+        using Format = ::megdnn::param::ConvBias::Format;
+        auto format = conv.format();
+        bool format_ok = format == Format::NCHW || format == Format::NCHW44 ||
+                         format == Format::NCHW44_DOT || format == Format::NCHW88;
+        //! the channel split of a batched result is not contiguous, which
+        //! costs a relayout of every split larger than the saved conv
+        bool batch_ok =
+                op->getResult(0).getType().cast<RankedTensorType>().getDimSize(0) ==
+                1;
+        auto operands = conv.inputs();
+        if (!format_ok || !batch_ok ||
+            conv.sparse() != ::megdnn::param::ConvBias::Sparse::DENSE ||
+            operands.size() < 2 || operands.size() > 3) {
+            return {};
+        }
+        SiblingOp ret{op, {}, {}, 1};
+        for (size_t i = 1; i < operands.size(); ++i) {
+            if (!MGB::is_static_param(operands[i])) {
+                return {};
+            }
+            ret.params.push_back(operands[i].getDefiningOp<MGB::ParamProvider>());
+            ret.axis.push_back(i == 1 ? 0 : 1);
+        }
+        if (!scales_ok(ret.params[0], 0)) {
+            return {};
+        }
+        return ret;
+    }
+    if (auto matmul = llvm::dyn_cast<MGB::MatrixMul>(op)) {
+        if (matmul.format() != ::megdnn::param::MatrixMul::Format::DEFAULT ||
+            !MGB::is_static_param(matmul.b()) || !is_static_value(matmul.a())) {
+            return {};
+        }
+        int axis = matmul.transposeB() ? 0 : 1;
+        auto provider = matmul.b().getDefiningOp<MGB::ParamProvider>();
+        if (!scales_ok(provider, axis)) {
+            return {};
+        }
+        return SiblingOp{op, {provider}, {axis}, 1};
+    }
+    return {};
+}
+
+//! all the shapes but the concat axis should be equal, the scales should
+//! cover the same number of values for every output channel
+bool param_compatible(MGB::ParamProvider lhs, MGB::ParamProvider rhs, int axis) {
+    auto lhs_storage = MGB::get_param_storage(lhs);
+    auto rhs_storage = MGB::get_param_storage(rhs);
+    auto lhs_type = lhs_storage.type().cast<RankedTensorType>();
+    auto rhs_type = rhs_storage.type().cast<RankedTensorType>();
+    if (lhs_type.getElementType() != rhs_type.getElementType() ||
+        lhs_type.getRank() != rhs_type.getRank()) {
+        return false;
+    }
+    for (int64_t i = 0; i < lhs_type.getRank(); ++i) {
+        if (i != axis && lhs_type.getDimSize(i) != rhs_type.getDimSize(i)) {
+            return false;
+        }
+    }
+    auto lhs_scales = lhs_storage.scalesAttr(), rhs_scales = rhs_storage.scalesAttr();
+    if (!lhs_scales || !rhs_scales) {
+        return !lhs_scales && !rhs_scales;
+    }
+    return lhs_scales.size() * rhs_type.getDimSize(axis) ==
+           rhs_scales.size() * lhs_type.getDimSize(axis);
+}
+
+bool compatible(const SiblingOp& lhs, const SiblingOp& rhs) {
+    if (lhs.op->getName() != rhs.op->getName() ||
+        lhs.op->getAttrDictionary() != rhs.op->getAttrDictionary() ||
+        lhs.op->getBlock() != rhs.op->getBlock() ||
+        lhs.params.size() != rhs.params.size()) {
+        return false;
+    }
+    auto lhs_type = lhs.op->getResult(0).getType().cast<RankedTensorType>();
+    auto rhs_type = rhs.op->getResult(0).getType().cast<RankedTensorType>();
+    if (lhs_type.getElementType() != rhs_type.getElementType() ||
+        lhs_type.getRank() != rhs_type.getRank()) {
+        return false;
+    }
+    for (int64_t i = 0; i < lhs_type.getRank(); ++i) {
+        if (i != lhs.out_axis && lhs_type.getDimSize(i) != rhs_type.getDimSize(i)) {
+            return false;
+        }
+    }
+    for (size_t i = 0; i < lhs.params.size(); ++i) {
+        if (!param_compatible(lhs.params[i], rhs.params[i], lhs.axis[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+RankedTensorType concat_type(const std::vector<RankedTensorType>& types, int axis) {
+    SmallVector<int64_t> shape(types[0].getShape().begin(), types[0].getShape().end());
+    shape[axis] = 0;
+    for (auto&& type : types) {
+        shape[axis] += type.getDimSize(axis);
+    }
+    return RankedTensorType::get(shape, types[0].getElementType());
+}
+
+//! concatenate the raw data of the params, the params with the same symbol
+//! are allowed, such as the same weight shared by two siblings
+MGB::ParamStorage concat_params(
+        ModuleOp module, const std::vector<MGB::ParamProvider>& params, int axis) {
+    std::vector<RankedTensorType> types;
+    for (auto&& param : params) {
+        types.push_back(
+                MGB::get_param_storage(param).type().cast<RankedTensorType>());
+    }
+    auto dst_type = concat_type(types, axis);
+    size_t elem_bytes = dst_type.getElementTypeBitWidth() / 8;
+    int64_t outer = 1;
+    for (int i = 0; i < axis; ++i) {
+        outer *= dst_type.getDimSize(i);
+    }
+    std::vector<std::vector<char>> srcs;
+    std::vector<size_t> chunks;
+    std::vector<float> scales;
+    for (size_t i = 0; i < params.size(); ++i) {
+        auto storage = MGB::get_param_storage(params[i]);
+        auto data = MGB::get_param_raw(storage);
+        size_t nr_bytes = data.size();
+        chunks.push_back(nr_bytes / outer);
+        srcs.push_back(std::move(data));
+        if (auto attr = storage.scalesAttr()) {
+            for (auto&& scale : attr.getAsRange<FloatAttr>()) {
+                scales.push_back(scale.getValueAsDouble());
+            }
+        }
+    }
+    std::vector<char> dst;
+    dst.reserve(dst_type.getNumElements() * elem_bytes);
+    for (int64_t o = 0; o < outer; ++o) {
+        for (size_t i = 0; i < srcs.size(); ++i) {
+            auto begin = srcs[i].begin() + o * chunks[i];
+            dst.insert(dst.end(), begin, begin + chunks[i]);
+        }
+    }
+
+    Builder builder(module.getContext());
+    return MGB::create_param_storage(
+            module, MGB::get_param_storage(params[0]).sym_name().str(), "_hfuse",
+            dst_type, dst,
+            scales.empty() ? ArrayAttr() : builder.getF32ArrayAttr(scales));
+}
+
+void fuse_siblings(ModuleOp module, std::vector<SiblingOp>& group) {
+    //! the fused op is placed at the first sibling, where the input and all the
+    //! params are ready
+    auto first = group[0].op;
+    for (auto&& sibling : group) {
+        if (sibling.op->isBeforeInBlock(first)) {
+            first = sibling.op;
+        }
+    }
+    auto& head = group[0];
+    OpBuilder builder(first);
+    SmallVector<Value, 3> operands{first->getOperand(0)};
+    for (size_t i = 0; i < head.params.size(); ++i) {
+        std::vector<MGB::ParamProvider> params;
+        for (auto&& sibling : group) {
+            params.push_back(sibling.params[i]);
+        }
+        auto storage = concat_params(module, params, head.axis[i]);
+        operands.push_back(
+                builder.create<MGB::ParamProvider>(first->getLoc(), storage));
+    }
+    std::vector<RankedTensorType> out_types;
+    for (auto&& sibling : group) {
+        out_types.push_back(
+                sibling.op->getResult(0).getType().cast<RankedTensorType>());
+    }
+    OperationState state(
+            first->getLoc(), first->getName(), operands,
+            TypeRange{concat_type(out_types, head.out_axis)}, first->getAttrs());
+    Operation* fused = builder.create(state);
+    LOG_DEBUG << "Horizontal fuse " << group.size() << " "
+              << first->getName().getStringRef().str() << " oprs\n";
+
+    //! split the result along the output channel, the subtensor is forwarded
+    //! as a view of the fused result, and it is only relayouted when the
+    //! consumer requires a contiguous input
+    int32_t begin = 0;
+    for (size_t i = 0; i < group.size(); ++i) {
+        int32_t end = begin + out_types[i].getDimSize(head.out_axis);
+        std::vector<std::tuple<int32_t, int32_t, int32_t, int32_t, int32_t>> desc{
+                {head.out_axis, begin, end, 1, -1}};
+        std::vector<std::tuple<int32_t, int32_t, int32_t, int32_t, int32_t>> flag{
+                {0, 0, 0, -1, -1}};
+        Value split = builder.create<MGB::Subtensor>(
+                first->getLoc(), out_types[i], ValueRange{fused->getResult(0)}, desc,
+                flag);
+        group[i].op->getResult(0).replaceAllUsesWith(split);
+        begin = end;
+    }
+    //! the siblings may share the same param
+    llvm::SetVector<Operation*> params;
+    for (auto&& sibling : group) {
+        sibling.op->erase();
+        for (auto&& param : sibling.params) {
+            params.insert(param);
+        }
+    }
+    for (auto param : params) {
+        MGB::release_param(module, llvm::cast<MGB::ParamProvider>(param));
+    }
+}
+
+//! fuse the largest group of compatible siblings reading the value, return
+//! whether the graph is changed
+bool fuse_users(ModuleOp module, Value value) {
+    std::vector<std::vector<SiblingOp>> groups;
+    for (auto&& use : value.getUses()) {
+        auto sibling = get_sibling(use);
+        if (!sibling) {
+            continue;
+        }
+        bool found = false;
+        for (auto&& group : groups) {
+            if (compatible(group[0], sibling.getValue())) {
+                group.push_back(sibling.getValue());
+                found = true;
+                break;
+            }
+        }
+        if (!found) {
+            groups.push_back({sibling.getValue()});
+        }
+    }
+    for (auto&& group : groups) {
+        if (group.size() > 1) {
+            fuse_siblings(module, group);
+            return true;
+        }
+    }
+    return false;
+}
+
+class MGBHorizontalFusePass final
+        : public MGBHorizontalFusePassBase<MGBHorizontalFusePass> {
+    void runOnOperation() override {
+        ModuleOp module = getOperation();
+        //! the walk is restarted after every fusion, as the fused ops are
+        //! erased and the split results may have siblings again
+        bool changed = true;
+        while (changed) {
+            changed = false;
+            module.walk([&](Operation* op) {
+                SmallVector<Value> values(
+                        op->getResults().begin(), op->getResults().end());
+                if (auto func = llvm::dyn_cast<FuncOp>(op)) {
+                    auto args = func.getArguments();
+                    values.append(args.begin(), args.end());
+                }
+                for (auto value : values) {
+                    if (fuse_users(module, value)) {
+                        changed = true;
+                        return WalkResult::interrupt();
+                    }
+                }
+                return WalkResult::advance();
+            });
+        }
+    }
+};
+
+}  // namespace
+
+std::unique_ptr<OperationPass<ModuleOp>> createMGBHorizontalFusePass() {
+    return std::make_unique<MGBHorizontalFusePass>();
+}
+}  // namespace mlir
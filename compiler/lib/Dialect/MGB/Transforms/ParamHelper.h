@@ -0,0 +1,94 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include "compiler/Common/Logger.h"
+#include "compiler/Dialect/MGB/IR/MGBDialect.h"
+#include "mlir/IR/BuiltinAttributes.h"
+#include "mlir/IR/BuiltinOps.h"
+#include "mlir/IR/BuiltinTypes.h"
+#include "mlir/IR/SymbolTable.h"
+
+namespace mlir {
+namespace MGB {
+
+static inline ParamStorage get_param_storage(ParamProvider provider) {
+    return SymbolTable::lookupNearestSymbolFrom<ParamStorage>(
+            provider, provider.nameAttr());
+}
+
+//! the param with dense value and static shape whose element is byte aligned
+static inline bool is_static_param(Value value) {
+    auto provider = value.getDefiningOp<ParamProvider>();
+    if (!provider) {
+        return false;
+    }
+    auto storage = get_param_storage(provider);
+    auto type = storage.type().dyn_cast<RankedTensorType>();
+    return storage.value().isa<DenseElementsAttr>() && type && type.hasStaticShape() &&
+           type.getElementTypeBitWidth() % 8 == 0;
+}
+
+//! the raw data of the static param, the splat value is expanded
+static inline std::vector<char> get_param_raw(ParamStorage storage) {
+    auto type = storage.type().cast<RankedTensorType>();
+    auto dense = storage.value().cast<DenseElementsAttr>();
+    auto raw = dense.getRawData();
+    size_t elem_bytes = type.getElementTypeBitWidth() / 8;
+    size_t nr_bytes = type.getNumElements() * elem_bytes;
+    std::vector<char> data;
+    data.reserve(nr_bytes);
+    if (dense.isSplat()) {
+        for (size_t pos = 0; pos < nr_bytes; pos += elem_bytes) {
+            data.insert(data.end(), raw.begin(), raw.begin() + elem_bytes);
+        }
+    } else {
+        data.assign(raw.begin(), raw.end());
+    }
+    CC_ASSERT(data.size() == nr_bytes);
+    return data;
+}
+
+//! create a private param storage at the head of the module, the symbol is
+//! `base` + `suffix` with a number appended when the name is taken, a param
+//! rewritten again keeps the name of the one it starts from
+static inline ParamStorage create_param_storage(
+        ModuleOp module, std::string base, const std::string& suffix,
+        RankedTensorType type, ArrayRef<char> raw, ArrayAttr scales = {}) {
+    auto pos = base.rfind(suffix);
+    if (pos != std::string::npos &&
+        base.find_first_not_of("0123456789", pos + suffix.size()) ==
+                std::string::npos) {
+        base.resize(pos);
+    }
+    std::string name = base + suffix;
+    for (int id = 0; module.lookupSymbol(name); ++id) {
+        name = base + suffix + std::to_string(id);
+    }
+    OpBuilder builder(module.getBody(), module.getBody()->begin());
+    auto storage = builder.create<ParamStorage>(
+            builder.getUnknownLoc(), name,
+            DenseElementsAttr::getFromRawBuffer(type, raw, false), type, 1, scales);
+    storage.setPrivate();
+    return storage;
+}
+
+//! drop the param provider and its storage when there is no user left
+static inline void release_param(ModuleOp module, ParamProvider provider) {
+    if (!provider->use_empty()) {
+        return;
+    }
+    auto storage = get_param_storage(provider);
+    provider->erase();
+    if (SymbolTable::symbolKnownUseEmpty(storage, module)) {
+        storage->erase();
+    } else if (storage.user_count() > 1) {
+        Builder builder(module.getContext());
+        storage.user_countAttr(builder.getI32IntegerAttr(storage.user_count() - 1));
+    }
+}
+
+}  // namespace MGB
+}  // namespace mlir
+
+// vim: syntax=cpp.doxygen
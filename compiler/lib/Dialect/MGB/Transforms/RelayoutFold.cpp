@@ -0,0 +1,347 @@
+#include <algorithm>
+#include <numeric>
+#include <tuple>
+#include <vector>
+#include "compiler/Common/Logger.h"
+#include "compiler/Dialect/MGB/IR/MGBDialect.h"
+#include "compiler/Dialect/MGB/Transforms/Passes.h"
+#include "llvm/Support/Casting.h"
+#include "mlir/IR/BuiltinAttributes.h"
+#include "mlir/IR/BuiltinTypes.h"
+
+#include "mlir/Dialect/StandardOps/IR/Ops.h"
+using namespace megcc;
+namespace mlir {
+namespace {
+
+#define GEN_PASS_CLASSES
+#include "compiler/Dialect/MGB/Transforms/Passes.h.inc"
+
+bool is_static_value(Value value) {
+    auto type = value.getType().dyn_cast<RankedTensorType>();
+    return type && type.hasStaticShape();
+}
+
+std::vector<int64_t> get_shape(Value value) {
+    auto shape = value.getType().cast<RankedTensorType>().getShape();
+    return {shape.begin(), shape.end()};
+}
+
+//! the Dimshuffle or the Reshape to a static shape, which only moves data
+bool is_layout_op(Operation* op) {
+    if (!op || op->getNumOperands() != 1 || op->getNumResults() != 1 ||
+        !is_static_value(op->getOperand(0)) || !is_static_value(op->getResult(0))) {
+        return false;
+    }
+    return llvm::isa<MGB::Dimshuffle>(op) || llvm::isa<MGB::Reshape>(op);
+}
+
+/*!
+ * a chain of layout ops is equal to reshaping the input to `groups`, then
+ * permuting the groups by `perm` and reshaping to the output shape, the
+ * groups are the factors of the input laid out in the input order
+ */
+struct Relayout {
+    std::vector<int64_t> groups;
+    std::vector<int32_t> perm;
+};
+
+/*!
+ * every dim of the view is a list of atoms, the atoms are the factors of the
+ * input in the input order, the reshape splits the atoms when a new dim ends
+ * inside of one, and it fails when the atom can not be split evenly
+ */
+Optional<Relayout> compose_layout(
+        const std::vector<int64_t>& src, const std::vector<Operation*>& chain) {
+    std::vector<int64_t> sizes;
+    std::vector<int> order;
+    std::vector<std::vector<int>> view;
+    auto reset = [&](const std::vector<int64_t>& shape) {
+        sizes.clear();
+        order.clear();
+        view.clear();
+        for (auto size : shape) {
+            view.emplace_back();
+            if (size != 1) {
+                view.back().push_back(sizes.size());
+                order.push_back(sizes.size());
+                sizes.push_back(size);
+            }
+        }
+    };
+    auto flatten = [&]() {
+        std::vector<int> flat;
+        for (auto& dim : view) {
+            flat.insert(flat.end(), dim.begin(), dim.end());
+        }
+        return flat;
+    };
+    reset(src);
+    for (auto op : chain) {
+        std::vector<std::vector<int>> next;
+        if (auto shuffle = llvm::dyn_cast<MGB::Dimshuffle>(op)) {
+            std::vector<bool> used(view.size(), false);
+            for (auto axis : shuffle.pattern()) {
+                if (axis < 0) {
+                    next.emplace_back();
+                    continue;
+                }
+                if (axis >= static_cast<int32_t>(view.size())) {
+                    return {};
+                }
+                used[axis] = true;
+                next.push_back(view[axis]);
+            }
+            //! the dropped axis must be 1
+            for (size_t i = 0; i < view.size(); ++i) {
+                if (!used[i] && !view[i].empty()) {
+                    return {};
+                }
+            }
+            view = std::move(next);
+            continue;
+        }
+        auto shape = get_shape(op->getResult(0));
+        auto flat = flatten();
+        //! nothing is permuted yet, so the prefix is a reshape of the input
+        if (flat == order) {
+            reset(shape);
+            continue;
+        }
+        size_t idx = 0;
+        for (auto size : shape) {
+            next.emplace_back();
+            int64_t need = size;
+            while (need > 1) {
+                if (idx >= flat.size()) {
+                    return {};
+                }
+                int atom = flat[idx];
+                if (sizes[atom] <= need) {
+                    if (need % sizes[atom] != 0) {
+                        return {};
+                    }
+                    need /= sizes[atom];
+                } else {
+                    if (sizes[atom] % need != 0) {
+                        return {};
+                    }
+                    int inner = sizes.size();
+                    sizes.push_back(sizes[atom] / need);
+                    sizes[atom] = need;
+                    auto it = std::find(order.begin(), order.end(), atom);
+                    order.insert(it + 1, inner);
+                    flat.insert(flat.begin() + idx + 1, inner);
+                    need = 1;
+                }
+                next.back().push_back(atom);
+                ++idx;
+            }
+        }
+        if (idx != flat.size()) {
+            return {};
+        }
+        view = std::move(next);
+    }
+    //! the atoms adjacent in both the input and the output are merged
+    std::vector<int> pos(sizes.size());
+    for (size_t i = 0; i < order.size(); ++i) {
+        pos[order[i]] = i;
+    }
+    auto flat = flatten();
+    std::vector<int> heads;
+    std::vector<int64_t> head_sizes;
+    for (size_t i = 0; i < flat.size(); ++i) {
+        if (i > 0 && pos[flat[i]] == pos[flat[i - 1]] + 1) {
+            head_sizes.back() *= sizes[flat[i]];
+            continue;
+        }
+        heads.push_back(pos[flat[i]]);
+        head_sizes.push_back(sizes[flat[i]]);
+    }
+    std::vector<int32_t> rank(heads.size());
+    std::iota(rank.begin(), rank.end(), 0);
+    std::sort(rank.begin(), rank.end(), [&](int32_t lhs, int32_t rhs) {
+        return heads[lhs] < heads[rhs];
+    });
+    Relayout relayout;
+    relayout.perm.resize(heads.size());
+    for (size_t i = 0; i < rank.size(); ++i) {
+        relayout.groups.push_back(head_sizes[rank[i]]);
+        relayout.perm[rank[i]] = i;
+    }
+    return relayout;
+}
+
+//! the Dimshuffle moves data when it is not forwarded, so fewer Dimshuffle
+//! comes first, then fewer ops and lower rank of the Dimshuffle
+struct LayoutCost {
+    int nr_shuffle = 0;
+    int nr_op = 0;
+    int64_t rank = 0;
+    void add(Operation* op) {
+        ++nr_op;
+        if (llvm::isa<MGB::Dimshuffle>(op)) {
+            auto type = op->getResult(0).getType().cast<RankedTensorType>();
+            ++nr_shuffle;
+            rank = std::max(rank, type.getRank());
+        }
+    }
+    bool operator<(const LayoutCost& rhs) const {
+        return std::tie(nr_shuffle, nr_op, rank) <
+               std::tie(rhs.nr_shuffle, rhs.nr_op, rhs.rank);
+    }
+};
+
+//! rewrite the chain ending at `tail` into at most Reshape, Dimshuffle and
+//! Reshape, the inverse layout transforms are cancelled in this way
+bool fold_layout_chain(Operation* tail) {
+    std::vector<Operation*> chain{tail};
+    while (true) {
+        Operation* prev = chain.front()->getOperand(0).getDefiningOp();
+        if (!is_layout_op(prev) || !prev->getResult(0).hasOneUse()) {
+            break;
+        }
+        chain.insert(chain.begin(), prev);
+    }
+    Value input = chain.front()->getOperand(0);
+    auto src = get_shape(input);
+    auto dst = get_shape(tail->getResult(0));
+    auto relayout = compose_layout(src, chain);
+    if (!relayout) {
+        return false;
+    }
+    auto& groups = relayout->groups;
+    auto& perm = relayout->perm;
+    bool permuted = false;
+    for (size_t i = 0; i < perm.size(); ++i) {
+        permuted |= perm[i] != static_cast<int32_t>(i);
+    }
+    std::vector<int64_t> permuted_shape;
+    for (auto axis : perm) {
+        permuted_shape.push_back(groups[axis]);
+    }
+    bool reshape_src = permuted && src != groups;
+    bool reshape_dst = permuted ? permuted_shape != dst : src != dst;
+
+    LayoutCost old_cost, new_cost;
+    for (auto op : chain) {
+        old_cost.add(op);
+    }
+    new_cost.nr_op = reshape_src + permuted + reshape_dst;
+    new_cost.nr_shuffle = permuted;
+    new_cost.rank = permuted ? perm.size() : 0;
+    if (!(new_cost < old_cost)) {
+        return false;
+    }
+
+    OpBuilder builder(tail);
+    auto elem_type = input.getType().cast<RankedTensorType>().getElementType();
+    Value value = input;
+    if (reshape_src) {
+        value = builder.create<MGB::Reshape>(
+                tail->getLoc(), RankedTensorType::get(groups, elem_type),
+                std::vector<Value>{value});
+    }
+    if (permuted) {
+        value = builder.create<MGB::Dimshuffle>(
+                tail->getLoc(), RankedTensorType::get(permuted_shape, elem_type),
+                value, perm);
+    }
+    if (reshape_dst) {
+        value = builder.create<MGB::Reshape>(
+                tail->getLoc(), tail->getResult(0).getType(),
+                std::vector<Value>{value});
+    }
+    tail->getResult(0).replaceAllUsesWith(value);
+    for (auto it = chain.rbegin(); it != chain.rend(); ++it) {
+        (*it)->erase();
+    }
+    LOG_DEBUG << "Fold " << chain.size() << " layout oprs into "
+              << new_cost.nr_op << " oprs\n";
+    return true;
+}
+
+//! the Dimshuffle swapping the last two axes
+bool is_transpose(Value value) {
+    auto shuffle = value.getDefiningOp<MGB::Dimshuffle>();
+    if (!shuffle || !is_static_value(shuffle.input())) {
+        return false;
+    }
+    auto pattern = shuffle.pattern();
+    int32_t rank = pattern.size();
+    if (rank < 2 || shuffle.input().getType().cast<RankedTensorType>().getRank() !=
+                            rank) {
+        return false;
+    }
+    for (int32_t i = 0; i < rank - 2; ++i) {
+        if (pattern[i] != i) {
+            return false;
+        }
+    }
+    return pattern[rank - 2] == rank - 1 && pattern[rank - 1] == rank - 2;
+}
+
+/*!
+ * the transposed operand of the matmul with the transpose flag is read as
+ * the input of the transpose, the flag is cleared so the kernel without the
+ * transposed packing is chosen and the relayout is removed
+ */
+template <typename Op>
+bool absorb_transpose(Op matmul) {
+    if (matmul.format() != ::megdnn::param::MatrixMul::Format::DEFAULT) {
+        return false;
+    }
+    bool changed = false;
+    Builder builder(matmul->getContext());
+    auto absorb = [&](int index, bool transpose, auto set_attr) {
+        Value operand = matmul->getOperand(index);
+        if (!transpose || !is_transpose(operand)) {
+            return;
+        }
+        auto shuffle = operand.template getDefiningOp<MGB::Dimshuffle>();
+        matmul->setOperand(index, shuffle.input());
+        set_attr(builder.getBoolAttr(false));
+        if (shuffle->use_empty()) {
+            shuffle->erase();
+        }
+        changed = true;
+    };
+    absorb(0, matmul.transposeA(), [&](BoolAttr attr) { matmul.transposeAAttr(attr); });
+    absorb(1, matmul.transposeB(), [&](BoolAttr attr) { matmul.transposeBAttr(attr); });
+    if (changed) {
+        LOG_DEBUG << "Absorb transpose into " << Op::getOperationName().str() << "\n";
+    }
+    return changed;
+}
+
+class MGBRelayoutFoldPass final : public MGBRelayoutFoldPassBase<MGBRelayoutFoldPass> {
+    void runOnOperation() override {
+        FuncOp func = getOperation();
+        //! only the tail of a chain is collected, the chains do not overlap
+        std::vector<Operation*> tails;
+        func.walk([&](Operation* op) {
+            if (!is_layout_op(op)) {
+                return;
+            }
+            Value result = op->getResult(0);
+            if (result.hasOneUse() &&
+                is_layout_op(result.getUses().begin()->getOwner())) {
+                return;
+            }
+            tails.push_back(op);
+        });
+        for (auto tail : tails) {
+            fold_layout_chain(tail);
+        }
+        func.walk([&](MGB::MatrixMul op) { absorb_transpose(op); });
+        func.walk([&](MGB::BatchedMatrixMul op) { absorb_transpose(op); });
+    }
+};
+
+}  // namespace
+
+std::unique_ptr<OperationPass<FuncOp>> createMGBRelayoutFoldPass() {
+    return std::make_unique<MGBRelayoutFoldPass>();
+}
+}  // namespace mlir
@@ -0,0 +1,59 @@
+#include <sstream>
+#include <string>
+#include "Arm/Arm64/ConvKernel.h"
+#include "Arm/Arm64/InternalKernel/InternalKernel.h"
+#include "Common/ConvBackData.h"
+#include "compiler/KernelGen/KernelGen.h"
+
+using namespace megcc;
+using namespace KernelGen;
+using namespace Arm64;
+
+namespace {
+std::string gen_deconv_prelude() {
+    return R"(
+#include <arm_neon.h>
+typedef float32x4_t deconv_vec_t;
+#define DECONV_LOAD(ptr) vld1q_f32(ptr)
+#define DECONV_STORE(ptr, v) vst1q_f32(ptr, v)
+#define DECONV_ADD(a, b) vaddq_f32(a, b)
+#define DECONV_ZERO() vdupq_n_f32(0.f)
+static inline void DECONV_STORE_ZIP(float* ptr, float32x4_t a, float32x4_t b) {
+    float32x4x2_t zip = {{a, b}};
+    vst2q_f32(ptr, zip);
+}
+)";
+}
+}  // namespace
+
+bool Float32NchwBackward::IsAvailable(TContext* ctx) const {
+    return ConvBackDataGemmHelper::is_available(ctx);
+}
+
+std::string Float32NchwBackward::GetKernelSymbol(TContext* ctx) const {
+    CC_ASSERT(ctx);
+    return ConvBackDataGemmHelper::gen_symbol(ctx, "Arm64_");
+}
+
+std::string Float32NchwBackward::GetInitBody(TContext* ctx) const {
+    return ConvBackDataGemmHelper::gen_init_body(
+            ctx, m_inner_gemm, GetInitSignature(ctx));
+}
+
+std::string Float32NchwBackward::GetWorkspaceBodyCondition(
+        TContext* ctx, bool jit) const {
+    return ConvBackDataGemmHelper::gen_workspace_body(
+            ctx, m_inner_gemm, GetWorkspaceSignature(ctx), jit);
+}
+
+std::vector<KernelObj> Float32NchwBackward::GetDependInternalSymbol(
+        TContext* ctx) const {
+    return ConvBackDataGemmHelper::gen_depend(m_inner_gemm);
+}
+
+std::string Float32NchwBackward::GetKernelBody(TContext* ctx) const {
+    return ConvBackDataGemmHelper::gen_kernel_body(
+            ctx, m_inner_gemm, gen_deconv_prelude(), GetKernelSignature(ctx));
+}
+
+// vim: syntax=cpp.doxygen
@@ -25,7 +25,7 @@ bool ConvDotNCHWNCHW44Common::IsAvailableCommon(
                      ctx->getAttrStr("nonlineMode") == "IDENTITY" ||
                      ctx->getAttrStr("nonlineMode") == "RELU";
 
-    bool type_ok = is_qint8_conv_dtype(ctx);
+    bool type_ok = is_qint8_conv_dtype(ctx, false, true);
     bool layout_ok =
             ctx->getAttrOprand("operand:0").shape.size() == 4 &&
             ctx->getAttrOprand(
@@ -80,6 +80,8 @@ std::string ConvDotNCHWNCHW44Common::GetInitBody(TContext* ctx) const {
     out_weights->dtype.type_enum = TinyNN_QINT8;
     out_weights->name = in_weights->name;
     out_weights->dtype.param.scale = in_weights->dtype.param.scale;
+    out_weights->dtype.param.scales = in_weights->dtype.param.scales;
+    out_weights->dtype.param.nr_scale = in_weights->dtype.param.nr_scale;
  )";
     std::string fill_weight_transform = StringTemplate::StringTemplateArgs()
                                                 .add("ic", ic)
@@ -3,6 +3,7 @@
 #include "Arm/ARMBackend.h"
 #include "Arm/Arm64/Activation.h"
 #include "Arm/Arm64/ConvKernel.h"
+#include "Arm/ArmCommon/ConvKernel/Int8/Common.h"
 #include "Utils/StringTemplate.h"
 #include "Utils/Utils.h"
 #include "compiler/KernelGen/KernelGen.h"
@@ -108,7 +109,7 @@ std::string render_store(
         ss << act.GenIntrinsicQuantStore(
                 "c[" + std::to_string(c_idx) + "][" + std::to_string(ow_idx) + "]",
                 "dst_ptr + " + store_offset + " + " + std::to_string(ow_idx) + " * 4",
-                "scale", "dst_scale_inv");
+                "scale[" + std::to_string(c_idx) + "]", "dst_scale_inv");
     }
     return ss.str();
 }
@@ -116,7 +117,7 @@ std::string render_store(
 std::string render_kernel(TContext* ctx) {
     std::stringstream ss;
     ss << R"(typedef void kern_func (const int8_t* src_ptr, const int8_t* filter_ptr, const int32_t* bias_ptr,
-                                        int8_t* dst_ptr, const int packed_iw, const int packed_ic_stride, const int ld_dst_oc, const float scale, float dst_scale_inv);
+                                        int8_t* dst_ptr, const int packed_iw, const int packed_ic_stride, const int ld_dst_oc, const float32x4_t* scale, float dst_scale_inv);
     )";
 
     auto mode = ctx->getAttrStr("nonlineMode");
@@ -184,15 +185,15 @@ std::string render_kernel(TContext* ctx) {
                      return render_store(ow_step, c_idx, store_offset, *activate_gen);
                  })
             .add("activate", [=](std::vector<std::string> args) {
-                CC_ASSERT(args.size() == 2) << "args size = " << args.size();
+                CC_ASSERT(args.size() == 3) << "args size = " << args.size();
                 auto str = activate_gen->GenIntrinsicQuantStore(
-                        args[0], args[1], "scale", "dst_scale_inv");
+                        args[0], args[1], args[2], "dst_scale_inv");
                 return str;
             });
     std::string kernel_temp = R"(  
     __attribute__((target("dotprod")))
     static inline void nchw_nchw44_s2_${filter_size}x${filter_size}_kernel_${nr_ow}_oc${oc_step}(const int8_t* src_ptr, const int8_t* filter_ptr, const int32_t* bias_ptr,
-                                            int8_t* dst_ptr, const int packed_iw, const int packed_ic_stride, const int ld_dst_oc, const float scale, float dst_scale_inv){
+                                            int8_t* dst_ptr, const int packed_iw, const int packed_ic_stride, const int ld_dst_oc, const float32x4_t* scale, float dst_scale_inv){
             const int simd_len = ${simd_len};
             int32x4_t c[${oc_step}/4][${ow_step}];
             ${render_init(0)}
@@ -221,7 +222,7 @@ std::string render_kernel(TContext* ctx) {
                                             int8_t* dst_ptr, const int
                                             packed_iw, const int
                                             packed_ic_stride, const int
-                                            ld_dst_oc, const int dst_nr_ow, const float scale, float dst_scale_inv){
+                                            ld_dst_oc, const int dst_nr_ow, const float32x4_t* scale, float dst_scale_inv){
             const int pad_h = ${pad_h};
             const int pad_w = ${pad_w};
             const int simd_len = ${simd_len};
@@ -242,10 +243,10 @@ std::string render_kernel(TContext* ctx) {
             }
             ${activate_init()}
             rep(step, dst_nr_ow){
-                ${activate(c[0][step], dst_ptr + step * 4)};
+                ${activate(c[0][step], dst_ptr + step * 4, scale[0])};
             }
             rep(step, dst_nr_ow){
-                ${activate(c[1][step], dst_ptr + ld_dst_oc + step * 4)};
+                ${activate(c[1][step], dst_ptr + ld_dst_oc + step * 4, scale[1])};
             }
         }
     )";
@@ -269,7 +270,7 @@ std::string render_kernel(TContext* ctx) {
     int8_t* src_ptr, const int8_t* filter_ptr, const int32_t* bias_ptr,
                                         int8_t* dst_ptr, const int packed_iw,
                                         const int packed_ic_stride, const int
-                                        ld_dst_oc, const float scale, float dst_scale_inv){
+                                        ld_dst_oc, const float32x4_t* scale, float dst_scale_inv){
         const int pad_h = ${pad_h};
         const int pad_w = ${pad_w};
         const int simd_len = ${simd_len};
@@ -304,7 +305,7 @@ std::string render_kernel(TContext* ctx) {
     int8_t* src_ptr, const int8_t* filter_ptr, const int32_t* bias_ptr,
                                         int8_t* dst_ptr, const int packed_iw,
                                         const int packed_ic_stride, const int
-                                        ld_dst_oc, const int dst_nr_ow, const float scale, float dst_scale_inv){
+                                        ld_dst_oc, const int dst_nr_ow, const float32x4_t* scale, float dst_scale_inv){
         const int pad_h = ${pad_h};
         const int pad_w = ${pad_w};
         const int simd_len = ${simd_len};
@@ -326,7 +327,7 @@ std::string render_kernel(TContext* ctx) {
         }
         ${activate_init()}
         rep(step, dst_nr_ow){
-            ${activate(c[0][step], dst_ptr + step * 4)};
+            ${activate(c[0][step], dst_ptr + step * 4, scale[0])};
         }
     }
     )";
@@ -408,10 +409,9 @@ static inline void copy_pad_src(int8_t* sptr_base, const int8_t* sptr_origin,
     const int fh = ${filter_size};
     const int fw = (${filter_size} + 3) / 4 * 4;
     const float src_scale = inputs[0]->dtype.param.scale;
-    const float flt_scale = inputs[1]->dtype.param.scale;
+    ${flt_scales}
     const float dst_scale = outputs[0]->dtype.param.scale;
     const float dst_scale_inv = 1.f / dst_scale;
-    const float scale = src_scale * flt_scale;
 
     const int oc = ${oc};
     const int oh = out_layout.dims[2];
@@ -434,6 +434,7 @@ static inline void copy_pad_src(int8_t* sptr_base, const int8_t* sptr_origin,
         copy_pad_src(workspace_ptr, input_ptr + batch_idx * src_batch_stride, ic, ih, iw, pad_h, pad_w);
         for (int oc_idx = 0; oc_idx < oc_end; oc_idx += big_oc_step) {
             const int weight_offset = oc_idx * ic * fh * fw;
+            const float32x4_t scale[2] = {${oc_scale}, ${oc_scale_1}};
             for (int oh_idx = 0; oh_idx < oh; oh_idx += oh_step) {
                 for (int ow_idx = 0; ow_idx < ow_end; ow_idx += ow_step) {
                     const int src_offset =  oh_idx * stride_h * packed_iw +
@@ -453,6 +454,7 @@ static inline void copy_pad_src(int8_t* sptr_base, const int8_t* sptr_origin,
         }
         if (oc_remain){
             const int weight_offset = oc_end * ic * fh * fw;
+            const float32x4_t scale[1] = {${oc_remain_scale}};
             for (int oh_idx = 0; oh_idx < oh; oh_idx += oh_step) {
                 for (int ow_idx = 0; ow_idx < ow_end; ow_idx += ow_step) {
                     const int src_offset =  oh_idx * stride_h * packed_iw +
@@ -486,6 +488,10 @@ static inline void copy_pad_src(int8_t* sptr_base, const int8_t* sptr_origin,
                       .add("ic", ic)
                       .add("oc", oc)
                       .add("filter_size", filter_size)
+                      .add("flt_scales", gen_flt_scales("inputs[1]"))
+                      .add("oc_scale", gen_oc4_scale("oc_idx"))
+                      .add("oc_scale_1", gen_oc4_scale("oc_idx + pack_oc_size"))
+                      .add("oc_remain_scale", gen_oc4_scale("oc_end"))
                       .render(body_temp);
     return writer.str();
 }
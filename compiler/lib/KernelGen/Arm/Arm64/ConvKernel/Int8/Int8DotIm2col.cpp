@@ -3,6 +3,7 @@
 #include "Arm/Arm64/Activation.h"
 #include "Arm/Arm64/ConvKernel.h"
 #include "Arm/Arm64/InternalKernel/InternalKernel.h"
+#include "Arm/ArmCommon/ConvKernel/Int8/Common.h"
 #include "Arm/ArmCommon/Im2colHelper.h"
 #include "compiler/KernelGen/KernelGen.h"
 
@@ -64,6 +65,9 @@ std::string ConvIm2colDot::GetKernelSymbol(TContext* ctx) const {
         extra_ss << "_" << ctx->getAttrStr("nonlineMode");
     }
     extra_ss << "_" << SymbolHelper::gen_io_str(ctx);
+    if (is_per_channel_scale(ctx)) {
+        extra_ss << "_per_channel";
+    }
     std::string name_temp =
             "Arm64_kernel_conv2d_im2col_dot_${kernel_h}x${kernel_w}_${"
             "format}_${sparse}_p${pad_h}x${pad_w}_s${stride_h}x${stride_w}_d${"
@@ -95,7 +99,7 @@ bool ConvIm2colDot::IsAvailable(TContext* ctx) const {
                      ctx->getAttrStr("nonlineMode") == "IDENTITY" ||
                      ctx->getAttrStr("nonlineMode") == "RELU" ||
                      ctx->getAttrStr("nonlineMode") == "H_SWISH";
-    bool type_ok = is_qint8_conv_dtype(ctx);
+    bool type_ok = is_qint8_conv_dtype(ctx, false, true);
     bool layout_ok = ctx->getAttrOprand("operand:0").shape.size() == 4 &&
                      ctx->getAttrOprand(dst_oprands).shape.size() == 4;
     bool weight_ok = (ctx->getAttrStr("sparse") == "GROUP" &&
@@ -152,6 +156,8 @@ std::string ConvIm2colDot::GetInitBody(TContext* ctx) const {
         out_weights->dtype.type_enum = TinyNN_QINT8;
         out_weights->name = in_weights->name;
         out_weights->dtype.param.scale = in_weights->dtype.param.scale;
+        out_weights->dtype.param.scales = in_weights->dtype.param.scales;
+        out_weights->dtype.param.nr_scale = in_weights->dtype.param.nr_scale;
     )";
     const std::string fill_weight_transform =
             StringTemplate::StringTemplateArgs()
@@ -204,6 +210,11 @@ std::string ConvIm2colDot::GetWorkspaceBodyCondition(TContext* ctx, bool jit) co
     if (inner_gemm->need_post_process(inner_ctx.get())) {
         temp_workspace = "size_t temp_dst = oc * ohw * sizeof(int32_t) + 64;";
     }
+    std::string gemm_dst_workspace = "size_t gemm_dst = 0;";
+    if (is_per_channel_scale(ctx)) {
+        gemm_dst_workspace =
+                "size_t gemm_dst = (size_t) oc * block_ohw * sizeof(int32_t) + 64;";
+    }
     std::string workspace_temp =
             R"({
         TINYNN_ASSERT(workspace);
@@ -236,8 +247,9 @@ std::string ConvIm2colDot::GetWorkspaceBodyCondition(TContext* ctx, bool jit) co
         size_t im2col_out = (size_t) block_ohw * k * sizeof(int8_t) + 64;                
         size_t packed_out = ${packb_workspace_func}(0, block_ohw, 0, k) + 64;
         ${temp_workspace}
+        ${gemm_dst_workspace}
         ${bypass_workspace}
-        size_t res = im2col_out + packed_out + pad_out + temp_dst;
+        size_t res = im2col_out + packed_out + pad_out + temp_dst + gemm_dst;
 
         *workspace = res;
         return TinyNN_SUCCESS;
@@ -252,6 +264,7 @@ std::string ConvIm2colDot::GetWorkspaceBodyCondition(TContext* ctx, bool jit) co
                     .add("packb_workspace_func",
                          inner_gemm->GetPackBWorkspaceSymbol(inner_ctx.get()))
                     .add("temp_workspace", temp_workspace)
+                    .add("gemm_dst_workspace", gemm_dst_workspace)
                     .add("bypass_workspace", bypass_workspace)
                     .render(workspace_temp);
     return ss.str();
@@ -270,13 +283,19 @@ std::vector<KernelObj> ConvIm2colDot::GetDependInternalSymbol(TContext* ctx) con
 
 std::shared_ptr<TContext> ConvIm2colDot::GetInnerCtx(TContext* ctx) const {
     auto inner_ctx = std::make_shared<CodeGenContext>();
-    if (ctx->haveAttr("nonlineMode")) {
+    //! the gemm of the per channel quantized filter only accumulates to int32
+    const bool per_channel = is_per_channel_scale(ctx);
+    if (ctx->haveAttr("nonlineMode") && !per_channel) {
         inner_ctx->setAttr("nonlineMode", CCAttr(ctx->getAttrStr("nonlineMode")));
     }
     inner_ctx->setAttr("with_bias", ConvImpl::is_bias(ctx));
     inner_ctx->setAttr("transposeA", false);
     inner_ctx->setAttr("transposeB", false);
-    inner_ctx->setAttr("dtype", ctx->getAttrOprand("operand:0").dtype);
+    if (per_channel) {
+        inner_ctx->setAttr("dtype", "8832");
+    } else {
+        inner_ctx->setAttr("dtype", ctx->getAttrOprand("operand:0").dtype);
+    }
     auto fmt = ctx->getAttrStr("format");
     if (fmt == "NCHW44_DOT") {
         inner_ctx->setAttr("format", "MK4_DOT");
@@ -298,7 +317,10 @@ std::string ConvIm2colDot::GetKernelBody(TContext* ctx) const {
     writer << inner_gemm->GetNakedKernelSignature(inner_ctx.get()) << ";\n";
     writer << inner_gemm->GetPackBSignature(inner_ctx.get()) << ";\n";
 
-    writer << gen_im2col(ctx, inner_ctx.get());
+    //! the im2col copies the int8 src even though the per channel gemm is 8832
+    auto im2col_ctx = GetInnerCtx(ctx);
+    im2col_ctx->setAttr("dtype", ctx->getAttrOprand("operand:0").dtype);
+    writer << gen_im2col(ctx, im2col_ctx.get());
     writer << GenCommonRet() << " " << GetKernelSignature(ctx);
     std::string bias_ptr_str = is_bias(ctx) ? "inputs[2]->ptr;" : "0;";
     const int pack_c_size = get_pack_c_size(ctx);
@@ -312,6 +334,35 @@ std::string ConvIm2colDot::GetKernelBody(TContext* ctx) const {
     if (inner_gemm->need_post_process(ctx)) {
         gen_temp_dst = "int32_t* temp_dst = (int32_t*)(pad_out_ptr + pad_out_offset);";
     }
+    std::string flt_scale_str = "const float flt_scale = inputs[1]->dtype.param.scale;";
+    std::string gen_gemm_dst = "const size_t gemm_dst_offset = 0;";
+    std::string gemm_store = R"(
+                    ${naked_kern_sym}(group_weight_data, packb_ptr, group_ouput_data + ohw_idx * pack_c_size, LDC, ocpg, real_block_ohw, K, group_bias_data, temp_dst, scale, temp_scale, dst_scale_inv);)";
+    std::string requant_store;
+    //! the int32 result of the gemm is requantized with the scale vector of
+    //! every 4 output channels
+    if (is_per_channel_scale(ctx)) {
+        auto act = create_activation_gener_instrinsic(
+                ctx->haveAttr("nonlineMode") ? ctx->getAttrStr("nonlineMode")
+                                             : "IDENTITY");
+        flt_scale_str = gen_flt_scales("inputs[1]");
+        gen_gemm_dst = R"(
+        const size_t temp_gemm_dst = (size_t) ocpg * block_ohw * sizeof(int32_t);
+        const size_t gemm_dst_offset = (temp_gemm_dst + align_size - 1) / align_size * align_size;
+        int32_t* gemm_dst = (int32_t*)(workspace->ptr + im2col_offset + packb_offset);)";
+        gemm_store = R"(
+                    ${naked_kern_sym}(group_weight_data, packb_ptr, gemm_dst, real_block_ohw * pack_c_size, ocpg, real_block_ohw, K, group_bias_data, scale, temp_scale, dst_scale_inv);
+                    ${requant_store})";
+        requant_store = gen_mk4_requant_store(
+                *act, "gemm_dst", "real_block_ohw * pack_c_size",
+                "group_ouput_data + ohw_idx * pack_c_size", "ohw * pack_c_size",
+                "ocpg / pack_c_size", "real_block_ohw", "group_idx * ocpg");
+    }
+    gemm_store = StringTemplate::StringTemplateArgs()
+                         .add("naked_kern_sym",
+                              inner_gemm->GetNakedKernelSymbol(inner_ctx.get()))
+                         .add("requant_store", requant_store)
+                         .render(gemm_store);
     std::string temp_body =
             R"({
         const int pack_c_size = ${pack_c_size};
@@ -323,7 +374,7 @@ std::string ConvIm2colDot::GetKernelBody(TContext* ctx) const {
         const uint32_t fw = ${kernel_w};
 
         const float src_scale = inputs[0]->dtype.param.scale;
-        const float flt_scale = inputs[1]->dtype.param.scale;
+        ${flt_scale_str}
         const float dst_scale = outputs[0]->dtype.param.scale;
         const float temp_scale = src_scale * flt_scale;
         const float dst_scale_inv = 1.f / dst_scale;
@@ -369,7 +420,8 @@ std::string ConvIm2colDot::GetKernelBody(TContext* ctx) const {
 
         int8_t* im2col_ptr = workspace->ptr;
         int8_t* packb_ptr = workspace->ptr + im2col_offset;
-        int8_t* pad_out_ptr = workspace->ptr + im2col_offset + packb_offset;
+        ${gen_gemm_dst}
+        int8_t* pad_out_ptr = workspace->ptr + im2col_offset + packb_offset + gemm_dst_offset;
         ${gen_temp_dst}
 
         for (int n_idx = 0; n_idx < n; ++n_idx) {
@@ -389,7 +441,7 @@ std::string ConvIm2colDot::GetKernelBody(TContext* ctx) const {
                             stride_h, stride_w, ohw_idx, real_block_ohw);
                             
                     ${pack_b_sym}(packb_ptr, im2col_ptr, real_block_ohw * pack_c_size, 0, real_block_ohw, 0, K);
-                    ${naked_kern_sym}(group_weight_data, packb_ptr, group_ouput_data + ohw_idx * pack_c_size, LDC, ocpg, real_block_ohw, K, group_bias_data, temp_dst, scale, temp_scale, dst_scale_inv);
+                    ${gemm_store}
                 }
             }
             input_data += ic * ih * iw;
@@ -413,6 +465,9 @@ std::string ConvIm2colDot::GetKernelBody(TContext* ctx) const {
                       .add("packb_size_sym",
                            inner_gemm->GetPackBWorkspaceSymbol(inner_ctx.get()))
                       .add("gen_temp_dst", gen_temp_dst)
+                      .add("flt_scale_str", flt_scale_str)
+                      .add("gen_gemm_dst", gen_gemm_dst)
+                      .add("gemm_store", gemm_store)
                       .render(temp_body);
     return writer.str();
 }
@@ -365,7 +365,9 @@ std::string gen_kernel(
             ctx->haveAttr("nonlineMode") ? ctx->getAttrStr("nonlineMode") : "IDENTITY";
     auto nonline_gen = create_activation_gener_instrinsic(nonline_mode);
     auto nonline_gen_func = [&](std::vector<std::string> str) -> std::string {
-        return nonline_gen->GenIntrinsicQuantStore(str[0], str[1], str[2], str[3]);
+        //! the requantize scale of the quant store is a vector of every lane
+        return nonline_gen->GenIntrinsicQuantStore(
+                str[0], str[1], "vdupq_n_f32(" + str[2] + ")", str[3]);
     };
     auto nonline_gen_init = [&]() -> std::string {
         return nonline_gen->GenIntrinsicInitFloat();
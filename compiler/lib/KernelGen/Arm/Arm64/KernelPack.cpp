@@ -24,6 +24,8 @@ struct AllA64Kernel {
         inner_i8mm_map[KernelPack::KernType::ConvKernel] = {
                 std::make_shared<Arm64::ConvBiasIm2colI8mmNCHW44>(),
         };
+        inner_map[KernelPack::KernType::ConvBackDataKernel] = {
+                std::make_shared<Arm64::Float32NchwBackward>()};
 
         inner_map[KernelPack::KernType::MatrixMulKernel] = {
                 std::make_shared<Arm64::Fp16MatMulM8N8K8>(),
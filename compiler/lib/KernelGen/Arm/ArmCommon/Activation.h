@@ -24,7 +24,10 @@ struct ActivationGenIntrinsicBase {
     virtual std::string GenIntrinsicFloatStore(
             const std::string& input, const std::string& outptr) const = 0;
 
-    //! compute the input neon data and write to the output ptr
+    //! requantize the int32 input data with src_scale, apply the activation and
+    //! quantize with dst_scale, then write 4 int8 to the output ptr. src_scale
+    //! is a float32x4_t holding the scale of every lane, so that per output
+    //! channel quantized weights are supported, dst_scale is a float
     virtual std::string GenIntrinsicQuantStore(
             const std::string& input, const std::string& outptr,
             const std::string& src_scale, const std::string& dst_scale) const = 0;
@@ -53,7 +56,7 @@ public:
         std::string store_temp = R"(
             {
                 float32x4_t f32_res = vcvtq_f32_s32(${input_reg});
-                float32x4_t res = vmulq_n_f32(f32_res, ${src_scale});
+                float32x4_t res = vmulq_f32(f32_res, ${src_scale});
                 res = vmulq_n_f32(res, ${dst_scale}); 
                 int32x4_t s32_res = vcvtaq_s32_f32(res);
                 int16x4_t s16_res = vqmovn_s32(s32_res);
@@ -96,7 +99,7 @@ public:
         std::string store_temp = R"(
             {
                 float32x4_t f32_res = vcvtq_f32_s32(${input_reg});
-                float32x4_t res = vmaxq_f32(vmulq_n_f32(f32_res, ${src_scale}), vzero);
+                float32x4_t res = vmaxq_f32(vmulq_f32(f32_res, ${src_scale}), vzero);
                 res = vmulq_n_f32(res, ${dst_scale}); 
                 int32x4_t s32_res = vcvtaq_s32_f32(res);
                 int16x4_t s16_res = vqmovn_s32(s32_res);
@@ -163,7 +166,7 @@ public:
         std::string store_temp = R"(
             {
                 float32x4_t f32_res = vcvtq_f32_s32(${input_reg});
-                f32_res = vmulq_n_f32(f32_res, ${src_scale});
+                f32_res = vmulq_f32(f32_res, ${src_scale});
 
                 float32x4_t relu6 = vaddq_f32(f32_res, f3_v);
                 relu6 = vminq_f32(relu6, f6_v);
@@ -0,0 +1,116 @@
+#include <sstream>
+
+#include "Argmax.h"
+#include "Common/Argmxx.h"
+#include "Utils/StringTemplate.h"
+#include "Utils/Utils.h"
+
+using namespace megcc;
+using namespace KernelGen;
+using namespace ArmCommon;
+
+namespace {
+//! the argmxx simd primitives on neon, int8 is widened to float lanes so that
+//! the index of every lane fits an int32 lane
+std::string gen_neon_prelude(const std::string& mode, const std::string& dtype) {
+    std::stringstream writer;
+    writer << "#include <arm_neon.h>\n";
+    if (dtype == "f32") {
+        writer << R"(
+#define ARGMXX_STEP 4
+#define ARGMXX_NR_VEC 1
+typedef float32x4_t argmxx_val_t;
+static inline void argmxx_load(const float* ptr, argmxx_val_t* val) {
+    val[0] = vld1q_f32(ptr);
+}
+static inline argmxx_val_t argmxx_load4(const float* ptr) {
+    return vld1q_f32(ptr);
+}
+)";
+    } else {
+        writer << R"(
+#define ARGMXX_STEP 16
+#define ARGMXX_NR_VEC 4
+typedef float32x4_t argmxx_val_t;
+static inline void argmxx_load(const int8_t* ptr, argmxx_val_t* val) {
+    int8x16_t vec = vld1q_s8(ptr);
+    int16x8_t low = vmovl_s8(vget_low_s8(vec));
+    int16x8_t high = vmovl_s8(vget_high_s8(vec));
+    val[0] = vcvtq_f32_s32(vmovl_s16(vget_low_s16(low)));
+    val[1] = vcvtq_f32_s32(vmovl_s16(vget_high_s16(low)));
+    val[2] = vcvtq_f32_s32(vmovl_s16(vget_low_s16(high)));
+    val[3] = vcvtq_f32_s32(vmovl_s16(vget_high_s16(high)));
+}
+static inline argmxx_val_t argmxx_load4(const int8_t* ptr) {
+    int32_t tmp[4] = {ptr[0], ptr[1], ptr[2], ptr[3]};
+    return vcvtq_f32_s32(vld1q_s32(tmp));
+}
+)";
+    }
+    writer << StringTemplate::StringTemplateArgs()
+                      .add("cmp", mode == "MAX" ? "vcgtq_f32" : "vcltq_f32")
+                      .render(R"(
+typedef int32x4_t argmxx_idx_t;
+static const int32_t argmxx_lane[4] = {0, 1, 2, 3};
+static inline argmxx_idx_t argmxx_iota(int base) {
+    return vaddq_s32(vdupq_n_s32(base), vld1q_s32(argmxx_lane));
+}
+static inline argmxx_idx_t argmxx_dup(int base) {
+    return vdupq_n_s32(base);
+}
+static inline void argmxx_update(
+        argmxx_val_t* best, argmxx_idx_t* arg, argmxx_val_t val, argmxx_idx_t idx) {
+    uint32x4_t mask = ${cmp}(val, *best);
+    *best = vbslq_f32(mask, val, *best);
+    *arg = vbslq_s32(mask, idx, *arg);
+}
+static inline void argmxx_store_arg(int32_t* ptr, argmxx_idx_t arg) {
+    vst1q_s32(ptr, arg);
+}
+static inline void argmxx_store_lane(
+        float* val_ptr, int32_t* arg_ptr, argmxx_val_t best, argmxx_idx_t arg) {
+    vst1q_f32(val_ptr, best);
+    vst1q_s32(arg_ptr, arg);
+}
+)");
+    return writer.str();
+}
+
+std::string gen_body(
+        TContext* context, const std::string& mode, const std::string& signature) {
+    auto dtype = context->getAttrOprand("operand:0").dtype;
+    std::stringstream writer;
+    writer << gen_neon_prelude(mode, dtype);
+    writer << GenCommonRet() << " " << signature << "{\n";
+    writer << ArgmxxHelper::gen_simd_body(
+            context, mode, Utils::cvt_dtype_specifier(dtype));
+    writer << "}\n";
+    return writer.str();
+}
+}  // namespace
+
+bool ArgmaxKernel::IsAvailable(TContext* context) const {
+    return ArgmxxHelper::is_available(context, false);
+}
+
+std::string ArgmaxKernel::GetKernelSymbol(TContext* context) const {
+    return ArgmxxHelper::gen_symbol("ArmCommon_kernel_", "MAX", context);
+}
+
+std::string ArgmaxKernel::GetKernelBody(TContext* context) const {
+    return gen_body(context, "MAX", GetKernelSignature(context));
+}
+
+bool ArgminKernel::IsAvailable(TContext* context) const {
+    return ArgmxxHelper::is_available(context, false);
+}
+
+std::string ArgminKernel::GetKernelSymbol(TContext* context) const {
+    return ArgmxxHelper::gen_symbol("ArmCommon_kernel_", "MIN", context);
+}
+
+std::string ArgminKernel::GetKernelBody(TContext* context) const {
+    return gen_body(context, "MIN", GetKernelSignature(context));
+}
+
+// vim: syntax=cpp.doxygen
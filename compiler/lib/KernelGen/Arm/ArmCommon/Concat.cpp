@@ -0,0 +1,67 @@
+#include "Concat.h"
+#include "Common/Concat.h"
+#include "Common/Indexing.h"
+#include "Utils/StringTemplate.h"
+#include "Utils/Utils.h"
+#include "compiler/Common/Logger.h"
+
+using namespace megcc;
+using namespace KernelGen;
+using namespace ArmCommon;
+
+bool ConcatKernel::IsAvailable(TContext* context) const {
+    size_t type_size =
+            Utils::get_dtype_size(context->getAttrOprand("operand:0").dtype);
+    return type_size == 1 || type_size == 2 || type_size == 4;
+}
+
+//! kernel gen
+std::string ConcatKernel::GetKernelSymbol(TContext* context) const {
+    std::stringstream ss;
+    ss << "ArmCommon_kernel_concat_byte_"
+       << Utils::get_dtype_size(context->getAttrOprand("operand:0").dtype)
+       << "_axis_" << context->getAttrInt("axis");
+    return ss.str();
+}
+
+std::string ConcatKernel::GetKernelBody(TContext* context) const {
+    std::string specifier = IndexingHelper::GetMoveSpecifier(
+            Utils::get_dtype_size(context->getAttrOprand("operand:0").dtype));
+    std::stringstream writer;
+    writer << R"(
+        #include <string.h>
+        #include <arm_neon.h>
+        #include "tensor_util.h"
+
+        static inline void copy_row(void* dst_ptr, const void* src_ptr, size_t nr_bytes) {
+            uint8_t* dst = (uint8_t*)dst_ptr;
+            const uint8_t* src = (const uint8_t*)src_ptr;
+            size_t i = 0;
+            for (; i + 64 <= nr_bytes; i += 64) {
+                uint8x16_t v0 = vld1q_u8(src + i);
+                uint8x16_t v1 = vld1q_u8(src + i + 16);
+                uint8x16_t v2 = vld1q_u8(src + i + 32);
+                uint8x16_t v3 = vld1q_u8(src + i + 48);
+                vst1q_u8(dst + i, v0);
+                vst1q_u8(dst + i + 16, v1);
+                vst1q_u8(dst + i + 32, v2);
+                vst1q_u8(dst + i + 48, v3);
+            }
+            for (; i + 16 <= nr_bytes; i += 16) {
+                vst1q_u8(dst + i, vld1q_u8(src + i));
+            }
+            for (; i + 8 <= nr_bytes; i += 8) {
+                vst1_u8(dst + i, vld1_u8(src + i));
+            }
+            if (i < nr_bytes) {
+                memcpy(dst + i, src + i, nr_bytes - i);
+            }
+        }
+    )";
+    writer << GenCommonRet() << " " << GetKernelSignature(context) << "{\n";
+    writer << ConcatHelper::GenBody(context->getAttrInt("axis"), specifier, "copy_row");
+    writer << "}\n";
+    return writer.str();
+}
+
+// vim: syntax=cpp.doxygen
@@ -2,7 +2,65 @@
 #include "Arm/ArmCommon/Activation.h"
 #include "Utils/StringTemplate.h"
 
-static std::string store_ocx_owx(
+//! read the filter scales of the weight tensor, the scales of the 4 output
+//! channels from oc are flt_scales + oc * flt_scale_step, the per tensor scale
+//! is broadcast to every output channel by flt_scale_step 0
+static inline std::string gen_flt_scales(const std::string& weight) {
+    return megcc::KernelGen::StringTemplate::StringTemplateArgs()
+            .add("weight", weight)
+            .render(R"(
+    const float flt_scale = ${weight}->dtype.param.scale;
+    const float flt_scale_oc4[4] = {flt_scale, flt_scale, flt_scale, flt_scale};
+    const float* flt_scales = ${weight}->dtype.param.scales;
+    const int flt_scale_step = flt_scales ? 1 : 0;
+    if (!flt_scales) {
+        flt_scales = flt_scale_oc4;
+    }
+)");
+}
+
+//! the requantize scale vector of the 4 output channels from oc
+static inline std::string gen_oc4_scale(const std::string& oc) {
+    return "vmulq_n_f32(vld1q_f32(flt_scales + (" + oc +
+           ") * flt_scale_step), src_scale)";
+}
+
+//! requantize the int32 result in MK4 layout of nr_ocb blocks of 4 output
+//! channels from oc and nr_pixel pixels, src and dst are advanced by src_stride
+//! and dst_stride elements every oc block
+static inline std::string gen_mk4_requant_store(
+        const megcc::KernelGen::ArmCommon::ActivationGenIntrinsicBase& act,
+        const std::string& src, const std::string& src_stride, const std::string& dst,
+        const std::string& dst_stride, const std::string& nr_ocb,
+        const std::string& nr_pixel, const std::string& oc) {
+    return megcc::KernelGen::StringTemplate::StringTemplateArgs()
+            .add("init_store", act.GenIntrinsicInitFloat())
+            .add("oc_scale", gen_oc4_scale("(" + oc + ") + ocb * 4"))
+            .add("quant_store",
+                 act.GenIntrinsicQuantStore(
+                         "res", "store_ptr + i * 4", "oc_scale", "dst_scale_inv"))
+            .add("src", src)
+            .add("src_stride", src_stride)
+            .add("dst", dst)
+            .add("dst_stride", dst_stride)
+            .add("nr_ocb", nr_ocb)
+            .add("nr_pixel", nr_pixel)
+            .render(R"({
+    ${init_store}
+    for (int ocb = 0; ocb < ${nr_ocb}; ++ocb) {
+        const float32x4_t oc_scale = ${oc_scale};
+        const int32_t* gemm_ptr = ${src} + ocb * ${src_stride};
+        int8_t* store_ptr = ${dst} + ocb * ${dst_stride};
+        for (int i = 0; i < ${nr_pixel}; ++i) {
+            int32x4_t res = vld1q_s32(gemm_ptr + i * 4);
+            ${quant_store}
+        }
+    }
+})");
+}
+
+//! bias_scale is an array of the requantize scale vectors of the oc blocks
+static inline std::string store_ocx_owx(
         std::string dst, std::string reg_name, std::string bias_scale,
         std::string dst_scale,
         const megcc::KernelGen::ArmCommon::ActivationGenIntrinsicBase& act,
@@ -23,14 +81,14 @@ static std::string store_ocx_owx(
                             "]",
                     "store_ptr" + std::to_string(i) + " + " + std::to_string(j) +
                             " * 4",
-                    bias_scale, dst_scale);
+                    bias_scale + "[" + std::to_string(i) + "]", dst_scale);
         }
     }
     ss << "\n}";
     return ss.str();
 }
 
-static std::string store_ocx_ow_remain(
+static inline std::string store_ocx_ow_remain(
         std::string dst, std::string reg_name, std::string bias_scale,
         std::string dst_scale, std::string ow_remain,
         const megcc::KernelGen::ArmCommon::ActivationGenIntrinsicBase& act,
@@ -52,8 +110,8 @@ static std::string store_ocx_ow_remain(
                     )");
         ss << act.GenIntrinsicQuantStore(
                 reg_name + "[" + std::to_string(i) + "]" + "[j]",
-                "store_ptr" + std::to_string(i) + " + j * oc_step", bias_scale,
-                dst_scale);
+                "store_ptr" + std::to_string(i) + " + j * oc_step",
+                bias_scale + "[" + std::to_string(i) + "]", dst_scale);
         ss << "\n}";
     }
     ss << "\n}";
@@ -1,6 +1,7 @@
 #include <string>
 #include "Arm/ArmCommon/Activation.h"
 #include "Arm/ArmCommon/ConvKernel.h"
+#include "Common.h"
 #include "Utils/StringTemplate.h"
 #include "compiler/KernelGen/KernelGen.h"
 
@@ -83,7 +84,7 @@ std::string render_store_1_line(
     for (int i = 0; i < 4; ++i) {
         ss << act.GenIntrinsicQuantStore(
                 reg_name + "[" + std::to_string(i) + "]",
-                "store_ptr + " + std::to_string(i) + " * 4", "src_scale", "dst_scale");
+                "store_ptr + " + std::to_string(i) + " * 4", "scale", "dst_scale");
     }
     ss << "\n}";
     return ss.str();
@@ -109,8 +110,7 @@ std::string render_store_1_line_remain(
         for (int i = 0; i < remain_val; ++i) {
             ss << act.GenIntrinsicQuantStore(
                     reg_name + "[" + std::to_string(i) + "]",
-                    "store_ptr + " + std::to_string(i) + " * 4", "src_scale",
-                    "dst_scale");
+                    "store_ptr + " + std::to_string(i) + " * 4", "scale", "dst_scale");
         }
         ss << "\n}";
     }
@@ -125,7 +125,7 @@ std::string gen_3x3_s1_kern(
     std::string bias_str = with_bias ? "vld1q_s32(bias)" : "vdupq_n_s32(0)";
     std::string body_temp = R"(
 static inline void nchw44_chanwise_3x3_int8(const int8_t* sptr, const int8_t* fptr, const int32_t* bias, void* dst,
-        const size_t IH, const size_t IW, const size_t OH, const size_t OW, float src_scale, float dst_scale){
+        const size_t IH, const size_t IW, const size_t OH, const size_t OW, float32x4_t scale, float dst_scale){
     int32x4_t init_v = ${bias_str};
     const int* filter = (int*)(fptr);
     int8x16_t kern[9];
@@ -498,7 +498,7 @@ std::string gen_3x3_s2_kern(
     std::string bias_str = with_bias ? "vld1q_s32(bias)" : "vdupq_n_s32(0)";
     std::string body_temp = R"(
 static inline void nchw44_chanwise_3x3_int8(const int8_t* src, const int8_t* filter, const int32_t* bias, void* dst,
-        const size_t IH, const size_t IW, const size_t OH, const size_t OW, float src_scale, float dst_scale){
+        const size_t IH, const size_t IW, const size_t OH, const size_t OW, float32x4_t scale, float dst_scale){
 
     int32x4_t init_v = ${bias_str};
     int32x2_t zero = vdup_n_s32(0);
@@ -723,7 +723,7 @@ std::string gen_5x5_s1_kern(
     std::string bias_str = with_bias ? "vld1q_s32(bias)" : "vdupq_n_s32(0)";
     std::string body_temp = R"(
 static inline void nchw44_chanwise_5x5_int8(const int8_t* src, const int8_t* filter, const int32_t* bias, void* dst,
-        const size_t IH, const size_t IW, const size_t OH, const size_t OW, float src_scale, float dst_scale){
+        const size_t IH, const size_t IW, const size_t OH, const size_t OW, float32x4_t scale, float dst_scale){
 #define LOAD_1_LINE_SRC(sptr, src)        \
     src[0] = vld1q_s8(sptr);              \
     src[4] = vld1q_s8(sptr + 16);         \
@@ -988,7 +988,7 @@ std::string gen_5x5_s2_kern(
     std::string bias_str = with_bias ? "vld1q_s32(bias)" : "vdupq_n_s32(0)";
     std::string body_temp = R"(
 static inline void nchw44_chanwise_5x5_int8(const int8_t* src, const int8_t* filter, const int32_t* bias, void* dst,
-        const size_t IH, const size_t IW, const size_t OH, const size_t OW, float src_scale, float dst_scale){
+        const size_t IH, const size_t IW, const size_t OH, const size_t OW, float32x4_t scale, float dst_scale){
 #define COMPUTE_ONE_VECTOR(                                            \
         src00, src01, src02, src10, src11, src12, kern0, kern1, sum)   \
     accumulate_1_line_horizon(src00, kern0[0], src10, kern1[0], &sum); \
@@ -1306,7 +1306,7 @@ bool ChannelWiseInt8Nchw44::IsAvailable(TContext* ctx) const {
                      ctx->getAttrStr("nonlineMode") == "IDENTITY" ||
                      ctx->getAttrStr("nonlineMode") == "RELU";
 
-    bool type_ok = is_qint8_conv_dtype(ctx);
+    bool type_ok = is_qint8_conv_dtype(ctx, false, true);
     bool layout_ok = ctx->getAttrOprand("operand:0").shape.size() == 5 &&
                      ctx->getAttrOprand("operand:0").shape[4] == 4;
     bool channel_wise_ok = ctx->getAttrOprand("operand:1").shape.size() == 6 &&
@@ -1417,10 +1417,9 @@ std::string ChannelWiseInt8Nchw44::GetKernelBody(TContext* ctx) const {
         const int min_iw = IW2 < IW? IW2:IW;
 
         const float src_scale = inputs[0]->dtype.param.scale;
-        const float flt_scale = inputs[1]->dtype.param.scale;
+        ${flt_scales}
         const float dst_scale = outputs[0]->dtype.param.scale;
         const float dst_scale_inv = 1.f / dst_scale;
-        const float scale = src_scale * flt_scale;
 
 
         int8_t* input_data = inputs[0]->ptr;
@@ -1440,7 +1439,7 @@ std::string ChannelWiseInt8Nchw44::GetKernelBody(TContext* ctx) const {
                     memcpy(padding_src + ((ih + PH) * IW2 + PW) * pack_ic_size,
                            src_ptr + ih * IW * pack_ic_size, sizeof(int8_t) * min_iw * pack_ic_size);
                 }
-                nchw44_chanwise_${kernel_h}x${kernel_w}_int8(padding_src, weight_ptr, bias_ptr, dst_ptr, IH2, IW2, OH, OW, scale, dst_scale_inv);
+                nchw44_chanwise_${kernel_h}x${kernel_w}_int8(padding_src, weight_ptr, bias_ptr, dst_ptr, IH2, IW2, OH, OW, ${oc_scale}, dst_scale_inv);
             }
             input_data += N_stride;
             output_data += ON_stride;
@@ -1455,6 +1454,8 @@ std::string ChannelWiseInt8Nchw44::GetKernelBody(TContext* ctx) const {
                       .add_ctx_int("stride_h")
                       .add_ctx_int("stride_w")
                       .add("bias_str", bias_str)
+                      .add("flt_scales", gen_flt_scales("inputs[1]"))
+                      .add("oc_scale", gen_oc4_scale("icb * pack_ic_size"))
                       .render(body_temp);
     return writer.str();
 }
@@ -2,6 +2,7 @@
 #include <string>
 #include "Arm/ArmCommon/Activation.h"
 #include "Arm/ArmCommon/ConvKernel.h"
+#include "Common.h"
 #include "Utils/StringTemplate.h"
 #include "Utils/Utils.h"
 #include "compiler/KernelGen/KernelGen.h"
@@ -78,7 +79,7 @@ std::string gen_do_conv_code(TContext* ctx) {
     std::stringstream ss;
     std::string code_body = R"(
 static void do_conv_kern(int8_t* sptr_base, int8_t* packed_weight_base, int32_t* bptr_base, int8_t* dptr_base, size_t OH, size_t OW, size_t ICPG, size_t OCPG, size_t GROUP, size_t IH2, size_t IW2, 
-    size_t workspace_batch_id, size_t workspace_group_id, size_t batch_id, size_t group_id, size_t oc_id, size_t oc_block_num, float scale, float dst_scale) {
+    size_t workspace_batch_id, size_t workspace_group_id, size_t batch_id, size_t group_id, size_t oc_id, size_t oc_block_num, const float* flt_scales, const int flt_scale_step, const float src_scale, float dst_scale) {
     size_t padding_group_size = IH2 * IW2 * ICPG;
     const size_t pack_c = 4;
     const size_t src_expand_size = 4;
@@ -101,7 +102,8 @@ static void do_conv_kern(int8_t* sptr_base, int8_t* packed_weight_base, int32_t*
         bptr = bptr_base + (group_id * OCPG + oc_idx);
     }
     int8_t* packed_weight = packed_weight_base + (group_id * OCPG * ICPG * ${kernel_h} * ${kernel_w} + oc_idx * ICPG * ${kernel_h} * ${kernel_w}) * sizeof(int8_t);
-    nchw44_conv_direct_${kernel_h}x${kernel_w}_int8(sptr, packed_weight, bptr, dst_ptr, oc_block, ICPG, IH2, IW2, OH, OW, scale, dst_scale);
+    nchw44_conv_direct_${kernel_h}x${kernel_w}_int8(sptr, packed_weight, bptr, dst_ptr, oc_block, ICPG, IH2, IW2, OH, OW,
+            flt_scales + (group_id * OCPG + oc_idx) * flt_scale_step, flt_scale_step, src_scale, dst_scale);
 }
 )";
     ss << StringTemplate::StringTemplateArgs(ctx)
@@ -115,7 +117,7 @@ std::string gen_oc4_kernel_common_code(TContext* ctx) {
     std::stringstream ss;
     std::string body_temp = R"(
 static inline void nchw44_conv_direct_${kernel_h}x${kernel_w}_int8(const int8_t* src, const int8_t* filter, const int32_t* bias, int8_t* dst,
-        const size_t oc, const size_t ic, const size_t ih, const size_t iw, const size_t oh, const size_t ow, float scale, float dst_scale){
+        const size_t oc, const size_t ic, const size_t ih, const size_t iw, const size_t oh, const size_t ow, const float* flt_scales, const int flt_scale_step, const float src_scale, float dst_scale){
     const size_t fh = ${kernel_h};
     const size_t fw = ${kernel_w};
     const size_t ic_step = 4;
@@ -133,6 +135,7 @@ static inline void nchw44_conv_direct_${kernel_h}x${kernel_w}_int8(const int8_t*
 
     for (size_t oc_idx = 0; oc_idx < oc; oc_idx += oc_step) {
         const size_t weight_offset = oc_idx * ic * fh * fw;
+        const float32x4_t scale[1] = {${oc_scale}};
         for (size_t oh_idx = 0; oh_idx < oh; oh_idx += oh_step) {
             for (size_t ow_idx = 0; ow_idx < ow_end; ow_idx += ow_step) {
                 const size_t src_offset =
@@ -140,7 +143,7 @@ static inline void nchw44_conv_direct_${kernel_h}x${kernel_w}_int8(const int8_t*
                 const size_t dst_offset =
                         oc_idx * img_stride + (oh_idx * ow + ow_idx) * oc_step;  
                 nchw44_conv_direct_${kernel_h}x${kernel_w}_int8_impl(src + src_offset, filter + weight_offset, bias + oc_idx,
-                             dst + dst_offset, ic, ih, iw, scale,dst_scale);
+                             dst + dst_offset, ic, ih, iw, scale, dst_scale);
             }
             if (ow_remain > 0) {
                 const size_t src_offset =
@@ -148,7 +151,7 @@ static inline void nchw44_conv_direct_${kernel_h}x${kernel_w}_int8(const int8_t*
                 const size_t dst_offset =
                         oc_idx * img_stride + (oh_idx * ow + ow_end) * oc_step;
                 nchw44_conv_direct_${kernel_h}x${kernel_w}_int8_impl_remain(src + src_offset, filter + weight_offset, bias + oc_idx,
-                        dst + dst_offset, ic, ih, iw, scale,dst_scale, ow_remain);
+                        dst + dst_offset, ic, ih, iw, scale, dst_scale, ow_remain);
             }
         }
     }
@@ -159,6 +162,8 @@ static inline void nchw44_conv_direct_${kernel_h}x${kernel_w}_int8(const int8_t*
                     .add_ctx_int("kernel_w")
                     .add_ctx_int("stride_h")
                     .add_ctx_int("stride_w")
+                    .add("oc_scale", gen_oc4_scale("oc_idx"))
+                    .add("oc_scale_1", gen_oc4_scale("oc_idx + oc_step"))
                     .render(body_temp);
     return ss.str();
 }
@@ -167,7 +172,7 @@ std::string gen_2x2_kernel_common_code(TContext* ctx) {
     std::stringstream ss;
     std::string body_temp = R"(
 static inline void nchw44_conv_direct_${kernel_h}x${kernel_w}_int8(const int8_t* src, const int8_t* filter, const int32_t* bias, int8_t* dst,
-        const size_t oc, const size_t ic, const size_t ih, const size_t iw, const size_t oh, const size_t ow, float scale, float dst_scale){
+        const size_t oc, const size_t ic, const size_t ih, const size_t iw, const size_t oh, const size_t ow, const float* flt_scales, const int flt_scale_step, const float src_scale, float dst_scale){
     const int fh = ${kernel_h};
     const int fw = ${kernel_w};
     const int oc_step = 4;
@@ -188,6 +193,7 @@ static inline void nchw44_conv_direct_${kernel_h}x${kernel_w}_int8(const int8_t*
 
     for (size_t oc_idx = 0; oc_idx < oc_end; oc_idx += big_oc_step) {
         const size_t weight_offset = oc_idx * ic * fh * fw;
+        const float32x4_t scale[2] = {${oc_scale}, ${oc_scale_1}};
         for (size_t oh_idx = 0; oh_idx < oh; oh_idx += oh_step) {
             for (size_t ow_idx = 0; ow_idx < ow_end; ow_idx += ow_step) {
                 const size_t src_offset =
@@ -203,13 +209,14 @@ static inline void nchw44_conv_direct_${kernel_h}x${kernel_w}_int8(const int8_t*
                 const size_t dst_offset =
                         oc_idx * img_stride + (oh_idx * ow + ow_end) * oc_step;
                 ker_neon_dirctconv_2x2s${stride_h}_oc8_ow8_remain(src + src_offset, filter + weight_offset, bias + oc_idx,
-                    dst + dst_offset, ic, ih, iw, ld_oc, scale,dst_scale, ow_remain);
+                    dst + dst_offset, ic, ih, iw, ld_oc, scale, dst_scale, ow_remain);
             }
         }
     }
     if (oc_remain > 0) {
         const size_t oc_idx = oc_end;
         const size_t weight_offset = oc_idx * ic * fh * fw;
+        const float32x4_t scale[1] = {${oc_scale}};
         for (size_t oh_idx = 0; oh_idx < oh; oh_idx += oh_step) {
             for (size_t ow_idx = 0; ow_idx < ow_end; ow_idx += ow_step) {
                 const size_t src_offset =
@@ -217,7 +224,7 @@ static inline void nchw44_conv_direct_${kernel_h}x${kernel_w}_int8(const int8_t*
                 const size_t dst_offset =
                         oc_idx * img_stride + (oh_idx * ow + ow_idx) * oc_step;
                 ker_neon_dirctconv_2x2s${stride_h}_oc4_ow8(src + src_offset, filter + weight_offset, bias + oc_idx,
-                        dst + dst_offset, ic, ih, iw, ld_oc, scale,dst_scale);
+                        dst + dst_offset, ic, ih, iw, ld_oc, scale, dst_scale);
             }
             if (ow_remain > 0) {
                 const size_t src_offset =
@@ -237,6 +244,8 @@ static inline void nchw44_conv_direct_${kernel_h}x${kernel_w}_int8(const int8_t*
                     .add_ctx_int("kernel_w")
                     .add_ctx_int("stride_h")
                     .add_ctx_int("stride_w")
+                    .add("oc_scale", gen_oc4_scale("oc_idx"))
+                    .add("oc_scale_1", gen_oc4_scale("oc_idx + oc_step"))
                     .render(body_temp);
     return ss.str();
 }
@@ -300,25 +309,26 @@ std::string gen_bias_init_code_remain(bool with_bias, std::string remain, int c_
     return ss.str();
 }
 
+//! scale_name is the requantize scale vector of the oc block of reg_name
 std::string gen_res_store_code(
-        std::string reg_name, std::string dst_name,
+        std::string reg_name, std::string scale_name, std::string dst_name,
         const ActivationGenIntrinsicBase& act) {
     std::stringstream ss;
     for (int i = 0; i < 8; ++i) {
         ss << act.GenIntrinsicQuantStore(
                 reg_name + "[" + std::to_string(i) + "]",
-                dst_name + " + " + std::to_string(i) + " * 4", "scale", "dst_scale");
+                dst_name + " + " + std::to_string(i) + " * 4", scale_name, "dst_scale");
     }
     return ss.str();
 }
 
 std::string gen_res_store_code_remain(
-        std::string reg_name, std::string dst_name,
+        std::string reg_name, std::string scale_name, std::string dst_name,
         const ActivationGenIntrinsicBase& act, std::string remain) {
     std::stringstream ss;
     ss << "rep(i, " << remain << ")\n";
     ss << act.GenIntrinsicQuantStore(
-            reg_name + "[i]", dst_name + " + i * 4", "scale", "dst_scale");
+            reg_name + "[i]", dst_name + " + i * 4", scale_name, "dst_scale");
     return ss.str();
 }
 
@@ -327,7 +337,7 @@ std::string gen_2x2_s1_oc8_ow8_kern(
     std::stringstream ss;
     std::string kernel_impl = R"(
 static inline void ${func_name}(const int8_t* src_ptr, const int8_t* weight_ptr, const int32_t* bias_ptr, int8_t* dst_ptr,
-        int ic, int ih, int iw, int ld_dst_oc, float scale, float dst_scale ${remain_param}){
+        int ic, int ih, int iw, int ld_dst_oc, const float32x4_t* scale, float dst_scale ${remain_param}){
     const int filter_size = 2;
     const int fh = filter_size;
     const int fw = filter_size;
@@ -418,9 +428,9 @@ static inline void ${func_name}(const int8_t* src_ptr, const int8_t* weight_ptr,
                     .add("bias_init_func", gen_bias_init_code(with_bias, 2))
                     .add("init_store", activate_gen->GenIntrinsicInitFloat())
                     .add("store_func",
-                         gen_res_store_code("c[0]", "dst_ptr", *activate_gen.get()) +
+                         gen_res_store_code("c[0]", "scale[0]", "dst_ptr", *activate_gen.get()) +
                                  gen_res_store_code(
-                                         "c[1]", "dst_ptr + ld_dst_oc",
+                                         "c[1]", "scale[1]", "dst_ptr + ld_dst_oc",
                                          *activate_gen.get()))
                     .render(kernel_impl);
     ss << StringTemplate::StringTemplateArgs()
@@ -431,9 +441,9 @@ static inline void ${func_name}(const int8_t* src_ptr, const int8_t* weight_ptr,
                     .add("init_store", activate_gen->GenIntrinsicInitFloat())
                     .add("store_func",
                          gen_res_store_code_remain(
-                                 "c[0]", "dst_ptr", *activate_gen.get(), "remain_w") +
+                                 "c[0]", "scale[0]", "dst_ptr", *activate_gen.get(), "remain_w") +
                                  gen_res_store_code_remain(
-                                         "c[1]", "dst_ptr + ld_dst_oc",
+                                         "c[1]", "scale[1]", "dst_ptr + ld_dst_oc",
                                          *activate_gen.get(), "remain_w"))
                     .render(kernel_impl);
     return ss.str();
@@ -444,7 +454,7 @@ std::string gen_2x2_s1_oc4_ow8_kern(
     std::stringstream ss;
     std::string kernel_impl = R"(
 static inline void ${func_name}(const int8_t* src_ptr, const int8_t* weight_ptr, const int32_t* bias_ptr, int8_t* dst_ptr,
-        int ic, int ih, int iw, int ld_dst_oc, float scale, float dst_scale ${remain_param}){
+        int ic, int ih, int iw, int ld_dst_oc, const float32x4_t* scale, float dst_scale ${remain_param}){
     const int filter_size = 2;
     const int fh = filter_size;
     const int fw = filter_size;
@@ -517,7 +527,7 @@ static inline void ${func_name}(const int8_t* src_ptr, const int8_t* weight_ptr,
                     .add("bias_init_func", gen_bias_init_code(with_bias, 1))
                     .add("init_store", activate_gen->GenIntrinsicInitFloat())
                     .add("store_func",
-                         gen_res_store_code("c[0]", "dst_ptr", *activate_gen.get()))
+                         gen_res_store_code("c[0]", "scale[0]", "dst_ptr", *activate_gen.get()))
                     .render(kernel_impl);
     ss << StringTemplate::StringTemplateArgs()
                     .add("func_name", "ker_neon_dirctconv_2x2s1_oc4_ow8_remain")
@@ -527,7 +537,7 @@ static inline void ${func_name}(const int8_t* src_ptr, const int8_t* weight_ptr,
                     .add("init_store", activate_gen->GenIntrinsicInitFloat())
                     .add("store_func",
                          gen_res_store_code_remain(
-                                 "c[0]", "dst_ptr", *activate_gen.get(), "remain_w"))
+                                 "c[0]", "scale[0]", "dst_ptr", *activate_gen.get(), "remain_w"))
                     .render(kernel_impl);
     return ss.str();
 }
@@ -537,7 +547,7 @@ std::string gen_2x2_s2_oc8_ow8_kern(
     std::stringstream ss;
     std::string kernel_impl = R"(
 static inline void ${func_name}(const int8_t* src_ptr, const int8_t* weight_ptr, const int32_t* bias_ptr, int8_t* dst_ptr,
-        int ic, int ih, int iw, int ld_dst_oc, float scale, float dst_scale ${remain_param}){
+        int ic, int ih, int iw, int ld_dst_oc, const float32x4_t* scale, float dst_scale ${remain_param}){
     const int filter_size = 2;
     const int fh = filter_size;
     const int fw = filter_size;
@@ -635,9 +645,9 @@ static inline void ${func_name}(const int8_t* src_ptr, const int8_t* weight_ptr,
                     .add("bias_init_func", gen_bias_init_code(with_bias, 2))
                     .add("init_store", activate_gen->GenIntrinsicInitFloat())
                     .add("store_func",
-                         gen_res_store_code("c[0]", "dst_ptr", *activate_gen.get()) +
+                         gen_res_store_code("c[0]", "scale[0]", "dst_ptr", *activate_gen.get()) +
                                  gen_res_store_code(
-                                         "c[1]", "dst_ptr + ld_dst_oc",
+                                         "c[1]", "scale[1]", "dst_ptr + ld_dst_oc",
                                          *activate_gen.get()))
                     .render(kernel_impl);
     ss << StringTemplate::StringTemplateArgs()
@@ -648,9 +658,9 @@ static inline void ${func_name}(const int8_t* src_ptr, const int8_t* weight_ptr,
                     .add("init_store", activate_gen->GenIntrinsicInitFloat())
                     .add("store_func",
                          gen_res_store_code_remain(
-                                 "c[0]", "dst_ptr", *activate_gen.get(), "remain_w") +
+                                 "c[0]", "scale[0]", "dst_ptr", *activate_gen.get(), "remain_w") +
                                  gen_res_store_code_remain(
-                                         "c[1]", "dst_ptr + ld_dst_oc",
+                                         "c[1]", "scale[1]", "dst_ptr + ld_dst_oc",
                                          *activate_gen.get(), "remain_w"))
                     .render(kernel_impl);
     return ss.str();
@@ -661,7 +671,7 @@ std::string gen_2x2_s2_oc4_ow8_kern(
     std::stringstream ss;
     std::string kernel_impl = R"(
 static inline void ${func_name}(const int8_t* src_ptr, const int8_t* weight_ptr, const int32_t* bias_ptr, int8_t* dst_ptr,
-        int ic, int ih, int iw, int ld_dst_oc, float scale,float dst_scale ${remain_param}){
+        int ic, int ih, int iw, int ld_dst_oc, const float32x4_t* scale, float dst_scale ${remain_param}){
     const int filter_size = 2;
     const int fh = filter_size;
     const int fw = filter_size;
@@ -741,7 +751,7 @@ static inline void ${func_name}(const int8_t* src_ptr, const int8_t* weight_ptr,
                     .add("bias_init_func", gen_bias_init_code(with_bias, 1))
                     .add("init_store", activate_gen->GenIntrinsicInitFloat())
                     .add("store_func",
-                         gen_res_store_code("c[0]", "dst_ptr", *activate_gen.get()))
+                         gen_res_store_code("c[0]", "scale[0]", "dst_ptr", *activate_gen.get()))
                     .render(kernel_impl);
     ss << StringTemplate::StringTemplateArgs()
                     .add("func_name", "ker_neon_dirctconv_2x2s2_oc4_ow8_remain")
@@ -751,7 +761,7 @@ static inline void ${func_name}(const int8_t* src_ptr, const int8_t* weight_ptr,
                     .add("init_store", activate_gen->GenIntrinsicInitFloat())
                     .add("store_func",
                          gen_res_store_code_remain(
-                                 "c[0]", "dst_ptr", *activate_gen.get(), "remain_w"))
+                                 "c[0]", "scale[0]", "dst_ptr", *activate_gen.get(), "remain_w"))
                     .render(kernel_impl);
     return ss.str();
 }
@@ -761,7 +771,7 @@ std::string gen_3x3_s1_kern(
     std::stringstream ss;
     std::string kernel_impl = R"(
 static inline void ${func_name}(const int8_t* src_ptr, const int8_t* weight_ptr, const int32_t* bias_ptr, int8_t* dst_ptr,
-        int ic, int ih, int iw, float scale, float dst_scale ${remain_param}){
+        int ic, int ih, int iw, const float32x4_t* scale, float dst_scale ${remain_param}){
     const int filter_size = 3;
     const int fh = filter_size;
     const int fw = filter_size;
@@ -844,7 +854,7 @@ static inline void ${func_name}(const int8_t* src_ptr, const int8_t* weight_ptr,
                     .add("bias_init_func", gen_bias_init_code(with_bias, 1))
                     .add("init_store", activate_gen->GenIntrinsicInitFloat())
                     .add("store_func",
-                         gen_res_store_code("c[0]", "dst_ptr", *activate_gen.get()))
+                         gen_res_store_code("c[0]", "scale[0]", "dst_ptr", *activate_gen.get()))
                     .render(kernel_impl);
     ss << StringTemplate::StringTemplateArgs()
                     .add("func_name", "nchw44_conv_direct_3x3_int8_impl_remain")
@@ -854,7 +864,7 @@ static inline void ${func_name}(const int8_t* src_ptr, const int8_t* weight_ptr,
                     .add("init_store", activate_gen->GenIntrinsicInitFloat())
                     .add("store_func",
                          gen_res_store_code_remain(
-                                 "c[0]", "dst_ptr", *activate_gen.get(), "remain_w"))
+                                 "c[0]", "scale[0]", "dst_ptr", *activate_gen.get(), "remain_w"))
                     .render(kernel_impl);
     return ss.str();
 }
@@ -864,7 +874,7 @@ std::string gen_3x3_s2_kern(
     std::stringstream ss;
     std::string kernel_impl = R"(
 static inline void ${func_name}(const int8_t* src_ptr, const int8_t* weight_ptr, const int32_t* bias_ptr, int8_t* dst_ptr,
-        int ic, int ih, int iw, float scale,float dst_scale ${remain_param}){
+        int ic, int ih, int iw, const float32x4_t* scale, float dst_scale ${remain_param}){
     const int filter_size = 3;
     const int fh = filter_size;
     const int fw = filter_size;
@@ -954,7 +964,7 @@ static inline void ${func_name}(const int8_t* src_ptr, const int8_t* weight_ptr,
                     .add("bias_init_func", gen_bias_init_code(with_bias, 1))
                     .add("init_store", activate_gen->GenIntrinsicInitFloat())
                     .add("store_func",
-                         gen_res_store_code("c[0]", "dst_ptr", *activate_gen.get()))
+                         gen_res_store_code("c[0]", "scale[0]", "dst_ptr", *activate_gen.get()))
                     .render(kernel_impl);
     ss << StringTemplate::StringTemplateArgs()
                     .add("func_name", "nchw44_conv_direct_3x3_int8_impl_remain")
@@ -964,7 +974,7 @@ static inline void ${func_name}(const int8_t* src_ptr, const int8_t* weight_ptr,
                     .add("init_store", activate_gen->GenIntrinsicInitFloat())
                     .add("store_func",
                          gen_res_store_code_remain(
-                                 "c[0]", "dst_ptr", *activate_gen.get(), "remain_w"))
+                                 "c[0]", "scale[0]", "dst_ptr", *activate_gen.get(), "remain_w"))
                     .render(kernel_impl);
     return ss.str();
 }
@@ -974,7 +984,7 @@ std::string gen_5x5_s1_kern(
     std::stringstream ss;
     std::string kernel_impl = R"(
 static inline void ${func_name}(const int8_t* src_ptr, const int8_t* weight_ptr, const int32_t* bias_ptr, int8_t* dst_ptr,
-        int ic, int ih, int iw, float scale,float dst_scale ${remain_param}){
+        int ic, int ih, int iw, const float32x4_t* scale, float dst_scale ${remain_param}){
     const int filter_size = 5;
     const int fh = filter_size;
     const int fw = filter_size;
@@ -1078,7 +1088,7 @@ static inline void ${func_name}(const int8_t* src_ptr, const int8_t* weight_ptr,
                     .add("bias_init_func", gen_bias_init_code(with_bias, 1))
                     .add("init_store", activate_gen->GenIntrinsicInitFloat())
                     .add("store_func",
-                         gen_res_store_code("c[0]", "dst_ptr", *activate_gen.get()))
+                         gen_res_store_code("c[0]", "scale[0]", "dst_ptr", *activate_gen.get()))
                     .render(kernel_impl);
     ss << StringTemplate::StringTemplateArgs()
                     .add("func_name", "nchw44_conv_direct_5x5_int8_impl_remain")
@@ -1088,7 +1098,7 @@ static inline void ${func_name}(const int8_t* src_ptr, const int8_t* weight_ptr,
                     .add("init_store", activate_gen->GenIntrinsicInitFloat())
                     .add("store_func",
                          gen_res_store_code_remain(
-                                 "c[0]", "dst_ptr", *activate_gen.get(), "remain_w"))
+                                 "c[0]", "scale[0]", "dst_ptr", *activate_gen.get(), "remain_w"))
                     .render(kernel_impl);
     return ss.str();
 }
@@ -1098,7 +1108,7 @@ std::string gen_5x5_s2_kern(
     std::stringstream ss;
     std::string kernel_impl = R"(
 static inline void ${func_name}(const int8_t* src_ptr, const int8_t* weight_ptr, const int32_t* bias_ptr, int8_t* dst_ptr,
-        int ic, int ih, int iw, float scale,float dst_scale ${remain_param}){
+        int ic, int ih, int iw, const float32x4_t* scale, float dst_scale ${remain_param}){
     const int filter_size = 5;
     const int fh = filter_size;
     const int fw = filter_size;
@@ -1208,7 +1218,7 @@ static inline void ${func_name}(const int8_t* src_ptr, const int8_t* weight_ptr,
                     .add("bias_init_func", gen_bias_init_code(with_bias, 1))
                     .add("init_store", activate_gen->GenIntrinsicInitFloat())
                     .add("store_func",
-                         gen_res_store_code("c[0]", "dst_ptr", *activate_gen.get()))
+                         gen_res_store_code("c[0]", "scale[0]", "dst_ptr", *activate_gen.get()))
                     .render(kernel_impl);
     ss << StringTemplate::StringTemplateArgs()
                     .add("func_name", "nchw44_conv_direct_5x5_int8_impl_remain")
@@ -1218,7 +1228,7 @@ static inline void ${func_name}(const int8_t* src_ptr, const int8_t* weight_ptr,
                     .add("init_store", activate_gen->GenIntrinsicInitFloat())
                     .add("store_func",
                          gen_res_store_code_remain(
-                                 "c[0]", "dst_ptr", *activate_gen.get(), "remain_w"))
+                                 "c[0]", "scale[0]", "dst_ptr", *activate_gen.get(), "remain_w"))
                     .render(kernel_impl);
     return ss.str();
 }
@@ -1228,7 +1238,7 @@ std::string gen_7x7_s1_kern(
     std::stringstream ss;
     std::string kernel_impl = R"(
 static inline void ${func_name}(const int8_t* src_ptr, const int8_t* weight_ptr, const int32_t* bias_ptr, int8_t* dst_ptr,
-        int ic, int ih, int iw, float scale,float dst_scale ${remain_param}){
+        int ic, int ih, int iw, const float32x4_t* scale, float dst_scale ${remain_param}){
     const int filter_size = 7;
     const int fh = filter_size;
     const int fw = filter_size;
@@ -1353,7 +1363,7 @@ static inline void ${func_name}(const int8_t* src_ptr, const int8_t* weight_ptr,
                     .add("bias_init_func", gen_bias_init_code(with_bias, 1))
                     .add("init_store", activate_gen->GenIntrinsicInitFloat())
                     .add("store_func",
-                         gen_res_store_code("c[0]", "dst_ptr", *activate_gen.get()))
+                         gen_res_store_code("c[0]", "scale[0]", "dst_ptr", *activate_gen.get()))
                     .render(kernel_impl);
     ss << StringTemplate::StringTemplateArgs()
                     .add("func_name", "nchw44_conv_direct_7x7_int8_impl_remain")
@@ -1363,7 +1373,7 @@ static inline void ${func_name}(const int8_t* src_ptr, const int8_t* weight_ptr,
                     .add("init_store", activate_gen->GenIntrinsicInitFloat())
                     .add("store_func",
                          gen_res_store_code_remain(
-                                 "c[0]", "dst_ptr", *activate_gen.get(), "remain_w"))
+                                 "c[0]", "scale[0]", "dst_ptr", *activate_gen.get(), "remain_w"))
                     .render(kernel_impl);
     return ss.str();
 }
@@ -1373,7 +1383,7 @@ std::string gen_7x7_s2_kern(
     std::stringstream ss;
     std::string kernel_impl = R"(
 static inline void ${func_name}(const int8_t* src_ptr, const int8_t* weight_ptr, const int32_t* bias_ptr, int8_t* dst_ptr,
-        int ic, int ih, int iw, float scale,float dst_scale ${remain_param}){
+        int ic, int ih, int iw, const float32x4_t* scale, float dst_scale ${remain_param}){
     const int filter_size = 7;
     const int fh = filter_size;
     const int fw = filter_size;
@@ -1503,7 +1513,7 @@ static inline void ${func_name}(const int8_t* src_ptr, const int8_t* weight_ptr,
                     .add("bias_init_func", gen_bias_init_code(with_bias, 1))
                     .add("init_store", activate_gen->GenIntrinsicInitFloat())
                     .add("store_func",
-                         gen_res_store_code("c[0]", "dst_ptr", *activate_gen.get()))
+                         gen_res_store_code("c[0]", "scale[0]", "dst_ptr", *activate_gen.get()))
                     .render(kernel_impl);
     ss << StringTemplate::StringTemplateArgs()
                     .add("func_name", "nchw44_conv_direct_7x7_int8_impl_remain")
@@ -1513,7 +1523,7 @@ static inline void ${func_name}(const int8_t* src_ptr, const int8_t* weight_ptr,
                     .add("init_store", activate_gen->GenIntrinsicInitFloat())
                     .add("store_func",
                          gen_res_store_code_remain(
-                                 "c[0]", "dst_ptr", *activate_gen.get(), "remain_w"))
+                                 "c[0]", "scale[0]", "dst_ptr", *activate_gen.get(), "remain_w"))
                     .render(kernel_impl);
     return ss.str();
 }
@@ -1534,7 +1544,7 @@ bool DirectInt8NCHW44::IsAvailable(TContext* ctx) const {
     bool noline_ok = !ctx->haveAttr("nonlineMode") ||
                      ctx->getAttrStr("nonlineMode") == "IDENTITY" ||
                      ctx->getAttrStr("nonlineMode") == "RELU";
-    bool type_ok = is_qint8_conv_dtype(ctx);
+    bool type_ok = is_qint8_conv_dtype(ctx, false, true);
     bool layout_ok = ctx->getAttrOprand("operand:0").shape.size() == 5 &&
                      ctx->getAttrOprand("operand:0").shape[4] == 4;
 
@@ -1636,6 +1646,8 @@ static inline void nchw44_pack_filter(const int8_t* src, int8_t* dst) {
         out_weights->dtype.type_enum = TinyNN_QINT8;
         out_weights->name = in_weights->name;
         out_weights->dtype.param.scale = in_weights->dtype.param.scale;
+        out_weights->dtype.param.scales = in_weights->dtype.param.scales;
+        out_weights->dtype.param.nr_scale = in_weights->dtype.param.nr_scale;
 )";
     std::string fill_weight_transform = R"(
         int8_t* outptr = out_weights->ptr;
@@ -1741,11 +1753,10 @@ std::string DirectInt8NCHW44::GetKernelBody(TContext* context) const {
     const int OCB_stride = OH * OW * pack_oc_size;
 
     const float src_scale = inputs[0]->dtype.param.scale;
-    const float flt_scale = inputs[1]->dtype.param.scale;
+    ${flt_scales}
     const float dst_scale = outputs[0]->dtype.param.scale;
     // this must be 1.f/dst_scale for quant data
     const float dst_scale_inv = 1.f / dst_scale;
-    const float scale = src_scale * flt_scale;
 
     int8_t* input_data = inputs[0]->ptr;
     int8_t* output_data = outputs[0]->ptr;
@@ -1780,7 +1791,7 @@ std::string DirectInt8NCHW44::GetKernelBody(TContext* context) const {
             const int8_t* src_ptr = input_data + batch_offset + group_offset;
             copy_padding_kern(src_ptr, padding_src, IH, IW, icpg, IH2, IW2);
             do_conv_kern(padding_src, weight_data, bias_data, output_data, OH, OW, icpg, ocpg, Group, IH2, IW2, 
-                0, 0, batch_id, group_id, 0, 1, scale, dst_scale_inv);
+                0, 0, batch_id, group_id, 0, 1, flt_scales, flt_scale_step, src_scale, dst_scale_inv);
         }
     }
 )"
@@ -1798,7 +1809,7 @@ std::string DirectInt8NCHW44::GetKernelBody(TContext* context) const {
     rep(batch_id, N){
         rep(oc_id, oc_block_num){
             do_conv_kern(padding_src, weight_data, bias_data, output_data, OH, OW, icpg, ocpg, Group, IH2, IW2, 
-                batch_id, 0, batch_id, 0, oc_id, oc_block_num, scale, dst_scale_inv);
+                batch_id, 0, batch_id, 0, oc_id, oc_block_num, flt_scales, flt_scale_step, src_scale, dst_scale_inv);
         }
     }
 )";
@@ -1812,6 +1823,7 @@ std::string DirectInt8NCHW44::GetKernelBody(TContext* context) const {
                       .add_ctx_int("stride_w")
                       .add("padding_do_conv_body", padding_do_conv_body)
                       .add("bias_str", bias_str)
+                      .add("flt_scales", gen_flt_scales("inputs[1]"))
                       .render(body_temp);
     return writer.str();
 }
@@ -240,6 +240,8 @@ std::string Int8NchwNchw44ConvS1::GetInitBody(TContext* ctx) const {
             out_weights->dtype.type_enum = TinyNN_QINT8;
             out_weights->name = in_weights->name;
             out_weights->dtype.param.scale = in_weights->dtype.param.scale;
+            out_weights->dtype.param.scales = in_weights->dtype.param.scales;
+            out_weights->dtype.param.nr_scale = in_weights->dtype.param.nr_scale;
         )";
     std::string fill_weight_transform_template = R"(
             const int kw_pad = out_weights->layout.dims[3];
@@ -344,7 +346,7 @@ bool Int8NchwNchw44ConvS1::IsAvailable(TContext* ctx) const {
                      ctx->getAttrStr("nonlineMode") == "IDENTITY" ||
                      ctx->getAttrStr("nonlineMode") == "RELU";
 
-    bool type_ok = is_qint8_conv_dtype(ctx);
+    bool type_ok = is_qint8_conv_dtype(ctx, false, true);
     bool layout_ok =
             ctx->getAttrOprand("operand:0").shape.size() == 4 &&
             ctx->getAttrOprand(
@@ -404,9 +406,8 @@ std::string Int8NchwNchw44ConvS1::GetKernelBody(TContext* ctx) const {
         int8_t *src_packed = (int8_t*)workspace->ptr + IW_pad;
 
         const float src_scale = src->dtype.param.scale;
-        const float flt_scale = weight->dtype.param.scale;
+        ${flt_scales}
         const float dst_scale = 1.f / dst->dtype.param.scale;
-        const float bias_scale = src_scale * flt_scale;
 
         int16x8_t tmp;
         ${init_store}
@@ -416,6 +417,7 @@ std::string Int8NchwNchw44ConvS1::GetKernelBody(TContext* ctx) const {
             int oc = 0;
             for(; oc < OC_div_4; ++oc) {
                 const int8_t *weight_oc = weight_ptr + oc * weight->layout.stride[0];
+                const float32x4_t bias_scale[1] = {${oc_scale}};
                 ${init_bias}
                 for(int oh = 0; oh < OH; ++oh) {
                     int ow = 0;
@@ -461,6 +463,8 @@ std::string Int8NchwNchw44ConvS1::GetKernelBody(TContext* ctx) const {
                       .add_ctx_int("pad_w")
                       .add("fh", filter_size)
                       .add("init_store", activate_gen->GenIntrinsicInitFloat())
+                      .add("flt_scales", gen_flt_scales("weight"))
+                      .add("oc_scale", gen_oc4_scale("oc * 4"))
                       .add("store_oc4_ow8",
                            [=](const std::string& dst, const std::string& sum,
                                const std::string& bias_scale,
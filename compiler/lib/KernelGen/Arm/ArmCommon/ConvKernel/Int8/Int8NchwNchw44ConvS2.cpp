@@ -1030,6 +1030,8 @@ std::string Int8NchwNchw44ConvS2::GetInitBody(TContext* ctx) const {
         out_weights->dtype.type_enum = TinyNN_QINT8;
         out_weights->name = in_weights->name;
         out_weights->dtype.param.scale = in_weights->dtype.param.scale;
+        out_weights->dtype.param.scales = in_weights->dtype.param.scales;
+        out_weights->dtype.param.nr_scale = in_weights->dtype.param.nr_scale;
     )";
     std::string fill_weight_transform_template = R"(
         const int oc_div_4 = out_weights->layout.dims[0];
@@ -1195,7 +1197,7 @@ bool Int8NchwNchw44ConvS2::IsAvailable(TContext* ctx) const {
                      ctx->getAttrStr("nonlineMode") == "IDENTITY" ||
                      ctx->getAttrStr("nonlineMode") == "RELU";
 
-    bool type_ok = is_qint8_conv_dtype(ctx);
+    bool type_ok = is_qint8_conv_dtype(ctx, false, true);
     bool layout_ok =
             ctx->getAttrOprand("operand:0").shape.size() == 4 &&
             ctx->getAttrOprand(
@@ -1265,9 +1267,8 @@ std::string Int8NchwNchw44ConvS2::GetKernelBody(TContext* ctx) const {
         int8_t *src_packed = (int8_t*)(workspace->ptr);
 
         const float src_scale = src->dtype.param.scale;
-        const float flt_scale = weight->dtype.param.scale;
+        ${flt_scales}
         const float dst_scale = 1.f / dst->dtype.param.scale;
-        const float bias_scale = src_scale * flt_scale;
 
         uint8_t tbl_idx[] = {0, 8, 0, 8, 0, 8, 0, 8, 0, 8, 0, 8, 0, 8, 0, 8};
         uint8x16_t tbl = vld1q_u8(tbl_idx);
@@ -1280,6 +1281,7 @@ std::string Int8NchwNchw44ConvS2::GetKernelBody(TContext* ctx) const {
             int oc = 0;
             for(; oc + 1 < OC_div_4; oc += 2) {
                 const int8_t *weight_oc = weight_ptr + oc * weight->layout.stride[0];
+                const float32x4_t bias_scale[2] = {${oc_scale}, ${oc_scale_1}};
                 ${init_bias_big_oc}
                 for(int oh = 0; oh < OH; ++oh) {
                     int ow = 0;
@@ -1318,6 +1320,7 @@ std::string Int8NchwNchw44ConvS2::GetKernelBody(TContext* ctx) const {
             }
             for(; oc < OC_div_4; ++oc) {
                 const int8_t *weight_oc = weight_ptr + oc * weight->layout.stride[0];
+                const float32x4_t bias_scale[1] = {${oc_scale}};
                 ${init_bias_small_oc}
                 for(int oh = 0; oh < OH; ++oh) {
                     int ow = 0;
@@ -1374,6 +1377,9 @@ std::string Int8NchwNchw44ConvS2::GetKernelBody(TContext* ctx) const {
                       .add_ctx_int("pad_w")
                       .add("fh", filter_size)
                       .add("init_store", activate_gen->GenIntrinsicInitFloat())
+                      .add("flt_scales", gen_flt_scales("weight"))
+                      .add("oc_scale", gen_oc4_scale("oc * 4"))
+                      .add("oc_scale_1", gen_oc4_scale("oc * 4 + 4"))
                       .add("store_oc4_ow4",
                            [=](const std::string& dst, const std::string& sum,
                                const std::string& bias_scale,
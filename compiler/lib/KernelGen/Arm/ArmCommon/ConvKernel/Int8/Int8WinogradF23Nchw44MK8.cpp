@@ -23,7 +23,7 @@ bool WinogradFloatF23Nchw44MK8Int8::IsAvailable(TContext* ctx) const {
                      ctx->getAttrStr("nonlineMode") == "IDENTITY" ||
                      ctx->getAttrStr("nonlineMode") == "RELU";
 
-    bool type_ok = is_qint8_conv_dtype(ctx);
+    bool type_ok = is_qint8_conv_dtype(ctx, false, true);
 
     //! because of MK8 matmul
     bool layout_ok = ctx->getAttrOprand("operand:0").shape.size() == 5 &&
@@ -1,6 +1,7 @@
 #include "Arm/ArmCommon/ConvKernel/Int8/Winograd/WinogradCommon.h"
 #include <memory>
 #include "Arm/ArmCommon/Activation.h"
+#include "Arm/ArmCommon/ConvKernel/Int8/Common.h"
 #include "Common/ConvKernel.h"
 #include "Utils/StringTemplate.h"
 #include "Utils/Utils.h"
@@ -100,6 +101,8 @@ std::string WinogradFrameNchw44Int8::GenInitCode(
     out_weights->layout.stride[3] = 1;
     out_weights->dtype.type_enum = TinyNN_INT16;
     out_weights->dtype.param.scale = in_weights->dtype.param.scale;
+    out_weights->dtype.param.scales = in_weights->dtype.param.scales;
+    out_weights->dtype.param.nr_scale = in_weights->dtype.param.nr_scale;
     out_weights->name = in_weights->name;)";
 
     std::string fill_weight_transform = R"(
@@ -143,7 +146,12 @@ std::string WinogradFrameNchw44Int8::GenKernelBodyCode(
     Tensor* output = outputs[0];
     Layout out_layout = outputs[0]->layout;
 
-    float bias_scale = input->dtype.param.scale * weight->dtype.param.scale * 0.25f;
+    //! the scale of the int32 conv result is src_scale times the filter scale
+    //! of the output channel, the output transform of F23 gives 4 times of the
+    //! conv result, so it uses bias_scale instead
+    ${flt_scales}
+    float src_scale = input->dtype.param.scale;
+    float bias_scale = src_scale * 0.25f;
     float dst_scale = 1.f / output->dtype.param.scale;
 
     const uint32_t PACK_C_SIZE = 4;
@@ -199,6 +207,7 @@ std::string WinogradFrameNchw44Int8::GenKernelBodyCode(
             int8_t* outptr = output_ptr + n * n_output_offset + group * group_output_offset;
             const int32_t* bptr = NULL;
             if(bias_ptr) bptr = bias_ptr + group * OC_per_group;
+            const float* sptr = flt_scales + group * OC_per_group * flt_scale_step;
 
             for(uint32_t tile_id = 0; tile_id < nr_tiles; tile_id += nr_tiles_per_loop) {
                     uint32_t nr_tiles_in_loop = nr_tiles_per_loop > nr_tiles -
@@ -221,7 +230,7 @@ std::string WinogradFrameNchw44Int8::GenKernelBodyCode(
 
                     //! output transform: ATmA
                     {
-                    ${OutputTransform(transform_output_ptr, outptr, bptr, OH, OW, OC_per_group, tile_id, nr_tiles_in_loop)}
+                    ${OutputTransform(transform_output_ptr, outptr, bptr, sptr, OH, OW, OC_per_group, tile_id, nr_tiles_in_loop)}
                     }
                 }
         }
@@ -232,6 +241,7 @@ std::string WinogradFrameNchw44Int8::GenKernelBodyCode(
                       .add("OutputBlockSize", strategy->GetOutputBlockSize())
                       .add("nr_tiles_per_loop", m_tile_per_loop)
                       .add("BiasPtr", bias_ptr)
+                      .add("flt_scales", gen_flt_scales("weight"))
                       .add_ctx_int("pad_h")
                       .add_ctx_int("pad_w")
                       .add("InputTransform",
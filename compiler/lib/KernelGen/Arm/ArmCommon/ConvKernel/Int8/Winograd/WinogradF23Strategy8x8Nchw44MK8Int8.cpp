@@ -266,6 +266,7 @@ std::string WinogradF23Strategy8x8Nchw44MK8Int8::OutputFeatureTrans(
     int32_t* transform_output_ptr_ = ${transform_output_ptr};
     int8_t* outptr_ = ${outptr};
     const int32_t* bias_ptr_ = ${bias_ptr};
+    const float* scale_ptr_ = ${scale_ptr};
     uint32_t OH_ = ${OH};
     uint32_t OW_ = ${OW};
     uint32_t OC_ = ${OC};
@@ -327,10 +328,12 @@ std::string WinogradF23Strategy8x8Nchw44MK8Int8::OutputFeatureTrans(
                 }
 
                 //! fuse activation
+                float32x4_t oc_scale = vmulq_n_f32(
+                        vld1q_f32(scale_ptr_ + (oc + oc_inner) * flt_scale_step), bias_scale);
                 ${nonline_gen_init()}
                 for(int oho = 0; oho < 2 && oh_start + oho < OH_; ++oho)
                     for(int owo = 0; owo < 2 && ow_start + owo < OW_; ++owo){
-                        ${nonline_gen_func(dst_v[oho][owo], outptr_ + (oc + oc_inner) * OH_ * OW_ + (oh_start + oho) * OW_ * 4 + (ow_start + owo) * 4, bias_scale, dst_scale)}
+                        ${nonline_gen_func(dst_v[oho][owo], outptr_ + (oc + oc_inner) * OH_ * OW_ + (oh_start + oho) * OW_ * 4 + (ow_start + owo) * 4, oc_scale, dst_scale)}
                     }
             }
         }
@@ -352,11 +355,12 @@ std::string WinogradF23Strategy8x8Nchw44MK8Int8::OutputFeatureTrans(
                     .add("transform_output_ptr", strs[0])
                     .add("outptr", strs[1])
                     .add("bias_ptr", strs[2])
-                    .add("OH", strs[3])
-                    .add("OW", strs[4])
-                    .add("OC", strs[5])
-                    .add("tile_id", strs[6])
-                    .add("nr_tiles_in_loop", strs[7])
+                    .add("scale_ptr", strs[3])
+                    .add("OH", strs[4])
+                    .add("OW", strs[5])
+                    .add("OC", strs[6])
+                    .add("tile_id", strs[7])
+                    .add("nr_tiles_in_loop", strs[8])
                     .render(ouput_trans);
     return ss.str();
 }
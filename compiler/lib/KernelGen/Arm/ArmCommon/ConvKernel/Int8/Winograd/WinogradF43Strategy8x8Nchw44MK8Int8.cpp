@@ -0,0 +1,415 @@
+#include "WinogradF43Strategy8x8Nchw44MK8Int8.h"
+#include <string>
+#include "Arm/ArmCommon/Activation.h"
+#include "Arm/ArmCommon/InternalMatMul/InternalMatMul.h"
+#include "Utils/StringTemplate.h"
+#include "compiler/KernelGen/KernelGen.h"
+
+using namespace megcc;
+using namespace KernelGen;
+using namespace ArmCommon;
+
+//! The fractional G of F(4, 3) is scaled row by row with D = diag(4, 6, 6, 24,
+//! 24, 1), so the transformed weight D * G * g * GT * D is an exact integer which
+//! is at most 49 * 128 and fits int16. The inverse D is folded into the output
+//! transform, which is also scaled by 24 to keep it integer, so the output
+//! transform gives 576 times of the conv result and it is divided exactly at
+//! last while |conv result| < 2^25, which limits IC to 224.
+std::string WinogradF43Strategy8x8Nchw44MK8Int8::WeightTrans(
+        const std::vector<std::string>& strs) {
+    auto inptr = strs[0];
+    auto outptr = strs[1];
+    auto OC = strs[2];
+    auto IC = strs[3];
+    std::string filter_process = R"(
+        const int alpha = 4 + 3 - 1;
+        //! D * G, the integer version of G
+        //!  1  0  0
+        //! -1 -1 -1
+        //! -1  1 -1
+        //!  1  2  4
+        //!  1 -2  4
+        //!  0  0  1
+        const int16_t G[6][3] = {{1, 0, 0},  {-1, -1, -1}, {-1, 1, -1},
+                                 {1, 2, 4}, {1, -2, 4},   {0, 0, 1}};
+
+        TINYNN_ASSERT_MSG(
+                    ${IC} % 8 == 0 && ${OC} % 8 == 0,
+                "Winograd filter transform input param is not times of 8!");
+        size_t ICB4 = ${IC} / 4;
+        for (size_t oc = 0; oc < ${OC}; oc++) {
+            for (size_t ic = 0; ic < ${IC}; ic++) {
+                const int8_t* fptr = ${filter} +
+                                     ((oc / 4) * ICB4 + ic / 4) * 3 * 3 * 4 * 4 +
+                                     (ic % 4) * 4 + oc % 4;
+                int16_t g[3][3];
+                for (int kh = 0; kh < 3; ++kh) {
+                    for (int kw = 0; kw < 3; ++kw) {
+                        g[kh][kw] = fptr[(kh * 3 + kw) * 4 * 4];
+                    }
+                }
+                //! G * g
+                int16_t wd[6][3];
+                for (int i = 0; i < alpha; ++i) {
+                    for (int j = 0; j < 3; ++j) {
+                        wd[i][j] = G[i][0] * g[0][j] + G[i][1] * g[1][j] +
+                                   G[i][2] * g[2][j];
+                    }
+                }
+                //! (G * g) * GT, stored as (alpha, alpha, OCB, IC, 8)
+                for (int i = 0; i < alpha; ++i) {
+                    for (int j = 0; j < alpha; ++j) {
+                        int16_t v = wd[i][0] * G[j][0] + wd[i][1] * G[j][1] +
+                                    wd[i][2] * G[j][2];
+                        ${outptr}[(i * alpha + j) * ${OC} * ${IC} +
+                                  (oc / 8) * ${IC} * 8 + ic * 8 + oc % 8] = v;
+                    }
+                }
+            }
+        }
+)";
+    std::stringstream ss;
+    ss << StringTemplate::StringTemplateArgs()
+                    .add("OC", OC)
+                    .add("IC", IC)
+                    .add("filter", inptr)
+                    .add("outptr", outptr)
+                    .render(filter_process);
+    return ss.str();
+}
+
+std::string WinogradF43Strategy8x8Nchw44MK8Int8::InputFeatureTrans(
+        const std::vector<std::string>& strs) {
+    auto InputTransformF43NCHW44Int8 = []() {
+        std::string kernel = R"(
+        int16x8_t d[6][6];
+#define cb(m, n) \
+    d[m][n] = vdupq_n_s16(0);
+
+        UNROLL_CALL_NOWRAPPER_D2(6, 6, cb);
+#undef cb
+        //! NCHW4 --> NCHW8
+        if (inner) {
+            const int8_t* input_ptr =
+                    input + ic * IH_ * IW_ + ih_start * IW_ * 4 + iw_start * 4;
+            for (size_t ico = 0; ico < alpha; ++ico) {
+                int8x16_t v_input0 = vld1q_s8(input_ptr);                // c0123
+                int8x16_t v_input1 = vld1q_s8(input_ptr + IH_ * IW_ * 4);  // c4567
+                int32x4_t v32_00 = vreinterpretq_s32_s8(v_input0);
+                int32x4_t v32_01 = vreinterpretq_s32_s8(v_input1);
+
+                int32x4x2_t v_trn = vtrnq_s32(v32_00, v32_01);  // c04261537
+
+                v_input0 = vreinterpretq_s8_s32(v_trn.val[0]);
+                v_input1 = vreinterpretq_s8_s32(v_trn.val[1]);
+
+                d[ico][0] = vmovl_s8(vget_low_s8(v_input0));
+                d[ico][2] = vmovl_s8(vget_high_s8(v_input0));
+                d[ico][1] = vmovl_s8(vget_low_s8(v_input1));
+                d[ico][3] = vmovl_s8(vget_high_s8(v_input1));
+
+                //! the last 2 pixels of the row
+                int32x2_t v32_10 = vreinterpret_s32_s8(vld1_s8(input_ptr + 16));
+                int32x2_t v32_11 =
+                        vreinterpret_s32_s8(vld1_s8(input_ptr + IH_ * IW_ * 4 + 16));
+                int32x2x2_t v_trn_tail = vtrn_s32(v32_10, v32_11);
+                d[ico][4] = vmovl_s8(vreinterpret_s8_s32(v_trn_tail.val[0]));
+                d[ico][5] = vmovl_s8(vreinterpret_s8_s32(v_trn_tail.val[1]));
+
+                input_ptr += IW_ * 4;  // next row
+            }
+        } else {
+            const int8_t* input_ptr = input + ic * IH_ * IW_;
+            int ih0_act = ih_start > 0 ? ih_start : 0,
+                ih1_act = ih_start + alpha < (int)IH_ ? ih_start + alpha : (int)IH_,
+                iw0_act = iw_start > 0 ? iw_start : 0,
+                iw1_act = iw_start + alpha < (int)IW_ ? iw_start + alpha : (int)IW_;
+            // partial copy
+            for (int ih = ih0_act; ih < ih1_act; ++ih) {
+                for (int iw = iw0_act; iw < iw1_act; ++iw) {
+                    size_t iho = ih - ih_start, iwo = iw - iw_start;
+                    d[iho][iwo] = vcombine_s16(
+                            vget_low_s16(vmovl_s8(vld1_s8(input_ptr + ih * IW_ * 4 + iw * 4))),
+                            vget_high_s16(vmovl_s8(vld1_s8(input_ptr + IH_ * IW_ * 4 + ih * IW_ * 4 +
+                                    iw * 4 - 4))));
+                }
+            }
+        }
+
+        // BT * d * B, the max abs sum of the rows of BT is 10, so the result
+        // of int8 input is at most 12800 and fits int16
+
+        //! 4  0 -5  0  1  0
+        //! 0 -4 -4  1  1  0
+        //! 0  4 -4 -1  1  0
+        //! 0 -2 -1  2  1  0
+        //! 0  2 -1 -2  1  0
+        //! 0  4  0 -5  0  1
+#define cb(m)                                                                   \
+    int16x8_t t0##m = vaddq_s16(vshlq_n_s16(vsubq_s16(d[0][m], d[2][m]), 2),    \
+                                vsubq_s16(d[4][m], d[2][m]));                   \
+    int16x8_t t1##m = vsubq_s16(vaddq_s16(d[3][m], d[4][m]),                    \
+                                vshlq_n_s16(vaddq_s16(d[1][m], d[2][m]), 2));   \
+    int16x8_t t2##m = vaddq_s16(vshlq_n_s16(vsubq_s16(d[1][m], d[2][m]), 2),    \
+                                vsubq_s16(d[4][m], d[3][m]));                   \
+    int16x8_t t3##m = vaddq_s16(vshlq_n_s16(vsubq_s16(d[3][m], d[1][m]), 1),    \
+                                vsubq_s16(d[4][m], d[2][m]));                   \
+    int16x8_t t4##m = vaddq_s16(vshlq_n_s16(vsubq_s16(d[1][m], d[3][m]), 1),    \
+                                vsubq_s16(d[4][m], d[2][m]));                   \
+    int16x8_t t5##m = vaddq_s16(vshlq_n_s16(vsubq_s16(d[1][m], d[3][m]), 2),    \
+                                vsubq_s16(d[5][m], d[3][m]));
+
+        UNROLL_CALL_NOWRAPPER(6, cb);
+#undef cb
+
+#define cb(m)                                                                    \
+    d[m][0] = vaddq_s16(vshlq_n_s16(vsubq_s16(t##m##0, t##m##2), 2),             \
+                        vsubq_s16(t##m##4, t##m##2));                            \
+    d[m][1] = vsubq_s16(vaddq_s16(t##m##3, t##m##4),                             \
+                        vshlq_n_s16(vaddq_s16(t##m##1, t##m##2), 2));            \
+    d[m][2] = vaddq_s16(vshlq_n_s16(vsubq_s16(t##m##1, t##m##2), 2),             \
+                        vsubq_s16(t##m##4, t##m##3));                            \
+    d[m][3] = vaddq_s16(vshlq_n_s16(vsubq_s16(t##m##3, t##m##1), 1),             \
+                        vsubq_s16(t##m##4, t##m##2));                            \
+    d[m][4] = vaddq_s16(vshlq_n_s16(vsubq_s16(t##m##1, t##m##3), 1),             \
+                        vsubq_s16(t##m##4, t##m##2));                            \
+    d[m][5] = vaddq_s16(vshlq_n_s16(vsubq_s16(t##m##1, t##m##3), 2),             \
+                        vsubq_s16(t##m##5, t##m##3));
+
+        UNROLL_CALL_NOWRAPPER(6, cb);
+#undef cb
+
+        size_t ICB = IC_ / 8;
+        size_t icb = ic / 8;
+#define cb(m, n)                                                 \
+    vst1q_s16(                                                   \
+            dst + (m * alpha + n) * ICB * nr_tiles_in_loop * 8 + \
+            icb * nr_tiles_in_loop * 8 + tile_idx * 8, d[m][n]);
+        UNROLL_CALL_NOWRAPPER_D2(6, 6, cb)
+#undef cb
+)";
+        return kernel;
+    };
+    std::string input_process = R"(
+    const int alpha = 3 + 4 - 1;
+    const uint32_t OUTPUT_BLOCK_SIZE = 4;
+    const uint32_t KS = 3;
+
+    int16_t* dst = ${transform_input_ptr};
+    const int8_t* input = ${inptr};
+    uint32_t IH_ = ${IH};
+    uint32_t IW_ = ${IW};
+    uint32_t IC_ = ${IC};
+    uint32_t PH_ = ${PH};
+    uint32_t PW_ = ${PW};
+    uint32_t nr_tiles_in_loop_ = ${nr_tiles_in_loop};
+    uint32_t tile_id_ = ${tile_id};
+
+    uint32_t OW = IW_ + 2 * PW_ - KS + 1;
+    uint32_t tiles_w = (OW + OUTPUT_BLOCK_SIZE -1)/ OUTPUT_BLOCK_SIZE;
+
+    for (uint32_t ic = 0; ic < IC_; ic += 8) {
+        uint32_t tile_start_id = tile_id_;
+        for(uint32_t tile_idx = 0; tile_idx < nr_tiles_in_loop_; tile_idx++) {
+            uint32_t index = tile_start_id + tile_idx;
+            uint32_t nh = index / tiles_w;
+            uint32_t nw = index % tiles_w;
+            int ih_start = nh * OUTPUT_BLOCK_SIZE - PH_;
+            int iw_start = nw * OUTPUT_BLOCK_SIZE - PW_;
+            int inner = (ih_start >= 0 && iw_start >= 0 &&
+                        ih_start + alpha <= (int)IH_ &&
+                        iw_start + alpha <= (int)IW_);
+            ${InputTransformF43NCHW44Int8()}
+        }
+    }
+    )";
+    std::stringstream ss;
+    ss << StringTemplate::StringTemplateArgs()
+                    .add("inptr", strs[0])
+                    .add("transform_input_ptr", strs[1])
+                    .add("IH", strs[2])
+                    .add("IW", strs[3])
+                    .add("IC", strs[4])
+                    .add("PH", strs[5])
+                    .add("PW", strs[6])
+                    .add("tile_id", strs[7])
+                    .add("nr_tiles_in_loop", strs[8])
+                    .add("InputTransformF43NCHW44Int8", InputTransformF43NCHW44Int8)
+                    .render(input_process);
+    return ss.str();
+}
+
+std::string WinogradF43Strategy8x8Nchw44MK8Int8::DependMatmulSymbol() {
+    return Int16M8N8K8MatMulKernel().GetKernelSymbol(nullptr);
+}
+
+std::string WinogradF43Strategy8x8Nchw44MK8Int8::BatchedMatMul(
+        const std::vector<std::string>& strs) {
+    std::string matmul_compute = R"(
+    for(uint32_t i =0; i< Alpha; i++){
+        for(uint32_t j=0; j<Alpha; j++){
+            const int16_t* a_ptr = ${A_ptr} +
+                (i * Alpha + j) * ${OC} * ${IC};
+            int16_t* b_ptr = ${B_ptr} +
+                (i * Alpha + j) * ${nr_tiles_in_loop} * ${IC};
+            int32_t* c_ptr = ${C_ptr} +
+                (i * Alpha + j) * ${nr_tiles_in_loop} * ${OC};
+            ${MatMul}(a_ptr, ${LDA}, b_ptr, ${LDB}, c_ptr, ${LDC}, ${OC},
+                    ${nr_tiles_in_loop}, ${IC});
+        }
+    })";
+
+    std::stringstream ss;
+    ss << StringTemplate::StringTemplateArgs()
+                    .add("MatMul", DependMatmulSymbol())
+                    .add("A_ptr", strs[0])
+                    .add("LDA", strs[1])
+                    .add("B_ptr", strs[2])
+                    .add("LDB", strs[3])
+                    .add("C_ptr", strs[4])
+                    .add("LDC", strs[5])
+                    .add("OC", strs[6])
+                    .add("IC", strs[7])
+                    .add("nr_tiles_in_loop", strs[8])
+                    .render(matmul_compute);
+    return ss.str();
+}
+
+std::string WinogradF43Strategy8x8Nchw44MK8Int8::OutputFeatureTrans(
+        const std::vector<std::string>& strs, TContext* ctx) {
+    std::string ouput_trans = R"(
+    int32_t* transform_output_ptr_ = ${transform_output_ptr};
+    int8_t* outptr_ = ${outptr};
+    const int32_t* bias_ptr_ = ${bias_ptr};
+    const float* scale_ptr_ = ${scale_ptr};
+    uint32_t OH_ = ${OH};
+    uint32_t OW_ = ${OW};
+    uint32_t OC_ = ${OC};
+    uint32_t tile_id_ = ${tile_id};
+    uint32_t nr_tiles_in_loop_ = ${nr_tiles_in_loop};
+
+    const uint32_t OutputBlockSize = 4;
+    uint32_t tiles_w_ = (OW_ + OutputBlockSize -1) / OutputBlockSize;
+
+    for (uint32_t oc = 0; oc < OC_; oc += 8) {
+        for(uint32_t tile_idx = 0; tile_idx < nr_tiles_in_loop_; tile_idx++) {
+            uint32_t index = tile_id_ + tile_idx;
+            uint32_t nh = index / tiles_w_;
+            uint32_t nw = index % tiles_w_;
+            uint32_t oh_start = nh * OutputBlockSize;
+            uint32_t ow_start = nw * OutputBlockSize;
+
+            //! AT * m * A
+            uint32_t OCB = OC_ / 8;
+
+            for(uint32_t oc_inner = 0; oc_inner < 8; oc_inner += 4) {
+                int32x4_t src[6][6];
+
+#define LOAD_V(m, n)                                               \
+    src[m][n] = vld1q_s32(transform_output_ptr_ +                  \
+            (m * Alpha + n) * OCB * nr_tiles_in_loop_ * 8 +        \
+            oc * nr_tiles_in_loop_ + tile_idx * 8 + oc_inner);
+
+                UNROLL_CALL_NOWRAPPER_D2(6, 6, LOAD_V);
+#undef LOAD_V
+
+                //! 24 * AT * inverse(D)
+                //! 6  4  4  1  1  0
+                //! 0  4 -4  2 -2  0
+                //! 0  4  4  4  4  0
+                //! 0  4 -4  8 -8 24
+                //! the intermediate results may wrap around, but the
+                //! arithmetic is exact modulo 2^32
+                int32x4_t mid[4][6];
+#define MULTI_ONE(m)                                                              \
+    {                                                                             \
+        int32x4_t s12 = vaddq_s32(src[1][m], src[2][m]);                          \
+        int32x4_t d12 = vsubq_s32(src[1][m], src[2][m]);                          \
+        int32x4_t s34 = vaddq_s32(src[3][m], src[4][m]);                          \
+        int32x4_t d34 = vsubq_s32(src[3][m], src[4][m]);                          \
+        mid[0][m] = vaddq_s32(vmulq_n_s32(src[0][m], 6),                          \
+                              vaddq_s32(vshlq_n_s32(s12, 2), s34));               \
+        mid[1][m] = vshlq_n_s32(vaddq_s32(vshlq_n_s32(d12, 1), d34), 1);          \
+        mid[2][m] = vshlq_n_s32(vaddq_s32(s12, s34), 2);                          \
+        mid[3][m] = vshlq_n_s32(vaddq_s32(vaddq_s32(d12, vshlq_n_s32(d34, 1)),    \
+                                          vmulq_n_s32(src[5][m], 6)), 2);         \
+    }
+
+                UNROLL_CALL_NOWRAPPER(6, MULTI_ONE);
+#undef MULTI_ONE
+
+                int32x4_t dst_v[4][4];
+#define MULTI_TWO(m)                                                              \
+    {                                                                             \
+        int32x4_t s12 = vaddq_s32(mid[m][1], mid[m][2]);                          \
+        int32x4_t d12 = vsubq_s32(mid[m][1], mid[m][2]);                          \
+        int32x4_t s34 = vaddq_s32(mid[m][3], mid[m][4]);                          \
+        int32x4_t d34 = vsubq_s32(mid[m][3], mid[m][4]);                          \
+        dst_v[m][0] = vaddq_s32(vmulq_n_s32(mid[m][0], 6),                        \
+                                vaddq_s32(vshlq_n_s32(s12, 2), s34));             \
+        dst_v[m][1] = vshlq_n_s32(vaddq_s32(vshlq_n_s32(d12, 1), d34), 1);        \
+        dst_v[m][2] = vshlq_n_s32(vaddq_s32(s12, s34), 2);                        \
+        dst_v[m][3] = vshlq_n_s32(vaddq_s32(vaddq_s32(d12, vshlq_n_s32(d34, 1)),  \
+                                            vmulq_n_s32(mid[m][5], 6)), 2);       \
+    }
+
+                UNROLL_CALL_NOWRAPPER(4, MULTI_TWO);
+#undef MULTI_TWO
+
+                //! divide 576 = 64 * 9 exactly, shift the factor 64 out and
+                //! multiply the inverse of 9 modulo 2^32, then the low 26 bits
+                //! are the conv result, which is sign extended. So the result
+                //! is exact when its absolute value is less than 2^25.
+#define DIV_576(m, n)                                                             \
+    dst_v[m][n] = vmulq_n_s32(vshrq_n_s32(dst_v[m][n], 6), 0x38E38E39);           \
+    dst_v[m][n] = vshrq_n_s32(vshlq_n_s32(dst_v[m][n], 6), 6);
+
+                UNROLL_CALL_NOWRAPPER_D2(4, 4, DIV_576);
+#undef DIV_576
+
+                if (bias_ptr_) {
+                    int32x4_t vbias = vld1q_s32(bias_ptr_ + oc + oc_inner);
+#define ADD_BIAS(m, n) dst_v[m][n] = vaddq_s32(dst_v[m][n], vbias);
+                    UNROLL_CALL_NOWRAPPER_D2(4, 4, ADD_BIAS);
+#undef ADD_BIAS
+                }
+
+                //! fuse activation
+                float32x4_t oc_scale = vmulq_n_f32(
+                        vld1q_f32(scale_ptr_ + (oc + oc_inner) * flt_scale_step), src_scale);
+                ${nonline_gen_init()}
+                for(int oho = 0; oho < 4 && oh_start + oho < OH_; ++oho)
+                    for(int owo = 0; owo < 4 && ow_start + owo < OW_; ++owo){
+                        ${nonline_gen_func(dst_v[oho][owo], outptr_ + (oc + oc_inner) * OH_ * OW_ + (oh_start + oho) * OW_ * 4 + (ow_start + owo) * 4, oc_scale, dst_scale)}
+                    }
+            }
+        }
+    })";
+    std::string nonline_mode =
+            ctx->haveAttr("nonlineMode") ? ctx->getAttrStr("nonlineMode") : "IDENTITY";
+    auto nonline_gen = create_activation_gener_instrinsic(nonline_mode);
+    auto nonline_gen_func = [&](std::vector<std::string> str) -> std::string {
+        return nonline_gen->GenIntrinsicQuantStore(str[0], str[1], str[2], str[3]);
+    };
+    auto nonline_gen_init = [&]() -> std::string {
+        return nonline_gen->GenIntrinsicInitFloat();
+    };
+
+    std::stringstream ss;
+    ss << StringTemplate::StringTemplateArgs()
+                    .add("nonline_gen_func", nonline_gen_func)
+                    .add("nonline_gen_init", nonline_gen_init)
+                    .add("transform_output_ptr", strs[0])
+                    .add("outptr", strs[1])
+                    .add("bias_ptr", strs[2])
+                    .add("scale_ptr", strs[3])
+                    .add("OH", strs[4])
+                    .add("OW", strs[5])
+                    .add("OC", strs[6])
+                    .add("tile_id", strs[7])
+                    .add("nr_tiles_in_loop", strs[8])
+                    .render(ouput_trans);
+    return ss.str();
+}
+
+// vim: syntax=cpp.doxygen
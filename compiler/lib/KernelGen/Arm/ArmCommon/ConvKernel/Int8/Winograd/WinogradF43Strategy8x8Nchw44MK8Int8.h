@@ -0,0 +1,27 @@
+#pragma once
+#include <string>
+#include "Arm/ArmCommon/ConvKernel/Fp32/Winograd/WinogradCommon.h"
+#include "Common/ConvKernel.h"
+#include "Utils/StringTemplate.h"
+#include "compiler/KernelGen/KernelGen.h"
+namespace megcc {
+namespace KernelGen {
+namespace ArmCommon {
+
+class WinogradF43Strategy8x8Nchw44MK8Int8 : public ArmCommon::WinogradStrategyBase {
+public:
+    uint32_t GetKernelSize() override { return 3; }
+    uint32_t GetOutputBlockSize() override { return 4; }
+    std::string DependMatmulSymbol() override;
+    std::string WeightTrans(const std::vector<std::string>& strs) override;
+    std::string InputFeatureTrans(const std::vector<std::string>& strs) override;
+    std::string BatchedMatMul(const std::vector<std::string>& strs) override;
+    std::string OutputFeatureTrans(
+            const std::vector<std::string>& strs, TContext*) override;
+};
+
+}  // namespace ArmCommon
+}  // namespace KernelGen
+}  // namespace megcc
+
+// vim: syntax=cpp.doxygen
@@ -3,6 +3,7 @@
 #include "../InternalKernel.h"
 #include "../NeonIntrinCompat.h"
 #include "Utils/SymbolHelper.h"
+#include "Utils/Utils.h"
 #include "compiler/Common/Logger.h"
 
 using namespace megcc;
@@ -56,6 +57,10 @@ std::string ElemwiseKernel::GetKernelSymbol(TContext* context) const {
     }
     //! TODO: add ternary elemwise
     ss << "_" << SymbolHelper::gen_io_str(context);
+    auto mode = context->getAttrStr("mode");
+    if (mode == "EXP" || mode == "SIGMOID") {
+        ss << ExpNeonKernel(Utils::get_fast_math_ulp(context)).FastMathSymbol();
+    }
     return ss.str();
 }
 
@@ -68,7 +73,7 @@ std::string ElemwiseKernel::GetKernelBody(TContext* ctx) const {
         operands.push_back(ctx->getAttrOprand("operand:" + std::to_string(i)));
     }
     auto ElemwiseImpl = ElemwiseHelperFunc::CreateGenHelper(mode, operands);
-    auto InternalKernelFunc = ExpNeonKernel();
+    auto InternalKernelFunc = ExpNeonKernel(Utils::get_fast_math_ulp(ctx));
     CC_ASSERT(ElemwiseImpl) << "ElemwiseHelper Create error!\n";
     writer << R"(
         #include <arm_neon.h>
@@ -78,6 +83,7 @@ std::string ElemwiseKernel::GetKernelBody(TContext* ctx) const {
     )";
     writer << gen_neon_intrin_compat();
     writer << "extern " << InternalKernelFunc.GetKernelSignature(ctx) << ";\n";
+    writer << InternalKernelFunc.GetFuncAlias();
     writer << "\n\n";
     writer << GenCommonRet() << " " << GetKernelSignature(ctx) << "{\n";
     //! input + output = 2, unary case
@@ -127,7 +133,7 @@ std::vector<KernelObj> ElemwiseKernel::GetDependInternalSymbol(TContext* ctx) co
     auto mode = ctx->getAttrStr("mode");
     std::vector<KernelObj> depends;
     if (mode == "EXP" || mode == "SIGMOID") {
-        ExpNeonKernel kern;
+        ExpNeonKernel kern(Utils::get_fast_math_ulp(ctx));
         depends.emplace_back(
                 kern.GetKernelSymbol(ctx), kern.GetKernelBody(ctx),
                 kern.GetBodyGuardBegin(ctx), kern.GetBodyGuardEnd(ctx));
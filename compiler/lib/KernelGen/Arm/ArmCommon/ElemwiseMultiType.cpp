@@ -0,0 +1,77 @@
+#include "ElemwiseMultiType.h"
+#include "Common/ElemwiseMultiType.h"
+#include "NeonIntrinCompat.h"
+#include "Utils/SymbolHelper.h"
+#include "Utils/Utils.h"
+#include "compiler/Common/Logger.h"
+
+using namespace megcc;
+using namespace KernelGen;
+using namespace ArmCommon;
+
+//! the modes with exp or sigmoid are left to the GI kernel
+bool ElemwiseMultiTypeKernel::IsAvailable(TContext* context) const {
+    if (!ElemwiseMultiTypeHelper::is_available(context)) {
+        return false;
+    }
+    auto& desc = ElemwiseMultiTypeHelper::get_mode(context);
+    return !desc.simd.empty() && !desc.need_math;
+}
+
+//! kernel gen
+std::string ElemwiseMultiTypeKernel::GetKernelSymbol(TContext* context) const {
+    std::stringstream ss;
+    ss << "ArmCommon_kernel_elementwise_multitype_" << context->getAttrStr("mode")
+       << "_" << SymbolHelper::gen_io_str(context);
+    return ss.str();
+}
+
+std::string ElemwiseMultiTypeKernel::GetKernelBody(TContext* context) const {
+    std::stringstream writer;
+    writer << R"(
+        #include <math.h>
+        #include <arm_neon.h>
+        #include "tensor_util.h"
+    )";
+    writer << gen_neon_intrin_compat();
+    writer << R"(
+        #define V_DUP vdupq_n_f32
+        #define V_ADD vaddq_f32
+        #define V_SUB vsubq_f32
+        #define V_MUL vmulq_f32
+        #define V_DIV vdivq_f32
+        #define V_MAX vmaxq_f32
+        #define V_MIN vminq_f32
+        #define V_NEG vnegq_f32
+        #define V_ABS vabsq_f32
+        #define V4_GET(v, idx) ((v).val[idx])
+        #define V4_SET(v, idx, s) ((v).val[idx] = (s))
+
+        static inline float32x4x4_t dequant_16(const int8_t* ptr, float32x4_t vscale) {
+            int8x16_t v = vld1q_s8(ptr);
+            int16x8_t v_low = vmovl_s8(vget_low_s8(v));
+            int16x8_t v_high = vmovl_s8(vget_high_s8(v));
+            float32x4x4_t ret;
+            ret.val[0] = vmulq_f32(vcvtq_f32_s32(vmovl_s16(vget_low_s16(v_low))), vscale);
+            ret.val[1] = vmulq_f32(vcvtq_f32_s32(vmovl_s16(vget_high_s16(v_low))), vscale);
+            ret.val[2] = vmulq_f32(vcvtq_f32_s32(vmovl_s16(vget_low_s16(v_high))), vscale);
+            ret.val[3] = vmulq_f32(vcvtq_f32_s32(vmovl_s16(vget_high_s16(v_high))), vscale);
+            return ret;
+        }
+
+        static inline void requant_16(int8_t* ptr, float32x4x4_t v) {
+            int16x8_t v_low = vcombine_s16(
+                    vqmovn_s32(vcvtaq_s32_f32(v.val[0])), vqmovn_s32(vcvtaq_s32_f32(v.val[1])));
+            int16x8_t v_high = vcombine_s16(
+                    vqmovn_s32(vcvtaq_s32_f32(v.val[2])), vqmovn_s32(vcvtaq_s32_f32(v.val[3])));
+            vst1q_s8(ptr, vcombine_s8(vqmovn_s16(v_low), vqmovn_s16(v_high)));
+        }
+    )";
+    writer << ElemwiseMultiTypeHelper::GenOpFunc(context, "float32x4_t");
+    writer << GenCommonRet() << " " << GetKernelSignature(context) << "{\n";
+    writer << ElemwiseMultiTypeHelper::GenBody(context, "float32x4_t", "float32x4x4_t");
+    writer << "}\n";
+    return writer.str();
+}
+
+// vim: syntax=cpp.doxygen
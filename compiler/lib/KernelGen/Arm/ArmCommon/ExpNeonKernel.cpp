@@ -1,19 +1,99 @@
 #include "InternalKernel.h"
+#include "Utils/Utils.h"
 #include "compiler/Common/Logger.h"
 
 using namespace megcc;
 using namespace KernelGen;
 using namespace ArmCommon;
 
+namespace {
+//! coeffs are from the highest degree, exp(r) = 1 + r + r^2 * P(r) with the minimax P
+//! for the relative error on [-ln2/2, ln2/2]
+std::string gen_fast_exp(
+        const std::string& func_name, const std::vector<float>& coeffs) {
+    std::stringstream writer;
+    writer << R"(
+    #include<arm_neon.h>
+
+    /* exp() with a degree )"
+           << coeffs.size() + 1 << R"( polynomial, inputs are clamped to the normal range */
+    float32x4_t )" << func_name
+           << R"((float32x4_t x) {
+        x = vminq_f32(x, vdupq_n_f32(88.3762512f));
+        x = vmaxq_f32(x, vdupq_n_f32(-87.3365479f));
+
+        /* express exp(x) as exp(r + n*log(2)), |r| <= log(2)/2 */
+        float32x4_t t = vmulq_f32(x, vdupq_n_f32(1.44269504f));
+#if defined(__aarch64__)
+        int32x4_t n = vcvtaq_s32_f32(t);
+#else
+        uint32x4_t neg = vcltq_f32(t, vdupq_n_f32(0.f));
+        t = vaddq_f32(t, vbslq_f32(neg, vdupq_n_f32(-0.5f), vdupq_n_f32(0.5f)));
+        int32x4_t n = vcvtq_s32_f32(t);
+#endif
+        float32x4_t fn = vcvtq_f32_s32(n);
+        float32x4_t r = vmlaq_f32(x, fn, vdupq_n_f32(-0.693359375f));
+        r = vmlaq_f32(r, fn, vdupq_n_f32(2.12194440e-4f));
+
+        float32x4_t y = vdupq_n_f32()"
+           << Utils::ssprintf("%.9ef", coeffs[0]) << ");";
+    for (size_t i = 1; i < coeffs.size(); ++i) {
+        writer << "\n        y = vmlaq_f32(vdupq_n_f32("
+               << Utils::ssprintf("%.9ef", coeffs[i]) << "), y, r);";
+    }
+    writer << R"(
+        y = vmlaq_f32(r, y, vmulq_f32(r, r));
+        y = vaddq_f32(y, vdupq_n_f32(1.f));
+
+        /* build 2^n */
+        int32x4_t mm = vshlq_n_s32(vaddq_s32(n, vdupq_n_s32(0x7f)), 23);
+        return vmulq_f32(y, vreinterpretq_f32_s32(mm));
+    })";
+    return writer.str();
+}
+}  // namespace
+
+std::string ExpNeonKernel::GetFuncName() const {
+    if (m_max_ulp >= DEG4_ULP) {
+        return "exp_ps_f32_deg4";
+    } else if (m_max_ulp >= DEG5_ULP) {
+        return "exp_ps_f32_deg5";
+    }
+    return "exp_ps_f32";
+}
+
+std::string ExpNeonKernel::GetFuncAlias() const {
+    if (m_max_ulp >= DEG5_ULP) {
+        return "#define exp_ps_f32 " + GetFuncName() + "\n";
+    }
+    return "";
+}
+
+std::string ExpNeonKernel::FastMathSymbol() const {
+    if (m_max_ulp >= DEG5_ULP) {
+        return "_fastmath_ulp" + std::to_string(m_max_ulp);
+    }
+    return "";
+}
+
 std::string ExpNeonKernel::GetKernelSymbol(TContext*) const {
-    return "ArmCommon_internel_exp_ps_f32";
+    return "ArmCommon_internel_" + GetFuncName();
 }
 
 std::string ExpNeonKernel::GetKernelSignature(TContext*) const {
-    return R"(float32x4_t exp_ps_f32(float32x4_t x))";
+    return "float32x4_t " + GetFuncName() + "(float32x4_t x)";
 }
 
 std::string ExpNeonKernel::GetKernelBody(TContext*) const {
+    if (m_max_ulp >= DEG4_ULP) {
+        return gen_fast_exp(
+                GetFuncName(), {4.1277747601270676e-2f, 1.6753514111042023e-1f,
+                                5.0005114078521729e-1f});
+    } else if (m_max_ulp >= DEG5_ULP) {
+        return gen_fast_exp(
+                GetFuncName(), {8.3125252276659012e-3f, 4.1890114545822144e-2f,
+                                1.6667114198207855e-1f, 4.9999231100082397e-1f});
+    }
     std::stringstream writer;
 
     writer << R"(
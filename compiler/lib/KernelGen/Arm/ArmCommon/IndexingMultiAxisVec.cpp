@@ -0,0 +1,88 @@
+#include "IndexingMultiAxisVec.h"
+#include "Common/Indexing.h"
+#include "Utils/StringTemplate.h"
+#include "Utils/SymbolHelper.h"
+#include "Utils/Utils.h"
+#include "compiler/Common/Logger.h"
+
+using namespace megcc;
+using namespace KernelGen;
+using namespace ArmCommon;
+
+bool IndexingMultiAxisKernel::IsAvailable(TContext* context) const {
+    int nr_operand = context->getAttrInt("nr_operands");
+    bool ok_operand = nr_operand > 2;
+    auto src_dtype = context->getAttrOprand("operand:0").dtype;
+    auto dst_dtype = Utils::get_last_operand(context).dtype;
+    size_t type_size = Utils::get_dtype_size(src_dtype);
+    bool ok_dtype = SymbolHelper::gen_valid_dtype(src_dtype) ==
+                            SymbolHelper::gen_valid_dtype(dst_dtype) &&
+                    (type_size == 1 || type_size == 2 || type_size == 4);
+    bool ok_axis = true;
+    int last_axis = -1;
+    for (int i = 0; i < nr_operand - 2; ++i) {
+        int axis = context->getAttrInt("axis:" + std::to_string(i));
+        if (last_axis >= 0) {
+            ok_axis = ok_axis && (axis == last_axis + 1);
+        }
+        last_axis = axis;
+    }
+    return ok_dtype && ok_operand && ok_axis;
+}
+
+//! kernel gen
+std::string IndexingMultiAxisKernel::GetKernelSymbol(TContext* context) const {
+    std::stringstream ss;
+    ss << "ArmCommon_kernel_indexingmultiaxisvec";
+    int nr_operand = context->getAttrInt("nr_operands");
+    for (int i = 0; i < nr_operand - 2; ++i) {
+        ss << "_" << context->getAttrInt("axis:" + std::to_string(i));
+    }
+    ss << "_"
+       << SymbolHelper::gen_valid_dtype(context->getAttrOprand("operand:0").dtype);
+    return ss.str();
+}
+
+std::string IndexingMultiAxisKernel::GetKernelBody(TContext* context) const {
+    auto src_dtype = context->getAttrOprand("operand:0").dtype;
+    std::string specifier =
+            IndexingHelper::GetMoveSpecifier(Utils::get_dtype_size(src_dtype));
+    std::stringstream writer;
+    writer << R"(
+        #include <arm_neon.h>
+        #include <string.h>
+        #include "tensor_util.h"
+
+        static inline void copy_row(void* dst_ptr, const void* src_ptr, size_t nr_bytes) {
+            uint8_t* dst = (uint8_t*)dst_ptr;
+            const uint8_t* src = (const uint8_t*)src_ptr;
+            size_t i = 0;
+            for (; i + 64 <= nr_bytes; i += 64) {
+                uint8x16_t v0 = vld1q_u8(src + i);
+                uint8x16_t v1 = vld1q_u8(src + i + 16);
+                uint8x16_t v2 = vld1q_u8(src + i + 32);
+                uint8x16_t v3 = vld1q_u8(src + i + 48);
+                vst1q_u8(dst + i, v0);
+                vst1q_u8(dst + i + 16, v1);
+                vst1q_u8(dst + i + 32, v2);
+                vst1q_u8(dst + i + 48, v3);
+            }
+            for (; i + 16 <= nr_bytes; i += 16) {
+                vst1q_u8(dst + i, vld1q_u8(src + i));
+            }
+            for (; i + 8 <= nr_bytes; i += 8) {
+                vst1_u8(dst + i, vld1_u8(src + i));
+            }
+            if (i < nr_bytes) {
+                memcpy(dst + i, src + i, nr_bytes - i);
+            }
+        }
+    )";
+    writer << GenCommonRet() << " " << GetKernelSignature(context) << "{\n";
+    writer << IndexingHelper::GenMultiAxisVecBody(
+            context->getAttrInt("axis:0"), specifier, "copy_row");
+    writer << "}\n";
+    return writer.str();
+}
+
+// vim: syntax=cpp.doxygen
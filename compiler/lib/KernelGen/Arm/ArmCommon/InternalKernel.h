@@ -8,11 +8,30 @@ namespace ArmCommon {
 
 class ExpNeonKernel : public InternalKernelFunc {
 public:
+    //! max_ulp is the error budget given by fast-math, a lower degree polynomial is
+    //! used when it allows, the default is the full precision cephes exp
+    ExpNeonKernel(int max_ulp = 0) : m_max_ulp(max_ulp) {}
+
+    //! max ulp error of the fast-math variants
+    static constexpr int DEG5_ULP = 4;
+    static constexpr int DEG4_ULP = 80;
+
     std::string GetKernelSymbol(TContext*) const override;
 
     std::string GetKernelSignature(TContext*) const override;
 
     std::string GetKernelBody(TContext*) const override;
+
+    //! the fast-math variant is named differently from exp_ps_f32, as callers
+    //! always use exp_ps_f32, the alias should be emitted after the declaration
+    std::string GetFuncAlias() const;
+
+    //! kernels with different precision should not share the same symbol
+    std::string FastMathSymbol() const;
+
+private:
+    std::string GetFuncName() const;
+    int m_max_ulp;
 };
 
 class MatmulInternal : public InternalKernelFunc {
@@ -1,14 +1,20 @@
 #include "KernelPack.h"
 #include <memory>
+#include "Argmax.h"
 #include "CVTranspose.h"
+#include "Concat.h"
 #include "ConvKernel.h"
 #include "CvtColor.h"
 #include "Elemwise/Elemwise.h"
+#include "ElemwiseMultiType.h"
 #include "Flip.h"
+#include "IndexingMultiAxisVec.h"
+#include "IndexingOneHot.h"
 #include "InternalKernel.h"
 #include "MatMulKernel/Fp32Gemv.h"
 #include "MatMulKernel/Fp32Gevm.h"
 #include "MatMulKernel/Int16MatMulM8N8K8.h"
+#include "Padding.h"
 #include "Pooling.h"
 #include "Reduce.h"
 #include "Relayout.h"
@@ -22,6 +28,7 @@ namespace {
 struct AllArmCommonKernel {
     AllArmCommonKernel() {
         inner_map[KernelPack::KernType::ConvKernel] = {
+                std::make_shared<ArmCommon::WinogradF43Nchw44MK8Int8>(),
                 std::make_shared<ArmCommon::WinogradFloatF23Nchw44MK8Int8>(),
                 std::make_shared<ArmCommon::ChannelWiseFloatMk4>(),
                 std::make_shared<ArmCommon::ConvFloatNCHWNCHW44>(),
@@ -53,6 +60,12 @@ struct AllArmCommonKernel {
         inner_map[KernelPack::KernType::ReduceKernel] = {
                 std::make_shared<ArmCommon::ReduceKernel>()};
 
+        inner_map[KernelPack::KernType::ArgmaxKernel] = {
+                std::make_shared<ArmCommon::ArgmaxKernel>()};
+
+        inner_map[KernelPack::KernType::ArgminKernel] = {
+                std::make_shared<ArmCommon::ArgminKernel>()};
+
         inner_map[KernelPack::KernType::CvtColorKernel] = {
                 std::make_shared<ArmCommon::CvtColorKernel>()};
 
@@ -68,8 +81,23 @@ struct AllArmCommonKernel {
         inner_map[KernelPack::KernType::ElemwiseKernel] = {
                 std::make_shared<ArmCommon::ElemwiseKernel>()};
 
+        inner_map[KernelPack::KernType::ElemwiseMultiKernel] = {
+                std::make_shared<ArmCommon::ElemwiseMultiTypeKernel>()};
+
         inner_map[KernelPack::KernType::InternelKernel] = {
                 std::make_shared<ArmCommon::ExpNeonKernel>()};
+
+        inner_map[KernelPack::KernType::IndexingMultiAxisKernel] = {
+                std::make_shared<ArmCommon::IndexingMultiAxisKernel>()};
+
+        inner_map[KernelPack::KernType::IndexingOneHotKernel] = {
+                std::make_shared<ArmCommon::IndexingOneHotKernel>()};
+
+        inner_map[KernelPack::KernType::ConcatKernel] = {
+                std::make_shared<ArmCommon::ConcatKernel>()};
+
+        inner_map[KernelPack::KernType::PaddingKernel] = {
+                std::make_shared<ArmCommon::PaddingKernel>()};
     }
 
     std::unordered_map<KernelPack::KernType, std::vector<std::shared_ptr<KernelFunc>>>
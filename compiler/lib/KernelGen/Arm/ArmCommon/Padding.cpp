@@ -0,0 +1,111 @@
+#include "Padding.h"
+#include "Common/Padding.h"
+#include "Utils/StringTemplate.h"
+#include "Utils/SymbolHelper.h"
+#include "Utils/Utils.h"
+#include "compiler/Common/Logger.h"
+
+using namespace megcc;
+using namespace KernelGen;
+using namespace ArmCommon;
+
+bool PaddingKernel::IsAvailable(TContext* context) const {
+    std::string padding_mode = context->getAttrStr("padding_mode");
+    bool mode_ok =
+            (padding_mode == "REPLICATE" || padding_mode == "CONSTANT" ||
+             padding_mode == "REFLECT");
+    //! fp16 needs the fp16 pad value conversion, leave it to the naive kernel
+    auto dtype = context->getAttrOprand("operand:0").dtype;
+    size_t type_size = Utils::get_dtype_size(dtype);
+    bool dtype_ok = !Utils::is_float_dtype(dtype, 16) &&
+                    (type_size == 1 || type_size == 4);
+    return mode_ok && dtype_ok;
+}
+
+//! kernel gen
+std::string PaddingKernel::GetKernelSymbol(TContext* context) const {
+    std::stringstream ss;
+    ss << "ArmCommon_kernel_padding_front_offset_";
+    for (int i = 0; i < 7; ++i) {
+        ss << context->getAttrInt("front_offsets:" + std::to_string(i)) << "_";
+    }
+    std::string padding_mode = context->getAttrStr("padding_mode");
+    ss << padding_mode << "_";
+    if (padding_mode == "CONSTANT") {
+        ss << SymbolHelper::gen_valid_float(context->getAttrFloat("padding_val"))
+           << "_";
+    }
+    ss << SymbolHelper::gen_valid_dtype(context->getAttrOprand("operand:0").dtype);
+    return ss.str();
+}
+
+std::string PaddingKernel::GetKernelBody(TContext* context) const {
+    std::string padding_mode = context->getAttrStr("padding_mode");
+    std::vector<int> front_offsets;
+    for (int i = 0; i < 7; ++i) {
+        front_offsets.push_back(
+                context->getAttrInt("front_offsets:" + std::to_string(i)));
+    }
+    std::string specifier =
+            Utils::cvt_dtype_specifier(context->getAttrOprand("operand:0").dtype);
+    std::stringstream writer;
+    writer << R"(
+        #include <string.h>
+        #include <arm_neon.h>
+        #include "tensor_util.h"
+
+        static inline void copy_row(void* dst_ptr, const void* src_ptr, size_t nr_bytes) {
+            uint8_t* dst = (uint8_t*)dst_ptr;
+            const uint8_t* src = (const uint8_t*)src_ptr;
+            size_t i = 0;
+            for (; i + 64 <= nr_bytes; i += 64) {
+                uint8x16_t v0 = vld1q_u8(src + i);
+                uint8x16_t v1 = vld1q_u8(src + i + 16);
+                uint8x16_t v2 = vld1q_u8(src + i + 32);
+                uint8x16_t v3 = vld1q_u8(src + i + 48);
+                vst1q_u8(dst + i, v0);
+                vst1q_u8(dst + i + 16, v1);
+                vst1q_u8(dst + i + 32, v2);
+                vst1q_u8(dst + i + 48, v3);
+            }
+            for (; i + 16 <= nr_bytes; i += 16) {
+                vst1q_u8(dst + i, vld1q_u8(src + i));
+            }
+            for (; i + 8 <= nr_bytes; i += 8) {
+                vst1_u8(dst + i, vld1_u8(src + i));
+            }
+            if (i < nr_bytes) {
+                memcpy(dst + i, src + i, nr_bytes - i);
+            }
+        }
+
+        //! the pattern period divides 16 bytes and every fill starts at an
+        //! element boundary, so the tail is the head of the pattern
+        static inline void fill_row(void* dst_ptr, const uint8_t* pattern, size_t nr_bytes) {
+            uint8_t* dst = (uint8_t*)dst_ptr;
+            uint8x16_t v = vld1q_u8(pattern);
+            size_t i = 0;
+            for (; i + 64 <= nr_bytes; i += 64) {
+                vst1q_u8(dst + i, v);
+                vst1q_u8(dst + i + 16, v);
+                vst1q_u8(dst + i + 32, v);
+                vst1q_u8(dst + i + 48, v);
+            }
+            for (; i + 16 <= nr_bytes; i += 16) {
+                vst1q_u8(dst + i, v);
+            }
+            if (i < nr_bytes) {
+                memcpy(dst + i, pattern, nr_bytes - i);
+            }
+        }
+    )";
+    writer << PaddingHelper::GenSrcIndexFunc(padding_mode);
+    writer << GenCommonRet() << " " << GetKernelSignature(context) << "{\n";
+    writer << PaddingHelper::GenBody(
+            front_offsets, padding_mode, context->getAttrFloat("padding_val"),
+            specifier, "copy_row", "fill_row");
+    writer << "}\n";
+    return writer.str();
+}
+
+// vim: syntax=cpp.doxygen
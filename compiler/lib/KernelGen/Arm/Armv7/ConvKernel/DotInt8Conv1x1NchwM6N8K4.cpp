@@ -1,5 +1,6 @@
 #include <sstream>
 #include <string>
+#include "Arm/ArmCommon/ConvKernel/Int8/Common.h"
 #include "Arm/Armv7/Activation.h"
 #include "Arm/Armv7/ConvKernel/ConvKernel.h"
 #include "Utils/StringTemplate.h"
@@ -11,13 +12,19 @@ using namespace Armv7;
 
 std::shared_ptr<TContext> DotInt8Conv1x1NCHWM6N8K4::GetInnerCtx(TContext* ctx) const {
     auto inner_ctx = std::make_shared<CodeGenContext>();
-    if (ctx->haveAttr("nonlineMode")) {
+    //! the gemm of the per channel quantized filter only accumulates to int32
+    const bool per_channel = is_per_channel_scale(ctx);
+    if (ctx->haveAttr("nonlineMode") && !per_channel) {
         inner_ctx->setAttr("nonlineMode", CCAttr(ctx->getAttrStr("nonlineMode")));
     }
     inner_ctx->setAttr("with_bias", ConvImpl::is_bias(ctx));
     inner_ctx->setAttr("transposeA", false);
     inner_ctx->setAttr("transposeB", false);
     inner_ctx->setAttr("format", "MK");
+    if (per_channel) {
+        inner_ctx->setAttr("dtype", "8832");
+        return inner_ctx;
+    }
     inner_ctx->setAttr("dtype", ctx->getAttrOprand("operand:0").dtype);
     auto last_dtype = Utils::get_last_operand(ctx).dtype;
     auto last_dtype_str = SymbolHelper::gen_valid_dtype(last_dtype);
@@ -42,7 +49,7 @@ bool DotInt8Conv1x1NCHWM6N8K4::IsAvailable(TContext* ctx) const {
                      ctx->getAttrStr("nonlineMode") == "IDENTITY" ||
                      ctx->getAttrStr("nonlineMode") == "RELU" ||
                      ctx->getAttrStr("nonlineMode") == "H_SWISH";
-    bool type_ok = is_qint8_conv_dtype(ctx);
+    bool type_ok = is_qint8_conv_dtype(ctx, false, true);
     bool layout_ok = ctx->getAttrOprand("operand:0").shape.size() == 4;
 
     bool bias_ok = !is_bias(ctx) || is_channel_broadcast_bias(ctx);
@@ -51,7 +58,9 @@ bool DotInt8Conv1x1NCHWM6N8K4::IsAvailable(TContext* ctx) const {
 }
 
 std::string DotInt8Conv1x1NCHWM6N8K4::GetKernelSymbol(TContext* ctx) const {
-    return "Armv7_int8_dot_Conv1x1_M6N8K4_" + ConvImpl::GetKernelSymbol(ctx);
+    std::string per_channel_str = is_per_channel_scale(ctx) ? "_per_channel" : "";
+    return "Armv7_int8_dot_Conv1x1_M6N8K4_" + ConvImpl::GetKernelSymbol(ctx) +
+           per_channel_str;
 }
 
 std::vector<KernelObj> DotInt8Conv1x1NCHWM6N8K4::GetDependInternalSymbol(
@@ -128,6 +137,8 @@ std::string DotInt8Conv1x1NCHWM6N8K4::GetInitBody(TContext* context) const {
         out_weights->dtype.type_enum = TinyNN_QINT8;
         out_weights->name = in_weights->name;
         out_weights->dtype.param.scale = in_weights->dtype.param.scale;
+        out_weights->dtype.param.scales = in_weights->dtype.param.scales;
+        out_weights->dtype.param.nr_scale = in_weights->dtype.param.nr_scale;
 )";
     std::string fill_weight_transform = R"(
     int8_t* outptr = out_weights->ptr;
@@ -175,7 +186,7 @@ std::string DotInt8Conv1x1NCHWM6N8K4::GetKernelBody(TContext* context) const {
     const int LDC = out_h * out_w;
 
     const float src_scale = inputs[0]->dtype.param.scale;
-    const float flt_scale = inputs[1]->dtype.param.scale;
+    ${flt_scale_str}
     const float dst_scale = outputs[0]->dtype.param.scale;
     const float temp_scale = src_scale * flt_scale;
     // this must be 1.f/dst_scale for quant data
@@ -197,7 +208,7 @@ std::string DotInt8Conv1x1NCHWM6N8K4::GetKernelBody(TContext* context) const {
         int32_t* bias_data = ${bias_ptr_str};
 
         ${packb_sym}(workspace_ptr, input_data, LDB, 0, in_h * in_w, 0, in_c);
-        ${naked_kern_sym}(weight_data, workspace_ptr, output_data, LDC, out_c, N, in_c, bias_data, temp_dst, scale, temp_scale, dst_scale_inv);
+        ${gemm_store}
         input_data += in_c * in_h * in_w;
         output_data += out_c * out_h * out_w;
     }
@@ -206,7 +217,54 @@ std::string DotInt8Conv1x1NCHWM6N8K4::GetKernelBody(TContext* context) const {
 }
 )";
 
+    std::string flt_scale_str = "const float flt_scale = inputs[1]->dtype.param.scale;";
+    std::string gemm_store =
+            "${naked_kern_sym}(weight_data, workspace_ptr, output_data, LDC, out_c, "
+            "N, in_c, bias_data, temp_dst, scale, temp_scale, dst_scale_inv);";
+    std::string init_store, quant_store;
+    //! the int32 result of the gemm is requantized row by row with the scale of
+    //! every output channel, the tail of the row goes through a temp buffer
+    if (is_per_channel_scale(context)) {
+        auto act = ArmCommon::create_activation_gener_instrinsic(nonline_mode);
+        flt_scale_str = gen_flt_scales("inputs[1]");
+        init_store = act->GenIntrinsicInitFloat();
+        quant_store = act->GenIntrinsicQuantStore(
+                "res", "store_ptr", "oc_scale", "dst_scale_inv");
+        gemm_store = R"(${naked_kern_sym}(weight_data, workspace_ptr, temp_dst, LDC, out_c, N, in_c, bias_data, scale, temp_scale, dst_scale_inv);
+        {
+            ${init_store}
+            for (int oc = 0; oc < out_c; ++oc) {
+                const float32x4_t oc_scale =
+                        vdupq_n_f32(src_scale * flt_scales[oc * flt_scale_step]);
+                const int32_t* gemm_ptr = (int32_t*)temp_dst + oc * LDC;
+                int8_t* dst_ptr = output_data + oc * LDC;
+                size_t i = 0;
+                for (; i + 4 <= N; i += 4) {
+                    int32x4_t res = vld1q_s32(gemm_ptr + i);
+                    int8_t* store_ptr = dst_ptr + i;
+                    ${quant_store}
+                }
+                if (i < N) {
+                    int32_t res_remain[4] = {0};
+                    int8_t store_remain[4];
+                    memcpy(res_remain, gemm_ptr + i, (N - i) * sizeof(int32_t));
+                    int32x4_t res = vld1q_s32(res_remain);
+                    int8_t* store_ptr = store_remain;
+                    ${quant_store}
+                    memcpy(dst_ptr + i, store_remain, N - i);
+                }
+            }
+        })";
+    }
+    gemm_store = StringTemplate::StringTemplateArgs()
+                         .add("naked_kern_sym",
+                              inner_gemm.GetNakedKernelSymbol(inner_ctx.get()))
+                         .add("init_store", init_store)
+                         .add("quant_store", quant_store)
+                         .render(gemm_store);
     writer << StringTemplate::StringTemplateArgs(context)
+                      .add("flt_scale_str", flt_scale_str)
+                      .add("gemm_store", gemm_store)
                       .add("bias_ptr_str", bias_ptr_str)
                       .add("packb_size_sym",
                            inner_gemm.GetPackBWorkspaceSymbol(inner_ctx.get()))
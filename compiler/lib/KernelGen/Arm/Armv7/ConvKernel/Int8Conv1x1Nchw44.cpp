@@ -1,5 +1,6 @@
 #include <sstream>
 #include <string>
+#include "Arm/ArmCommon/ConvKernel/Int8/Common.h"
 #include "Arm/Armv7/Activation.h"
 #include "Arm/Armv7/ConvKernel/ConvKernel.h"
 #include "Utils/StringTemplate.h"
@@ -11,13 +12,19 @@ using namespace Armv7;
 
 std::shared_ptr<TContext> Int8Conv1x1NCHW44::GetInnerCtx(TContext* ctx) const {
     auto inner_ctx = std::make_shared<CodeGenContext>();
-    if (ctx->haveAttr("nonlineMode")) {
+    //! the gemm of the per channel quantized filter only accumulates to int32
+    const bool per_channel = is_per_channel_scale(ctx);
+    if (ctx->haveAttr("nonlineMode") && !per_channel) {
         inner_ctx->setAttr("nonlineMode", CCAttr(ctx->getAttrStr("nonlineMode")));
     }
     inner_ctx->setAttr("with_bias", ConvImpl::is_bias(ctx));
     inner_ctx->setAttr("transposeA", false);
     inner_ctx->setAttr("transposeB", false);
     inner_ctx->setAttr("format", "MK4");
+    if (per_channel) {
+        inner_ctx->setAttr("dtype", "8832");
+        return inner_ctx;
+    }
     inner_ctx->setAttr("dtype", ctx->getAttrOprand("operand:0").dtype);
     auto last_dtype = Utils::get_last_operand(ctx).dtype;
     auto last_dtype_str = SymbolHelper::gen_valid_dtype(last_dtype);
@@ -42,7 +49,7 @@ bool Int8Conv1x1NCHW44::IsAvailable(TContext* ctx) const {
                      ctx->getAttrStr("nonlineMode") == "IDENTITY" ||
                      ctx->getAttrStr("nonlineMode") == "RELU" ||
                      ctx->getAttrStr("nonlineMode") == "H_SWISH";
-    bool type_ok = is_qint8_conv_dtype(ctx);
+    bool type_ok = is_qint8_conv_dtype(ctx, false, true);
     bool layout_ok = ctx->getAttrOprand("operand:0").shape.size() == 5 &&
                      ctx->getAttrOprand("operand:0").shape[4] == 4;
 
@@ -52,7 +59,8 @@ bool Int8Conv1x1NCHW44::IsAvailable(TContext* ctx) const {
 }
 
 std::string Int8Conv1x1NCHW44::GetKernelSymbol(TContext* ctx) const {
-    return "Armv7_int8_Conv1x1_" + ConvImpl::GetKernelSymbol(ctx);
+    std::string per_channel_str = is_per_channel_scale(ctx) ? "_per_channel" : "";
+    return "Armv7_int8_Conv1x1_" + ConvImpl::GetKernelSymbol(ctx) + per_channel_str;
 }
 
 std::vector<KernelObj> Int8Conv1x1NCHW44::GetDependInternalSymbol(TContext* ctx) const {
@@ -129,6 +137,8 @@ std::string Int8Conv1x1NCHW44::GetInitBody(TContext* context) const {
         out_weights->dtype.type_enum = TinyNN_QINT8;
         out_weights->name = in_weights->name;
         out_weights->dtype.param.scale = in_weights->dtype.param.scale;
+        out_weights->dtype.param.scales = in_weights->dtype.param.scales;
+        out_weights->dtype.param.nr_scale = in_weights->dtype.param.nr_scale;
 )";
     std::string fill_weight_transform = R"(
     int8_t* outptr = out_weights->ptr;
@@ -177,7 +187,7 @@ std::string Int8Conv1x1NCHW44::GetKernelBody(TContext* context) const {
     const int LDC = out_h * out_w * PACK_C_SIZE;
 
     const float src_scale = inputs[0]->dtype.param.scale;
-    const float flt_scale = inputs[1]->dtype.param.scale;
+    ${flt_scale_str}
     const float dst_scale = outputs[0]->dtype.param.scale;
     const float temp_scale = src_scale * flt_scale;
     // this must be 1.f/dst_scale for quant data
@@ -199,7 +209,7 @@ std::string Int8Conv1x1NCHW44::GetKernelBody(TContext* context) const {
         int32_t* bias_data = ${bias_ptr_str};
 
         ${packb_sym}(workspace_ptr, input_data, LDB, 0, in_h * in_w, 0, in_c);
-        ${naked_kern_sym}(weight_data, workspace_ptr, output_data, LDC, out_c, N, in_c, bias_data, temp_dst, scale, temp_scale, dst_scale_inv);
+        ${gemm_store}
         input_data += in_c * in_h * in_w;
         output_data += out_c * out_h * out_w;
     }
@@ -208,7 +218,30 @@ std::string Int8Conv1x1NCHW44::GetKernelBody(TContext* context) const {
 }
 )";
 
+    std::string flt_scale_str = "const float flt_scale = inputs[1]->dtype.param.scale;";
+    std::string gemm_store =
+            "${naked_kern_sym}(weight_data, workspace_ptr, output_data, LDC, out_c, "
+            "N, in_c, bias_data, temp_dst, scale, temp_scale, dst_scale_inv);";
+    std::string requant_store;
+    //! the int32 result of the gemm is requantized with the scale vector of
+    //! every 4 output channels
+    if (is_per_channel_scale(context)) {
+        auto act = ArmCommon::create_activation_gener_instrinsic(nonline_mode);
+        flt_scale_str = gen_flt_scales("inputs[1]");
+        gemm_store = R"(${naked_kern_sym}(weight_data, workspace_ptr, temp_dst, LDC, out_c, N, in_c, bias_data, scale, temp_scale, dst_scale_inv);
+        ${requant_store})";
+        requant_store = gen_mk4_requant_store(
+                *act, "(int32_t*)temp_dst", "LDC", "output_data", "LDC",
+                "out_c / PACK_C_SIZE", "N", "0");
+    }
+    gemm_store = StringTemplate::StringTemplateArgs()
+                         .add("naked_kern_sym",
+                              inner_gemm.GetNakedKernelSymbol(inner_ctx.get()))
+                         .add("requant_store", requant_store)
+                         .render(gemm_store);
     writer << StringTemplate::StringTemplateArgs(context)
+                      .add("flt_scale_str", flt_scale_str)
+                      .add("gemm_store", gemm_store)
                       .add("bias_ptr_str", bias_ptr_str)
                       .add("packb_size_sym",
                            inner_gemm.GetPackBWorkspaceSymbol(inner_ctx.get()))
@@ -1,4 +1,5 @@
 #include "Int8DirectNchwBase.h"
+#include "Arm/ArmCommon/ConvKernel/Int8/Common.h"
 
 namespace megcc {
 namespace KernelGen {
@@ -79,7 +80,8 @@ std::string Int8DirectNchwHelperBase::gen_res_store_code(
         const std::string& reg_name, const std::string& dst_name,
         const ArmCommon::ActivationGenIntrinsicBase& act) {
     std::stringstream ss;
-    ss << act.GenIntrinsicQuantStore(reg_name, dst_name, "bias_scale", "inv_dst_scale");
+    ss << act.GenIntrinsicQuantStore(
+            reg_name, dst_name, "vdupq_n_f32(bias_scale)", "inv_dst_scale");
     return ss.str();
 }
 
@@ -182,11 +184,10 @@ std::string Int8DirectNchwBase::GetKernelBody(TContext* context) const {
     const size_t FW = ${kernel_w};
 
     const float src_scale = inputs[0]->dtype.param.scale;
-    const float flt_scale = inputs[1]->dtype.param.scale;
+    ${flt_scales}
     const float dst_scale = outputs[0]->dtype.param.scale;
     // this must be 1.f/dst_scale for quant data
     const float dst_scale_inv = 1.f / dst_scale;
-    const float scale = src_scale * flt_scale;
 
     int8_t* input_data = inputs[0]->ptr;
     int8_t* output_data = outputs[0]->ptr;
@@ -230,6 +231,7 @@ std::string Int8DirectNchwBase::GetKernelBody(TContext* context) const {
             const int8_t* filter_oc_ptr = weight_data + group_id * ocpg * icpg * FH * FW;
             int8_t* output_oc_ptr = output_data + batch_id * out_batch_stride + group_id * ocpg * OC_stride;
             rep(oc_idx, ocpg){
+                const float scale = src_scale * flt_scales[(group_id * ocpg + oc_idx) * flt_scale_step];
                 if (need_dst_copy_padding_flag) {
                     do_conv_kern(src_ptr, filter_oc_ptr, bias_data + group_id * ocpg + oc_idx, temp_buffer, dst_buffer, OH2, OW2, icpg, IH2, IW2, 
                         FH, FW, scale, dst_scale_inv);
@@ -260,6 +262,7 @@ std::string Int8DirectNchwBase::GetKernelBody(TContext* context) const {
                       .add("padding_do_conv_body", padding_do_conv_body)
                       .add("bias_str", bias_str)
                       .add("group_str", group_str)
+                      .add("flt_scales", gen_flt_scales("inputs[1]"))
                       .render(body_temp);
     return writer.str();
 }
@@ -690,8 +690,12 @@ std::string DotInt8x8x32M6N8K4MatMulKernel::GetKernelSymbol(TContext* ctx) const
         ss << "_" << ctx->getAttrStr("nonlineMode");
     }
     auto dtype = ctx->getAttrStr("dtype");
-    CC_ASSERT(Utils::is_quant_dtype(dtype, 8)) << "Only support qsi8 dtype.\n";
-    ss << "_qsi8";
+    if (Utils::is_quant_dtype(dtype, 8)) {
+        ss << "_qsi8";
+    } else {
+        CC_ASSERT(dtype == "8832") << "Only support qsi8 and 8832 dtype.\n";
+        ss << "_" << dtype;
+    }
     if (ctx->haveAttr("last_dtype")) {
         auto last_dtype = ctx->getAttrStr("last_dtype");
         ss << "_"
@@ -724,7 +728,6 @@ std::string DotInt8x8x32M6N8K4MatMulKernel::GetPackBWorkspaceBody(TContext* ctx)
 
 std::string DotInt8x8x32M6N8K4MatMulKernel::GetKernelBody(TContext* context) const {
     auto d_type = context->getAttrStr("dtype");
-    CC_ASSERT(d_type != "8832");
     std::stringstream writer;
     writer << "#include <string.h>\n";
     writer << "#include <math.h>\n";
@@ -749,6 +752,13 @@ std::string DotInt8x8x32M6N8K4MatMulKernel::GetKernelBody(TContext* context) con
     writer << gen_pack_b(GetPackBSignature(context));
     writer << gen_pack_a_workspace(GetPackAWorkspaceSignature(context));
     writer << gen_pack_b_workspace(GetPackBWorkspaceSignature(context));
+    //! 8832 stores the int32 result to C without the postprocess
+    if (d_type == "8832") {
+        writer << gen_kernel(
+                dst_specifier, GetNakedKernelSignature(context), context, "", "",
+                false);
+        return writer.str();
+    }
     auto postprocess_pair = gen_postprocess_inline(context, true);
     writer << postprocess_pair.first;
     writer << gen_kernel(
@@ -503,6 +503,9 @@ std::string Int8x8x32MK4MatMulKernel::GetKernelBody(TContext* context) const {
                         .add("packa_sym", GetPackASymbol(context))
                         .add("packb_sym", GetPackBSymbol(context))
                         .render(preset_temp);
+        writer << gen_kernel(
+                dst_specifier, GetNakedKernelSignature(context), context, "", "",
+                false);
         writer << gen_kernel(
                 dst_specifier, GetKernelSignature(context), context, "", preset_str,
                 false);
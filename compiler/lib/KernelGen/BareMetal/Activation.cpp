@@ -54,9 +54,10 @@ std::string GenActivation::gen_func_call_with_typecvt_dep(
                 return (int8_t)(res);
             }
         )";
-    } else if (src_specifier == dst_specifier) {
+    } else if (src_specifier == dst_specifier ||
+               (src_specifier == "float" && dst_specifier == "gi_float16_t")) {
         std::string type_cvt = "";
-        if (src_specifier == "gi_float16_t") {
+        if (dst_specifier == "gi_float16_t") {
             type_cvt = R"(
 static float FastFp16toFp32(const gi_float16_t data) { 
     const unsigned short x =*(unsigned short*)&data; 
@@ -117,6 +118,9 @@ std::string GenActivation::gen_func_call_with_typecvt(
             return "FastFp32toFp16(" + act_str + ")";
         }
         return gen_func_call(mode, args);
+    } else if (src_specifier == "float" && dst_specifier == "gi_float16_t") {
+        //! fp16 output of the fp32 accumulator
+        return "FastFp32toFp16(" + gen_func_call(mode, args) + ")";
     } else {
         CC_ABORT << "not support type" << src_specifier << " to " << dst_specifier
                  << "\n";
@@ -14,6 +14,13 @@ public:
     std::string GetKernelBody(TContext* context) const override;
 };
 
+class ArgminKernel : public KernelFunc {
+public:
+    bool IsAvailable(TContext* context) const override;
+    std::string GetKernelSymbol(TContext* context) const override;
+    std::string GetKernelBody(TContext* context) const override;
+};
+
 }  // namespace BareMetal
 }  // namespace KernelGen
 }  // namespace megcc
\ No newline at end of file
@@ -152,6 +152,10 @@ std::string ConvImpl::GetKernelSymbol(TContext* ctx) const {
             ctx->getAttrStr("nonlineMode") != "IDENTITY") {
             extra_ss << "_" << ctx->getAttrStr("nonlineMode");
         }
+        if (ctx->haveAttr("compute_mode") &&
+            ctx->getAttrStr("compute_mode") == "FLOAT32") {
+            extra_ss << "_comp_f32";
+        }
         std::string name_temp =
                 "kernel_conv2d_${kernel_h}x${kernel_w}_${format}_${sparse}_p$"
                 "{pad_h}x${pad_w}_s${stride_h}x${stride_w}_d${dilate_h}x${"
@@ -203,7 +207,9 @@ std::string ConvGeneral::GetKernelBody(TContext* context) const {
     if (src_specifier == "int8_t" && flt_specifier == "int8_t") {
         acc_specifier = "int";
     }
-    if (src_specifier == "gi_float16_t" && flt_specifier == "gi_float16_t") {
+    //! fp16 convolution accumulates in fp32 with FLOAT32 compute mode
+    if (src_specifier == "gi_float16_t" && flt_specifier == "gi_float16_t" &&
+        context->getAttrStr("compute_mode") != "FLOAT32") {
         acc_specifier = "gi_float16_t";
     }
 
@@ -306,6 +312,9 @@ std::string ConvGeneral::GetKernelBody(TContext* context) const {
         for (uint32_t group_idx = 0; group_idx < group; ++group_idx) {
             for (uint32_t ocpg_idx = 0; ocpg_idx < ocpg; ++ocpg_idx) {
                 uint32_t oc_idx = group_idx * ocpg + ocpg_idx;
+                //! the per output channel scale of the quantized filter
+                const float* flt_scales = filter_weight->dtype.param.scales;
+                const float oc_flt_scale = flt_scales ? flt_scales[oc_idx] : flt_scale;
                 for (uint32_t oh_idx = 0; oh_idx < oh; ++oh_idx) {
                     for (uint32_t ow_idx = 0; ow_idx < ow; ++ow_idx) {
                         ${acc_specifier} dval = 0;
@@ -357,7 +366,7 @@ std::string ConvGeneral::GetKernelBody(TContext* context) const {
                     .add("act_func",
                          GenActivation::gen_func_call_with_typecvt(
                                  noline_mode, "dval", acc_specifier, dst_specifier,
-                                 "scale", "flt_scale", "dst_scale"))
+                                 "scale", "oc_flt_scale", "dst_scale"))
                     .add("gen_bias_ptr",
                          [&]() -> std::string {
                              if (with_bias) {
@@ -19,6 +19,7 @@
 #include "IndexingOneHot.h"
 #include "MatrixInv.h"
 #include "MatrixMul.h"
+#include "NMSKeep.h"
 #include "Padding.h"
 #include "Pooling.h"
 #include "PowC.h"
@@ -27,10 +28,12 @@
 #include "Resize.h"
 #include "RoiCopy.h"
 #include "Rotate.h"
+#include "SepFilter.h"
 #include "Topk.h"
 #include "Typecvt.h"
 #include "WarpAffine.h"
 #include "WarpPerspective.h"
+#include "WeightQuantMatMul.h"
 using namespace megcc;
 using namespace KernelGen;
 using namespace BareMetal;
@@ -48,6 +51,7 @@ struct AllBareKernel {
         inner_map[KernelPack::KernType::MatrixInvKernel] = {
                 std::make_shared<BareMetal::MatrixInvKernel>()};
         inner_map[KernelPack::KernType::MatrixMulKernel] = {
+                std::make_shared<BareMetal::WeightQuantMatMulKernel>(),
                 std::make_shared<BareMetal::Fp32GemvKernel>(),
                 std::make_shared<BareMetal::Fp32GevmKernel>(),
                 std::make_shared<BareMetal::MatrixMulKernel>()};
@@ -89,6 +93,8 @@ struct AllBareKernel {
                 std::make_shared<BareMetal::ConcatKernel>()};
         inner_map[KernelPack::KernType::ArgmaxKernel] = {
                 std::make_shared<BareMetal::ArgmaxKernel>()};
+        inner_map[KernelPack::KernType::ArgminKernel] = {
+                std::make_shared<BareMetal::ArgminKernel>()};
         inner_map[KernelPack::KernType::ConvBackDataKernel] = {
                 std::make_shared<BareMetal::ConvBackDataGeneral>()};
         inner_map[KernelPack::KernType::FusedElemwiseKernel] = {
@@ -99,6 +105,10 @@ struct AllBareKernel {
                 std::make_shared<BareMetal::GaussianBlurKernel>()};
         inner_map[KernelPack::KernType::PaddingKernel] = {
                 std::make_shared<BareMetal::PaddingKernel>()};
+        inner_map[KernelPack::KernType::NMSKeepKernel] = {
+                std::make_shared<BareMetal::NMSKeepKernel>()};
+        inner_map[KernelPack::KernType::CVSepFilterKernel] = {
+                std::make_shared<BareMetal::SepFilterKernel>()};
     }
 
     std::unordered_map<KernelPack::KernType, std::vector<std::shared_ptr<KernelFunc>>>
@@ -1,6 +1,7 @@
 #include <float.h>
 #include <sstream>
 
+#include "Common/MatrixInv.h"
 #include "FormatHelper.h"
 #include "MatrixInv.h"
 #include "Utils/StringTemplate.h"
@@ -44,7 +45,17 @@ std::string MatrixInvKernel::GetKernelBody(TContext* context) const {
     ss << R"(
         #include <math.h>
         #include <string.h>
+
+        typedef float mi_vec_t;
+        #define MI_LANE 1
+        #define MI_LOAD(ptr) (*(ptr))
+        #define MI_STORE(ptr, v) (*(ptr) = (v))
+        #define MI_MUL(a, b) ((a) * (b))
+        #define MI_MLA(acc, a, b) ((acc) + (a) * (b))
+        #define MI_MLS(acc, a, b) ((acc) - (a) * (b))
+        #define MI_RECIP(a) (1.f / (a))
     )";
+    ss << MatrixInvHelper::gen_small_inverses();
     ss << GenCommonRet() << " " << GetKernelSignature(context);
     std::string body_temp = R"({
     float* a_data = (float*)inputs[0]->ptr;
@@ -60,6 +71,7 @@ std::string MatrixInvKernel::GetKernelBody(TContext* context) const {
     for (int i = 0; i < a_layout.nr_dim - 2; ++i) {
         batch *= a_layout.dims[i];
     }
+    ${small_dispatch}
     float* src_buffer = (float*)(workspace->ptr);
     for (int b_idx = 0; b_idx < batch; ++b_idx){
         float* batch_src = a_data + b_idx * n * n;
@@ -113,7 +125,10 @@ std::string MatrixInvKernel::GetKernelBody(TContext* context) const {
 
     return TinyNN_SUCCESS;
 })";
-    ss << body_temp;
+    ss << StringTemplate::StringTemplateArgs()
+                    .add("small_dispatch", MatrixInvHelper::gen_small_dispatch(
+                                                   "a_data", "c_data", "n", "batch"))
+                    .render(body_temp);
     return ss.str();
 }
 
@@ -17,8 +17,10 @@ bool MatrixMulKernel::IsAvailable(TContext* context) const {
     bool ok_fp16 = context->getAttrOprand("operand:0").dtype == "f16" &&
                    context->getAttrOprand("operand:1").dtype == "f16" &&
                    context->getAttrOprand("operand:2").dtype == "f16";
+    //! fp16 matmul may accumulate in fp32
     bool ok_mode = context->getAttrStr("format") == "DEFAULT" &&
-                   context->getAttrStr("compute_mode") == "DEFAULT";
+                   (context->getAttrStr("compute_mode") == "DEFAULT" ||
+                    (ok_fp16 && context->getAttrStr("compute_mode") == "FLOAT32"));
     return (ok_dtype || ok_fp16) && ok_mode;
 }
 
@@ -37,6 +39,9 @@ std::string MatrixMulKernel::GetKernelSymbol(TContext* context) const {
         ss << "n";
     }
     ss << "_" << context->getAttrOprand("operand:0").dtype;
+    if (context->getAttrStr("compute_mode") == "FLOAT32") {
+        ss << "_comp_f32";
+    }
     return ss.str();
 }
 
@@ -72,6 +77,8 @@ std::string MatrixMulKernel::GetKernelBody(TContext* context) const {
     bool trans_a = context->getAttrBool("transposeA");
     bool trans_b = context->getAttrBool("transposeB");
     auto type = Utils::cvt_dtype_specifier(context->getAttrOprand("operand:0").dtype);
+    std::string acc_type =
+            context->getAttrStr("compute_mode") == "FLOAT32" ? "float" : type;
     if (type == "gi_float16_t") {
         ss << R"(
 #include "gi_float16.h"
@@ -100,7 +107,7 @@ std::string MatrixMulKernel::GetKernelBody(TContext* context) const {
     ${k_init}
     for (int m_idx = 0; m_idx < m; ++m_idx) {
         for (int n_idx = 0; n_idx < n; ++n_idx) {
-            ${c_type} sum = 0.0;
+            ${acc_type} sum = 0.0;
             for (int k_idx = 0; k_idx < k; ++k_idx) {
                 ${a_init}
                 ${b_init}
@@ -114,9 +121,10 @@ std::string MatrixMulKernel::GetKernelBody(TContext* context) const {
 
     ss << StringTemplate::StringTemplateArgs()
                     .add("k_init", emit_k(trans_a))
-                    .add("a_init", emit_a_val(trans_a, type))
-                    .add("b_init", emit_b_val(trans_b, type))
+                    .add("a_init", emit_a_val(trans_a, acc_type))
+                    .add("b_init", emit_b_val(trans_b, acc_type))
                     .add("c_type", type)
+                    .add("acc_type", acc_type)
                     .render(body_temp);
     return ss.str();
 }
@@ -0,0 +1,63 @@
+#include "NMSKeep.h"
+#include "Common/NMSKeep.h"
+#include "Utils/StringTemplate.h"
+#include "Utils/SymbolHelper.h"
+#include "Utils/Utils.h"
+#include "compiler/Common/Logger.h"
+
+using namespace megcc;
+using namespace KernelGen;
+using namespace BareMetal;
+
+bool NMSKeepKernel::IsAvailable(TContext* context) const {
+    return context->getAttrOprand("operand:0").dtype == "f32";
+}
+
+//! kernel gen
+std::string NMSKeepKernel::GetKernelSymbol(TContext* context) const {
+    std::stringstream ss;
+    ss << "kernel_nms_keep_iou_"
+       << SymbolHelper::gen_valid_float(context->getAttrFloat("iou_thresh"))
+       << "_max_" << context->getAttrUInt("max_output") << "_f32";
+    return ss.str();
+}
+
+std::string NMSKeepKernel::GetWorkspaceBody(TContext* context) const {
+    return NMSKeepHelper::GenWorkspaceBody(
+            GenCommonRet() + " " + GetWorkspaceSignature(context));
+}
+
+std::string NMSKeepKernel::GetKernelBody(TContext* context) const {
+    std::stringstream writer;
+    writer << R"(
+        #include <string.h>
+        #include "tensor_util.h"
+
+        //! the IoU test is inter > union * thresh to avoid the division
+        static inline void suppress(const float* x0, const float* y0, const float* x1,
+                                    const float* y1, const float* area,
+                                    uint32_t* removed, int i, int nr_boxes,
+                                    float thresh) {
+            for (int j = i + 1; j < nr_boxes; ++j) {
+                float left = x0[i] > x0[j] ? x0[i] : x0[j];
+                float top = y0[i] > y0[j] ? y0[i] : y0[j];
+                float right = x1[i] < x1[j] ? x1[i] : x1[j];
+                float bottom = y1[i] < y1[j] ? y1[i] : y1[j];
+                float w = right - left > 0.f ? right - left : 0.f;
+                float h = bottom - top > 0.f ? bottom - top : 0.f;
+                float inter = w * h;
+                if (inter > (area[i] + area[j] - inter) * thresh) {
+                    removed[j] = 1;
+                }
+            }
+        }
+    )";
+    writer << GenCommonRet() << " " << GetKernelSignature(context) << "{\n";
+    writer << NMSKeepHelper::GenBody(
+            context->getAttrFloat("iou_thresh"), context->getAttrUInt("max_output"),
+            "suppress");
+    writer << "}\n";
+    return writer.str();
+}
+
+// vim: syntax=cpp.doxygen
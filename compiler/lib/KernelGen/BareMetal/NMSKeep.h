@@ -0,0 +1,24 @@
+#pragma once
+#include <string>
+#include "compiler/KernelGen/KernelGen.h"
+
+namespace megcc {
+namespace KernelGen {
+namespace BareMetal {
+
+class NMSKeepKernel : public KernelFunc {
+public:
+    bool IsAvailable(TContext* context) const override;
+    std::string GetKernelSymbol(TContext* context) const override;
+    std::string GetKernelBody(TContext* context) const override;
+    std::string GetWorkspaceBody(TContext* context) const override;
+    std::string GetWorkspaceBodyAndJitExec(TContext* context) const override {
+        return GetWorkspaceBody(context);
+    }
+};
+
+}  // namespace BareMetal
+}  // namespace KernelGen
+}  // namespace megcc
+
+// vim: syntax=cpp.doxygen
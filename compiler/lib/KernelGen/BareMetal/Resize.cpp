@@ -3,6 +3,7 @@
 
 #include "Common/Resize.h"
 #include "FormatHelper.h"
+#include "Fp16Common.h"
 #include "Resize.h"
 #include "Utils/StringTemplate.h"
 #include "Utils/SymbolHelper.h"
@@ -13,15 +14,10 @@ using namespace KernelGen;
 using namespace BareMetal;
 
 bool ResizeKernel::IsAvailable(TContext* context) const {
-    auto src_dtype = context->getAttrOprand("operand:0").dtype;
-    bool dtype_ok = src_dtype == "f32";
     bool mode_ok = context->getAttrStr("imode") == "LINEAR" ||
                    context->getAttrStr("imode") == "NEAREST";
-
-    bool format_ok = context->getAttrStr("format") == "NCHW" ||
-                     (context->getAttrStr("format") == "NCHW44" &&
-                      context->getAttrStr("imode") == "LINEAR");
-    return dtype_ok && mode_ok && format_ok;
+    return ResizeHelper::is_dtype_ok(context) && mode_ok &&
+           ResizeHelper::is_format_ok(context);
 }
 //! kernel gen
 std::string ResizeKernel::GetKernelSymbol(TContext* context) const {
@@ -29,7 +25,8 @@ std::string ResizeKernel::GetKernelSymbol(TContext* context) const {
     auto src_dtype = context->getAttrOprand("operand:0").dtype;
     auto fmt = context->getAttrStr("format");
     auto imode = context->getAttrStr("imode");
-    ss << "kernel_resize_linear_" << fmt << "_" << imode << "_" << src_dtype;
+    ss << "kernel_resize_linear_" << fmt << "_" << imode << "_"
+       << SymbolHelper::gen_valid_dtype(src_dtype);
     return ss.str();
 }
 
@@ -38,29 +35,32 @@ std::string ResizeKernel::GetKernelBody(TContext* context) const {
     auto src_dtype = context->getAttrOprand("operand:0").dtype;
     auto imode = context->getAttrStr("imode");
     auto fmt = context->getAttrStr("format");
-    auto specifier = Utils::cvt_dtype_specifier(src_dtype);
+    //! nearest only moves the values, so it works on the storage type
+    auto specifier = imode == "NEAREST" ? Utils::get_common_dtype_specifier(
+                                                  Utils::get_dtype_size(src_dtype))
+                                        : Utils::cvt_dtype_specifier(src_dtype);
+    if (specifier == "gi_float16_t") {
+        ss << gen_fp16_define();
+    }
     ss << R"(
         #include <math.h>
         #include <stdalign.h>
+        #include <string.h>
+        #define rep(i, n) for (int i = 0; i < (n); ++i)
+        #define MIN(x, y) ((x) < (y) ? (x) : (y))
     )";
     std::string coord_str = "";
     if (imode == "LINEAR") {
         coord_str = ResizeHelper::GenCoordHelper(imode, specifier);
+    } else {
+        coord_str = ResizeHelper::GenDupRow(specifier);
     }
     auto gen_layout_dims = ResizeHelper::GenLayoutDims(fmt);
     auto get_offset = ResizeHelper::GenGetOffset(fmt);
-    ss << StringTemplate::StringTemplateArgs()
-                    .add("coord_helper_str", coord_str)
-                    .add("get_offset", get_offset)
-                    .render(R"(
-        static inline float output_converter(float x){
-            return x;
-        }
-        ${coord_helper_str}
-        ${get_offset}
-        #define rep(i, n) for (int i = 0; i < (n); ++i)
-        #define MIN(x, y) ((x) < (y) ? (x) : (y))
-    )");
+    if (imode == "LINEAR") {
+        ss << ResizeHelper::GenOutputConverter(src_dtype);
+    }
+    ss << coord_str << get_offset;
     ss << GenCommonRet() << " " << GetKernelSignature(context);
     std::string body_temp = R"({
         const Tensor* src_tensor = inputs[0];
@@ -85,7 +85,7 @@ std::string ResizeKernel::GetKernelBody(TContext* context) const {
         normal_impl = ResizeHelper::GenNormImpl(fmt);
     } else {
         CC_ASSERT(imode == "NEAREST");
-        normal_impl = ResizeHelper::GenNearestImpl();
+        normal_impl = ResizeHelper::GenNearestImpl(fmt, specifier);
     }
     ss << StringTemplate::StringTemplateArgs()
                     .add("specifier", specifier)
@@ -0,0 +1,64 @@
+#include <sstream>
+
+#include "Common/SepFilter.h"
+#include "SepFilter.h"
+#include "Utils/StringTemplate.h"
+#include "Utils/SymbolHelper.h"
+#include "Utils/Utils.h"
+
+using namespace megcc;
+using namespace KernelGen;
+using namespace BareMetal;
+
+bool SepFilterKernel::IsCVAvailable(TContext* context) const {
+    auto src_dtype = context->getAttrOprand("operand:0").dtype;
+    bool dtype_ok = src_dtype == "ui8" || src_dtype == "f32";
+    std::string mode = context->getAttrStr("border_mode");
+    return dtype_ok && SepFilterHelper::is_border_mode_ok(mode);
+}
+
+//! kernel gen
+std::string SepFilterKernel::GetCVKernelSubSymbol(TContext* context) const {
+    std::stringstream ss;
+    auto src_dtype = context->getAttrOprand("operand:0").dtype;
+    ss << "tinycv_sep_filter_" << SepFilterHelper::get_lower_border_mode(context)
+       << "_" << src_dtype;
+    return ss.str();
+}
+
+std::string SepFilterKernel::GetCVKernelSignature(TContext* context) const {
+    return GetCVKernelSymbol(context) +
+           "(const TinyMat* src, const TinyMat* dst, const TinyMat* kx, const "
+           "TinyMat* ky)";
+}
+
+std::string SepFilterKernel::GetCVKernelBody(TContext* context) const {
+    auto kernel_sig = GetCVKernelSignature(context);
+    std::string bmode = context->getAttrStr("border_mode");
+    auto src_specifier =
+            Utils::cvt_dtype_specifier(context->getAttrOprand("operand:0").dtype);
+    //! the kernels may be negative or unnormalized, so uint8 is filtered in float
+    auto filter_dtype = SepFilterHelper::get_filter_dtype(src_specifier, false);
+    std::stringstream writer;
+    writer << R"(
+        #include <math.h>
+        #include <stdlib.h>
+        #include <string.h>
+        #include "tinycv_c.h"
+        #include "utils.h"
+    )";
+    writer << SepFilterHelper::gen_border_interpolate(bmode);
+    writer << SepFilterHelper::gen_filter_engine(bmode, src_specifier, filter_dtype);
+    writer << SepFilterHelper::gen_cast_op(src_specifier, filter_dtype);
+    writer << SepFilterHelper::gen_naive_filters(src_specifier, filter_dtype, false);
+    writer << "void " << kernel_sig << "{";
+    writer << SepFilterHelper::gen_engine_setup(
+            "(TinyMat*)kx", "(TinyMat*)ky", "rowFilter", "columnFilter");
+    writer << SepFilterHelper::gen_engine_proceed_cv(src_specifier);
+    writer << R"(
+        }
+    )";
+    return writer.str();
+}
+
+// vim: syntax=cpp.doxygen
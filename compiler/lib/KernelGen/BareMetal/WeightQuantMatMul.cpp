@@ -0,0 +1,90 @@
+#include <sstream>
+
+#include "Common/WeightQuantMatMul.h"
+#include "Utils/StringTemplate.h"
+#include "WeightQuantMatMul.h"
+
+using namespace megcc;
+using namespace KernelGen;
+using namespace BareMetal;
+
+bool WeightQuantMatMulKernel::IsAvailable(TContext* context) const {
+    return WeightQuantMatMulHelper::is_available(context);
+}
+
+//! kernel gen
+std::string WeightQuantMatMulKernel::GetKernelSymbol(TContext* context) const {
+    std::stringstream ss;
+    ss << "kernel_weight_quant_matmul_nt_";
+    ss << (WeightQuantMatMulHelper::is_int4(context) ? "int4" : "int8");
+    return ss.str();
+}
+
+namespace {
+std::string emit_weight_val(bool int4) {
+    if (int4) {
+        return R"(
+                    int8_t packed = b_row[k_idx / 32 * 16 + k_idx % 16];
+                    int low = (int8_t)((uint8_t)packed << 4) >> 4;
+                    int b_val = k_idx % 32 < 16 ? low : packed >> 4;)";
+    } else {
+        return "int b_val = b_row[k_idx];";
+    }
+}
+}  // namespace
+
+std::string WeightQuantMatMulKernel::GetKernelBody(TContext* context) const {
+    std::stringstream ss;
+    ss << "#include <stdint.h>\n";
+    ss << GenCommonRet() << " " << GetKernelSignature(context);
+    std::string body_temp = R"({
+    float* a_data = (float*)inputs[0]->ptr;
+    int8_t* b_data = (int8_t*)inputs[1]->ptr;
+    float* c_data = (float*)outputs[0]->ptr;
+    TINYNN_ASSERT(a_data);
+    TINYNN_ASSERT(b_data);
+    TINYNN_ASSERT(c_data);
+    const Tensor* b_tensor = inputs[1];
+    const Layout a_layout = inputs[0]->layout;
+    const Layout b_layout = b_tensor->layout;
+    const Layout c_layout = outputs[0]->layout;
+    const int lda = a_layout.stride[0];
+    const int ldb = b_layout.stride[0];
+    const int ldc = c_layout.stride[0];
+    const int m = c_layout.dims[0];
+    const int n = c_layout.dims[1];
+    const int k = a_layout.dims[1];
+    const float* scales = b_tensor->dtype.param.scales;
+    const int nr_scale = b_tensor->dtype.param.nr_scale;
+    TINYNN_ASSERT(scales && nr_scale % n == 0);
+    const int nr_group = nr_scale / n;
+    const int group = ${group};
+    for (int m_idx = 0; m_idx < m; ++m_idx) {
+        for (int n_idx = 0; n_idx < n; ++n_idx) {
+            const int8_t* b_row = b_data + n_idx * ldb;
+            float sum = 0.f;
+            for (int g = 0; g < nr_group; ++g) {
+                float group_sum = 0.f;
+                const int k_end = (g + 1) * group < k ? (g + 1) * group : k;
+                for (int k_idx = g * group; k_idx < k_end; ++k_idx) {
+                    float a_val = a_data[m_idx * lda + k_idx];
+                    ${b_init}
+                    group_sum += a_val * b_val;
+                }
+                sum += group_sum * scales[n_idx * nr_group + g];
+            }
+            c_data[m_idx * ldc + n_idx] = sum;
+        }
+    }
+    return TinyNN_SUCCESS;
+})";
+
+    bool int4 = WeightQuantMatMulHelper::is_int4(context);
+    ss << StringTemplate::StringTemplateArgs()
+                    .add("b_init", emit_weight_val(int4))
+                    .add("group", WeightQuantMatMulHelper::gen_group(int4))
+                    .render(body_temp);
+    return ss.str();
+}
+
+// vim: syntax=cpp.doxygen
@@ -0,0 +1,202 @@
+#pragma once
+#include <sstream>
+#include <string>
+#include "Utils/StringTemplate.h"
+#include "Utils/SymbolHelper.h"
+#include "Utils/Utils.h"
+#include "compiler/Common/Logger.h"
+#include "compiler/KernelGen/KernelGen.h"
+namespace megcc {
+namespace KernelGen {
+
+//! Argmax and Argmin view the input as (A, B, C) where B is the reduced axis,
+//! the output is the int32 index of the first best value along B
+class ArgmxxHelper {
+public:
+    static bool is_available(TContext* ctx, bool support_f16) {
+        auto src_dtype = ctx->getAttrOprand("operand:0").dtype;
+        auto dst_dtype = Utils::get_last_operand(ctx).dtype;
+        bool ok_src = src_dtype == "f32" || src_dtype == "i8" || src_dtype == "si8" ||
+                      Utils::is_quant_dtype(src_dtype, 8) ||
+                      (support_f16 && src_dtype == "f16");
+        return ok_src && (dst_dtype == "i32" || dst_dtype == "si32");
+    }
+
+    static std::string gen_symbol(
+            const std::string& prefix, const std::string& mode, TContext* ctx) {
+        std::stringstream ss;
+        ss << prefix << (mode == "MAX" ? "Argmax" : "Argmin") << "_"
+           << SymbolHelper::gen_valid_dtype(ctx->getAttrOprand("operand:0").dtype)
+           << "_a" << ctx->getAttrInt("axis");
+        return ss.str();
+    }
+
+    //! the scalar condition that replaces best_val by curr_val
+    static std::string gen_comp(const std::string& mode) {
+        if (mode == "MAX") {
+            return "curr_val > best_val";
+        } else if (mode == "MIN") {
+            return "curr_val < best_val";
+        }
+        CC_ABORT << "unknown argmxx mode " << mode.c_str() << "\n";
+        return "";
+    }
+
+    //! the shared (A, B, C) decomposition, src_a and dst_a point to the
+    //! current outer slice
+    static std::string gen_layout(TContext* ctx, const std::string& specifier) {
+        return StringTemplate::StringTemplateArgs()
+                .add("axis", ctx->getAttrInt("axis"))
+                .add("specifier", specifier)
+                .render(R"(
+    const int axis = ${axis};
+    const ${specifier}* src = (const ${specifier}*)inputs[0]->ptr;
+    int32_t* dst = (int32_t*)outputs[0]->ptr;
+    Layout in_layout = inputs[0]->layout;
+    int A = 1, B = in_layout.dims[axis], C = 1;
+    for (int i = 0; i < axis; ++i)
+        A *= in_layout.dims[i];
+    for (int i = axis + 1; i < in_layout.nr_dim; ++i)
+        C *= in_layout.dims[i];
+)");
+    }
+
+    static std::string gen_naive_body(
+            TContext* ctx, const std::string& mode, const std::string& specifier) {
+        return gen_layout(ctx, specifier) +
+               StringTemplate::StringTemplateArgs()
+                       .add("specifier", specifier)
+                       .add("comp", gen_comp(mode))
+                       .render(R"(
+    for (int a = 0; a < A; ++a) {
+        const ${specifier}* src_a = src + (size_t)a * B * C;
+        int32_t* dst_a = dst + (size_t)a * C;
+        for (int c = 0; c < C; ++c) {
+            float best_val = (float)src_a[c];
+            int32_t best_arg = 0;
+            for (int b = 1; b < B; ++b) {
+                float curr_val = (float)src_a[(size_t)b * C + c];
+                if (${comp}) {
+                    best_val = curr_val;
+                    best_arg = b;
+                }
+            }
+            dst_a[c] = best_arg;
+        }
+    }
+    return TinyNN_SUCCESS;
+)");
+    }
+
+    /*!
+     * the simd body works on float lanes, every load of ARGMXX_STEP elements
+     * is widened to ARGMXX_NR_VEC float vectors of 4 lanes, the prelude of the
+     * arch must define argmxx_val_t, argmxx_idx_t and
+     *  argmxx_load(ptr, val): load ARGMXX_STEP elements
+     *  argmxx_load4(ptr): load 4 elements into one vector
+     *  argmxx_iota(base): the index vector {base, base + 1, base + 2, base + 3}
+     *  argmxx_dup(base): the index vector with all lanes equal to base
+     *  argmxx_update(best, arg, val, idx): take val and idx where val is better
+     *  argmxx_store_arg(ptr, arg) and argmxx_store_lane(val_ptr, arg_ptr, best, arg)
+     *
+     * If C == 1 the lanes run along B and keep the first best of every lane,
+     * the lanes are merged at the end by value and then by the smaller index.
+     * Otherwise the lanes run along C, which also covers the 4 channel block
+     * of NCHW44 as it is the innermost dim, and B is walked with a stride.
+     */
+    static std::string gen_simd_body(
+            TContext* ctx, const std::string& mode, const std::string& specifier) {
+        std::string body = R"(
+    for (int a = 0; a < A; ++a) {
+        const ${specifier}* src_a = src + (size_t)a * B * C;
+        int32_t* dst_a = dst + (size_t)a * C;
+        if (C == 1) {
+            float best_val = (float)src_a[0];
+            int32_t best_arg = 0;
+            int b = 1;
+            if (B >= ARGMXX_STEP) {
+                argmxx_val_t best[ARGMXX_NR_VEC], val[ARGMXX_NR_VEC];
+                argmxx_idx_t arg[ARGMXX_NR_VEC];
+                argmxx_load(src_a, best);
+                for (int k = 0; k < ARGMXX_NR_VEC; ++k)
+                    arg[k] = argmxx_iota(k * 4);
+                for (b = ARGMXX_STEP; b + ARGMXX_STEP <= B; b += ARGMXX_STEP) {
+                    argmxx_load(src_a + b, val);
+                    for (int k = 0; k < ARGMXX_NR_VEC; ++k)
+                        argmxx_update(&best[k], &arg[k], val[k], argmxx_iota(b + k * 4));
+                }
+                float lane_val[ARGMXX_NR_VEC * 4];
+                int32_t lane_arg[ARGMXX_NR_VEC * 4];
+                for (int k = 0; k < ARGMXX_NR_VEC; ++k)
+                    argmxx_store_lane(lane_val + k * 4, lane_arg + k * 4, best[k], arg[k]);
+                best_val = lane_val[0];
+                best_arg = lane_arg[0];
+                for (int i = 1; i < ARGMXX_NR_VEC * 4; ++i) {
+                    float curr_val = lane_val[i];
+                    if (${comp} || (curr_val == best_val && lane_arg[i] < best_arg)) {
+                        best_val = curr_val;
+                        best_arg = lane_arg[i];
+                    }
+                }
+            }
+            for (; b < B; ++b) {
+                float curr_val = (float)src_a[b];
+                if (${comp}) {
+                    best_val = curr_val;
+                    best_arg = b;
+                }
+            }
+            dst_a[0] = best_arg;
+            continue;
+        }
+        int c = 0;
+        for (; c + ARGMXX_STEP <= C; c += ARGMXX_STEP) {
+            argmxx_val_t best[ARGMXX_NR_VEC], val[ARGMXX_NR_VEC];
+            argmxx_idx_t arg[ARGMXX_NR_VEC];
+            argmxx_load(src_a + c, best);
+            for (int k = 0; k < ARGMXX_NR_VEC; ++k)
+                arg[k] = argmxx_dup(0);
+            for (int b = 1; b < B; ++b) {
+                argmxx_idx_t idx = argmxx_dup(b);
+                argmxx_load(src_a + (size_t)b * C + c, val);
+                for (int k = 0; k < ARGMXX_NR_VEC; ++k)
+                    argmxx_update(&best[k], &arg[k], val[k], idx);
+            }
+            for (int k = 0; k < ARGMXX_NR_VEC; ++k)
+                argmxx_store_arg(dst_a + c + k * 4, arg[k]);
+        }
+        for (; c + 4 <= C; c += 4) {
+            argmxx_val_t best = argmxx_load4(src_a + c);
+            argmxx_idx_t arg = argmxx_dup(0);
+            for (int b = 1; b < B; ++b) {
+                argmxx_update(&best, &arg, argmxx_load4(src_a + (size_t)b * C + c),
+                              argmxx_dup(b));
+            }
+            argmxx_store_arg(dst_a + c, arg);
+        }
+        for (; c < C; ++c) {
+            float best_val = (float)src_a[c];
+            int32_t best_arg = 0;
+            for (int b = 1; b < B; ++b) {
+                float curr_val = (float)src_a[(size_t)b * C + c];
+                if (${comp}) {
+                    best_val = curr_val;
+                    best_arg = b;
+                }
+            }
+            dst_a[c] = best_arg;
+        }
+    }
+    return TinyNN_SUCCESS;
+)";
+        return gen_layout(ctx, specifier) + StringTemplate::StringTemplateArgs()
+                                                    .add("specifier", specifier)
+                                                    .add("comp", gen_comp(mode))
+                                                    .render(body);
+    }
+};
+
+}  // namespace KernelGen
+}  // namespace megcc
+
+// vim: syntax=cpp.doxygen
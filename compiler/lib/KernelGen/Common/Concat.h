@@ -0,0 +1,84 @@
+#pragma once
+#include <string>
+#include "Utils/StringTemplate.h"
+#include "compiler/KernelGen/KernelGen.h"
+namespace megcc {
+namespace KernelGen {
+
+class ConcatHelper {
+public:
+    //! gen the concat body. When all tensors are contiguous every input is
+    //! nr_outer blocks of dims[axis] * inner elements and each block is a
+    //! contiguous range of the matching output block, so the whole concat is
+    //! nr_input * nr_outer bulk moves done by the arch specific
+    //! `${copy_row_func}(dst, src, nr_bytes)`. Non-contiguous tensors fall back
+    //! to the element iterator
+    static std::string GenBody(
+            int axis, const std::string& specifier, const std::string& copy_row_func) {
+        std::string body = R"(
+    Tensor* output = outputs[0];
+    const Layout dst_layout = output->layout;
+    const int axis = ${axis};
+    const size_t dtype_len = sizeof(${specifier});
+    bool all_contiguous = is_contiguous(dst_layout);
+    for (int i = 0; i < nr_input; ++i) {
+        all_contiguous = all_contiguous && is_contiguous(inputs[i]->layout);
+    }
+    if (all_contiguous) {
+        size_t nr_outer = 1, inner = 1;
+        for (int i = 0; i < axis; ++i) {
+            nr_outer *= dst_layout.dims[i];
+        }
+        for (int i = axis + 1; i < dst_layout.nr_dim; ++i) {
+            inner *= dst_layout.dims[i];
+        }
+        const size_t dst_block = dst_layout.dims[axis] * inner * dtype_len;
+        uint8_t* dst_base = (uint8_t*)output->ptr;
+        for (int i = 0; i < nr_input; ++i) {
+            const uint8_t* src = (const uint8_t*)inputs[i]->ptr;
+            const size_t src_block = inputs[i]->layout.dims[axis] * inner * dtype_len;
+            uint8_t* dst = dst_base;
+            for (size_t outer = 0; outer < nr_outer; ++outer) {
+                ${copy_row_func}(dst, src, src_block);
+                dst += dst_block;
+                src += src_block;
+            }
+            dst_base += src_block;
+        }
+        return TinyNN_SUCCESS;
+    }
+
+    int32_t axis_index = 0;
+    for (int i = 0; i < nr_input; i++) {
+        Tensor slice = *output;
+        slice.layout.dims[axis] = inputs[i]->layout.dims[axis];
+        slice.ptr += axis_index * output->layout.stride[axis] * dtype_len;
+        axis_index += inputs[i]->layout.dims[axis];
+        size_t nr_elem = 1;
+        for (int j = 0; j < inputs[i]->layout.nr_dim; ++j) {
+            nr_elem *= inputs[i]->layout.dims[j];
+        }
+        NoconIter src_iter = init_iter(inputs[i]->layout);
+        NoconIter dst_iter = init_iter(slice.layout);
+        ${specifier}* dst_data = slice.ptr;
+        const ${specifier}* src_data = inputs[i]->ptr;
+        for (size_t j = 0; j < nr_elem; ++j) {
+            dst_data[dst_iter.offset] = src_data[src_iter.offset];
+            inc_iter(inputs[i]->layout, &src_iter);
+            inc_iter(slice.layout, &dst_iter);
+        }
+    }
+    return TinyNN_SUCCESS;
+)";
+        return StringTemplate::StringTemplateArgs()
+                .add("axis", axis)
+                .add("specifier", specifier)
+                .add("copy_row_func", copy_row_func)
+                .render(body);
+    }
+};
+
+}  // namespace KernelGen
+}  // namespace megcc
+
+// vim: syntax=cpp.doxygen
@@ -0,0 +1,463 @@
+#pragma once
+#include <memory>
+#include <sstream>
+#include <string>
+#include "Common/ConvKernel.h"
+#include "Utils/StringTemplate.h"
+#include "Utils/SymbolHelper.h"
+#include "compiler/KernelGen/KernelGen.h"
+namespace megcc {
+namespace KernelGen {
+
+/*!
+ * the float NCHW ConvBackData as a gemm and a col2im, the gemm computes the
+ * col buffer (out_c * kh * kw, in_h * in_w) = weight^T * diff with the weight
+ * packed in init, which is then gathered into the output.
+ *
+ * The col2im splits the output into the stride_h * stride_w sub pixel phases.
+ * Every phase is a small dense correlation of the col buffer, the taps of a
+ * phase are contiguous both in the col buffer and in the sub grid of the
+ * output row, so the taps are summed with vectors and the output is written
+ * once without a memset or a scatter. The prelude of the arch must define
+ * deconv_vec_t, DECONV_LOAD(ptr), DECONV_STORE(ptr, v), DECONV_ADD(a, b),
+ * DECONV_ZERO() and DECONV_STORE_ZIP(ptr, a, b) which stores a and b
+ * interleaved.
+ */
+class ConvBackDataGemmHelper {
+public:
+    static bool is_available(TContext* ctx) {
+        bool param_value_ok = ctx->getAttrUInt("dilate_h") == 1 &&
+                              ctx->getAttrUInt("dilate_w") == 1;
+        bool param_mode_ok = (ctx->getAttrStr("sparse") == "DENSE" ||
+                              ctx->getAttrStr("sparse") == "GROUP") &&
+                             ctx->getAttrStr("format") == "NCHW" &&
+                             ctx->getAttrStr("mode") == "CROSS_CORRELATION";
+        bool noline_ok = !ctx->haveAttr("nonlineMode");
+        bool type_ok = ctx->getAttrInt("nr_operands") >= 3 &&
+                       ctx->getAttrOprand("operand:0").dtype == "f32" &&
+                       ctx->getAttrOprand("operand:1").dtype == "f32" &&
+                       ctx->getAttrOprand("operand:2").dtype == "f32";
+        return param_value_ok && param_mode_ok && type_ok && noline_ok &&
+               !ConvImpl::is_bias(ctx);
+    }
+
+    static std::string gen_symbol(TContext* ctx, const std::string& prefix) {
+        std::string name_temp =
+                "${prefix}kernel_back_data_conv2d_${format}_${kernel_h}x${kernel_w}_${"
+                "sparse}_p${pad_h}x${pad_w}_s${stride_h}x${stride_w}_d${"
+                "dilate_h}x${dilate_w}_${io}";
+        return StringTemplate::StringTemplateArgs(ctx)
+                .add("prefix", prefix)
+                .add("io", SymbolHelper::gen_io_str(ctx))
+                .add_ctx_int("kernel_h")
+                .add_ctx_int("kernel_w")
+                .add_ctx_str("format")
+                .add_ctx_str("sparse")
+                .add_ctx_int("pad_h")
+                .add_ctx_int("pad_w")
+                .add_ctx_int("stride_h")
+                .add_ctx_int("stride_w")
+                .add_ctx_int("dilate_h")
+                .add_ctx_int("dilate_w")
+                .render(name_temp);
+    }
+
+    static std::shared_ptr<TContext> gen_inner_gemm_ctx() {
+        auto inner_ctx = std::make_shared<CodeGenContext>();
+        inner_ctx->setAttr("with_bias", false);
+        inner_ctx->setAttr("transposeA", true);
+        inner_ctx->setAttr("transposeB", false);
+        inner_ctx->setAttr("format", "NCHW");
+        inner_ctx->setAttr("dtype", "f32");
+        return inner_ctx;
+    }
+
+    //! the weight (in_c, out_c * kh * kw) of every group is packed as the
+    //! transposed A, in_c is the channel of diff
+    template <typename Gemm>
+    static std::string gen_init_body(
+            TContext* ctx, const Gemm& gemm, const std::string& init_signature) {
+        std::stringstream writer;
+        auto inner_ctx = gen_inner_gemm_ctx();
+        writer << gemm.GetPackASignature(inner_ctx.get()) << ";\n";
+        writer << gemm.GetPackAWorkspaceSignature(inner_ctx.get()) << ";\n";
+        writer << GenCommonRet() << " " << init_signature;
+        uint32_t nr_out_weight = 1;
+        std::string common_def = R"(
+    Tensor* in_weights = inputs[0]; //! The weight is the first input in BackwardConv.
+    const uint32_t nr_dim = in_weights->layout.nr_dim;
+    const uint32_t group = nr_dim == 5 ? in_weights->layout.dims[0] : 1;
+    const uint32_t ic_idx = nr_dim == 5 ? 1 : 0;
+    int ymax = in_weights->layout.dims[ic_idx + 1] * in_weights->layout.dims[ic_idx + 2] * in_weights->layout.dims[ic_idx + 3];
+    int kmax = in_weights->layout.dims[ic_idx + 0];
+    int ldin = ymax;
+                      )";
+        std::string fill_weight_attr =
+                R"(
+    out_weights->layout.nr_dim = 2;
+    out_weights->layout.dims[0] = group;
+    out_weights->layout.dims[1] = )" +
+                gemm.GetPackAWorkspaceSymbol(inner_ctx.get()) +
+                R"((0, ymax, 0, kmax)/sizeof(float);
+    out_weights->layout.stride[0] = out_weights->layout.dims[1];
+    out_weights->layout.stride[1] = 1;
+    out_weights->dtype.type_enum=TinyNN_FLOAT;
+    out_weights->name = in_weights->name;
+                      )";
+        std::string fill_weight_transform =
+                R"(
+    for (int g = 0; g < group; ++g) {
+        float* outptr = (float*)(out_weights->ptr) + g * out_weights->layout.stride[0];
+        float* inptr = (float*)(in_weights->ptr) + g * kmax * ymax;
+    )" + gemm.GetPackASymbol(inner_ctx.get()) +
+                "(outptr, inptr, ldin, 0, ymax, 0, kmax);}";
+        writer << StringTemplate::render_init_body(
+                nr_out_weight, fill_weight_attr, fill_weight_transform, common_def);
+        return writer.str();
+    }
+
+    template <typename Gemm>
+    static std::string gen_workspace_body(
+            TContext* ctx, const Gemm& gemm, const std::string& workspace_signature,
+            bool jit) {
+        std::stringstream ss;
+        auto inner_ctx = gen_inner_gemm_ctx();
+        if (jit) {
+            ss << gemm.GetPackBWorkspaceBody(inner_ctx.get()) << ";\n";
+        } else {
+            ss << "extern " << gemm.GetPackBWorkspaceSignature(inner_ctx.get())
+               << ";\n";
+        }
+        ss << GenCommonRet() << " " << workspace_signature;
+        std::string workspace_temp =
+                R"({
+        TINYNN_ASSERT(workspace);
+        const Layout weight_layout = inputs[0]->layout;
+        const uint32_t group = weight_layout.nr_dim == 5 ? weight_layout.dims[0] : 1;
+        const Layout in_layout = inputs[1]->layout;
+        const uint32_t ic = in_layout.dims[1] / group;
+        const uint32_t ih = in_layout.dims[2];
+        const uint32_t iw = in_layout.dims[3];
+        const uint32_t hw = ih * iw;
+        *workspace = )" +
+                gemm.GetPackBWorkspaceSymbol(inner_ctx.get()) +
+                StringTemplate::StringTemplateArgs(ctx)
+                        .add_ctx_int("kernel_h")
+                        .add_ctx_int("kernel_w")
+                        .add("need_col", need_col_buffer(ctx))
+                        .render(R"((0, hw, 0, ic);
+        const uint32_t kh = ${kernel_h};
+        const uint32_t kw = ${kernel_w};
+        if (${need_col}) {
+            const uint32_t oc = weight_layout.nr_dim == 5 ? weight_layout.dims[2] : weight_layout.dims[1];
+            *workspace = *workspace + oc * kh * kw * hw * sizeof(float);
+        }
+        return TinyNN_SUCCESS;
+    })");
+        ss << workspace_temp;
+        return ss.str();
+    }
+
+    template <typename Gemm>
+    static std::vector<KernelObj> gen_depend(const Gemm& gemm) {
+        auto inner_ctx = gen_inner_gemm_ctx();
+        return {
+                {gemm.GetKernelSymbol(inner_ctx.get()),
+                 gemm.GetKernelBody(inner_ctx.get()),
+                 gemm.GetBodyGuardBegin(inner_ctx.get()),
+                 gemm.GetBodyGuardEnd(inner_ctx.get())}};
+    }
+
+    //! prelude is the arch definition of the deconv vector macros
+    template <typename Gemm>
+    static std::string gen_kernel_body(
+            TContext* ctx, const Gemm& gemm, const std::string& prelude,
+            const std::string& kernel_signature) {
+        std::stringstream writer;
+        auto inner_ctx = gen_inner_gemm_ctx();
+        writer << "#include <string.h>\n";
+        writer << gemm.GetNakedKernelSignature(inner_ctx.get()) << ";\n";
+        writer << gemm.GetPackBSignature(inner_ctx.get()) << ";\n";
+        writer << prelude;
+        writer << gen_col2im(ctx);
+        writer << GenCommonRet() << " " << kernel_signature;
+        writer << StringTemplate::StringTemplateArgs(ctx)
+                          .add_ctx_int("kernel_h")
+                          .add_ctx_int("kernel_w")
+                          .add("need_col", need_col_buffer(ctx))
+                          .add("pack_b", gemm.GetPackBSymbol(inner_ctx.get()))
+                          .add("naked_kern", gemm.GetNakedKernelSymbol(inner_ctx.get()))
+                          .render(R"({
+    float* input_data = inputs[1]->ptr;
+    float* output_data = outputs[0]->ptr;
+
+    Layout weight_layout = inputs[0]->layout;
+    Layout in_layout = inputs[1]->layout;
+    Layout out_layout = outputs[0]->layout;
+
+    const int group = weight_layout.dims[0];
+
+    const int in_n = in_layout.dims[0];
+    const int in_c = in_layout.dims[1] / group;
+    const int in_h = in_layout.dims[2];
+    const int in_w = in_layout.dims[3];
+    const size_t N = in_h * in_w;
+
+    const int out_c = out_layout.dims[1] / group;
+    const int out_h = out_layout.dims[2];
+    const int out_w = out_layout.dims[3];
+
+    const size_t M = out_c * ${kernel_h} * ${kernel_w};
+
+    const int LDB = N;
+    const int LDC = LDB;
+
+    void* workspace_ptr = workspace->ptr;
+    float* out_buffer = NULL;
+    const int need_out_buffer = ${need_col};
+    if (need_out_buffer) {
+        out_buffer = workspace->ptr;
+        workspace_ptr = out_buffer + M * N;
+    }
+    for (int n_idx = 0; n_idx < in_n; ++n_idx) {
+        float* weight_data = inputs[0]->ptr;
+        for (int g = 0; g < group; ++g) {
+            ${pack_b}(workspace_ptr, input_data, LDB, 0, in_h * in_w, 0, in_c);
+            float* out_ptr = need_out_buffer ? out_buffer : output_data;
+            ${naked_kern}(weight_data, workspace_ptr, out_ptr, LDC, M, N, in_c, NULL);
+            if (need_out_buffer) {
+                deconv_col2im(out_buffer, output_data, out_c, out_h, out_w, in_h, in_w);
+            }
+            weight_data += weight_layout.stride[0];
+            input_data += in_c * in_h * in_w;
+            output_data += out_c * out_h * out_w;
+        }
+    }
+    return TinyNN_SUCCESS;
+})");
+        return writer.str();
+    }
+
+    //! the gemm output is the conv output only for the 1x1 s1 p0 conv
+    static int need_col_buffer(TContext* ctx) {
+        return ctx->getAttrInt("kernel_h") != 1 || ctx->getAttrInt("kernel_w") != 1 ||
+               ctx->getAttrInt("stride_h") != 1 || ctx->getAttrInt("stride_w") != 1 ||
+               ctx->getAttrInt("pad_h") != 0 || ctx->getAttrInt("pad_w") != 0;
+    }
+
+    /*!
+     * the col2im of the NCHWxx ConvBackData `deconv_col2im_mk`, the col buffer
+     * of a group is (out_c / pack, kh, kw, in_h * in_w, pack) as computed by a
+     * MK gemm, so the pack lanes are output channels and every tap adds one
+     * vector to an output pixel. The sub pixel phases are walked as in the
+     * float NCHW col2im. The prelude of the arch must define the col element
+     * deconv_acc_t, the output element deconv_dst_t, DECONV_PACK,
+     * DECONV_VEC_LOAD(ptr), DECONV_VEC_STORE(ptr, v), DECONV_VEC_ADD(a, b),
+     * DECONV_VEC_ZERO(), the extra parameter list DECONV_STORE_PARAM with its
+     * arguments DECONV_STORE_ARG, and deconv_store_pixel(dst, acc
+     * DECONV_STORE_PARAM) which writes the pack channels of an output pixel
+     */
+    static std::string gen_mk_col2im(TContext* ctx) {
+        return StringTemplate::StringTemplateArgs(ctx)
+                .add_ctx_int("kernel_h")
+                .add_ctx_int("kernel_w")
+                .add_ctx_int("stride_h")
+                .add_ctx_int("stride_w")
+                .add_ctx_int("pad_h")
+                .add_ctx_int("pad_w")
+                .render(R"(
+#define KH ${kernel_h}
+#define KW ${kernel_w}
+#define SH ${stride_h}
+#define SW ${stride_w}
+#define PH ${pad_h}
+#define PW ${pad_w}
+#define DECONV_CHUNK 32
+static void deconv_col2im_mk(
+        const deconv_acc_t* col, deconv_dst_t* dst, int nr_ocb, int out_h, int out_w,
+        int in_h, int in_w DECONV_STORE_PARAM) {
+    const size_t N = (size_t)in_h * in_w;
+    const int nr_sub = (out_w + SW - 1) / SW;
+    deconv_acc_t acc[SW][DECONV_CHUNK * DECONV_PACK];
+    for (int ocb = 0; ocb < nr_ocb; ++ocb) {
+        const deconv_acc_t* col_c = col + (size_t)ocb * KH * KW * N * DECONV_PACK;
+        for (int oh = 0; oh < out_h; ++oh) {
+            deconv_dst_t* dst_row = dst + ((size_t)ocb * out_h + oh) * out_w * DECONV_PACK;
+            for (int b0 = 0; b0 < nr_sub; b0 += DECONV_CHUNK) {
+                const int nr_b = nr_sub - b0 < DECONV_CHUNK ? nr_sub - b0 : DECONV_CHUNK;
+                for (int px = 0; px < SW; ++px) {
+                    for (int b = 0; b < nr_b; ++b)
+                        DECONV_VEC_STORE(acc[px] + b * DECONV_PACK, DECONV_VEC_ZERO());
+                }
+                for (int fh = 0; fh < KH; ++fh) {
+                    const int th = oh + PH - fh;
+                    if (th < 0 || th % SH != 0 || th / SH >= in_h)
+                        continue;
+                    const int ih = th / SH;
+                    for (int fw = 0; fw < KW; ++fw) {
+                        const int tw = fw - PW;
+                        const int px = ((tw % SW) + SW) % SW;
+                        const int dx = (px - tw) / SW;
+                        int b_begin = -dx > b0 ? -dx : b0;
+                        int b_end = in_w - dx < b0 + nr_b ? in_w - dx : b0 + nr_b;
+                        if (px >= out_w || b_begin >= b_end)
+                            continue;
+                        const deconv_acc_t* src =
+                                col_c + ((size_t)(fh * KW + fw) * N + (size_t)ih * in_w +
+                                         dx) * DECONV_PACK;
+                        for (int b = b_begin; b < b_end; ++b) {
+                            deconv_acc_t* acc_ptr = acc[px] + (b - b0) * DECONV_PACK;
+                            DECONV_VEC_STORE(
+                                    acc_ptr, DECONV_VEC_ADD(DECONV_VEC_LOAD(acc_ptr),
+                                                            DECONV_VEC_LOAD(src + b * DECONV_PACK)));
+                        }
+                    }
+                }
+                for (int px = 0; px < SW; ++px) {
+                    for (int b = 0; b < nr_b; ++b) {
+                        int ow = (b0 + b) * SW + px;
+                        if (ow < out_w)
+                            deconv_store_pixel(dst_row + ow * DECONV_PACK,
+                                               acc[px] + b * DECONV_PACK DECONV_STORE_ARG);
+                    }
+                }
+            }
+        }
+    }
+}
+#undef KH
+#undef KW
+#undef SH
+#undef SW
+#undef PH
+#undef PW
+#undef DECONV_CHUNK
+)");
+    }
+
+private:
+
+    static std::string gen_col2im(TContext* ctx) {
+        int sw = ctx->getAttrInt("stride_w");
+        //! the sub pixel phases of a row are interleaved into the output
+        std::string store;
+        if (sw == 1) {
+            store = R"(
+                memcpy(dst_row + b0, acc[0], sizeof(float) * nr_b);)";
+        } else if (sw == 2) {
+            store = R"(
+                float* dst_ptr = dst_row + b0 * 2;
+                int nr_pair = out_w / 2 - b0 < nr_b ? out_w / 2 - b0 : nr_b;
+                int b = 0;
+                for (; b + 4 <= nr_pair; b += 4) {
+                    DECONV_STORE_ZIP(dst_ptr + b * 2, DECONV_LOAD(acc[0] + b),
+                                     DECONV_LOAD(acc[1] + b));
+                }
+                for (; b < nr_b; ++b) {
+                    dst_ptr[b * 2] = acc[0][b];
+                    if ((b0 + b) * 2 + 1 < out_w)
+                        dst_ptr[b * 2 + 1] = acc[1][b];
+                })";
+        } else {
+            store = R"(
+                for (int px = 0; px < SW; ++px) {
+                    for (int b = 0; b < nr_b; ++b) {
+                        int ow = (b0 + b) * SW + px;
+                        if (ow < out_w)
+                            dst_row[ow] = acc[px][b];
+                    }
+                })";
+        }
+        return StringTemplate::StringTemplateArgs(ctx)
+                .add_ctx_int("kernel_h")
+                .add_ctx_int("kernel_w")
+                .add_ctx_int("stride_h")
+                .add_ctx_int("stride_w")
+                .add_ctx_int("pad_h")
+                .add_ctx_int("pad_w")
+                .add("store", store)
+                .render(R"(
+#define KH ${kernel_h}
+#define KW ${kernel_w}
+#define SH ${stride_h}
+#define SW ${stride_w}
+#define PH ${pad_h}
+#define PW ${pad_w}
+#define DECONV_CHUNK 64
+static inline void deconv_acc_add(float* acc, const float* src, int len) {
+    int i = 0;
+    for (; i + 8 <= len; i += 8) {
+        DECONV_STORE(acc + i, DECONV_ADD(DECONV_LOAD(acc + i), DECONV_LOAD(src + i)));
+        DECONV_STORE(acc + i + 4,
+                     DECONV_ADD(DECONV_LOAD(acc + i + 4), DECONV_LOAD(src + i + 4)));
+    }
+    for (; i + 4 <= len; i += 4) {
+        DECONV_STORE(acc + i, DECONV_ADD(DECONV_LOAD(acc + i), DECONV_LOAD(src + i)));
+    }
+    for (; i < len; ++i) {
+        acc[i] += src[i];
+    }
+}
+
+//! output (oh, b * SW + px) takes the taps with (oh + PH - fh) % SH == 0 and
+//! (px + PW - fw) % SW == 0 from col (fh, fw, ih = (oh + PH - fh) / SH,
+//! iw = b + (px + PW - fw) / SW)
+static void deconv_col2im(
+        const float* col, float* dst, int out_c, int out_h, int out_w, int in_h,
+        int in_w) {
+    const size_t N = (size_t)in_h * in_w;
+    const int nr_sub = (out_w + SW - 1) / SW;
+    float acc[SW][DECONV_CHUNK];
+    for (int oc = 0; oc < out_c; ++oc) {
+        const float* col_c = col + (size_t)oc * KH * KW * N;
+        for (int oh = 0; oh < out_h; ++oh) {
+            float* dst_row = dst + ((size_t)oc * out_h + oh) * out_w;
+            for (int b0 = 0; b0 < nr_sub; b0 += DECONV_CHUNK) {
+                const int nr_b = nr_sub - b0 < DECONV_CHUNK ? nr_sub - b0 : DECONV_CHUNK;
+                for (int px = 0; px < SW; ++px) {
+                    int b = 0;
+                    for (; b + 4 <= nr_b; b += 4)
+                        DECONV_STORE(acc[px] + b, DECONV_ZERO());
+                    for (; b < nr_b; ++b)
+                        acc[px][b] = 0.f;
+                }
+                for (int fh = 0; fh < KH; ++fh) {
+                    const int th = oh + PH - fh;
+                    if (th < 0 || th % SH != 0 || th / SH >= in_h)
+                        continue;
+                    const int ih = th / SH;
+                    for (int fw = 0; fw < KW; ++fw) {
+                        const int tw = fw - PW;
+                        //! the phase of the tap and the shift of its sub grid
+                        const int px = ((tw % SW) + SW) % SW;
+                        const int dx = (px - tw) / SW;
+                        int b_begin = -dx > b0 ? -dx : b0;
+                        int b_end = in_w - dx < b0 + nr_b ? in_w - dx : b0 + nr_b;
+                        if (px >= out_w || b_begin >= b_end)
+                            continue;
+                        const float* src =
+                                col_c + (size_t)(fh * KW + fw) * N + (size_t)ih * in_w;
+                        deconv_acc_add(acc[px] + b_begin - b0, src + b_begin + dx,
+                                       b_end - b_begin);
+                    }
+                }
+                ${store}
+            }
+        }
+    }
+}
+#undef KH
+#undef KW
+#undef SH
+#undef SW
+#undef PH
+#undef PW
+#undef DECONV_CHUNK
+)");
+    }
+};
+
+}  // namespace KernelGen
+}  // namespace megcc
+
+// vim: syntax=cpp.doxygen
@@ -23,10 +23,20 @@ public:
         auto pad_w = ctx->getAttrInt("pad_w");
         return pad_h == 0 && pad_w == 0;
     }
+    //! the filter is quantized with the scales of every output channel
+    static bool is_per_channel_scale(TContext* ctx) {
+        return ctx->getAttrOprand("operand:1").per_channel_scale;
+    }
     std::string GetKernelSymbol(TContext* context) const override;
 
-    static bool is_qint8_conv_dtype(TContext* ctx, bool is_dst_support_si32 = false) {
+    //! the kernels reading the per output channel scales of the filter from the
+    //! runtime dtype param set support_per_channel
+    static bool is_qint8_conv_dtype(
+            TContext* ctx, bool is_dst_support_si32 = false,
+            bool support_per_channel = false) {
         bool type_ok = ctx->getAttrInt("nr_operands") >= 3;
+        type_ok = type_ok && (support_per_channel ||
+                              !ctx->getAttrOprand("operand:1").per_channel_scale);
         auto dst_dtype = Utils::get_last_operand(ctx).dtype;
         type_ok = type_ok &&
                   Utils::is_quant_dtype(ctx->getAttrOprand("operand:0").dtype, 8);
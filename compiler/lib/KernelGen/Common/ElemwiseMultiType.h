@@ -0,0 +1,348 @@
+#pragma once
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include "Utils/StringTemplate.h"
+#include "Utils/Utils.h"
+#include "compiler/KernelGen/KernelGen.h"
+namespace megcc {
+namespace KernelGen {
+
+//! the quantized elemwise, every input is dequantized to fp32 with its scale,
+//! computed in fp32 and requantized to the dst scale with round half away from
+//! zero and saturation
+class ElemwiseMultiTypeHelper {
+public:
+    struct ModeDesc {
+        int arity;
+        //! fp32 expression of the dequantized x, y and z
+        std::string scalar;
+        //! body of the simd function of x, y and z written with the arch
+        //! specific V_* macros, empty when the mode is computed in scalar
+        std::string simd;
+        //! the simd body uses V_EXP or V_SIGMOID
+        bool need_math;
+    };
+
+    static const std::unordered_map<std::string, ModeDesc>& mode_map() {
+        static const std::unordered_map<std::string, ModeDesc> modes = {
+                {"QRELU", {1, "fmaxf(x, 0.f)", "return V_MAX(x, V_DUP(0.f));", false}},
+                {"QABS", {1, "fabsf(x)", "return V_ABS(x);", false}},
+                {"QNEGATE", {1, "-x", "return V_NEG(x);", false}},
+                {"QSIGMOID",
+                 {1, "1.f / (1.f + expf(-x))", "return V_SIGMOID(x);", true}},
+                {"QEXP", {1, "expf(x)", "return V_EXP(x);", true}},
+                {"QTANH",
+                 {1, "tanhf(x)",
+                  R"(x = V_SIGMOID(V_MUL(x, V_DUP(2.f)));
+    return V_SUB(V_MUL(x, V_DUP(2.f)), V_DUP(1.f));)",
+                  true}},
+                {"QFAST_TANH",
+                 {1, "x * (27.f + x * x) / (27.f + 9.f * x * x)",
+                  R"(${vtype} x2 = V_MUL(x, x);
+    return V_DIV(V_MUL(x, V_ADD(x2, V_DUP(27.f))),
+                 V_ADD(V_MUL(x2, V_DUP(9.f)), V_DUP(27.f)));)",
+                  false}},
+                {"QH_SWISH",
+                 {1, "x * fminf(fmaxf(x + 3.f, 0.f), 6.f) / 6.f", hswish_simd(""),
+                  false}},
+                {"QACOS", {1, "acosf(x)", "", false}},
+                {"QASIN", {1, "asinf(x)", "", false}},
+                {"QCEIL", {1, "ceilf(x)", "", false}},
+                {"QCOS", {1, "cosf(x)", "", false}},
+                {"QEXPM1", {1, "expm1f(x)", "", false}},
+                {"QFLOOR", {1, "floorf(x)", "", false}},
+                {"QLOG", {1, "logf(x)", "", false}},
+                {"QLOG1P", {1, "log1pf(x)", "", false}},
+                {"QSIN", {1, "sinf(x)", "", false}},
+                {"QROUND", {1, "roundf(x)", "", false}},
+                {"QERF", {1, "erff(x)", "", false}},
+                {"QERFC", {1, "erfcf(x)", "", false}},
+                {"QADD", {2, "x + y", "return V_ADD(x, y);", false}},
+                {"QSUB", {2, "x - y", "return V_SUB(x, y);", false}},
+                {"QMUL", {2, "x * y", "return V_MUL(x, y);", false}},
+                {"QMIN", {2, "fminf(x, y)", "return V_MIN(x, y);", false}},
+                {"QMAX", {2, "fmaxf(x, y)", "return V_MAX(x, y);", false}},
+                {"QTRUE_DIV", {2, "x / y", "return V_DIV(x, y);", false}},
+                {"QFUSE_ADD_RELU",
+                 {2, "fmaxf(x + y, 0.f)", "return V_MAX(V_ADD(x, y), V_DUP(0.f));",
+                  false}},
+                {"QFUSE_ADD_SIGMOID",
+                 {2, "1.f / (1.f + expf(-(x + y)))", "return V_SIGMOID(V_ADD(x, y));",
+                  true}},
+                {"QFUSE_ADD_TANH",
+                 {2, "tanhf(x + y)",
+                  R"(x = V_SIGMOID(V_MUL(V_ADD(x, y), V_DUP(2.f)));
+    return V_SUB(V_MUL(x, V_DUP(2.f)), V_DUP(1.f));)",
+                  true}},
+                {"QFUSE_ADD_H_SWISH",
+                 {2, "(x + y) * fminf(fmaxf(x + y + 3.f, 0.f), 6.f) / 6.f",
+                  hswish_simd("x = V_ADD(x, y);\n    "), false}},
+                {"QSIGMOID_GRAD",
+                 {2, "x * (1.f - x) * y",
+                  "return V_MUL(V_MUL(x, V_SUB(V_DUP(1.f), x)), y);", false}},
+                {"QTANH_GRAD",
+                 {2, "(1.f - x * x) * y",
+                  "return V_MUL(V_SUB(V_DUP(1.f), V_MUL(x, x)), y);", false}},
+                {"QABS_GRAD", {2, "x > 0.f ? y : -y", "", false}},
+                {"QSWITCH_GT0", {2, "x > 0.f ? y : 0.f", "", false}},
+                {"QH_SWISH_GRAD",
+                 {2, "x < -3.f ? 0.f : (x > 3.f ? y : (2.f * x + 3.f) / 6.f * y)", "",
+                  false}},
+                {"QFLOOR_DIV", {2, "floorf(x / y)", "", false}},
+                {"QMOD", {2, "fmodf(x, y)", "", false}},
+                {"QLT", {2, "x < y ? 1.f : 0.f", "", false}},
+                {"QLEQ", {2, "x <= y ? 1.f : 0.f", "", false}},
+                {"QEQ", {2, "x == y ? 1.f : 0.f", "", false}},
+                {"QPOW", {2, "powf(x, y)", "", false}},
+                {"QATAN2", {2, "atan2f(x, y)", "", false}},
+                {"QLOG_SUM_EXP",
+                 {2, "fmaxf(x, y) + log1pf(expf(-fabsf(x - y)))", "", false}},
+                {"QFUSE_MUL_ADD3",
+                 {3, "x * y + z", "return V_ADD(V_MUL(x, y), z);", false}},
+                {"QCOND_LEQ_MOV", {3, "x <= y ? z : 0.f", "", false}},
+        };
+        return modes;
+    }
+
+    //! every operand is qsi8 and the mode takes nr_operands - 1 inputs
+    static bool is_available(TContext* ctx) {
+        auto& modes = mode_map();
+        auto it = modes.find(ctx->getAttrStr("mode"));
+        int nr_operands = ctx->getAttrInt("nr_operands");
+        if (it == modes.end() || it->second.arity + 1 != nr_operands) {
+            return false;
+        }
+        for (int i = 0; i < nr_operands; ++i) {
+            auto dtype = ctx->getAttrOprand("operand:" + std::to_string(i)).dtype;
+            if (!Utils::is_quant_dtype(dtype, 8)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    static const ModeDesc& get_mode(TContext* ctx) {
+        auto it = mode_map().find(ctx->getAttrStr("mode"));
+        CC_ASSERT(it != mode_map().end())
+                << "not support mode " << ctx->getAttrStr("mode");
+        return it->second;
+    }
+
+    //! gen the `fp32_to_int8` requant and the `scalar_op`, plus the `simd_op`
+    //! when vtype is not empty
+    static std::string GenOpFunc(TContext* ctx, const std::string& vtype) {
+        auto& desc = get_mode(ctx);
+        std::stringstream ss;
+        ss << R"(
+static inline int8_t fp32_to_int8(float src) {
+    src = fminf(fmaxf(src, -128.f), 127.f);
+    return (int8_t)roundf(src);
+}
+)";
+        ss << "static inline float scalar_op(" << gen_params("float", desc.arity)
+           << ") {\n    return " << desc.scalar << ";\n}\n";
+        if (!vtype.empty()) {
+            CC_ASSERT(!desc.simd.empty());
+            ss << "static inline " << vtype << " simd_op("
+               << gen_params(vtype, desc.arity) << ") {\n    "
+               << StringTemplate::StringTemplateArgs()
+                          .add("vtype", vtype)
+                          .render(desc.simd)
+               << "\n}\n";
+        }
+        return ss.str();
+    }
+
+    //! gen the kernel body, the inputs are broadcast to the contiguous dst
+    //! numpy style. The inner dims are merged into one run where every input
+    //! is a vector (period 0), a broadcast scalar (period 1) or a broadcast
+    //! pack whose period divides 16, like the bias of BCAST101xX, and the dst
+    //! is walked run by run. With simd the runs are computed in blocks of 16
+    //! by `simd_op` with the arch specific `dequant_16(ptr, vscale)`,
+    //! `requant_16(ptr, v4)` and V4_GET/V4_SET, the broadcast inputs of a run
+    //! are dequantized once before the blocks
+    static std::string GenBody(
+            TContext* ctx, const std::string& vtype, const std::string& v4type) {
+        auto& desc = get_mode(ctx);
+        const int arity = desc.arity;
+        const bool simd = !vtype.empty();
+        const char* names[3] = {"x", "y", "z"};
+        std::string body = R"(
+    const int nr_src = ${arity};
+    const Tensor* dst_tensor = outputs[0];
+    const Layout dst_layout = dst_tensor->layout;
+    int8_t* dst = (int8_t*)dst_tensor->ptr;
+    const float scale_div = 1.f / dst_tensor->dtype.param.scale;
+    TINYNN_ASSERT(dst && is_contiguous(dst_layout));
+    const int ndim = dst_layout.nr_dim;
+    const int8_t* src[3] = {NULL, NULL, NULL};
+    float scale[3] = {0.f, 0.f, 0.f};
+    int stride[3][MAX_DIM];
+    for (int i = 0; i < nr_src; ++i) {
+        const Layout layout = inputs[i]->layout;
+        src[i] = (const int8_t*)inputs[i]->ptr;
+        scale[i] = inputs[i]->dtype.param.scale;
+        TINYNN_ASSERT(src[i] && layout.nr_dim <= ndim);
+        const int shift = ndim - layout.nr_dim;
+        for (int d = 0; d < ndim; ++d) {
+            const int sd = d - shift;
+            if (sd < 0 || layout.dims[sd] == 1) {
+                stride[i][d] = 0;
+            } else {
+                TINYNN_ASSERT(layout.dims[sd] == dst_layout.dims[d]);
+                stride[i][d] = layout.stride[sd];
+            }
+        }
+    }
+
+    //! -1 means all the dims merged so far have size 1
+    int period[3] = {-1, -1, -1};
+    size_t run = 1;
+    int outer_dim = ndim;
+    for (; outer_dim > 0; --outer_dim) {
+        const int d = outer_dim - 1;
+        const size_t len = dst_layout.dims[d];
+        if (len == 1) {
+            continue;
+        }
+        int next_period[3] = {-1, -1, -1};
+        int ok = 1;
+        for (int i = 0; i < nr_src; ++i) {
+            const int s = stride[i][d];
+            next_period[i] = period[i];
+            if (period[i] < 0) {
+                if (s == 0 || s == 1) {
+                    next_period[i] = 1 - s;
+                } else {
+                    ok = 0;
+                }
+            } else if (period[i] == 0) {
+                if (s == 0 && (run == 4 || run == 8 || run == 16)) {
+                    next_period[i] = run;
+                } else if (s != (int)run) {
+                    ok = 0;
+                }
+            } else if (s != 0) {
+                ok = 0;
+            }
+        }
+        if (!ok) {
+            break;
+        }
+        for (int i = 0; i < nr_src; ++i) {
+            period[i] = next_period[i];
+        }
+        run *= len;
+    }
+    for (int i = 0; i < nr_src; ++i) {
+        period[i] = period[i] < 0 ? 0 : period[i];
+    }
+
+    size_t nr_outer = 1;
+    for (int d = 0; d < outer_dim; ++d) {
+        nr_outer *= dst_layout.dims[d];
+    }
+    int idx[MAX_DIM] = {0};
+    long offset[3] = {0, 0, 0};
+    ${init_simd}
+    for (size_t outer = 0; outer < nr_outer; ++outer) {
+        ${init_ptr}
+        int8_t* dst_ptr = dst + outer * run;
+        size_t j = 0;
+        ${simd_run}
+        for (; j < run; ++j) {
+            ${scalar_load}
+            dst_ptr[j] = fp32_to_int8(scalar_op(${args}) * scale_div);
+        }
+        for (int d = outer_dim - 1; d >= 0; --d) {
+            for (int i = 0; i < nr_src; ++i) {
+                offset[i] += stride[i][d];
+            }
+            if (++idx[d] < (int)dst_layout.dims[d]) {
+                break;
+            }
+            for (int i = 0; i < nr_src; ++i) {
+                offset[i] -= (long)stride[i][d] * idx[d];
+            }
+            idx[d] = 0;
+        }
+    }
+    return TinyNN_SUCCESS;
+)";
+        std::stringstream init_simd, init_ptr, scalar_load, args, simd_run;
+        std::stringstream simd_load, simd_args;
+        init_simd << "const " << vtype << " vscale_div = V_DUP(scale_div);";
+        for (int i = 0; i < arity; ++i) {
+            std::string n = names[i], si = std::to_string(i);
+            init_ptr << (i ? "\n        " : "") << "const int8_t* ptr_" << n
+                     << " = src[" << si << "] + offset[" << si << "];";
+            scalar_load << (i ? "\n            " : "") << "float " << n << " = scale["
+                        << si << "] * ptr_" << n << "[period[" << si << "] ? j % period["
+                        << si << "] : j];";
+            args << (i ? ", " : "") << n;
+            init_simd << "\n    const " << vtype << " vscale_" << n
+                      << " = V_DUP(scale[" << si << "]);";
+            simd_load << "int8_t pattern_" << n << "[16];\n"
+                      << "            for (int k = 0; k < 16; ++k) {\n"
+                      << "                pattern_" << n << "[k] = period[" << si
+                      << "] ? ptr_" << n << "[k % period[" << si << "]] : 0;\n"
+                      << "            }\n"
+                      << "            const " << v4type << " vb_" << n
+                      << " = dequant_16(pattern_" << n << ", vscale_" << n
+                      << ");\n            ";
+        }
+        for (int k = 0; k < 4; ++k) {
+            simd_args << "\n                V4_SET(vd, " << k
+                      << ", V_MUL(simd_op(";
+            for (int i = 0; i < arity; ++i) {
+                simd_args << (i ? ", " : "") << "V4_GET(v" << names[i] << ", " << k
+                          << ")";
+            }
+            simd_args << "), vscale_div));";
+        }
+        if (simd) {
+            simd_run << "if (run >= 16) {\n            " << simd_load.str();
+            simd_run << "for (; j + 16 <= run; j += 16) {";
+            for (int i = 0; i < arity; ++i) {
+                std::string n = names[i];
+                simd_run << "\n                const " << v4type << " v" << n
+                         << " = period[" << i << "] ? vb_" << n
+                         << " : dequant_16(ptr_" << n << " + j, vscale_" << n
+                         << ");";
+            }
+            simd_run << "\n                " << v4type << " vd;" << simd_args.str()
+                     << "\n                requant_16(dst_ptr + j, vd);\n"
+                     << "            }\n        }";
+        }
+        return StringTemplate::StringTemplateArgs()
+                .add("arity", arity)
+                .add("init_simd", simd ? init_simd.str() : "")
+                .add("init_ptr", init_ptr.str())
+                .add("simd_run", simd_run.str())
+                .add("scalar_load", scalar_load.str())
+                .add("args", args.str())
+                .render(body);
+    }
+
+private:
+    static std::string hswish_simd(const std::string& prologue) {
+        return prologue + R"(${vtype} clip = V_MAX(V_ADD(x, V_DUP(3.f)), V_DUP(0.f));
+    clip = V_MIN(clip, V_DUP(6.f));
+    return V_MUL(V_MUL(x, clip), V_DUP(1.f / 6.f));)";
+    }
+
+    static std::string gen_params(const std::string& type, int arity) {
+        const char* names[3] = {"x", "y", "z"};
+        std::stringstream ss;
+        for (int i = 0; i < arity; ++i) {
+            ss << (i ? ", " : "") << type << " " << names[i];
+        }
+        return ss.str();
+    }
+};
+
+}  // namespace KernelGen
+}  // namespace megcc
+
+// vim: syntax=cpp.doxygen
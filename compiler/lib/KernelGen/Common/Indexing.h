@@ -0,0 +1,236 @@
+#pragma once
+#include <string>
+#include "Utils/StringTemplate.h"
+#include "compiler/KernelGen/KernelGen.h"
+namespace megcc {
+namespace KernelGen {
+
+class IndexingHelper {
+public:
+    //! the storage type used to move elements of given size without touching
+    //! the value, so all dtypes with the same size share one kernel body
+    static std::string GetMoveSpecifier(size_t type_size) {
+        switch (type_size) {
+            case 1:
+                return "uint8_t";
+            case 2:
+                return "uint16_t";
+            case 4:
+                return "uint32_t";
+            default:
+                CC_ABORT << "not support type size " << type_size << "\n";
+        }
+        return "";
+    }
+
+    //! gen the multi axis gather body, the indexed axes must be contiguous, so
+    //! the output is organized as [outer, index_shape, inner] and every index
+    //! position maps to nr_outer rows of inner elements. The index tensors are
+    //! walked only once, the negative index normalization and the offset
+    //! computation are done per index position instead of per output element.
+    //! The row copy is done by the arch specific
+    //! `${copy_row_func}(dst, src, nr_bytes)` when src and dst are contiguous,
+    //! otherwise the elements are copied one by one by the strides
+    static std::string GenMultiAxisVecBody(
+            int first_axis, const std::string& specifier,
+            const std::string& copy_row_func) {
+        std::string body = R"(
+    const Tensor* src_tensor = inputs[0];
+    const Tensor* dst_tensor = outputs[0];
+    const Layout src_layout = src_tensor->layout;
+    const Layout dst_layout = dst_tensor->layout;
+    ${specifier}* src = (${specifier}*)src_tensor->ptr;
+    ${specifier}* dst = (${specifier}*)dst_tensor->ptr;
+    TINYNN_ASSERT(src && dst);
+    const bool contiguous = is_contiguous(src_layout) && is_contiguous(dst_layout);
+
+    const int nr_index = nr_input - 1;
+    const int first_axis = ${first_axis};
+    const int last_axis = first_axis + nr_index - 1;
+    TINYNN_ASSERT(nr_index <= MAX_DIM && last_axis < src_layout.nr_dim);
+
+    // deduce the broadcast shape of all index tensors
+    Layout index_shape;
+    index_shape.nr_dim = 0;
+    for (int i = 0; i < nr_index; ++i) {
+        const Layout cur = inputs[i + 1]->layout;
+        TINYNN_ASSERT_MSG(cur.nr_dim, "bad input shape for polyadic operator");
+        if (!index_shape.nr_dim || is_layout_scalar(&index_shape)) {
+            index_shape = cur;
+        } else if (!is_layout_scalar(&cur)) {
+            int max_dim = index_shape.nr_dim > cur.nr_dim ? index_shape.nr_dim
+                                                           : cur.nr_dim;
+            Layout res;
+            res.nr_dim = max_dim;
+            for (int j = 0; j < max_dim; ++j) {
+                int cur_idx = cur.nr_dim - j - 1;
+                int res_idx = index_shape.nr_dim - j - 1;
+                size_t v0 = res_idx >= 0 ? index_shape.dims[res_idx] : 1;
+                size_t v1 = cur_idx >= 0 ? cur.dims[cur_idx] : 1;
+                TINYNN_ASSERT_MSG(v0 == v1 || v0 <= 1 || v1 <= 1,
+                                  "bad input shape for polyadic operator");
+                res.dims[max_dim - j - 1] =
+                        (v0 != 0 && v1 != 0) ? (v0 > v1 ? v0 : v1) : 0;
+            }
+            index_shape = res;
+        }
+    }
+    force_layout_contiguous(&index_shape);
+
+    // per index tensor: broadcast layout, iterator, axis shape and stride
+    Layout idx_layout[MAX_DIM];
+    NoconIter idx_iter[MAX_DIM];
+    const int* idx_ptr[MAX_DIM];
+    int axis_shape[MAX_DIM];
+    size_t axis_stride[MAX_DIM];
+    for (int i = 0; i < nr_index; ++i) {
+        idx_layout[i] = inputs[i + 1]->layout;
+        broadcast_layout(&idx_layout[i], index_shape);
+        idx_iter[i] = init_iter(idx_layout[i]);
+        idx_ptr[i] = (const int*)inputs[i + 1]->ptr;
+        axis_shape[i] = src_layout.dims[first_axis + i];
+        axis_stride[i] = src_layout.stride[first_axis + i];
+    }
+
+    size_t nr_outer = 1, nr_inner = 1, nr_position = 1;
+    for (int i = 0; i < first_axis; ++i) {
+        nr_outer *= src_layout.dims[i];
+    }
+    for (int i = last_axis + 1; i < src_layout.nr_dim; ++i) {
+        nr_inner *= src_layout.dims[i];
+    }
+    for (int i = 0; i < index_shape.nr_dim; ++i) {
+        nr_position *= index_shape.dims[i];
+    }
+    const int nr_index_dim = index_shape.nr_dim;
+    TINYNN_ASSERT(dst_layout.nr_dim ==
+                  src_layout.nr_dim - nr_index + nr_index_dim);
+    const size_t src_outer_stride =
+            first_axis > 0 ? (size_t)src_layout.stride[first_axis - 1] : 0;
+    const size_t dst_outer_stride = nr_position * nr_inner;
+    const size_t row_bytes = nr_inner * sizeof(${specifier});
+
+    for (size_t pos = 0; pos < nr_position; ++pos) {
+        size_t src_offset = 0;
+        for (int i = 0; i < nr_index; ++i) {
+            int idx = idx_ptr[i][idx_iter[i].offset];
+            idx += idx < 0 ? axis_shape[i] : 0;
+            TINYNN_ASSERT_MSG(idx >= 0 && idx < axis_shape[i],
+                              "invalid advanced indexing");
+            src_offset += idx * axis_stride[i];
+            inc_iter(idx_layout[i], &idx_iter[i]);
+        }
+        if (!contiguous) {
+            size_t dst_offset = 0, rem = pos;
+            for (int i = nr_index_dim - 1; i >= 0; --i) {
+                dst_offset += rem % index_shape.dims[i] *
+                              dst_layout.stride[first_axis + i];
+                rem /= index_shape.dims[i];
+            }
+            for (size_t outer = 0; outer < nr_outer; ++outer) {
+                size_t src_row = src_offset, dst_row = dst_offset;
+                rem = outer;
+                for (int i = first_axis - 1; i >= 0; --i) {
+                    size_t cur = rem % src_layout.dims[i];
+                    rem /= src_layout.dims[i];
+                    src_row += cur * src_layout.stride[i];
+                    dst_row += cur * dst_layout.stride[i];
+                }
+                for (size_t inner = 0; inner < nr_inner; ++inner) {
+                    size_t src_pos = src_row, dst_pos = dst_row;
+                    rem = inner;
+                    for (int i = src_layout.nr_dim - 1; i > last_axis; --i) {
+                        size_t cur = rem % src_layout.dims[i];
+                        rem /= src_layout.dims[i];
+                        src_pos += cur * src_layout.stride[i];
+                        dst_pos += cur * dst_layout.stride[i - nr_index +
+                                                           nr_index_dim];
+                    }
+                    dst[dst_pos] = src[src_pos];
+                }
+            }
+            continue;
+        }
+        const ${specifier}* sptr = src + src_offset;
+        ${specifier}* dptr = dst + pos * nr_inner;
+        if (nr_inner == 1) {
+            for (size_t outer = 0; outer < nr_outer; ++outer) {
+                dptr[outer * dst_outer_stride] = sptr[outer * src_outer_stride];
+            }
+        } else {
+            for (size_t outer = 0; outer < nr_outer; ++outer) {
+                ${copy_row_func}(dptr + outer * dst_outer_stride,
+                                 sptr + outer * src_outer_stride, row_bytes);
+            }
+        }
+    }
+    return TinyNN_SUCCESS;
+)";
+        return StringTemplate::StringTemplateArgs()
+                .add("first_axis", first_axis)
+                .add("specifier", specifier)
+                .add("copy_row_func", copy_row_func)
+                .render(body);
+    }
+
+    //! gen the one hot gather body, dst[b][i] = src[b][idx[b][i]][i]. The
+    //! gather offsets are computed by the arch specific
+    //! `${gather_offset_func}(offset, idx, nr_elem, inner)` in vector registers
+    //! then the elements are moved with scalar loads
+    static std::string GenOneHotBody(
+            int axis, const std::string& specifier,
+            const std::string& gather_offset_func) {
+        std::string body = R"(
+    const Tensor* src_tensor = inputs[0];
+    const Tensor* dst_tensor = outputs[0];
+    const Layout src_layout = src_tensor->layout;
+    const ${specifier}* src = (const ${specifier}*)src_tensor->ptr;
+    const int* idx = (const int*)inputs[1]->ptr;
+    ${specifier}* dst = (${specifier}*)dst_tensor->ptr;
+    TINYNN_ASSERT(src && idx && dst);
+
+    const int axis = ${axis};
+    size_t batch = 1, inner = 1;
+    for (int i = 0; i < axis; ++i) {
+        batch *= src_layout.dims[i];
+    }
+    for (int i = axis + 1; i < src_layout.nr_dim; ++i) {
+        inner *= src_layout.dims[i];
+    }
+    const size_t batch_stride = src_layout.dims[axis] * inner;
+    if (inner == 1) {
+        for (size_t bid = 0; bid < batch; ++bid) {
+            dst[bid] = src[bid * batch_stride + idx[bid]];
+        }
+        return TinyNN_SUCCESS;
+    }
+    int offset[GATHER_BLOCK];
+    for (size_t bid = 0; bid < batch; ++bid) {
+        const ${specifier}* src_ptr = src + bid * batch_stride;
+        size_t id = 0;
+        for (; id + GATHER_BLOCK <= inner; id += GATHER_BLOCK) {
+            ${gather_offset_func}(offset, idx + id, id, inner);
+            for (int k = 0; k < GATHER_BLOCK; ++k) {
+                dst[id + k] = src_ptr[offset[k]];
+            }
+        }
+        for (; id < inner; ++id) {
+            dst[id] = src_ptr[idx[id] * inner + id];
+        }
+        dst += inner;
+        idx += inner;
+    }
+    return TinyNN_SUCCESS;
+)";
+        return StringTemplate::StringTemplateArgs()
+                .add("axis", axis)
+                .add("specifier", specifier)
+                .add("gather_offset_func", gather_offset_func)
+                .render(body);
+    }
+};
+
+}  // namespace KernelGen
+}  // namespace megcc
+
+// vim: syntax=cpp.doxygen
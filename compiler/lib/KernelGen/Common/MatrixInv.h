@@ -0,0 +1,223 @@
+#pragma once
+#include <sstream>
+#include <string>
+#include <tuple>
+#include <vector>
+#include "Utils/StringTemplate.h"
+#include "compiler/Common/Logger.h"
+namespace megcc {
+namespace KernelGen {
+
+/*!
+ * closed form inverse of small matrices, the matrices of a batch are stored
+ * as structure of arrays, m[k] holds the element k of MI_LANE matrices. The
+ * prelude of the arch must define mi_vec_t, MI_LANE and
+ *  MI_LOAD(ptr), MI_STORE(ptr, v): load and store MI_LANE floats
+ *  MI_MUL(a, b), MI_MLA(acc, a, b) = acc + a * b, MI_MLS(acc, a, b) = acc - a * b
+ *  MI_RECIP(a): 1 / a
+ */
+class MatrixInvHelper {
+public:
+    static constexpr int kMaxSmallN = 4;
+
+    //! mi_inv_<n>(src, dst, batch) inverts batch matrices of n x n
+    static std::string gen_small_inverse(int n) {
+        CC_ASSERT(n >= 1 && n <= kMaxSmallN);
+        std::stringstream eye;
+        for (int i = 0; i < n * n; ++i) {
+            eye << (i ? ", " : "") << (i % (n + 1) == 0 ? "1.f" : "0.f");
+        }
+        return StringTemplate::StringTemplateArgs()
+                .add("n", n)
+                .add("nn", n * n)
+                .add("eye", eye.str())
+                .add("cofactor", gen_cofactor(n))
+                .render(R"(
+static const float mi_eye_${n}[${nn}] = {${eye}};
+static void mi_inv_${n}(const float* src, float* dst, int batch) {
+    float buf[${nn} * MI_LANE];
+    mi_vec_t m[${nn}], r[${nn}];
+    for (int b = 0; b < batch; b += MI_LANE) {
+        int nr_lane = batch - b < MI_LANE ? batch - b : MI_LANE;
+        //! pad the tail with identity so that every lane stays finite
+        for (int l = 0; l < MI_LANE; ++l) {
+            const float* s = l < nr_lane ? src + (size_t)(b + l) * ${nn} : mi_eye_${n};
+            for (int k = 0; k < ${nn}; ++k)
+                buf[k * MI_LANE + l] = s[k];
+        }
+        for (int k = 0; k < ${nn}; ++k)
+            m[k] = MI_LOAD(buf + k * MI_LANE);
+        ${cofactor}
+        MI_STORE(buf, det);
+        for (int l = 0; l < nr_lane; ++l)
+            TINYNN_ASSERT(buf[l] != 0.f);
+        for (int k = 0; k < ${nn}; ++k)
+            MI_STORE(buf + k * MI_LANE, r[k]);
+        for (int l = 0; l < nr_lane; ++l) {
+            float* d = dst + (size_t)(b + l) * ${nn};
+            for (int k = 0; k < ${nn}; ++k)
+                d[k] = buf[k * MI_LANE + l];
+        }
+    }
+}
+)");
+    }
+
+    //! all the small inverses and the dispatch used at the head of the kernel
+    static std::string gen_small_inverses() {
+        std::string res;
+        for (int n = 1; n <= kMaxSmallN; ++n) {
+            res += gen_small_inverse(n);
+        }
+        return res;
+    }
+
+    static std::string gen_small_dispatch(
+            const std::string& src, const std::string& dst, const std::string& n,
+            const std::string& batch) {
+        std::stringstream ss;
+        ss << "switch (" << n << ") {\n";
+        for (int i = 1; i <= kMaxSmallN; ++i) {
+            ss << "        case " << i << ":\n"
+               << "            mi_inv_" << i << "(" << src << ", " << dst << ", "
+               << batch << ");\n"
+               << "            return TinyNN_SUCCESS;\n";
+        }
+        ss << "        default:\n            break;\n    }\n";
+        return ss.str();
+    }
+
+private:
+    //! sign, lhs, rhs of a product in a sum
+    using Term = std::tuple<int, std::string, std::string>;
+
+    static std::string gen_sum(std::vector<Term> terms) {
+        //! start from a positive product so that only MLA and MLS are needed
+        for (size_t i = 0; i < terms.size(); ++i) {
+            if (std::get<0>(terms[i]) > 0) {
+                std::swap(terms[0], terms[i]);
+                break;
+            }
+        }
+        CC_ASSERT(std::get<0>(terms[0]) > 0);
+        std::string res = "MI_MUL(" + std::get<1>(terms[0]) + ", " +
+                          std::get<2>(terms[0]) + ")";
+        for (size_t i = 1; i < terms.size(); ++i) {
+            res = std::string(std::get<0>(terms[i]) > 0 ? "MI_MLA(" : "MI_MLS(") +
+                  res + ", " + std::get<1>(terms[i]) + ", " + std::get<2>(terms[i]) +
+                  ")";
+        }
+        return res;
+    }
+
+    static std::string a(int n, int row, int col) {
+        return "m[" + std::to_string(row * n + col) + "]";
+    }
+
+    //! the statements compute det and r[k] = inverse element k from m[k]
+    static std::string gen_cofactor(int n) {
+        std::stringstream ss;
+        auto def = [&ss](const std::string& name, const std::string& expr) {
+            ss << "mi_vec_t " << name << " = " << expr << ";\n";
+        };
+        auto out = [&ss](int idx, const std::string& expr) {
+            ss << "r[" << idx << "] = MI_MUL(" << expr << ", inv_det);\n";
+        };
+        if (n == 1) {
+            def("det", "m[0]");
+            ss << "r[0] = MI_RECIP(det);\n";
+            return ss.str();
+        }
+        if (n == 2) {
+            def("det", gen_sum({Term{1, a(2, 0, 0), a(2, 1, 1)},
+                                Term{-1, a(2, 0, 1), a(2, 1, 0)}}));
+            //! the off diagonal entries are negated by the reciprocal of -det
+            def("neg_det", gen_sum({Term{1, a(2, 0, 1), a(2, 1, 0)},
+                                    Term{-1, a(2, 0, 0), a(2, 1, 1)}}));
+            def("inv_det", "MI_RECIP(det)");
+            def("neg_inv_det", "MI_RECIP(neg_det)");
+            out(0, "m[3]");
+            out(3, "m[0]");
+            ss << "r[1] = MI_MUL(m[1], neg_inv_det);\n";
+            ss << "r[2] = MI_MUL(m[2], neg_inv_det);\n";
+            return ss.str();
+        }
+        if (n == 3) {
+            //! the cofactors c<row><col> of the first row are reused by det
+            auto minor = [&](int r0, int c0, int r1, int c1) {
+                return gen_sum({Term{1, a(3, r0, c0), a(3, r1, c1)},
+                                Term{-1, a(3, r0, c1), a(3, r1, c0)}});
+            };
+            def("c00", minor(1, 1, 2, 2));
+            def("c01", minor(1, 2, 2, 0));
+            def("c02", minor(1, 0, 2, 1));
+            def("det", gen_sum({Term{1, a(3, 0, 0), "c00"}, Term{1, a(3, 0, 1), "c01"},
+                                Term{1, a(3, 0, 2), "c02"}}));
+            def("inv_det", "MI_RECIP(det)");
+            out(0, "c00");
+            out(1, minor(0, 2, 2, 1));
+            out(2, minor(0, 1, 1, 2));
+            out(3, "c01");
+            out(4, minor(0, 0, 2, 2));
+            out(5, minor(0, 2, 1, 0));
+            out(6, "c02");
+            out(7, minor(0, 1, 2, 0));
+            out(8, minor(0, 0, 1, 1));
+            return ss.str();
+        }
+        CC_ASSERT(n == 4);
+        //! the 2 x 2 minors of the upper rows s<i> and of the lower rows c<i>
+        auto minor = [&](int r0, int c0, int c1) {
+            return gen_sum({Term{1, a(4, r0, c0), a(4, r0 + 1, c1)},
+                            Term{-1, a(4, r0 + 1, c0), a(4, r0, c1)}});
+        };
+        const int pairs[6][2] = {{0, 1}, {0, 2}, {0, 3}, {1, 2}, {1, 3}, {2, 3}};
+        for (int i = 0; i < 6; ++i) {
+            def("s" + std::to_string(i), minor(0, pairs[i][0], pairs[i][1]));
+            def("c" + std::to_string(i), minor(2, pairs[i][0], pairs[i][1]));
+        }
+        def("det", gen_sum({Term{1, "s0", "c5"}, Term{-1, "s1", "c4"},
+                            Term{1, "s2", "c3"}, Term{1, "s3", "c2"},
+                            Term{-1, "s4", "c1"}, Term{1, "s5", "c0"}}));
+        def("inv_det", "MI_RECIP(det)");
+        //! the adjugate, entry (i, j) is the cofactor of (j, i)
+        out(0, gen_sum({Term{1, a(4, 1, 1), "c5"}, Term{-1, a(4, 1, 2), "c4"},
+                        Term{1, a(4, 1, 3), "c3"}}));
+        out(1, gen_sum({Term{-1, a(4, 0, 1), "c5"}, Term{1, a(4, 0, 2), "c4"},
+                        Term{-1, a(4, 0, 3), "c3"}}));
+        out(2, gen_sum({Term{1, a(4, 3, 1), "s5"}, Term{-1, a(4, 3, 2), "s4"},
+                        Term{1, a(4, 3, 3), "s3"}}));
+        out(3, gen_sum({Term{-1, a(4, 2, 1), "s5"}, Term{1, a(4, 2, 2), "s4"},
+                        Term{-1, a(4, 2, 3), "s3"}}));
+        out(4, gen_sum({Term{-1, a(4, 1, 0), "c5"}, Term{1, a(4, 1, 2), "c2"},
+                        Term{-1, a(4, 1, 3), "c1"}}));
+        out(5, gen_sum({Term{1, a(4, 0, 0), "c5"}, Term{-1, a(4, 0, 2), "c2"},
+                        Term{1, a(4, 0, 3), "c1"}}));
+        out(6, gen_sum({Term{-1, a(4, 3, 0), "s5"}, Term{1, a(4, 3, 2), "s2"},
+                        Term{-1, a(4, 3, 3), "s1"}}));
+        out(7, gen_sum({Term{1, a(4, 2, 0), "s5"}, Term{-1, a(4, 2, 2), "s2"},
+                        Term{1, a(4, 2, 3), "s1"}}));
+        out(8, gen_sum({Term{1, a(4, 1, 0), "c4"}, Term{-1, a(4, 1, 1), "c2"},
+                        Term{1, a(4, 1, 3), "c0"}}));
+        out(9, gen_sum({Term{-1, a(4, 0, 0), "c4"}, Term{1, a(4, 0, 1), "c2"},
+                        Term{-1, a(4, 0, 3), "c0"}}));
+        out(10, gen_sum({Term{1, a(4, 3, 0), "s4"}, Term{-1, a(4, 3, 1), "s2"},
+                         Term{1, a(4, 3, 3), "s0"}}));
+        out(11, gen_sum({Term{-1, a(4, 2, 0), "s4"}, Term{1, a(4, 2, 1), "s2"},
+                         Term{-1, a(4, 2, 3), "s0"}}));
+        out(12, gen_sum({Term{-1, a(4, 1, 0), "c3"}, Term{1, a(4, 1, 1), "c1"},
+                         Term{-1, a(4, 1, 2), "c0"}}));
+        out(13, gen_sum({Term{1, a(4, 0, 0), "c3"}, Term{-1, a(4, 0, 1), "c1"},
+                         Term{1, a(4, 0, 2), "c0"}}));
+        out(14, gen_sum({Term{-1, a(4, 3, 0), "s3"}, Term{1, a(4, 3, 1), "s1"},
+                         Term{-1, a(4, 3, 2), "s0"}}));
+        out(15, gen_sum({Term{1, a(4, 2, 0), "s3"}, Term{-1, a(4, 2, 1), "s1"},
+                         Term{1, a(4, 2, 2), "s0"}}));
+        return ss.str();
+    }
+};
+
+}  // namespace KernelGen
+}  // namespace megcc
+
+// vim: syntax=cpp.doxygen
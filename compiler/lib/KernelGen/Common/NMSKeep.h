@@ -0,0 +1,95 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include "Utils/StringTemplate.h"
+#include "Utils/Utils.h"
+#include "compiler/KernelGen/KernelGen.h"
+namespace megcc {
+namespace KernelGen {
+
+class NMSKeepHelper {
+public:
+    //! the boxes of one batch are split into x0, y0, x1, y1 and area planes
+    //! followed by the removed flags, every plane is padded to 4 floats
+    static std::string GenWorkspaceBody(const std::string& signature) {
+        std::string body = R"(
+        ${signature} {
+            TINYNN_ASSERT(workspace);
+            const Layout in_layout = inputs[0]->layout;
+            const size_t nr_boxes = in_layout.dims[1];
+            const size_t plane = (nr_boxes + 3) / 4 * 4;
+            *workspace = plane * 6 * sizeof(float);
+            return TinyNN_SUCCESS;
+        })";
+        return StringTemplate::StringTemplateArgs()
+                .add("signature", signature)
+                .render(body);
+    }
+
+    //! gen the body of NMSKeep. Boxes of shape (batch, nr_boxes, 4) are
+    //! (x0, y0, x1, y1) sorted by score in descending order. Boxes are kept
+    //! greedily, every kept box removes the later boxes whose IoU with it
+    //! is over the threshold by the arch specific
+    //! `${suppress_func}(x0, y0, x1, y1, area, removed, i, nr_boxes, thresh)`.
+    //! out_idx is padded with the last kept index as megbrain does
+    static std::string GenBody(float iou_thresh, uint32_t max_output,
+                               const std::string& suppress_func) {
+        std::string body = R"(
+    const Tensor* boxes_tensor = inputs[0];
+    const Layout layout = boxes_tensor->layout;
+    TINYNN_ASSERT(layout.nr_dim == 3 && layout.dims[2] == 4);
+    const float* boxes = (const float*)boxes_tensor->ptr;
+    int32_t* out_idx = (int32_t*)outputs[0]->ptr;
+    int32_t* out_size = (int32_t*)outputs[1]->ptr;
+    const int batch = layout.dims[0];
+    const int nr_boxes = layout.dims[1];
+    //! no box is kept from the empty input, whose layout is not contiguous
+    TINYNN_ASSERT(nr_boxes == 0 || is_contiguous(layout));
+    const int max_output = ${max_output};
+    const float thresh = ${iou_thresh};
+    const size_t plane = (nr_boxes + 3) / 4 * 4;
+    float* x0 = (float*)workspace->ptr;
+    float* y0 = x0 + plane;
+    float* x1 = y0 + plane;
+    float* y1 = x1 + plane;
+    float* area = y1 + plane;
+    uint32_t* removed = (uint32_t*)(area + plane);
+    for (int b = 0; b < batch; ++b) {
+        const float* box = boxes + (size_t)b * nr_boxes * 4;
+        for (int i = 0; i < nr_boxes; ++i) {
+            x0[i] = box[i * 4 + 0];
+            y0[i] = box[i * 4 + 1];
+            x1[i] = box[i * 4 + 2];
+            y1[i] = box[i * 4 + 3];
+            area[i] = (x1[i] - x0[i]) * (y1[i] - y0[i]);
+        }
+        memset(removed, 0, nr_boxes * sizeof(uint32_t));
+        int32_t* idx = out_idx + (size_t)b * max_output;
+        int nr_keep = 0;
+        for (int i = 0; i < nr_boxes && nr_keep < max_output; ++i) {
+            if (removed[i]) {
+                continue;
+            }
+            idx[nr_keep++] = i;
+            ${suppress_func}(x0, y0, x1, y1, area, removed, i, nr_boxes, thresh);
+        }
+        out_size[b] = nr_keep;
+        const int32_t last = nr_keep > 0 ? idx[nr_keep - 1] : 0;
+        for (int i = nr_keep; i < max_output; ++i) {
+            idx[i] = last;
+        }
+    }
+    return TinyNN_SUCCESS;
+)";
+        return StringTemplate::StringTemplateArgs()
+                .add("max_output", max_output)
+                .add("iou_thresh", Utils::ssprintf("%.9ef", iou_thresh))
+                .add("suppress_func", suppress_func)
+                .render(body);
+    }
+};
+
+}  // namespace KernelGen
+}  // namespace megcc
+
+// vim: syntax=cpp.doxygen
@@ -0,0 +1,149 @@
+#pragma once
+#include <string>
+#include <vector>
+#include "Utils/StringTemplate.h"
+#include "Utils/Utils.h"
+#include "compiler/KernelGen/KernelGen.h"
+namespace megcc {
+namespace KernelGen {
+
+class PaddingHelper {
+public:
+    //! gen `pad_src_index(idx, front, len)` which maps an output index of one
+    //! dim to the source index of the padding mode, CONSTANT returns -1 when
+    //! the index is in the border
+    static std::string GenSrcIndexFunc(const std::string& mode) {
+        std::string map;
+        if (mode == "CONSTANT") {
+            map = "return (i >= 0 && i < len) ? i : -1;";
+        } else if (mode == "REPLICATE") {
+            map = "return i < 0 ? 0 : (i >= len ? len - 1 : i);";
+        } else {
+            CC_ASSERT(mode == "REFLECT") << "not support padding mode " << mode;
+            map = R"(i = i < 0 ? -i : i;
+            return i >= len ? 2 * len - 2 - i : i;)";
+        }
+        std::string func = R"(
+        static inline int pad_src_index(int idx, int front, int len) {
+            int i = idx - front;
+            ${map}
+        }
+    )";
+        return StringTemplate::StringTemplateArgs().add("map", map).render(func);
+    }
+
+    //! gen the padding body, src and dst must be contiguous. The trailing dims
+    //! without padding are merged into blocks, then the dst is walked row by
+    //! row along the last padded dim. The source part of a row is one bulk
+    //! move and the borders are filled per mode: CONSTANT stores the pad value
+    //! pattern with the arch specific `${fill_row_func}(dst, pattern, nr_bytes)`
+    //! while REPLICATE and REFLECT copy the mapped source blocks. All moves go
+    //! through the arch specific `${copy_row_func}(dst, src, nr_bytes)`
+    static std::string GenBody(
+            const std::vector<int>& front_offsets, const std::string& mode,
+            float padding_val, const std::string& specifier,
+            const std::string& copy_row_func, const std::string& fill_row_func) {
+        CC_ASSERT(front_offsets.size() == 7);
+        std::string body = R"(
+    const Tensor* src_tensor = inputs[0];
+    const Tensor* dst_tensor = outputs[0];
+    const Layout src_layout = src_tensor->layout;
+    const Layout dst_layout = dst_tensor->layout;
+    const uint8_t* src = (const uint8_t*)src_tensor->ptr;
+    uint8_t* dst = (uint8_t*)dst_tensor->ptr;
+    TINYNN_ASSERT(src && dst);
+    TINYNN_ASSERT(is_contiguous(src_layout) && is_contiguous(dst_layout));
+    const int front_offsets[7] = {${f0}, ${f1}, ${f2}, ${f3}, ${f4}, ${f5}, ${f6}};
+    const size_t elem_bytes = sizeof(${specifier});
+    ${init_pattern}
+
+    const int ndim = dst_layout.nr_dim;
+    int row_dim = ndim - 1;
+    size_t block = elem_bytes;
+    while (row_dim >= 0 && front_offsets[row_dim] == 0 &&
+           src_layout.dims[row_dim] == dst_layout.dims[row_dim]) {
+        block *= dst_layout.dims[row_dim];
+        --row_dim;
+    }
+    if (row_dim < 0) {
+        ${copy_row_func}(dst, src, block);
+        return TinyNN_SUCCESS;
+    }
+    const int row_front = front_offsets[row_dim];
+    const int src_len = src_layout.dims[row_dim];
+    const int dst_len = dst_layout.dims[row_dim];
+    const size_t src_row_bytes = src_len * block;
+    const size_t dst_row_bytes = dst_len * block;
+    const size_t front_bytes = row_front * block;
+    const size_t back_bytes = dst_row_bytes - front_bytes - src_row_bytes;
+    size_t nr_row = 1;
+    for (int i = 0; i < row_dim; ++i) {
+        nr_row *= dst_layout.dims[i];
+    }
+
+    int dst_idx[MAX_DIM] = {0};
+    for (size_t row = 0; row < nr_row; ++row) {
+        uint8_t* dst_row = dst + row * dst_row_bytes;
+        //! NULL means the whole row is in the border, only for CONSTANT
+        const uint8_t* src_row = src;
+        for (int i = 0; i < row_dim && src_row; ++i) {
+            int src_i = pad_src_index(dst_idx[i], front_offsets[i], src_layout.dims[i]);
+            src_row = src_i < 0 ? NULL
+                                : src_row + (size_t)src_i * src_layout.stride[i] * elem_bytes;
+        }
+        ${row_body}
+        for (int i = row_dim - 1; i >= 0; --i) {
+            if (++dst_idx[i] < dst_layout.dims[i]) {
+                break;
+            }
+            dst_idx[i] = 0;
+        }
+    }
+    return TinyNN_SUCCESS;
+)";
+        std::string init_pattern, row_body;
+        if (mode == "CONSTANT") {
+            init_pattern = R"(//! the pad value repeated to one 16 bytes vector
+    const ${specifier} pad_val = (${specifier})${padding_val};
+    uint8_t pad_pattern[16];
+    for (size_t i = 0; i < 16; i += sizeof(pad_val)) {
+        memcpy(pad_pattern + i, &pad_val, sizeof(pad_val));
+    })";
+            row_body = R"(if (!src_row) {
+            ${fill_row_func}(dst_row, pad_pattern, dst_row_bytes);
+        } else {
+            ${fill_row_func}(dst_row, pad_pattern, front_bytes);
+            ${copy_row_func}(dst_row + front_bytes, src_row, src_row_bytes);
+            ${fill_row_func}(dst_row + front_bytes + src_row_bytes, pad_pattern, back_bytes);
+        })";
+        } else {
+            row_body = R"(for (int i = 0; i < row_front; ++i) {
+            int src_i = pad_src_index(i, row_front, src_len);
+            ${copy_row_func}(dst_row + i * block, src_row + src_i * block, block);
+        }
+        ${copy_row_func}(dst_row + front_bytes, src_row, src_row_bytes);
+        for (int i = row_front + src_len; i < dst_len; ++i) {
+            int src_i = pad_src_index(i, row_front, src_len);
+            ${copy_row_func}(dst_row + i * block, src_row + src_i * block, block);
+        })";
+        }
+        auto args = StringTemplate::StringTemplateArgs()
+                            .add("specifier", specifier)
+                            .add("padding_val", Utils::ssprintf("%.9ef", padding_val))
+                            .add("copy_row_func", copy_row_func)
+                            .add("fill_row_func", fill_row_func);
+        for (int i = 0; i < 7; ++i) {
+            args.add("f" + std::to_string(i), front_offsets[i]);
+        }
+        init_pattern = args.render(init_pattern);
+        row_body = args.render(row_body);
+        return args.add("init_pattern", init_pattern)
+                .add("row_body", row_body)
+                .render(body);
+    }
+};
+
+}  // namespace KernelGen
+}  // namespace megcc
+
+// vim: syntax=cpp.doxygen
@@ -1,16 +1,57 @@
 #pragma once
 #include <string>
 #include "Utils/StringTemplate.h"
+#include "Utils/Utils.h"
 #include "compiler/KernelGen/KernelGen.h"
 namespace megcc {
 namespace KernelGen {
 
 class ResizeHelper {
 public:
+    //! the resize kernels copy or interpolate the values in the storage type,
+    //! so the quantized dst must have the same scale as the src
+    static bool is_dtype_ok(TContext* context) {
+        auto src = context->getAttrOprand("operand:0");
+        auto dst = Utils::get_last_operand(context);
+        bool dtype_ok = src.dtype == "f32" || src.dtype == "f16" ||
+                        src.dtype == "i8" || src.dtype == "ui8" ||
+                        Utils::is_quant_dtype(src.dtype, 8);
+        bool same_dtype = dst.dtype == src.dtype;
+        if (Utils::is_quant_dtype(src.dtype)) {
+            same_dtype = Utils::is_quant_dtype(dst.dtype, 8) && dst.scale == src.scale;
+        }
+        return dtype_ok && same_dtype;
+    }
+
+    static bool is_format_ok(TContext* context) {
+        auto format = context->getAttrStr("format");
+        return format == "NCHW" || format == "NHWC" || format == "NCHW44";
+    }
+
+    //! convert the interpolated float value to the dst storage type
+    static std::string GenOutputConverter(const std::string& dtype) {
+        auto specifier = Utils::cvt_dtype_specifier(dtype);
+        std::string body;
+        if (dtype == "f32" || dtype == "f16") {
+            body = "x";
+        } else if (dtype == "ui8") {
+            body = "roundf(fminf(fmaxf(x, 0.f), 255.f))";
+        } else {
+            body = "roundf(fminf(fmaxf(x, -128.f), 127.f))";
+        }
+        return StringTemplate::StringTemplateArgs()
+                .add("specifier", specifier)
+                .add("body", body)
+                .render(R"(
+        static inline ${specifier} output_converter(float x){
+            return (${specifier})${body};
+        }
+    )");
+    }
+
     static std::string GenCoordHelper(
             const std::string& imode, const std::string& specifier) {
         CC_ASSERT(imode == "LINEAR");
-        CC_ASSERT(specifier == "float");
         std::string body = R"(
         #include <math.h>
         static inline void get_coord(float scale, int size, int idx, float* ah0, int* ih0, float* ah1, int* ih1){
@@ -19,6 +60,7 @@ public:
                 *ih0 = 0;
                 *ah1 = 0.f;
                 *ih1 = 0;
+                return;
             }
             float alpha = (idx + 0.5f) / scale - 0.5f;
             int origin_idx = (int)(floorf(alpha));
@@ -93,24 +135,87 @@ public:
         return ret;
     }
 
-    static std::string GenNearestImpl() {
-        std::string ret;
-        ret = R"(
-            rep(n, N) {
-                rep(oh, OH) rep(ow, OW) {
-                    int ih = MIN((int)(oh / scale_h), IH - 1);
-                    int iw = MIN((int)(ow / scale_w), IW - 1);
+    //! the scalar dup_row used by the integer scale nearest resize, it
+    //! repeats every pixel of pix elements of a src row fw times
+    static std::string GenDupRow(const std::string& specifier) {
+        return StringTemplate::StringTemplateArgs()
+                .add("specifier", specifier)
+                .render(R"(
+        static inline void dup_row(${specifier}* dst, const ${specifier}* src, int IW,
+                                   int fw, int pix) {
+            if (pix == 1) {
+                rep(iw, IW) {
+                    ${specifier} val = src[iw];
+                    rep(k, fw) {
+                        dst[iw * fw + k] = val;
+                    }
+                }
+            } else {
+                rep(iw, IW) rep(k, fw) {
+                    memcpy(dst + (iw * fw + k) * pix, src + iw * pix,
+                           pix * sizeof(${specifier}));
+                }
+            }
+        }
+    )");
+    }
 
-                    rep(c, C) {
-                        dptr[c * OH * OW + oh * OW + ow] =
-                                sptr[c * S_IC + ih * S_IH + iw * S_IW];
+    //! nearest resize, when the output size is an integer multiple of the
+    //! input size every src pixel becomes a fh x fw block, the first row of a
+    //! block is built by dup_row and copied to the others, otherwise the
+    //! coordinate of every dst pixel is computed. dup_row must be defined
+    static std::string GenNearestImpl(
+            const std::string& format, const std::string& specifier) {
+        std::string pix, nr_plane;
+        if (format == "NCHW") {
+            pix = "1";
+            nr_plane = "N * C";
+        } else if (format == "NHWC") {
+            pix = "C";
+            nr_plane = "N";
+        } else {
+            CC_ASSERT(format == "NCHW44");
+            pix = "4";
+            nr_plane = "N * C / 4";
+        }
+        return StringTemplate::StringTemplateArgs()
+                .add("specifier", specifier)
+                .add("pix", pix)
+                .add("nr_plane", nr_plane)
+                .render(R"(
+            if (OH % IH == 0 && OW % IW == 0) {
+                int fh = OH / IH;
+                int fw = OW / IW;
+                int pix = ${pix};
+                size_t src_row = (size_t)IW * pix;
+                size_t dst_row = (size_t)OW * pix;
+                rep(p, ${nr_plane}) {
+                    rep(ih, IH) {
+                        ${specifier}* drow = dptr + (size_t)ih * fh * dst_row;
+                        dup_row(drow, sptr + ih * src_row, IW, fw, pix);
+                        for (int k = 1; k < fh; ++k) {
+                            memcpy(drow + k * dst_row, drow,
+                                   dst_row * sizeof(${specifier}));
+                        }
+                    }
+                    sptr += IH * src_row;
+                    dptr += OH * dst_row;
+                }
+            } else {
+                rep(n, N) {
+                    rep(oh, OH) rep(ow, OW) {
+                        int ih = MIN((int)(oh / scale_h), IH - 1);
+                        int iw = MIN((int)(ow / scale_w), IW - 1);
+                        rep(c, C) {
+                            dptr[get_offset(oh, ow, c, OH, OW, C)] =
+                                    sptr[get_offset(ih, iw, c, IH, IW, C)];
+                        }
                     }
+                    sptr += C * IH * IW;
+                    dptr += C * OH * OW;
                 }
-                sptr += S_IN;
-                dptr += C * OH * OW;
             }
-        )";
-        return ret;
+        )");
     }
 
     static std::string GenLayoutDims(const std::string& format) {
@@ -123,10 +228,15 @@ public:
                 int IW = src_layout.dims[3];
                 int OH = dst_layout.dims[2];
                 int OW = dst_layout.dims[3];
-                int S_IN = src_layout.stride[0];
-                int S_IC = src_layout.stride[1];
-                int S_IH = src_layout.stride[2];
-                int S_IW = src_layout.stride[3];
+            )";
+        } else if (format == "NHWC") {
+            ret = R"(
+                int N = src_layout.dims[0];
+                int IH = src_layout.dims[1];
+                int IW = src_layout.dims[2];
+                int C = src_layout.dims[3];
+                int OH = dst_layout.dims[1];
+                int OW = dst_layout.dims[2];
             )";
         } else {
             CC_ASSERT(format == "NCHW44");
@@ -150,6 +260,13 @@ public:
                     return c * H * W + h * W + w;
                 }
             )";
+        } else if (format == "NHWC") {
+            ret = R"(
+                static inline size_t get_offset(size_t h, size_t w, size_t c, size_t H, size_t W,
+                               size_t C){
+                    return (h * W + w) * C + c;
+                }
+            )";
         } else {
             CC_ASSERT(format == "NCHW44");
             ret = R"(
@@ -0,0 +1,766 @@
+#pragma once
+#include <algorithm>
+#include <sstream>
+#include <string>
+#include "Utils/StringTemplate.h"
+#include "Utils/Utils.h"
+#include "compiler/Common/Logger.h"
+#include "compiler/KernelGen/KernelGen.h"
+namespace megcc {
+namespace KernelGen {
+
+/*!
+ * The separable filter engine shared by GaussianBlur and SepFilter. Every src
+ * row is extended by the border table and filtered horizontally into a ring
+ * buffer of ksize_row rows of filter_dtype, once ksize_row rows are ready the
+ * vertical filter writes one dst row. The arch only provides the row and
+ * column filter functions, uint8 src is filtered either in fixed point with
+ * int kernels (bits = 8 for both passes) or in float.
+ */
+class SepFilterHelper {
+public:
+    static bool is_border_mode_ok(const std::string& mode) {
+        return mode == "CONSTANT" || mode == "REFLECT" || mode == "REFLECT_101" ||
+               mode == "REPLICATE";
+    }
+
+    static std::string get_lower_border_mode(TContext* context) {
+        std::string bmode = context->getAttrStr("border_mode");
+        std::transform(bmode.begin(), bmode.end(), bmode.begin(), [](unsigned char c) {
+            return std::tolower(c);
+        });
+        return bmode;
+    }
+
+    //! the gaussian blur symbol without the arch prefix
+    static std::string gen_gaussian_blur_symbol(TContext* context) {
+        std::stringstream ss;
+        auto src_dtype = context->getAttrOprand("operand:0").dtype;
+        uint32_t kh = context->getAttrUInt("kernel_height");
+        uint32_t kw = context->getAttrUInt("kernel_width");
+        float sigma_x = context->getAttrFloat("sigma_x");
+        float sigma_y = context->getAttrFloat("sigma_y");
+        ss << "gaussian_blur_" << get_lower_border_mode(context) << "_" << kh << "x"
+           << kw << "_sigmax_" << sigma_x << "_sigmay_" << sigma_y << "_" << src_dtype;
+        std::string symbol = ss.str();
+        //! function names can't contains "." .
+        std::replace(symbol.begin(), symbol.end(), '.', '_');
+        return symbol;
+    }
+
+    static std::string gen_border_interpolate(const std::string& bmode) {
+        std::string body_temp = R"(
+            static inline int border_interpolate(int p, const int len){
+                if ((unsigned)p >= (unsigned)len){
+                    ${core_temp}
+                }
+                return p;
+            }
+        )";
+        std::string core_temp;
+        if (bmode == "REFLECT") {
+            core_temp = R"(
+            if (len == 1)
+                return 0;
+            do {
+                if (p < 0)
+                    p = -p - 1;
+                else
+                    p = len - 1 - (p - len);
+            } while ((unsigned)p >= (unsigned)len);
+        )";
+        } else if (bmode == "REFLECT_101") {
+            core_temp = R"(
+            if (len == 1)
+                return 0;
+            do {
+                if (p < 0)
+                    p = -p - 1 + 1;
+                else
+                    p = len - 1 - (p - len) - 1;
+            } while ((unsigned)p >= (unsigned)len);
+        )";
+        } else if (bmode == "REPLICATE") {
+            core_temp = R"(
+            p = p < 0 ? 0 : len - 1;
+        )";
+        } else if (bmode == "CONSTANT") {
+            core_temp = R"(
+            p = -1;
+        )";
+        } else if (bmode == "WRAP") {
+            core_temp = R"(
+            if (p < 0)
+                p -= ((p - len + 1) / len) * len;
+
+            while (p >= len) {
+                p -= len;
+            }
+        )";
+        } else {
+            CC_ABORT << "no support bmode " << bmode << "\n";
+        }
+        return StringTemplate::StringTemplateArgs()
+                .add("core_temp", core_temp)
+                .render(body_temp);
+    }
+
+    static std::string gen_create_gaussian_kernels() {
+        return R"(
+        static inline void getGaussianKernel(size_t n, double sigma, TinyMat* kernel) {
+#define SMALL_GAUSSIAN_SIZE  7
+            static const float small_gaussian_tab[][SMALL_GAUSSIAN_SIZE] = {
+                    {1.f},
+                    {0.25f, 0.5f, 0.25f},
+                    {0.0625f, 0.25f, 0.375f, 0.25f, 0.0625f},
+                    {0.03125f, 0.109375f, 0.21875f, 0.28125f, 0.21875f, 0.109375f, 0.03125f}};
+
+            const float* fixed_kernel = n % 2 == 1 && n <= SMALL_GAUSSIAN_SIZE && sigma <= 0
+                                            ? small_gaussian_tab[n >> 1]
+                                            : 0;
+#undef SMALL_GAUSSIAN_SIZE
+
+            float* c = (float*)(kernel->data);
+
+            double sigmaX = sigma > 0 ? sigma : ((n - 1) * 0.5 - 1) * 0.3 + 0.8;
+            double scale2X = -0.5 / (sigmaX * sigmaX);
+            double sum = 0;
+
+            int i;
+            for (i = 0; i < (int)n; i++) {
+                double x = i - (n - 1) * 0.5;
+                double t = fixed_kernel ? (double)fixed_kernel[i] : exp(scale2X * x * x);
+                c[i] = (float)t;
+                sum += c[i];
+            }
+
+            sum = 1. / sum;
+            for (i = 0; i < (int)n; i++)
+                c[i] = (float)(c[i] * sum);
+        }
+
+        static inline void calRowsAndCols(int* rows, int* cols, double sigma1, double sigma2){
+            if (sigma2 <= 0)
+                sigma2 = sigma1;
+
+            if (*cols <= 0 && sigma1 > 0) {
+                double num = sigma1 * 4 * 2 + 1;
+                num = (int)(num + (num >= 0 ? 0.5 : -0.5));
+                *cols = ((int)num) | 1;
+            }
+            if (*rows <= 0 && sigma2 > 0) {
+                double num = sigma2 * 4 * 2 + 1;
+                num = (int)(num + (num >= 0 ? 0.5 : -0.5));
+                *rows = ((int)num) | 1;
+            }
+
+            TINYNN_ASSERT(
+                    (*cols > 0 && *cols % 2 == 1 && *rows > 0 &&
+                    *rows % 2 == 1));
+        }
+
+        static inline void createGaussianKernels(
+                TinyMat* kx, TinyMat* ky, int rows, int cols, double sigma1, double sigma2) {
+            if (sigma2 <= 0)
+                sigma2 = sigma1;
+
+            sigma1 = sigma1 > 0. ? sigma1 : 0.;
+            sigma2 = sigma2 > 0. ? sigma2 : 0.;
+
+            getGaussianKernel(cols, sigma1, kx);
+            if (rows == cols && sigma1 - sigma2 < 1e-7 && sigma1 - sigma2 > -1e-7)
+                memcpy(ky->data, kx->data, ky->cols * sizeof(float));
+            else
+                getGaussianKernel(rows, sigma2, ky);
+        }
+    )";
+    }
+
+    //! int filter for uint8 means the fixed point path, see gen_cast_op
+    static std::string get_filter_dtype(
+            const std::string& src_specifier, bool fixed_point) {
+        if (src_specifier == "float") {
+            return "float";
+        }
+        CC_ASSERT(src_specifier == "uint8_t")
+                << "sep filter not support " << src_specifier << "\n";
+        return fixed_point ? "int" : "float";
+    }
+
+    //! castOp converts the accumulator of the column filter to uint8, the
+    //! fixed point accumulator carries 16 fraction bits
+    static std::string gen_cast_op(
+            const std::string& src_specifier, const std::string& filter_dtype) {
+        if (src_specifier != "uint8_t") {
+            return "";
+        }
+        if (filter_dtype == "int") {
+            return R"(
+        static inline uint8_t castOp(int x){
+            int delta = (1 << 15);
+            int res = ((x + delta) >> 16);
+            return (uint8_t)((unsigned)res <= 255 ? res : (res < 0 ? 0 : 255));
+        }
+    )";
+        }
+        return R"(
+        static inline uint8_t castOp(float x){
+            x = x < 0.f ? 0.f : (x > 255.f ? 255.f : x);
+            return (uint8_t)roundf(x);
+        }
+    )";
+    }
+
+    //! the float kernels are scaled to int in place for the fixed point path
+    static std::string gen_kernel_to_fixed_point(
+            const std::string& kernel, const std::string& filter_dtype) {
+        if (filter_dtype != "int") {
+            return "";
+        }
+        return StringTemplate::StringTemplateArgs()
+                .add("kernel", kernel)
+                .render(R"(
+            for(size_t i = 0; i < ${kernel}.cols; ++i){
+                ((int*)(${kernel}.data))[i] = (int)(((float*)(${kernel}.data))[i] * (1 << 8));
+            }
+    )");
+    }
+
+    //! RowFilter, ColFilter and the FilterEngine driving them
+    static std::string gen_filter_engine(
+            const std::string& bmode, const std::string& src_specifier,
+            const std::string& filter_dtype) {
+        std::string helper = R"(
+        typedef struct RowFilter{
+            TinyMat* m_kernel;
+            int m_anchor, ksize;
+            void(*m_filter)(struct RowFilter* self, const uint8_t* src, uint8_t* dst, int width, int cn);
+        } RowFilter;
+
+        typedef struct ColFilter{
+            TinyMat* m_kernel;
+            int m_anchor, ksize;
+            void(*m_filter)(struct ColFilter *self, const uint8_t** src, uint8_t* dst, int dststep, int count, int width);
+        } ColFilter;
+
+        typedef struct FilterEngine {
+            RowFilter* m_row_filter;
+            ColFilter* m_column_filter;
+            size_t m_ch;
+
+            //! the size of the kernel
+            size_t m_ksize_row, m_ksize_col;
+
+            //! the center of kernel, e.g GuassianBlur m_anchor is (kernel_row/2,
+            //! kernel_column/2)
+            size_t m_anchor_x, m_anchor_y;
+
+            //! the whole size.
+            size_t m_whole_h, m_whole_w;
+            //! store the border value, if sizeof(src_type) >= 4,
+            int* m_border_table;
+            //! nr of border value
+            int m_border_elem_size;
+
+            //! the step of the buffer data.
+            int m_buf_step;
+
+            //! store the total row if the border is BORDER_CONSTANT, the size is
+            //! image_width + kernel_width - 1, which include the row and the border.
+            uint8_t* m_const_border_row;
+            //! store the total row if the border is not BORDER_CONSTANT
+            uint8_t* m_src_row;
+
+            //! store the kernel_height rows data.
+            uint8_t* m_ring_buf;
+
+            //! the border left width, equal to m_anchor.x
+            int m_left_width;
+            //! equal to m_ksize.width() - m_left_width - 1
+            int m_right_width;
+
+            void(*ctor)(struct FilterEngine* self, RowFilter* row_filter, ColFilter* column_filter, const size_t ch, const size_t cols, const size_t rows);
+            int (*proceed)(
+                struct FilterEngine* self, const uint8_t* src, int srcstep, int count, uint8_t* dst, int dststep);
+            void (*dtor)(struct FilterEngine* self);
+        }FilterEngine;
+
+#define VEC_ALIGN 16
+        static inline size_t align_size(size_t sz, int n){
+            TINYNN_ASSERT(((n & (n-1)) == 0));
+            return (sz + n - 1) & -n;
+        }
+
+        static inline uint8_t* align_ptr(uint8_t* ptr, int n) {
+            return (uint8_t*)(((size_t)ptr + n - 1) & -n);
+        }
+
+        static void filterEngineCtor(FilterEngine* self, RowFilter* row_filter, ColFilter* column_filter, const size_t ch, const size_t cols, const size_t rows){
+            self->m_row_filter = row_filter;
+            self->m_column_filter = column_filter;
+            self->m_ch = ch;
+
+            self->m_ksize_col = self->m_row_filter->ksize;
+            self->m_ksize_row = self->m_column_filter->ksize;
+            self->m_anchor_x = self->m_row_filter->m_anchor;
+            self->m_anchor_y = self->m_column_filter->m_anchor;
+            self->m_buf_step = 0;
+
+            self->m_whole_w = cols;
+            self->m_whole_h = rows;
+
+            int element_size = (int)sizeof(${src_dtype}) * self->m_ch;
+            int buf_elem_size = (int)sizeof(${filter_dtype}) * self->m_ch;
+
+            self->m_src_row = (uint8_t*)tinynn_malloc(element_size * (self->m_whole_w + self->m_ksize_col - 1));
+
+            ${init_const_border_row}
+
+            self->m_buf_step = buf_elem_size *
+                        (int)align_size(self->m_whole_w + self->m_ksize_col - 1, VEC_ALIGN);
+            self->m_ring_buf = (uint8_t*)tinynn_malloc(self->m_buf_step * self->m_ksize_row + VEC_ALIGN);
+            self->m_left_width = self->m_anchor_x;
+            self->m_right_width = self->m_ksize_col - self->m_anchor_x - 1;
+
+            self->m_border_elem_size = element_size;
+            ${init_non_const_border_table}
+        }
+
+        static int filterEngineProceed(
+                FilterEngine* self, const uint8_t* src, int srcstep, int count, uint8_t* dst, int dststep) {
+            int src_elem_size = (int)(sizeof(${src_dtype}) * self->m_ch);
+            int dy = 0, i = 0;
+
+            int row_count = 0;
+            int start_y = 0;
+            uint8_t **buf_rows = (uint8_t**)tinynn_malloc(sizeof(uint8_t*) * self->m_ksize_row);
+            for (;; dst += dststep * i, dy += i) {
+                int dcount = self->m_ksize_row - self->m_anchor_y - start_y - row_count;
+                dcount = dcount > 0 ? dcount : 1;
+                dcount = dcount < count ? dcount : count;
+                count -= dcount;
+                for (; dcount-- > 0; src += srcstep) {
+                    int bi = (start_y + row_count) % self->m_ksize_row;
+                    uint8_t* brow = align_ptr(self->m_ring_buf, VEC_ALIGN) + bi * self->m_buf_step;
+                    uint8_t* row = self->m_src_row;
+
+                    if (++row_count > (int)self->m_ksize_row) {
+                        --row_count;
+                        ++start_y;
+                    }
+
+                    memcpy(row + self->m_left_width * src_elem_size, src,
+                        self->m_whole_w * src_elem_size);
+
+                    ${set_non_const_border_value_by_border_table}
+
+                    self->m_row_filter->m_filter(self->m_row_filter, row, brow, self->m_whole_w, self->m_ch);
+                }
+
+                int max_i =
+                        self->m_ksize_row < self->m_whole_h - dy + (self->m_ksize_row - 1) ?
+                        self->m_ksize_row : self->m_whole_h - dy + (self->m_ksize_row - 1);
+                for (i = 0; i < max_i; i++) {
+                    int src_y = border_interpolate(
+                            dy + i - self->m_anchor_y, self->m_whole_h);
+                    if (src_y < 0) {
+                        TINYNN_ASSERT(self->m_const_border_row);
+                        buf_rows[i] = align_ptr(self->m_const_border_row, VEC_ALIGN);
+                    } else {
+                        TINYNN_ASSERT((src_y >= start_y));
+                        if (src_y >= start_y + row_count) {
+                            break;
+                        }
+                        int bi = src_y % self->m_ksize_row;
+                        buf_rows[i] = align_ptr(self->m_ring_buf, VEC_ALIGN) + bi * self->m_buf_step;
+                    }
+                }
+                if (i < (int)(self->m_ksize_row)) {
+                    break;
+                }
+                i -= self->m_ksize_row - 1;
+                self->m_column_filter->m_filter(
+                        self->m_column_filter, (const uint8_t**)buf_rows, dst, dststep, i,
+                        self->m_whole_w * self->m_ch);
+            }
+
+            tinynn_free(buf_rows);
+
+            return dy;
+        }
+#undef VEC_ALIGN
+        static void filterEngineDtor(FilterEngine* self){
+            tinynn_free(self->m_src_row);
+            tinynn_free(self->m_ring_buf);
+            if(self->m_const_border_row){
+                tinynn_free(self->m_const_border_row);
+            }
+            if(self->m_border_table){
+                tinynn_free(self->m_border_table);
+            }
+        }
+        )";
+        int is_constant = bmode == "CONSTANT";
+        std::string init_const_border_row =
+                (is_constant ? R"(
+            memset(self->m_src_row, 0, element_size * (self->m_whole_w + self->m_ksize_col - 1));
+            self->m_const_border_row = (uint8_t*)tinynn_malloc(
+                    buf_elem_size *
+                    (self->m_whole_w + self->m_ksize_col - 1 + VEC_ALIGN));
+            memset(self->m_const_border_row, 0, buf_elem_size *
+                    (self->m_whole_w + self->m_ksize_col - 1 + VEC_ALIGN));
+    )"
+                             : "self->m_const_border_row = NULL;");
+        std::string init_non_const_border_table = (!is_constant)
+                                                        ? R"(
+            int border_length = (int)(self->m_ksize_col - 1) > (int)1 ? (int)(self->m_ksize_col - 1) : (int)1;
+            self->m_border_table = (int*)tinynn_malloc(sizeof(int) * border_length * self->m_border_elem_size);
+            //! calc the index of the border value, we will not calc it when
+            //! process border each time
+            if (self->m_left_width > 0 || self->m_right_width > 0) {
+                for (int i = 0; i < self->m_left_width; i++) {
+                    int p0 = border_interpolate(
+                                    i - self->m_left_width, self->m_whole_w) *
+                            self->m_border_elem_size;
+                    for (int j = 0; j < self->m_border_elem_size; j++)
+                        self->m_border_table[i * self->m_border_elem_size + j] = p0 + j;
+                }
+
+                for (int i = 0; i < self->m_right_width; i++) {
+                    int p0 = border_interpolate(
+                                    self->m_whole_w + i, self->m_whole_w) *
+                            self->m_border_elem_size;
+                    for (int j = 0; j < self->m_border_elem_size; j++)
+                        self->m_border_table[(i + self->m_left_width) * self->m_border_elem_size + j] =
+                                p0 + j;
+                }
+            }
+    )"
+                                                        : "self->m_border_table = NULL;";
+        std::string set_non_const_border_value_by_border_table =
+                (!is_constant ? R"(
+                    TINYNN_ASSERT(self->m_border_table);
+                    if (self->m_left_width > 0 || self->m_right_width > 0) {
+                        for (int i = 0; i < self->m_left_width * src_elem_size; i++)
+                            row[i] = src[self->m_border_table[i]];
+                        for (int i = 0; i < self->m_right_width * src_elem_size; i++)
+                            row[i + (self->m_whole_w + self->m_left_width) * src_elem_size] =
+                                    src[self->m_border_table[i + self->m_left_width * src_elem_size]];
+                    }
+    )"
+                              : "");
+        return StringTemplate::StringTemplateArgs()
+                .add("init_const_border_row", init_const_border_row)
+                .add("init_non_const_border_table", init_non_const_border_table)
+                .add("set_non_const_border_value_by_border_table",
+                     set_non_const_border_value_by_border_table)
+                .add("src_dtype", src_specifier)
+                .add("filter_dtype", filter_dtype)
+                .render(helper);
+    }
+
+    /*!
+     * the scalar row and column filters, rowFilter and columnFilter take any
+     * kernel, the symm*SmallFilter variants are only valid for symmetric
+     * kernels and are emitted if with_symm is set, castOp must be emitted
+     * before for uint8
+     */
+    static std::string gen_naive_filters(
+            const std::string& src_specifier, const std::string& filter_dtype,
+            bool with_symm) {
+        std::string symm_row = R"(
+        static void symmRowSmallFilter(RowFilter* self, const uint8_t* src, uint8_t* dst, int width, int cn) {
+            int ksize2 = self->ksize / 2, ksize2n = ksize2 * cn;
+            const ${filter_dtype}* kx = (${filter_dtype}*)self->m_kernel->data + ksize2;
+            ${filter_dtype}* D = (${filter_dtype}*)dst;
+            int i = 0, j, k;
+
+            //! The center
+            const ${src_dtype}* S = (${src_dtype}*)src + i + ksize2n;
+            width *= cn;
+
+            if (self->ksize == 1 && kx[0] == 1) {
+                for (; i <= width - 2; i += 2) {
+                    ${filter_dtype} s0 = S[i], s1 = S[i + 1];
+                    D[i] = s0;
+                    D[i + 1] = s1;
+                }
+                S += i;
+            } else if (self->ksize == 3) {
+                ${filter_dtype} k0 = kx[0], k1 = kx[1];
+                for (; i <= width - 2; i += 2, S += 2) {
+                    ${filter_dtype} s0 = S[0] * k0 + (S[-cn] + S[cn]) * k1,
+                    s1 = S[1] * k0 + (S[1 - cn] + S[1 + cn]) * k1;
+                    D[i] = s0;
+                    D[i + 1] = s1;
+                }
+            } else if (self->ksize == 5) {
+                ${filter_dtype} k0 = kx[0], k1 = kx[1], k2 = kx[2];
+                for (; i <= width - 2; i += 2, S += 2) {
+                    ${filter_dtype} s0 = S[0] * k0 + (S[-cn] + S[cn]) * k1 +
+                            (S[-cn * 2] + S[cn * 2]) * k2;
+                    ${filter_dtype} s1 = S[1] * k0 + (S[1 - cn] + S[1 + cn]) * k1 +
+                            (S[1 - cn * 2] + S[1 + cn * 2]) * k2;
+                    D[i] = s0;
+                    D[i + 1] = s1;
+                }
+            }
+
+            for (; i < width; i++, S++) {
+                ${filter_dtype} s0 = kx[0] * S[0];
+                for (k = 1, j = cn; k <= ksize2; k++, j += cn)
+                    s0 += kx[k] * (S[j] + S[-j]);
+                D[i] = s0;
+            }
+        }
+)";
+        std::string row = R"(
+        static void rowFilter(RowFilter* self, const uint8_t* src, uint8_t* dst, int width, int cn){
+            const ${filter_dtype} *kx = (${filter_dtype}*)self->m_kernel->data;
+            const ${src_dtype} *S;
+            ${filter_dtype} *D = (${filter_dtype}*)dst;
+            int i = 0, k;
+            width *= cn;
+
+            for(; i + 3 < width; i += 4){
+                S = (${src_dtype}*)src + i;
+                ${filter_dtype} s0 = kx[0] * S[0], s1 = kx[0] * S[1], s2 = kx[0] * S[2], s3 = kx[0] * S[3];
+                for (k = 1; k < self->ksize; ++k) {
+                    S += cn;
+                    s0 += kx[k] * S[0];
+                    s1 += kx[k] * S[1];
+                    s2 += kx[k] * S[2];
+                    s3 += kx[k] * S[3];
+                }
+                D[i] = s0, D[i + 1] = s1, D[i + 2] = s2, D[i + 3] = s3;
+            }
+
+            for(; i < width; ++i){
+                S = (${src_dtype}*)src + i;
+                ${filter_dtype} s0 = kx[0] * S[0];
+                for (k = 1; k < self->ksize; ++k) {
+                    S += cn;
+                    s0 += kx[k] * S[0];
+                }
+                D[i] = s0;
+            }
+        }
+)";
+        std::string symm_col = R"(
+        static void symmColumnSmallFilter(ColFilter *self, const uint8_t** src, uint8_t* dst, int dststep, int count, int width) {
+            int ksize2 = self->ksize / 2;
+            const ${filter_dtype} *ky = (${filter_dtype}*)self->m_kernel->data + ksize2;
+            int i;
+            ${filter_dtype} f0 = ky[0], f1 = ky[1];
+            src += ksize2;
+
+            for (; count > 0; count--, dst += dststep, src++) {
+                ${dst_dtype}* D = (${dst_dtype}*)dst;
+                i = 0;
+                if (count == 0)
+                    break;
+                const ${filter_dtype}* S0 = (const ${filter_dtype}*)src[-1];
+                const ${filter_dtype}* S1 = (const ${filter_dtype}*)src[0];
+                const ${filter_dtype}* S2 = (const ${filter_dtype}*)src[1];
+
+                {
+                    for (; i <= width - 4; i += 4) {
+                        ${filter_dtype} s0 = (S0[i] + S2[i]) * f1 + S1[i] * f0;
+                        ${filter_dtype} s1 = (S0[i + 1] + S2[i + 1]) * f1 + S1[i + 1] * f0;
+                        ${filter_dtype} s2 = (S0[i + 2] + S2[i + 2]) * f1 + S1[i + 2] * f0;
+                        ${filter_dtype} s3 = (S0[i + 3] + S2[i + 3]) * f1 + S1[i + 3] * f0;
+
+                        ${store_unroll}
+                    }
+                    for (; i < width; i++) {
+                        ${filter_dtype} s0 = (S0[i] + S2[i]) * f1 + S1[i] * f0;
+                        ${store}
+                    }
+                }
+            }
+        }
+)";
+        std::string col = R"(
+        static void columnFilter(ColFilter *self, const uint8_t** src, uint8_t* dst, int dststep, int count, int width) {
+            const ${filter_dtype}* ky = (${filter_dtype}*)self->m_kernel->data;
+            int i = 0, k;
+            {
+                for (; count > 0; count--, dst += dststep, src++) {
+                    ${dst_dtype}* D = (${dst_dtype}*)dst;
+                    i = 0;
+                    for (; i <= width - 4; i += 4) {
+                        ${filter_dtype} f = ky[0];
+                        const ${filter_dtype}* S = (const ${filter_dtype}*)src[0] + i;
+                        ${filter_dtype} s0 = f * S[0], s1 = f * S[1], s2 = f * S[2], s3 = f * S[3];
+
+                        for (k = 1; k < self->ksize; k++) {
+                            S = (const ${filter_dtype}*)src[k] + i;
+                            f = ky[k];
+                            s0 += f * S[0];
+                            s1 += f * S[1];
+                            s2 += f * S[2];
+                            s3 += f * S[3];
+                        }
+
+                        ${store_unroll}
+                    }
+                    for (; i < width; i++) {
+                        ${filter_dtype} s0 = 0;
+                        for (k = 0; k < self->ksize; k++) {
+                            s0 += ky[k] * ((const ${filter_dtype}*)src[k])[i];
+                        }
+                        ${store}
+                    }
+                }
+            }
+        }
+)";
+        bool is_ui8 = src_specifier == "uint8_t";
+        std::string store_unroll = is_ui8 ? R"(
+                        D[i] = castOp(s0);
+                        D[i + 1] = castOp(s1);
+                        D[i + 2] = castOp(s2);
+                        D[i + 3] = castOp(s3);
+    )"
+                                          : R"(
+                        D[i] = s0;
+                        D[i + 1] = s1;
+                        D[i + 2] = s2;
+                        D[i + 3] = s3;
+    )";
+        std::string store = is_ui8 ? R"(
+                        D[i] = castOp(s0);
+    )"
+                                   : R"(
+                        D[i] = s0;
+    )";
+        std::string temp = with_symm ? symm_row + row + symm_col + col : row + col;
+        return StringTemplate::StringTemplateArgs()
+                .add("store_unroll", store_unroll)
+                .add("store", store)
+                .add("src_dtype", src_specifier)
+                .add("filter_dtype", filter_dtype)
+                .add("dst_dtype", src_specifier)
+                .render(temp);
+    }
+
+    /*!
+     * declare the FilterEngine fe on the horizontal kernel row_kernel and the
+     * vertical kernel col_kernel, both are TinyMat pointer expressions and
+     * row_filter and col_filter are the expressions of the filter functions
+     */
+    static std::string gen_engine_setup(
+            const std::string& row_kernel, const std::string& col_kernel,
+            const std::string& row_filter, const std::string& col_filter) {
+        return StringTemplate::StringTemplateArgs()
+                .add("row_kernel", row_kernel)
+                .add("col_kernel", col_kernel)
+                .add("row_filter", row_filter)
+                .add("col_filter", col_filter)
+                .render(R"(
+            RowFilter rf;
+            rf.m_kernel = ${row_kernel};
+            rf.ksize = (int)rf.m_kernel->cols;
+            rf.m_anchor = rf.ksize / 2;
+            rf.m_filter = ${row_filter};
+
+            ColFilter cf;
+            cf.m_kernel = ${col_kernel};
+            cf.ksize = (int)cf.m_kernel->cols;
+            cf.m_anchor = cf.ksize / 2;
+            cf.m_filter = ${col_filter};
+
+            FilterEngine fe;
+            fe.ctor = filterEngineCtor;
+            fe.proceed = filterEngineProceed;
+            fe.dtor = filterEngineDtor;
+)");
+    }
+
+    //! run fe on every image of the NHWC tensor inputs[0] into outputs[0]
+    static std::string gen_engine_proceed_nn(const std::string& src_specifier) {
+        return StringTemplate::StringTemplateArgs()
+                .add("src_specifier", src_specifier)
+                .add("dst_specifier", src_specifier)
+                .render(R"(
+            Tensor *src = inputs[0];
+            Layout src_layout = src->layout;
+            const int src_n = src_layout.dims[0];
+            const int src_rows = src_layout.dims[1];
+            const int src_cols = src_layout.dims[2];
+            const int src_channels = src_layout.dims[3];
+
+            Tensor *dst = outputs[0];
+            Layout dst_layout = dst->layout;
+            const int dst_cols = dst_layout.dims[2];
+            const int dst_channels = dst_layout.dims[3];
+
+            fe.ctor(&fe, &rf, &cf, src_channels, src_cols, src_rows);
+            for (int i = 0; i < src_n; ++i) {
+                uint8_t *src_ptr = (uint8_t*)src->ptr + sizeof(${src_specifier}) * src_layout.stride[0] * i;
+                uint8_t *dst_ptr = (uint8_t*)dst->ptr + sizeof(${dst_specifier}) * dst_layout.stride[0] * i;
+                fe.proceed(&fe, src_ptr, src_cols * src_channels * sizeof(${src_specifier}), fe.m_whole_h,
+                            dst_ptr, dst_cols * dst_channels * sizeof(${dst_specifier}));
+            }
+            fe.dtor(&fe);
+)");
+    }
+
+    //! run fe on the TinyMat src into dst
+    static std::string gen_engine_proceed_cv(const std::string& src_specifier) {
+        return StringTemplate::StringTemplateArgs()
+                .add("src_specifier", src_specifier)
+                .add("dst_specifier", src_specifier)
+                .render(R"(
+            fe.ctor(&fe, &rf, &cf, src->channels, src->cols, src->rows);
+            uint8_t *src_ptr = (uint8_t*)src->data;
+            uint8_t *dst_ptr = (uint8_t*)dst->data;
+            fe.proceed(&fe, src_ptr, src->cols * src->channels * sizeof(${src_specifier}), fe.m_whole_h,
+                        dst_ptr, dst->cols * dst->channels * sizeof(${dst_specifier}));
+            fe.dtor(&fe);
+)");
+    }
+
+    /*!
+     * build the gaussian kernels kernel_col (horizontal) and kernel_row
+     * (vertical) from the C expressions of the kernel size and sigma, free
+     * them with gen_gaussian_kernel_free
+     */
+    static std::string gen_gaussian_kernel_init(
+            const std::string& filter_dtype, const std::string& kernel_h,
+            const std::string& kernel_w, const std::string& sigma_x,
+            const std::string& sigma_y) {
+        return StringTemplate::StringTemplateArgs()
+                .add("kernel_h", kernel_h)
+                .add("kernel_w", kernel_w)
+                .add("sigma_x", sigma_x)
+                .add("sigma_y", sigma_y)
+                .add("cast_row_kernel",
+                     gen_kernel_to_fixed_point("kernel_row", filter_dtype))
+                .add("cast_col_kernel",
+                     gen_kernel_to_fixed_point("kernel_col", filter_dtype))
+                .render(R"(
+            int row = ${kernel_h}, col = ${kernel_w};
+            calRowsAndCols(&row, &col, ${sigma_x}, ${sigma_y});
+            TinyMat kernel_row = {1, row, 1, NULL};
+            TinyMat kernel_col = {1, col, 1, NULL};
+            kernel_row.data = (float*)tinynn_malloc(sizeof(float) * row);
+            kernel_col.data = (float*)tinynn_malloc(sizeof(float) * col);
+            createGaussianKernels(&kernel_col, &kernel_row, row, col, ${sigma_x}, ${sigma_y});
+            ${cast_row_kernel}
+            ${cast_col_kernel}
+)");
+    }
+
+    static std::string gen_gaussian_kernel_free() {
+        return R"(
+            tinynn_free(kernel_row.data);
+            tinynn_free(kernel_col.data);
+)";
+    }
+};
+
+}  // namespace KernelGen
+}  // namespace megcc
+
+// vim: syntax=cpp.doxygen
@@ -0,0 +1,53 @@
+#pragma once
+#include <string>
+#include "Utils/Utils.h"
+#include "compiler/KernelGen/KernelGen.h"
+namespace megcc {
+namespace KernelGen {
+
+//! the float matmul with the weight only quantized by the importer, the weight
+//! is (N, K) int8 or (N, K / 2) packed int4 with transposeB, and has
+//! nr_group = nr_scale / N scales of every row in the runtime dtype param. The
+//! group is ceil(K / nr_group) rounded up to the int4 block of 32, the last
+//! group of a row keeps the rest of K and may be shorter.
+//! Every 32 int4 values of a row are packed into 16 bytes, the low nibble of
+//! byte j holds value j and the high nibble holds value j + 16
+class WeightQuantMatMulHelper {
+public:
+    static bool is_available(TContext* ctx) {
+        if (ctx->getAttrInt("nr_operands") != 3) {
+            return false;
+        }
+        auto src = ctx->getAttrOprand("operand:0");
+        auto weight = ctx->getAttrOprand("operand:1");
+        auto dst = ctx->getAttrOprand("operand:2");
+        bool ok_dtype = src.dtype == "f32" && dst.dtype == "f32" &&
+                        Utils::is_quant_dtype(weight.dtype, 8) &&
+                        weight.per_channel_scale;
+        bool ok_mode = ctx->getAttrStr("format") == "DEFAULT" &&
+                       ctx->getAttrStr("compute_mode") == "DEFAULT" &&
+                       !ctx->getAttrBool("transposeA") &&
+                       ctx->getAttrBool("transposeB");
+        bool ok_shape = src.shape.size() == 2 && weight.shape.size() == 2;
+        ok_shape = ok_shape && (weight.shape[1] == src.shape[1] ||
+                                (weight.shape[1] * 2 == src.shape[1] &&
+                                 src.shape[1] % 32 == 0));
+        return ok_dtype && ok_mode && ok_shape;
+    }
+
+    //! the C expression of the group of K
+    static std::string gen_group(bool int4) {
+        return int4 ? "((k + nr_group - 1) / nr_group + 31) / 32 * 32"
+                    : "(k + nr_group - 1) / nr_group";
+    }
+
+    static bool is_int4(TContext* ctx) {
+        return ctx->getAttrOprand("operand:1").shape[1] * 2 ==
+               ctx->getAttrOprand("operand:0").shape[1];
+    }
+};
+
+}  // namespace KernelGen
+}  // namespace megcc
+
+// vim: syntax=cpp.doxygen
@@ -25,10 +25,13 @@ struct ActivationGenIntrinsicBase {
     virtual std::string GenIntrinsicFloatStore(
             const std::string& input, const std::string& outptr) const = 0;
 
-    //! compute the input neon data and write to the output ptr
+    //! requantize the int32 input data with src_scale, apply the activation and
+    //! quantize with dst_scale, then write 4 int8 to the output ptr. src_scale
+    //! is a GI_FLOAT32_t holding the scale of every lane, so that per output
+    //! channel quantized weights are supported, dst_scale is a float
     virtual std::string GenIntrinsicQuantStore(
             const std::string& input, const std::string& outptr,
-            const std::string& scale_sym) const = 0;
+            const std::string& src_scale, const std::string& dst_scale) const = 0;
 };
 
 template <NonlineMode mode, Dtype ctype>
@@ -52,17 +55,20 @@ public:
     }
     std::string GenIntrinsicQuantStore(
             const std::string& input, const std::string& outptr,
-            const std::string& scale_sym) const override {
+            const std::string& src_scale, const std::string& dst_scale) const override {
         std::string store_temp = R"(
             {
-                GI_FLOAT32_t f32_res = vcvtq_f32_s32(${input_reg});
-                GI_INT8_t s8_res =  GiCvtFromFloat32ToInt8(GiMultiplyScalerFloat32(f32_res, ${scale_sym}));
+                GI_FLOAT32_t f32_res = GiCastToFloat32(${input_reg});
+                f32_res = GiMultiplyFloat32(f32_res, ${src_scale});
+                f32_res = GiMultiplyScalerFloat32(f32_res, ${dst_scale});
+                GI_INT8_t s8_res = GiCvtFromFloat32ToInt8(f32_res);
                 GiStoreLane0Int32((int32_t*)(${output_ptr}), GiReinterpretInt8AsInt32(s8_res));
-            }        
+            }
         )";
         return StringTemplate::StringTemplateArgs()
                 .add("input_reg", input)
-                .add("scale_sym", scale_sym)
+                .add("src_scale", src_scale)
+                .add("dst_scale", dst_scale)
                 .add("output_ptr", outptr)
                 .render(store_temp);
     }
@@ -90,7 +96,7 @@ public:
     }
     std::string GenIntrinsicQuantStore(
             const std::string& input, const std::string& outptr,
-            const std::string& scale_sym) const override {
+            const std::string& src_scale, const std::string& dst_scale) const override {
         CC_ASSERT(0) << "not impl GI quant relu fp16 compute act\n";
         return "";
     }
@@ -120,17 +126,20 @@ public:
     }
     std::string GenIntrinsicQuantStore(
             const std::string& input, const std::string& outptr,
-            const std::string& scale_sym) const override {
+            const std::string& src_scale, const std::string& dst_scale) const override {
         std::string store_temp = R"(
             {
-                GI_FLOAT32_t f32_res = vcvtq_f32_s32(${input_reg});
-                GI_INT8_t s8_res =  GiCvtFromFloat32ToInt8(GiMultiplyScalerFloat32(f32_res, ${scale_sym}));
+                GI_FLOAT32_t f32_res = GiCastToFloat32(${input_reg});
+                f32_res = GiMaximumFloat32(GiMultiplyFloat32(f32_res, ${src_scale}), vzero);
+                f32_res = GiMultiplyScalerFloat32(f32_res, ${dst_scale});
+                GI_INT8_t s8_res = GiCvtFromFloat32ToInt8(f32_res);
                 GiStoreLane0Int32((int32_t*)(${output_ptr}), GiReinterpretInt8AsInt32(s8_res));
-            }        
+            }
         )";
         return StringTemplate::StringTemplateArgs()
                 .add("input_reg", input)
-                .add("scale_sym", scale_sym)
+                .add("src_scale", src_scale)
+                .add("dst_scale", dst_scale)
                 .add("output_ptr", outptr)
                 .render(store_temp);
     }
@@ -183,9 +192,27 @@ public:
     }
     std::string GenIntrinsicQuantStore(
             const std::string& input, const std::string& outptr,
-            const std::string& scale_sym) const override {
-        CC_ASSERT(0) << "not impl GI quant hswish act\n";
-        return "";
+            const std::string& src_scale, const std::string& dst_scale) const override {
+        std::string store_temp = R"(
+            {
+                GI_FLOAT32_t f32_res = GiCastToFloat32(${input_reg});
+                f32_res = GiMultiplyFloat32(f32_res, ${src_scale});
+                GI_FLOAT32_t relu6 = GiAddFloat32(f32_res, f3_v);
+                relu6 = GiMinimumFloat32(relu6, f6_v);
+                relu6 = GiMaximumFloat32(relu6, vzero);
+                f32_res = GiMultiplyFloat32(f32_res, relu6);
+                f32_res = GiMultiplyFloat32(f32_res, inv6_v);
+                f32_res = GiMultiplyScalerFloat32(f32_res, ${dst_scale});
+                GI_INT8_t s8_res = GiCvtFromFloat32ToInt8(f32_res);
+                GiStoreLane0Int32((int32_t*)(${output_ptr}), GiReinterpretInt8AsInt32(s8_res));
+            }
+        )";
+        return StringTemplate::StringTemplateArgs()
+                .add("input_reg", input)
+                .add("src_scale", src_scale)
+                .add("dst_scale", dst_scale)
+                .add("output_ptr", outptr)
+                .render(store_temp);
     }
 };
 
@@ -213,7 +240,7 @@ public:
     }
     std::string GenIntrinsicQuantStore(
             const std::string& input, const std::string& outptr,
-            const std::string& scale_sym) const override {
+            const std::string& src_scale, const std::string& dst_scale) const override {
         CC_ASSERT(0) << "not impl GI quant relu fp16 compute act\n";
         return "";
     }
@@ -266,7 +293,7 @@ public:
     }
     std::string GenIntrinsicQuantStore(
             const std::string& input, const std::string& outptr,
-            const std::string& scale_sym) const override {
+            const std::string& src_scale, const std::string& dst_scale) const override {
         CC_ASSERT(0) << "not impl GI quant hswish act\n";
         return "";
     }
@@ -0,0 +1,139 @@
+#include <sstream>
+
+#include "Argmax.h"
+#include "Common/Argmxx.h"
+#include "Utils/StringTemplate.h"
+#include "Utils/Utils.h"
+
+using namespace megcc;
+using namespace KernelGen;
+using namespace GeneralIntrinsic;
+
+namespace {
+//! the argmxx simd primitives on GI, every element is compared as a float
+//! lane, int8 and fp16 are exactly representable so the result is unchanged
+std::string gen_gi_prelude(const std::string& mode, const std::string& dtype) {
+    std::string specifier = Utils::cvt_dtype_specifier(dtype);
+    std::stringstream writer;
+    writer << R"(
+#include "gi_float.h"
+#include "gi_int.h"
+)";
+    if (dtype == "f32") {
+        writer << R"(
+#define ARGMXX_STEP 4
+#define ARGMXX_NR_VEC 1
+typedef GI_FLOAT32_t argmxx_val_t;
+static inline void argmxx_load(const float* ptr, argmxx_val_t* val) {
+    val[0] = GiLoadFloat32(ptr);
+}
+static inline argmxx_val_t argmxx_load4(const float* ptr) {
+    return GiLoadFloat32(ptr);
+}
+)";
+    } else {
+        if (dtype == "f16") {
+            writer << R"(
+#include "gi_float16.h"
+#define ARGMXX_STEP 8
+#define ARGMXX_NR_VEC 2
+typedef GI_FLOAT32_t argmxx_val_t;
+static inline void argmxx_load(const gi_float16_t* ptr, argmxx_val_t* val) {
+    GI_FLOAT32_V2_t vec = GiCastFloat16ToFloat32(GiLoadFloat16(ptr));
+    val[0] = GiGetSubVectorFloat32V2(vec, 0);
+    val[1] = GiGetSubVectorFloat32V2(vec, 1);
+}
+)";
+        } else {
+            writer << R"(
+#define ARGMXX_STEP 16
+#define ARGMXX_NR_VEC 4
+typedef GI_FLOAT32_t argmxx_val_t;
+static inline void argmxx_load(const int8_t* ptr, argmxx_val_t* val) {
+    GI_INT8_t vec = GiLoadInt8(ptr);
+    GI_INT16_t low = GiMoveLowLongInt8(vec);
+    GI_INT16_t high = GiMoveHighLongInt8(vec);
+    val[0] = GiCastToFloat32(GiMoveLowLongInt16(low));
+    val[1] = GiCastToFloat32(GiMoveHighLongInt16(low));
+    val[2] = GiCastToFloat32(GiMoveLowLongInt16(high));
+    val[3] = GiCastToFloat32(GiMoveHighLongInt16(high));
+}
+)";
+        }
+        writer << StringTemplate::StringTemplateArgs()
+                          .add("specifier", specifier)
+                          .render(R"(
+static inline argmxx_val_t argmxx_load4(const ${specifier}* ptr) {
+    float tmp[4] = {(float)ptr[0], (float)ptr[1], (float)ptr[2], (float)ptr[3]};
+    return GiLoadFloat32(tmp);
+}
+)");
+    }
+    writer << StringTemplate::StringTemplateArgs()
+                      .add("cmp", mode == "MAX" ? "GiGreaterThanFloat32"
+                                                : "GiLessThanFloat32")
+                      .render(R"(
+typedef GI_INT32_t argmxx_idx_t;
+static const int32_t argmxx_lane[4] = {0, 1, 2, 3};
+static inline argmxx_idx_t argmxx_iota(int base) {
+    return GiAddInt32(GiBroadcastInt32(base), GiLoadInt32(argmxx_lane));
+}
+static inline argmxx_idx_t argmxx_dup(int base) {
+    return GiBroadcastInt32(base);
+}
+static inline void argmxx_update(
+        argmxx_val_t* best, argmxx_idx_t* arg, argmxx_val_t val, argmxx_idx_t idx) {
+    GI_UINT32_t mask = ${cmp}(val, *best);
+    *best = GiBSLFloat32(mask, val, *best);
+    *arg = GiBlendInt32(*arg, idx, GiReinterpretAsInt32(GiReintUint32ToFloat32(mask)));
+}
+static inline void argmxx_store_arg(int32_t* ptr, argmxx_idx_t arg) {
+    GiStoreInt32(ptr, arg);
+}
+static inline void argmxx_store_lane(
+        float* val_ptr, int32_t* arg_ptr, argmxx_val_t best, argmxx_idx_t arg) {
+    GiStoreFloat32(val_ptr, best);
+    GiStoreInt32(arg_ptr, arg);
+}
+)");
+    return writer.str();
+}
+
+std::string gen_body(
+        TContext* context, const std::string& mode, const std::string& signature) {
+    auto dtype = context->getAttrOprand("operand:0").dtype;
+    std::stringstream writer;
+    writer << gen_gi_prelude(mode, dtype);
+    writer << GenCommonRet() << " " << signature << "{\n";
+    writer << ArgmxxHelper::gen_simd_body(
+            context, mode, Utils::cvt_dtype_specifier(dtype));
+    writer << "}\n";
+    return writer.str();
+}
+}  // namespace
+
+bool ArgmaxKernel::IsAvailable(TContext* context) const {
+    return ArgmxxHelper::is_available(context, true);
+}
+
+std::string ArgmaxKernel::GetKernelSymbol(TContext* context) const {
+    return ArgmxxHelper::gen_symbol("GI_kernel_", "MAX", context);
+}
+
+std::string ArgmaxKernel::GetKernelBody(TContext* context) const {
+    return gen_body(context, "MAX", GetKernelSignature(context));
+}
+
+bool ArgminKernel::IsAvailable(TContext* context) const {
+    return ArgmxxHelper::is_available(context, true);
+}
+
+std::string ArgminKernel::GetKernelSymbol(TContext* context) const {
+    return ArgmxxHelper::gen_symbol("GI_kernel_", "MIN", context);
+}
+
+std::string ArgminKernel::GetKernelBody(TContext* context) const {
+    return gen_body(context, "MIN", GetKernelSignature(context));
+}
+
+// vim: syntax=cpp.doxygen
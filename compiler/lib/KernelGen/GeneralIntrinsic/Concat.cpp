@@ -0,0 +1,64 @@
+#include "Concat.h"
+#include "Common/Concat.h"
+#include "Common/Indexing.h"
+#include "Utils/StringTemplate.h"
+#include "Utils/Utils.h"
+#include "compiler/Common/Logger.h"
+
+using namespace megcc;
+using namespace KernelGen;
+using namespace GeneralIntrinsic;
+
+bool ConcatKernel::IsAvailable(TContext* context) const {
+    size_t type_size =
+            Utils::get_dtype_size(context->getAttrOprand("operand:0").dtype);
+    return type_size == 1 || type_size == 2 || type_size == 4;
+}
+
+//! kernel gen
+std::string ConcatKernel::GetKernelSymbol(TContext* context) const {
+    std::stringstream ss;
+    ss << "GI_kernel_concat_byte_"
+       << Utils::get_dtype_size(context->getAttrOprand("operand:0").dtype)
+       << "_axis_" << context->getAttrInt("axis");
+    return ss.str();
+}
+
+std::string ConcatKernel::GetKernelBody(TContext* context) const {
+    std::string specifier = IndexingHelper::GetMoveSpecifier(
+            Utils::get_dtype_size(context->getAttrOprand("operand:0").dtype));
+    std::stringstream writer;
+    writer << R"(
+        #include <string.h>
+        #include "gi_int.h"
+        #include "tensor_util.h"
+
+        static inline void copy_row(void* dst_ptr, const void* src_ptr, size_t nr_bytes) {
+            int8_t* dst = (int8_t*)dst_ptr;
+            const int8_t* src = (const int8_t*)src_ptr;
+            size_t i = 0;
+            for (; i + 64 <= nr_bytes; i += 64) {
+                GI_INT8_t v0 = GiLoadInt8(src + i);
+                GI_INT8_t v1 = GiLoadInt8(src + i + 16);
+                GI_INT8_t v2 = GiLoadInt8(src + i + 32);
+                GI_INT8_t v3 = GiLoadInt8(src + i + 48);
+                GiStoreInt8(dst + i, v0);
+                GiStoreInt8(dst + i + 16, v1);
+                GiStoreInt8(dst + i + 32, v2);
+                GiStoreInt8(dst + i + 48, v3);
+            }
+            for (; i + 16 <= nr_bytes; i += 16) {
+                GiStoreInt8(dst + i, GiLoadInt8(src + i));
+            }
+            if (i < nr_bytes) {
+                memcpy(dst + i, src + i, nr_bytes - i);
+            }
+        }
+    )";
+    writer << GenCommonRet() << " " << GetKernelSignature(context) << "{\n";
+    writer << ConcatHelper::GenBody(context->getAttrInt("axis"), specifier, "copy_row");
+    writer << "}\n";
+    return writer.str();
+}
+
+// vim: syntax=cpp.doxygen
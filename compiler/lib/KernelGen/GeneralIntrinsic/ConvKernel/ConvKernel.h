@@ -147,10 +147,38 @@ public:
 
 private:
     std::string GetWorkspaceBodyCondition(TContext* ctx, bool jit) const;
-    std::shared_ptr<TContext> GetInnerGemmCtx(TContext* ctx) const;
     MatmulM4N12Kernel m_inner_gemm;
 };
 
+//! the fp16 nchw88 ConvBackData, a mk8 gemm into the col buffer and a col2im
+class Float16Nchw88Backward : public GIConvImpl {
+public:
+    std::string GetKernelSymbol(TContext* context) const override;
+    bool IsAvailable(TContext* context) const override;
+    //! kernel gen
+    std::string GetKernelBody(TContext* context) const override;
+    //! init gen
+    std::string GetInitBody(TContext* context) const override;
+    std::vector<KernelObj> GetDependInternalSymbol(TContext* context) const override;
+    std::string GetWorkspaceBody(TContext* context) const override;
+
+private:
+    Fp16MatmulM8N8MK8Kernel m_inner_gemm;
+};
+
+//! the int8 nchw44 ConvBackData, a mk4 gemm into the int32 col buffer and a
+//! col2im which requantizes the output
+class Int8Nchw44Backward : public GIConvImpl {
+public:
+    std::string GetKernelSymbol(TContext* context) const override;
+    bool IsAvailable(TContext* context) const override;
+    //! kernel gen
+    std::string GetKernelBody(TContext* context) const override;
+    //! init gen
+    std::string GetInitBody(TContext* context) const override;
+    std::string GetWorkspaceBody(TContext* context) const override;
+};
+
 class WinogradFloatF43NCHW44 : public GIConvImpl {
     mutable WinogradFrameNchw44 m_framework;
     mutable WinogradF43Strategy4x16MK4 m_winograd_strategy;
@@ -329,6 +357,49 @@ public:
     };
 };
 
+class ChannelWiseInt8Nchw44 : public GIConvImpl {
+public:
+    bool IsAvailable(TContext* context) const override;
+    //! kernel gen
+    std::string GetKernelBody(TContext* context) const override;
+    std::string GetWorkspaceBody(TContext* context) const override;
+    std::string GetKernelSubSymbol(TContext* context) const override {
+        return "chanwise_int8";
+    };
+};
+
+class DirectInt8Nchw44 : public GIConvImpl {
+public:
+    bool IsAvailable(TContext* context) const override;
+    //! kernel gen
+    std::string GetKernelBody(TContext* context) const override;
+    std::string GetWorkspaceBody(TContext* context) const override;
+    std::string GetKernelSubSymbol(TContext* context) const override {
+        return "direct_int8";
+    };
+};
+
+class Conv1x1Int8Nchw44 : public GIConvImpl {
+public:
+    bool IsAvailable(TContext* context) const override;
+    //! kernel gen
+    std::string GetKernelBody(TContext* context) const override;
+    std::string GetKernelSubSymbol(TContext* context) const override {
+        return "conv1x1_int8";
+    };
+};
+
+class ConvIm2colInt8Nchw44 : public GIConvImpl {
+public:
+    bool IsAvailable(TContext* context) const override;
+    //! kernel gen
+    std::string GetKernelBody(TContext* context) const override;
+    std::string GetWorkspaceBody(TContext* context) const override;
+    std::string GetKernelSubSymbol(TContext* context) const override {
+        return "im2col_int8";
+    };
+};
+
 }  // namespace GeneralIntrinsic
 }  // namespace KernelGen
 }  // namespace megcc
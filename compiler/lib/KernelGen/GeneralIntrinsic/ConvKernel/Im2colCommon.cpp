@@ -548,6 +548,9 @@ std::shared_ptr<TContext> Im2colStrategyBase::cvt2matmul_ctx(TContext* ctx) {
     inner_ctx->setAttr("transposeA", false);
     inner_ctx->setAttr("transposeB", false);
     inner_ctx->setAttr("dtype", ctx->getAttrOprand("operand:0").dtype);
+    if (ctx->haveAttr("compute_mode")) {
+        inner_ctx->setAttr("compute_mode", CCAttr(ctx->getAttrStr("compute_mode")));
+    }
     auto fmt = ctx->getAttrStr("format");
     if (fmt == "NCHW44") {
         inner_ctx->setAttr("format", "MK4");
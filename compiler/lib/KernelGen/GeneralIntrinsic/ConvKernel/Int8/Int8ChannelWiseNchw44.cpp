@@ -0,0 +1,239 @@
+#include <sstream>
+#include <string>
+#include "GeneralIntrinsic/ConvKernel/ConvKernel.h"
+#include "Int8Common.h"
+#include "Utils/StringTemplate.h"
+#include "compiler/KernelGen/KernelGen.h"
+
+using namespace megcc;
+using namespace KernelGen;
+using namespace GeneralIntrinsic;
+
+namespace {
+//! load 4 nchw44 pixels, when stride is 2 the even pixels of 8 pixels are
+//! picked out by zipping twice
+std::string gen_load_src(int stride) {
+    if (stride == 1) {
+        return R"(
+static inline GI_INT8_t load_src_x4(const int8_t* sptr) {
+    return GiLoadInt8(sptr);
+}
+)";
+    } else {
+        return R"(
+static inline GI_INT8_t load_src_x4(const int8_t* sptr) {
+    GI_INT32_t v0 = GiReinterpretInt8AsInt32(GiLoadInt8(sptr));
+    GI_INT32_t v1 = GiReinterpretInt8AsInt32(GiLoadInt8(sptr + 16));
+    //! p0 p4 p1 p5 and p2 p6 p3 p7
+    GI_INT32_t z0 = GiZipV0Int32(v0, v1);
+    GI_INT32_t z1 = GiZipV1Int32(v0, v1);
+    //! p0 p2 p4 p6
+    return GiReinterInt32ToInt8(GiZipV0Int32(z0, z1));
+}
+)";
+    }
+}
+
+std::string gen_compute_kern(
+        TContext* ctx, const std::string& nonline_mode, bool with_bias) {
+    auto act = create_activation_gener_instrinsic(nonline_mode);
+    std::string kern_temp = R"(
+//! src is padded to [IH2][IW2][4] and OW is rounded up to 4 in IW2
+static inline void nchw44_chanwise_int8(const int8_t* src, const int8_t* filter,
+        const int32_t* bias, int8_t* dst, const int IW2, const int OH, const int OW,
+        const float* flt_scale, const float src_scale, const float dst_scale) {
+    ${act_init}
+    const GI_FLOAT32_t scale =
+            GiMultiplyScalerFloat32(GiLoadFloat32(flt_scale), src_scale);
+    //! every tap of filter widened to int16 and duplicated for 2 pixels
+    GI_INT16_FIXLEN_t kern[${kernel_h} * ${kernel_w}];
+    for (int tap = 0; tap < ${kernel_h} * ${kernel_w}; ++tap) {
+        int32_t flt;
+        memcpy(&flt, filter + tap * 4, sizeof(int32_t));
+        GI_INT16_t k = GiMoveLowLongInt8(GiReinterInt32ToInt8(GiBroadcastInt32(flt)));
+        kern[tap] = GiInt16Type2FixLenType(k);
+    }
+    GI_INT32_t init = ${bias_init};
+    for (int oh = 0; oh < OH; ++oh) {
+        for (int ow = 0; ow < OW; ow += 4) {
+            GI_INT32_t c0 = init, c1 = init, c2 = init, c3 = init;
+            for (int kh = 0; kh < ${kernel_h}; ++kh) {
+                const int8_t* sptr =
+                        src + ((oh * ${stride_h} + kh) * IW2 + ow * ${stride_w}) * 4;
+                for (int kw = 0; kw < ${kernel_w}; ++kw) {
+                    GI_INT8_t s = load_src_x4(sptr + kw * 4);
+                    GI_INT16_t s01 = GiMoveLowLongInt8(s);
+                    GI_INT16_t s23 = GiMoveHighLongInt8(s);
+                    GI_INT16_t k = GiFixLenType2GiInt16Type(kern[kh * ${kernel_w} + kw]);
+                    c0 = GiMultiplyAddInt16LongLow(c0, s01, k);
+                    c1 = GiMultiplyAddInt16LongHigh(c1, s01, k);
+                    c2 = GiMultiplyAddInt16LongLow(c2, s23, k);
+                    c3 = GiMultiplyAddInt16LongHigh(c3, s23, k);
+                }
+            }
+            int8_t* dptr = dst + (oh * OW + ow) * 4;
+            if (ow + 4 <= OW) {
+                ${store(c0, 0)}
+                ${store(c1, 1)}
+                ${store(c2, 2)}
+                ${store(c3, 3)}
+            } else {
+                const int remain = OW - ow;
+                ${store(c0, 0)}
+                if (remain > 1) {
+                    ${store(c1, 1)}
+                }
+                if (remain > 2) {
+                    ${store(c2, 2)}
+                }
+            }
+        }
+    }
+}
+)";
+    return StringTemplate::StringTemplateArgs(ctx)
+            .add_ctx_int("kernel_h")
+            .add_ctx_int("kernel_w")
+            .add_ctx_int("stride_h")
+            .add_ctx_int("stride_w")
+            .add("act_init", act->GenIntrinsicInitFloat())
+            .add("bias_init", with_bias ? "GiLoadInt32(bias)" : "GiBroadcastInt32(0)")
+            .add("store",
+                 [=](const std::string& reg, const std::string& idx) {
+                     return act->GenIntrinsicQuantStore(
+                             reg, "dptr + " + idx + " * 4", "scale", "dst_scale");
+                 })
+            .render(kern_temp);
+}
+}  // namespace
+
+bool ChannelWiseInt8Nchw44::IsAvailable(TContext* ctx) const {
+    bool param_value_ok =
+            ctx->getAttrUInt("kernel_h") <= 7 && ctx->getAttrUInt("kernel_w") <= 7 &&
+            ctx->getAttrUInt("stride_h") == ctx->getAttrUInt("stride_w") &&
+            (ctx->getAttrUInt("stride_h") == 1 || ctx->getAttrUInt("stride_h") == 2) &&
+            ctx->getAttrUInt("dilate_h") == 1 && ctx->getAttrUInt("dilate_w") == 1;
+
+    bool param_mode_ok = ctx->getAttrStr("sparse") == "GROUP" &&
+                         ctx->getAttrStr("format") == "NCHW44" &&
+                         ctx->getAttrStr("mode") == "CROSS_CORRELATION";
+    bool type_ok = is_qint8_conv_dtype(ctx, false, true);
+    bool layout_ok = ctx->getAttrOprand("operand:0").shape.size() == 5 &&
+                     ctx->getAttrOprand("operand:0").shape[4] == 4;
+    bool channel_wise_ok = ctx->getAttrOprand("operand:1").shape.size() == 6 &&
+                           ctx->getAttrOprand("operand:1").shape[5] == 4 &&
+                           ctx->getAttrOprand("operand:1").shape[1] == 1 &&
+                           ctx->getAttrOprand("operand:1").shape[2] == 1;
+    bool bias_ok = !is_bias(ctx) || is_channel_broadcast_bias(ctx);
+    return param_value_ok && param_mode_ok && type_ok && is_int8_nonline_ok(ctx) &&
+           layout_ok && channel_wise_ok && bias_ok;
+}
+
+std::string ChannelWiseInt8Nchw44::GetWorkspaceBody(TContext* ctx) const {
+    std::stringstream ss;
+    ss << GenCommonRet() << " " << GetWorkspaceSignature(ctx);
+    std::string workspace_temp = R"({
+        TINYNN_ASSERT(workspace);
+        const Layout in_layout = inputs[0]->layout;
+        const uint32_t oh =
+                (in_layout.dims[2] + 2 * ${pad_h} - ${kernel_h}) / ${stride_h} + 1;
+        const uint32_t ow =
+                (in_layout.dims[3] + 2 * ${pad_w} - ${kernel_w}) / ${stride_w} + 1;
+        const uint32_t ih2 = ${stride_h} * (oh - 1) + ${kernel_h};
+        const uint32_t ow_round4 = (ow + 3) & ~3;
+        const uint32_t iw2 = ${stride_w} * (ow_round4 - 1) + ${kernel_w};
+        //! the extra 16B is used by the stride 2 load, which reads 8 pixels
+        *workspace = (size_t)ih2 * iw2 * 4 + 16;
+        return TinyNN_SUCCESS;
+    })";
+    ss << StringTemplate::StringTemplateArgs(ctx)
+                    .add_ctx_int("pad_h")
+                    .add_ctx_int("pad_w")
+                    .add_ctx_int("stride_h")
+                    .add_ctx_int("stride_w")
+                    .add_ctx_int("kernel_h")
+                    .add_ctx_int("kernel_w")
+                    .render(workspace_temp);
+    return ss.str();
+}
+
+std::string ChannelWiseInt8Nchw44::GetKernelBody(TContext* ctx) const {
+    bool with_bias = ConvImpl::is_bias(ctx);
+    std::string bias_str = with_bias ? "inputs[2]->ptr" : "0";
+    std::string nonline_mode =
+            ctx->haveAttr("nonlineMode") ? ctx->getAttrStr("nonlineMode") : "IDENTITY";
+    std::stringstream writer;
+    writer << R"(
+        #include <string.h>
+        #include "gi_float.h"
+        #include "gi_int.h"
+    )";
+    writer << gen_load_src(ctx->getAttrUInt("stride_w"));
+    writer << gen_compute_kern(ctx, nonline_mode, with_bias);
+    writer << GenCommonRet() << " " << GetKernelSignature(ctx) << "{\n";
+    std::string body_temp = R"(
+    const int pack_c_size = 4;
+    const int N = inputs[0]->layout.dims[0];
+    const int ICB = inputs[0]->layout.dims[1];
+    const int IH = inputs[0]->layout.dims[2];
+    const int IW = inputs[0]->layout.dims[3];
+    const int OH = outputs[0]->layout.dims[2];
+    const int OW = outputs[0]->layout.dims[3];
+    const int PH = ${pad_h}, PW = ${pad_w};
+    const int IH2 = ${stride_h} * (OH - 1) + ${kernel_h};
+    const int OW_ROUND4 = (OW + 3) & ~3;
+    const int IW2 = ${stride_w} * (OW_ROUND4 - 1) + ${kernel_w};
+    //! the input rows and cols which are covered by the padded src
+    const int copy_h = IH < IH2 - PH ? IH : IH2 - PH;
+    const int copy_w = IW < IW2 - PW ? IW : IW2 - PW;
+
+    const float src_scale = inputs[0]->dtype.param.scale;
+    const float flt_scale = inputs[1]->dtype.param.scale;
+    const float dst_scale = outputs[0]->dtype.param.scale;
+    const float dst_scale_inv = 1.f / dst_scale;
+    //! the filter scales of channel block icb are flt_scales + icb * flt_scale_step,
+    //! the per tensor scale is broadcast to every channel block
+    const float flt_scale_oc4[4] = {flt_scale, flt_scale, flt_scale, flt_scale};
+    const float* flt_scales = inputs[1]->dtype.param.scales;
+    const int flt_scale_step = flt_scales ? pack_c_size : 0;
+    if (!flt_scales) {
+        flt_scales = flt_scale_oc4;
+    }
+
+    const int8_t* input_data = inputs[0]->ptr;
+    int8_t* output_data = outputs[0]->ptr;
+    const int8_t* weight_data = inputs[1]->ptr;
+    const int32_t* bias_data = ${bias_str};
+    int8_t* padding_src = workspace->ptr;
+    for (int n = 0; n < N; ++n) {
+        for (int icb = 0; icb < ICB; ++icb) {
+            const int8_t* src_ptr =
+                    input_data + ((size_t)n * ICB + icb) * IH * IW * pack_c_size;
+            int8_t* dst_ptr = output_data + ((size_t)n * ICB + icb) * OH * OW * pack_c_size;
+            memset(padding_src, 0, (size_t)IH2 * IW2 * pack_c_size);
+            for (int ih = 0; ih < copy_h; ++ih) {
+                memcpy(padding_src + ((ih + PH) * IW2 + PW) * pack_c_size,
+                       src_ptr + ih * IW * pack_c_size, copy_w * pack_c_size);
+            }
+            nchw44_chanwise_int8(
+                    padding_src,
+                    weight_data + icb * ${kernel_h} * ${kernel_w} * pack_c_size,
+                    bias_data + icb * pack_c_size, dst_ptr, IW2, OH, OW,
+                    flt_scales + icb * flt_scale_step, src_scale, dst_scale_inv);
+        }
+    }
+    return TinyNN_SUCCESS;
+})";
+    writer << StringTemplate::StringTemplateArgs(ctx)
+                      .add_ctx_int("pad_h")
+                      .add_ctx_int("pad_w")
+                      .add_ctx_int("kernel_h")
+                      .add_ctx_int("kernel_w")
+                      .add_ctx_int("stride_h")
+                      .add_ctx_int("stride_w")
+                      .add("bias_str", bias_str)
+                      .render(body_temp);
+    return writer.str();
+}
+
+// vim: syntax=cpp.doxygen
@@ -0,0 +1,154 @@
+#pragma once
+#include <sstream>
+#include <string>
+#include "Common/ConvKernel.h"
+#include "GeneralIntrinsic/Activation.h"
+#include "Utils/StringTemplate.h"
+#include "compiler/KernelGen/KernelGen.h"
+
+namespace megcc {
+namespace KernelGen {
+namespace GeneralIntrinsic {
+
+//! gen the int8 nchw44 dense kernels `int8_nchw44_oc4_ow8` and
+//! `int8_nchw44_oc4_ow8_remain`, which compute 4 output channels of at most 8
+//! output pixels. The weight is organized as [icb][tap][4(ic)][4(oc)], which is
+//! the same as the nchw44 dense filter, so no weight pre-pack is needed. The
+//! 4 input channels of pixel p at tap t in input channel block icb are at
+//! `src + icb * ld_src_icb + tap_offset[t] + p * pix_stride`. Every input
+//! value is broadcast to int16 and multiplied with the widened weight column
+//! by the widening multiply-accumulate, then the int32 result is requantized
+//! with src_scale, the 4 filter scales of the output channels and dst_scale
+static inline std::string gen_int8_nchw44_oc4_kern(
+        const std::string& nonline_mode, bool with_bias) {
+    auto act = create_activation_gener_instrinsic(nonline_mode);
+    std::string kern_temp = R"(
+static inline void ${func_name}(const int8_t* src, const int8_t* weight,
+        const int32_t* bias, int8_t* dst, const int nr_icb, const int ld_src_icb,
+        const int* tap_offset, const int nr_tap, const int pix_stride${remain_param},
+        const float* flt_scale, const float src_scale, const float dst_scale) {
+    ${act_init}
+    const GI_FLOAT32_t scale =
+            GiMultiplyScalerFloat32(GiLoadFloat32(flt_scale), src_scale);
+    GI_INT32_t init = ${bias_init};
+    GI_INT32_FIXLEN_t c[8];
+    for (int p = 0; p < 8; ++p) {
+        c[p] = GiInt32Type2FixLenType(init);
+    }
+    for (int icb = 0; icb < nr_icb; ++icb) {
+        const int8_t* src_icb = src + icb * ld_src_icb;
+        for (int tap = 0; tap < nr_tap; ++tap) {
+            GI_INT8_t w = GiLoadInt8(weight);
+            GI_INT16_t w01 = GiMoveLowLongInt8(w);
+            GI_INT16_t w23 = GiMoveHighLongInt8(w);
+            const int8_t* sptr = src_icb + tap_offset[tap];
+            for (int p = 0; p < ${nr_pix}; ++p) {
+                const int8_t* s = sptr + p * pix_stride;
+                GI_INT32_t acc = GiFixLenType2GiInt32Type(c[p]);
+                acc = GiMultiplyAddInt16LongLow(acc, GiBroadcastInt16(s[0]), w01);
+                acc = GiMultiplyAddInt16LongHigh(acc, GiBroadcastInt16(s[1]), w01);
+                acc = GiMultiplyAddInt16LongLow(acc, GiBroadcastInt16(s[2]), w23);
+                acc = GiMultiplyAddInt16LongHigh(acc, GiBroadcastInt16(s[3]), w23);
+                c[p] = GiInt32Type2FixLenType(acc);
+            }
+            weight += 16;
+        }
+    }
+    for (int p = 0; p < ${nr_pix}; ++p) {
+        GI_INT32_t res = GiFixLenType2GiInt32Type(c[p]);
+        ${store}
+    }
+}
+)";
+    std::string bias_init =
+            with_bias ? "GiLoadInt32(bias)" : "GiBroadcastInt32(0)";
+    std::string store =
+            act->GenIntrinsicQuantStore("res", "dst + p * 4", "scale", "dst_scale");
+    std::stringstream ss;
+    ss << StringTemplate::StringTemplateArgs()
+                    .add("func_name", "int8_nchw44_oc4_ow8")
+                    .add("remain_param", "")
+                    .add("nr_pix", 8)
+                    .add("act_init", act->GenIntrinsicInitFloat())
+                    .add("bias_init", bias_init)
+                    .add("store", store)
+                    .render(kern_temp);
+    ss << StringTemplate::StringTemplateArgs()
+                    .add("func_name", "int8_nchw44_oc4_ow8_remain")
+                    .add("remain_param", ", const int nr_pix")
+                    .add("nr_pix", "nr_pix")
+                    .add("act_init", act->GenIntrinsicInitFloat())
+                    .add("bias_init", bias_init)
+                    .add("store", store)
+                    .render(kern_temp);
+    return ss.str();
+}
+
+//! the nonline modes supported by the GI int8 requantization epilogue
+static inline bool is_int8_nonline_ok(TContext* ctx) {
+    return !ctx->haveAttr("nonlineMode") ||
+           ctx->getAttrStr("nonlineMode") == "IDENTITY" ||
+           ctx->getAttrStr("nonlineMode") == "RELU" ||
+           ctx->getAttrStr("nonlineMode") == "H_SWISH";
+}
+
+//! the mode, dtype and layout check shared by the int8 nchw44 dense kernels,
+//! the group conv here must be a real group conv, not a channel wise one
+static inline bool is_int8_nchw44_dense_ok(TContext* ctx) {
+    bool param_mode_ok = ctx->getAttrStr("format") == "NCHW44" &&
+                         ctx->getAttrStr("mode") == "CROSS_CORRELATION";
+    auto flt_shape = ctx->getAttrOprand("operand:1").shape;
+    bool sparse_ok = (ctx->getAttrStr("sparse") == "DENSE" && flt_shape.size() == 6) ||
+                     (ctx->getAttrStr("sparse") == "GROUP" && flt_shape.size() == 7);
+    bool type_ok = ConvImpl::is_qint8_conv_dtype(ctx, false, true);
+    bool layout_ok = ctx->getAttrOprand("operand:0").shape.size() == 5 &&
+                     ctx->getAttrOprand("operand:0").shape[4] == 4;
+    bool bias_ok = !ConvImpl::is_bias(ctx) || ConvImpl::is_channel_broadcast_bias(ctx);
+    return param_mode_ok && sparse_ok && type_ok && layout_ok && bias_ok &&
+           is_int8_nonline_ok(ctx);
+}
+
+//! the common tensor description of the int8 nchw44 dense kernels, the dense
+//! filter is [OCB, ICB, FH, FW, 4, 4] and the group filter is
+//! [G, OCB, ICB, FH, FW, 4, 4]
+static inline std::string gen_int8_nchw44_dense_param() {
+    return R"(
+    const int pack_c_size = 4;
+    const Layout weight_layout = inputs[1]->layout;
+    const int N = inputs[0]->layout.dims[0];
+    const int IH = inputs[0]->layout.dims[2];
+    const int IW = inputs[0]->layout.dims[3];
+    const int OH = outputs[0]->layout.dims[2];
+    const int OW = outputs[0]->layout.dims[3];
+    int Group = 1, OCPG_B, ICPG_B;
+    if (weight_layout.nr_dim == 7) {
+        Group = weight_layout.dims[0];
+        OCPG_B = weight_layout.dims[1];
+        ICPG_B = weight_layout.dims[2];
+    } else {
+        OCPG_B = weight_layout.dims[0];
+        ICPG_B = weight_layout.dims[1];
+    }
+    const size_t src_batch_stride = (size_t)Group * ICPG_B * IH * IW * pack_c_size;
+    const size_t dst_batch_stride = (size_t)Group * OCPG_B * OH * OW * pack_c_size;
+
+    const float src_scale = inputs[0]->dtype.param.scale;
+    const float flt_scale = inputs[1]->dtype.param.scale;
+    const float dst_scale = outputs[0]->dtype.param.scale;
+    const float dst_scale_inv = 1.f / dst_scale;
+    //! the filter scales of oc block ocb are flt_scales + ocb * flt_scale_step,
+    //! the per tensor scale is broadcast to every oc block
+    const float flt_scale_oc4[4] = {flt_scale, flt_scale, flt_scale, flt_scale};
+    const float* flt_scales = inputs[1]->dtype.param.scales;
+    const int flt_scale_step = flt_scales ? pack_c_size : 0;
+    if (!flt_scales) {
+        flt_scales = flt_scale_oc4;
+    }
+)";
+}
+
+}  // namespace GeneralIntrinsic
+}  // namespace KernelGen
+}  // namespace megcc
+
+// vim: syntax=cpp.doxygen
@@ -0,0 +1,89 @@
+#include <sstream>
+#include <string>
+#include "GeneralIntrinsic/ConvKernel/ConvKernel.h"
+#include "Int8Common.h"
+#include "Utils/StringTemplate.h"
+#include "compiler/KernelGen/KernelGen.h"
+
+using namespace megcc;
+using namespace KernelGen;
+using namespace GeneralIntrinsic;
+
+bool Conv1x1Int8Nchw44::IsAvailable(TContext* ctx) const {
+    bool param_value_ok =
+            ctx->getAttrUInt("kernel_h") == 1 && ctx->getAttrUInt("kernel_w") == 1 &&
+            ctx->getAttrUInt("stride_h") == 1 && ctx->getAttrUInt("stride_w") == 1 &&
+            ConvImpl::is_no_pad(ctx) && ctx->getAttrUInt("dilate_h") == 1 &&
+            ctx->getAttrUInt("dilate_w") == 1;
+    return param_value_ok && is_int8_nchw44_dense_ok(ctx);
+}
+
+std::string Conv1x1Int8Nchw44::GetKernelBody(TContext* ctx) const {
+    bool with_bias = ConvImpl::is_bias(ctx);
+    std::string bias_str = with_bias ? "inputs[2]->ptr" : "0";
+    std::string nonline_mode =
+            ctx->haveAttr("nonlineMode") ? ctx->getAttrStr("nonlineMode") : "IDENTITY";
+    std::stringstream writer;
+    writer << R"(
+        #include "gi_float.h"
+        #include "gi_int.h"
+    )";
+    writer << gen_int8_nchw44_oc4_kern(nonline_mode, with_bias);
+    writer << GenCommonRet() << " " << GetKernelSignature(ctx) << "{\n";
+    writer << gen_int8_nchw44_dense_param();
+    //! 1x1 conv with stride 1 and no padding is a matmul of [OCB, ICB] x [ICB, HW],
+    //! so the output pixels are walked as one row and the pixel blocks are the
+    //! outer loop to keep the src block in cache when looping the output channels
+    std::string body_temp = R"(
+    const int HW = IH * IW;
+    const int ld_src_icb = HW * pack_c_size;
+    const int ld_weight_ocb = ICPG_B * 16;
+    const int tap_offset[1] = {0};
+
+    const int8_t* input_data = inputs[0]->ptr;
+    int8_t* output_data = outputs[0]->ptr;
+    const int8_t* weight_data = inputs[1]->ptr;
+    const int32_t* bias_data = ${bias_str};
+    for (int n = 0; n < N; ++n) {
+        for (int g = 0; g < Group; ++g) {
+            const int8_t* src_ptr = input_data + n * src_batch_stride +
+                                    (size_t)g * ICPG_B * ld_src_icb;
+            int8_t* dst_ptr = output_data + n * dst_batch_stride +
+                              (size_t)g * OCPG_B * HW * pack_c_size;
+            const int8_t* weight_ptr = weight_data + (size_t)g * OCPG_B * ld_weight_ocb;
+            const int32_t* bias_ptr = bias_data + g * OCPG_B * pack_c_size;
+            const float* flt_scale_ptr = flt_scales + g * OCPG_B * flt_scale_step;
+            int pos = 0;
+            for (; pos + 8 <= HW; pos += 8) {
+                for (int ocb = 0; ocb < OCPG_B; ++ocb) {
+                    int8_nchw44_oc4_ow8(src_ptr + pos * pack_c_size,
+                                        weight_ptr + ocb * ld_weight_ocb,
+                                        bias_ptr + ocb * pack_c_size,
+                                        dst_ptr + (ocb * HW + pos) * pack_c_size, ICPG_B,
+                                        ld_src_icb, tap_offset, 1, pack_c_size,
+                                        flt_scale_ptr + ocb * flt_scale_step,
+                                        src_scale, dst_scale_inv);
+                }
+            }
+            if (pos < HW) {
+                for (int ocb = 0; ocb < OCPG_B; ++ocb) {
+                    int8_nchw44_oc4_ow8_remain(
+                            src_ptr + pos * pack_c_size, weight_ptr + ocb * ld_weight_ocb,
+                            bias_ptr + ocb * pack_c_size,
+                            dst_ptr + (ocb * HW + pos) * pack_c_size, ICPG_B, ld_src_icb,
+                            tap_offset, 1, pack_c_size, HW - pos,
+                            flt_scale_ptr + ocb * flt_scale_step, src_scale,
+                            dst_scale_inv);
+                }
+            }
+        }
+    }
+    return TinyNN_SUCCESS;
+})";
+    writer << StringTemplate::StringTemplateArgs()
+                      .add("bias_str", bias_str)
+                      .render(body_temp);
+    return writer.str();
+}
+
+// vim: syntax=cpp.doxygen
@@ -0,0 +1,137 @@
+#include <sstream>
+#include <string>
+#include "GeneralIntrinsic/ConvKernel/ConvKernel.h"
+#include "Int8Common.h"
+#include "Utils/StringTemplate.h"
+#include "compiler/KernelGen/KernelGen.h"
+
+using namespace megcc;
+using namespace KernelGen;
+using namespace GeneralIntrinsic;
+
+bool DirectInt8Nchw44::IsAvailable(TContext* ctx) const {
+    bool param_value_ok =
+            ctx->getAttrUInt("kernel_h") <= 7 && ctx->getAttrUInt("kernel_w") <= 7 &&
+            ctx->getAttrUInt("stride_h") == ctx->getAttrUInt("stride_w") &&
+            (ctx->getAttrUInt("stride_h") == 1 || ctx->getAttrUInt("stride_h") == 2) &&
+            ctx->getAttrUInt("dilate_h") == 1 && ctx->getAttrUInt("dilate_w") == 1;
+    return param_value_ok && is_int8_nchw44_dense_ok(ctx);
+}
+
+std::string DirectInt8Nchw44::GetWorkspaceBody(TContext* ctx) const {
+    std::stringstream ss;
+    ss << GenCommonRet() << " " << GetWorkspaceSignature(ctx);
+    std::string workspace_temp = R"({
+        TINYNN_ASSERT(workspace);
+        const Layout in_layout = inputs[0]->layout;
+        const Layout weight_layout = inputs[1]->layout;
+        const uint32_t icpg_b = weight_layout.nr_dim == 7 ? weight_layout.dims[2]
+                                                          : weight_layout.dims[1];
+        const uint32_t ih2 = in_layout.dims[2] + 2 * ${pad_h};
+        const uint32_t iw2 = in_layout.dims[3] + 2 * ${pad_w};
+        //! the padded src of one group
+        *workspace = ${need_pad} ? (size_t)icpg_b * ih2 * iw2 * 4 : 0;
+        return TinyNN_SUCCESS;
+    })";
+    ss << StringTemplate::StringTemplateArgs(ctx)
+                    .add_ctx_int("pad_h")
+                    .add_ctx_int("pad_w")
+                    .add("need_pad", static_cast<int>(!ConvImpl::is_no_pad(ctx)))
+                    .render(workspace_temp);
+    return ss.str();
+}
+
+std::string DirectInt8Nchw44::GetKernelBody(TContext* ctx) const {
+    bool with_bias = ConvImpl::is_bias(ctx);
+    std::string bias_str = with_bias ? "inputs[2]->ptr" : "0";
+    std::string nonline_mode =
+            ctx->haveAttr("nonlineMode") ? ctx->getAttrStr("nonlineMode") : "IDENTITY";
+    std::stringstream writer;
+    writer << R"(
+        #include <string.h>
+        #include "gi_float.h"
+        #include "gi_int.h"
+    )";
+    writer << gen_int8_nchw44_oc4_kern(nonline_mode, with_bias);
+    writer << GenCommonRet() << " " << GetKernelSignature(ctx) << "{\n";
+    writer << gen_int8_nchw44_dense_param();
+    std::string body_temp = R"(
+    const int FH = ${kernel_h}, FW = ${kernel_w};
+    const int SH = ${stride_h}, SW = ${stride_w};
+    const int PH = ${pad_h}, PW = ${pad_w};
+    const int IH2 = IH + 2 * PH, IW2 = IW + 2 * PW;
+    const int ld_src_icb = IH2 * IW2 * pack_c_size;
+    const int ld_weight_ocb = ICPG_B * FH * FW * 16;
+    int tap_offset[${kernel_h} * ${kernel_w}];
+    for (int kh = 0; kh < FH; ++kh) {
+        for (int kw = 0; kw < FW; ++kw) {
+            tap_offset[kh * FW + kw] = (kh * IW2 + kw) * pack_c_size;
+        }
+    }
+
+    const int8_t* input_data = inputs[0]->ptr;
+    int8_t* output_data = outputs[0]->ptr;
+    const int8_t* weight_data = inputs[1]->ptr;
+    const int32_t* bias_data = ${bias_str};
+    int8_t* padding_src = workspace->ptr;
+    for (int n = 0; n < N; ++n) {
+        for (int g = 0; g < Group; ++g) {
+            const int8_t* src_ptr = input_data + n * src_batch_stride +
+                                    (size_t)g * ICPG_B * IH * IW * pack_c_size;
+            if (${need_pad}) {
+                memset(padding_src, 0, (size_t)ICPG_B * ld_src_icb);
+                for (int icb = 0; icb < ICPG_B; ++icb) {
+                    for (int ih = 0; ih < IH; ++ih) {
+                        memcpy(padding_src + icb * ld_src_icb +
+                                       ((ih + PH) * IW2 + PW) * pack_c_size,
+                               src_ptr + (icb * IH + ih) * IW * pack_c_size,
+                               IW * pack_c_size);
+                    }
+                }
+                src_ptr = padding_src;
+            }
+            for (int ocb = 0; ocb < OCPG_B; ++ocb) {
+                const int oc_block_idx = g * OCPG_B + ocb;
+                const int8_t* weight_ptr = weight_data + oc_block_idx * ld_weight_ocb;
+                const int32_t* bias_ptr = bias_data + oc_block_idx * pack_c_size;
+                const float* flt_scale_ptr = flt_scales + oc_block_idx * flt_scale_step;
+                int8_t* dst_ptr = output_data + n * dst_batch_stride +
+                                  (size_t)oc_block_idx * OH * OW * pack_c_size;
+                for (int oh = 0; oh < OH; ++oh) {
+                    const int8_t* src_row = src_ptr + oh * SH * IW2 * pack_c_size;
+                    int8_t* dst_row = dst_ptr + oh * OW * pack_c_size;
+                    int ow = 0;
+                    for (; ow + 8 <= OW; ow += 8) {
+                        int8_nchw44_oc4_ow8(src_row + ow * SW * pack_c_size, weight_ptr,
+                                            bias_ptr, dst_row + ow * pack_c_size,
+                                            ICPG_B, ld_src_icb, tap_offset, FH * FW,
+                                            SW * pack_c_size, flt_scale_ptr, src_scale,
+                                            dst_scale_inv);
+                    }
+                    if (ow < OW) {
+                        int8_nchw44_oc4_ow8_remain(
+                                src_row + ow * SW * pack_c_size, weight_ptr, bias_ptr,
+                                dst_row + ow * pack_c_size, ICPG_B, ld_src_icb,
+                                tap_offset, FH * FW, SW * pack_c_size, OW - ow,
+                                flt_scale_ptr, src_scale, dst_scale_inv);
+                    }
+                }
+            }
+        }
+    }
+    return TinyNN_SUCCESS;
+})";
+    writer << StringTemplate::StringTemplateArgs(ctx)
+                      .add_ctx_int("kernel_h")
+                      .add_ctx_int("kernel_w")
+                      .add_ctx_int("stride_h")
+                      .add_ctx_int("stride_w")
+                      .add_ctx_int("pad_h")
+                      .add_ctx_int("pad_w")
+                      .add("need_pad", static_cast<int>(!ConvImpl::is_no_pad(ctx)))
+                      .add("bias_str", bias_str)
+                      .render(body_temp);
+    return writer.str();
+}
+
+// vim: syntax=cpp.doxygen
@@ -0,0 +1,174 @@
+#include <sstream>
+#include <string>
+#include "GeneralIntrinsic/ConvKernel/ConvKernel.h"
+#include "Int8Common.h"
+#include "Utils/StringTemplate.h"
+#include "compiler/KernelGen/KernelGen.h"
+
+using namespace megcc;
+using namespace KernelGen;
+using namespace GeneralIntrinsic;
+
+namespace {
+//! the number of output pixels unfolded in one im2col step
+constexpr int IM2COL_BLOCK = 96;
+}  // namespace
+
+bool ConvIm2colInt8Nchw44::IsAvailable(TContext* ctx) const {
+    return is_int8_nchw44_dense_ok(ctx);
+}
+
+std::string ConvIm2colInt8Nchw44::GetWorkspaceBody(TContext* ctx) const {
+    std::stringstream ss;
+    ss << GenCommonRet() << " " << GetWorkspaceSignature(ctx);
+    std::string workspace_temp = R"({
+        TINYNN_ASSERT(workspace);
+        const Layout in_layout = inputs[0]->layout;
+        const Layout weight_layout = inputs[1]->layout;
+        const uint32_t icpg_b = weight_layout.nr_dim == 7 ? weight_layout.dims[2]
+                                                          : weight_layout.dims[1];
+        const uint32_t ih2 = in_layout.dims[2] + 2 * ${pad_h};
+        const uint32_t iw2 = in_layout.dims[3] + 2 * ${pad_w};
+        //! the padded src of one group and the unfolded src of one pixel block
+        size_t pad_size = ${need_pad} ? (size_t)icpg_b * ih2 * iw2 * 4 : 0;
+        size_t col_size = (size_t)icpg_b * ${kernel_h} * ${kernel_w} * ${block} * 4;
+        *workspace = pad_size + col_size;
+        return TinyNN_SUCCESS;
+    })";
+    ss << StringTemplate::StringTemplateArgs(ctx)
+                    .add_ctx_int("pad_h")
+                    .add_ctx_int("pad_w")
+                    .add_ctx_int("kernel_h")
+                    .add_ctx_int("kernel_w")
+                    .add("block", IM2COL_BLOCK)
+                    .add("need_pad", static_cast<int>(!ConvImpl::is_no_pad(ctx)))
+                    .render(workspace_temp);
+    return ss.str();
+}
+
+std::string ConvIm2colInt8Nchw44::GetKernelBody(TContext* ctx) const {
+    bool with_bias = ConvImpl::is_bias(ctx);
+    std::string bias_str = with_bias ? "inputs[2]->ptr" : "0";
+    std::string nonline_mode =
+            ctx->haveAttr("nonlineMode") ? ctx->getAttrStr("nonlineMode") : "IDENTITY";
+    std::stringstream writer;
+    writer << R"(
+        #include <string.h>
+        #include "gi_float.h"
+        #include "gi_int.h"
+    )";
+    writer << gen_int8_nchw44_oc4_kern(nonline_mode, with_bias);
+    writer << GenCommonRet() << " " << GetKernelSignature(ctx) << "{\n";
+    writer << gen_int8_nchw44_dense_param();
+    //! the src of a pixel block is unfolded to [icb][tap][block][4] so that the
+    //! dense kernel reads the pixels contiguously, which handles any kernel size,
+    //! stride and dilation
+    std::string body_temp = R"(
+    const int FH = ${kernel_h}, FW = ${kernel_w};
+    const int SH = ${stride_h}, SW = ${stride_w};
+    const int PH = ${pad_h}, PW = ${pad_w};
+    const int DH = ${dilate_h}, DW = ${dilate_w};
+    const int block = ${block};
+    const int nr_tap = FH * FW;
+    const int HW = OH * OW;
+    const int IH2 = IH + 2 * PH, IW2 = IW + 2 * PW;
+    const int ld_pad_icb = IH2 * IW2 * pack_c_size;
+    const int ld_col_icb = nr_tap * block * pack_c_size;
+    const int ld_weight_ocb = ICPG_B * nr_tap * 16;
+    int tap_offset[${kernel_h} * ${kernel_w}];
+    for (int tap = 0; tap < nr_tap; ++tap) {
+        tap_offset[tap] = tap * block * pack_c_size;
+    }
+
+    const int8_t* input_data = inputs[0]->ptr;
+    int8_t* output_data = outputs[0]->ptr;
+    const int8_t* weight_data = inputs[1]->ptr;
+    const int32_t* bias_data = ${bias_str};
+    int8_t* padding_src = workspace->ptr;
+    int8_t* col_src = padding_src + (${need_pad} ? (size_t)ICPG_B * ld_pad_icb : 0);
+    for (int n = 0; n < N; ++n) {
+        for (int g = 0; g < Group; ++g) {
+            const int8_t* src_ptr = input_data + n * src_batch_stride +
+                                    (size_t)g * ICPG_B * IH * IW * pack_c_size;
+            if (${need_pad}) {
+                memset(padding_src, 0, (size_t)ICPG_B * ld_pad_icb);
+                for (int icb = 0; icb < ICPG_B; ++icb) {
+                    for (int ih = 0; ih < IH; ++ih) {
+                        memcpy(padding_src + icb * ld_pad_icb +
+                                       ((ih + PH) * IW2 + PW) * pack_c_size,
+                               src_ptr + (icb * IH + ih) * IW * pack_c_size,
+                               IW * pack_c_size);
+                    }
+                }
+                src_ptr = padding_src;
+            }
+            int8_t* dst_ptr = output_data + n * dst_batch_stride +
+                              (size_t)g * OCPG_B * HW * pack_c_size;
+            const int8_t* weight_ptr = weight_data + (size_t)g * OCPG_B * ld_weight_ocb;
+            const int32_t* bias_ptr = bias_data + g * OCPG_B * pack_c_size;
+            const float* flt_scale_ptr = flt_scales + g * OCPG_B * flt_scale_step;
+            for (int pos = 0; pos < HW; pos += block) {
+                const int nr_pix = HW - pos < block ? HW - pos : block;
+                for (int icb = 0; icb < ICPG_B; ++icb) {
+                    for (int kh = 0; kh < FH; ++kh) {
+                        for (int kw = 0; kw < FW; ++kw) {
+                            const int8_t* sptr = src_ptr + icb * ld_pad_icb +
+                                                 (kh * DH * IW2 + kw * DW) * pack_c_size;
+                            int8_t* col = col_src + icb * ld_col_icb +
+                                          tap_offset[kh * FW + kw];
+                            int oh = pos / OW, ow = pos % OW;
+                            for (int p = 0; p < nr_pix; ++p) {
+                                memcpy(col + p * pack_c_size,
+                                       sptr + (oh * SH * IW2 + ow * SW) * pack_c_size,
+                                       pack_c_size);
+                                if (++ow == OW) {
+                                    ow = 0;
+                                    ++oh;
+                                }
+                            }
+                        }
+                    }
+                }
+                for (int ocb = 0; ocb < OCPG_B; ++ocb) {
+                    int8_t* dst_pos = dst_ptr + (ocb * HW + pos) * pack_c_size;
+                    int p = 0;
+                    for (; p + 8 <= nr_pix; p += 8) {
+                        int8_nchw44_oc4_ow8(col_src + p * pack_c_size,
+                                            weight_ptr + ocb * ld_weight_ocb,
+                                            bias_ptr + ocb * pack_c_size,
+                                            dst_pos + p * pack_c_size, ICPG_B, ld_col_icb,
+                                            tap_offset, nr_tap, pack_c_size,
+                                            flt_scale_ptr + ocb * flt_scale_step,
+                                            src_scale, dst_scale_inv);
+                    }
+                    if (p < nr_pix) {
+                        int8_nchw44_oc4_ow8_remain(
+                                col_src + p * pack_c_size, weight_ptr + ocb * ld_weight_ocb,
+                                bias_ptr + ocb * pack_c_size, dst_pos + p * pack_c_size,
+                                ICPG_B, ld_col_icb, tap_offset, nr_tap, pack_c_size,
+                                nr_pix - p, flt_scale_ptr + ocb * flt_scale_step,
+                                src_scale, dst_scale_inv);
+                    }
+                }
+            }
+        }
+    }
+    return TinyNN_SUCCESS;
+})";
+    writer << StringTemplate::StringTemplateArgs(ctx)
+                      .add_ctx_int("kernel_h")
+                      .add_ctx_int("kernel_w")
+                      .add_ctx_int("stride_h")
+                      .add_ctx_int("stride_w")
+                      .add_ctx_int("pad_h")
+                      .add_ctx_int("pad_w")
+                      .add_ctx_int("dilate_h")
+                      .add_ctx_int("dilate_w")
+                      .add("block", IM2COL_BLOCK)
+                      .add("need_pad", static_cast<int>(!ConvImpl::is_no_pad(ctx)))
+                      .add("bias_str", bias_str)
+                      .render(body_temp);
+    return writer.str();
+}
+
+// vim: syntax=cpp.doxygen
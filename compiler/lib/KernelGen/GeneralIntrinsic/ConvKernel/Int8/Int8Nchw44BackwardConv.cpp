@@ -0,0 +1,251 @@
+#include <sstream>
+#include <string>
+#include "Common/ConvBackData.h"
+#include "GeneralIntrinsic/ConvKernel/ConvKernel.h"
+#include "Int8Common.h"
+#include "Utils/StringTemplate.h"
+#include "compiler/KernelGen/KernelGen.h"
+
+using namespace megcc;
+using namespace KernelGen;
+using namespace GeneralIntrinsic;
+
+namespace {
+//! the col element is the int32 sum of the taps, which is requantized once
+//! when the output pixel is written
+std::string gen_deconv_prelude() {
+    auto act = create_activation_gener_instrinsic("IDENTITY");
+    std::string store =
+            act->GenIntrinsicQuantStore("res", "dst", "scale", "dst_scale");
+    return R"(
+#include "gi_float.h"
+#include "gi_int.h"
+typedef int32_t deconv_acc_t;
+typedef int8_t deconv_dst_t;
+#define DECONV_PACK 4
+#define DECONV_VEC_LOAD(ptr) GiLoadInt32(ptr)
+#define DECONV_VEC_STORE(ptr, v) GiStoreInt32(ptr, v)
+#define DECONV_VEC_ADD(a, b) GiAddInt32(a, b)
+#define DECONV_VEC_ZERO() GiBroadcastInt32(0)
+#define DECONV_STORE_PARAM , const GI_FLOAT32_t scale, const float dst_scale
+#define DECONV_STORE_ARG , scale, dst_scale
+static inline void deconv_store_pixel(
+        int8_t* dst, const int32_t* acc DECONV_STORE_PARAM) {
+    GI_INT32_t res = GiLoadInt32(acc);
+    )" + store + R"(
+}
+)";
+}
+
+//! gen the mk4 gemm kernels `int8_deconv_gemm_n8` and
+//! `int8_deconv_gemm_n8_remain`, which compute the int32 col of 4 output
+//! channels at one tap for at most 8 input pixels. The packed weight block is
+//! [4(k)][4(oc)] and the diff of pixel p in channel block kb is at
+//! `diff + kb * ld_diff_kb + p * 4`
+std::string gen_deconv_gemm() {
+    std::string kern_temp = R"(
+static inline void ${func_name}(const int8_t* weight, const int8_t* diff,
+        int32_t* col, const int nr_kb, const size_t ld_diff_kb${remain_param}) {
+    GI_INT32_t zero = GiBroadcastInt32(0);
+    GI_INT32_FIXLEN_t c[8];
+    for (int p = 0; p < 8; ++p) {
+        c[p] = GiInt32Type2FixLenType(zero);
+    }
+    for (int kb = 0; kb < nr_kb; ++kb) {
+        GI_INT8_t w = GiLoadInt8(weight);
+        GI_INT16_t w01 = GiMoveLowLongInt8(w);
+        GI_INT16_t w23 = GiMoveHighLongInt8(w);
+        const int8_t* s = diff + kb * ld_diff_kb;
+        for (int p = 0; p < ${nr_pix}; ++p) {
+            GI_INT32_t acc = GiFixLenType2GiInt32Type(c[p]);
+            acc = GiMultiplyAddInt16LongLow(acc, GiBroadcastInt16(s[0]), w01);
+            acc = GiMultiplyAddInt16LongHigh(acc, GiBroadcastInt16(s[1]), w01);
+            acc = GiMultiplyAddInt16LongLow(acc, GiBroadcastInt16(s[2]), w23);
+            acc = GiMultiplyAddInt16LongHigh(acc, GiBroadcastInt16(s[3]), w23);
+            c[p] = GiInt32Type2FixLenType(acc);
+            s += 4;
+        }
+        weight += 16;
+    }
+    for (int p = 0; p < ${nr_pix}; ++p) {
+        GiStoreInt32(col + p * 4, GiFixLenType2GiInt32Type(c[p]));
+    }
+}
+)";
+    std::stringstream ss;
+    ss << StringTemplate::StringTemplateArgs()
+                    .add("func_name", "int8_deconv_gemm_n8")
+                    .add("remain_param", "")
+                    .add("nr_pix", 8)
+                    .render(kern_temp);
+    ss << StringTemplate::StringTemplateArgs()
+                    .add("func_name", "int8_deconv_gemm_n8_remain")
+                    .add("remain_param", ", const int nr_pix")
+                    .add("nr_pix", "nr_pix")
+                    .render(kern_temp);
+    return ss.str();
+}
+}  // namespace
+
+bool Int8Nchw44Backward::IsAvailable(TContext* ctx) const {
+    bool param_value_ok = ctx->getAttrUInt("dilate_h") == 1 &&
+                          ctx->getAttrUInt("dilate_w") == 1;
+    auto flt_shape = ctx->getAttrOprand("operand:0").shape;
+    bool param_mode_ok =
+            ((ctx->getAttrStr("sparse") == "DENSE" && flt_shape.size() == 6) ||
+             (ctx->getAttrStr("sparse") == "GROUP" && flt_shape.size() == 7)) &&
+            ctx->getAttrStr("format") == "NCHW44" &&
+            ctx->getAttrStr("mode") == "CROSS_CORRELATION";
+    bool noline_ok = !ctx->haveAttr("nonlineMode");
+    bool type_ok = ctx->getAttrInt("nr_operands") == 3 &&
+                   ConvImpl::is_qint8_conv_dtype(ctx) &&
+                   !ctx->getAttrOprand("operand:0").per_channel_scale;
+    return param_value_ok && param_mode_ok && type_ok && noline_ok;
+}
+
+std::string Int8Nchw44Backward::GetKernelSymbol(TContext* ctx) const {
+    CC_ASSERT(ctx);
+    return ConvBackDataGemmHelper::gen_symbol(ctx, "GI_");
+}
+
+//! the filter [K/4, OC/4, FH, FW, 4(oc), 4(k)] of every group is packed into
+//! the mk4 A [OC/4, FH, FW, K/4, 4(k), 4(oc)], K is the channel of diff
+std::string Int8Nchw44Backward::GetInitBody(TContext* ctx) const {
+    std::stringstream writer;
+    writer << GenCommonRet() << " " << GetInitSignature(ctx);
+    uint32_t nr_out_weight = 1;
+    std::string common_def = R"(
+    Tensor* in_weights = inputs[0]; //! The weight is the first input in BackwardConv.
+    const uint32_t nr_dim = in_weights->layout.nr_dim;
+    const uint32_t group = nr_dim == 7 ? in_weights->layout.dims[0] : 1;
+    const uint32_t kb_idx = nr_dim == 7 ? 1 : 0;
+    const int nr_kb = in_weights->layout.dims[kb_idx];
+    const int nr_ocb = in_weights->layout.dims[kb_idx + 1];
+    const int nr_tap = in_weights->layout.dims[kb_idx + 2] * in_weights->layout.dims[kb_idx + 3];
+    const size_t group_size = (size_t)nr_kb * nr_ocb * nr_tap * 16;
+                      )";
+    std::string fill_weight_attr = R"(
+    out_weights->layout.nr_dim = 2;
+    out_weights->layout.dims[0] = group;
+    out_weights->layout.dims[1] = group_size;
+    out_weights->layout.stride[0] = out_weights->layout.dims[1];
+    out_weights->layout.stride[1] = 1;
+    out_weights->dtype.type_enum = TinyNN_QINT8;
+    out_weights->name = in_weights->name;
+    out_weights->dtype.param.scale = in_weights->dtype.param.scale;
+    out_weights->dtype.param.scales = in_weights->dtype.param.scales;
+    out_weights->dtype.param.nr_scale = in_weights->dtype.param.nr_scale;
+                      )";
+    std::string fill_weight_transform = R"(
+    for (int g = 0; g < group; ++g) {
+        const int8_t* inptr = (int8_t*)(in_weights->ptr) + g * group_size;
+        int8_t* outptr = (int8_t*)(out_weights->ptr) + g * group_size;
+        for (int ocb = 0; ocb < nr_ocb; ++ocb) {
+            for (int tap = 0; tap < nr_tap; ++tap) {
+                for (int kb = 0; kb < nr_kb; ++kb) {
+                    const int8_t* w = inptr + ((size_t)(kb * nr_ocb + ocb) * nr_tap + tap) * 16;
+                    for (int k = 0; k < 4; ++k) {
+                        for (int oc = 0; oc < 4; ++oc) {
+                            *outptr++ = w[oc * 4 + k];
+                        }
+                    }
+                }
+            }
+        }
+    })";
+    writer << StringTemplate::render_init_body(
+            nr_out_weight, fill_weight_attr, fill_weight_transform, common_def);
+    return writer.str();
+}
+
+//! the int32 col buffer is needed even by the 1x1 conv for the requantization
+std::string Int8Nchw44Backward::GetWorkspaceBody(TContext* ctx) const {
+    std::stringstream ss;
+    ss << GenCommonRet() << " " << GetWorkspaceSignature(ctx);
+    ss << StringTemplate::StringTemplateArgs(ctx)
+                    .add_ctx_int("kernel_h")
+                    .add_ctx_int("kernel_w")
+                    .render(R"({
+        TINYNN_ASSERT(workspace);
+        const Layout in_layout = inputs[1]->layout;
+        const Layout weight_layout = inputs[0]->layout;
+        const uint32_t ocb = weight_layout.nr_dim == 7 ? weight_layout.dims[2] : weight_layout.dims[1];
+        const uint32_t hw = in_layout.dims[2] * in_layout.dims[3];
+        *workspace = (size_t)ocb * ${kernel_h} * ${kernel_w} * hw * 4 * sizeof(int32_t);
+        return TinyNN_SUCCESS;
+    })");
+    return ss.str();
+}
+
+std::string Int8Nchw44Backward::GetKernelBody(TContext* ctx) const {
+    std::stringstream writer;
+    writer << gen_deconv_prelude();
+    writer << gen_deconv_gemm();
+    writer << ConvBackDataGemmHelper::gen_mk_col2im(ctx);
+    writer << GenCommonRet() << " " << GetKernelSignature(ctx);
+    //! diff in nchw44 is already the mk4 B [K/4, in_h * in_w, 4(k)], the input
+    //! pixel blocks are the outer loop to keep the diff block in cache
+    writer << StringTemplate::StringTemplateArgs(ctx)
+                      .add_ctx_int("kernel_h")
+                      .add_ctx_int("kernel_w")
+                      .render(R"({
+    const int8_t* input_data = inputs[1]->ptr;
+    int8_t* output_data = outputs[0]->ptr;
+
+    Layout weight_layout = inputs[0]->layout;
+    Layout in_layout = inputs[1]->layout;
+    Layout out_layout = outputs[0]->layout;
+
+    const int group = weight_layout.dims[0];
+
+    const int in_n = in_layout.dims[0];
+    const int in_cb = in_layout.dims[1] / group;
+    const int in_h = in_layout.dims[2];
+    const int in_w = in_layout.dims[3];
+    const size_t N = in_h * in_w;
+
+    const int out_cb = out_layout.dims[1] / group;
+    const int out_h = out_layout.dims[2];
+    const int out_w = out_layout.dims[3];
+
+    const int nr_mb = out_cb * ${kernel_h} * ${kernel_w};
+    const size_t ld_weight_mb = in_cb * 16;
+    const size_t ld_diff_kb = N * 4;
+
+    const float src_scale = inputs[1]->dtype.param.scale;
+    const float flt_scale = inputs[0]->dtype.param.scale;
+    const float dst_scale_inv = 1.f / outputs[0]->dtype.param.scale;
+    const GI_FLOAT32_t scale = GiBroadcastFloat32(src_scale * flt_scale);
+
+    int32_t* col = workspace->ptr;
+    for (int n_idx = 0; n_idx < in_n; ++n_idx) {
+        const int8_t* weight_data = inputs[0]->ptr;
+        for (int g = 0; g < group; ++g) {
+            size_t pos = 0;
+            for (; pos + 8 <= N; pos += 8) {
+                for (int mb = 0; mb < nr_mb; ++mb) {
+                    int8_deconv_gemm_n8(weight_data + mb * ld_weight_mb,
+                                        input_data + pos * 4,
+                                        col + (mb * N + pos) * 4, in_cb, ld_diff_kb);
+                }
+            }
+            if (pos < N) {
+                for (int mb = 0; mb < nr_mb; ++mb) {
+                    int8_deconv_gemm_n8_remain(
+                            weight_data + mb * ld_weight_mb, input_data + pos * 4,
+                            col + (mb * N + pos) * 4, in_cb, ld_diff_kb, N - pos);
+                }
+            }
+            deconv_col2im_mk(col, output_data, out_cb, out_h, out_w, in_h, in_w, scale,
+                             dst_scale_inv);
+            weight_data += weight_layout.stride[0];
+            input_data += in_cb * N * 4;
+            output_data += out_cb * out_h * out_w * 4;
+        }
+    }
+    return TinyNN_SUCCESS;
+})");
+    return writer.str();
+}
+
+// vim: syntax=cpp.doxygen
@@ -335,6 +335,9 @@ bool ChannelWiseFloat16Mk8::IsAvailable(TContext* ctx) const {
     bool param_mode_ok = ctx->getAttrStr("sparse") == "GROUP" &&
                          ctx->getAttrStr("format") == "NCHW88" &&
                          ctx->getAttrStr("mode") == "CROSS_CORRELATION";
+    //! the fp16 kernels accumulate in fp16
+    param_mode_ok = param_mode_ok && (!ctx->haveAttr("compute_mode") ||
+                                      ctx->getAttrStr("compute_mode") == "DEFAULT");
     bool noline_ok = !ctx->haveAttr("nonlineMode") ||
                      ctx->getAttrStr("nonlineMode") == "IDENTITY" ||
                      ctx->getAttrStr("nonlineMode") == "RELU" ||
@@ -76,6 +76,10 @@ bool Conv1x1Float16MK8::IsAvailable(TContext* ctx) const {
     bool param_mode_ok = ctx->getAttrStr("sparse") == "DENSE" &&
                          ctx->getAttrStr("format") == "NCHW88" &&
                          ctx->getAttrStr("mode") == "CROSS_CORRELATION";
+    //! the inner matmul accumulates in fp32 with FLOAT32 compute mode
+    param_mode_ok = param_mode_ok && (!ctx->haveAttr("compute_mode") ||
+                                      ctx->getAttrStr("compute_mode") == "DEFAULT" ||
+                                      ctx->getAttrStr("compute_mode") == "FLOAT32");
     bool noline_ok = !ctx->haveAttr("nonlineMode") ||
                      ctx->getAttrStr("nonlineMode") == "IDENTITY" ||
                      ctx->getAttrStr("nonlineMode") == "RELU" ||
@@ -103,6 +107,10 @@ std::string Conv1x1Float16MK8::GetKernelSymbol(TContext* ctx) const {
             ctx->getAttrStr("nonlineMode") != "IDENTITY") {
             extra_ss << "_" << ctx->getAttrStr("nonlineMode");
         }
+        if (ctx->haveAttr("compute_mode") &&
+            ctx->getAttrStr("compute_mode") == "FLOAT32") {
+            extra_ss << "_comp_f32";
+        }
         std::string name_temp =
                 "GI_kernel_conv2d_conv1x1_fp16_${format}_${kernel_h}x${kernel_w}_${"
                 "sparse}_p${pad_h}x${pad_w}_s${stride_h}x${stride_w}_d${"
@@ -193,6 +201,9 @@ std::shared_ptr<TContext> Conv1x1Float16MK8::GetInnerCtx(TContext* ctx) const {
     inner_ctx->setAttr("transposeB", false);
     inner_ctx->setAttr("format", "MK8");
     inner_ctx->setAttr("dtype", "f16");
+    if (ctx->haveAttr("compute_mode")) {
+        inner_ctx->setAttr("compute_mode", CCAttr(ctx->getAttrStr("compute_mode")));
+    }
     return inner_ctx;
 }
 
@@ -18,6 +18,9 @@ bool ConvFloat16NCHWNCHW88::IsAvailable(TContext* ctx) const {
     bool param_mode_ok = ctx->getAttrStr("sparse") == "DENSE" &&
                          ctx->getAttrStr("format") == "NCHW88" &&
                          ctx->getAttrStr("mode") == "CROSS_CORRELATION";
+    //! the fp16 kernels accumulate in fp16
+    param_mode_ok = param_mode_ok && (!ctx->haveAttr("compute_mode") ||
+                                      ctx->getAttrStr("compute_mode") == "DEFAULT");
     bool noline_ok = !ctx->haveAttr("nonlineMode") ||
                      ctx->getAttrStr("nonlineMode") == "IDENTITY" ||
                      ctx->getAttrStr("nonlineMode") == "RELU" ||
@@ -74,6 +74,10 @@ std::string ConvIm2colFloat16M8N8::GetKernelSymbol(TContext* ctx) const {
             ctx->getAttrStr("nonlineMode") != "IDENTITY") {
             extra_ss << "_" << ctx->getAttrStr("nonlineMode");
         }
+        if (ctx->haveAttr("compute_mode") &&
+            ctx->getAttrStr("compute_mode") == "FLOAT32") {
+            extra_ss << "_comp_f32";
+        }
         extra_ss << ctx->getAttrOprand("operand:0").dtype;
         std::string name_temp =
                 "GI_kernel_conv2d_im2colm8n8_fp16_${kernel_h}x${kernel_w}_${"
@@ -106,6 +110,10 @@ bool ConvIm2colFloat16M8N8::IsAvailable(TContext* ctx) const {
             ctx->getAttrUInt("dilate_h") == 1 && ctx->getAttrUInt("dilate_w") == 1;
     bool param_mode_ok =
             (fmt == "NCHW88") && ctx->getAttrStr("mode") == "CROSS_CORRELATION";
+    //! the inner matmul accumulates in fp32 with FLOAT32 compute mode
+    param_mode_ok = param_mode_ok && (!ctx->haveAttr("compute_mode") ||
+                                      ctx->getAttrStr("compute_mode") == "DEFAULT" ||
+                                      ctx->getAttrStr("compute_mode") == "FLOAT32");
     bool noline_ok = !ctx->haveAttr("nonlineMode") ||
                      ctx->getAttrStr("nonlineMode") == "IDENTITY" ||
                      ctx->getAttrStr("nonlineMode") == "RELU" ||
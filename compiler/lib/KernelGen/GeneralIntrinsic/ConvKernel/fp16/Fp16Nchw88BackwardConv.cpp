@@ -0,0 +1,210 @@
+#include <sstream>
+#include <string>
+#include "Common/ConvBackData.h"
+#include "GeneralIntrinsic/ConvKernel/ConvKernel.h"
+#include "GeneralIntrinsic/InternalKernel/InternalKernel.h"
+#include "Utils/StringTemplate.h"
+#include "compiler/KernelGen/KernelGen.h"
+
+using namespace megcc;
+using namespace KernelGen;
+using namespace GeneralIntrinsic;
+
+namespace {
+std::string gen_deconv_prelude() {
+    return R"(
+#include "gi_float16.h"
+typedef gi_float16_t deconv_acc_t;
+typedef gi_float16_t deconv_dst_t;
+#define DECONV_PACK 8
+#define DECONV_VEC_LOAD(ptr) GiLoadFloat16(ptr)
+#define DECONV_VEC_STORE(ptr, v) GiStoreFloat16(ptr, v)
+#define DECONV_VEC_ADD(a, b) GiAddFloat16(a, b)
+#define DECONV_VEC_ZERO() GiBroadcastFloat16(0.0)
+#define DECONV_STORE_PARAM
+#define DECONV_STORE_ARG
+static inline void deconv_store_pixel(gi_float16_t* dst, const gi_float16_t* acc) {
+    GiStoreFloat16(dst, GiLoadFloat16(acc));
+}
+)";
+}
+
+std::shared_ptr<TContext> gen_inner_gemm_ctx() {
+    auto inner_ctx = std::make_shared<CodeGenContext>();
+    inner_ctx->setAttr("with_bias", false);
+    inner_ctx->setAttr("transposeA", false);
+    inner_ctx->setAttr("transposeB", false);
+    inner_ctx->setAttr("format", "MK8");
+    inner_ctx->setAttr("dtype", "f16");
+    return inner_ctx;
+}
+}  // namespace
+
+bool Float16Nchw88Backward::IsAvailable(TContext* ctx) const {
+    bool param_value_ok = ctx->getAttrUInt("dilate_h") == 1 &&
+                          ctx->getAttrUInt("dilate_w") == 1;
+    auto flt_shape = ctx->getAttrOprand("operand:0").shape;
+    bool param_mode_ok =
+            ((ctx->getAttrStr("sparse") == "DENSE" && flt_shape.size() == 6) ||
+             (ctx->getAttrStr("sparse") == "GROUP" && flt_shape.size() == 7)) &&
+            ctx->getAttrStr("format") == "NCHW88" &&
+            ctx->getAttrStr("mode") == "CROSS_CORRELATION";
+    //! the mk8 gemm and the col2im accumulate in fp16
+    param_mode_ok = param_mode_ok && (!ctx->haveAttr("compute_mode") ||
+                                      ctx->getAttrStr("compute_mode") == "DEFAULT");
+    bool noline_ok = !ctx->haveAttr("nonlineMode");
+    bool type_ok = ctx->getAttrInt("nr_operands") >= 3 &&
+                   ctx->getAttrOprand("operand:0").dtype == "f16" &&
+                   ctx->getAttrOprand("operand:1").dtype == "f16" &&
+                   ctx->getAttrOprand("operand:2").dtype == "f16";
+    return param_value_ok && param_mode_ok && type_ok && noline_ok &&
+           !ConvImpl::is_bias(ctx);
+}
+
+std::string Float16Nchw88Backward::GetKernelSymbol(TContext* ctx) const {
+    CC_ASSERT(ctx);
+    return ConvBackDataGemmHelper::gen_symbol(ctx, "GI_");
+}
+
+//! the filter [K/8, OC/8, FH, FW, 8(oc), 8(k)] of every group is packed into
+//! the mk8 A [OC/8, FH, FW, K/8, 8(k), 8(oc)], K is the channel of diff, so the
+//! gemm output is the col buffer [OC/8, FH, FW, in_h * in_w, 8(oc)]
+std::string Float16Nchw88Backward::GetInitBody(TContext* ctx) const {
+    std::stringstream writer;
+    writer << R"(
+#include "gi_float16.h"
+)";
+    writer << GenCommonRet() << " " << GetInitSignature(ctx);
+    uint32_t nr_out_weight = 1;
+    std::string common_def = R"(
+    Tensor* in_weights = inputs[0]; //! The weight is the first input in BackwardConv.
+    const uint32_t nr_dim = in_weights->layout.nr_dim;
+    const uint32_t group = nr_dim == 7 ? in_weights->layout.dims[0] : 1;
+    const uint32_t kb_idx = nr_dim == 7 ? 1 : 0;
+    const int nr_kb = in_weights->layout.dims[kb_idx];
+    const int nr_ocb = in_weights->layout.dims[kb_idx + 1];
+    const int nr_tap = in_weights->layout.dims[kb_idx + 2] * in_weights->layout.dims[kb_idx + 3];
+    const size_t group_size = (size_t)nr_kb * nr_ocb * nr_tap * 64;
+                      )";
+    std::string fill_weight_attr = R"(
+    out_weights->layout.nr_dim = 2;
+    out_weights->layout.dims[0] = group;
+    out_weights->layout.dims[1] = group_size;
+    out_weights->layout.stride[0] = out_weights->layout.dims[1];
+    out_weights->layout.stride[1] = 1;
+    out_weights->dtype.type_enum=TinyNN_FLOAT16;
+    out_weights->name = in_weights->name;
+                      )";
+    std::string fill_weight_transform = R"(
+    for (int g = 0; g < group; ++g) {
+        const gi_float16_t* inptr = (gi_float16_t*)(in_weights->ptr) + g * group_size;
+        gi_float16_t* outptr = (gi_float16_t*)(out_weights->ptr) + g * group_size;
+        for (int ocb = 0; ocb < nr_ocb; ++ocb) {
+            for (int tap = 0; tap < nr_tap; ++tap) {
+                for (int kb = 0; kb < nr_kb; ++kb) {
+                    const gi_float16_t* w = inptr + ((size_t)(kb * nr_ocb + ocb) * nr_tap + tap) * 64;
+                    for (int k = 0; k < 8; ++k) {
+                        for (int oc = 0; oc < 8; ++oc) {
+                            *outptr++ = w[oc * 8 + k];
+                        }
+                    }
+                }
+            }
+        }
+    })";
+    writer << StringTemplate::render_init_body(
+            nr_out_weight, fill_weight_attr, fill_weight_transform, common_def);
+    return writer.str();
+}
+
+std::string Float16Nchw88Backward::GetWorkspaceBody(TContext* ctx) const {
+    std::stringstream ss;
+    ss << GenCommonRet() << " " << GetWorkspaceSignature(ctx);
+    ss << StringTemplate::StringTemplateArgs(ctx)
+                    .add_ctx_int("kernel_h")
+                    .add_ctx_int("kernel_w")
+                    .add("need_col", ConvBackDataGemmHelper::need_col_buffer(ctx))
+                    .render(R"({
+        TINYNN_ASSERT(workspace);
+        const Layout in_layout = inputs[1]->layout;
+        const Layout weight_layout = inputs[0]->layout;
+        const uint32_t ocb = weight_layout.nr_dim == 7 ? weight_layout.dims[2] : weight_layout.dims[1];
+        const uint32_t hw = in_layout.dims[2] * in_layout.dims[3];
+        *workspace = 0;
+        if (${need_col}) {
+            *workspace = (size_t)ocb * ${kernel_h} * ${kernel_w} * hw * 8 * sizeof(gi_float16_t);
+        }
+        return TinyNN_SUCCESS;
+    })");
+    return ss.str();
+}
+
+std::vector<KernelObj> Float16Nchw88Backward::GetDependInternalSymbol(
+        TContext* ctx) const {
+    auto inner_ctx = gen_inner_gemm_ctx();
+    return {
+            {m_inner_gemm.GetKernelSymbol(inner_ctx.get()),
+             m_inner_gemm.GetKernelBody(inner_ctx.get()),
+             m_inner_gemm.GetBodyGuardBegin(inner_ctx.get()),
+             m_inner_gemm.GetBodyGuardEnd(inner_ctx.get())}};
+}
+
+std::string Float16Nchw88Backward::GetKernelBody(TContext* ctx) const {
+    std::stringstream writer;
+    auto inner_ctx = gen_inner_gemm_ctx();
+    writer << m_inner_gemm.GetKernelSignature(inner_ctx.get()) << ";\n";
+    writer << gen_deconv_prelude();
+    writer << ConvBackDataGemmHelper::gen_mk_col2im(ctx);
+    writer << GenCommonRet() << " " << GetKernelSignature(ctx);
+    //! diff in nchw88 is already the mk8 B [K/8, in_h * in_w, 8(k)]
+    writer << StringTemplate::StringTemplateArgs(ctx)
+                      .add_ctx_int("kernel_h")
+                      .add_ctx_int("kernel_w")
+                      .add("need_col", ConvBackDataGemmHelper::need_col_buffer(ctx))
+                      .add("gemm", m_inner_gemm.GetKernelSymbol(inner_ctx.get()))
+                      .render(R"({
+    gi_float16_t* input_data = inputs[1]->ptr;
+    gi_float16_t* output_data = outputs[0]->ptr;
+
+    Layout weight_layout = inputs[0]->layout;
+    Layout in_layout = inputs[1]->layout;
+    Layout out_layout = outputs[0]->layout;
+
+    const int group = weight_layout.dims[0];
+
+    const int in_n = in_layout.dims[0];
+    const int in_cb = in_layout.dims[1] / group;
+    const int in_h = in_layout.dims[2];
+    const int in_w = in_layout.dims[3];
+    const size_t N = in_h * in_w;
+
+    const int out_cb = out_layout.dims[1] / group;
+    const int out_h = out_layout.dims[2];
+    const int out_w = out_layout.dims[3];
+
+    const size_t M = out_cb * ${kernel_h} * ${kernel_w} * 8;
+    const size_t LDA = in_cb * 64;
+    const size_t LDB = N * 8;
+    const size_t LDC = N * 8;
+
+    const int need_col = ${need_col};
+    gi_float16_t* col = workspace->ptr;
+    for (int n_idx = 0; n_idx < in_n; ++n_idx) {
+        const gi_float16_t* weight_data = inputs[0]->ptr;
+        for (int g = 0; g < group; ++g) {
+            gi_float16_t* out_ptr = need_col ? col : output_data;
+            ${gemm}(weight_data, LDA, input_data, LDB, out_ptr, LDC, M, N, in_cb * 8);
+            if (need_col) {
+                deconv_col2im_mk(col, output_data, out_cb, out_h, out_w, in_h, in_w);
+            }
+            weight_data += weight_layout.stride[0];
+            input_data += in_cb * N * 8;
+            output_data += out_cb * out_h * out_w * 8;
+        }
+    }
+    return TinyNN_SUCCESS;
+})");
+    return writer.str();
+}
+
+// vim: syntax=cpp.doxygen
@@ -16,9 +16,10 @@ bool ElemwiseKernel::IsAvailable(TContext* ctx) const {
     }
     auto mode = ctx->getAttrStr("mode");
     bool mode_ok = mode == "RELU" || mode == "EXP" || mode == "SIGMOID" ||
-                   mode == "H_SWISH" || mode == "ADD" || mode == "SUB" ||
-                   mode == "MUL" || mode == "TRUE_DIV" || mode == "FUSE_ADD_RELU" ||
-                   mode == "FUSE_MUL_ADD3" || mode == "MAX" || mode == "MIN";
+                   mode == "H_SWISH" || mode == "LOG" || mode == "ADD" ||
+                   mode == "SUB" || mode == "MUL" || mode == "TRUE_DIV" ||
+                   mode == "FUSE_ADD_RELU" || mode == "FUSE_MUL_ADD3" || mode == "MAX" ||
+                   mode == "MIN";
     if (mode == "FUSE_MUL_ADD3") {
         auto bcast_type = ElemwiseGenTernary::GetBcastType(
                 ctx->getAttrOprand("operand:0"), ctx->getAttrOprand("operand:1"),
@@ -31,6 +32,8 @@ bool ElemwiseKernel::IsAvailable(TContext* ctx) const {
         is_fp16_ok &=
                 (ctx->getAttrOprand("operand:" + std::to_string(i)).dtype == "f16");
     }
+    //! LOG is only generated for float32
+    is_fp16_ok &= mode != "LOG";
     bool usable = (type_ok || is_fp16_ok) && mode_ok && ok_input;
     return usable;
 }
@@ -59,6 +62,10 @@ std::string ElemwiseKernel::GetKernelSymbol(TContext* context) const {
         CC_ABORT << "not support quarter elemwise kernel.\n";
     }
     ss << "_" << SymbolHelper::gen_io_str(context);
+    auto mode = context->getAttrStr("mode");
+    if (mode == "EXP" || mode == "SIGMOID" || mode == "LOG") {
+        ss << GIMathHelper(context).FastMathSymbol();
+    }
     return ss.str();
 }
 
@@ -76,7 +83,7 @@ std::string ElemwiseKernel::GetKernelBody(TContext* ctx) const {
     auto src_specifier = Utils::cvt_dtype_specifier(operands[0].dtype);
     auto dst_specifier =
             Utils::cvt_dtype_specifier(operands[operands.size() - 1].dtype);
-    GIMathHelper gi_math;
+    GIMathHelper gi_math(ctx);
     CC_ASSERT(ElemwiseImpl) << "ElemwiseHelper Create error!\n";
     switch (dtype) {
         case Utils::DtypeEnum::float32:
@@ -127,6 +134,12 @@ std::string ElemwiseKernel::GetKernelBody(TContext* ctx) const {
             writer << gi_math.GiSigmoidPsFloat16() << "\n";
         }
     }
+    if ("LOG" == mode) {
+        writer << R"(
+#include "gi_int.h"
+            )";
+        writer << gi_math.GiLogPsFloat32() << "\n";
+    }
     if ("H_SWISH" == mode) {
         writer << gi_math.GiHSwishFloat32() << "\n";
     }
@@ -25,6 +25,7 @@ std::shared_ptr<ElemwiseGenBase> ElemwiseHelperFunc::CreateGenHelper(
             CASE_DISPATCH("EXP", ElemwiseGenUnaryExp);
             CASE_DISPATCH("SIGMOID", ElemwiseGenUnarySigmoid);
             CASE_DISPATCH("H_SWISH", ElemwiseGenUnaryHswish);
+            CASE_DISPATCH("LOG", ElemwiseGenUnaryLog);
         } else if (operands[0].dtype == "f16") {
             CASE_DISPATCH_ARG("RELU", ElemwiseGenUnaryRelu, "f16", "f16");
             CASE_DISPATCH_ARG("EXP", ElemwiseGenUnaryExp, "f16", "f16");
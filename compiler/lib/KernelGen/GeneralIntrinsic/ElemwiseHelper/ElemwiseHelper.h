@@ -137,6 +137,7 @@ DEFINE_UNARY_OP(ElemwiseGenUnaryRelu)
 DEFINE_UNARY_OP(ElemwiseGenUnaryExp)
 DEFINE_UNARY_OP(ElemwiseGenUnarySigmoid)
 DEFINE_UNARY_OP(ElemwiseGenUnaryHswish)
+DEFINE_UNARY_OP(ElemwiseGenUnaryLog)
 #undef DEFINE_UNARY_OP
 
 /************************************Binary***********************************/
@@ -449,4 +449,38 @@ std::string ElemwiseGenUnaryHswish::GenKernelNaiveUnroll(
     return writer.str();
 }
 
+//! Log
+std::string ElemwiseGenUnaryLog::GenInlineName() const {
+    return "ElemwiseGenUnaryLog";
+}
+std::string ElemwiseGenUnaryLog::GenKernelSimdInit(std::vector<std::string>) const {
+    return " ";
+}
+
+std::string ElemwiseGenUnaryLog::GenKernelSimdUnroll(
+        std::vector<std::string> strs) const {
+    int unroll = std::stoi(strs[0]);
+    std::stringstream writer;
+    CC_ASSERT(Utils::is_float_dtype(m_dst_dtype, 32));
+    for (int i = 0; i < unroll; i++) {
+        writer << "\n GI_FLOAT32_t " << strs[2 * i + 2] << " = GiLogPsFloat32("
+               << strs[2 * i + 1] << ");";
+    }
+    return writer.str();
+}
+
+std::string ElemwiseGenUnaryLog::GenKernelNaiveUnroll(
+        std::vector<std::string> strs) const {
+    int unroll = std::stoi(strs[0]);
+    auto input_ptr = strs[1];
+    auto output_ptr = strs[2];
+    std::stringstream writer;
+    CC_ASSERT(Utils::is_float_dtype(m_dst_dtype, 32));
+    for (int i = 0; i < unroll; i++) {
+        writer << "\n(" << output_ptr << ")[" << i << "] =  logf((" << input_ptr
+               << ")[" << i << "]);";
+    }
+    return writer.str();
+}
+
 // vim: syntax=cpp.doxygen
@@ -0,0 +1,79 @@
+#include "ElemwiseMultiType.h"
+#include "Common/ElemwiseMultiType.h"
+#include "GIMathHelper.h"
+#include "Utils/SymbolHelper.h"
+#include "Utils/Utils.h"
+#include "compiler/Common/Logger.h"
+
+using namespace megcc;
+using namespace KernelGen;
+using namespace GeneralIntrinsic;
+
+bool ElemwiseMultiTypeKernel::IsAvailable(TContext* context) const {
+    return ElemwiseMultiTypeHelper::is_available(context) &&
+           !ElemwiseMultiTypeHelper::get_mode(context).simd.empty();
+}
+
+//! kernel gen
+std::string ElemwiseMultiTypeKernel::GetKernelSymbol(TContext* context) const {
+    std::stringstream ss;
+    ss << "GI_kernel_elementwise_multitype_" << context->getAttrStr("mode") << "_"
+       << SymbolHelper::gen_io_str(context);
+    if (ElemwiseMultiTypeHelper::get_mode(context).need_math) {
+        ss << GIMathHelper(context).FastMathSymbol();
+    }
+    return ss.str();
+}
+
+std::string ElemwiseMultiTypeKernel::GetKernelBody(TContext* context) const {
+    std::stringstream writer;
+    writer << R"(
+        #include <math.h>
+        #include "gi_float.h"
+        #include "gi_int.h"
+        #include "tensor_util.h"
+
+        #define V_DUP GiBroadcastFloat32
+        #define V_ADD GiAddFloat32
+        #define V_SUB GiSubtractFloat32
+        #define V_MUL GiMultiplyFloat32
+        #define V_DIV GiDivideFloat32
+        #define V_MAX GiMaximumFloat32
+        #define V_MIN GiMinimumFloat32
+        #define V_NEG GiNegFloat32
+        #define V_ABS GiAbsFloat32
+        #define V_EXP GiExpPsFloat32
+        #define V_SIGMOID GiSigmoidPsFloat32
+        #define V4_GET GiGetSubVectorFloat32V4
+        #define V4_SET GiSetSubVectorFloat32V4
+
+        static inline GI_FLOAT32_V4_t dequant_16(const int8_t* ptr, GI_FLOAT32_t vscale) {
+            GI_INT8_t v = GiLoadInt8(ptr);
+            GI_INT16_t v_low = GiMoveLowLongInt8(v);
+            GI_INT16_t v_high = GiMoveHighLongInt8(v);
+            GI_FLOAT32_V4_t ret;
+            GiSetSubVectorFloat32V4(ret, 0, GiMultiplyFloat32(GiCastToFloat32(GiMoveLowLongInt16(v_low)), vscale));
+            GiSetSubVectorFloat32V4(ret, 1, GiMultiplyFloat32(GiCastToFloat32(GiMoveHighLongInt16(v_low)), vscale));
+            GiSetSubVectorFloat32V4(ret, 2, GiMultiplyFloat32(GiCastToFloat32(GiMoveLowLongInt16(v_high)), vscale));
+            GiSetSubVectorFloat32V4(ret, 3, GiMultiplyFloat32(GiCastToFloat32(GiMoveHighLongInt16(v_high)), vscale));
+            return ret;
+        }
+
+        static inline void requant_16(int8_t* ptr, GI_FLOAT32_V4_t v) {
+            GiStoreInt8(ptr, GiCvtFromFloat32V4ToInt8(v));
+        }
+    )";
+    if (ElemwiseMultiTypeHelper::get_mode(context).need_math) {
+        GIMathHelper gi_math(context);
+        writer << gi_math.GiExpPsFloat32() << "\n";
+        writer << gi_math.GiSigmoidPsFloat32() << "\n";
+    }
+    writer << ElemwiseMultiTypeHelper::GenOpFunc(context, "GI_FLOAT32_t");
+    writer << GenCommonRet() << " " << GetKernelSignature(context) << "{\n";
+    writer << ElemwiseMultiTypeHelper::GenBody(
+            context, "GI_FLOAT32_t", "GI_FLOAT32_V4_t");
+    writer << "}\n";
+    return writer.str();
+}
+
+// vim: syntax=cpp.doxygen
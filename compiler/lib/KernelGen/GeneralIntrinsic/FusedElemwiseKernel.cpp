@@ -515,15 +515,18 @@ std::string FusedElmwiseKernel::GetKernelBody(TContext* context) const {
                 #include "gi_int.h" 
                 )";
 
-    GIMathHelper gi_math;
+    GIMathHelper gi_math(context);
     bool exp = false;
     bool sigmoid = false;
     bool hswith = false;
+    bool log = false;
     for (size_t id = 0; id < op_modes.size(); id++) {
         auto modes = op_modes[id];
         size_t nr_str = modes.size();
         auto mode = modes[nr_str - 2];
-        if ((mode == "EXP" || mode == "SIGMOID") && !exp) {
+        //! the fast-math sigmoid is computed by exp
+        bool fast_sigmoid = "FUSE_ADD_SIGMOID" == mode && gi_math.IsFastMath();
+        if ((mode == "EXP" || mode == "SIGMOID" || fast_sigmoid) && !exp) {
             writer << gi_math.GiExpPsFloat32() << "\n";
             exp = true;
         }
@@ -531,6 +534,10 @@ std::string FusedElmwiseKernel::GetKernelBody(TContext* context) const {
             writer << gi_math.GiSigmoidPsFloat32() << "\n";
             sigmoid = true;
         }
+        if ("LOG" == mode && !log) {
+            writer << gi_math.GiLogPsFloat32() << "\n";
+            log = true;
+        }
         if ("H_SWISH" == mode && !hswith) {
             writer << gi_math.GiHSwishFloat32() << "\n";
             writer << gen_dep_func() << "\n";
@@ -688,7 +695,7 @@ bool FusedElmwiseKernel::IsAvailable(TContext* context) const {
         size_t modes_size = modes.size();
         auto mode = modes[modes_size - 2];
         bool mode_ok_unary = mode == "RELU" || mode == "SIGMOID" || mode == "EXP" ||
-                             mode == "H_SWISH" || mode == "NEGATE";
+                             mode == "H_SWISH" || mode == "NEGATE" || mode == "LOG";
         bool mode_ok_binary = mode == "ADD" || mode == "SUB" || mode == "MUL" ||
                               mode == "MAX" || mode == "MIN" || mode == "TRUE_DIV" ||
                               mode == "FUSE_ADD_RELU" || mode == "FUSE_ADD_SIGMOID";
@@ -705,12 +712,15 @@ std::string FusedElmwiseKernel::GetKernelSymbol(TContext* context) const {
     std::stringstream ss;
     ss << "kernel_gi_fused_elementwise";
     auto mode_size = context->getAttrInt("modes:size");
+    bool transcendental = false;
     for (int i = 0; i < mode_size; i++) {
         auto modes = Utils::split_string(
                 context->getAttrStr("modes:" + std::to_string(i)), ',');
         size_t modes_size = modes.size();
         auto mode = modes[modes_size - 2];
         ss << "_" << mode;
+        transcendental |= mode == "EXP" || mode == "SIGMOID" ||
+                          mode == "FUSE_ADD_SIGMOID" || mode == "LOG";
     }
     for (size_t i = 0; i < nr_operands; i++) {
         auto operand = context->getAttrOprand("operand:" + std::to_string(i));
@@ -718,6 +728,9 @@ std::string FusedElmwiseKernel::GetKernelSymbol(TContext* context) const {
         ss << "_tensortype" << tensor_type;
     }
     ss << "_" << SymbolHelper::gen_io_str(context);
+    if (transcendental) {
+        ss << GIMathHelper(context).FastMathSymbol();
+    }
     return ss.str();
 }
 
@@ -8,8 +8,37 @@ namespace GeneralIntrinsic {
 class GIMathHelper {
 public:
     GIMathHelper(){};
+    //! when fast-math is enabled in ctx, exp, log and sigmoid are generated with the
+    //! cheapest variant whose max error is within the ulp budget
+    GIMathHelper(TContext* ctx) : m_max_ulp(Utils::get_fast_math_ulp(ctx)){};
+
+    //! max ulp error of the fast-math variants, measured on all floats in
+    //! [-87, 88] (exp, sigmoid) and [FLT_MIN, FLT_MAX] (log) against double precision
+    static constexpr int EXP_DEG5_ULP = 4;
+    static constexpr int EXP_DEG4_ULP = 80;
+    static constexpr int LOG_DEG8_ULP = 6;
+    static constexpr int LOG_DEG7_ULP = 32;
+    static constexpr int SIGMOID_ULP = 4;
+
+    bool IsFastMath() const { return m_max_ulp >= EXP_DEG5_ULP; }
+
+    //! kernels with different precision should not share the same symbol
+    std::string FastMathSymbol() const {
+        return IsFastMath() ? "_fastmath_ulp" + std::to_string(m_max_ulp) : "";
+    }
 
     std::string GiLogPsFloat32() {
+        if (m_max_ulp >= LOG_DEG7_ULP) {
+            return GiFastLogPsFloat32(
+                    {1.1781896650791168e-1f, -1.8407191336154938e-1f,
+                     2.0442187786102295e-1f, -2.4943833053112030e-1f,
+                     3.3320862054824830e-1f});
+        } else if (m_max_ulp >= LOG_DEG8_ULP) {
+            return GiFastLogPsFloat32(
+                    {-1.0191730409860611e-1f, 1.6024382412433624e-1f,
+                     -1.7137128114700317e-1f, 1.9924503564834595e-1f,
+                     -2.4983267486095428e-1f, 3.3334246277809143e-1f});
+        }
         return R"(
 
 #define c_inv_mant_mask ~0x7f800000u
@@ -103,6 +132,15 @@ static GI_FLOAT32_t GiLogPsFloat32(GI_FLOAT32_t x) {
         )";
     }
     std::string GiExpPsFloat32() {
+        if (m_max_ulp >= EXP_DEG4_ULP) {
+            return GiFastExpPsFloat32(
+                    {4.1277747601270676e-2f, 1.6753514111042023e-1f,
+                     5.0005114078521729e-1f});
+        } else if (m_max_ulp >= EXP_DEG5_ULP) {
+            return GiFastExpPsFloat32(
+                    {8.3125252276659012e-3f, 4.1890114545822144e-2f,
+                     1.6667114198207855e-1f, 4.9999231100082397e-1f});
+        }
         return R"(
             #define c_exp_hi 88.3762626647949f
 #define c_exp_lo -88.3762626647949f
@@ -309,7 +347,21 @@ static GI_FLOAT32_t GiTanPsFloat32(GI_FLOAT32_t x) {
 }
         )";
     }
+    //! the fast-math variant is 1 / (1 + exp(-x)) with the exp above, the divide is
+    //! replaced by the reciprocal estimate refined with two newton steps. Like the
+    //! precise one it saturates, the results below FLT_MIN are flushed to 0
     std::string GiSigmoidPsFloat32() {
+        if (m_max_ulp >= SIGMOID_ULP + ExpUlp()) {
+            return R"(
+static GI_FLOAT32_t GiSigmoidPsFloat32(GI_FLOAT32_t src) {
+    GI_FLOAT32_t denom = GiAddFloat32(GiBroadcastFloat32(1.f), GiExpPsFloat32(GiNegFloat32(src)));
+    GI_FLOAT32_t recp = GiRecpeFloat32(denom);
+    recp = GiMultiplyFloat32(GiRecpeSFloat32(denom, recp), recp);
+    recp = GiMultiplyFloat32(GiRecpeSFloat32(denom, recp), recp);
+    GI_UINT32_t underflow = GiLessThanFloat32(src, GiBroadcastFloat32(-87.3365479f));
+    return GiBSLFloat32(underflow, GiBroadcastFloat32(0.f), recp);
+})";
+        }
         return R"(
     static const struct {
     float lower_range;
@@ -535,6 +587,105 @@ static GI_FLOAT16_t GiMultiplyAddFloat16(GI_FLOAT16_t x, GI_FLOAT16_t y, GI_FLOA
 #endif
         )";
     }
+
+private:
+    //! error of the exp variant in use, the cephes one is within 2 ulp
+    int ExpUlp() const {
+        if (m_max_ulp >= EXP_DEG4_ULP) {
+            return EXP_DEG4_ULP;
+        } else if (m_max_ulp >= EXP_DEG5_ULP) {
+            return EXP_DEG5_ULP;
+        }
+        return 2;
+    }
+
+    //! coeffs are from the highest degree, exp(r) = 1 + r + r^2 * P(r) with the minimax
+    //! P for the relative error on [-ln2/2, ln2/2]
+    std::string GiFastExpPsFloat32(const std::vector<float>& coeffs) {
+        std::stringstream ss;
+        ss << R"(
+/* exp() with a degree )"
+           << coeffs.size() + 1 << R"( polynomial, inputs are clamped to the normal range */
+static GI_FLOAT32_t GiExpPsFloat32(GI_FLOAT32_t x) {
+    x = GiMinimumFloat32(x, GiBroadcastFloat32(88.3762512f));
+    x = GiMaximumFloat32(x, GiBroadcastFloat32(-87.3365479f));
+
+    /* express exp(x) as exp(r + n*log(2)), |r| <= log(2)/2 */
+    GI_INT32_t n = GiRoundAsInt32(GiMultiplyFloat32(x, GiBroadcastFloat32(1.44269504f)));
+    GI_FLOAT32_t fn = GiCastToFloat32(n);
+    GI_FLOAT32_t r = GiMultiplyAddFloat32(x, fn, GiBroadcastFloat32(-0.693359375f));
+    r = GiMultiplyAddFloat32(r, fn, GiBroadcastFloat32(2.12194440e-4f));
+
+    GI_FLOAT32_t y = GiBroadcastFloat32()"
+           << to_literal(coeffs[0]) << ");";
+        for (size_t i = 1; i < coeffs.size(); ++i) {
+            ss << "\n    y = GiMultiplyAddFloat32(GiBroadcastFloat32("
+               << to_literal(coeffs[i]) << "), y, r);";
+        }
+        ss << R"(
+    y = GiMultiplyAddFloat32(r, y, GiMultiplyFloat32(r, r));
+    y = GiAddFloat32(y, GiBroadcastFloat32(1.f));
+
+    /* build 2^n */
+    GI_INT32_t mm = GiShiftLeft23Int32(GiAddInt32(n, GiBroadcastInt32(0x7f)));
+    return GiMultiplyFloat32(y, GiReintInt32ToFloat32(mm));
+})";
+        return ss.str();
+    }
+
+    //! coeffs are from the highest degree, log(1 + x) = x - x^2/2 + x^3 * P(x) with the
+    //! minimax P for the relative error on [sqrt(1/2) - 1, sqrt(2) - 1]
+    std::string GiFastLogPsFloat32(const std::vector<float>& coeffs) {
+        std::stringstream ss;
+        ss << R"(
+/* natural logarithm with a degree )"
+           << coeffs.size() + 2 << R"( polynomial, return NaN for x <= 0 */
+static GI_FLOAT32_t GiLogPsFloat32(GI_FLOAT32_t x) {
+    GI_FLOAT32_t one = GiBroadcastFloat32(1);
+
+    x = GiMaximumFloat32(x, GiBroadcastFloat32(0));
+    GI_UINT32_t invalid_mask = GiLessThanEqFloat32(x, GiBroadcastFloat32(0));
+
+    /* split x into the exponent e and the mantissa in [0.5, 1) */
+    GI_INT32_t ux = GiReinterpretAsInt32(x);
+    GI_INT32_t emm0 = GiShiftRight23Int32(ux);
+    ux = GiAndInt32(ux, GiBroadcastInt32(~0x7f800000u));
+    ux = GiOrInt32(ux, GiReinterpretAsInt32(GiBroadcastFloat32(0.5f)));
+    x = GiReintInt32ToFloat32(ux);
+    emm0 = GiSubtractInt32(emm0, GiBroadcastInt32(0x7f));
+    GI_FLOAT32_t e = GiAddFloat32(GiCastToFloat32(emm0), one);
+
+    /* move the mantissa to [sqrt(1/2), sqrt(2)) and subtract 1 */
+    GI_UINT32_t mask = GiLessThanFloat32(x, GiBroadcastFloat32(0.707106781f));
+    GI_FLOAT32_t tmp = GiAndFloat32(x, GiReintUint32ToFloat32(mask));
+    x = GiSubtractFloat32(x, one);
+    e = GiSubtractFloat32(e, GiAndFloat32(one, GiReintUint32ToFloat32(mask)));
+    x = GiAddFloat32(x, tmp);
+
+    GI_FLOAT32_t z = GiMultiplyFloat32(x, x);
+    GI_FLOAT32_t y = GiBroadcastFloat32()"
+           << to_literal(coeffs[0]) << ");";
+        for (size_t i = 1; i < coeffs.size(); ++i) {
+            ss << "\n    y = GiMultiplyAddFloat32(GiBroadcastFloat32("
+               << to_literal(coeffs[i]) << "), y, x);";
+        }
+        ss << R"(
+    y = GiMultiplyFloat32(GiMultiplyFloat32(y, x), z);
+
+    y = GiMultiplyAddFloat32(y, e, GiBroadcastFloat32(-2.12194440e-4f));
+    y = GiMultiplySubFloat32(y, z, GiBroadcastFloat32(0.5f));
+    x = GiAddFloat32(x, y);
+    x = GiMultiplyAddFloat32(x, e, GiBroadcastFloat32(0.693359375f));
+    return GiOrFloat32(x, GiReintUint32ToFloat32(invalid_mask));
+})";
+        return ss.str();
+    }
+
+    static std::string to_literal(float val) {
+        return Utils::ssprintf("%.9ef", val);
+    }
+
+    int m_max_ulp = 0;
 };
 }  // namespace GeneralIntrinsic
 }  // namespace KernelGen
@@ -0,0 +1,242 @@
+#pragma once
+#include <string>
+#include "Utils/StringTemplate.h"
+#include "Utils/Utils.h"
+namespace megcc {
+namespace KernelGen {
+namespace GeneralIntrinsic {
+
+/*!
+ * the simd row and column filters vecRowFilter and vecColumnFilter of the
+ * SepFilterHelper engine, they take any kernel and need castOp for the tail
+ * of uint8. The fixed point uint8 path widens the pixels to int16 and
+ * accumulates u8 * kernel in int32 in the row pass, the column pass rounds
+ * the int32 sums with (x + (1 << 15)) >> 16, which is exactly castOp. The
+ * float uint8 path keeps float rows and rounds with saturation at the end.
+ */
+class GISepFilterHelper {
+public:
+    static std::string gen_filters(
+            const std::string& src_specifier, const std::string& filter_dtype) {
+        if (src_specifier == "float") {
+            return gen_f32_filters();
+        } else if (filter_dtype == "int") {
+            return gen_u8_fixed_point_filters();
+        }
+        return gen_u8_float_filters();
+    }
+
+private:
+    static std::string gen_f32_filters() {
+        return R"(
+        static void vecRowFilter(RowFilter* self, const uint8_t* src, uint8_t* dst, int width, int cn) {
+            const float* kx = (const float*)self->m_kernel->data;
+            const int ksize = self->ksize;
+            float* D = (float*)dst;
+            int i = 0;
+            width *= cn;
+            for (; i + 8 <= width; i += 8) {
+                const float* S = (const float*)src + i;
+                GI_FLOAT32_t s0 = GiMultiplyScalerFloat32(GiLoadFloat32(S), kx[0]);
+                GI_FLOAT32_t s1 = GiMultiplyScalerFloat32(GiLoadFloat32(S + 4), kx[0]);
+                for (int k = 1; k < ksize; ++k) {
+                    S += cn;
+                    s0 = GiMultiplyAddScalarFloat32(s0, GiLoadFloat32(S), kx[k]);
+                    s1 = GiMultiplyAddScalarFloat32(s1, GiLoadFloat32(S + 4), kx[k]);
+                }
+                GiStoreFloat32(D + i, s0);
+                GiStoreFloat32(D + i + 4, s1);
+            }
+            for (; i < width; ++i) {
+                const float* S = (const float*)src + i;
+                float s0 = kx[0] * S[0];
+                for (int k = 1; k < ksize; ++k) {
+                    S += cn;
+                    s0 += kx[k] * S[0];
+                }
+                D[i] = s0;
+            }
+        }
+
+        static void vecColumnFilter(ColFilter* self, const uint8_t** src, uint8_t* dst, int dststep, int count, int width) {
+            const float* ky = (const float*)self->m_kernel->data;
+            const int ksize = self->ksize;
+            for (; count > 0; count--, dst += dststep, src++) {
+                float* D = (float*)dst;
+                int i = 0;
+                for (; i + 8 <= width; i += 8) {
+                    const float* S = (const float*)src[0] + i;
+                    GI_FLOAT32_t s0 = GiMultiplyScalerFloat32(GiLoadFloat32(S), ky[0]);
+                    GI_FLOAT32_t s1 = GiMultiplyScalerFloat32(GiLoadFloat32(S + 4), ky[0]);
+                    for (int k = 1; k < ksize; ++k) {
+                        S = (const float*)src[k] + i;
+                        s0 = GiMultiplyAddScalarFloat32(s0, GiLoadFloat32(S), ky[k]);
+                        s1 = GiMultiplyAddScalarFloat32(s1, GiLoadFloat32(S + 4), ky[k]);
+                    }
+                    GiStoreFloat32(D + i, s0);
+                    GiStoreFloat32(D + i + 4, s1);
+                }
+                for (; i < width; ++i) {
+                    float s0 = ky[0] * ((const float*)src[0])[i];
+                    for (int k = 1; k < ksize; ++k)
+                        s0 += ky[k] * ((const float*)src[k])[i];
+                    D[i] = s0;
+                }
+            }
+        }
+    )";
+    }
+
+    static std::string gen_u8_fixed_point_filters() {
+        return R"(
+        static void vecRowFilter(RowFilter* self, const uint8_t* src, uint8_t* dst, int width, int cn) {
+            const int* kx = (const int*)self->m_kernel->data;
+            const int ksize = self->ksize;
+            int* D = (int*)dst;
+            int i = 0;
+            width *= cn;
+            for (; i + 16 <= width; i += 16) {
+                const uint8_t* S = src + i;
+                GI_INT32_t s0 = GiBroadcastInt32(0), s1 = s0, s2 = s0, s3 = s0;
+                for (int k = 0; k < ksize; ++k, S += cn) {
+                    GI_UINT8_t v = GiLoadUint8(S);
+                    GI_INT16_t lo = GiCvtUint8toInt16Low(v);
+                    GI_INT16_t hi = GiCvtUint8toInt16High(v);
+                    GI_INT16_t f = GiBroadcastInt16((int16_t)kx[k]);
+                    s0 = GiMultiplyAddInt16LongLow(s0, lo, f);
+                    s1 = GiMultiplyAddInt16LongHigh(s1, lo, f);
+                    s2 = GiMultiplyAddInt16LongLow(s2, hi, f);
+                    s3 = GiMultiplyAddInt16LongHigh(s3, hi, f);
+                }
+                GiStoreInt32(D + i, s0);
+                GiStoreInt32(D + i + 4, s1);
+                GiStoreInt32(D + i + 8, s2);
+                GiStoreInt32(D + i + 12, s3);
+            }
+            for (; i < width; ++i) {
+                const uint8_t* S = src + i;
+                int s0 = kx[0] * S[0];
+                for (int k = 1; k < ksize; ++k) {
+                    S += cn;
+                    s0 += kx[k] * S[0];
+                }
+                D[i] = s0;
+            }
+        }
+
+        static void vecColumnFilter(ColFilter* self, const uint8_t** src, uint8_t* dst, int dststep, int count, int width) {
+            const int* ky = (const int*)self->m_kernel->data;
+            const int ksize = self->ksize;
+            GI_INT32_t delta = GiBroadcastInt32(1 << 15);
+            for (; count > 0; count--, dst += dststep, src++) {
+                uint8_t* D = dst;
+                int i = 0;
+                for (; i + 16 <= width; i += 16) {
+                    GI_INT32_t s0 = delta, s1 = delta, s2 = delta, s3 = delta;
+                    for (int k = 0; k < ksize; ++k) {
+                        const int* S = (const int*)src[k] + i;
+                        GI_INT32_t f = GiBroadcastInt32(ky[k]);
+                        s0 = GiMultiplyAddInt32(s0, GiLoadInt32(S), f);
+                        s1 = GiMultiplyAddInt32(s1, GiLoadInt32(S + 4), f);
+                        s2 = GiMultiplyAddInt32(s2, GiLoadInt32(S + 8), f);
+                        s3 = GiMultiplyAddInt32(s3, GiLoadInt32(S + 12), f);
+                    }
+                    s0 = GiShiftRightInt32(s0, 16);
+                    s1 = GiShiftRightInt32(s1, 16);
+                    s2 = GiShiftRightInt32(s2, 16);
+                    s3 = GiShiftRightInt32(s3, 16);
+                    GiStoreUint8(D + i, GiCvtFromInt32V4ToUint8(s0, s1, s2, s3));
+                }
+                for (; i < width; ++i) {
+                    int s0 = ky[0] * ((const int*)src[0])[i];
+                    for (int k = 1; k < ksize; ++k)
+                        s0 += ky[k] * ((const int*)src[k])[i];
+                    D[i] = castOp(s0);
+                }
+            }
+        }
+    )";
+    }
+
+    static std::string gen_u8_float_filters() {
+        return R"(
+        static void vecRowFilter(RowFilter* self, const uint8_t* src, uint8_t* dst, int width, int cn) {
+            const float* kx = (const float*)self->m_kernel->data;
+            const int ksize = self->ksize;
+            float* D = (float*)dst;
+            int i = 0;
+            width *= cn;
+            for (; i + 16 <= width; i += 16) {
+                const uint8_t* S = src + i;
+                GI_FLOAT32_t s0 = GiBroadcastFloat32(0.f), s1 = s0, s2 = s0, s3 = s0;
+                for (int k = 0; k < ksize; ++k, S += cn) {
+                    GI_UINT8_t v = GiLoadUint8(S);
+                    GI_INT16_t lo = GiCvtUint8toInt16Low(v);
+                    GI_INT16_t hi = GiCvtUint8toInt16High(v);
+                    s0 = GiMultiplyAddScalarFloat32(
+                            s0, GiCastToFloat32(GiMoveLowLongInt16(lo)), kx[k]);
+                    s1 = GiMultiplyAddScalarFloat32(
+                            s1, GiCastToFloat32(GiMoveHighLongInt16(lo)), kx[k]);
+                    s2 = GiMultiplyAddScalarFloat32(
+                            s2, GiCastToFloat32(GiMoveLowLongInt16(hi)), kx[k]);
+                    s3 = GiMultiplyAddScalarFloat32(
+                            s3, GiCastToFloat32(GiMoveHighLongInt16(hi)), kx[k]);
+                }
+                GiStoreFloat32(D + i, s0);
+                GiStoreFloat32(D + i + 4, s1);
+                GiStoreFloat32(D + i + 8, s2);
+                GiStoreFloat32(D + i + 12, s3);
+            }
+            for (; i < width; ++i) {
+                const uint8_t* S = src + i;
+                float s0 = kx[0] * S[0];
+                for (int k = 1; k < ksize; ++k) {
+                    S += cn;
+                    s0 += kx[k] * S[0];
+                }
+                D[i] = s0;
+            }
+        }
+
+        static void vecColumnFilter(ColFilter* self, const uint8_t** src, uint8_t* dst, int dststep, int count, int width) {
+            const float* ky = (const float*)self->m_kernel->data;
+            const int ksize = self->ksize;
+            GI_FLOAT32_t vmin = GiBroadcastFloat32(0.f);
+            GI_FLOAT32_t vmax = GiBroadcastFloat32(255.f);
+            for (; count > 0; count--, dst += dststep, src++) {
+                uint8_t* D = dst;
+                int i = 0;
+                for (; i + 16 <= width; i += 16) {
+                    GI_FLOAT32_t s[4];
+                    const float* S = (const float*)src[0] + i;
+                    for (int j = 0; j < 4; ++j)
+                        s[j] = GiMultiplyScalerFloat32(GiLoadFloat32(S + j * 4), ky[0]);
+                    for (int k = 1; k < ksize; ++k) {
+                        S = (const float*)src[k] + i;
+                        for (int j = 0; j < 4; ++j)
+                            s[j] = GiMultiplyAddScalarFloat32(
+                                    s[j], GiLoadFloat32(S + j * 4), ky[k]);
+                    }
+                    GI_INT32_t r[4];
+                    for (int j = 0; j < 4; ++j)
+                        r[j] = GiRoundAsInt32(
+                                GiMinimumFloat32(GiMaximumFloat32(s[j], vmin), vmax));
+                    GiStoreUint8(D + i, GiCvtFromInt32V4ToUint8(r[0], r[1], r[2], r[3]));
+                }
+                for (; i < width; ++i) {
+                    float s0 = ky[0] * ((const float*)src[0])[i];
+                    for (int k = 1; k < ksize; ++k)
+                        s0 += ky[k] * ((const float*)src[k])[i];
+                    D[i] = castOp(s0);
+                }
+            }
+        }
+    )";
+    }
+};
+
+}  // namespace GeneralIntrinsic
+}  // namespace KernelGen
+}  // namespace megcc
+
+// vim: syntax=cpp.doxygen
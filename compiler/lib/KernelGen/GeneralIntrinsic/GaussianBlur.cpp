@@ -0,0 +1,135 @@
+#include <sstream>
+
+#include "Common/SepFilter.h"
+#include "GISepFilterHelper.h"
+#include "GaussianBlur.h"
+#include "Utils/StringTemplate.h"
+#include "Utils/SymbolHelper.h"
+#include "Utils/Utils.h"
+
+using namespace megcc;
+using namespace KernelGen;
+using namespace GeneralIntrinsic;
+
+namespace {
+bool is_gaussian_blur_available(TContext* context) {
+    auto src_dtype = context->getAttrOprand("operand:0").dtype;
+    bool dtype_ok = src_dtype == "ui8" || src_dtype == "f32";
+    std::string mode = context->getAttrStr("border_mode");
+    return dtype_ok && SepFilterHelper::is_border_mode_ok(mode);
+}
+
+std::string gen_filters(const std::string& bmode, const std::string& src_specifier) {
+    auto filter_dtype = SepFilterHelper::get_filter_dtype(src_specifier, true);
+    std::stringstream writer;
+    writer << SepFilterHelper::gen_border_interpolate(bmode);
+    writer << SepFilterHelper::gen_create_gaussian_kernels();
+    writer << SepFilterHelper::gen_filter_engine(bmode, src_specifier, filter_dtype);
+    writer << SepFilterHelper::gen_cast_op(src_specifier, filter_dtype);
+    writer << GISepFilterHelper::gen_filters(src_specifier, filter_dtype);
+    return writer.str();
+}
+
+std::string gen_engine_setup() {
+    return SepFilterHelper::gen_engine_setup(
+            "&kernel_col", "&kernel_row", "vecRowFilter", "vecColumnFilter");
+}
+}  // namespace
+
+bool GaussianBlurKernel::IsAvailable(TContext* context) const {
+    return is_gaussian_blur_available(context);
+}
+
+std::string GaussianBlurKernel::GetKernelSymbol(TContext* context) const {
+    return "GI_kernel_" + SepFilterHelper::gen_gaussian_blur_symbol(context);
+}
+
+bool GaussianBlurKernel::IsCVAvailable(TContext* context) const {
+    return is_gaussian_blur_available(context);
+}
+
+//! kernel gen
+std::string GaussianBlurKernel::GetCVKernelSubSymbol(TContext* context) const {
+    std::stringstream ss;
+    auto src_dtype = context->getAttrOprand("operand:0").dtype;
+    ss << "tinycv_gaussian_blur_" << SepFilterHelper::get_lower_border_mode(context)
+       << "_" << src_dtype;
+    return ss.str();
+}
+
+std::string GaussianBlurKernel::GetCVKernelSignature(TContext* context) const {
+    return GetCVKernelSymbol(context) +
+           "(const TinyMat* src, const TinyMat* dst, int kernel_h, int kernel_w, "
+           "double sigma1, double sigma2)";
+}
+
+std::string GaussianBlurKernel::GetKernelBody(TContext* context) const {
+    std::string bmode = context->getAttrStr("border_mode");
+    uint32_t kh = context->getAttrUInt("kernel_height");
+    uint32_t kw = context->getAttrUInt("kernel_width");
+    float sigma_x = context->getAttrFloat("sigma_x");
+    float sigma_y = context->getAttrFloat("sigma_y");
+    auto src_specifier =
+            Utils::cvt_dtype_specifier(context->getAttrOprand("operand:0").dtype);
+    auto filter_dtype = SepFilterHelper::get_filter_dtype(src_specifier, true);
+    std::stringstream writer;
+    writer << R"(
+        #include <math.h>
+        #include <stdlib.h>
+        #include <string.h>
+        #include "gi_float.h"
+        #include "gi_int.h"
+        #include "utils.h"
+
+        typedef struct TinyMat {
+            size_t rows;
+            size_t cols;
+            size_t channels;
+            void* data;
+        } TinyMat;
+    )";
+    writer << gen_filters(bmode, src_specifier);
+    writer << GenCommonRet() << " " << GetKernelSignature(context) << "{";
+    writer << SepFilterHelper::gen_gaussian_kernel_init(
+            filter_dtype, std::to_string(kh), std::to_string(kw),
+            std::to_string(sigma_x), std::to_string(sigma_y));
+    writer << gen_engine_setup();
+    writer << SepFilterHelper::gen_engine_proceed_nn(src_specifier);
+    writer << SepFilterHelper::gen_gaussian_kernel_free();
+    writer << R"(
+            return TinyNN_SUCCESS;
+        }
+    )";
+    return writer.str();
+}
+
+std::string GaussianBlurKernel::GetCVKernelBody(TContext* context) const {
+    auto kernel_sig = GetCVKernelSignature(context);
+    std::string bmode = context->getAttrStr("border_mode");
+    auto src_specifier =
+            Utils::cvt_dtype_specifier(context->getAttrOprand("operand:0").dtype);
+    auto filter_dtype = SepFilterHelper::get_filter_dtype(src_specifier, true);
+    std::stringstream writer;
+    writer << R"(
+        #include <math.h>
+        #include <stdlib.h>
+        #include <string.h>
+        #include "gi_float.h"
+        #include "gi_int.h"
+        #include "tinycv_c.h"
+        #include "utils.h"
+    )";
+    writer << gen_filters(bmode, src_specifier);
+    writer << "void " << kernel_sig << "{";
+    writer << SepFilterHelper::gen_gaussian_kernel_init(
+            filter_dtype, "kernel_h", "kernel_w", "sigma1", "sigma2");
+    writer << gen_engine_setup();
+    writer << SepFilterHelper::gen_engine_proceed_cv(src_specifier);
+    writer << SepFilterHelper::gen_gaussian_kernel_free();
+    writer << R"(
+        }
+    )";
+    return writer.str();
+}
+
+// vim: syntax=cpp.doxygen
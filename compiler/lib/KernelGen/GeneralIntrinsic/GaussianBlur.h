@@ -0,0 +1,22 @@
+#pragma once
+#include "CvCommon.h"
+#include "compiler/KernelGen/KernelGen.h"
+namespace megcc {
+namespace KernelGen {
+namespace GeneralIntrinsic {
+
+class GaussianBlurKernel : public CVKernelImpl {
+public:
+    bool IsAvailable(TContext* context) const override;
+    std::string GetKernelSymbol(TContext* context) const override;
+    std::string GetKernelBody(TContext* context) const override;
+
+    bool IsCVAvailable(TContext* context) const override;
+    std::string GetCVKernelBody(TContext* context) const override;
+    std::string GetCVKernelSubSymbol(TContext* context) const override;
+    std::string GetCVKernelSignature(TContext* context) const override;
+};
+
+}  // namespace GeneralIntrinsic
+}  // namespace KernelGen
+}  // namespace megcc
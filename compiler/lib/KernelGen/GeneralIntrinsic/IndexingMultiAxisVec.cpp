@@ -0,0 +1,85 @@
+#include "IndexingMultiAxisVec.h"
+#include "Common/Indexing.h"
+#include "Utils/StringTemplate.h"
+#include "Utils/SymbolHelper.h"
+#include "Utils/Utils.h"
+#include "compiler/Common/Logger.h"
+
+using namespace megcc;
+using namespace KernelGen;
+using namespace GeneralIntrinsic;
+
+bool IndexingMultiAxisKernel::IsAvailable(TContext* context) const {
+    int nr_operand = context->getAttrInt("nr_operands");
+    bool ok_operand = nr_operand > 2;
+    auto src_dtype = context->getAttrOprand("operand:0").dtype;
+    auto dst_dtype = Utils::get_last_operand(context).dtype;
+    size_t type_size = Utils::get_dtype_size(src_dtype);
+    bool ok_dtype = SymbolHelper::gen_valid_dtype(src_dtype) ==
+                            SymbolHelper::gen_valid_dtype(dst_dtype) &&
+                    (type_size == 1 || type_size == 2 || type_size == 4);
+    bool ok_axis = true;
+    int last_axis = -1;
+    for (int i = 0; i < nr_operand - 2; ++i) {
+        int axis = context->getAttrInt("axis:" + std::to_string(i));
+        if (last_axis >= 0) {
+            ok_axis = ok_axis && (axis == last_axis + 1);
+        }
+        last_axis = axis;
+    }
+    return ok_dtype && ok_operand && ok_axis;
+}
+
+//! kernel gen
+std::string IndexingMultiAxisKernel::GetKernelSymbol(TContext* context) const {
+    std::stringstream ss;
+    ss << "GI_kernel_indexingmultiaxisvec";
+    int nr_operand = context->getAttrInt("nr_operands");
+    for (int i = 0; i < nr_operand - 2; ++i) {
+        ss << "_" << context->getAttrInt("axis:" + std::to_string(i));
+    }
+    ss << "_"
+       << SymbolHelper::gen_valid_dtype(context->getAttrOprand("operand:0").dtype);
+    return ss.str();
+}
+
+std::string IndexingMultiAxisKernel::GetKernelBody(TContext* context) const {
+    auto src_dtype = context->getAttrOprand("operand:0").dtype;
+    std::string specifier =
+            IndexingHelper::GetMoveSpecifier(Utils::get_dtype_size(src_dtype));
+    std::stringstream writer;
+    writer << R"(
+        #include <string.h>
+        #include "gi_int.h"
+        #include "tensor_util.h"
+
+        static inline void copy_row(void* dst_ptr, const void* src_ptr, size_t nr_bytes) {
+            int8_t* dst = (int8_t*)dst_ptr;
+            const int8_t* src = (const int8_t*)src_ptr;
+            size_t i = 0;
+            for (; i + 64 <= nr_bytes; i += 64) {
+                GI_INT8_t v0 = GiLoadInt8(src + i);
+                GI_INT8_t v1 = GiLoadInt8(src + i + 16);
+                GI_INT8_t v2 = GiLoadInt8(src + i + 32);
+                GI_INT8_t v3 = GiLoadInt8(src + i + 48);
+                GiStoreInt8(dst + i, v0);
+                GiStoreInt8(dst + i + 16, v1);
+                GiStoreInt8(dst + i + 32, v2);
+                GiStoreInt8(dst + i + 48, v3);
+            }
+            for (; i + 16 <= nr_bytes; i += 16) {
+                GiStoreInt8(dst + i, GiLoadInt8(src + i));
+            }
+            if (i < nr_bytes) {
+                memcpy(dst + i, src + i, nr_bytes - i);
+            }
+        }
+    )";
+    writer << GenCommonRet() << " " << GetKernelSignature(context) << "{\n";
+    writer << IndexingHelper::GenMultiAxisVecBody(
+            context->getAttrInt("axis:0"), specifier, "copy_row");
+    writer << "}\n";
+    return writer.str();
+}
+
+// vim: syntax=cpp.doxygen
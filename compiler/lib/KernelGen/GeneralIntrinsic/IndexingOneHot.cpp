@@ -0,0 +1,57 @@
+#include "IndexingOneHot.h"
+#include "Common/Indexing.h"
+#include "Utils/StringTemplate.h"
+#include "Utils/SymbolHelper.h"
+#include "Utils/Utils.h"
+#include "compiler/Common/Logger.h"
+
+using namespace megcc;
+using namespace KernelGen;
+using namespace GeneralIntrinsic;
+
+bool IndexingOneHotKernel::IsAvailable(TContext* context) const {
+    int nr_operand = context->getAttrInt("nr_operands");
+    bool ok_operand = nr_operand == 3;
+    auto src_dtype = context->getAttrOprand("operand:0").dtype;
+    size_t type_size = Utils::get_dtype_size(src_dtype);
+    bool ok_dtype = type_size == 1 || type_size == 2 || type_size == 4;
+    bool ok_idx_dtype =
+            Utils::is_int_dtype(context->getAttrOprand("operand:1").dtype, 32);
+    return ok_dtype && ok_idx_dtype && ok_operand;
+}
+
+//! kernel gen
+std::string IndexingOneHotKernel::GetKernelSymbol(TContext* context) const {
+    std::stringstream ss;
+    ss << "GI_kernel_indexingonehot_" << context->getAttrInt("axis") << "_"
+       << SymbolHelper::gen_valid_dtype(context->getAttrOprand("operand:0").dtype);
+    return ss.str();
+}
+
+std::string IndexingOneHotKernel::GetKernelBody(TContext* context) const {
+    auto src_dtype = context->getAttrOprand("operand:0").dtype;
+    std::string specifier =
+            IndexingHelper::GetMoveSpecifier(Utils::get_dtype_size(src_dtype));
+    std::stringstream writer;
+    writer << R"(
+        #include "gi_int.h"
+        #define GATHER_BLOCK 8
+        static const int lane_id[4] = {0, 1, 2, 3};
+
+        //! offset[k] = idx[k] * inner + base + k
+        static inline void gather_offset(int* offset, const int* idx, size_t base, size_t inner) {
+            GI_INT32_t vinner = GiBroadcastInt32((int)inner);
+            GI_INT32_t vbase0 = GiAddInt32(GiBroadcastInt32((int)base), GiLoadInt32(lane_id));
+            GI_INT32_t vbase1 = GiAddInt32(vbase0, GiBroadcastInt32(4));
+            GiStoreInt32(offset, GiMultiplyAddInt32(vbase0, GiLoadInt32(idx), vinner));
+            GiStoreInt32(offset + 4, GiMultiplyAddInt32(vbase1, GiLoadInt32(idx + 4), vinner));
+        }
+    )";
+    writer << GenCommonRet() << " " << GetKernelSignature(context) << "{\n";
+    writer << IndexingHelper::GenOneHotBody(
+            context->getAttrInt("axis"), specifier, "gather_offset");
+    writer << "}\n";
+    return writer.str();
+}
+
+// vim: syntax=cpp.doxygen
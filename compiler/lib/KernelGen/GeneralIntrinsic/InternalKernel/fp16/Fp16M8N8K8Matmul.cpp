@@ -452,9 +452,57 @@ static void kern_8x8(
 )";
     return writer.str();
 }
+//! the kernel of 8 rows and nr_col cols accumulating in fp32 for the FLOAT32
+//! compute mode, every row vector of A is widened once and multiplied by the
+//! fp16 scalars of B converted to fp32
+std::string GetKern8xNAccFp32(int nr_col) {
+    std::stringstream writer;
+    writer << "\nstatic void kern_8x" << nr_col << R"((
+        const gi_float16_t* A, const gi_float16_t* B, size_t LDB, size_t K,
+        gi_float16_t* C) {
+)";
+    writer << "    LDB = LDB - " << nr_col * 8 << ";\n";
+    for (int col = 0; col < nr_col; ++col) {
+        writer << "    GI_FLOAT32_t c" << col << "l = GiBroadcastFloat32(0.f);\n";
+        writer << "    GI_FLOAT32_t c" << col << "h = GiBroadcastFloat32(0.f);\n";
+    }
+    writer << R"(
+    for (; K > 0; K -= 8) {
+        for (int k = 0; k < 8; ++k) {
+            GI_FLOAT32_V2_t a = GiCastFloat16ToFloat32(GiLoadFloat16(A));
+            GI_FLOAT32_t al = GiGetSubVectorFloat32V2(a, 0);
+            GI_FLOAT32_t ah = GiGetSubVectorFloat32V2(a, 1);
+            A = A + 8;
+)";
+    for (int col = 0; col < nr_col; ++col) {
+        writer << "            float b" << col << " = (float)(*(B + " << col * 8
+               << " + k));\n";
+        writer << "            c" << col << "l = MLA_F32(c" << col << "l, al, b" << col
+               << ");\n";
+        writer << "            c" << col << "h = MLA_F32(c" << col << "h, ah, b" << col
+               << ");\n";
+    }
+    writer << "        }\n";
+    writer << "        B = B + " << nr_col * 8 << " + LDB;\n";
+    writer << "    }\n";
+    for (int col = 0; col < nr_col; ++col) {
+        writer << "    GiStoreFloat16(C + " << col * 8 << ", GiCastFloat32ToFloat16(c"
+               << col << "l, c" << col << "h));\n";
+    }
+    writer << "}\n";
+    return writer.str();
+}
+
+bool is_acc_fp32(TContext* ctx) {
+    return ctx && ctx->haveAttr("compute_mode") &&
+           ctx->getAttrStr("compute_mode") == "FLOAT32";
+}
 }  // namespace
 
-std::string Fp16MatmulM8N8MK8Kernel::GetKernelSymbol(TContext*) const {
+std::string Fp16MatmulM8N8MK8Kernel::GetKernelSymbol(TContext* ctx) const {
+    if (is_acc_fp32(ctx)) {
+        return "GI_fp16_m8_n8_mk8_matmul_comp_f32";
+    }
     return "GI_fp16_m8_n8_mk8_matmul";
 }
 
@@ -472,11 +520,20 @@ std::string Fp16MatmulM8N8MK8Kernel::GetKernelBody(TContext* ctx) const {
     writer << "#include \"stddef.h\"\n";
     writer << "#define MLA GiMultiplyAddScalarFloat16\n";
 
-    writer << GetKern8x1();
-    writer << "\n\n";
-    writer << GetKern8x4();
-    writer << "\n\n";
-    writer << GetKern8x8();
+    if (is_acc_fp32(ctx)) {
+        writer << "#include \"gi_float.h\"\n";
+        writer << "#define MLA_F32 GiMultiplyAddScalarFloat32\n";
+        writer << GetKern8xNAccFp32(1);
+        writer << GetKern8xNAccFp32(4);
+        writer << GetKern8xNAccFp32(8);
+        writer << "#undef MLA_F32\n";
+    } else {
+        writer << GetKern8x1();
+        writer << "\n\n";
+        writer << GetKern8x4();
+        writer << "\n\n";
+        writer << GetKern8x8();
+    }
     writer << "\n\n";
 
     writer << GetKernelSignature(ctx);
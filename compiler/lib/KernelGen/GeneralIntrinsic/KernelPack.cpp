@@ -1,19 +1,30 @@
 #include "KernelPack.h"
 #include <memory>
+#include "Argmax.h"
 #include "CVTranspose.h"
+#include "Concat.h"
 #include "ConvKernel/ConvKernel.h"
 #include "CvtColor.h"
 #include "Elemwise/Elemwise.h"
+#include "ElemwiseMultiType.h"
 #include "Flip.h"
 #include "FusedElemwiseKernel.h"
+#include "GaussianBlur.h"
+#include "IndexingMultiAxisVec.h"
+#include "IndexingOneHot.h"
 #include "InternalKernel/InternalKernel.h"
 #include "MatMulKernel/Fp32MatMul.h"
 #include "MatMulKernel/fp16/Fp16MatMul.h"
+#include "MatrixInv.h"
+#include "NMSKeep.h"
+#include "Padding.h"
 #include "PoolingKernel/Pooling.h"
+#include "Preprocess.h"
 #include "Reduce.h"
 #include "Relayout.h"
 #include "Resize.h"
 #include "Rotate.h"
+#include "SepFilter.h"
 #include "Typecvt.h"
 #include "WarpAffine.h"
 
@@ -25,7 +36,10 @@ struct AllGICommonKernel {
     AllGICommonKernel() {
         inner_map[KernelPack::KernType::ElemwiseKernel] = {
                 std::make_shared<GeneralIntrinsic::ElemwiseKernel>()};
+        inner_map[KernelPack::KernType::ElemwiseMultiKernel] = {
+                std::make_shared<GeneralIntrinsic::ElemwiseMultiTypeKernel>()};
         inner_map[KernelPack::KernType::MatrixMulKernel] = {
+                std::make_shared<GeneralIntrinsic::Fp32WeightQuantMatMulKernel>(),
                 std::make_shared<GeneralIntrinsic::Fp16GevmKernel>(),
                 std::make_shared<GeneralIntrinsic::Fp16GemvKernel>(),
                 std::make_shared<GeneralIntrinsic::Fp16MatMulM8N8K8>(),
@@ -56,11 +70,17 @@ struct AllGICommonKernel {
                 std::make_shared<GeneralIntrinsic::WinogradFloatF23NCHW44>(),
                 std::make_shared<GeneralIntrinsic::ConvIm2colFloat>(),
                 std::make_shared<GeneralIntrinsic::ConvIm2colFloatM4N8>(),
+                std::make_shared<GeneralIntrinsic::Conv1x1Int8Nchw44>(),
+                std::make_shared<GeneralIntrinsic::ChannelWiseInt8Nchw44>(),
+                std::make_shared<GeneralIntrinsic::DirectInt8Nchw44>(),
+                std::make_shared<GeneralIntrinsic::ConvIm2colInt8Nchw44>(),
 
         };
 
         inner_map[KernelPack::KernType::ConvBackDataKernel] = {
-                std::make_shared<GeneralIntrinsic::Float32NchwBackward>()};
+                std::make_shared<GeneralIntrinsic::Float32NchwBackward>(),
+                std::make_shared<GeneralIntrinsic::Float16Nchw88Backward>(),
+                std::make_shared<GeneralIntrinsic::Int8Nchw44Backward>()};
 
         inner_map[KernelPack::KernType::PoolingKernel] = {
                 std::make_shared<GeneralIntrinsic::PoolingNchw88Fp16>(),
@@ -73,6 +93,12 @@ struct AllGICommonKernel {
         inner_map[KernelPack::KernType::ReduceKernel] = {
                 std::make_shared<GeneralIntrinsic::ReduceKernel>()};
 
+        inner_map[KernelPack::KernType::ArgmaxKernel] = {
+                std::make_shared<GeneralIntrinsic::ArgmaxKernel>()};
+
+        inner_map[KernelPack::KernType::ArgminKernel] = {
+                std::make_shared<GeneralIntrinsic::ArgminKernel>()};
+
         inner_map[KernelPack::KernType::FlipKernel] = {
                 std::make_shared<GeneralIntrinsic::FlipKernel>()};
 
@@ -96,6 +122,35 @@ struct AllGICommonKernel {
 
         inner_map[KernelPack::KernType::FusedElemwiseKernel] = {
                 std::make_shared<GeneralIntrinsic::FusedElmwiseKernel>()};
+
+        inner_map[KernelPack::KernType::IndexingMultiAxisKernel] = {
+                std::make_shared<GeneralIntrinsic::IndexingMultiAxisKernel>()};
+
+        inner_map[KernelPack::KernType::IndexingOneHotKernel] = {
+                std::make_shared<GeneralIntrinsic::IndexingOneHotKernel>()};
+
+        inner_map[KernelPack::KernType::ConcatKernel] = {
+                std::make_shared<GeneralIntrinsic::ConcatKernel>()};
+
+        inner_map[KernelPack::KernType::PaddingKernel] = {
+                std::make_shared<GeneralIntrinsic::PaddingKernel>()};
+
+        inner_map[KernelPack::KernType::CVPreprocessKernel] = {
+                std::make_shared<GeneralIntrinsic::PreprocessKernel>()};
+
+        inner_map[KernelPack::KernType::NMSKeepKernel] = {
+                std::make_shared<GeneralIntrinsic::NMSKeepKernel>()};
+
+        inner_map[KernelPack::KernType::CVGaussianBlur] = {
+                std::make_shared<GeneralIntrinsic::GaussianBlurKernel>()};
+        inner_map[KernelPack::KernType::GaussianBlurKernel] = {
+                std::make_shared<GeneralIntrinsic::GaussianBlurKernel>()};
+
+        inner_map[KernelPack::KernType::CVSepFilterKernel] = {
+                std::make_shared<GeneralIntrinsic::SepFilterKernel>()};
+
+        inner_map[KernelPack::KernType::MatrixInvKernel] = {
+                std::make_shared<GeneralIntrinsic::MatrixInvKernel>()};
     }
 
     std::unordered_map<KernelPack::KernType, std::vector<std::shared_ptr<KernelFunc>>>
@@ -36,6 +36,15 @@ public:
     std::string GetWorkspaceBody(TContext* context) const override;
 };
 
+//! float matmul with the int8 or packed int4 weight quantized by the importer,
+//! the weights are dequantized in registers and shared by 4 rows of the input
+class Fp32WeightQuantMatMulKernel : public KernelFunc {
+public:
+    bool IsAvailable(TContext* context) const override;
+    std::string GetKernelSymbol(TContext* context) const override;
+    std::string GetKernelBody(TContext* context) const override;
+};
+
 class Fp32GemvMk4Kernel : public KernelFunc {
 public:
     bool IsAvailable(TContext* context) const override;
@@ -0,0 +1,181 @@
+#include <sstream>
+#include "Common/WeightQuantMatMul.h"
+#include "Fp32MatMul.h"
+#include "Utils/StringTemplate.h"
+using namespace megcc;
+using namespace KernelGen;
+using namespace GeneralIntrinsic;
+namespace {
+//! dequantize the weights of one block starting from k_idx to w0, w1, ...
+std::string dequant_block(bool int4) {
+    std::string body = R"(
+                GI_INT8_t q = GiLoadInt8(b_row + ${offset});
+                GI_INT16_t q_low = GiMoveLowLongInt8(q);
+                GI_INT16_t q_high = GiMoveHighLongInt8(q);
+                GI_INT32_t q0 = GiMoveLowLongInt16(q_low);
+                GI_INT32_t q1 = GiMoveHighLongInt16(q_low);
+                GI_INT32_t q2 = GiMoveLowLongInt16(q_high);
+                GI_INT32_t q3 = GiMoveHighLongInt16(q_high);
+    )";
+    if (int4) {
+        //! the low nibbles are the first 16 values and the high nibbles are the
+        //! last 16 values of the block
+        body += R"(
+                GI_FLOAT32_t w0 = GiCastToFloat32(GiShiftRightInt32(GiShiftLeftInt32(q0, 28), 28));
+                GI_FLOAT32_t w1 = GiCastToFloat32(GiShiftRightInt32(GiShiftLeftInt32(q1, 28), 28));
+                GI_FLOAT32_t w2 = GiCastToFloat32(GiShiftRightInt32(GiShiftLeftInt32(q2, 28), 28));
+                GI_FLOAT32_t w3 = GiCastToFloat32(GiShiftRightInt32(GiShiftLeftInt32(q3, 28), 28));
+                GI_FLOAT32_t w4 = GiCastToFloat32(GiShiftRightInt32(q0, 4));
+                GI_FLOAT32_t w5 = GiCastToFloat32(GiShiftRightInt32(q1, 4));
+                GI_FLOAT32_t w6 = GiCastToFloat32(GiShiftRightInt32(q2, 4));
+                GI_FLOAT32_t w7 = GiCastToFloat32(GiShiftRightInt32(q3, 4));
+        )";
+    } else {
+        body += R"(
+                GI_FLOAT32_t w0 = GiCastToFloat32(q0);
+                GI_FLOAT32_t w1 = GiCastToFloat32(q1);
+                GI_FLOAT32_t w2 = GiCastToFloat32(q2);
+                GI_FLOAT32_t w3 = GiCastToFloat32(q3);
+        )";
+    }
+    return StringTemplate::StringTemplateArgs()
+            .add("offset", int4 ? "k_idx / 2" : "k_idx")
+            .render(body);
+}
+
+//! accumulate the block of nr_row rows with the dequantized weights
+std::string mla_block(int nr_row, int nr_w) {
+    std::stringstream ss;
+    for (int w = 0; w < nr_w; ++w) {
+        for (int row = 0; row < nr_row; ++row) {
+            ss << "acc" << row << " = GiMlaqFloat32(acc" << row << ", GiLoadFloat32(a"
+               << row << " + k_idx + " << w * 4 << "), w" << w << ");\n";
+        }
+    }
+    return ss.str();
+}
+
+std::string scalar_weight(bool int4) {
+    if (int4) {
+        return R"(
+                    int8_t packed = b_row[k_idx / 32 * 16 + k_idx % 16];
+                    int low = (int8_t)((uint8_t)packed << 4) >> 4;
+                    float b_val = k_idx % 32 < 16 ? low : packed >> 4;)";
+    } else {
+        return "float b_val = b_row[k_idx];";
+    }
+}
+
+//! compute nr_row rows of the output column n_idx from row m_idx
+std::string compute_rows(int nr_row, bool int4) {
+    std::stringstream init_ss, acc_ss, tail_ss, sum_ss, store_ss;
+    for (int row = 0; row < nr_row; ++row) {
+        init_ss << "const float* a" << row << " = a_data + (m_idx + " << row
+                << ") * lda;\n";
+        init_ss << "float sum" << row << " = 0.f;\n";
+        acc_ss << "GI_FLOAT32_t acc" << row << " = GiBroadcastFloat32(0.f);\n";
+        acc_ss << "float tail" << row << " = 0.f;\n";
+        tail_ss << "tail" << row << " += a" << row << "[k_idx] * b_val;\n";
+        sum_ss << "sum" << row << " += (GiReduceAddFloat32(acc" << row << ") + tail"
+               << row << ") * scale;\n";
+        store_ss << "c_data[(m_idx + " << row << ") * ldc + n_idx] = sum" << row
+                 << ";\n";
+    }
+    std::string body = R"(
+        ${init}
+        for (int g = 0; g < nr_group; ++g) {
+            ${acc_init}
+            int k_idx = g * group;
+            const int k_end = k_idx + group < k ? k_idx + group : k;
+            for (; k_idx + ${block} <= k_end; k_idx += ${block}) {
+                ${dequant}
+                ${mla}
+            }
+            for (; k_idx < k_end; ++k_idx) {
+                ${scalar_weight}
+                ${tail}
+            }
+            const float scale = scale_row[g];
+            ${sum}
+        }
+        ${store}
+    )";
+    return StringTemplate::StringTemplateArgs()
+            .add("init", init_ss.str())
+            .add("acc_init", acc_ss.str())
+            .add("block", int4 ? 32 : 16)
+            .add("dequant", dequant_block(int4))
+            .add("mla", mla_block(nr_row, int4 ? 8 : 4))
+            .add("scalar_weight", scalar_weight(int4))
+            .add("tail", tail_ss.str())
+            .add("sum", sum_ss.str())
+            .add("store", store_ss.str())
+            .render(body);
+}
+}  // namespace
+
+bool Fp32WeightQuantMatMulKernel::IsAvailable(TContext* context) const {
+    return WeightQuantMatMulHelper::is_available(context);
+}
+
+//! kernel gen
+std::string Fp32WeightQuantMatMulKernel::GetKernelSymbol(TContext* context) const {
+    std::stringstream ss;
+    ss << "GI_kernel_weight_quant_matmul_nt_";
+    ss << (WeightQuantMatMulHelper::is_int4(context) ? "int4" : "int8");
+    return ss.str();
+}
+
+std::string Fp32WeightQuantMatMulKernel::GetKernelBody(TContext* context) const {
+    bool int4 = WeightQuantMatMulHelper::is_int4(context);
+    std::stringstream writer;
+    writer << R"(
+        #include "gi_float.h"
+        #include "gi_int.h"
+    )";
+    writer << GenCommonRet() << " ";
+    writer << GetKernelSignature(context) << "{\n";
+    std::string body = R"(
+    float* a_data = (float*)inputs[0]->ptr;
+    int8_t* b_data = (int8_t*)inputs[1]->ptr;
+    float* c_data = (float*)outputs[0]->ptr;
+    TINYNN_ASSERT(a_data);
+    TINYNN_ASSERT(b_data);
+    TINYNN_ASSERT(c_data);
+    const Tensor* b_tensor = inputs[1];
+    const Layout a_layout = inputs[0]->layout;
+    const Layout b_layout = b_tensor->layout;
+    const Layout c_layout = outputs[0]->layout;
+    const int lda = a_layout.stride[0];
+    const int ldb = b_layout.stride[0];
+    const int ldc = c_layout.stride[0];
+    const int m = c_layout.dims[0];
+    const int n = c_layout.dims[1];
+    const int k = a_layout.dims[1];
+    const float* scales = b_tensor->dtype.param.scales;
+    const int nr_scale = b_tensor->dtype.param.nr_scale;
+    TINYNN_ASSERT(scales && nr_scale % n == 0);
+    const int nr_group = nr_scale / n;
+    const int group = ${group};
+    for (int n_idx = 0; n_idx < n; ++n_idx) {
+        const int8_t* b_row = b_data + n_idx * ldb;
+        const float* scale_row = scales + n_idx * nr_group;
+        int m_idx = 0;
+        for (; m_idx + 4 <= m; m_idx += 4) {
+            ${compute_4_rows}
+        }
+        for (; m_idx < m; ++m_idx) {
+            ${compute_1_row}
+        }
+    }
+    return TinyNN_SUCCESS;
+})";
+    writer << StringTemplate::StringTemplateArgs()
+                      .add("group", WeightQuantMatMulHelper::gen_group(int4))
+                      .add("compute_4_rows", compute_rows(4, int4))
+                      .add("compute_1_row", compute_rows(1, int4))
+                      .render(body);
+    return writer.str();
+}
+
+// vim: syntax=cpp.doxygen
@@ -11,8 +11,10 @@ bool Fp16MatMulM8N8K8::IsAvailable(TContext* context) const {
     bool ok_dtype = context->getAttrOprand("operand:0").dtype == "f16" &&
                     context->getAttrOprand("operand:1").dtype == "f16" &&
                     context->getAttrOprand("operand:2").dtype == "f16";
+    //! the inner matmul accumulates in fp32 with FLOAT32 compute mode
     bool ok_mode = context->getAttrStr("format") == "MK8" &&
-                   context->getAttrStr("compute_mode") == "DEFAULT";
+                   (context->getAttrStr("compute_mode") == "DEFAULT" ||
+                    context->getAttrStr("compute_mode") == "FLOAT32");
     bool ok_shape = context->getAttrOprand("operand:0").shape.size() == 4 &&
                     context->getAttrOprand("operand:1").shape.size() == 3;
     bool ok_tran = context->getAttrBool("transposeA") == false &&
@@ -34,6 +36,9 @@ std::string Fp16MatMulM8N8K8::GetKernelSymbol(TContext* context) const {
     } else {
         ss << "n";
     }
+    if (context->getAttrStr("compute_mode") == "FLOAT32") {
+        ss << "_comp_f32";
+    }
     return ss.str();
 }
 
@@ -45,6 +50,7 @@ std::shared_ptr<TContext> GetInnerCtx(TContext* ctx) {
     inner_ctx->setAttr("transposeA", ctx->getAttrBool("transposeA"));
     inner_ctx->setAttr("transposeB", ctx->getAttrBool("transposeB"));
     inner_ctx->setAttr("dtype", "f16");
+    inner_ctx->setAttr("compute_mode", CCAttr(ctx->getAttrStr("compute_mode")));
     return inner_ctx;
 }
 }  // namespace
@@ -0,0 +1,202 @@
+#include <sstream>
+
+#include "Common/MatrixInv.h"
+#include "MatrixInv.h"
+#include "Utils/StringTemplate.h"
+#include "Utils/Utils.h"
+
+using namespace megcc;
+using namespace KernelGen;
+using namespace GeneralIntrinsic;
+
+namespace {
+//! the small matrices run 4 of a batch at once, one in every float lane
+std::string gen_gi_prelude() {
+    return R"(
+#include <math.h>
+#include <string.h>
+#include "gi_float.h"
+
+typedef GI_FLOAT32_t mi_vec_t;
+#define MI_LANE 4
+#define MI_LOAD(ptr) GiLoadFloat32(ptr)
+#define MI_STORE(ptr, v) GiStoreFloat32(ptr, v)
+#define MI_MUL(a, b) GiMultiplyFloat32(a, b)
+#define MI_MLA(acc, a, b) GiMultiplyAddFloat32(acc, a, b)
+#define MI_MLS(acc, a, b) GiMultiplySubFloat32(acc, a, b)
+#define MI_RECIP(a) GiDivideFloat32(GiBroadcastFloat32(1.f), a)
+)";
+}
+
+/*!
+ * the larger matrices are factorized as P * A = L * U with a right looking
+ * blocked LU, a panel of MI_LU_BLOCK columns is factorized first and then the
+ * trailing rows are updated once per panel. The inverse is U^-1 * L^-1 * P,
+ * solved row by row on the permuted identity. All the updates are
+ * row[j] -= sum_k coef[k] * base[k * ld + j] over a range of j, which keeps
+ * the row segment in registers while the k rows are accumulated.
+ */
+std::string gen_lu_inverse() {
+    return R"(
+#define MI_LU_BLOCK 8
+static inline void mi_rank_update(
+        float* row, const float* coef, const float* base, int ld, int k_begin,
+        int k_end, int j_begin, int j_end) {
+    int j = j_begin;
+    for (; j + 8 <= j_end; j += 8) {
+        GI_FLOAT32_t acc0 = GiLoadFloat32(row + j);
+        GI_FLOAT32_t acc1 = GiLoadFloat32(row + j + 4);
+        for (int k = k_begin; k < k_end; ++k) {
+            const float* b = base + (size_t)k * ld + j;
+            acc0 = GiMultiplySubScalarFloat32(acc0, GiLoadFloat32(b), coef[k]);
+            acc1 = GiMultiplySubScalarFloat32(acc1, GiLoadFloat32(b + 4), coef[k]);
+        }
+        GiStoreFloat32(row + j, acc0);
+        GiStoreFloat32(row + j + 4, acc1);
+    }
+    for (; j + 4 <= j_end; j += 4) {
+        GI_FLOAT32_t acc = GiLoadFloat32(row + j);
+        for (int k = k_begin; k < k_end; ++k) {
+            acc = GiMultiplySubScalarFloat32(
+                    acc, GiLoadFloat32(base + (size_t)k * ld + j), coef[k]);
+        }
+        GiStoreFloat32(row + j, acc);
+    }
+    for (; j < j_end; ++j) {
+        float acc = row[j];
+        for (int k = k_begin; k < k_end; ++k)
+            acc -= coef[k] * base[(size_t)k * ld + j];
+        row[j] = acc;
+    }
+}
+
+static void mi_lu_inverse(
+        const float* src, float* dst, int n, float* lu, int* perm) {
+    memcpy(lu, src, sizeof(float) * n * n);
+    for (int i = 0; i < n; ++i)
+        perm[i] = i;
+    for (int k0 = 0; k0 < n; k0 += MI_LU_BLOCK) {
+        int k1 = k0 + MI_LU_BLOCK < n ? k0 + MI_LU_BLOCK : n;
+        //! factorize the panel of columns [k0, k1)
+        for (int k = k0; k < k1; ++k) {
+            float abs_max = 0.f;
+            int select_row = k;
+            for (int row = k; row < n; ++row) {
+                float abs_val = fabsf(lu[row * n + k]);
+                if (abs_val > abs_max) {
+                    abs_max = abs_val;
+                    select_row = row;
+                }
+            }
+            TINYNN_ASSERT(abs_max > 1e-7);
+            if (select_row != k) {
+                float* r0 = lu + k * n;
+                float* r1 = lu + select_row * n;
+                for (int col = 0; col < n; ++col) {
+                    float temp = r0[col];
+                    r0[col] = r1[col];
+                    r1[col] = temp;
+                }
+                int temp = perm[k];
+                perm[k] = perm[select_row];
+                perm[select_row] = temp;
+            }
+            const float* pivot_row = lu + k * n;
+            float inv_pivot = 1.f / pivot_row[k];
+            for (int row = k + 1; row < n; ++row) {
+                float* cur_row = lu + row * n;
+                float l = cur_row[k] * inv_pivot;
+                cur_row[k] = l;
+                for (int col = k + 1; col < k1; ++col)
+                    cur_row[col] -= l * pivot_row[col];
+            }
+        }
+        if (k1 == n)
+            break;
+        //! U12 = L11^-1 * A12, then A22 -= L21 * U12
+        for (int row = k0 + 1; row < k1; ++row)
+            mi_rank_update(lu + row * n, lu + row * n, lu, n, k0, row, k1, n);
+        for (int row = k1; row < n; ++row)
+            mi_rank_update(lu + row * n, lu + row * n, lu, n, k0, k1, k1, n);
+    }
+    memset(dst, 0, sizeof(float) * n * n);
+    for (int row = 0; row < n; ++row)
+        dst[row * n + perm[row]] = 1.f;
+    for (int row = 1; row < n; ++row)
+        mi_rank_update(dst + row * n, lu + row * n, dst, n, 0, row, 0, n);
+    for (int row = n - 1; row >= 0; --row) {
+        float* cur_row = dst + row * n;
+        mi_rank_update(cur_row, lu + row * n, dst, n, row + 1, n, 0, n);
+        GI_FLOAT32_t scale = GiBroadcastFloat32(1.f / lu[row * n + row]);
+        int col = 0;
+        for (; col + 4 <= n; col += 4)
+            GiStoreFloat32(
+                    cur_row + col, GiMultiplyFloat32(GiLoadFloat32(cur_row + col), scale));
+        for (; col < n; ++col)
+            cur_row[col] /= lu[row * n + row];
+    }
+}
+)";
+}
+}  // namespace
+
+bool MatrixInvKernel::IsAvailable(TContext* context) const {
+    bool ok_dtype = context->getAttrOprand("operand:0").dtype == "f32";
+    auto src_shape = context->getAttrOprand("operand:0").shape;
+    bool ok_shape = src_shape.size() >= 2 &&
+                    src_shape[src_shape.size() - 1] == src_shape[src_shape.size() - 2];
+    return ok_dtype && ok_shape;
+}
+
+//! kernel gen
+std::string MatrixInvKernel::GetKernelSymbol(TContext* context) const {
+    return "GI_kernel_matrix_inv_f32";
+}
+
+std::string MatrixInvKernel::GetWorkspaceBody(TContext* context) const {
+    std::stringstream ss;
+    ss << GenCommonRet() << " " << GetWorkspaceSignature(context);
+    ss << R"({
+        TINYNN_ASSERT(workspace);
+        const Layout in_layout = inputs[0]->layout;
+        const uint32_t n = in_layout.dims[in_layout.nr_dim - 1];
+        *workspace = n * n * sizeof(float) + n * sizeof(int);
+        return TinyNN_SUCCESS;
+    })";
+    return ss.str();
+}
+
+std::string MatrixInvKernel::GetKernelBody(TContext* context) const {
+    std::stringstream ss;
+    ss << gen_gi_prelude();
+    ss << MatrixInvHelper::gen_small_inverses();
+    ss << gen_lu_inverse();
+    ss << GenCommonRet() << " " << GetKernelSignature(context);
+    std::string body_temp = R"({
+    const float* a_data = (const float*)inputs[0]->ptr;
+    float* c_data = (float*)outputs[0]->ptr;
+    TINYNN_ASSERT(a_data);
+    TINYNN_ASSERT(c_data);
+    const Layout a_layout = inputs[0]->layout;
+    const int n = a_layout.dims[a_layout.nr_dim - 1];
+    int batch = 1;
+    for (int i = 0; i < a_layout.nr_dim - 2; ++i) {
+        batch *= a_layout.dims[i];
+    }
+    ${small_dispatch}
+    float* lu = (float*)(workspace->ptr);
+    int* perm = (int*)(lu + n * n);
+    for (int b_idx = 0; b_idx < batch; ++b_idx) {
+        mi_lu_inverse(a_data + (size_t)b_idx * n * n, c_data + (size_t)b_idx * n * n,
+                      n, lu, perm);
+    }
+    return TinyNN_SUCCESS;
+})";
+    ss << StringTemplate::StringTemplateArgs()
+                    .add("small_dispatch", MatrixInvHelper::gen_small_dispatch(
+                                                   "a_data", "c_data", "n", "batch"))
+                    .render(body_temp);
+    return ss.str();
+}
+
+// vim: syntax=cpp.doxygen
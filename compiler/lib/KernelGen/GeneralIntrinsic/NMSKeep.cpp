@@ -0,0 +1,90 @@
+#include "NMSKeep.h"
+#include "Common/NMSKeep.h"
+#include "Utils/StringTemplate.h"
+#include "Utils/SymbolHelper.h"
+#include "Utils/Utils.h"
+#include "compiler/Common/Logger.h"
+
+using namespace megcc;
+using namespace KernelGen;
+using namespace GeneralIntrinsic;
+
+bool NMSKeepKernel::IsAvailable(TContext* context) const {
+    return context->getAttrOprand("operand:0").dtype == "f32";
+}
+
+//! kernel gen
+std::string NMSKeepKernel::GetKernelSymbol(TContext* context) const {
+    std::stringstream ss;
+    ss << "GI_kernel_nms_keep_iou_"
+       << SymbolHelper::gen_valid_float(context->getAttrFloat("iou_thresh"))
+       << "_max_" << context->getAttrUInt("max_output") << "_f32";
+    return ss.str();
+}
+
+std::string NMSKeepKernel::GetWorkspaceBody(TContext* context) const {
+    return NMSKeepHelper::GenWorkspaceBody(
+            GenCommonRet() + " " + GetWorkspaceSignature(context));
+}
+
+std::string NMSKeepKernel::GetKernelBody(TContext* context) const {
+    std::stringstream writer;
+    writer << R"(
+        #include <string.h>
+        #include "gi_float.h"
+        #include "tensor_util.h"
+
+        //! the kept box against 4 later boxes a time, the IoU test is
+        //! inter > union * thresh to avoid the division. removed holds all
+        //! ones lanes, so the masks are or-ed in as float bits
+        static inline void suppress(const float* x0, const float* y0, const float* x1,
+                                    const float* y1, const float* area,
+                                    uint32_t* removed, int i, int nr_boxes,
+                                    float thresh) {
+            GI_FLOAT32_t v_x0 = GiBroadcastFloat32(x0[i]);
+            GI_FLOAT32_t v_y0 = GiBroadcastFloat32(y0[i]);
+            GI_FLOAT32_t v_x1 = GiBroadcastFloat32(x1[i]);
+            GI_FLOAT32_t v_y1 = GiBroadcastFloat32(y1[i]);
+            GI_FLOAT32_t v_area = GiBroadcastFloat32(area[i]);
+            GI_FLOAT32_t v_thresh = GiBroadcastFloat32(thresh);
+            GI_FLOAT32_t v_zero = GiBroadcastFloat32(0.f);
+            int j = i + 1;
+            for (; j + 4 <= nr_boxes; j += 4) {
+                GI_FLOAT32_t left = GiMaximumFloat32(v_x0, GiLoadFloat32(x0 + j));
+                GI_FLOAT32_t top = GiMaximumFloat32(v_y0, GiLoadFloat32(y0 + j));
+                GI_FLOAT32_t right = GiMinimumFloat32(v_x1, GiLoadFloat32(x1 + j));
+                GI_FLOAT32_t bottom = GiMinimumFloat32(v_y1, GiLoadFloat32(y1 + j));
+                GI_FLOAT32_t w = GiMaximumFloat32(GiSubtractFloat32(right, left), v_zero);
+                GI_FLOAT32_t h = GiMaximumFloat32(GiSubtractFloat32(bottom, top), v_zero);
+                GI_FLOAT32_t inter = GiMultiplyFloat32(w, h);
+                GI_FLOAT32_t uni = GiSubtractFloat32(
+                        GiAddFloat32(v_area, GiLoadFloat32(area + j)), inter);
+                GI_UINT32_t mask =
+                        GiGreaterThanFloat32(inter, GiMultiplyFloat32(uni, v_thresh));
+                float* flag = (float*)(removed + j);
+                GiStoreFloat32(
+                        flag, GiOrFloat32(GiLoadFloat32(flag), GiReintUint32ToFloat32(mask)));
+            }
+            for (; j < nr_boxes; ++j) {
+                float left = x0[i] > x0[j] ? x0[i] : x0[j];
+                float top = y0[i] > y0[j] ? y0[i] : y0[j];
+                float right = x1[i] < x1[j] ? x1[i] : x1[j];
+                float bottom = y1[i] < y1[j] ? y1[i] : y1[j];
+                float w = right - left > 0.f ? right - left : 0.f;
+                float h = bottom - top > 0.f ? bottom - top : 0.f;
+                float inter = w * h;
+                if (inter > (area[i] + area[j] - inter) * thresh) {
+                    removed[j] = 0xffffffff;
+                }
+            }
+        }
+    )";
+    writer << GenCommonRet() << " " << GetKernelSignature(context) << "{\n";
+    writer << NMSKeepHelper::GenBody(
+            context->getAttrFloat("iou_thresh"), context->getAttrUInt("max_output"),
+            "suppress");
+    writer << "}\n";
+    return writer.str();
+}
+
+// vim: syntax=cpp.doxygen
@@ -0,0 +1,108 @@
+#include "Padding.h"
+#include "Common/Padding.h"
+#include "Utils/StringTemplate.h"
+#include "Utils/SymbolHelper.h"
+#include "Utils/Utils.h"
+#include "compiler/Common/Logger.h"
+
+using namespace megcc;
+using namespace KernelGen;
+using namespace GeneralIntrinsic;
+
+bool PaddingKernel::IsAvailable(TContext* context) const {
+    std::string padding_mode = context->getAttrStr("padding_mode");
+    bool mode_ok =
+            (padding_mode == "REPLICATE" || padding_mode == "CONSTANT" ||
+             padding_mode == "REFLECT");
+    //! fp16 needs the fp16 pad value conversion, leave it to the naive kernel
+    auto dtype = context->getAttrOprand("operand:0").dtype;
+    size_t type_size = Utils::get_dtype_size(dtype);
+    bool dtype_ok = !Utils::is_float_dtype(dtype, 16) &&
+                    (type_size == 1 || type_size == 4);
+    return mode_ok && dtype_ok;
+}
+
+//! kernel gen
+std::string PaddingKernel::GetKernelSymbol(TContext* context) const {
+    std::stringstream ss;
+    ss << "GI_kernel_padding_front_offset_";
+    for (int i = 0; i < 7; ++i) {
+        ss << context->getAttrInt("front_offsets:" + std::to_string(i)) << "_";
+    }
+    std::string padding_mode = context->getAttrStr("padding_mode");
+    ss << padding_mode << "_";
+    if (padding_mode == "CONSTANT") {
+        ss << SymbolHelper::gen_valid_float(context->getAttrFloat("padding_val"))
+           << "_";
+    }
+    ss << SymbolHelper::gen_valid_dtype(context->getAttrOprand("operand:0").dtype);
+    return ss.str();
+}
+
+std::string PaddingKernel::GetKernelBody(TContext* context) const {
+    std::string padding_mode = context->getAttrStr("padding_mode");
+    std::vector<int> front_offsets;
+    for (int i = 0; i < 7; ++i) {
+        front_offsets.push_back(
+                context->getAttrInt("front_offsets:" + std::to_string(i)));
+    }
+    std::string specifier =
+            Utils::cvt_dtype_specifier(context->getAttrOprand("operand:0").dtype);
+    std::stringstream writer;
+    writer << R"(
+        #include <string.h>
+        #include "gi_int.h"
+        #include "tensor_util.h"
+
+        static inline void copy_row(void* dst_ptr, const void* src_ptr, size_t nr_bytes) {
+            int8_t* dst = (int8_t*)dst_ptr;
+            const int8_t* src = (const int8_t*)src_ptr;
+            size_t i = 0;
+            for (; i + 64 <= nr_bytes; i += 64) {
+                GI_INT8_t v0 = GiLoadInt8(src + i);
+                GI_INT8_t v1 = GiLoadInt8(src + i + 16);
+                GI_INT8_t v2 = GiLoadInt8(src + i + 32);
+                GI_INT8_t v3 = GiLoadInt8(src + i + 48);
+                GiStoreInt8(dst + i, v0);
+                GiStoreInt8(dst + i + 16, v1);
+                GiStoreInt8(dst + i + 32, v2);
+                GiStoreInt8(dst + i + 48, v3);
+            }
+            for (; i + 16 <= nr_bytes; i += 16) {
+                GiStoreInt8(dst + i, GiLoadInt8(src + i));
+            }
+            if (i < nr_bytes) {
+                memcpy(dst + i, src + i, nr_bytes - i);
+            }
+        }
+
+        //! the pattern period divides 16 bytes and every fill starts at an
+        //! element boundary, so the tail is the head of the pattern
+        static inline void fill_row(void* dst_ptr, const uint8_t* pattern, size_t nr_bytes) {
+            int8_t* dst = (int8_t*)dst_ptr;
+            GI_INT8_t v = GiLoadInt8(pattern);
+            size_t i = 0;
+            for (; i + 64 <= nr_bytes; i += 64) {
+                GiStoreInt8(dst + i, v);
+                GiStoreInt8(dst + i + 16, v);
+                GiStoreInt8(dst + i + 32, v);
+                GiStoreInt8(dst + i + 48, v);
+            }
+            for (; i + 16 <= nr_bytes; i += 16) {
+                GiStoreInt8(dst + i, v);
+            }
+            if (i < nr_bytes) {
+                memcpy(dst + i, pattern, nr_bytes - i);
+            }
+        }
+    )";
+    writer << PaddingHelper::GenSrcIndexFunc(padding_mode);
+    writer << GenCommonRet() << " " << GetKernelSignature(context) << "{\n";
+    writer << PaddingHelper::GenBody(
+            front_offsets, padding_mode, context->getAttrFloat("padding_val"),
+            specifier, "copy_row", "fill_row");
+    writer << "}\n";
+    return writer.str();
+}
+
+// vim: syntax=cpp.doxygen
@@ -0,0 +1,434 @@
+#include <algorithm>
+#include <sstream>
+
+#include "Preprocess.h"
+#include "Utils/StringTemplate.h"
+#include "Utils/SymbolHelper.h"
+#include "Utils/Utils.h"
+
+using namespace megcc;
+using namespace KernelGen;
+using namespace GeneralIntrinsic;
+
+namespace {
+
+//! fetch one source pixel as b, g, r integers
+std::string gen_load_pixel(const std::string& src_format) {
+    if (src_format == "BGR") {
+        return R"(
+        static inline void load_pixel(const uint8_t* sptr, int src_rows, int src_cols,
+                                      int row, int col, int* b, int* g, int* r) {
+            (void)src_rows;
+            const uint8_t* p = sptr + ((size_t)row * src_cols + col) * 3;
+            *b = p[0];
+            *g = p[1];
+            *r = p[2];
+        }
+    )";
+    }
+    CC_ASSERT(src_format == "NV21");
+    //! same integer conversion as tinycv_cvt_yuv2bgr_nv21
+    return R"(
+        static inline int clamp_ui8(int x) {
+            return x < 0 ? 0 : (x > 255 ? 255 : x);
+        }
+        static inline void load_pixel(const uint8_t* sptr, int src_rows, int src_cols,
+                                      int row, int col, int* b, int* g, int* r) {
+            int Y = sptr[(size_t)row * src_cols + col];
+            const uint8_t* pvu =
+                    sptr + (size_t)(src_rows + row / 2) * src_cols + (col & ~1);
+            int V = pvu[0] - 128;
+            int U = pvu[1] - 128;
+            *r = clamp_ui8(Y + ((359 * V) >> 8));
+            *g = clamp_ui8(Y - ((88 * U + 183 * V) >> 8));
+            *b = clamp_ui8(Y + ((454 * U) >> 8));
+        }
+    )";
+}
+
+//! `pack_row` moves the normalized planar row into dst and `fill_pixels`
+//! writes the letterbox border. NCHW float rows are normalized in place in
+//! dst, so they need no pack
+std::string gen_store_func(const std::string& dst_format, bool is_int8) {
+    std::string quant_func = R"(
+        static inline int8_t quant_i8(float x) {
+            float r = roundf(x);
+            return (int8_t)(r < -128.f ? -128.f : (r > 127.f ? 127.f : r));
+        }
+    )";
+    if (dst_format == "NCHW" && !is_int8) {
+        return R"(
+        static inline void fill_pixels(float* dptr, size_t plane, size_t offset, int n,
+                                       const float* pad) {
+            for (int c = 0; c < 3; ++c) {
+                float* dst = dptr + c * plane + offset;
+                GI_FLOAT32_t v_pad = GiBroadcastFloat32(pad[c]);
+                int i = 0;
+                for (; i + 4 <= n; i += 4) {
+                    GiStoreFloat32(dst + i, v_pad);
+                }
+                for (; i < n; ++i) {
+                    dst[i] = pad[c];
+                }
+            }
+        }
+    )";
+    }
+    if (dst_format == "NCHW") {
+        return quant_func + R"(
+        static inline void fill_pixels(int8_t* dptr, size_t plane, size_t offset, int n,
+                                       const float* pad) {
+            for (int c = 0; c < 3; ++c) {
+                memset(dptr + c * plane + offset, quant_i8(pad[c]), n);
+            }
+        }
+        static inline void pack_row(int8_t* dptr, size_t plane, size_t offset,
+                                    float* const* rows, int n) {
+            for (int c = 0; c < 3; ++c) {
+                const float* row = rows[c];
+                int8_t* dst = dptr + c * plane + offset;
+                int i = 0;
+                for (; i + 16 <= n; i += 16) {
+                    GI_FLOAT32_V4_t v;
+                    GiSetSubVectorFloat32V4(v, 0, GiLoadFloat32(row + i));
+                    GiSetSubVectorFloat32V4(v, 1, GiLoadFloat32(row + i + 4));
+                    GiSetSubVectorFloat32V4(v, 2, GiLoadFloat32(row + i + 8));
+                    GiSetSubVectorFloat32V4(v, 3, GiLoadFloat32(row + i + 12));
+                    GiStoreInt8(dst + i, GiCvtFromFloat32V4ToInt8(v));
+                }
+                for (; i < n; ++i) {
+                    dst[i] = quant_i8(row[i]);
+                }
+            }
+        }
+    )";
+    }
+    CC_ASSERT(dst_format == "NCHW44");
+    //! 4 pixels of the 3 channel planes are transposed to 4 pixel vectors
+    //! with the 4th channel zeroed
+    std::string interleave = R"(
+        static inline void interleave_c3_to_c4(const float* r0, const float* r1,
+                                               const float* r2, GI_FLOAT32_t* pixels) {
+            GI_FLOAT32_V2_t z02 = GiZipqFloat32(GiLoadFloat32(r0), GiLoadFloat32(r2));
+            GI_FLOAT32_V2_t z1z =
+                    GiZipqFloat32(GiLoadFloat32(r1), GiBroadcastFloat32(0.f));
+            GI_FLOAT32_V2_t lo = GiZipqFloat32(
+                    GiGetSubVectorFloat32V2(z02, 0), GiGetSubVectorFloat32V2(z1z, 0));
+            GI_FLOAT32_V2_t hi = GiZipqFloat32(
+                    GiGetSubVectorFloat32V2(z02, 1), GiGetSubVectorFloat32V2(z1z, 1));
+            pixels[0] = GiGetSubVectorFloat32V2(lo, 0);
+            pixels[1] = GiGetSubVectorFloat32V2(lo, 1);
+            pixels[2] = GiGetSubVectorFloat32V2(hi, 0);
+            pixels[3] = GiGetSubVectorFloat32V2(hi, 1);
+        }
+    )";
+    if (!is_int8) {
+        return interleave + R"(
+        static inline void fill_pixels(float* dptr, size_t plane, size_t offset, int n,
+                                       const float* pad) {
+            (void)plane;
+            alignas(16) float pattern[4] = {pad[0], pad[1], pad[2], 0.f};
+            GI_FLOAT32_t v_pad = GiLoadFloat32(pattern);
+            float* dst = dptr + offset * 4;
+            for (int i = 0; i < n; ++i) {
+                GiStoreFloat32(dst + i * 4, v_pad);
+            }
+        }
+        static inline void pack_row(float* dptr, size_t plane, size_t offset,
+                                    float* const* rows, int n) {
+            (void)plane;
+            float* dst = dptr + offset * 4;
+            int i = 0;
+            for (; i + 4 <= n; i += 4) {
+                GI_FLOAT32_t pixels[4];
+                interleave_c3_to_c4(rows[0] + i, rows[1] + i, rows[2] + i, pixels);
+                GiStoreFloat32(dst + i * 4, pixels[0]);
+                GiStoreFloat32(dst + i * 4 + 4, pixels[1]);
+                GiStoreFloat32(dst + i * 4 + 8, pixels[2]);
+                GiStoreFloat32(dst + i * 4 + 12, pixels[3]);
+            }
+            for (; i < n; ++i) {
+                dst[i * 4 + 0] = rows[0][i];
+                dst[i * 4 + 1] = rows[1][i];
+                dst[i * 4 + 2] = rows[2][i];
+                dst[i * 4 + 3] = 0.f;
+            }
+        }
+    )";
+    }
+    return quant_func + interleave + R"(
+        static inline void fill_pixels(int8_t* dptr, size_t plane, size_t offset, int n,
+                                       const float* pad) {
+            (void)plane;
+            const int8_t pattern[4] = {quant_i8(pad[0]), quant_i8(pad[1]),
+                                       quant_i8(pad[2]), 0};
+            int8_t* dst = dptr + offset * 4;
+            for (int i = 0; i < n; ++i) {
+                memcpy(dst + i * 4, pattern, 4);
+            }
+        }
+        static inline void pack_row(int8_t* dptr, size_t plane, size_t offset,
+                                    float* const* rows, int n) {
+            (void)plane;
+            int8_t* dst = dptr + offset * 4;
+            int i = 0;
+            for (; i + 4 <= n; i += 4) {
+                GI_FLOAT32_t pixels[4];
+                interleave_c3_to_c4(rows[0] + i, rows[1] + i, rows[2] + i, pixels);
+                GI_FLOAT32_V4_t v;
+                GiSetSubVectorFloat32V4(v, 0, pixels[0]);
+                GiSetSubVectorFloat32V4(v, 1, pixels[1]);
+                GiSetSubVectorFloat32V4(v, 2, pixels[2]);
+                GiSetSubVectorFloat32V4(v, 3, pixels[3]);
+                GiStoreInt8(dst + i * 4, GiCvtFromFloat32V4ToInt8(v));
+            }
+            for (; i < n; ++i) {
+                dst[i * 4 + 0] = quant_i8(rows[0][i]);
+                dst[i * 4 + 1] = quant_i8(rows[1][i]);
+                dst[i * 4 + 2] = quant_i8(rows[2][i]);
+                dst[i * 4 + 3] = 0;
+            }
+        }
+    )";
+}
+
+//! the json config names the int8 output i8 and the test si8
+bool is_int8_dtype(const std::string& dtype) {
+    return dtype == "i8" || dtype == "si8";
+}
+
+}  // namespace
+
+bool PreprocessKernel::IsCVAvailable(TContext* context) const {
+    auto src_format = context->getAttrStr("src_format");
+    auto dst_format = context->getAttrStr("dst_format");
+    auto dst_dtype = context->getAttrOprand("operand:1").dtype;
+    bool src_ok = src_format == "BGR" || src_format == "NV21";
+    bool dst_ok = dst_format == "NCHW" || dst_format == "NCHW44";
+    bool dtype_ok = dst_dtype == "f32" || is_int8_dtype(dst_dtype);
+    return src_ok && dst_ok && dtype_ok;
+}
+
+//! kernel gen
+std::string PreprocessKernel::GetCVKernelSubSymbol(TContext* context) const {
+    std::stringstream ss;
+    auto src_format = context->getAttrStr("src_format");
+    auto dst_format = context->getAttrStr("dst_format");
+    std::transform(src_format.begin(), src_format.end(), src_format.begin(), ::tolower);
+    std::transform(dst_format.begin(), dst_format.end(), dst_format.begin(), ::tolower);
+    auto dst_dtype = context->getAttrOprand("operand:1").dtype;
+    ss << "tinycv_preprocess_" << src_format << "_" << dst_format << "_"
+       << (is_int8_dtype(dst_dtype) ? "i8" : dst_dtype);
+    return ss.str();
+}
+
+std::string PreprocessKernel::GetCVKernelSignature(TContext* context) const {
+    return GetCVKernelSymbol(context) +
+           "(const TinyMat* src, const TinyMat* dst, const TinyPreprocessParam* "
+           "param)";
+}
+
+std::string PreprocessKernel::GetCVKernelBody(TContext* context) const {
+    auto src_format = context->getAttrStr("src_format");
+    auto dst_format = context->getAttrStr("dst_format");
+    auto dst_dtype = context->getAttrOprand("operand:1").dtype;
+    bool int8_out = is_int8_dtype(dst_dtype);
+    bool direct_store = dst_format == "NCHW" && !int8_out;
+    std::string body_temp = R"(
+        #include <math.h>
+        #include <stdalign.h>
+        #include <string.h>
+        #include "gi_float.h"
+        #include "gi_int.h"
+        #include "tinycv_c.h"
+        #include "utils.h"
+
+        ${load_pixel}
+        ${store_func}
+
+        //! half pixel centers as tinycv_resize_linear, a source of length 1
+        //! gets ratio 0 and its neighbour step is 0 in the caller
+        static inline void build_tabs(int src_len, int dst_len, int* tab_idx,
+                                      float* tab_ratio) {
+            const float inv_scale = (float)src_len / dst_len;
+            for (int i = 0; i < dst_len; ++i) {
+                float r = (i + 0.5f) * inv_scale - 0.5f;
+                int s = (int)floorf(r);
+                r -= s;
+                if (s < 0) {
+                    s = 0;
+                    r = 0.f;
+                } else if (s + 1 >= src_len) {
+                    s = src_len > 1 ? src_len - 2 : 0;
+                    r = src_len > 1 ? 1.f : 0.f;
+                }
+                tab_idx[i] = s;
+                tab_ratio[i] = r;
+            }
+        }
+
+        //! horizontal pass of one source row into 3 planes of n floats in dst
+        //! channel order
+        static inline void calc_cache(const uint8_t* sptr, int src_rows, int src_cols,
+                                      int sy, const int* tab_x, const float* tab_rx,
+                                      int x_step, int b_idx, int n, float* cache) {
+            float* cache_b = cache + b_idx * n;
+            float* cache_g = cache + n;
+            float* cache_r = cache + (2 - b_idx) * n;
+            for (int dx = 0; dx < n; ++dx) {
+                int b0, g0, r0, b1, g1, r1;
+                load_pixel(sptr, src_rows, src_cols, sy, tab_x[dx], &b0, &g0, &r0);
+                load_pixel(sptr, src_rows, src_cols, sy, tab_x[dx] + x_step, &b1, &g1,
+                           &r1);
+                float rx = tab_rx[dx];
+                cache_b[dx] = b0 + (b1 - b0) * rx;
+                cache_g[dx] = g0 + (g1 - g0) * rx;
+                cache_r[dx] = r0 + (r1 - r0) * rx;
+            }
+        }
+
+        //! vertical pass fused with normalize, out = (c0 * (1 - ry) + c1 * ry) *
+        //! scale + bias
+        static inline void vertical_norm(const float* cache0, const float* cache1,
+                                         int n, float ry, const float* scale,
+                                         const float* bias, float* const* out) {
+            for (int c = 0; c < 3; ++c) {
+                const float* c0 = cache0 + c * n;
+                const float* c1 = cache1 + c * n;
+                float* dst = out[c];
+                const float w1 = ry * scale[c];
+                const float w0 = scale[c] - w1;
+                GI_FLOAT32_t v_w0 = GiBroadcastFloat32(w0);
+                GI_FLOAT32_t v_w1 = GiBroadcastFloat32(w1);
+                GI_FLOAT32_t v_bias = GiBroadcastFloat32(bias[c]);
+                int i = 0;
+                for (; i + 8 <= n; i += 8) {
+                    GI_FLOAT32_t a0 = GiMlaqFloat32(v_bias, GiLoadFloat32(c0 + i), v_w0);
+                    GI_FLOAT32_t a1 =
+                            GiMlaqFloat32(v_bias, GiLoadFloat32(c0 + i + 4), v_w0);
+                    a0 = GiMlaqFloat32(a0, GiLoadFloat32(c1 + i), v_w1);
+                    a1 = GiMlaqFloat32(a1, GiLoadFloat32(c1 + i + 4), v_w1);
+                    GiStoreFloat32(dst + i, a0);
+                    GiStoreFloat32(dst + i + 4, a1);
+                }
+                if (i + 4 <= n) {
+                    GI_FLOAT32_t a0 = GiMlaqFloat32(v_bias, GiLoadFloat32(c0 + i), v_w0);
+                    a0 = GiMlaqFloat32(a0, GiLoadFloat32(c1 + i), v_w1);
+                    GiStoreFloat32(dst + i, a0);
+                    i += 4;
+                }
+                for (; i < n; ++i) {
+                    dst[i] = c0[i] * w0 + c1[i] * w1 + bias[c];
+                }
+            }
+        }
+
+        void ${kernel_sig}{
+            const uint8_t* sptr = (const uint8_t*)src->data;
+            ${dst_specifier}* dptr = (${dst_specifier}*)dst->data;
+            const int src_rows = ${src_rows};
+            const int src_cols = src->cols;
+            const int dst_rows = dst->rows;
+            const int dst_cols = dst->cols;
+            const size_t plane = (size_t)dst_rows * dst_cols;
+            const int RH = param->resize_rows;
+            const int RW = param->resize_cols;
+            const int top = param->top;
+            const int left = param->left;
+            const int b_idx = param->swap_rb ? 2 : 0;
+
+            //! (x - mean) / std folded to x * scale + bias, int8 output also
+            //! folds the quantization scale
+            const float out_scale = ${out_scale};
+            float scale[3], bias[3], pad[3];
+            for (int c = 0; c < 3; ++c) {
+                scale[c] = out_scale / param->std[c];
+                bias[c] = -param->mean[c] * scale[c];
+                pad[c] = param->pad_value * scale[c] + bias[c];
+            }
+
+            //! the tables, the two cached rows and the packed row are taken
+            //! from the workspace instead of the stack, as the resize is only
+            //! known at runtime. Every buffer is padded to 4 floats
+            const int RH4 = (RH + 3) / 4 * 4;
+            const int RW4 = (RW + 3) / 4 * 4;
+            float* workspace = (float*)tinynn_malloc(
+                    (RH4 * 2 + RW4 * ${nr_row_buffer}) * sizeof(float));
+            TINYNN_ASSERT(workspace);
+            int* tab_y = (int*)workspace;
+            float* tab_ry = workspace + RH4;
+            int* tab_x = (int*)(tab_ry + RH4);
+            float* tab_rx = (float*)(tab_x + RW4);
+            float* cache0 = tab_rx + RW4;
+            float* cache1 = cache0 + 3 * RW4;
+            ${rowbuf_decl}
+            build_tabs(src_rows, RH, tab_y, tab_ry);
+            build_tabs(src_cols, RW, tab_x, tab_rx);
+            const int x_step = src_cols > 1;
+            const int y_step = src_rows > 1;
+
+            int cache0_row = -1, cache1_row = -1;
+            for (int y = 0; y < dst_rows; ++y) {
+                const size_t row_offset = (size_t)y * dst_cols;
+                if (y < top || y >= top + RH) {
+                    fill_pixels(dptr, plane, row_offset, dst_cols, pad);
+                    continue;
+                }
+                const int sy = tab_y[y - top];
+                const int sy1 = sy + y_step;
+                if (cache0_row != sy) {
+                    if (cache1_row == sy) {
+                        float* temp = cache0;
+                        cache0 = cache1;
+                        cache1 = temp;
+                        cache1_row = cache0_row;
+                    } else {
+                        calc_cache(sptr, src_rows, src_cols, sy, tab_x, tab_rx, x_step,
+                                   b_idx, RW, cache0);
+                    }
+                    cache0_row = sy;
+                }
+                if (cache1_row != sy1) {
+                    calc_cache(sptr, src_rows, src_cols, sy1, tab_x, tab_rx, x_step,
+                               b_idx, RW, cache1);
+                    cache1_row = sy1;
+                }
+
+                fill_pixels(dptr, plane, row_offset, left, pad);
+                float* out[3];
+                ${set_out}
+                vertical_norm(cache0, cache1, RW, tab_ry[y - top], scale, bias, out);
+                ${pack}
+                fill_pixels(dptr, plane, row_offset + left + RW, dst_cols - left - RW, pad);
+            }
+            tinynn_free(workspace);
+        }
+    )";
+    std::string set_out, pack, rowbuf_decl;
+    if (direct_store) {
+        set_out = R"(for (int c = 0; c < 3; ++c) {
+                    out[c] = dptr + c * plane + row_offset + left;
+                })";
+    } else {
+        rowbuf_decl = "float* rowbuf = cache1 + 3 * RW4;";
+        set_out = R"(for (int c = 0; c < 3; ++c) {
+                    out[c] = rowbuf + c * RW;
+                })";
+        pack = "pack_row(dptr, plane, row_offset + left, out, RW);";
+    }
+    return StringTemplate::StringTemplateArgs()
+            .add("kernel_sig", GetCVKernelSignature(context))
+            .add("load_pixel", gen_load_pixel(src_format))
+            .add("store_func", gen_store_func(dst_format, int8_out))
+            .add("dst_specifier", Utils::cvt_dtype_specifier(dst_dtype))
+            .add("src_rows",
+                 src_format == "NV21" ? "src->rows * 2 / 3" : "src->rows")
+            .add("out_scale", int8_out ? "1.f / param->dst_scale" : "1.f")
+            .add("rowbuf_decl", rowbuf_decl)
+            .add("nr_row_buffer", direct_store ? 8 : 11)
+            .add("set_out", set_out)
+            .add("pack", pack)
+            .render(body_temp);
+}
+
+// vim: syntax=cpp.doxygen
@@ -0,0 +1,20 @@
+#pragma once
+#include "CvCommon.h"
+#include "compiler/KernelGen/KernelGen.h"
+namespace megcc {
+namespace KernelGen {
+namespace GeneralIntrinsic {
+
+//! fused letterbox resize + color convert + normalize + relayout, which writes
+//! the network input tensor from an uint8 BGR or NV21 image in one pass
+class PreprocessKernel : public CVKernelImpl {
+public:
+    bool IsCVAvailable(TContext* context) const override;
+    std::string GetCVKernelBody(TContext* context) const override;
+    std::string GetCVKernelSubSymbol(TContext* context) const override;
+    std::string GetCVKernelSignature(TContext* context) const override;
+};
+
+}  // namespace GeneralIntrinsic
+}  // namespace KernelGen
+}  // namespace megcc
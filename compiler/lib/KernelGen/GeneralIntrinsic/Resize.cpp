@@ -10,10 +10,74 @@ using namespace megcc;
 using namespace KernelGen;
 using namespace GeneralIntrinsic;
 
+namespace {
+//! repeat every pixel of a src row fw times, the 2x case of 1, 2 and 4 byte
+//! pixels zips a vector with itself and a 16 byte pixel is a whole vector
+std::string gen_gi_dup_row(const std::string& specifier) {
+    return StringTemplate::StringTemplateArgs()
+            .add("specifier", specifier)
+            .render(R"(
+        static inline void dup_row(${specifier}* dst_ptr, const ${specifier}* src_ptr,
+                                   int IW, int fw, int pix) {
+            const int pix_bytes = pix * sizeof(${specifier});
+            int8_t* dst = (int8_t*)dst_ptr;
+            const int8_t* src = (const int8_t*)src_ptr;
+            int iw = 0;
+            if (fw == 2 && pix_bytes == 1) {
+                for (; iw + 16 <= IW; iw += 16) {
+                    GI_INT8_t v = GiLoadInt8(src + iw);
+                    GiStoreInt8(dst + 2 * iw, GiZipV0Int8(v, v));
+                    GiStoreInt8(dst + 2 * iw + 16, GiZipV1Int8(v, v));
+                }
+            } else if (fw == 2 && pix_bytes == 2) {
+                for (; iw + 8 <= IW; iw += 8) {
+                    GI_INT16_t v = GiLoadInt16(src + 2 * iw);
+                    GiStoreInt16(dst + 4 * iw, GiZipV0Int16(v, v));
+                    GiStoreInt16(dst + 4 * iw + 16, GiZipV1Int16(v, v));
+                }
+            } else if (fw == 2 && pix_bytes == 4) {
+                for (; iw + 4 <= IW; iw += 4) {
+                    GI_INT32_t v = GiLoadInt32(src + 4 * iw);
+                    GiStoreInt32(dst + 8 * iw, GiZipV0Int32(v, v));
+                    GiStoreInt32(dst + 8 * iw + 16, GiZipV1Int32(v, v));
+                }
+            } else if (pix_bytes == 16) {
+                for (; iw < IW; ++iw) {
+                    GI_INT8_t v = GiLoadInt8(src + 16 * iw);
+                    rep(k, fw) {
+                        GiStoreInt8(dst + (iw * fw + k) * 16, v);
+                    }
+                }
+            }
+            if (pix == 1) {
+                for (; iw < IW; ++iw) {
+                    ${specifier} val = src_ptr[iw];
+                    rep(k, fw) {
+                        dst_ptr[iw * fw + k] = val;
+                    }
+                }
+            } else {
+                for (; iw < IW; ++iw) {
+                    rep(k, fw) {
+                        memcpy(dst + (iw * fw + k) * pix_bytes, src + iw * pix_bytes,
+                               pix_bytes);
+                    }
+                }
+            }
+        }
+    )");
+}
+}  // namespace
+
 bool ResizeKernel::IsAvailable(TContext* context) const {
     auto src_dtype = context->getAttrOprand("operand:0").dtype;
+    auto imode = context->getAttrStr("imode");
+    if (imode == "NEAREST") {
+        return ResizeHelper::is_dtype_ok(context) &&
+               ResizeHelper::is_format_ok(context);
+    }
     bool dtype_ok = src_dtype == "f32";
-    bool mode_ok = context->getAttrStr("imode") == "LINEAR";
+    bool mode_ok = imode == "LINEAR";
     bool format_ok = context->getAttrStr("format") == "NCHW" ||
                      context->getAttrStr("format") == "NCHW44";
     return dtype_ok && mode_ok && format_ok;
@@ -24,7 +88,8 @@ std::string ResizeKernel::GetKernelSymbol(TContext* context) const {
     auto src_dtype = context->getAttrOprand("operand:0").dtype;
     auto fmt = context->getAttrStr("format");
     auto imode = context->getAttrStr("imode");
-    ss << "GI_kernel_resize_linear_" << fmt << "_" << imode << "_" << src_dtype;
+    ss << "GI_kernel_resize_linear_" << fmt << "_" << imode << "_"
+       << SymbolHelper::gen_valid_dtype(src_dtype);
     return ss.str();
 }
 
@@ -32,8 +97,45 @@ std::string ResizeKernel::GetKernelBody(TContext* context) const {
     std::stringstream ss;
     auto src_dtype = context->getAttrOprand("operand:0").dtype;
     auto fmt = context->getAttrStr("format");
-    auto specifier = Utils::cvt_dtype_specifier(src_dtype);
     auto imode = context->getAttrStr("imode");
+    if (imode == "NEAREST") {
+        //! nearest only moves the values, so it works on the storage type
+        auto specifier = Utils::get_common_dtype_specifier(
+                Utils::get_dtype_size(src_dtype));
+        ss << R"(
+        #include <string.h>
+        #include "gi_int.h"
+        #define rep(i, n) for (int i = 0; i < (n); ++i)
+        #define MIN(x, y) ((x) < (y) ? (x) : (y))
+    )";
+        ss << gen_gi_dup_row(specifier);
+        ss << ResizeHelper::GenGetOffset(fmt);
+        ss << GenCommonRet() << " " << GetKernelSignature(context);
+        ss << StringTemplate::StringTemplateArgs()
+                        .add("specifier", specifier)
+                        .add("gen_layout_dims", ResizeHelper::GenLayoutDims(fmt))
+                        .add("nearest_impl",
+                             ResizeHelper::GenNearestImpl(fmt, specifier))
+                        .render(R"({
+        const Tensor* src_tensor = inputs[0];
+        const Tensor* dst_tensor = outputs[0];
+        ${specifier}* sptr = (${specifier}*)(src_tensor->ptr);
+        ${specifier}* dptr = (${specifier}*)(dst_tensor->ptr);
+        TINYNN_ASSERT(sptr);
+        TINYNN_ASSERT(dptr);
+
+        const Layout src_layout = src_tensor->layout;
+        const Layout dst_layout = dst_tensor->layout;
+        ${gen_layout_dims}
+        float scale_h = (float)(OH) / IH;
+        float scale_w = (float)(OW) / IW;
+
+        ${nearest_impl}
+        return TinyNN_SUCCESS;
+    })");
+        return ss.str();
+    }
+    auto specifier = Utils::cvt_dtype_specifier(src_dtype);
     ss << R"(
         #include <math.h>
         #include <stdalign.h>
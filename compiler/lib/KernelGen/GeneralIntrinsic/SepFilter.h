@@ -0,0 +1,20 @@
+#pragma once
+#include "CvCommon.h"
+#include "compiler/KernelGen/KernelGen.h"
+namespace megcc {
+namespace KernelGen {
+namespace GeneralIntrinsic {
+
+//! separable 2D filter with the kernels kx (horizontal) and ky (vertical)
+//! anchored at the center, a box filter is the constant kernel 1 / ksize
+class SepFilterKernel : public CVKernelImpl {
+public:
+    bool IsCVAvailable(TContext* context) const override;
+    std::string GetCVKernelBody(TContext* context) const override;
+    std::string GetCVKernelSubSymbol(TContext* context) const override;
+    std::string GetCVKernelSignature(TContext* context) const override;
+};
+
+}  // namespace GeneralIntrinsic
+}  // namespace KernelGen
+}  // namespace megcc
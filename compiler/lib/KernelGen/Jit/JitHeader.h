@@ -50,6 +50,8 @@ static std::string get_runtime_define() {
         typedef struct {
             float scale;
             uint8_t zero_point;
+            int nr_scale;
+            float* scales;
         } DTypeParam;
 
         typedef struct {
@@ -1,6 +1,8 @@
 #pragma once
+#include <algorithm>
 #include <sstream>
 #include <string>
+#include "Utils/Utils.h"
 #include "compiler/KernelGen/KernelGen.h"
 namespace megcc {
 namespace KernelGen {
@@ -13,6 +15,14 @@ public:
         }
         return dtype_str;
     }
+    //! a float attr in a kernel symbol, '-' and '.' are not valid there
+    static std::string gen_valid_float(float val) {
+        std::string str = Utils::ssprintf("%.9g", val);
+        std::replace(str.begin(), str.end(), '-', 'n');
+        std::replace(str.begin(), str.end(), '.', 'p');
+        std::replace(str.begin(), str.end(), '+', '_');
+        return str;
+    }
     static std::string gen_io_str(TContext* context) {
         std::stringstream ss;
         for (int i = 0; i < context->getAttrInt("nr_operands"); ++i) {
@@ -204,6 +204,15 @@ static inline bool is_test_mode(TContext* ctx) {
     return false;
 }
 
+//! the max ulp error which transcendental functions may trade for speed, it is set
+//! by the fast-math compile option, 0 means full precision
+static inline int get_fast_math_ulp(TContext* ctx) {
+    if (ctx && ctx->haveAttr("fast_math_ulp")) {
+        return ctx->getAttrInt("fast_math_ulp");
+    }
+    return 0;
+}
+
 static inline void cv_kern_sym_add_prefix(
         TContext* ctx, std::string prefix, std::stringstream& ss) {
     if (is_test_mode(ctx)) {
@@ -1,3 +1,5 @@
+#include <algorithm>
+#include <cmath>
 #include <memory>
 #include <set>
 
@@ -12,6 +14,7 @@
 #include "compiler/Dialect/MGB/IR/MGBDialect.h"
 #include "compiler/Target/Hako/hako_parse.h"
 #include "compiler/Target/MGB/dummy_loader.h"
+#include "compiler/Target/MGB/fp16_storage.h"
 #include "compiler/Target/MGB/helper.h"
 #include "compiler/Target/MGB/import.h"
 
@@ -20,6 +23,7 @@
 #include "megbrain/opr/blas.h"
 #include "megbrain/opr/dnn/adaptive_pooling.h"
 #include "megbrain/opr/dnn/convolution.h"
+#include "megbrain/opr/dnn/fake_quant.h"
 #include "megbrain/opr/dnn/pooling.h"
 #include "megbrain/opr/dnn/softmax.h"
 #include "megbrain/opr/imgproc.h"
@@ -27,6 +31,7 @@
 #include "megbrain/opr/io.h"
 #include "megbrain/opr/misc.h"
 #include "megbrain/opr/nn_int.h"
+#include "megbrain/opr/standalone/nms_opr.h"
 #include "megbrain/opr/tensor_manip.h"
 #include "megbrain/serialization/extern_c_opr.h"
 #include "megbrain/serialization/extern_c_opr_io.h"
@@ -511,6 +516,25 @@ private:
         return inputs;
     }
 
+    //! the per output channel scales of the filter tagged by
+    //! quantize_fake_quant_conv, the tag is the dtype scale so the scales
+    //! follow the filter through the relayout and the rename of gopt
+    ArrayAttr get_filter_scales(const DeviceTensorND& tensor) {
+        if (tensor.dtype().enumv() != ::megdnn::DTypeEnum::QuantizedS8) {
+            return {};
+        }
+        auto iter = m_per_channel_scales.find(
+                tensor.dtype().param<dtype::QuantizedS8>().scale);
+        if (iter == m_per_channel_scales.end()) {
+            return {};
+        }
+        CC_ASSERT(tensor.layout().total_nr_elems() % iter->second.size() == 0)
+                << "the filter " << tensor.layout().to_string()
+                << " mismatches its " << iter->second.size()
+                << " per channel scales\n";
+        return m_builder.getF32ArrayAttr(iter->second);
+    }
+
     MGB::ParamStorage& create_param_storage(
             VarNode* var, const DeviceTensorND& tensor, size_t idx) {
         std::string name = var->cname();
@@ -542,13 +566,126 @@ private:
             m_builder.setInsertionPointToStart(m_module.getBody());
             auto storage = m_builder.create<MGB::ParamStorage>(
                     m_builder.getUnknownLoc(), name, tensor_attr,
-                    var_to_shaped_type(var), 1);
+                    var_to_shaped_type(var), 1, get_filter_scales(tensor));
             storage.setPrivate();
             m_param_storage.emplace(id_str, storage);
         }
         return m_param_storage[id_str];
     }
 
+    //! store the float param weight of the matmul as int8 or int4 with a scale
+    //! for every m_weight_quant_group elements along K, the quantized weight is
+    //! always laid out as (N, K) and used with transposeB. Every 32 int4 values
+    //! of a row are packed into 16 bytes, the low nibble of byte j holds value j
+    //! and the high nibble holds value j + 16, so the kernels unpack them with
+    //! two shifts. Return a null value if the matmul can not be quantized
+    mlir::Value quantize_matmul_weight(opr::MatrixMul* matmul) {
+        using Format = opr::MatrixMul::Param::Format;
+        auto&& p = matmul->param();
+        auto src = matmul->input(0);
+        auto weight = matmul->input(1);
+        if (p.format != Format::DEFAULT || p.transposeA ||
+            src->dtype() != dtype::Float32() || src->shape().ndim != 2 ||
+            weight->shape().ndim != 2) {
+            return {};
+        }
+        auto provider = m_var2value.at(weight).getDefiningOp<MGB::ParamProvider>();
+        if (!provider) {
+            return {};
+        }
+        auto storage = SymbolTable::lookupNearestSymbolFrom<MGB::ParamStorage>(
+                provider, provider.nameAttr());
+        auto dense = storage.value().dyn_cast<DenseElementsAttr>();
+        if (!dense || !dense.getType().getElementType().isF32()) {
+            return {};
+        }
+        bool int4 = m_weight_quant_bits == 4;
+        size_t k = src->shape()[1];
+        size_t n = p.transposeB ? weight->shape()[0] : weight->shape()[1];
+        //! the int4 values are packed by the block of 32 along K
+        if (int4 && k % 32 != 0) {
+            return {};
+        }
+        //! the kernels take ceil(k / nr_group) rounded up to the int4 block as
+        //! the group, which is never larger than m_weight_quant_group, and the
+        //! last group keeps the rest of K
+        size_t nr_group = (k + m_weight_quant_group - 1) / m_weight_quant_group;
+        size_t align = int4 ? 32 : 1;
+        size_t group = ((k + nr_group - 1) / nr_group + align - 1) / align * align;
+        std::string name = storage.sym_name().str() + (int4 ? "_int4" : "_int8");
+        if (auto quant_storage = m_module.lookupSymbol<MGB::ParamStorage>(name)) {
+            quant_storage.user_countAttr(m_builder.getI32IntegerAttr(
+                    quant_storage.user_count() + 1));
+            return m_builder.create<MGB::ParamProvider>(
+                    m_builder.getUnknownLoc(), quant_storage);
+        }
+
+        std::vector<float> value(
+                dense.getValues<float>().begin(), dense.getValues<float>().end());
+        auto weight_at = [&](size_t n_idx, size_t k_idx) {
+            return p.transposeB ? value[n_idx * k + k_idx] : value[k_idx * n + n_idx];
+        };
+        size_t row_bytes = int4 ? k / 2 : k;
+        float qmax = int4 ? 7.f : 127.f;
+        std::vector<float> scales(n * nr_group);
+        DeviceTensorND qweight(
+                CompNode::default_cpu(), {n, row_bytes}, dtype::QuantizedS8(1.f));
+        int8_t* qptr = static_cast<int8_t*>(qweight.raw_ptr());
+        memset(qptr, 0, n * row_bytes);
+        for (size_t n_idx = 0; n_idx < n; ++n_idx) {
+            for (size_t g = 0; g < nr_group; ++g) {
+                float max_abs = 0.f;
+                size_t k_end = std::min((g + 1) * group, k);
+                for (size_t k_idx = g * group; k_idx < k_end; ++k_idx) {
+                    max_abs = std::max(max_abs, std::abs(weight_at(n_idx, k_idx)));
+                }
+                float scale = max_abs > 0.f ? max_abs / qmax : 1.f;
+                scales[n_idx * nr_group + g] = scale;
+                for (size_t k_idx = g * group; k_idx < k_end; ++k_idx) {
+                    float q_val = std::round(weight_at(n_idx, k_idx) / scale);
+                    int q = static_cast<int>(std::min(std::max(q_val, -qmax), qmax));
+                    int8_t* row = qptr + n_idx * row_bytes;
+                    if (!int4) {
+                        row[k_idx] = q;
+                    } else if (k_idx % 32 < 16) {
+                        row[k_idx / 32 * 16 + k_idx % 32] |= q & 0xf;
+                    } else {
+                        row[k_idx / 32 * 16 + k_idx % 32 - 16] |= (q & 0xf) << 4;
+                    }
+                }
+            }
+        }
+
+        MGB::ParamStorage quant_storage;
+        {
+            OpBuilder::InsertionGuard _(m_builder);
+            m_builder.setInsertionPointToStart(m_module.getBody());
+            quant_storage = m_builder.create<MGB::ParamStorage>(
+                    m_builder.getUnknownLoc(), name, dev_tensor_to_attr(qweight),
+                    tensorShapeToShapedType(m_context, qweight.shape(), qweight.dtype()),
+                    1, m_builder.getF32ArrayAttr(scales));
+            quant_storage.setPrivate();
+        }
+        return m_builder.create<MGB::ParamProvider>(
+                m_builder.getUnknownLoc(), quant_storage);
+    }
+
+    //! import the operator and name the location of the imported ops by the
+    //! mgb operator name, which is kept to the tinynn Opr for profiling
+    void on_opr_with_name(
+            cg::OperatorNodeBase* opr,
+            std::unordered_map<VarNode*, std::vector<cg::OperatorNodeBase*>>& input2opr,
+            size_t idx) {
+        Block* block = m_builder.getInsertionBlock();
+        Operation* last = block->empty() ? nullptr : &block->back();
+        on_opr(opr, input2opr, idx);
+        auto loc = mlir::NameLoc::get(m_builder.getStringAttr(opr->name()));
+        auto iter = last ? std::next(Block::iterator(last)) : block->begin();
+        for (; iter != block->end(); ++iter) {
+            iter->setLoc(loc);
+        }
+    }
+
     void on_opr(
             cg::OperatorNodeBase* opr,
             std::unordered_map<VarNode*, std::vector<cg::OperatorNodeBase*>>& input2opr,
@@ -727,10 +864,18 @@ private:
         } else if (auto matmul = opr->try_cast_final<opr::MatrixMul>()) {
             auto&& p = matmul->param();
             auto&& out = opr->output(0);
+            mlir::Value weight = m_var2value.at(opr->input(1));
+            bool transpose_b = p.transposeB;
+            if (m_weight_quant_bits) {
+                if (auto qweight = quantize_matmul_weight(matmul)) {
+                    weight = qweight;
+                    transpose_b = true;
+                }
+            }
             mlir::Value value = m_builder.create<mlir::MGB::MatrixMul>(
                     m_builder.getUnknownLoc(), var_to_shaped_type(out),
-                    m_var2value.at(opr->input(0)), m_var2value.at(opr->input(1)),
-                    p.transposeA, p.transposeB, p.compute_mode, p.format);
+                    m_var2value.at(opr->input(0)), weight, p.transposeA,
+                    transpose_b, p.compute_mode, p.format);
             m_var2value.emplace(out, value);
         } else if (auto batched_matmul = opr->try_cast_final<opr::BatchedMatrixMul>()) {
             auto&& p = batched_matmul->param();
@@ -943,6 +1088,13 @@ private:
                     m_builder.getUnknownLoc(), var_to_shaped_type(out_val),
                     m_var2value.at(opr->input(0)), param.axis);
             m_var2value.emplace(out_val, value);
+        } else if (auto arg_min = opr->try_cast_final<opr::Argmin>()) {
+            auto&& out_val = opr->output(0);
+            auto param = arg_min->param();
+            mlir::Value value = m_builder.create<mlir::MGB::Argmin>(
+                    m_builder.getUnknownLoc(), var_to_shaped_type(out_val),
+                    m_var2value.at(opr->input(0)), param.axis);
+            m_var2value.emplace(out_val, value);
         } else if (auto arg_topk = opr->try_cast_final<opr::TopK>()) {
             CC_ASSERT(arg_topk->output().size() >= 2)
                     << "only support size >= 2 , but " << arg_topk->output().size()
@@ -965,6 +1117,16 @@ private:
                     param.mode, k);
             m_var2value.emplace(out_val, values.getResult(0));
             m_var2value.emplace(out_index, values.getResult(1));
+        } else if (auto nms = opr->try_cast_final<opr::standalone::NMSKeep>()) {
+            auto&& out_idx = opr->output(0);
+            auto&& out_size = opr->output(1);
+            auto param = nms->param();
+            auto values = m_builder.create<mlir::MGB::NMSKeep>(
+                    m_builder.getUnknownLoc(), var_to_shaped_type(out_idx),
+                    var_to_shaped_type(out_size), m_var2value.at(opr->input(0)),
+                    param.iou_thresh, param.max_output);
+            m_var2value.emplace(out_idx, values.getResult(0));
+            m_var2value.emplace(out_size, values.getResult(1));
         } else if (auto idx_one = opr->try_cast_final<opr::IndexingOneHot>()) {
             auto&& out = opr->output(0);
             auto param = idx_one->param();
@@ -1206,6 +1368,410 @@ private:
         return dest_vars;
     }
 
+    //! copy the value of a float32 param var to value, return false if the var
+    //! is not a param
+    bool get_param_value(VarNode* var, HostTensorND& value) {
+        if (var->dtype() != dtype::Float32()) {
+            return false;
+        }
+        auto owner = var->owner_opr();
+        if (auto imm = owner->try_cast_final<opr::ImmutableTensor>()) {
+            value.copy_from(imm->host_value()).sync();
+            return true;
+        } else if (auto sd = owner->try_cast_final<opr::SharedDeviceTensor>()) {
+            value.copy_from(sd->get_dev_tensor()).sync();
+            return true;
+        }
+        return false;
+    }
+
+    //! the zero padding of the convolution is applied to the normalized input,
+    //! so only the unpadded dense NCHW convolution can fold the normalization
+    template <typename Param>
+    bool is_normalize_foldable(const Param& param) {
+        return param.format == Param::Format::NCHW &&
+               param.sparse == Param::Sparse::DENSE && param.pad_h == 0 &&
+               param.pad_w == 0;
+    }
+
+    //! return why the normalized input var can not be folded into its reader,
+    //! or an empty string if the reader is a foldable convolution
+    std::string normalize_unfoldable_reason(
+            cg::OperatorNodeBase* reader, VarNode* var) {
+        if (auto conv = reader->try_cast_final<opr::Convolution>()) {
+            if (!is_normalize_foldable(conv->param()))
+                return "is not an unpadded dense NCHW convolution";
+        } else if (auto conv = reader->try_cast_final<opr::ConvBiasForward>()) {
+            if (conv->input().size() != 3)
+                return "has the z input";
+            if (!is_normalize_foldable(conv->param()))
+                return "is not an unpadded dense NCHW convolution";
+        } else {
+            return "is not a convolution";
+        }
+        if (reader->input(0) != var)
+            return "does not read it as the src";
+        HostTensorND filter(CompNode::default_cpu());
+        if (!get_param_value(reader->input(1), filter))
+            return "has a non-constant filter";
+        return "";
+    }
+
+    //! scale the filter of shape (oc, ic, fh, fw) by 1 / std of ic inplace and
+    //! return the bias of shape (1, oc, 1, 1) which compensates the mean
+    HostTensorND fold_normalize_to_filter(
+            HostTensorND& filter, const std::vector<float>& mean,
+            const std::vector<float>& std) {
+        auto shape = filter.shape();
+        CC_ASSERT(shape.ndim == 4);
+        size_t oc = shape[0], ic = shape[1], kernel = shape[2] * shape[3];
+        HostTensorND bias(CompNode::default_cpu(), {1, oc, 1, 1}, dtype::Float32());
+        float* filter_ptr = filter.ptr<float>();
+        float* bias_ptr = bias.ptr<float>();
+        for (size_t o = 0; o < oc; ++o) {
+            float sum = 0.f;
+            for (size_t c = 0; c < ic; ++c) {
+                float mean_val = mean.size() == 1 ? mean[0] : mean[c];
+                float scale = 1.f / (std.size() == 1 ? std[0] : std[c]);
+                float* ptr = filter_ptr + (o * ic + c) * kernel;
+                for (size_t k = 0; k < kernel; ++k) {
+                    ptr[k] *= scale;
+                    sum += ptr[k] * mean_val;
+                }
+            }
+            bias_ptr[o] = -sum;
+        }
+        return bias;
+    }
+
+    //! fold the per channel `(x - mean) / std` of the 4-dim float inputs into
+    //! the filter and bias of the convolutions reading them. The inputs with
+    //! other readers get one explicit `x * (1 / std) + (-mean / std)` instead
+    SymbolVarArray fold_normalize_to_h2d(
+            const SymbolVarArray& dest_vars, const std::vector<float>& mean,
+            const std::vector<float>& std) {
+        CC_ASSERT(mean.size() == std.size() && !mean.empty())
+                << "input mean and std must have the same nonzero size\n";
+        ThinHashMap<VarNode*, std::vector<cg::OperatorNodeBase*>> readers;
+        std::vector<opr::Host2DeviceCopy*> inputs;
+        cg::DepOprIter dep([&](cg::OperatorNodeBase* opr) {
+            for (auto&& var : opr->input()) {
+                readers[var].push_back(opr);
+            }
+            if (auto h2d = opr->try_cast_final<opr::Host2DeviceCopy>()) {
+                auto var = h2d->output(0);
+                if (var->shape().ndim == 4 && var->dtype() == dtype::Float32()) {
+                    inputs.push_back(h2d);
+                }
+            }
+        });
+        for (auto&& i : dest_vars)
+            dep.add(i);
+
+        ThinHashMap<SymbolVar, SymbolVar> varmap;
+        for (auto h2d : inputs) {
+            auto var = h2d->output(0);
+            size_t channel = var->shape()[1];
+            CC_ASSERT(mean.size() == 1 || mean.size() == channel)
+                    << "input mean size " << mean.size() << " mismatch channel "
+                    << channel << " of " << h2d->name() << "\n";
+            auto&& input_readers = readers[var];
+            std::string reason = input_readers.empty() ? "it has no reader" : "";
+            for (auto reader : input_readers) {
+                if (!reason.empty())
+                    break;
+                reason = normalize_unfoldable_reason(reader, var);
+                if (!reason.empty()) {
+                    reason = "reader " + reader->name() + " (" +
+                             reader->dyn_typeinfo()->name + ") " + reason;
+                }
+            }
+            auto graph = h2d->owner_graph();
+            if (!reason.empty()) {
+                HostTensorND scale(
+                        CompNode::default_cpu(), {1, channel, 1, 1}, dtype::Float32());
+                HostTensorND shift(
+                        CompNode::default_cpu(), {1, channel, 1, 1}, dtype::Float32());
+                for (size_t c = 0; c < channel; ++c) {
+                    float mean_val = mean.size() == 1 ? mean[0] : mean[c];
+                    float std_val = std.size() == 1 ? std[0] : std[c];
+                    scale.ptr<float>()[c] = 1.f / std_val;
+                    shift.ptr<float>()[c] = -mean_val / std_val;
+                }
+                auto h2d_opr = opr::Host2DeviceCopy::make(
+                        *graph, h2d->host_data(), h2d->param(), h2d->config());
+                varmap[var] = opr::Elemwise::make(
+                        {h2d_opr, opr::ImmutableTensor::make(*graph, scale),
+                         opr::ImmutableTensor::make(*graph, shift)},
+                        opr::Elemwise::Mode::FUSE_MUL_ADD3);
+                LOG_WARN << "input normalize of " << h2d->name()
+                         << " can not be folded into convolution as " << reason
+                         << ", keep it as elemwise\n";
+                continue;
+            }
+            for (auto reader : input_readers) {
+                HostTensorND filter(CompNode::default_cpu());
+                get_param_value(reader->input(1), filter);
+                auto bias = opr::ImmutableTensor::make(
+                        *graph, fold_normalize_to_filter(filter, mean, std));
+                auto new_filter = opr::ImmutableTensor::make(*graph, filter);
+                if (auto conv = reader->try_cast_final<opr::Convolution>()) {
+                    auto new_conv = opr::Convolution::make(
+                            var, new_filter, conv->param(), conv->execution_policy(),
+                            conv->config());
+                    varmap[conv->output(0)] = opr::Elemwise::make(
+                            {new_conv, bias}, opr::Elemwise::Mode::ADD);
+                } else {
+                    auto conv = reader->try_cast_final<opr::ConvBiasForward>();
+                    auto new_bias = opr::Elemwise::make(
+                            {conv->input(2), bias}, opr::Elemwise::Mode::ADD);
+                    varmap[conv->output(0)] = opr::ConvBiasForward::make(
+                            var, new_filter, new_bias, conv->param(),
+                            conv->execution_policy(), conv->config());
+                }
+                LOG_INFO << "fold input normalize of " << h2d->name() << " into "
+                         << reader->name() << "\n";
+            }
+        }
+        if (!varmap.empty()) {
+            return cg::replace_vars(dest_vars, varmap);
+        }
+        return dest_vars;
+    }
+
+    //! read the scale of the symmetric int8 FakeQuant opr, return false if the
+    //! scale is not a param or the quantization is not symmetric int8
+    bool get_fake_quant_scale(cg::OperatorNodeBase* opr, std::vector<float>& scale) {
+        auto fq = opr->try_cast_final<opr::FakeQuant>();
+        if (!fq || fq->param().qmin < -128 || fq->param().qmax > 127) {
+            return false;
+        }
+        HostTensorND scale_value(CompNode::default_cpu()),
+                zero_point(CompNode::default_cpu());
+        if (!get_param_value(fq->input(1), scale_value) ||
+            !get_param_value(fq->input(2), zero_point)) {
+            return false;
+        }
+        for (size_t i = 0; i < zero_point.shape().total_nr_elems(); ++i) {
+            if (zero_point.ptr<float>()[i] != 0.f) {
+                return false;
+            }
+        }
+        auto ptr = scale_value.ptr<float>();
+        scale.assign(ptr, ptr + scale_value.shape().total_nr_elems());
+        return true;
+    }
+
+    //! rewrite one float convolution of a QAT graph
+    //! `FakeQuant(conv(FakeQuant(x), FakeQuant(w), b) [-> RELU])` to
+    //! `TypeCvt(ConvBias(qint8 x, qint8 w, qint32 b), float32)`, the filter
+    //! quantized per output channel gets a unique placeholder dtype scale as
+    //! the tag of its scales, return false if not matched
+    bool quantize_fake_quant_conv(
+            cg::OperatorNodeBase* conv,
+            ThinHashMap<VarNode*, std::vector<cg::OperatorNodeBase*>>& readers,
+            ThinHashMap<SymbolVar, SymbolVar>& varmap) {
+        using ConvBiasParam = opr::ConvBiasForward::Param;
+        ConvBiasParam param;
+        if (auto conv_opr = conv->try_cast_final<opr::Convolution>()) {
+            auto&& p = conv_opr->param();
+            param.mode = p.mode;
+            param.sparse = p.sparse;
+            param.format = p.format;
+            param.pad_h = p.pad_h;
+            param.pad_w = p.pad_w;
+            param.stride_h = p.stride_h;
+            param.stride_w = p.stride_w;
+            param.dilate_h = p.dilate_h;
+            param.dilate_w = p.dilate_w;
+            param.compute_mode = p.compute_mode;
+        } else if (auto conv_opr = conv->try_cast_final<opr::ConvBiasForward>()) {
+            if (conv->input().size() > 3) {
+                return false;
+            }
+            param = conv_opr->param();
+        } else {
+            return false;
+        }
+        auto out = conv->output(0);
+        if (param.format != ConvBiasParam::Format::NCHW ||
+            out->dtype() != dtype::Float32() || readers[out].size() != 1) {
+            return false;
+        }
+        //! the optional relu between the convolution and the output FakeQuant
+        auto fq_out = readers[out][0];
+        if (auto relu = fq_out->try_cast_final<opr::Elemwise>()) {
+            if (relu->param().mode != opr::Elemwise::Mode::RELU ||
+                param.nonlineMode != ConvBiasParam::NonlineMode::IDENTITY ||
+                readers[relu->output(0)].size() != 1) {
+                return false;
+            }
+            param.nonlineMode = ConvBiasParam::NonlineMode::RELU;
+            fq_out = readers[relu->output(0)][0];
+        }
+        std::vector<float> src_scale, dst_scale, flt_scale;
+        auto fq_src = conv->input(0)->owner_opr();
+        auto fq_flt = conv->input(1)->owner_opr();
+        if (!get_fake_quant_scale(fq_out, dst_scale) || dst_scale.size() != 1 ||
+            !get_fake_quant_scale(fq_src, src_scale) || src_scale.size() != 1 ||
+            !get_fake_quant_scale(fq_flt, flt_scale)) {
+            return false;
+        }
+        HostTensorND filter(CompNode::default_cpu());
+        if (!get_param_value(fq_flt->input(0), filter)) {
+            return false;
+        }
+        auto flt_shape = filter.shape();
+        size_t oc = param.sparse == ConvBiasParam::Sparse::GROUP
+                          ? flt_shape[0] * flt_shape[1]
+                          : flt_shape[0];
+        if (flt_scale.size() != 1 && flt_scale.size() != oc) {
+            return false;
+        }
+        HostTensorND bias(CompNode::default_cpu());
+        bool with_bias = conv->input().size() == 3;
+        if (with_bias && (!get_param_value(conv->input(2), bias) ||
+                          bias.shape().total_nr_elems() != oc)) {
+            return false;
+        }
+
+        flt_scale.resize(oc, flt_scale[0]);
+        bool per_channel =
+                std::any_of(flt_scale.begin(), flt_scale.end(), [&](float scale) {
+                    return scale != flt_scale[0];
+                });
+        float sx = src_scale[0];
+        float sw = flt_scale[0];
+        if (per_channel) {
+            m_scale_tag = std::nextafter(m_scale_tag, 2.f);
+            sw = m_scale_tag;
+            m_per_channel_scales[sw] = flt_scale;
+        }
+        auto fq_param = fq_flt->cast_final_safe<opr::FakeQuant>().param();
+        HostTensorND qfilter(
+                CompNode::default_cpu(), flt_shape, dtype::QuantizedS8(sw));
+        auto flt_ptr = filter.ptr<float>();
+        auto qflt_ptr = reinterpret_cast<int8_t*>(qfilter.raw_ptr());
+        size_t oc_stride = flt_shape.total_nr_elems() / oc;
+        for (size_t i = 0; i < flt_shape.total_nr_elems(); ++i) {
+            float q = std::round(flt_ptr[i] / flt_scale[i / oc_stride]);
+            q = std::min<float>(std::max<float>(q, fq_param.qmin), fq_param.qmax);
+            qflt_ptr[i] = static_cast<int8_t>(q);
+        }
+        //! the bias is quantized by the scale of every output channel, and the
+        //! kernels requantize the accumulator by the same scale
+        HostTensorND qbias(
+                CompNode::default_cpu(), {1, oc, 1, 1}, dtype::QuantizedS32(sx * sw));
+        auto qbias_ptr = reinterpret_cast<int32_t*>(qbias.raw_ptr());
+        for (size_t i = 0; i < oc; ++i) {
+            float value = with_bias ? bias.ptr<float>()[i] / (sx * flt_scale[i]) : 0.f;
+            qbias_ptr[i] = static_cast<int32_t>(std::round(value));
+        }
+
+        //! reuse the int8 output of the previous rewritten convolution
+        auto graph = conv->owner_graph();
+        SymbolVar src = fq_src->input(0);
+        auto typecvt = src.node()->owner_opr()->try_cast_final<opr::TypeCvt>();
+        if (typecvt && typecvt->input(0)->dtype() == dtype::QuantizedS8(sx)) {
+            src = typecvt->input(0);
+        } else {
+            src = opr::TypeCvt::make(src, dtype::QuantizedS8(sx));
+        }
+        OperatorNodeConfig config = conv->config();
+        config.output_dtype(dtype::QuantizedS8(dst_scale[0]));
+        auto conv_bias = opr::ConvBiasForward::make(
+                src, opr::ImmutableTensor::make(*graph, qfilter),
+                opr::ImmutableTensor::make(*graph, qbias), param, {}, config);
+        varmap[fq_out->output(0)] = opr::TypeCvt::make(conv_bias, dtype::Float32());
+        LOG_DEBUG << "quantize fake quant convolution " << conv->name()
+                  << (per_channel ? " with per channel scales\n" : "\n");
+        return true;
+    }
+
+    //! convert the float convolutions of a QAT graph with FakeQuant to int8
+    //! ConvBias one by one, so that a convolution reads the int8 output of the
+    //! rewritten one before it. The other FakeQuant oprs are removed
+    SymbolVarArray quantize_fake_quant(const SymbolVarArray& dest_vars) {
+        SymbolVarArray vars = dest_vars;
+        while (true) {
+            ThinHashMap<VarNode*, std::vector<cg::OperatorNodeBase*>> readers;
+            std::vector<cg::OperatorNodeBase*> convs;
+            cg::DepOprIter dep([&](cg::OperatorNodeBase* opr) {
+                for (auto&& var : opr->input()) {
+                    readers[var].push_back(opr);
+                }
+                if (opr->same_type<opr::Convolution>() ||
+                    opr->same_type<opr::ConvBiasForward>()) {
+                    convs.push_back(opr);
+                }
+            });
+            for (auto&& i : vars)
+                dep.add(i);
+            ThinHashMap<SymbolVar, SymbolVar> varmap;
+            for (auto conv : convs) {
+                if (quantize_fake_quant_conv(conv, readers, varmap)) {
+                    break;
+                }
+            }
+            if (varmap.empty()) {
+                break;
+            }
+            vars = cg::replace_vars(vars, varmap);
+        }
+        ThinHashMap<SymbolVar, SymbolVar> varmap;
+        cg::DepOprIter dep([&](cg::OperatorNodeBase* opr) {
+            if (opr->same_type<opr::FakeQuant>()) {
+                varmap[opr->output(0)] = opr->input(0);
+                LOG_WARN << "remove FakeQuant " << opr->name()
+                         << " which is not around a convolution\n";
+            }
+        });
+        for (auto&& i : vars)
+            dep.add(i);
+        if (!varmap.empty()) {
+            return cg::replace_vars(vars, varmap);
+        }
+        return vars;
+    }
+
+    SymbolVarArray append_typecvt_to_h2d(
+            const SymbolVarArray& dest_vars,
+            serialization::GraphLoader::LoadResult::TensorMap& tensor_map) {
+        ThinHashMap<SymbolVar, SymbolVar> varmap;
+        cg::DepOprIter dep([&](cg::OperatorNodeBase* opr) {
+            if (auto h2d = opr->try_cast_final<opr::Host2DeviceCopy>()) {
+                if (h2d->output(0)->shape().ndim != 4 ||
+                    h2d->output(0)->dtype() != dtype::Float32()) {
+                    return;
+                }
+                auto host_data = h2d->host_data();
+                std::shared_ptr<HostTensorND> host_data_new =
+                        std::make_shared<HostTensorND>(
+                                host_data->comp_node(), host_data->shape(),
+                                dtype::Uint8());
+                std::string old_name = h2d->name();
+                for (auto kv : tensor_map) {
+                    if (kv.second == host_data) {
+                        old_name = kv.first;
+                    }
+                }
+                tensor_map[old_name] = host_data_new;
+                auto h2d_opr = opr::Host2DeviceCopy::make(
+                        *h2d->owner_graph(), host_data_new, h2d->param(),
+                        h2d->config());
+                varmap[h2d->output(0)] = opr::TypeCvt::make(h2d_opr, dtype::Float32());
+                LOG_DEBUG << "add uint8 typecvt to h2d: " << h2d->name() << ", shape "
+                          << h2d->output(0)->shape().to_string() << "\n";
+            }
+        });
+        for (auto&& i : dest_vars)
+            dep.add(i);
+        if (!varmap.empty()) {
+            return cg::replace_vars(dest_vars, varmap);
+        }
+        return dest_vars;
+    }
+
     SymbolVarArray append_reshape_to_h2d(
             const SymbolVarArray& dest_vars,
             std::vector<TensorShape>& input_tensorshape) {
@@ -1326,6 +1892,21 @@ private:
         OpBuilder::InsertionGuard _(m_builder);
         bool use_default_input_map = options.input_map_vec.empty();
         size_t nr_input = use_default_input_map ? 1 : options.input_map_vec.size();
+        CC_ASSERT(
+                options.weight_quant.empty() || options.weight_quant == "int8" ||
+                options.weight_quant == "int4")
+                << "unsupported weight quant " << options.weight_quant
+                << ", should be int8 or int4\n";
+        CC_ASSERT(options.weight_quant_group > 0)
+                << "invalid weight quant group " << options.weight_quant_group << "\n";
+        CC_ASSERT(options.weight_quant != "int4" || options.weight_quant_group % 32 == 0)
+                << "the int4 weight quant group should be a multiple of 32\n";
+        m_weight_quant_bits = options.weight_quant.empty()
+                                    ? 0
+                                    : (options.weight_quant == "int4" ? 4 : 8);
+        m_weight_quant_group = options.weight_quant_group;
+        CC_ASSERT(!options.enable_fp16_storage || !options.enable_ioc16)
+                << "fp16 storage can not be used with ioc16\n";
 
         for (size_t idx = 0; idx < nr_input; ++idx) {
             auto graph = m_loader->load(m_load_config, true);
@@ -1341,9 +1922,24 @@ private:
             output_vars = disable_h2d_mem_fwd(output_vars);
             output_vars = append_reshape_to_h2d(output_vars, input_tensorshape);
             output_vars = append_reshape_to_warpaffine(output_vars, input_tensorshape);
+            if (!options.input_mean.empty()) {
+                output_vars = fold_normalize_to_h2d(
+                        output_vars, options.input_mean, options.input_std);
+            }
+            if (options.quantize_fake_quant) {
+                output_vars = quantize_fake_quant(output_vars);
+            }
+            if (options.enable_fp16_storage) {
+                output_vars = fp16_storage(
+                        output_vars, load_fp16_calib_data(options.fp16_calib_data),
+                        options.fp16_error_budget, graph.tensor_map);
+            }
             if (options.add_nhwc2nchw_to_input) {
                 output_vars = append_nhwc2nchw_to_h2d(output_vars, graph.tensor_map);
             }
+            if (options.input_uint8) {
+                output_vars = append_typecvt_to_h2d(output_vars, graph.tensor_map);
+            }
 
             auto cg = output_vars[0].node()->owner_graph();
             cg->options().graph_opt_level = options.graph_opt_level;
@@ -1421,8 +2017,8 @@ private:
             });
             cg::ComputeDepOprIter dep(
                     std::bind(
-                            &Importer::on_opr, this, std::placeholders::_1,
-                            std::placeholders::_2, idx),
+                            &Importer::on_opr_with_name, this,
+                            std::placeholders::_1, std::placeholders::_2, idx),
                     varnode_to_used_opr);
             seq->iter_opr_seq([&](cg::OperatorNodeBase* op) {
                 dep.iter(op);
@@ -1454,6 +2050,14 @@ private:
     mlir::OpBuilder m_builder;
     std::unordered_map<cg::VarNode*, mlir::Value> m_var2value;
     std::unordered_map<std::string, MGB::ParamStorage> m_param_storage;
+    //! the per output channel filter scales by the placeholder dtype scale
+    //! of the filter, the tags are next to 1 and unlikely to be a real scale
+    std::unordered_map<float, std::vector<float>> m_per_channel_scales;
+    float m_scale_tag = 1.f;
+    //! the bits and the group size of the weight only quantized matmul, 0 bits
+    //! to keep the float weight
+    int m_weight_quant_bits = 0;
+    size_t m_weight_quant_group = 32;
 };
 
 mlir::LogicalResult removeUnusedParam(mlir::ModuleOp module) {
@@ -1538,6 +2142,41 @@ mlir::LogicalResult parseInputShapes(
     return mlir::success();
 }
 
+mlir::LogicalResult parseInputNormalize(
+        std::string mean, std::string std, mlir::MGB::MGBImporterOptions& options) {
+    if (mean.empty() && std.empty())
+        return mlir::success();
+    auto parse = [](std::string s, std::vector<float>& values) {
+        llvm::SmallVector<llvm::StringRef> items;
+        llvm::SplitString(s, items, ", ");
+        for (auto&& item : items) {
+            double value;
+            if (item.getAsDouble(value)) {
+                llvm::errs() << "invalid normalize value " << item << "\n";
+                return false;
+            }
+            values.push_back(value);
+        }
+        return true;
+    };
+    if (!parse(mean, options.input_mean) || !parse(std, options.input_std)) {
+        return mlir::failure();
+    }
+    if (options.input_mean.size() != options.input_std.size() ||
+        options.input_mean.empty()) {
+        llvm::errs() << "input mean " << mean << " and std " << std
+                     << " must have the same nonzero size\n";
+        return mlir::failure();
+    }
+    for (auto std_val : options.input_std) {
+        if (std_val == 0.f) {
+            llvm::errs() << "input std must be nonzero\n";
+            return mlir::failure();
+        }
+    }
+    return mlir::success();
+}
+
 }  // namespace MGB
 }  // namespace mlir
 
@@ -11,6 +11,7 @@
 #include "mlir/IR/BuiltinOps.h"
 
 #include <unordered_map>
+#include <unordered_set>
 
 extern llvm::cl::opt<megcc::KernelGen::Arch> target_arch;
 
@@ -56,7 +57,7 @@ public:
                     .Case([&](Kernel::WeightStorage op) {
                         weights.push_back(attr_to_weight(
                                 op.value(), op.sym_name(), op.user_count(),
-                                weight_compress));
+                                weight_compress, op.scalesAttr()));
                         symbol2weight_id[op.sym_name().str()] = weights.size() - 1;
                     })
                     .Case([&](Kernel::RawCodeKernelDef op) {
@@ -277,6 +278,70 @@ public:
             }
         }
 
+        //! a dynamic broadcast whose users only read it through its strides is
+        //! a stride 0 view of an input which lives through the whole run, and a
+        //! dynamic setsubtensor whose src is not used after it writes the value
+        //! in place into the src memory
+        std::unordered_set<Operation*> broadcast_views;
+        std::unordered_set<Operation*> inplace_setsubtensors;
+        auto is_dynamic_alloc = [](Value value) {
+            return value.getDefiningOp<Kernel::DynamicAlloc>() != nullptr;
+        };
+        auto is_view_user = [](OpOperand& use) {
+            Operation* user = use.getOwner();
+            if (llvm::isa<Kernel::SetSubtensorIns>(user)) {
+                return use.getOperandNumber() == 1;
+            }
+            return use.getOperandNumber() == 0 &&
+                   (llvm::isa<Kernel::BroadcastIns>(user) ||
+                    llvm::isa<Kernel::SubtensorIns>(user) ||
+                    llvm::isa<Kernel::DimshuffleIns>(user));
+        };
+        for (auto&& _ : block) {
+            if (auto op = llvm::dyn_cast<Kernel::BroadcastIns>(&_)) {
+                Value input = op->getOperand(0);
+                bool input_alive = input.isa<BlockArgument>() ||
+                                   input.getDefiningOp<Kernel::GetWeight>() ||
+                                   is_dynamic_alloc(input);
+                if (!input_alive || !is_dynamic_alloc(op.result())) {
+                    continue;
+                }
+                bool as_view = true;
+                for (auto&& use : op.result().getUses()) {
+                    if (use.getOwner() != op.getOperation()) {
+                        as_view = as_view && is_view_user(use);
+                    }
+                }
+                if (as_view) {
+                    broadcast_views.insert(op.getOperation());
+                }
+            } else if (auto op = llvm::dyn_cast<Kernel::SetSubtensorIns>(&_)) {
+                Value src = op->getOperand(0);
+                if (!is_dynamic_alloc(src) || !is_dynamic_alloc(op.result())) {
+                    continue;
+                }
+                bool src_dead = true;
+                for (auto&& use : op->getOpOperands()) {
+                    src_dead = src_dead &&
+                               (use.getOperandNumber() == 0 || use.get() != src);
+                }
+                for (auto&& user : src.getUsers()) {
+                    if (user == op.getOperation()) {
+                        continue;
+                    }
+                    bool aliased = llvm::isa<Kernel::Reshape>(user) ||
+                                   llvm::isa<Kernel::Subtensor>(user) ||
+                                   llvm::isa<Kernel::Dimshuffle>(user) ||
+                                   broadcast_views.count(user);
+                    src_dead = src_dead && !aliased &&
+                               user->isBeforeInBlock(op.getOperation());
+                }
+                if (src_dead) {
+                    inplace_setsubtensors.insert(op.getOperation());
+                }
+            }
+        }
+
         for (auto&& _ : block) {
             llvm::TypeSwitch<Operation*>(&_)
                     .Case([&](memref::AllocOp op) {
@@ -372,6 +437,12 @@ public:
                         auto workspace_ =
                                 value_to_workspace(op.workspace(), op.callee().str());
                         auto type_ = m_fbs_builder.CreateString(op.callee().str());
+                        //! the mgb operator name kept in location by importer
+                        std::string opr_name;
+                        if (auto name_loc = op->getLoc().dyn_cast<NameLoc>()) {
+                            opr_name = name_loc.getName().str();
+                        }
+                        auto name_ = m_fbs_builder.CreateString(opr_name);
                         MegCC::OprBuilder opr_builder(m_fbs_builder);
                         opr_builder.add_inputs(input_tensors_);
                         opr_builder.add_input_types(input_types_);
@@ -386,6 +457,7 @@ public:
                         }
                         opr_builder.add_workspace(workspace_);
                         opr_builder.add_type(type_);
+                        opr_builder.add_name(name_);
 
                         LOG_DEBUG << "Add Opr to Call Kernel: " << op.callee().str()
                                   << " inputs id is " << input_tensors
@@ -542,6 +614,8 @@ public:
                         subtensor_builder.add_output(output_tensor);
                         subtensor_builder.add_descs(descs_fbs);
                         subtensor_builder.add_flags(flags_fbs);
+                        subtensor_builder.add_in_place(
+                                inplace_setsubtensors.count(op.getOperation()) > 0);
 
                         LOG_DEBUG << "Add set_subtensor instruction : \n";
                         instructions_type.push_back(MegCC::Instruction_SetSubTensor);
@@ -597,9 +671,11 @@ public:
                                 value2typed_tensor.at(op.result().getAsOpaquePointer());
                         LOG_DEBUG << "Add Broadcast instruction.\n";
                         instructions_type.push_back(MegCC::Instruction_BroadCast);
+                        bool as_view = broadcast_views.count(op.getOperation()) > 0;
                         instructions.push_back(MegCC::CreateBroadCast(
                                                        m_fbs_builder, input_tensors_,
-                                                       input_types_, out_tensor.second)
+                                                       input_types_, out_tensor.second,
+                                                       as_view)
                                                        .Union());
                     })
                     .Case([&](Kernel::ReshapeIns op) {
@@ -873,7 +949,8 @@ private:
         return {low, high};
     }
 
-    Offset<MegCC::DType> type_to_dtype(mlir::Type type) {
+    //! scales is the per output channel scales of the quantized weight
+    Offset<MegCC::DType> type_to_dtype(mlir::Type type, ArrayAttr scales = {}) {
         if (type.isF32()) {
             return MegCC::CreateDType(m_fbs_builder, MegCC::DTypeEnum_Float32);
         } else if (type.isF16()) {
@@ -881,7 +958,16 @@ private:
         } else if (auto inttype = type.dyn_cast_or_null<IntegerType>()) {
             if (inttype.isQuant()) {
                 float scale = inttype.getScale();
-                auto param = MegCC::CreateDTypeParam(m_fbs_builder, scale);
+                Offset<Vector<float>> scales_vec;
+                if (scales) {
+                    std::vector<float> scales_value;
+                    for (auto&& i : scales.getAsValueRange<FloatAttr>()) {
+                        scales_value.push_back(i.convertToFloat());
+                    }
+                    scales_vec = m_fbs_builder.CreateVector(scales_value);
+                }
+                auto param =
+                        MegCC::CreateDTypeParam(m_fbs_builder, scale, 0, scales_vec);
                 if (inttype.isInteger(32)) {
                     return MegCC::CreateDType(
                             m_fbs_builder, MegCC::DTypeEnum_QInt32, param);
@@ -1009,7 +1095,8 @@ private:
     }
 
     Offset<MegCC::Weight> attr_to_weight(
-            Attribute attr, StringRef name, int32_t user_count, bool weight_compress) {
+            Attribute attr, StringRef name, int32_t user_count, bool weight_compress,
+            ArrayAttr scales = {}) {
         auto dense = attr.cast<DenseElementsAttr>();
         auto size_in_bits = dense.getType().getSizeInBits();
         if (size_in_bits & 0x7) {
@@ -1094,7 +1181,7 @@ private:
         return MegCC::CreateWeight(
                 m_fbs_builder,
                 // dtype
-                type_to_dtype(dense.getType().getElementType()),
+                type_to_dtype(dense.getType().getElementType(), scales),
                 // layout
                 layout,
                 // use_count
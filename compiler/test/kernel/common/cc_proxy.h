@@ -20,13 +20,16 @@ struct OutputScope {
 };
 
 }  // namespace
+//! the per output channel scales of the quantized weights by the tensor index
+using TensorScales = std::unordered_map<size_t, std::vector<float>>;
+
 template <typename Opr>
 struct CCOprProxy {
     PerformanceResult exec(
             Opr* opr, const TensorNDArray& tensors, KernelGen::Arch arch,
             const BenchmarkOption& benchmark_option, const std::string& kernel_symbol,
             const std::unordered_map<std::string, CCAttr>& proxy_attr,
-            bool gen_dynamic);
+            bool gen_dynamic, const TensorScales& scales = {});
 
     OutputScope get_output_idx(Opr*);
 };
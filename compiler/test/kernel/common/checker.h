@@ -1,5 +1,6 @@
 #pragma once
 #include <functional>
+#include "test/kernel/common/cc_proxy.h"
 #include "test/kernel/common/dnn_proxy.h"
 #include "test/kernel/common/runner.h"
 
@@ -18,6 +19,7 @@ public:
     using Param = typename Opr::Param;
     using BeforeExecCallback = std::function<void(Opr*, const TensorNDArray&)>;
     using OutputCanonizer = std::function<void(const TensorNDArray&)>;
+    using Reference = std::function<void(Opr*, const TensorNDArray&)>;
     Checker(KernelGen::Arch arch = KernelGen::Arch::BAREMETAL, const int dnn_level = 2)
             : Runner<Opr>(arch, dnn_level), m_arch(arch), m_kernel_symbol(".*") {}
 
@@ -64,6 +66,14 @@ public:
         return *this;
     }
 
+    //! set the per output channel scales of the quantized weight idx, which
+    //! are passed to the kernel by the dtype param, megdnn does not support
+    //! them, so the outputs should be computed by set_reference
+    Checker& set_scales(size_t idx, std::vector<float> scales) {
+        m_scales[idx] = std::move(scales);
+        return *this;
+    }
+
     Checker& set_rng(size_t idx, RNG* rng) {
         m_rng[idx] = rng;
         return *this;
@@ -118,6 +128,20 @@ public:
         return *this;
     }
 
+    //! generate the kernel with fast-math, the float outputs are checked by the ulp
+    //! error instead of epsilon
+    Checker& set_fast_math_ulp(int ulp) {
+        m_fast_math_ulp = ulp;
+        return *this;
+    }
+
+    //! compute the expected outputs in place by the reference instead of
+    //! megdnn, the inputs are filled as the ones of the kernel
+    Checker& set_reference(const Reference& reference) {
+        m_reference = reference;
+        return *this;
+    }
+
     Checker& set_proxy(const DnnProxy& proxy) {
         m_dnn_proxy = proxy;
         return *this;
@@ -137,6 +161,9 @@ public:
             const TensorNDArray& expected, const TensorNDArray& computed, float epsilon,
             float max_avg_error, float max_avg_biased_error);
 
+    void check_tensors_ulp(
+            const TensorNDArray& expected, const TensorNDArray& computed, int max_ulp);
+
 private:
     bool m_run_cc_only = false;
     bool m_run_cc_dynamic = false;
@@ -144,15 +171,18 @@ private:
     float m_epsilon{1e-5};
     float m_max_avg_error{1e-5};
     float m_max_avg_biased_error{1e-5};
+    int m_fast_math_ulp{0};
     std::unique_ptr<Opr> m_dnn_opr;
     std::unordered_map<size_t, RNG*> m_rng;
     std::unordered_map<size_t, megdnn::DType> m_dtype;
+    TensorScales m_scales;
     std::unordered_map<size_t, megdnn::TensorFormat> m_fmt;
     OutputCanonizer m_output_canonizer;
     KernelGen::Arch m_arch;
     std::string m_kernel_symbol;
     DnnProxy m_dnn_proxy;
     BeforeExecCallback m_before_exec_callback = nullptr;
+    Reference m_reference = nullptr;
 };
 
 }  // namespace test
@@ -104,4 +104,64 @@ private:
     Param m_param;
 };
 
+//! tinycv_sep_filter, the NHWC src is filtered by the float kernels of
+//! {1, 1, 1, ksize_w} and {1, 1, 1, ksize_h} anchored at the center
+class CVSepFilter {
+public:
+    using DnnOpr = megdnn::SeparableFilterForward;
+    using Param = DnnOpr::Param;
+    Param& param() { return m_param; }
+
+    DnnOpr::Param dnn_param(Param ori_param) {
+        ori_param.format = Param::Format::NHWC;
+        ori_param.anchor_h = ori_param.ksize_h / 2;
+        ori_param.anchor_w = ori_param.ksize_w / 2;
+        return ori_param;
+    }
+    static void reformat_layout(CVSepFilter* opr, TensorLayoutArray& layouts){};
+
+private:
+    Param m_param;
+};
+
+//! tinycv_preprocess without the megdnn opr, the uint8 BGR image of
+//! (1, rows, cols, 3) or NV21 image of (1, rows * 3 / 2, cols, 1) is written to
+//! the NCHW (1, 3, H, W) or NCHW44 (1, 1, H, W, 4) network input, so it is only
+//! checked by set_reference
+class CVPreprocess {
+public:
+    struct Param {
+        std::string src_format = "BGR";
+        std::string dst_format = "NCHW";
+        size_t resize_rows = 1;
+        size_t resize_cols = 1;
+        size_t top = 0;
+        size_t left = 0;
+        uint8_t pad_value = 0;
+        float mean[3] = {0.f, 0.f, 0.f};
+        float std[3] = {1.f, 1.f, 1.f};
+        bool swap_rb = false;
+        float dst_scale = 1.f;
+    };
+    Param& param() { return m_param; }
+
+private:
+    Param m_param;
+};
+
+//! megbrain NMSKeep without the megdnn opr, the boxes of (batch, nr_boxes, 4)
+//! give the kept index of (batch, max_output) and the kept number of (batch),
+//! so it is only checked by set_reference
+class NMSKeep {
+public:
+    struct Param {
+        float iou_thresh = 0.5f;
+        uint32_t max_output = 1;
+    };
+    Param& param() { return m_param; }
+
+private:
+    Param m_param;
+};
+
 }  // namespace megdnn
\ No newline at end of file
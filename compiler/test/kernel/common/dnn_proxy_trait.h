@@ -122,6 +122,11 @@ DEF(CVRoicopy, 2, false, false);
 DEF(CVCvtColor, 2, false, false);
 DEF(CVWarpAffine, 2, false, false);
 DEF(CVGaussianBlur, 2, false, false);
+DEF(CVSepFilter, 4, false, false);
+DEF(CVPreprocess, 2, false, false);
+
+//! define for megbrain oprs
+DEF(NMSKeep, 3, false, false);
 }  // namespace megdnn
 
 // vim: syntax=cpp.doxygen
@@ -0,0 +1,114 @@
+#pragma once
+#include <algorithm>
+#include <random>
+#include <vector>
+#include "test/kernel/common/checker.h"
+
+namespace megcc {
+namespace test {
+
+/*!
+ * the greedy NMSKeep of megbrain, the boxes (x0, y0, x1, y1) are sorted by
+ * score, a box is dropped if inter > (area_kept + area - inter) * iou_thresh
+ * with any kept box. The kept index is padded with the last kept one, or 0 if
+ * none is kept
+ */
+inline Checker<megdnn::NMSKeep>::Reference nms_keep_reference() {
+    return [](megdnn::NMSKeep* opr, const TensorNDArray& tensors) {
+        float thresh = opr->param().iou_thresh;
+        size_t max_output = opr->param().max_output;
+        size_t batch = tensors[0].layout[0], nr_boxes = tensors[0].layout[1];
+        auto area = [](const float* box) {
+            return (box[2] - box[0]) * (box[3] - box[1]);
+        };
+        for (size_t b = 0; b < batch; ++b) {
+            const float* boxes = tensors[0].ptr<float>() + b * nr_boxes * 4;
+            std::vector<int32_t> keep;
+            for (size_t i = 0; i < nr_boxes && keep.size() < max_output; ++i) {
+                const float* box = boxes + i * 4;
+                bool removed = false;
+                for (int32_t k : keep) {
+                    const float* kept = boxes + k * 4;
+                    float w = std::max(
+                            std::min(kept[2], box[2]) - std::max(kept[0], box[0]),
+                            0.f);
+                    float h = std::max(
+                            std::min(kept[3], box[3]) - std::max(kept[1], box[1]),
+                            0.f);
+                    float inter = w * h;
+                    removed |= inter > (area(kept) + area(box) - inter) * thresh;
+                }
+                if (!removed) {
+                    keep.push_back(i);
+                }
+            }
+            int32_t* idx = tensors[1].ptr<int32_t>() + b * max_output;
+            for (size_t i = 0; i < max_output; ++i) {
+                idx[i] = i < keep.size() ? keep[i] : (keep.empty() ? 0 : keep.back());
+            }
+            tensors[2].ptr<int32_t>()[b] = keep.size();
+        }
+    };
+}
+
+//! nr random boxes with the integer coordinates, so the areas and the
+//! intersections are exact and only the threshold product is rounded
+inline std::vector<float> nms_keep_boxes(size_t nr) {
+    std::mt19937 rng(nr);
+    std::vector<float> boxes;
+    for (size_t i = 0; i < nr; ++i) {
+        float x = rng() % 64, y = rng() % 64;
+        float w = 1 + rng() % 32, h = 1 + rng() % 32;
+        boxes.insert(boxes.end(), {x, y, x + w, y + h});
+    }
+    return boxes;
+}
+
+//! check the NMSKeep kernel selected by the checker against the reference,
+//! the box numbers are not all multiples of the SIMD width
+inline void check_nms_keep(Checker<megdnn::NMSKeep>& checker) {
+    checker.set_dtype(1, megdnn::dtype::Int32());
+    checker.set_dtype(2, megdnn::dtype::Int32());
+    checker.set_reference(nms_keep_reference());
+    megdnn::NMSKeep::Param param;
+    auto run = [&](size_t batch, size_t nr_boxes, std::vector<float> boxes) {
+        ListRNG rng(boxes);
+        checker.set_rng(0, &rng);
+        checker.set_param(param);
+        checker.execs({{batch, nr_boxes, 4}, {batch, param.max_output}, {batch}});
+    };
+    for (size_t batch : {1, 3})
+        for (size_t nr_boxes : {1, 4, 7, 13, 37})
+            for (float thresh : {0.3f, 0.7f})
+                for (uint32_t max_output : {1, 5, 64}) {
+                    param.iou_thresh = thresh;
+                    param.max_output = max_output;
+                    run(batch, nr_boxes, nms_keep_boxes(batch * nr_boxes));
+                }
+    //! no box is kept from the empty input
+    param.iou_thresh = 0.5f;
+    param.max_output = 5;
+    run(2, 0, {0.f});
+    //! the same boxes are all suppressed by the first one
+    run(2, 9, {2.f, 2.f, 10.f, 10.f});
+    //! the later boxes have the IoU of 0.5 with the first one, which is not
+    //! over the threshold of 0.5, the first two boxes are kept
+    std::vector<float> tie_boxes{0.f, 0.f, 3.f, 1.f};
+    for (int i = 0; i < 6; ++i) {
+        tie_boxes.insert(tie_boxes.end(), {1.f, 0.f, 4.f, 1.f});
+    }
+    run(1, 7, tie_boxes);
+    param.iou_thresh = 0.49f;
+    run(1, 7, tie_boxes);
+    //! disjoint boxes are kept up to max_output
+    std::vector<float> disjoint_boxes;
+    for (int i = 0; i < 13; ++i) {
+        disjoint_boxes.insert(disjoint_boxes.end(), {2.f * i, 0.f, 2.f * i + 1, 1.f});
+    }
+    run(1, 13, disjoint_boxes);
+}
+
+}  // namespace test
+}  // namespace megcc
+
+// vim: syntax=cpp.doxygen
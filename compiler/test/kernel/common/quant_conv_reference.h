@@ -0,0 +1,130 @@
+#pragma once
+#include <algorithm>
+#include <cmath>
+#include <vector>
+#include "test/kernel/common/checker.h"
+
+namespace megcc {
+namespace test {
+
+namespace quant_conv_detail {
+using Format = megdnn::ConvBiasForward::Param::Format;
+
+//! the index of the element at linear of the contiguous layout
+inline std::vector<size_t> linear_to_index(
+        const megdnn::TensorLayout& layout, size_t linear) {
+    std::vector<size_t> index(layout.ndim);
+    for (size_t i = layout.ndim; i > 0; --i) {
+        index[i - 1] = linear % layout[i - 1];
+        linear /= layout[i - 1];
+    }
+    return index;
+}
+
+//! the channel of the NCHW or NCHW44 src, bias and dst
+inline size_t tensor_channel(
+        Format format, const megdnn::TensorLayout& layout, size_t linear) {
+    auto index = linear_to_index(layout, linear);
+    return format != Format::NCHW && layout.ndim == 5 ? index[1] * 4 + index[4]
+                                                      : index[1];
+}
+
+//! the linear of the float NCHW44 filter element of the NCHW44_DOT filter
+//! element, whose inner {4oc, 4ic} block is transposed
+inline size_t nchw44_filter_linear(
+        Format format, const megdnn::TensorLayout& layout, size_t linear) {
+    if (format != Format::NCHW44_DOT || layout.ndim < 6) {
+        return linear;
+    }
+    size_t block = linear / 16, oc = linear % 16 / 4, ic = linear % 4;
+    return block * 16 + ic * 4 + oc;
+}
+
+//! the output channel of the NCHW, NCHW44 or NCHW44_DOT filter, the group
+//! filter of NCHW44 is {G, OCPG/4, ICPG/4, FH, FW, 4, 4} and the channel wise
+//! one is {G/4, 1, 1, FH, FW, 4}, the inner block of NCHW44_DOT is {4oc, 4ic}
+//! while the hybrid filter of the NCHW src is {OC/4, FH, FW, IC, 4}
+inline size_t filter_channel(
+        Format format, bool group, const megdnn::TensorLayout& layout,
+        size_t linear) {
+    auto index = linear_to_index(layout, linear);
+    if (format == Format::NCHW44 || format == Format::NCHW44_DOT) {
+        size_t block = layout.ndim == 7 ? index[0] * layout[1] + index[1] : index[0];
+        bool dot_block = format == Format::NCHW44_DOT && layout.ndim >= 6;
+        size_t oc_axis = layout.ndim - (dot_block ? 2 : 1);
+        return block * 4 + index[oc_axis];
+    }
+    return group ? index[0] * layout[1] + index[1] : index[0];
+}
+
+inline float quant_scale(megdnn::DType dtype) {
+    if (dtype.enumv() == megdnn::DTypeEnum::QuantizedS32) {
+        return dtype.param<megdnn::dtype::QuantizedS32>().scale;
+    }
+    return dtype.param<megdnn::dtype::QuantizedS8>().scale;
+}
+}  // namespace quant_conv_detail
+
+/*!
+ * the float reference of the int8 ConvBias with the filter quantized by the
+ * per output channel scales, the src, the filter and the int32 bias which is
+ * quantized by src_scale * scales[oc] are dequantized, then the float ConvBias
+ * of megdnn runs and its output is quantized by the dst scale
+ */
+inline Checker<megdnn::ConvBiasForward>::Reference per_channel_conv_reference(
+        std::vector<float> scales) {
+    using namespace quant_conv_detail;
+    return [scales](megdnn::ConvBiasForward* opr, const TensorNDArray& tensors) {
+        auto param = opr->param();
+        auto format = param.format;
+        bool group = param.sparse == megdnn::ConvBiasForward::Param::Sparse::GROUP;
+        float src_scale = quant_scale(tensors[0].layout.dtype);
+        float dst_scale = quant_scale(tensors[4].layout.dtype);
+        TensorLayoutArray layouts;
+        for (auto&& tensor : tensors) {
+            layouts.push_back(
+                    megdnn::TensorLayout(tensor.layout, megdnn::dtype::Float32()));
+        }
+        auto float_storage = megdnn::test::dnn_alloc_tensors(opr->handle(), layouts, 0);
+        auto&& float_tensors = *float_storage;
+
+        auto&& src = tensors[0];
+        for (size_t i = 0; i < src.layout.total_nr_elems(); ++i) {
+            float_tensors[0].ptr<float>()[i] =
+                    src.ptr<megdnn::dt_qint8>()[i].as_int8() * src_scale;
+        }
+        auto&& filter = tensors[1];
+        for (size_t i = 0; i < filter.layout.total_nr_elems(); ++i) {
+            size_t oc = filter_channel(format, group, filter.layout, i);
+            float_tensors[1].ptr<float>()[nchw44_filter_linear(
+                    format, filter.layout, i)] =
+                    filter.ptr<megdnn::dt_qint8>()[i].as_int8() * scales.at(oc);
+        }
+        auto&& bias = tensors[2];
+        for (size_t i = 0; i < bias.layout.total_nr_elems(); ++i) {
+            size_t oc = tensor_channel(format, bias.layout, i);
+            float_tensors[2].ptr<float>()[i] =
+                    bias.ptr<megdnn::dt_qint32>()[i].as_int32() * src_scale *
+                    scales.at(oc);
+        }
+
+        auto float_opr = opr->handle()->create_operator<megdnn::ConvBiasForward>();
+        float_opr->param() = param;
+        if (format == Format::NCHW44_DOT) {
+            float_opr->param().format = Format::NCHW44;
+        }
+        megdnn::test::DnnOprProxy<megdnn::ConvBiasForward>().exec(
+                float_opr.get(), float_tensors);
+
+        auto&& dst = tensors[4];
+        for (size_t i = 0; i < dst.layout.total_nr_elems(); ++i) {
+            float value = std::round(float_tensors[4].ptr<float>()[i] / dst_scale);
+            value = std::min(std::max(value, -128.f), 127.f);
+            dst.ptr<megdnn::dt_qint8>()[i] =
+                    megdnn::dt_qint8(static_cast<int8_t>(value));
+        }
+    };
+}
+
+}  // namespace test
+}  // namespace megcc
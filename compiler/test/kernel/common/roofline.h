@@ -0,0 +1,54 @@
+#pragma once
+#include <string>
+#include <vector>
+#include "test/kernel/common/performance.h"
+namespace megcc {
+namespace test {
+
+//! peak of the running machine measured by the built in probes, the compute
+//! peak is a fp32 FMA loop and the memory peak is a STREAM triad
+struct MachinePeak {
+    float compute_gflops{0.f};
+    float memory_gbps{0.f};
+};
+
+//! run the probes once and cache the result for the whole process
+const MachinePeak& get_machine_peak();
+
+//! one measured case of the sweep, the efficiency is the attained compute
+//! throughput over the roofline bound min(peak_gflops, intensity * peak_gbps)
+struct RooflineRecord {
+    std::string kernel_type;
+    std::string kernel_symbol;
+    std::string args;
+    float time_ms{0.f};
+    float gflops{0.f};
+    float gbps{0.f};
+    //! operations per byte
+    float intensity{0.f};
+    float bound_gflops{0.f};
+    float efficiency{0.f};
+};
+
+//! collect the sweep results and write them to `${MEGCC_BENCHMARK_OUTPUT}.csv`
+//! and `${MEGCC_BENCHMARK_OUTPUT}.json` when the process exits, nothing is
+//! written if the env is not set
+class RooflineRecorder {
+public:
+    static RooflineRecorder& inst();
+    //! invalid megcc performance is ignored, return the record for printing
+    RooflineRecord record(
+            const std::string& kernel_type, const std::string& kernel_symbol,
+            const PerformanceResultPair& result);
+    ~RooflineRecorder();
+
+private:
+    RooflineRecorder();
+    void dump_csv(const std::string& path) const;
+    void dump_json(const std::string& path) const;
+    std::string m_output_prefix;
+    std::vector<RooflineRecord> m_records;
+};
+
+}  // namespace test
+}  // namespace megcc
@@ -230,5 +230,6 @@ DEF_CV_BENCHMARK(megdnn::CVtranspose);
 DEF_CV_BENCHMARK(megdnn::CVflip);
 DEF_CV_BENCHMARK(megdnn::CVRotate);
 DEF_CV_BENCHMARK(megdnn::CVGaussianBlur);
+DEF_CV_BENCHMARK(megdnn::CVSepFilter);
 }  // namespace test
 }  // namespace megcc
@@ -213,6 +213,17 @@ KernelGenRet opr_fill_attr<megdnn::CVCvtColor>(
     return KernelGen::KernelPack::GetKernel(KernType::CvtColorKernel, arch);
 }
 
+template <>
+KernelGenRet opr_fill_attr<megdnn::CVPreprocess>(
+        std::unordered_map<std::string, CCAttr>& attr_map, megdnn::CVPreprocess* opr,
+        const TensorNDArray& tensors, KernelGen::Arch arch,
+        const std::unordered_map<std::string, CCAttr>& proxy_attr) {
+    auto param = opr->param();
+    FILL_MAP(attr_map, param, src_format);
+    FILL_MAP(attr_map, param, dst_format);
+    return KernelGen::KernelPack::GetKernel(KernType::CVPreprocessKernel, arch);
+}
+
 template <>
 KernelGenRet opr_fill_attr<megdnn::CVWarpAffine>(
         std::unordered_map<std::string, CCAttr>& attr_map, megdnn::CVWarpAffine* opr,
@@ -420,6 +431,17 @@ KernelGenRet opr_fill_attr<megdnn::CVGaussianBlur>(
     return KernelGen::KernelPack::GetKernel(KernType::CVGaussianBlur, arch);
 }
 
+template <>
+KernelGenRet opr_fill_attr<megdnn::CVSepFilter>(
+        std::unordered_map<std::string, CCAttr>& attr_map, megdnn::CVSepFilter* opr,
+        const TensorNDArray& tensors, KernelGen::Arch arch,
+        const std::unordered_map<std::string, CCAttr>& proxy_attr) {
+    auto param = opr->param();
+
+    attr_map["border_mode"] = CCAttr(dnnparam_2_str(param.borderMode));
+    return KernelGen::KernelPack::GetKernel(KernType::CVSepFilterKernel, arch);
+}
+
 template <>
 KernelGenRet opr_fill_attr<megdnn::GaussianBlur>(
         std::unordered_map<std::string, CCAttr>& attr_map, megdnn::GaussianBlur* opr,
@@ -480,6 +502,17 @@ KernelGenRet opr_fill_attr<megdnn::CVRoicopy>(
     return KernelGen::KernelPack::GetKernel(KernType::RoiCopyKernel, arch);
 }
 
+template <>
+KernelGenRet opr_fill_attr<megdnn::NMSKeep>(
+        std::unordered_map<std::string, CCAttr>& attr_map, megdnn::NMSKeep* opr,
+        const TensorNDArray& tensors, KernelGen::Arch arch,
+        const std::unordered_map<std::string, CCAttr>& proxy_attr) {
+    auto param = opr->param();
+    FILL_MAP(attr_map, param, iou_thresh);
+    FILL_MAP(attr_map, param, max_output);
+    return KernelGen::KernelPack::GetKernel(KernType::NMSKeepKernel, arch);
+}
+
 template <>
 KernelGenRet opr_fill_attr<megdnn::PowC>(
         std::unordered_map<std::string, CCAttr>& attr_map, megdnn::PowC* opr,
@@ -508,6 +541,15 @@ KernelGenRet opr_fill_attr<megdnn::ArgmaxForward>(
     return KernelGen::KernelPack::GetKernel(KernType::ArgmaxKernel, arch);
 }
 template <>
+KernelGenRet opr_fill_attr<megdnn::ArgminForward>(
+        std::unordered_map<std::string, CCAttr>& attr_map, megdnn::ArgminForward* opr,
+        const TensorNDArray& tensors, KernelGen::Arch arch,
+        const std::unordered_map<std::string, CCAttr>& proxy_attr) {
+    auto param = opr->param();
+    FILL_MAP(attr_map, param, axis);
+    return KernelGen::KernelPack::GetKernel(KernType::ArgminKernel, arch);
+}
+template <>
 KernelGenRet opr_fill_attr<megdnn::ConvolutionBackwardData>(
         std::unordered_map<std::string, CCAttr>& attr_map,
         megdnn::ConvolutionBackwardData* opr, const TensorNDArray& tensors,
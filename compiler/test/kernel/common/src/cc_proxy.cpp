@@ -30,7 +30,7 @@ using namespace test;
 
 namespace {
 DType dnndtype_2_ccdtype(megdnn::DType dtype) {
-    DType res;
+    DType res{};
     switch (dtype.enumv()) {
         case megdnn::DTypeEnum::Float32:
             res.type_enum = TinyNNDType::TinyNN_FLOAT;
@@ -126,7 +126,7 @@ PerformanceResult proxy_kernel(
         TensorNDArray tensor_array, StdKernelCall func, StdKernelInitCall init_func,
         StdKernelWorkspaceCall workspace_func, StdKernelDeduceCall deduce_func,
         const BenchmarkOption& benchmark_option, const size_t workspace_bytes,
-        OutputScope output_idx) {
+        OutputScope output_idx, const TensorScales& scales) {
     constexpr size_t mem_align_bytes = 64;
     megdnn::SmallVector<Tensor> cc_tensor_in;
     megdnn::SmallVector<std::string> cc_tensor_in_name;
@@ -142,6 +142,11 @@ PerformanceResult proxy_kernel(
         cc_tensor_in_name.push_back(mgb::ssprintf("cc_input:%zu", input_cnt++));
         cc_tensor_in.push_back(dnntensor_2_cctensor(
                 tensor_array[i], cc_tensor_in_name.back().c_str()));
+        if (scales.count(i)) {
+            auto&& param = cc_tensor_in.back().dtype.param;
+            param.nr_scale = scales.at(i).size();
+            param.scales = const_cast<float*>(scales.at(i).data());
+        }
     }
     auto make_pointer_array = [](auto&& data_vec) {
         std::vector<decltype(data_vec.data())> ret;
@@ -302,7 +307,8 @@ PerformanceResult call_kernel(
                 const KernelGen::DeduceFunc*>& kernels,
         TContext* ctx, const TensorNDArray& tensors,
         const BenchmarkOption& benchmark_option, const std::string& kernel_symbol,
-        const OutputScope output_idx, bool dynamic_shape) {
+        const OutputScope output_idx, bool dynamic_shape,
+        const TensorScales& scales = {}) {
     std::string kern_name;
     std::string kern_init_name;
     std::string kern_deduce_name;
@@ -348,7 +354,7 @@ PerformanceResult call_kernel(
     }
     return proxy_kernel(
             tensors, func, init_func, workspace_func, deduce_func, benchmark_option,
-            workspace_bytes, output_idx);
+            workspace_bytes, output_idx, scales);
 }
 
 }  // namespace
@@ -391,6 +397,10 @@ OutputScope CCOprProxy<megdnn::TopK>::get_output_idx(megdnn::TopK* opr) {
         return {-2, -1};
 }
 template <>
+OutputScope CCOprProxy<megdnn::NMSKeep>::get_output_idx(megdnn::NMSKeep*) {
+    return {-2, -1};
+}
+template <>
 OutputScope CCOprProxy<megdnn::IndexingMultiAxisVec>::get_output_idx(
         megdnn::IndexingMultiAxisVec*) {
     return {1, 1};
@@ -400,12 +410,16 @@ template <typename Opr>
 PerformanceResult CCOprProxy<Opr>::exec(
         Opr* opr, const TensorNDArray& tensors, KernelGen::Arch arch,
         const BenchmarkOption& benchmark_option, const std::string& kernel_symbol,
-        const std::unordered_map<std::string, CCAttr>& proxy_attr, bool gen_dynamic) {
+        const std::unordered_map<std::string, CCAttr>& proxy_attr, bool gen_dynamic,
+        const TensorScales& scales) {
     std::unordered_map<std::string, CCAttr> attr_map;
     auto kernels = opr_fill_attr<Opr>(attr_map, opr, tensors, arch, proxy_attr);
+    if (proxy_attr.count("fast_math_ulp")) {
+        attr_map["fast_math_ulp"] = proxy_attr.at("fast_math_ulp");
+    }
     auto output_idx = get_output_idx(opr);
     output_idx.normalize((int)tensors.size());
-    fill_operands(attr_map, tensors, output_idx, gen_dynamic);
+    fill_operands(attr_map, tensors, output_idx, gen_dynamic, scales);
     CodeGenContext ctx(attr_map);
     MGB_MARK_USED_VAR(call_kernel);
     MGB_MARK_USED_VAR(gen_kernel);
@@ -416,7 +430,7 @@ PerformanceResult CCOprProxy<Opr>::exec(
     //! call kernel
     return call_kernel(
             kernels, &ctx, tensors, benchmark_option, kernel_symbol, output_idx,
-            gen_dynamic);
+            gen_dynamic, scales);
 #endif
 }
 
@@ -428,7 +442,7 @@ PerformanceResult CCOprProxy<Opr>::exec(
             _OPR_CLS* opr, const TensorNDArray& tensors, KernelGen::Arch arch,         \
             const BenchmarkOption& benchmark_option, const std::string& kernel_symbol, \
             const std::unordered_map<std::string, CCAttr>& proxy_attr,                 \
-            bool gen_dynamic)
+            bool gen_dynamic, const TensorScales& scales)
 
 DEF_CCOPRPROXY(megdnn::ElemwiseForward);
 DEF_CCOPRPROXY(megdnn::ElemwiseMultiType);
@@ -452,8 +466,10 @@ DEF_CCOPRPROXY(megdnn::ResizeForward);
 DEF_CCOPRPROXY(megdnn::Argsort);
 DEF_CCOPRPROXY(megdnn::ConcatForward);
 DEF_CCOPRPROXY(megdnn::ArgmaxForward);
+DEF_CCOPRPROXY(megdnn::ArgminForward);
 DEF_CCOPRPROXY(megdnn::GaussianBlurForward);
 DEF_CCOPRPROXY(megdnn::PaddingForward);
+DEF_CCOPRPROXY(megdnn::NMSKeep);
 
 #undef DEF_CCOPRPROXY
 
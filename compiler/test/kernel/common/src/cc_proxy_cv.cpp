@@ -187,6 +187,64 @@ private:
     megdnn::CVGaussianBlur::Param m_param;
 };
 
+template <>
+class RunCvHelper<megdnn::CVSepFilter> {
+public:
+    typedef void (*CVSepFilterFunc)(
+            const TinyMat* src, const TinyMat* dst, const TinyMat* kx,
+            const TinyMat* ky);
+    RunCvHelper(megdnn::CVSepFilter* opr) { m_param = opr->param(); };
+    void run_cv_kernel(megdnn::SmallVector<TinyMat>& mat_array, void* func_ptr) {
+        CVSepFilterFunc func = (CVSepFilterFunc)func_ptr;
+        TinyMat kx = {1, m_param.ksize_w, 1, mat_array[1].data};
+        TinyMat ky = {1, m_param.ksize_h, 1, mat_array[2].data};
+        func(&mat_array[0], &mat_array[3], &kx, &ky);
+    };
+    TensorNDArray on_tensor_before(TensorNDArray& tensor_array) {
+        return tensor_array;
+    };
+
+private:
+    megdnn::CVSepFilter::Param m_param;
+};
+
+template <>
+class RunCvHelper<megdnn::CVPreprocess> {
+public:
+    typedef void (*CVPreprocessFunc)(
+            const TinyMat* src, const TinyMat* dst, const TinyPreprocessParam* param);
+    RunCvHelper(megdnn::CVPreprocess* opr) {
+        auto&& param = opr->param();
+        m_param.resize_rows = param.resize_rows;
+        m_param.resize_cols = param.resize_cols;
+        m_param.top = param.top;
+        m_param.left = param.left;
+        m_param.pad_value = param.pad_value;
+        for (int c = 0; c < 3; ++c) {
+            m_param.mean[c] = param.mean[c];
+            m_param.std[c] = param.std[c];
+        }
+        m_param.swap_rb = param.swap_rb;
+        m_param.dst_scale = param.dst_scale;
+    };
+    void run_cv_kernel(megdnn::SmallVector<TinyMat>& mat_array, void* func_ptr) {
+        CVPreprocessFunc func = (CVPreprocessFunc)func_ptr;
+        func(&mat_array[0], &mat_array[1], &m_param);
+    };
+    //! the dst mat only gives the rows and the cols of the network input
+    TensorNDArray on_tensor_before(TensorNDArray& tensor_array) {
+        TensorNDArray res = tensor_array;
+        auto&& dst = tensor_array[1].layout;
+        size_t h = dst[dst.ndim - 2 - (dst.ndim == 5)];
+        size_t w = dst[dst.ndim - 1 - (dst.ndim == 5)];
+        res[1].layout = megdnn::TensorLayout({h, w, 3}, dst.dtype);
+        return res;
+    };
+
+private:
+    TinyPreprocessParam m_param;
+};
+
 static inline TinyMat tensor2TinyMat(const megdnn::TensorND& tensor) {
     auto layout = tensor.layout;
     mgb_assert(
@@ -305,7 +363,7 @@ void gen_kernel_cv(
             _Opr* opr, const TensorNDArray& tensors, KernelGen::Arch arch,             \
             const BenchmarkOption& benchmark_option, const std::string& kernel_symbol, \
             const std::unordered_map<std::string, CCAttr>& proxy_attr,                 \
-            bool gen_dynamic) {                                                        \
+            bool gen_dynamic, const TensorScales&) {                                   \
         std::unordered_map<std::string, CCAttr> attr_map;                              \
         auto kernels = opr_fill_attr<_Opr>(attr_map, opr, tensors, arch, proxy_attr);  \
         auto output_idx = get_output_idx(opr);                                         \
@@ -325,6 +383,8 @@ DEF_CCOPRPROXY_CV(megdnn::CVRoicopy);
 DEF_CCOPRPROXY_CV(megdnn::CVCvtColor);
 DEF_CCOPRPROXY_CV(megdnn::CVWarpAffine);
 DEF_CCOPRPROXY_CV(megdnn::CVGaussianBlur);
+DEF_CCOPRPROXY_CV(megdnn::CVSepFilter);
+DEF_CCOPRPROXY_CV(megdnn::CVPreprocess);
 
 #undef DEF_CCOPRPROXY_CV
 }  // namespace test
@@ -88,7 +88,7 @@ megcc::CCOperand dnntensor_2_ccoperand(
 }
 void fill_operands(
         std::unordered_map<std::string, CCAttr>& map, const TensorNDArray& tensors,
-        OutputScope output_idx, bool is_dynamic) {
+        OutputScope output_idx, bool is_dynamic, const TensorScales& scales = {}) {
     int tensor_size = (int)tensors.size();
     map["nr_operands"] = CCAttr(tensor_size);
     int input_cnt = 0;
@@ -96,8 +96,9 @@ void fill_operands(
         if (i >= output_idx.start && i <= output_idx.end) {
             continue;
         }
-        map["operand:" + std::to_string(input_cnt++)] =
-                CCAttr(dnntensor_2_ccoperand(tensors[i], is_dynamic));
+        auto operand = dnntensor_2_ccoperand(tensors[i], is_dynamic);
+        operand.per_channel_scale = scales.count(i) > 0;
+        map["operand:" + std::to_string(input_cnt++)] = CCAttr(operand);
     }
     for (int i = output_idx.start; i <= output_idx.end; ++i) {
         map["operand:" + std::to_string(input_cnt++)] =
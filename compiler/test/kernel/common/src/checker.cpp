@@ -1,3 +1,5 @@
+#include <cmath>
+#include <limits>
 #include "test/kernel/common/checker.h"
 #include "megcc_test_config.h"
 #include "test/kernel/common/cc_proxy.h"
@@ -285,13 +287,41 @@ void Checker<Opr>::check_tensors(
     }
 }
 
+template <typename Opr>
+void Checker<Opr>::check_tensors_ulp(
+        const TensorNDArray& expected, const TensorNDArray& computed, int max_ulp) {
+    for (size_t i = 0; i < expected.size(); ++i) {
+        if (expected[i].layout.ndim == 0)
+            continue;
+        mgb_assert(expected[i].layout.dtype == dtype::Float32());
+        auto expect_ptr = expected[i].ptr<float>();
+        auto compute_ptr = computed[i].ptr<float>();
+        for (size_t idx = 0; idx < expected[i].layout.total_nr_elems(); ++idx) {
+            float expect = expect_ptr[idx];
+            float compute = compute_ptr[idx];
+            if (std::isnan(expect) && std::isnan(compute))
+                continue;
+            //! the ulp of denormal results is taken as the one of FLT_MIN
+            float abs_expect =
+                    std::max(std::abs(expect), std::numeric_limits<float>::min());
+            float ulp = std::nextafter(abs_expect, INFINITY) - abs_expect;
+            ASSERT_LE(std::abs(compute - expect) / ulp, max_ulp)
+                    << "tensor " << i << " at " << idx << " expect " << expect
+                    << " but get " << compute;
+        }
+    }
+}
+
 template <typename Opr>
 void Checker<Opr>::exec(TensorLayoutArray all_layouts) {
     using CCProxy = CCOprProxy<Opr>;
     auto dnn_handle = Runner<Opr>::get_dnn_handle();
     auto opr = dnn_handle->template create_operator<Opr>();
     opr->param() = m_param;
-    if (!m_run_cc_only)
+    //! the reference may check the layouts which megdnn does not support, such
+    //! as the weight quantized MatrixMul, so the given output is not deduced
+    bool deduce = !m_run_cc_only && !(m_reference && all_layouts.back().ndim);
+    if (deduce)
         m_dnn_proxy.deduce_layout(opr.get(), all_layouts);
 
     auto tensor_array_storage = dnn_alloc_tensors(dnn_handle, all_layouts, 0);
@@ -306,23 +336,34 @@ void Checker<Opr>::exec(TensorLayoutArray all_layouts) {
     CCProxy cc_proxy;
     std::unordered_map<std::string, CCAttr> proxy_attr;
     fix_addition_attr_map<Opr>(proxy_attr, m_dnn_proxy, tensor_array_dnn);
+    if (m_fast_math_ulp > 0) {
+        proxy_attr["fast_math_ulp"] = CCAttr(m_fast_math_ulp);
+    }
     cc_proxy.exec(
             opr.get(), tensor_array, m_arch, {}, m_kernel_symbol, proxy_attr,
-            m_run_cc_dynamic);
+            m_run_cc_dynamic, m_scales);
 #if !MEGCC_TEST_GEN
     //! run dnn
     if (m_before_exec_callback) {
         m_before_exec_callback(opr.get(), tensor_array_dnn);
     }
     if (!m_run_cc_only) {
-        m_dnn_proxy.exec(opr.get(), tensor_array_dnn);
+        if (m_reference) {
+            m_reference(opr.get(), tensor_array_dnn);
+        } else {
+            m_dnn_proxy.exec(opr.get(), tensor_array_dnn);
+        }
         if (m_output_canonizer) {
             m_output_canonizer(tensor_array);
             m_output_canonizer(tensor_array_dnn);
         }
-        check_tensors(
-                tensor_array_dnn, tensor_array, m_epsilon, m_max_avg_error,
-                m_max_avg_biased_error);
+        if (m_fast_math_ulp > 0) {
+            check_tensors_ulp(tensor_array_dnn, tensor_array, m_fast_math_ulp);
+        } else {
+            check_tensors(
+                    tensor_array_dnn, tensor_array, m_epsilon, m_max_avg_error,
+                    m_max_avg_biased_error);
+        }
     }
 #endif
 }
@@ -381,6 +422,42 @@ namespace test {
     }                                                                                 \
     template class Checker<_Opr>;
 
+//! the oprs without the megdnn ones, whose outputs given by the shapes are
+//! always computed by the reference
+#if !MEGCC_TEST_GEN
+#define RUN_REFERENCE_MACRO(...)                                            \
+    {                                                                       \
+        m_reference(&opr, tensor_array_dnn);                                \
+        check_tensors(                                                      \
+                tensor_array_dnn, tensor_array, m_epsilon, m_max_avg_error, \
+                m_max_avg_biased_error);                                    \
+    }
+#else
+#define RUN_REFERENCE_MACRO(...) \
+    {}
+#endif
+
+#define DEF_REFERENCE_OPR(_Opr)                                                       \
+    template <>                                                                       \
+    void Checker<_Opr>::exec(TensorLayoutArray all_layouts) {                         \
+        mgb_assert(m_run_cc_only || m_reference, #_Opr " needs the reference");       \
+        Runner<_Opr> runner;                                                          \
+        auto dnn_handle = runner.get_dnn_handle();                                    \
+        _Opr opr;                                                                     \
+        opr.param() = m_param;                                                        \
+        auto tensor_array_storage = dnn_alloc_tensors(dnn_handle, all_layouts, 0);    \
+        auto tensor_array_naive_storage =                                             \
+                dnn_alloc_tensors(dnn_handle, all_layouts, 0);                        \
+        auto tensor_array_dnn = *tensor_array_naive_storage;                          \
+        auto tensor_array = *tensor_array_storage;                                    \
+        INIT_TENSOR_MACRO();                                                          \
+        CCOprProxy<_Opr> cc_proxy;                                                    \
+        cc_proxy.exec(&opr, tensor_array, m_arch, {}, m_kernel_symbol, {}, false);    \
+        if (!m_run_cc_only)                                                           \
+            RUN_REFERENCE_MACRO();                                                    \
+    }                                                                                 \
+    template class Checker<_Opr>;
+
 }  // namespace test
 }  // namespace megcc
 namespace megcc {
@@ -407,6 +484,7 @@ template class Checker<megdnn::ResizeForward>;
 template class Checker<megdnn::ArgsortForward>;
 template class Checker<megdnn::ConcatForward>;
 template class Checker<megdnn::ArgmaxForward>;
+template class Checker<megdnn::ArgminForward>;
 template class Checker<megdnn::GaussianBlurForward>;
 template class Checker<megdnn::PaddingForward>;
 
@@ -419,6 +497,10 @@ DEF_CV_OPR(megdnn::CVRoicopy);
 DEF_CV_OPR(megdnn::CVCvtColor);
 DEF_CV_OPR(megdnn::CVWarpAffine);
 DEF_CV_OPR(megdnn::CVGaussianBlur);
+DEF_CV_OPR(megdnn::CVSepFilter);
+
+DEF_REFERENCE_OPR(megdnn::CVPreprocess);
+DEF_REFERENCE_OPR(megdnn::NMSKeep);
 
 }  // namespace test
 }  // namespace megcc
@@ -0,0 +1,187 @@
+#include "test/kernel/common/roofline.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <ctime>
+#include <fstream>
+#include "megbrain/common.h"
+using namespace megcc::test;
+
+namespace {
+using clock_type = std::chrono::high_resolution_clock;
+
+double elapsed_s(clock_type::time_point start) {
+    return std::chrono::duration<double>(clock_type::now() - start).count();
+}
+
+//! enough independent lanes to cover the latency of the FMA pipeline after
+//! the loop is vectorized by the compiler
+constexpr int nr_fma_lanes = 64;
+constexpr size_t nr_fma_iter = 1 << 20;
+
+float probe_compute_gflops() {
+    float acc[nr_fma_lanes], mul[nr_fma_lanes], add[nr_fma_lanes];
+    for (int i = 0; i < nr_fma_lanes; ++i) {
+        acc[i] = 0.f;
+        mul[i] = 0.999f - i * 1e-6f;
+        add[i] = 1e-3f + i * 1e-6f;
+    }
+    double best = 1e30;
+    for (int rep = 0; rep < 3; ++rep) {
+        auto start = clock_type::now();
+        for (size_t iter = 0; iter < nr_fma_iter; ++iter) {
+            for (int i = 0; i < nr_fma_lanes; ++i) {
+                acc[i] = acc[i] * mul[i] + add[i];
+            }
+        }
+        best = std::min(best, elapsed_s(start));
+    }
+    //! keep the accumulators alive
+    volatile float sink = 0.f;
+    for (int i = 0; i < nr_fma_lanes; ++i) {
+        sink = sink + acc[i];
+    }
+    (void)sink;
+    return 2.0 * nr_fma_lanes * nr_fma_iter / best / 1e9;
+}
+
+//! the arrays are far larger than the last level cache
+constexpr size_t nr_stream_elem = 4 << 20;
+
+float probe_memory_gbps() {
+    std::vector<float> a(nr_stream_elem, 0.f), b(nr_stream_elem, 1.f),
+            c(nr_stream_elem, 2.f);
+    const float scalar = 3.f;
+    double best = 1e30;
+    for (int rep = 0; rep < 5; ++rep) {
+        auto start = clock_type::now();
+        float* pa = a.data();
+        const float* pb = b.data();
+        const float* pc = c.data();
+        for (size_t i = 0; i < nr_stream_elem; ++i) {
+            pa[i] = pb[i] + scalar * pc[i];
+        }
+        best = std::min(best, elapsed_s(start));
+    }
+    volatile float sink = a[nr_stream_elem / 2];
+    (void)sink;
+    return 3.0 * sizeof(float) * nr_stream_elem / best / 1e9;
+}
+}  // namespace
+
+const MachinePeak& megcc::test::get_machine_peak() {
+    static MachinePeak peak = [] {
+        MachinePeak ret;
+        ret.compute_gflops = probe_compute_gflops();
+        ret.memory_gbps = probe_memory_gbps();
+        printf("machine peak: %f GFLOPS (fp32 FMA), %f GB/s (STREAM triad)\n",
+               ret.compute_gflops, ret.memory_gbps);
+        return ret;
+    }();
+    return peak;
+}
+
+RooflineRecorder& RooflineRecorder::inst() {
+    static RooflineRecorder recorder;
+    return recorder;
+}
+
+RooflineRecorder::RooflineRecorder() {
+    if (const char* prefix = getenv("MEGCC_BENCHMARK_OUTPUT")) {
+        m_output_prefix = prefix;
+    }
+}
+
+RooflineRecorder::~RooflineRecorder() {
+    if (m_output_prefix.empty() || m_records.empty()) {
+        return;
+    }
+    dump_csv(m_output_prefix + ".csv");
+    dump_json(m_output_prefix + ".json");
+}
+
+RooflineRecord RooflineRecorder::record(
+        const std::string& kernel_type, const std::string& kernel_symbol,
+        const PerformanceResultPair& result) {
+    RooflineRecord rec;
+    rec.kernel_type = kernel_type;
+    rec.kernel_symbol = kernel_symbol;
+    rec.args = result.args;
+    auto& perf = result.megcc_performance;
+    if (!perf.valid || perf.kernel_time_ms <= 0) {
+        return rec;
+    }
+    auto& peak = get_machine_peak();
+    rec.time_ms = perf.kernel_time_ms;
+    rec.gflops = perf.compute_throughput_gops;
+    rec.gbps = perf.memory_throughput_mbps / 1e3;
+    rec.intensity = rec.gbps > 0 ? rec.gflops / rec.gbps : 0;
+    rec.bound_gflops = std::min(peak.compute_gflops, rec.intensity * peak.memory_gbps);
+    //! pure data movement kernels have no compute, measure them by bandwidth
+    if (rec.gflops > 0 && rec.bound_gflops > 0) {
+        rec.efficiency = rec.gflops / rec.bound_gflops;
+    } else if (peak.memory_gbps > 0) {
+        rec.efficiency = rec.gbps / peak.memory_gbps;
+    }
+    printf("roofline %s: %f GFLOPS, %f GB/s, intensity %f, bound %f GFLOPS, "
+           "efficiency %.2f%%\n",
+           kernel_type.c_str(), rec.gflops, rec.gbps, rec.intensity, rec.bound_gflops,
+           rec.efficiency * 100);
+    m_records.push_back(rec);
+    return rec;
+}
+
+void RooflineRecorder::dump_csv(const std::string& path) const {
+    auto quote = [](const std::string& str) {
+        std::string ret = "\"";
+        for (char c : str) {
+            ret.push_back(c);
+            if (c == '"') {
+                ret.push_back('"');
+            }
+        }
+        return ret + "\"";
+    };
+    std::ofstream out(path);
+    mgb_assert(out.good(), "can not open %s", path.c_str());
+    out << "kernel_type,kernel_symbol,args,time_ms,gflops,gbps,intensity,bound_"
+           "gflops,efficiency\n";
+    for (auto& rec : m_records) {
+        out << rec.kernel_type << "," << quote(rec.kernel_symbol) << ","
+            << quote(rec.args) << "," << rec.time_ms << "," << rec.gflops << ","
+            << rec.gbps << "," << rec.intensity << "," << rec.bound_gflops << ","
+            << rec.efficiency << "\n";
+    }
+    printf("roofline csv written to %s\n", path.c_str());
+}
+
+void RooflineRecorder::dump_json(const std::string& path) const {
+    auto escape = [](const std::string& str) {
+        std::string ret;
+        for (char c : str) {
+            if (c == '"' || c == '\\') {
+                ret.push_back('\\');
+            }
+            ret.push_back(c);
+        }
+        return ret;
+    };
+    auto& peak = get_machine_peak();
+    std::ofstream out(path);
+    mgb_assert(out.good(), "can not open %s", path.c_str());
+    out << "{\"timestamp\":" << time(nullptr)
+        << ",\"peak_gflops\":" << peak.compute_gflops
+        << ",\"peak_gbps\":" << peak.memory_gbps << ",\"records\":[";
+    for (size_t i = 0; i < m_records.size(); ++i) {
+        auto& rec = m_records[i];
+        out << (i ? ",\n" : "\n") << "{\"kernel_type\":\"" << rec.kernel_type
+            << "\",\"kernel_symbol\":\"" << escape(rec.kernel_symbol)
+            << "\",\"args\":\"" << escape(rec.args) << "\",\"time_ms\":" << rec.time_ms
+            << ",\"gflops\":" << rec.gflops << ",\"gbps\":" << rec.gbps
+            << ",\"intensity\":" << rec.intensity
+            << ",\"bound_gflops\":" << rec.bound_gflops
+            << ",\"efficiency\":" << rec.efficiency << "}";
+    }
+    out << "\n]}\n";
+    printf("roofline json written to %s\n", path.c_str());
+}
@@ -0,0 +1,59 @@
+#pragma once
+#include <vector>
+#include "test/kernel/common/checker.h"
+
+namespace megcc {
+namespace test {
+
+/*!
+ * the float reference of the MatrixMul with the (N, K) int8 or (N, K / 2)
+ * packed int4 weight used with transposeB, the weight is dequantized by the
+ * scales of nr_group = scales.size() / N groups along K of every row, the
+ * group is ceil(K / nr_group) rounded up to the int4 block of 32 and the last
+ * group keeps the rest of K. Every 32 int4 values are packed into 16 bytes, the
+ * low nibble of byte j holds value j and the high nibble holds value j + 16
+ */
+inline Checker<megdnn::MatrixMulForward>::Reference weight_quant_matmul_reference(
+        std::vector<float> scales, bool int4) {
+    return [scales, int4](megdnn::MatrixMulForward*, const TensorNDArray& tensors) {
+        auto&& a = tensors[0];
+        auto&& b = tensors[1];
+        auto&& c = tensors[2];
+        size_t m = a.layout[0], k = a.layout[1], n = b.layout[0];
+        size_t nr_group = scales.size() / n;
+        size_t align = int4 ? 32 : 1;
+        size_t group = ((k + nr_group - 1) / nr_group + align - 1) / align * align;
+        std::vector<float> weight(n * k);
+        for (size_t n_idx = 0; n_idx < n; ++n_idx) {
+            const megdnn::dt_qint8* row =
+                    b.ptr<megdnn::dt_qint8>() + n_idx * b.layout[1];
+            for (size_t k_idx = 0; k_idx < k; ++k_idx) {
+                int value;
+                if (int4) {
+                    int8_t packed = row[k_idx / 32 * 16 + k_idx % 16].as_int8();
+                    value = k_idx % 32 < 16 ? (int8_t)((uint8_t)packed << 4) >> 4
+                                            : packed >> 4;
+                } else {
+                    value = row[k_idx].as_int8();
+                }
+                weight[n_idx * k + k_idx] =
+                        value * scales[n_idx * nr_group + k_idx / group];
+            }
+        }
+        for (size_t m_idx = 0; m_idx < m; ++m_idx) {
+            for (size_t n_idx = 0; n_idx < n; ++n_idx) {
+                float sum = 0.f;
+                for (size_t k_idx = 0; k_idx < k; ++k_idx) {
+                    sum += a.ptr<float>()[m_idx * k + k_idx] *
+                           weight[n_idx * k + k_idx];
+                }
+                c.ptr<float>()[m_idx * n + n_idx] = sum;
+            }
+        }
+    };
+}
+
+}  // namespace test
+}  // namespace megcc
+
+// vim: syntax=cpp.doxygen
@@ -19,6 +19,21 @@ TEST(AARCH64, ElementwiseUnique) {
     }
 }
 
+TEST(AARCH64, ElementwiseUniqueFastMath) {
+    Checker<ElemwiseForward> checker(Arch::ARM64);
+    checker.set_kernel_symbol("ArmCommon_kernel_elementwise.+_fastmath_ulp.+");
+    ElemwiseForward::Param param;
+    param.mode = MODE::EXP;
+    checker.set_param(param);
+    megcc::test::UniformRNG rng(-20.0, 20.0);
+    checker.set_rng(0, &rng);
+    for (int ulp : {4, 80}) {
+        checker.set_fast_math_ulp(ulp);
+        checker.execs({{1, 10}, {}});
+        checker.execs({{1, 10, 12, 13}, {}});
+    }
+}
+
 TEST(AARCH64, ElementwiseUnique_asm) {
     Checker<ElemwiseForward> checker(Arch::ARM64);
     checker.set_kernel_symbol("Arm64_kernel_elementwise.+");
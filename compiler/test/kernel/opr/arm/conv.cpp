@@ -1,6 +1,7 @@
 #include "megbrain/reflection.h"
 #include "test/kernel/common/benchmark.h"
 #include "test/kernel/common/checker.h"
+#include "test/kernel/common/quant_conv_reference.h"
 
 using namespace megdnn;
 using namespace megcc::test;
@@ -676,4 +677,93 @@ TEST(AARCH64, ConvBiasChannelBroadcastBias) {
 #endif
     }
 }
+
+TEST(AARCH64, ConvBackDataNCHW) {
+    Checker<ConvolutionBackwardData> checker(Arch::ARM64);
+    checker.set_kernel_symbol("Arm64_kernel_back_data_conv2d_.*");
+    ConvolutionBackwardData::Param param;
+    param.compute_mode = ConvolutionBackwardData::Param::ComputeMode::DEFAULT;
+    param.format = ConvolutionBackwardData::Param::Format::NCHW;
+    checker.set_epsilon(1e-4);
+    for (size_t oc : {3, 8})
+        for (size_t ic : {4, 13})
+            for (size_t hw : {7, 23})
+                for (size_t kernel : {1, 2, 3, 4})
+                    for (size_t pad : {0, 1})
+                        for (size_t stride : {1, 2}) {
+                            size_t out_hw = (hw - 1) * stride + kernel - 2 * pad;
+                            param.pad_h = pad;
+                            param.pad_w = pad;
+                            param.stride_h = stride;
+                            param.stride_w = stride;
+                            param.sparse = ConvolutionBackwardData::Param::Sparse::DENSE;
+                            checker.set_param(param);
+                            checker.execs(
+                                    {{oc, ic, kernel, kernel},
+                                     {2, oc, hw, hw},
+                                     {2, ic, out_hw, out_hw}});
+                            param.sparse = ConvolutionBackwardData::Param::Sparse::GROUP;
+                            checker.set_param(param);
+                            checker.execs(
+                                    {{2, oc, ic, kernel, kernel},
+                                     {2, oc * 2, hw, hw},
+                                     {2, ic * 2, out_hw, out_hw}});
+                        }
+}
+
+TEST(AARCH64, ConvBiasNCHW44DotInt8PerChannel) {
+    //! the filter dtype scale is ignored by the kernels reading the scales
+    UniformIntRNG qint_rng(-3, 3);
+    std::vector<float> scales;
+    for (size_t oc = 0; oc < 24; ++oc) {
+        scales.push_back(0.25f + 0.125f * oc);
+    }
+    Checker<ConvBiasForward> checker(Arch::ARM64);
+    checker.set_dtype(0, dtype::QuantizedS8(0.5f))
+            .set_dtype(1, dtype::QuantizedS8(3.f))
+            .set_dtype(2, dtype::QuantizedS32(1.5f))
+            .set_dtype(4, dtype::QuantizedS8(2.f));
+    checker.set_rng(0, &qint_rng).set_rng(1, &qint_rng).set_rng(2, &qint_rng);
+    checker.set_epsilon(1 + 1e-3);
+    ConvBiasForward::Param param;
+    param.compute_mode = ConvBiasForward::Param::ComputeMode::DEFAULT;
+    param.format = ConvBiasForward::Param::Format::NCHW44_DOT;
+    for (auto noline :
+         {ConvBiasForward::Param::NonlineMode::IDENTITY,
+          ConvBiasForward::Param::NonlineMode::RELU})
+        for (size_t stride : {1, 2}) {
+            param.nonlineMode = noline;
+            param.stride_h = stride;
+            param.stride_w = stride;
+            param.pad_h = 1;
+            param.pad_w = 1;
+            param.sparse = ConvBiasForward::Param::Sparse::DENSE;
+            checker.set_param(param);
+            checker.set_kernel_symbol("Arm64_kernel_conv2d_im2col_dot_.*");
+            checker.set_scales(1, {scales.begin(), scales.begin() + 20});
+            checker.set_reference(
+                    per_channel_conv_reference({scales.begin(), scales.begin() + 20}));
+            checker.execs(
+                    {{2, 3, 9, 11, 4},
+                     {5, 3, 3, 3, 4, 4},
+                     {1, 5, 1, 1, 4},
+                     {},
+                     {}});
+            checker.set_kernel_symbol(".+dot_nchw_nchw44.+");
+            checker.execs({{2, 3, 11, 17}, {5, 3, 3, 3, 4}, {1, 5, 1, 1, 4}, {}, {}});
+
+            param.sparse = ConvBiasForward::Param::Sparse::GROUP;
+            checker.set_param(param);
+            checker.set_kernel_symbol("Arm64_kernel_conv2d_im2col_dot_.*");
+            checker.set_scales(1, scales);
+            checker.set_reference(per_channel_conv_reference(scales));
+            checker.execs(
+                    {{1, 4, 10, 10, 4},
+                     {2, 3, 2, 3, 3, 4, 4},
+                     {1, 6, 1, 1, 4},
+                     {},
+                     {}});
+        }
+}
+
 // vim: syntax=cpp.doxygen
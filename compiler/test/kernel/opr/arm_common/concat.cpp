@@ -0,0 +1,31 @@
+#include "test/kernel/common/checker.h"
+using namespace megdnn;
+using namespace megcc::test;
+using namespace megcc::KernelGen;
+
+TEST(ARMCOMMON, Concat) {
+#ifdef __aarch64__
+    Checker<Concat> checker(Arch::ARM64);
+#else
+    Checker<Concat> checker(Arch::ARMV7);
+#endif
+    checker.set_kernel_symbol("ArmCommon_kernel_concat.*");
+    checker.set_dynamic_megcc(true);
+    using Param = Concat::Param;
+    for (auto dtype : std::vector<DType>{dtype::Float32(), dtype::Int8()}) {
+        for (size_t axis = 0; axis < 4; ++axis) {
+            Param param;
+            param.axis = axis;
+            TensorShapeArray shapes(3, TensorShape({5, 6, 7, 9}));
+            for (size_t i = 0; i < 3; ++i) {
+                shapes[i].shape[axis] = i + 1;
+            }
+            shapes.emplace_back();
+            for (size_t i = 0; i < shapes.size(); ++i)
+                checker.set_dtype(i, dtype);
+            checker.set_param(param).exec(shapes);
+        }
+    }
+    checker.set_param(Param{1});
+    checker.execs({{2, 3, 9, 11, 4}, {2, 5, 9, 11, 4}, {}});
+}
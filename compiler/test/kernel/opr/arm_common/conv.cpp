@@ -1,4 +1,5 @@
 #include "test/kernel/common/checker.h"
+#include "test/kernel/common/quant_conv_reference.h"
 
 using namespace megdnn;
 using namespace megcc::test;
@@ -307,6 +308,99 @@ TEST(ARMCOMMON, WinogradF23NCHW44MK8Int8) {
 #endif
 }
 
+TEST(ARMCOMMON, WinogradF43NCHW44MK8Int8) {
+#ifdef __aarch64__
+    Checker<ConvBiasForward> checker(Arch::ARM64, 0);
+#else
+    Checker<ConvBiasForward> checker(Arch::ARMV7, 0);
+#endif
+    checker.set_dtype(0, dtype::QuantizedS8(2.5f))
+            .set_dtype(1, dtype::QuantizedS8(2.5f))
+            .set_dtype(2, dtype::QuantizedS32(6.25f))
+            .set_dtype(4, dtype::QuantizedS8(40.25f));
+    checker.set_epsilon(1e-4);
+    checker.set_kernel_symbol(".+_winograd_f43_int8_nchw44_mk8");
+    ConvBiasForward::Param param;
+    param.compute_mode = ConvBiasForward::Param::ComputeMode::DEFAULT;
+    param.format = ConvBiasForward::Param::Format::NCHW44;
+    size_t kernel = 3;
+    param.stride_h = 1;
+    param.stride_w = 1;
+    for (auto noline :
+         {ConvBiasForward::Param::NonlineMode::IDENTITY,
+          ConvBiasForward::Param::NonlineMode::RELU,
+          ConvBiasForward::Param::NonlineMode::H_SWISH})
+        for (size_t pad : {0, 1}) {
+            param.pad_h = pad;
+            param.pad_w = pad;
+            param.nonlineMode = noline;
+            param.sparse = ConvBiasForward::Param::Sparse::DENSE;
+            checker.set_param(param);
+            checker.execs(
+                    {{1, 2, 4, 4, 4},
+                     {2, 2, kernel, kernel, 4, 4},
+                     {1, 2, 1, 1, 4},
+                     {},
+                     {}});
+            checker.execs(
+                    {{2, 8, 10, 10, 4},
+                     {8, 8, kernel, kernel, 4, 4},
+                     {1, 8, 1, 1, 4},
+                     {},
+                     {}});
+            checker.execs(
+                    {{1, 2, 73, 11, 4},
+                     {12, 2, kernel, kernel, 4, 4},
+                     {1, 12, 1, 1, 4},
+                     {},
+                     {}});
+            checker.execs(
+                    {{1, 16, 30, 30, 4}, {4, 16, kernel, kernel, 4, 4}, {}, {}, {}});
+
+            param.sparse = ConvBiasForward::Param::Sparse::GROUP;
+            checker.set_param(param);
+            checker.execs(
+                    {{1, 8, 5, 3, 4},
+                     {2, 4, 4, kernel, kernel, 4, 4},
+                     {1, 8, 1, 1, 4},
+                     {},
+                     {}});
+            checker.execs(
+                    {{2, 16, 10, 10, 4},
+                     {4, 2, 4, kernel, kernel, 4, 4},
+                     {1, 8, 1, 1, 4},
+                     {},
+                     {}});
+        }
+}
+
+TEST(ARMCOMMON, WinogradF43NCHW44MK8Int8MaxIC) {
+#ifdef __aarch64__
+    Checker<ConvBiasForward> checker(Arch::ARM64, 0);
+#else
+    Checker<ConvBiasForward> checker(Arch::ARMV7, 0);
+#endif
+    //! all -128 give the largest conv result of IC * 9 * 128 * 128, which is
+    //! 33030144 for IC 224 and below the exact limit 2^25, IC 232 is over it
+    ConstRNG min_rng(-128);
+    checker.set_rng(0, &min_rng).set_rng(1, &min_rng);
+    checker.set_dtype(0, dtype::QuantizedS8(1.f))
+            .set_dtype(1, dtype::QuantizedS8(1.f))
+            .set_dtype(2, dtype::QuantizedS32(1.f))
+            .set_dtype(4, dtype::QuantizedS8(3e5f));
+    checker.set_epsilon(1e-4);
+    checker.set_kernel_symbol(".+_winograd_f43_int8_nchw44_mk8");
+    ConvBiasForward::Param param;
+    param.format = ConvBiasForward::Param::Format::NCHW44;
+    param.sparse = ConvBiasForward::Param::Sparse::DENSE;
+    checker.set_param(param);
+    checker.execs({{1, 56, 6, 6, 4}, {2, 56, 3, 3, 4, 4}, {}, {}, {}});
+#ifdef __x86_64__
+    EXPECT_DEATH(
+            checker.execs({{1, 58, 6, 6, 4}, {2, 58, 3, 3, 4, 4}, {}, {}, {}}), "");
+#endif
+}
+
 TEST(ARMCOMMON, ConvBiasNCHWNCHW44Int8) {
 #ifdef __aarch64
     Checker<ConvBiasForward> checker(Arch::ARM64);
@@ -356,4 +450,87 @@ TEST(ARMCOMMON, ConvBiasNCHWNCHW44Int8) {
     run(2, {2, 3, 5, 7});
 }
 
+TEST(ARMCOMMON, ConvBiasNCHW44Int8PerChannel) {
+    //! the filter dtype scale is ignored by the kernels reading the scales
+    UniformIntRNG qint_rng(-3, 3);
+    std::vector<float> scales;
+    for (size_t oc = 0; oc < 24; ++oc) {
+        scales.push_back(0.25f + 0.125f * oc);
+    }
+#ifdef __aarch64__
+    const Arch arch = Arch::ARM64;
+#else
+    const Arch arch = Arch::ARMV7;
+#endif
+    auto set_checker = [&](Checker<ConvBiasForward>& checker, const std::string& symbol,
+                           size_t nr_scale) {
+        checker.set_dtype(0, dtype::QuantizedS8(0.5f))
+                .set_dtype(1, dtype::QuantizedS8(3.f))
+                .set_dtype(2, dtype::QuantizedS32(1.5f))
+                .set_dtype(4, dtype::QuantizedS8(2.f));
+        checker.set_rng(0, &qint_rng).set_rng(1, &qint_rng).set_rng(2, &qint_rng);
+        checker.set_epsilon(1 + 1e-3);
+        checker.set_kernel_symbol(symbol);
+        std::vector<float> oc_scales(scales.begin(), scales.begin() + nr_scale);
+        checker.set_scales(1, oc_scales);
+        checker.set_reference(per_channel_conv_reference(oc_scales));
+    };
+    ConvBiasForward::Param param;
+    param.compute_mode = ConvBiasForward::Param::ComputeMode::DEFAULT;
+    param.format = ConvBiasForward::Param::Format::NCHW44;
+    param.pad_h = 1;
+    param.pad_w = 1;
+    for (auto noline :
+         {ConvBiasForward::Param::NonlineMode::IDENTITY,
+          ConvBiasForward::Param::NonlineMode::RELU}) {
+        param.nonlineMode = noline;
+        for (size_t stride : {1, 2}) {
+            param.stride_h = stride;
+            param.stride_w = stride;
+            param.sparse = ConvBiasForward::Param::Sparse::DENSE;
+            Checker<ConvBiasForward> direct(arch), hybrid(arch), chanwise(arch);
+            set_checker(direct, "ArmCommon_direct.+", 20);
+            direct.set_param(param);
+            direct.execs(
+                    {{2, 3, 9, 11, 4},
+                     {5, 3, 3, 3, 4, 4},
+                     {1, 5, 1, 1, 4},
+                     {},
+                     {}});
+            set_checker(hybrid, "ArmCommon_nchw_nchw44.+", 20);
+            hybrid.set_param(param);
+            hybrid.execs({{1, 3, 10, 19}, {5, 3, 3, 3, 4}, {1, 5, 1, 1, 4}, {}, {}});
+
+            param.sparse = ConvBiasForward::Param::Sparse::GROUP;
+            set_checker(direct, "ArmCommon_direct.+", 24);
+            direct.set_param(param);
+            direct.execs(
+                    {{1, 4, 10, 10, 4},
+                     {2, 3, 2, 3, 3, 4, 4},
+                     {1, 6, 1, 1, 4},
+                     {},
+                     {}});
+            set_checker(chanwise, "ArmCommon_chanwise.+", 8);
+            chanwise.set_param(param);
+            chanwise.execs(
+                    {{2, 2, 13, 23, 4}, {2, 1, 1, 3, 3, 4}, {1, 2, 1, 1, 4}, {}, {}});
+        }
+        param.stride_h = 1;
+        param.stride_w = 1;
+        param.sparse = ConvBiasForward::Param::Sparse::DENSE;
+        for (std::string symbol :
+             {".+_winograd_f23_int8_nchw44_mk8", ".+_winograd_f43_int8_nchw44_mk8"}) {
+            Checker<ConvBiasForward> winograd(arch);
+            set_checker(winograd, symbol, 16);
+            winograd.set_param(param);
+            winograd.execs(
+                    {{1, 4, 10, 13, 4},
+                     {4, 4, 3, 3, 4, 4},
+                     {1, 4, 1, 1, 4},
+                     {},
+                     {}});
+        }
+    }
+}
+
 // vim: syntax=cpp.doxygen
@@ -0,0 +1,77 @@
+#include "test/kernel/common/checker.h"
+using namespace megdnn;
+using namespace megcc::test;
+using namespace megcc::KernelGen;
+
+TEST(ARMCOMMON, IndexingMultiAxisVec) {
+#ifdef __aarch64__
+    Checker<IndexingMultiAxisVec> checker(Arch::ARM64);
+#else
+    Checker<IndexingMultiAxisVec> checker(Arch::ARMV7);
+#endif
+    checker.set_kernel_symbol("ArmCommon_kernel_indexingmultiaxisvec.*");
+    checker.set_dynamic_megcc(true);
+    UniformIntRNG idx_rng(-5, 4);
+    ConstRNG zero(0);
+
+    auto run = [&]() {
+        checker.set_proxy({{0}});
+        checker.execs({{10}, {5}, {5}});
+        checker.execs({{10, 67}, {5, 67}, {5}});
+
+        checker.set_proxy({{1}});
+        checker.execs({{3, 10, 7}, {3, 5, 7}, {5}});
+
+        checker.set_proxy({{1, 2}});
+        checker.execs({{10, 7, 11, 9}, {10, 5, 9}, {5}, {5}});
+
+        checker.set_proxy({{1, 2, 3}});
+        checker.execs({{5, 5, 6, 7, 3}, {5, 2, 3, 4, 3}, {3, 1}, {2, 1, 1}, {1, 4}});
+    };
+
+    checker.set_dtype(2, dtype::Int32())
+            .set_dtype(3, dtype::Int32())
+            .set_dtype(4, dtype::Int32())
+            .set_rng(2, &zero)
+            .set_rng(3, &idx_rng)
+            .set_rng(4, &idx_rng);
+
+    checker.set_dtype(0, dtype::Float32()).set_dtype(1, dtype::Float32());
+    run();
+    checker.set_dtype(0, dtype::Int8()).set_dtype(1, dtype::Int8());
+    run();
+
+    //! the src with strides is gathered element by element
+    checker.set_rng(2, &idx_rng);
+    for (DType dtype :
+         {static_cast<DType>(dtype::Float32()), static_cast<DType>(dtype::Int8())}) {
+        TensorLayout index({5}, dtype::Int32());
+        checker.set_proxy({{0}});
+        checker.execl(
+                {TensorLayout({10, 7}, {9, 1}, dtype), TensorLayout({5, 7}, dtype),
+                 index});
+        checker.set_proxy({{1}});
+        checker.execl(
+                {TensorLayout({3, 10, 7}, {100, 9, 1}, dtype),
+                 TensorLayout({3, 5, 7}, dtype), index});
+        checker.execl(
+                {TensorLayout({7, 10}, {1, 7}, dtype), TensorLayout({7, 5}, dtype),
+                 index});
+    }
+}
+
+TEST(ARMCOMMON, IndexingOneHot) {
+#ifdef __aarch64__
+    Checker<IndexingOneHot> checker(Arch::ARM64);
+#else
+    Checker<IndexingOneHot> checker(Arch::ARMV7);
+#endif
+    checker.set_kernel_symbol("ArmCommon_kernel_indexingonehot.*");
+    UniformIntRNG rng_idx{0, 7};
+    checker.set_param({2}).set_dtype(1, dtype::Int32{}).set_rng(1, &rng_idx);
+    checker.execs({{10, 4, 8, 9}, {10, 4, 9}, {}});
+    checker.execs({{10, 4, 8, 9, 7}, {10, 4, 9, 7}, {}});
+    checker.set_param({1});
+    checker.execs({{10, 8, 17}, {10, 17}, {}});
+    checker.execs({{10, 8, 1}, {10, 1}, {}});
+}
@@ -0,0 +1,41 @@
+#include "test/kernel/common/checker.h"
+using namespace megdnn;
+using namespace megcc::test;
+using namespace megcc::KernelGen;
+
+TEST(ARMCOMMON, Padding) {
+#ifdef __aarch64__
+    Checker<megdnn::Padding> checker(Arch::ARM64);
+#else
+    Checker<megdnn::Padding> checker(Arch::ARMV7);
+#endif
+    checker.set_kernel_symbol("ArmCommon_kernel_padding.*");
+    megdnn::Padding::Param param;
+    using PaddingMode = megdnn::Padding::Param::PaddingMode;
+    auto run = [&checker, &param](float padding_val) {
+        for (auto mode :
+             {PaddingMode::CONSTANT, PaddingMode::REFLECT, PaddingMode::REPLICATE}) {
+            param = {};
+            param.padding_mode = mode;
+            param.padding_val = padding_val;
+            param.front_offset_dim2 = 1;
+            param.back_offset_dim2 = 2;
+            param.front_offset_dim3 = 3;
+            param.back_offset_dim3 = 1;
+            checker.set_param(param);
+            checker.exec({{3, 3, 17, 19}, {}});
+            checker.exec({{2, 3, 9, 11, 4}, {}});
+        }
+    };
+    UniformIntRNG int8_rng(-128, 127);
+    checker.set_rng(0, &int8_rng);
+    checker.set_dtype(0, dtype::Int8());
+    checker.set_dtype(1, dtype::Int8());
+    run(-2.f);
+
+    megcc::test::UniformRNG rng(-30, 30);
+    checker.set_rng(0, &rng);
+    checker.set_dtype(0, dtype::Float32());
+    checker.set_dtype(1, dtype::Float32());
+    run(-1.5f);
+}
@@ -1,4 +1,5 @@
 #include "test/kernel/common/checker.h"
+#include "test/kernel/common/quant_conv_reference.h"
 
 using namespace megdnn;
 using namespace megcc::test;
@@ -452,4 +453,68 @@ TEST(ARMV7, ConvBiasChannelBroadcastBias) {
 #endif
     }
 }
+
+TEST(ARMV7, ConvBiasInt8PerChannel) {
+    //! the filter dtype scale is ignored by the kernels reading the scales
+    UniformIntRNG qint_rng(-3, 3);
+    std::vector<float> scales;
+    for (size_t oc = 0; oc < 24; ++oc) {
+        scales.push_back(0.25f + 0.125f * oc);
+    }
+    auto set_checker = [&](Checker<ConvBiasForward>& checker, const std::string& symbol,
+                           size_t nr_scale) {
+        checker.set_dtype(0, dtype::QuantizedS8(0.5f))
+                .set_dtype(1, dtype::QuantizedS8(3.f))
+                .set_dtype(2, dtype::QuantizedS32(1.5f))
+                .set_dtype(4, dtype::QuantizedS8(2.f));
+        checker.set_rng(0, &qint_rng).set_rng(1, &qint_rng).set_rng(2, &qint_rng);
+        checker.set_epsilon(1 + 1e-3);
+        checker.set_kernel_symbol(symbol);
+        std::vector<float> oc_scales(scales.begin(), scales.begin() + nr_scale);
+        checker.set_scales(1, oc_scales);
+        checker.set_reference(per_channel_conv_reference(oc_scales));
+    };
+    ConvBiasForward::Param param;
+    param.compute_mode = ConvBiasForward::Param::ComputeMode::DEFAULT;
+    for (auto noline :
+         {ConvBiasForward::Param::NonlineMode::IDENTITY,
+          ConvBiasForward::Param::NonlineMode::RELU,
+          ConvBiasForward::Param::NonlineMode::H_SWISH}) {
+        param.nonlineMode = noline;
+        param.sparse = ConvBiasForward::Param::Sparse::DENSE;
+        param.stride_h = 1;
+        param.stride_w = 1;
+        param.pad_h = 0;
+        param.pad_w = 0;
+        param.format = ConvBiasForward::Param::Format::NCHW44;
+        Checker<ConvBiasForward> conv1x1(Arch::ARMV7), dot1x1(Arch::ARMV7_WITH_DOT);
+        set_checker(conv1x1, "Armv7_int8_Conv1x1.*", 20);
+        conv1x1.set_param(param);
+        conv1x1.execs({{2, 3, 13, 10, 4}, {5, 3, 1, 1, 4, 4}, {1, 5, 1, 1, 4}, {}, {}});
+        param.format = ConvBiasForward::Param::Format::NCHW;
+        set_checker(dot1x1, "Armv7_int8_dot_Conv1x1_M6N8K4.*", 7);
+        dot1x1.set_param(param);
+        dot1x1.execs({{1, 5, 12, 11}, {7, 5, 1, 1}, {1, 7, 1, 1}, {}, {}});
+
+        param.pad_h = 2;
+        param.pad_w = 2;
+        for (size_t stride : {1, 2}) {
+            param.stride_h = stride;
+            param.stride_w = stride;
+            Checker<ConvBiasForward> direct(
+                    stride == 1 ? Arch::ARMV7 : Arch::ARMV7_WITH_DOT);
+            set_checker(
+                    direct,
+                    stride == 1 ? "Armv7_int8_direct_.*" : "Armv7_dot_int8_direct_.*",
+                    6);
+            param.sparse = ConvBiasForward::Param::Sparse::DENSE;
+            direct.set_param(param);
+            direct.execs({{2, 4, 13, 16}, {6, 4, 5, 5}, {1, 6, 1, 1}, {}, {}});
+            param.sparse = ConvBiasForward::Param::Sparse::GROUP;
+            direct.set_param(param);
+            direct.execs({{1, 4, 13, 16}, {2, 3, 2, 5, 5}, {1, 6, 1, 1}, {}, {}});
+        }
+    }
+}
+
 // vim: syntax=cpp.doxygen
@@ -224,6 +224,55 @@ TEST(GI, Conv1x1NCHW88) {
     }
 }
 
+//! the FLOAT32 compute mode of the fp16 storage accumulates in fp32, the long
+//! reduction keeps the error of the fp16 rounding of the output only
+TEST(GI, ConvBiasIm2colConv1x1NCHW88ComputeFloat32) {
+    Checker<ConvBiasForward> checker(Arch::BAREMETAL);
+    checker.set_epsilon(1e-2);
+    ConvBiasForward::Param param;
+    param.format = ConvBiasForward::Param::Format::NCHW88;
+    param.compute_mode = ConvBiasForward::Param::ComputeMode::FLOAT32;
+    megcc::test::UniformRNG rng(-1.0, 1.0);
+    checker.set_rng(0, &rng);
+    checker.set_rng(1, &rng);
+    checker.set_rng(2, &rng);
+    checker.set_dtype(0, dtype::Float16())
+            .set_dtype(1, dtype::Float16())
+            .set_dtype(2, dtype::Float16())
+            .set_dtype(3, dtype::Float16())
+            .set_dtype(4, dtype::Float16());
+    for (auto noline :
+         {ConvBiasForward::Param::NonlineMode::IDENTITY,
+          ConvBiasForward::Param::NonlineMode::RELU}) {
+        param.nonlineMode = noline;
+        checker.set_kernel_symbol("GI_kernel_conv2d_im2colm8n8_fp16.*_comp_f32");
+        for (size_t ic : {8, 128})
+            for (size_t stride : {1, 2}) {
+                param.pad_h = 1;
+                param.pad_w = 1;
+                param.stride_h = stride;
+                param.stride_w = stride;
+                checker.set_param(param);
+                checker.execs(
+                        {{1, ic / 8, 13, 13, 8},
+                         {16 / 8, ic / 8, 3, 3, 8, 8},
+                         {1, 16 / 8, 1, 1, 8},
+                         {},
+                         {}});
+            }
+        checker.set_kernel_symbol("GI_kernel_conv2d_conv1x1_fp16.*_comp_f32");
+        param.pad_h = 0;
+        param.pad_w = 0;
+        param.stride_h = 1;
+        param.stride_w = 1;
+        checker.set_param(param);
+        for (size_t ic : {8, 512}) {
+            checker.execs(
+                    {{2, ic / 8, 5, 11, 8}, {3, ic / 8, 1, 1, 8, 8}, {1, 3, 1, 1, 8}, {}, {}});
+        }
+    }
+}
+
 TEST(GI, ConvBiasNCHWNCHW88FP16) {
     Checker<ConvBiasForward> checker(Arch::BAREMETAL);
     ConvBiasForward::Param param;
@@ -375,5 +424,47 @@ TEST(GI, ConvBiasChannelWiseNCHW8K5) {
         }
 }
 
+TEST(GI, ConvBackDataNCHW88) {
+    Checker<ConvolutionBackwardData> checker(Arch::BAREMETAL);
+    checker.set_kernel_symbol("GI_kernel_back_data_conv2d_.*");
+    checker.set_epsilon(5e-2);
+    megcc::test::Float16PeriodicalRNG rng(0x3c00);
+    checker.set_rng(0, &rng);
+    checker.set_rng(1, &rng);
+    checker.set_dtype(0, dtype::Float16())
+            .set_dtype(1, dtype::Float16())
+            .set_dtype(2, dtype::Float16());
+    ConvolutionBackwardData::Param param;
+    param.compute_mode = ConvolutionBackwardData::Param::ComputeMode::DEFAULT;
+    param.format = ConvolutionBackwardData::Param::Format::NCHW88;
+    for (size_t oc : {8, 16})
+        for (size_t ic : {8, 24})
+            for (size_t hw : {5, 11})
+                for (size_t kernel : {1, 2, 3, 5})
+                    for (size_t pad : {(size_t)0, kernel / 2})
+                        for (size_t stride : {1, 2}) {
+                            size_t out = (hw - 1) * stride + kernel - pad * 2;
+                            param.pad_h = pad;
+                            param.pad_w = pad;
+                            param.stride_h = stride;
+                            param.stride_w = stride;
+                            param.sparse = ConvolutionBackwardData::Param::Sparse::DENSE;
+                            checker.set_param(param);
+                            checker.execs(
+                                    {{oc / 8, ic / 8, kernel, kernel, 8, 8},
+                                     {2, oc / 8, hw, hw, 8},
+                                     {2, ic / 8, out, out, 8}});
+                            if (oc == 16) {
+                                param.sparse =
+                                        ConvolutionBackwardData::Param::Sparse::GROUP;
+                                checker.set_param(param);
+                                checker.execs(
+                                        {{2, 1, 1, kernel, kernel, 8, 8},
+                                         {2, 2, hw, hw, 8},
+                                         {2, 2, out, out, 8}});
+                            }
+                        }
+}
+
 #endif
 // vim: syntax=cpp.doxygen
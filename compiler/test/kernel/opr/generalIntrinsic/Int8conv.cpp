@@ -0,0 +1,291 @@
+#include "test/kernel/common/checker.h"
+#include "test/kernel/common/quant_conv_reference.h"
+
+using namespace megdnn;
+using namespace megcc::test;
+using namespace megcc::KernelGen;
+
+TEST(GI, ConvBiasChannelWiseNCHW44Int8) {
+    Checker<ConvBiasForward> checker(Arch::BAREMETAL);
+    checker.set_dtype(0, dtype::QuantizedS8(2.5f))
+            .set_dtype(1, dtype::QuantizedS8(2.5f))
+            .set_dtype(2, dtype::QuantizedS32(6.25f))
+            .set_dtype(4, dtype::QuantizedS8(40.25f));
+    checker.set_epsilon(1e-4);
+    checker.set_kernel_symbol("GI_chanwise_int8.+");
+    ConvBiasForward::Param param;
+    param.compute_mode = ConvBiasForward::Param::ComputeMode::DEFAULT;
+    param.format = ConvBiasForward::Param::Format::NCHW44;
+    param.sparse = ConvBiasForward::Param::Sparse::GROUP;
+    for (auto noline :
+         {ConvBiasForward::Param::NonlineMode::IDENTITY,
+          ConvBiasForward::Param::NonlineMode::RELU,
+          ConvBiasForward::Param::NonlineMode::H_SWISH})
+        for (size_t pad : {0, 1, 2})
+            for (size_t stride : {1, 2})
+                for (size_t kernel : {2, 3, 5, 7}) {
+                    param.pad_h = pad;
+                    param.pad_w = pad;
+                    param.nonlineMode = noline;
+                    param.stride_h = stride;
+                    param.stride_w = stride;
+                    checker.set_param(param);
+                    checker.execs(
+                            {{2, 8, 13, 23, 4},
+                             {8, 1, 1, kernel, kernel, 4},
+                             {1, 8, 1, 1, 4},
+                             {},
+                             {}});
+                    checker.execs(
+                            {{1, 3, 14, 9, 4},
+                             {3, 1, 1, kernel, kernel, 4},
+                             {},
+                             {},
+                             {}});
+                }
+}
+
+TEST(GI, ConvBiasDirectNCHW44Int8) {
+    Checker<ConvBiasForward> checker(Arch::BAREMETAL);
+    checker.set_dtype(0, dtype::QuantizedS8(2.5f))
+            .set_dtype(1, dtype::QuantizedS8(2.5f))
+            .set_dtype(2, dtype::QuantizedS32(6.25f))
+            .set_dtype(4, dtype::QuantizedS8(40.25f));
+    checker.set_epsilon(1e-4);
+    checker.set_kernel_symbol("GI_direct_int8.+");
+    ConvBiasForward::Param param;
+    param.compute_mode = ConvBiasForward::Param::ComputeMode::DEFAULT;
+    param.format = ConvBiasForward::Param::Format::NCHW44;
+    for (auto noline :
+         {ConvBiasForward::Param::NonlineMode::IDENTITY,
+          ConvBiasForward::Param::NonlineMode::RELU,
+          ConvBiasForward::Param::NonlineMode::H_SWISH})
+        for (size_t stride : {1, 2})
+            for (size_t kernel : {2, 3, 5, 7}) {
+                param.pad_h = kernel / 2;
+                param.pad_w = kernel / 2;
+                param.stride_h = stride;
+                param.stride_w = stride;
+                param.nonlineMode = noline;
+                param.sparse = ConvBiasForward::Param::Sparse::GROUP;
+                checker.set_param(param);
+                checker.execs(
+                        {{2, 6, 10, 10, 4},
+                         {2, 3, 3, kernel, kernel, 4, 4},
+                         {1, 6, 1, 1, 4},
+                         {},
+                         {}});
+                param.sparse = ConvBiasForward::Param::Sparse::DENSE;
+                checker.set_param(param);
+                checker.execs(
+                        {{2, 3, 13, 19, 4},
+                         {5, 3, kernel, kernel, 4, 4},
+                         {1, 5, 1, 1, 4},
+                         {},
+                         {}});
+                checker.execs(
+                        {{1, 2, 9, 11, 4}, {3, 2, kernel, kernel, 4, 4}, {}, {}, {}});
+            }
+}
+
+TEST(GI, Conv1x1NCHW44Int8) {
+    Checker<ConvBiasForward> checker(Arch::BAREMETAL);
+    checker.set_dtype(0, dtype::QuantizedS8(2.5f))
+            .set_dtype(1, dtype::QuantizedS8(2.5f))
+            .set_dtype(2, dtype::QuantizedS32(6.25f))
+            .set_dtype(4, dtype::QuantizedS8(40.25f));
+    checker.set_epsilon(1e-4);
+    checker.set_kernel_symbol("GI_conv1x1_int8.+");
+    ConvBiasForward::Param param;
+    param.pad_h = 0;
+    param.pad_w = 0;
+    param.stride_h = 1;
+    param.stride_w = 1;
+    param.compute_mode = ConvBiasForward::Param::ComputeMode::DEFAULT;
+    param.format = ConvBiasForward::Param::Format::NCHW44;
+    for (auto noline :
+         {ConvBiasForward::Param::NonlineMode::IDENTITY,
+          ConvBiasForward::Param::NonlineMode::RELU,
+          ConvBiasForward::Param::NonlineMode::H_SWISH}) {
+        param.nonlineMode = noline;
+        param.sparse = ConvBiasForward::Param::Sparse::DENSE;
+        checker.set_param(param);
+        for (size_t ic : {1, 3, 8})
+            for (size_t ohw : {1, 7, 8, 23}) {
+                checker.execs(
+                        {{2, ic, 1, ohw, 4},
+                         {5, ic, 1, 1, 4, 4},
+                         {1, 5, 1, 1, 4},
+                         {},
+                         {}});
+                checker.execs({{1, ic, 3, ohw, 4}, {2, ic, 1, 1, 4, 4}, {}, {}, {}});
+            }
+        param.sparse = ConvBiasForward::Param::Sparse::GROUP;
+        checker.set_param(param);
+        checker.execs(
+                {{2, 6, 7, 9, 4}, {2, 4, 3, 1, 1, 4, 4}, {1, 8, 1, 1, 4}, {}, {}});
+    }
+}
+
+TEST(GI, ConvBiasIm2colNCHW44Int8) {
+    Checker<ConvBiasForward> checker(Arch::BAREMETAL);
+    checker.set_dtype(0, dtype::QuantizedS8(2.5f))
+            .set_dtype(1, dtype::QuantizedS8(2.5f))
+            .set_dtype(2, dtype::QuantizedS32(6.25f))
+            .set_dtype(4, dtype::QuantizedS8(40.25f));
+    checker.set_epsilon(1e-4);
+    checker.set_kernel_symbol("GI_im2col_int8.+");
+    ConvBiasForward::Param param;
+    param.compute_mode = ConvBiasForward::Param::ComputeMode::DEFAULT;
+    param.format = ConvBiasForward::Param::Format::NCHW44;
+    for (auto noline :
+         {ConvBiasForward::Param::NonlineMode::IDENTITY,
+          ConvBiasForward::Param::NonlineMode::RELU,
+          ConvBiasForward::Param::NonlineMode::H_SWISH})
+        for (size_t stride : {1, 2, 3})
+            for (size_t dilate : {1, 2})
+                for (size_t kernel : {1, 3, 9}) {
+                    param.pad_h = kernel / 2;
+                    param.pad_w = kernel / 2;
+                    param.stride_h = stride;
+                    param.stride_w = stride;
+                    param.dilate_h = dilate;
+                    param.dilate_w = dilate;
+                    param.nonlineMode = noline;
+                    param.sparse = ConvBiasForward::Param::Sparse::DENSE;
+                    checker.set_param(param);
+                    checker.execs(
+                            {{2, 3, 23, 29, 4},
+                             {5, 3, kernel, kernel, 4, 4},
+                             {1, 5, 1, 1, 4},
+                             {},
+                             {}});
+                    param.sparse = ConvBiasForward::Param::Sparse::GROUP;
+                    checker.set_param(param);
+                    checker.execs(
+                            {{1, 4, 20, 20, 4},
+                             {2, 3, 2, kernel, kernel, 4, 4},
+                             {},
+                             {},
+                             {}});
+                }
+}
+
+TEST(GI, ConvBiasNCHW44Int8PerChannel) {
+    //! the filter dtype scale is ignored by the kernels reading the scales
+    UniformIntRNG qint_rng(-3, 3);
+    std::vector<float> scales;
+    for (size_t oc = 0; oc < 24; ++oc) {
+        scales.push_back(0.25f + 0.125f * oc);
+    }
+    ConvBiasForward::Param param;
+    param.compute_mode = ConvBiasForward::Param::ComputeMode::DEFAULT;
+    param.format = ConvBiasForward::Param::Format::NCHW44;
+    for (std::string symbol :
+         {"GI_direct_int8.+", "GI_conv1x1_int8.+", "GI_im2col_int8.+"}) {
+        Checker<ConvBiasForward> checker(Arch::BAREMETAL);
+        checker.set_dtype(0, dtype::QuantizedS8(0.5f))
+                .set_dtype(1, dtype::QuantizedS8(3.f))
+                .set_dtype(2, dtype::QuantizedS32(1.5f))
+                .set_dtype(4, dtype::QuantizedS8(2.f));
+        checker.set_rng(0, &qint_rng).set_rng(1, &qint_rng).set_rng(2, &qint_rng);
+        checker.set_epsilon(1 + 1e-3);
+        checker.set_kernel_symbol(symbol);
+        size_t kernel = symbol == "GI_conv1x1_int8.+" ? 1 : 3;
+        param.pad_h = kernel / 2;
+        param.pad_w = kernel / 2;
+        for (auto noline :
+             {ConvBiasForward::Param::NonlineMode::IDENTITY,
+              ConvBiasForward::Param::NonlineMode::RELU,
+              ConvBiasForward::Param::NonlineMode::H_SWISH}) {
+            param.nonlineMode = noline;
+            param.sparse = ConvBiasForward::Param::Sparse::DENSE;
+            checker.set_param(param);
+            checker.set_scales(1, {scales.begin(), scales.begin() + 20});
+            checker.set_reference(per_channel_conv_reference(
+                    {scales.begin(), scales.begin() + 20}));
+            checker.execs(
+                    {{2, 3, 9, 11, 4},
+                     {5, 3, kernel, kernel, 4, 4},
+                     {1, 5, 1, 1, 4},
+                     {},
+                     {}});
+            param.sparse = ConvBiasForward::Param::Sparse::GROUP;
+            checker.set_param(param);
+            checker.set_scales(1, scales);
+            checker.set_reference(per_channel_conv_reference(scales));
+            checker.execs(
+                    {{1, 4, 10, 10, 4},
+                     {2, 3, 2, kernel, kernel, 4, 4},
+                     {1, 6, 1, 1, 4},
+                     {},
+                     {}});
+        }
+    }
+    Checker<ConvBiasForward> checker(Arch::BAREMETAL);
+    checker.set_dtype(0, dtype::QuantizedS8(0.5f))
+            .set_dtype(1, dtype::QuantizedS8(3.f))
+            .set_dtype(2, dtype::QuantizedS32(1.5f))
+            .set_dtype(4, dtype::QuantizedS8(2.f));
+    checker.set_rng(0, &qint_rng).set_rng(1, &qint_rng).set_rng(2, &qint_rng);
+    checker.set_epsilon(1 + 1e-3);
+    checker.set_kernel_symbol("GI_chanwise_int8.+");
+    checker.set_scales(1, {scales.begin(), scales.begin() + 8});
+    checker.set_reference(
+            per_channel_conv_reference({scales.begin(), scales.begin() + 8}));
+    param.sparse = ConvBiasForward::Param::Sparse::GROUP;
+    param.pad_h = 1;
+    param.pad_w = 1;
+    for (auto noline :
+         {ConvBiasForward::Param::NonlineMode::IDENTITY,
+          ConvBiasForward::Param::NonlineMode::RELU,
+          ConvBiasForward::Param::NonlineMode::H_SWISH}) {
+        param.nonlineMode = noline;
+        checker.set_param(param);
+        checker.execs(
+                {{2, 2, 13, 23, 4}, {2, 1, 1, 3, 3, 4}, {1, 2, 1, 1, 4}, {}, {}});
+    }
+}
+
+//! the int32 sum of the taps is requantized once, so the rounding is the same
+//! as the reference
+TEST(GI, ConvBackDataNCHW44Int8) {
+    Checker<ConvolutionBackwardData> checker(Arch::BAREMETAL);
+    checker.set_kernel_symbol("GI_kernel_back_data_conv2d_.*");
+    checker.set_dtype(0, dtype::QuantizedS8(0.5f))
+            .set_dtype(1, dtype::QuantizedS8(2.f))
+            .set_dtype(2, dtype::QuantizedS8(4.f));
+    checker.set_epsilon(1 + 1e-3);
+    ConvolutionBackwardData::Param param;
+    param.compute_mode = ConvolutionBackwardData::Param::ComputeMode::DEFAULT;
+    param.format = ConvolutionBackwardData::Param::Format::NCHW44;
+    for (size_t oc : {4, 8})
+        for (size_t ic : {4, 12})
+            for (size_t hw : {5, 11})
+                for (size_t kernel : {1, 2, 3, 5})
+                    for (size_t pad : {(size_t)0, kernel / 2})
+                        for (size_t stride : {1, 2}) {
+                            size_t out = (hw - 1) * stride + kernel - pad * 2;
+                            param.pad_h = pad;
+                            param.pad_w = pad;
+                            param.stride_h = stride;
+                            param.stride_w = stride;
+                            param.sparse = ConvolutionBackwardData::Param::Sparse::DENSE;
+                            checker.set_param(param);
+                            checker.execs(
+                                    {{oc / 4, ic / 4, kernel, kernel, 4, 4},
+                                     {2, oc / 4, hw, hw, 4},
+                                     {2, ic / 4, out, out, 4}});
+                            if (oc == 8) {
+                                param.sparse =
+                                        ConvolutionBackwardData::Param::Sparse::GROUP;
+                                checker.set_param(param);
+                                checker.execs(
+                                        {{2, 1, 1, kernel, kernel, 4, 4},
+                                         {2, 2, hw, hw, 4},
+                                         {2, 2, out, out, 4}});
+                            }
+                        }
+}
+
+// vim: syntax=cpp.doxygen
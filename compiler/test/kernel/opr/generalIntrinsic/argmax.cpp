@@ -0,0 +1,37 @@
+#include "test/kernel/common/checker.h"
+using namespace megdnn;
+using namespace megcc::test;
+using namespace megcc::KernelGen;
+
+namespace {
+template <typename Opr>
+void run_argmxx(Checker<Opr>& checker) {
+    UniformIntRNG int_rng(-128, 127);
+    checker.set_rng(0, &int_rng);
+    for (DType dtype : {(DType)dtype::Float32(), (DType)dtype::Int8()}) {
+        checker.set_dtype(0, dtype);
+        //! the innermost axis, the channel axis and the NCHW44 channel block
+        for (auto src :
+             {TensorShape{3, 37}, TensorShape{2, 67}, TensorShape{2, 19, 8, 7},
+              TensorShape{1, 8, 5, 5, 4}, TensorShape{2, 3, 16, 1, 4}})
+            for (size_t axis = 0; axis < src.ndim; ++axis) {
+                typename Opr::Param param;
+                param.axis = axis;
+                checker.set_param(param);
+                checker.execs({src, {}});
+            }
+    }
+}
+}  // namespace
+
+TEST(GI, Argmax) {
+    Checker<Argmax> checker(Arch::BAREMETAL);
+    checker.set_kernel_symbol("GI_kernel_Argmax.*");
+    run_argmxx(checker);
+}
+
+TEST(GI, Argmin) {
+    Checker<Argmin> checker(Arch::BAREMETAL);
+    checker.set_kernel_symbol("GI_kernel_Argmin.*");
+    run_argmxx(checker);
+}
@@ -101,4 +101,43 @@ TEST(GI, CVBenchmarkCvtColor) {
     benchmarker.set_param(param);
     benchmarker.execs({{1, 1080, 1920, 3}, {}}).print();
 }
+
+TEST(GI, CVBenchmarkGaussianBlur) {
+    Benchmarker<CVGaussianBlur> benchmarker(Arch::BAREMETAL);
+    benchmarker.set_kernel_symbol("GI_tinycv_gaussian_blur.+");
+    megdnn::CVGaussianBlur::Param param;
+    param.border_mode = megdnn::CVGaussianBlur::Param::BorderMode::REFLECT_101;
+    param.sigma_x = 0.8;
+    param.sigma_y = 0.8;
+    benchmarker.set_dtype(0, dtype::Uint8());
+    benchmarker.set_dtype(1, dtype::Uint8());
+    for (int ksize : {3, 5, 7}) {
+        param.kernel_height = ksize;
+        param.kernel_width = ksize;
+        benchmarker.set_param(param);
+        printf("ksize: %d\n", ksize);
+        benchmarker.execs({{1, 1080, 1920, 3}, {}}).print();
+        benchmarker.execs({{1, 1080, 1920, 1}, {}}).print();
+    }
+}
+
+TEST(GI, CVBenchmarkSepFilter) {
+    Benchmarker<CVSepFilter> benchmarker(Arch::BAREMETAL);
+    benchmarker.set_kernel_symbol("GI_tinycv_sep_filter.+");
+    megdnn::CVSepFilter::Param param;
+    param.borderMode = megdnn::CVSepFilter::Param::BorderMode::REFLECT_101;
+    param.is_symm_kernel = false;
+    benchmarker.set_dtype(0, dtype::Uint8());
+    benchmarker.set_dtype(1, dtype::Float32());
+    benchmarker.set_dtype(2, dtype::Float32());
+    benchmarker.set_dtype(3, dtype::Uint8());
+    for (size_t ksize : {3, 5, 7}) {
+        param.ksize_h = ksize;
+        param.ksize_w = ksize;
+        benchmarker.set_param(param);
+        printf("ksize: %zu\n", ksize);
+        benchmarker.execs({{1, 1080, 1920, 3}, {1, 1, 1, ksize}, {1, 1, 1, ksize}, {}})
+                .print();
+    }
+}
 #endif
\ No newline at end of file
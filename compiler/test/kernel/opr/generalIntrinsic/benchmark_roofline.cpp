@@ -0,0 +1,102 @@
+#include "megbrain/reflection.h"
+#include "test/kernel/common/benchmark.h"
+#include "test/kernel/common/roofline.h"
+using namespace megdnn;
+using namespace megcc::test;
+using namespace megcc::KernelGen;
+#ifdef ENABLE_KERNEL_BENCHMARK
+//! sweep the shape grids of the main kernels and report the efficiency
+//! against the roofline of the machine, set MEGCC_BENCHMARK_OUTPUT=<prefix> to
+//! write <prefix>.csv and <prefix>.json for tracking
+
+TEST(GI, BenchmarkRooflineConv) {
+    using Param = ConvBiasForward::Param;
+    Benchmarker<ConvBiasForward> benchmarker(Arch::BAREMETAL);
+    benchmarker.set_kernel_symbol("GI_kernel_conv2d.+");
+    auto& recorder = RooflineRecorder::inst();
+    for (size_t filter_size : {1, 3, 5})
+        for (int stride : {1, 2})
+            for (size_t channel : {16, 64, 128})
+                for (size_t hw : {14, 28, 56}) {
+                    if (filter_size == 1 && stride == 2) {
+                        continue;
+                    }
+                    Param param;
+                    param.pad_h = param.pad_w = filter_size / 2;
+                    param.stride_h = param.stride_w = stride;
+                    param.format = Param::Format::NCHW44;
+                    param.nonlineMode = Param::NonlineMode::RELU;
+                    benchmarker.set_param(param);
+                    auto result = benchmarker.execs(
+                            {{1, channel / 4, hw, hw, 4},
+                             {channel / 4, channel / 4, filter_size, filter_size, 4,
+                              4},
+                             {1, channel / 4, 1, 1, 4},
+                             {},
+                             {}});
+                    result.print();
+                    recorder.record(
+                            "conv" + std::to_string(filter_size) + "x" +
+                                    std::to_string(filter_size) + "s" +
+                                    std::to_string(stride),
+                            "GI_kernel_conv2d.+", result);
+                }
+}
+
+TEST(GI, BenchmarkRooflineMatmul) {
+    Benchmarker<MatrixMulForward> benchmarker(Arch::BAREMETAL);
+    benchmarker.set_kernel_symbol("GI_kernel_fp32_matmul_4x12_.*");
+    auto& recorder = RooflineRecorder::inst();
+    MatrixMulForward::Param param;
+    benchmarker.set_param(param);
+    for (size_t m : {1, 16, 64, 256})
+        for (size_t n : {16, 128, 512})
+            for (size_t k : {16, 128, 512}) {
+                auto result = benchmarker.execs({{m, k}, {k, n}, {}});
+                result.print();
+                recorder.record("matmul", "GI_kernel_fp32_matmul_4x12_.*", result);
+            }
+}
+
+TEST(GI, BenchmarkRooflineElemwise) {
+    using MODE = ElemwiseForward::Param::Mode;
+    Benchmarker<ElemwiseForward> benchmarker(Arch::BAREMETAL);
+    benchmarker.set_kernel_symbol("GI_kernel_elementwise.+");
+    megcc::test::UniformRNG rng(3, 12);
+    benchmarker.set_rng(0, &rng);
+    benchmarker.set_rng(1, &rng);
+    auto& recorder = RooflineRecorder::inst();
+    ElemwiseForward::Param param;
+    for (auto mode : {MODE::RELU, MODE::EXP, MODE::SIGMOID}) {
+        param.mode = mode;
+        benchmarker.set_param(param);
+        auto name = mgb::reflection::nameOfEnumValue<MODE>(mode);
+        for (size_t size : {1024, 64 * 1024, 1024 * 1024}) {
+            auto result = benchmarker.execs({{size}, {}});
+            result.print();
+            recorder.record("elemwise_" + name, "GI_kernel_elementwise.+", result);
+        }
+    }
+    //! binary broadcast types: vec_vec, vec_bcast101, vec_scalar, bcast101_vec
+    for (auto mode : {MODE::ADD, MODE::MUL}) {
+        param.mode = mode;
+        benchmarker.set_param(param);
+        auto name = mgb::reflection::nameOfEnumValue<MODE>(mode);
+        for (size_t hw : {16, 64, 256}) {
+            TensorShape vec{1, 32, hw, hw};
+            TensorShape bcast101{1, 32, 1, 1};
+            TensorShape scalar{1};
+            for (auto& shapes : std::vector<std::pair<TensorShape, TensorShape>>{
+                         {vec, vec},
+                         {vec, bcast101},
+                         {vec, scalar},
+                         {bcast101, vec}}) {
+                auto result = benchmarker.execs({shapes.first, shapes.second, {}});
+                result.print();
+                recorder.record(
+                        "elemwise_" + name, "GI_kernel_elementwise.+", result);
+            }
+        }
+    }
+}
+#endif
@@ -0,0 +1,33 @@
+#include "test/kernel/common/checker.h"
+using namespace megdnn;
+using namespace megcc::test;
+
+TEST(GI, Concat) {
+    Checker<Concat> checker(megcc::KernelGen::Arch::BAREMETAL);
+    checker.set_kernel_symbol("GI_kernel_concat.*");
+    checker.set_dynamic_megcc(true);
+    using Param = Concat::Param;
+    for (auto dtype : std::vector<DType>{
+                 dtype::Float32(), dtype::Int32(), dtype::Int16(), dtype::Int8(),
+                 dtype::Uint8()}) {
+        for (size_t axis = 0; axis < 4; ++axis) {
+            Param param;
+            param.axis = axis;
+            TensorShapeArray shapes(4, TensorShape({12, 13, 14, 15}));
+            for (size_t i = 0; i < 4; ++i) {
+                shapes[i].shape[axis] = i + 1;
+            }
+            shapes.emplace_back();
+            for (size_t i = 0; i < shapes.size(); ++i)
+                checker.set_dtype(i, dtype);
+            checker.set_param(param).exec(shapes);
+        }
+    }
+    //! nchw44 channel concat
+    checker.set_dtype(0, dtype::Float32())
+            .set_dtype(1, dtype::Float32())
+            .set_dtype(2, dtype::Float32());
+    checker.set_param(Param{1});
+    checker.execs({{2, 3, 9, 11, 4}, {2, 5, 9, 11, 4}, {}});
+    checker.execs({{1, 1, 1, 1, 4}, {1, 2, 1, 1, 4}, {}});
+}
@@ -418,4 +418,33 @@ TEST(GI, ConvBackDataNCHW) {
                             }
 }
 
+//! the asymmetric strides and kernels of the sub pixel col2im, the wide
+//! output runs over more than one column chunk
+TEST(GI, ConvBackDataNCHWSubPixel) {
+    Checker<ConvolutionBackwardData> checker(Arch::BAREMETAL);
+    checker.set_kernel_symbol("GI_kernel_back_data_conv2d_.*");
+    ConvolutionBackwardData::Param param;
+    param.compute_mode = ConvolutionBackwardData::Param::ComputeMode::DEFAULT;
+    param.format = ConvolutionBackwardData::Param::Format::NCHW;
+    param.sparse = ConvolutionBackwardData::Param::Sparse::DENSE;
+    checker.set_epsilon(1e-4);
+    auto run = [&](size_t oc, size_t ic, size_t ih, size_t iw, size_t fh, size_t fw,
+                   size_t sh, size_t sw, size_t ph, size_t pw) {
+        param.stride_h = sh;
+        param.stride_w = sw;
+        param.pad_h = ph;
+        param.pad_w = pw;
+        checker.set_param(param);
+        checker.execs(
+                {{oc, ic, fh, fw},
+                 {1, oc, ih, iw},
+                 {1, ic, (ih - 1) * sh + fh - 2 * ph, (iw - 1) * sw + fw - 2 * pw}});
+    };
+    run(3, 2, 5, 9, 3, 5, 3, 2, 1, 2);
+    run(2, 3, 6, 7, 4, 2, 2, 3, 1, 0);
+    run(2, 2, 4, 40, 4, 4, 4, 4, 1, 1);
+    run(4, 4, 3, 100, 7, 7, 2, 2, 3, 3);
+    run(4, 4, 3, 70, 3, 3, 1, 1, 1, 1);
+}
+
 // vim: syntax=cpp.doxygen
@@ -1,3 +1,6 @@
+#include <algorithm>
+#include <array>
+#include <cmath>
 #include "megbrain/reflection.h"
 #include "test/kernel/common/checker.h"
 #include "test/kernel/common/cv_opr.h"
@@ -5,6 +8,89 @@ using namespace megcc::test;
 using namespace megdnn;
 using namespace megcc::KernelGen;
 
+namespace {
+//! float tinycv_preprocess, the source is resized with the half pixel centers
+//! of tinycv_resize_linear and NV21 is converted as tinycv_cvt_yuv2bgr_nv21
+void preprocess_reference(megdnn::CVPreprocess* opr, const TensorNDArray& tensors) {
+    auto&& param = opr->param();
+    bool nv21 = param.src_format == "NV21";
+    bool nchw44 = param.dst_format == "NCHW44";
+    auto&& src = tensors[0];
+    auto&& dst = tensors[1];
+    int src_rows = nv21 ? src.layout[1] * 2 / 3 : src.layout[1];
+    int src_cols = src.layout[2];
+    int rows = dst.layout[2], cols = dst.layout[3];
+    const uint8_t* sptr = src.ptr<uint8_t>();
+    auto clamp = [](int x) { return std::min(std::max(x, 0), 255); };
+    auto load = [&](int row, int col, int* bgr) {
+        if (!nv21) {
+            const uint8_t* p = sptr + (row * src_cols + col) * 3;
+            std::copy(p, p + 3, bgr);
+            return;
+        }
+        int Y = sptr[row * src_cols + col];
+        const uint8_t* vu = sptr + (src_rows + row / 2) * src_cols + col / 2 * 2;
+        int V = vu[0] - 128, U = vu[1] - 128;
+        bgr[0] = clamp(Y + ((454 * U) >> 8));
+        bgr[1] = clamp(Y - ((88 * U + 183 * V) >> 8));
+        bgr[2] = clamp(Y + ((359 * V) >> 8));
+    };
+    auto coord = [](int src_len, int dst_len, int i, int* s0, int* s1, float* ratio) {
+        float r = (i + 0.5f) * ((float)src_len / dst_len) - 0.5f;
+        int s = (int)std::floor(r);
+        r -= s;
+        if (s < 0) {
+            s = 0;
+            r = 0.f;
+        } else if (s + 1 >= src_len) {
+            s = src_len > 1 ? src_len - 2 : 0;
+            r = src_len > 1 ? 1.f : 0.f;
+        }
+        *s0 = s;
+        *s1 = src_len > 1 ? s + 1 : s;
+        *ratio = r;
+    };
+    int top = param.top, left = param.left;
+    int resize_rows = param.resize_rows, resize_cols = param.resize_cols;
+    for (int y = 0; y < rows; ++y)
+        for (int x = 0; x < cols; ++x) {
+            float out[4] = {0.f, 0.f, 0.f, 0.f};
+            bool pad = y < top || y >= top + resize_rows || x < left ||
+                       x >= left + resize_cols;
+            int y0, y1, x0, x1, p00[3] = {}, p01[3] = {}, p10[3] = {}, p11[3] = {};
+            float ry = 0.f, rx = 0.f;
+            if (!pad) {
+                coord(src_rows, resize_rows, y - top, &y0, &y1, &ry);
+                coord(src_cols, resize_cols, x - left, &x0, &x1, &rx);
+                load(y0, x0, p00);
+                load(y0, x1, p01);
+                load(y1, x0, p10);
+                load(y1, x1, p11);
+            }
+            for (int c = 0; c < 3; ++c) {
+                float value = param.pad_value;
+                if (!pad) {
+                    int k = param.swap_rb ? 2 - c : c;
+                    float h0 = p00[k] + (p01[k] - p00[k]) * rx;
+                    float h1 = p10[k] + (p11[k] - p10[k]) * rx;
+                    value = h0 * (1 - ry) + h1 * ry;
+                }
+                out[c] = (value - param.mean[c]) / param.std[c];
+            }
+            for (int c = 0; c < (nchw44 ? 4 : 3); ++c) {
+                size_t idx = nchw44 ? (y * cols + x) * 4 + c
+                                    : (c * rows + y) * cols + x;
+                if (dst.layout.dtype == dtype::Float32()) {
+                    dst.ptr<float>()[idx] = out[c];
+                } else {
+                    float q = std::round(out[c] / param.dst_scale);
+                    dst.ptr<int8_t>()[idx] = std::min(std::max(q, -128.f), 127.f);
+                }
+            }
+        }
+}
+}  // namespace
+
 TEST(GI, CVflip) {
     Checker<megdnn::CVflip> checker(Arch::BAREMETAL);
     checker.set_kernel_symbol("GI_tinycv_flip.+");
@@ -153,3 +239,145 @@ TEST(GI, CVcvtcolor) {
         checker.exec({{1, 18, 18, 1}, {}});
     }
 }
+
+TEST(GI, CVGaussianBlur) {
+    Checker<megdnn::CVGaussianBlur> checker(Arch::BAREMETAL);
+    checker.set_kernel_symbol("GI_tinycv_gaussian_blur.+");
+    megdnn::CVGaussianBlur::Param param;
+    using BorderMode = megdnn::CVGaussianBlur::Param::BorderMode;
+    auto run = [&checker, &param]() {
+        for (auto mode :
+             {BorderMode::CONSTANT, BorderMode::REFLECT, BorderMode::REFLECT_101,
+              BorderMode::REPLICATE}) {
+            for (int kh : {3, 5, 9}) {
+                for (int kw : {3, 7}) {
+                    for (double sigma : {0., 0.8}) {
+                        param.border_mode = mode;
+                        param.kernel_height = kh;
+                        param.kernel_width = kw;
+                        param.sigma_x = sigma;
+                        param.sigma_y = sigma;
+                        checker.set_param(param);
+                        checker.exec({{1, 3, 5, 1}, {}});
+                        checker.exec({{1, 16, 19, 3}, {}});
+                        checker.exec({{1, 33, 35, 1}, {}});
+                        checker.exec({{1, 37, 64, 3}, {}});
+                    }
+                }
+            }
+        }
+    };
+    UniformIntRNG seq(0, 255);
+    checker.set_rng(0, &seq);
+    checker.set_dtype(0, dtype::Uint8());
+    checker.set_dtype(1, dtype::Uint8());
+    run();
+
+    megcc::test::UniformRNG rng(-30, 30);
+    checker.set_rng(0, &rng);
+    checker.set_dtype(0, dtype::Float32());
+    checker.set_dtype(1, dtype::Float32());
+    checker.set_epsilon(1e-4);
+    run();
+}
+
+TEST(GI, CVSepFilter) {
+    Checker<megdnn::CVSepFilter> checker(Arch::BAREMETAL);
+    checker.set_kernel_symbol("GI_tinycv_sep_filter.+");
+    megdnn::CVSepFilter::Param param;
+    using BorderMode = megdnn::CVSepFilter::Param::BorderMode;
+    param.is_symm_kernel = false;
+    auto run = [&checker, &param]() {
+        for (auto mode :
+             {BorderMode::CONSTANT, BorderMode::REFLECT, BorderMode::REFLECT_101,
+              BorderMode::REPLICATE}) {
+            for (size_t kh : {1, 3, 7}) {
+                for (size_t kw : {3, 5, 9}) {
+                    param.borderMode = mode;
+                    param.ksize_h = kh;
+                    param.ksize_w = kw;
+                    checker.set_param(param);
+                    for (size_t c : {1, 3}) {
+                        checker.execs({{1, 3, 5, c}, {1, 1, 1, kw}, {1, 1, 1, kh}, {}});
+                        checker.execs(
+                                {{1, 33, 35, c}, {1, 1, 1, kw}, {1, 1, 1, kh}, {}});
+                    }
+                }
+            }
+        }
+    };
+    UniformIntRNG seq(0, 255);
+    megcc::test::UniformRNG kernel_rng(-0.5, 0.5);
+    checker.set_rng(0, &seq);
+    checker.set_rng(1, &kernel_rng);
+    checker.set_rng(2, &kernel_rng);
+    checker.set_dtype(0, dtype::Uint8());
+    checker.set_dtype(1, dtype::Float32());
+    checker.set_dtype(2, dtype::Float32());
+    checker.set_dtype(3, dtype::Uint8());
+    checker.set_epsilon(1 + 1e-4);
+    run();
+
+    megcc::test::UniformRNG rng(-30, 30);
+    checker.set_rng(0, &rng);
+    checker.set_dtype(0, dtype::Float32());
+    checker.set_dtype(3, dtype::Float32());
+    checker.set_epsilon(1e-4);
+    run();
+}
+
+TEST(GI, CVPreprocess) {
+    //! megdnn has no fused preprocess, the outputs are checked against the
+    //! reference
+    Checker<megdnn::CVPreprocess> checker(Arch::BAREMETAL);
+    checker.set_kernel_symbol("GI_tinycv_preprocess.+");
+    checker.set_reference(preprocess_reference);
+    megdnn::CVPreprocess::Param param;
+    param.pad_value = 114;
+    param.mean[0] = 103.53f;
+    param.mean[1] = 116.28f;
+    param.mean[2] = 123.675f;
+    param.std[0] = 57.375f;
+    param.std[1] = 57.12f;
+    param.std[2] = 58.395f;
+    param.dst_scale = 0.02f;
+    UniformIntRNG rng(0, 255);
+    checker.set_rng(0, &rng);
+    checker.set_dtype(0, dtype::Uint8());
+    //! src rows, src cols, dst rows, dst cols, resize rows, resize cols, top, left
+    std::vector<std::array<size_t, 8>> shapes{
+            {4, 6, 8, 8, 8, 8, 0, 0},     {17, 31, 20, 23, 13, 19, 3, 2},
+            {2, 2, 5, 7, 5, 7, 0, 0},     {6, 2, 9, 9, 7, 1, 1, 4},
+            {1, 1, 3, 3, 2, 2, 1, 1},     {100, 60, 33, 37, 30, 18, 2, 9},
+            {48, 64, 42, 42, 32, 42, 5, 0}};
+    for (std::string src_format : {"BGR", "NV21"})
+        for (std::string dst_format : {"NCHW", "NCHW44"})
+            for (DType dst_dtype : {(DType)dtype::Float32(), (DType)dtype::Int8()})
+                for (bool swap_rb : {false, true})
+                    for (auto&& shape : shapes) {
+                        bool nv21 = src_format == "NV21";
+                        if (nv21 && (shape[0] % 2 || shape[1] % 2)) {
+                            continue;
+                        }
+                        param.src_format = src_format;
+                        param.dst_format = dst_format;
+                        param.swap_rb = swap_rb;
+                        param.resize_rows = shape[4];
+                        param.resize_cols = shape[5];
+                        param.top = shape[6];
+                        param.left = shape[7];
+                        checker.set_param(param);
+                        checker.set_dtype(1, dst_dtype);
+                        checker.set_epsilon(
+                                dst_dtype == dtype::Float32() ? 1e-3 : 1 + 1e-4);
+                        TensorShape src{1, shape[0], shape[1], 3};
+                        if (nv21) {
+                            src = {1, shape[0] * 3 / 2, shape[1], 1};
+                        }
+                        TensorShape dst{1, 3, shape[2], shape[3]};
+                        if (dst_format == "NCHW44") {
+                            dst = {1, 1, shape[2], shape[3], 4};
+                        }
+                        checker.exec({src, dst});
+                    }
+}
@@ -30,6 +30,35 @@ TEST(GI, ElementwiseUnique) {
 #endif
 }
 
+TEST(GI, ElementwiseUniqueFastMath) {
+    Checker<ElemwiseForward> checker(Arch::BAREMETAL);
+    ElemwiseForward::Param param;
+    checker.set_kernel_symbol("GI_kernel_elementwise.+_fastmath_ulp.+");
+    megcc::test::UniformRNG rng(-20.0, 20.0);
+    checker.set_rng(0, &rng);
+    //! the fast-math sigmoid needs the ulp of the exp in use plus 4, so 8 and 84
+    //! select it with the degree 5 and degree 4 exp
+    for (auto mode_ulp :
+         {std::make_pair(MODE::EXP, 4), std::make_pair(MODE::EXP, 80),
+          std::make_pair(MODE::SIGMOID, 8), std::make_pair(MODE::SIGMOID, 84)}) {
+        param.mode = mode_ulp.first;
+        checker.set_param(param);
+        checker.set_fast_math_ulp(mode_ulp.second);
+        checker.execs({{1, 10}, {}});
+        checker.execs({{1, 10, 12, 13}, {}});
+    }
+    //! the fast-math log over several binades, with the degree 8 and 7 polynomial
+    megcc::test::UniformRNG log_rng(1e-3, 1e3);
+    checker.set_rng(0, &log_rng);
+    param.mode = MODE::LOG;
+    checker.set_param(param);
+    for (int ulp : {6, 32}) {
+        checker.set_fast_math_ulp(ulp);
+        checker.execs({{1, 10}, {}});
+        checker.execs({{1, 10, 12, 13}, {}});
+    }
+}
+
 TEST(GI, ElementwiseBinary) {
     //! only support 1x11 broadcast
     Checker<ElemwiseForward> checker(Arch::BAREMETAL);
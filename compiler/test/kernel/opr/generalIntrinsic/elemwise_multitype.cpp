@@ -0,0 +1,83 @@
+#include "test/kernel/common/checker.h"
+using namespace megdnn;
+using namespace megcc::test;
+using namespace megcc::KernelGen;
+using MODE = ElemwiseMultiType::Param::Mode;
+
+TEST(GI, ElementwiseMultitypeUnary) {
+    Checker<ElemwiseMultiType> checker(Arch::BAREMETAL);
+    checker.set_kernel_symbol("GI_kernel_elementwise_multitype.+");
+    checker.set_epsilon(1e-4);
+    checker.set_dtype(0, dtype::QuantizedS8(0.05f));
+    checker.set_dtype(1, dtype::QuantizedS8(0.03f));
+    ElemwiseMultiType::Param param;
+    for (auto mode :
+         {MODE::QRELU, MODE::QABS, MODE::QNEGATE, MODE::QFAST_TANH, MODE::QH_SWISH}) {
+        param.mode = mode;
+        checker.set_param(param);
+        checker.execs({{1}, {}});
+        checker.execs({{1, 10}, {}});
+        checker.execs({{1, 10, 12, 13}, {}});
+    }
+    //! exp and sigmoid are approximated in simd, allow one quantized step
+    checker.set_epsilon(1);
+    for (auto mode : {MODE::QSIGMOID, MODE::QEXP, MODE::QTANH}) {
+        param.mode = mode;
+        checker.set_param(param);
+        checker.execs({{1}, {}});
+        checker.execs({{1, 10}, {}});
+        checker.execs({{1, 10, 12, 13}, {}});
+    }
+}
+
+TEST(GI, ElementwiseMultitypeBinary) {
+    Checker<ElemwiseMultiType> checker(Arch::BAREMETAL);
+    checker.set_kernel_symbol("GI_kernel_elementwise_multitype.+");
+    checker.set_epsilon(1e-4);
+    checker.set_dtype(0, dtype::QuantizedS8(0.05f));
+    checker.set_dtype(1, dtype::QuantizedS8(0.07f));
+    checker.set_dtype(2, dtype::QuantizedS8(0.05f));
+    ElemwiseMultiType::Param param;
+    auto run = [&]() {
+        checker.execs({{1}, {1}, {}});
+        checker.execs({{2, 8, 5, 7}, {2, 8, 5, 7}, {}});
+        checker.execs({{2, 8, 5, 7}, {1, 8, 1, 1}, {}});
+        checker.execs({{2, 8, 5, 7}, {1}, {}});
+        checker.execs({{1, 8, 1, 1}, {2, 8, 5, 7}, {}});
+        checker.execs({{2, 4, 3, 6, 4}, {1, 4, 1, 1, 4}, {}});
+        checker.execs({{2, 3, 4}, {2, 1, 4}, {}});
+    };
+    for (auto mode :
+         {MODE::QADD, MODE::QSUB, MODE::QMUL, MODE::QMIN, MODE::QMAX,
+          MODE::QFUSE_ADD_RELU, MODE::QFUSE_ADD_H_SWISH, MODE::QSIGMOID_GRAD,
+          MODE::QTANH_GRAD}) {
+        param.mode = mode;
+        checker.set_param(param);
+        run();
+    }
+    //! avoid dividing by zero
+    UniformIntRNG nonzero_rng(1, 127);
+    checker.set_rng(1, &nonzero_rng);
+    checker.set_epsilon(1);
+    for (auto mode : {MODE::QTRUE_DIV, MODE::QFUSE_ADD_SIGMOID, MODE::QFUSE_ADD_TANH}) {
+        param.mode = mode;
+        checker.set_param(param);
+        run();
+    }
+}
+
+TEST(GI, ElementwiseMultitypeTernary) {
+    Checker<ElemwiseMultiType> checker(Arch::BAREMETAL);
+    checker.set_kernel_symbol("GI_kernel_elementwise_multitype.+");
+    checker.set_epsilon(1e-4);
+    checker.set_dtype(0, dtype::QuantizedS8(0.05f));
+    checker.set_dtype(1, dtype::QuantizedS8(0.07f));
+    checker.set_dtype(2, dtype::QuantizedS8(0.03f));
+    checker.set_dtype(3, dtype::QuantizedS8(0.05f));
+    ElemwiseMultiType::Param param;
+    param.mode = MODE::QFUSE_MUL_ADD3;
+    checker.set_param(param);
+    checker.execs({{2, 8, 5, 7}, {2, 8, 5, 7}, {2, 8, 5, 7}, {}});
+    checker.execs({{2, 8, 5, 7}, {1, 8, 1, 1}, {1, 8, 1, 1}, {}});
+    checker.execs({{2, 4, 3, 6, 4}, {1, 4, 1, 1, 4}, {1}, {}});
+}
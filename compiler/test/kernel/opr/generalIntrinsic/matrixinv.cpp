@@ -0,0 +1,25 @@
+#include "test/kernel/common/checker.h"
+#include "test/kernel/common/rng.h"
+using namespace megdnn;
+using namespace megcc::test;
+using namespace megcc::KernelGen;
+
+TEST(GI, MatInv) {
+    Checker<MatrixInverse> checker(Arch::BAREMETAL);
+    checker.set_kernel_symbol("GI_kernel_matrix_inv.*");
+    InvertibleMatrixRNG rng;
+    checker.set_rng(0, &rng);
+    checker.set_epsilon(3e-3);
+    //! the closed form small sizes with batch tails
+    for (size_t n : {1, 2, 3, 4})
+        for (size_t batch : {1, 4, 7, 13}) {
+            checker.exec({{batch, n, n}, {}});
+        }
+    checker.exec({{3, 3, 4, 4}, {}});
+    //! the blocked LU with a partial last panel
+    checker.exec({{5, 5}, {}});
+    checker.exec({{3, 7, 7}, {}});
+    checker.exec({{2, 8, 8}, {}});
+    checker.exec({{2, 19, 19}, {}});
+    checker.exec({{1, 33, 33}, {}});
+}
@@ -0,0 +1,12 @@
+#include "test/kernel/common/checker.h"
+#include "test/kernel/common/nms_keep_reference.h"
+using namespace megdnn;
+using namespace megcc::test;
+using namespace megcc::KernelGen;
+
+TEST(GI, NMSKeep) {
+    //! megdnn has no NMSKeep, the outputs are checked against the reference
+    Checker<NMSKeep> checker(Arch::BAREMETAL);
+    checker.set_kernel_symbol("GI_kernel_nms_keep_.*");
+    check_nms_keep(checker);
+}
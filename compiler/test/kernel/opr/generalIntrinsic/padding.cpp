@@ -0,0 +1,58 @@
+#include "test/kernel/common/checker.h"
+using namespace megdnn;
+using namespace megcc::test;
+using namespace megcc::KernelGen;
+
+TEST(GI, Padding) {
+    Checker<megdnn::Padding> checker(Arch::BAREMETAL);
+    checker.set_kernel_symbol("GI_kernel_padding.*");
+    megdnn::Padding::Param param;
+    using PaddingMode = megdnn::Padding::Param::PaddingMode;
+    auto run = [&checker, &param](float padding_val) {
+        for (auto mode :
+             {PaddingMode::CONSTANT, PaddingMode::REFLECT, PaddingMode::REPLICATE}) {
+            param = {};
+            param.padding_mode = mode;
+            param.padding_val = padding_val;
+            for (int offset0 : {0, 3}) {
+                for (int offset1 : {1, 5}) {
+                    param.front_offset_dim2 = offset0;
+                    param.back_offset_dim2 = offset1;
+                    param.front_offset_dim3 = offset1;
+                    param.back_offset_dim3 = offset0;
+                    checker.set_param(param);
+                    checker.exec({{1, 1, 30, 30}, {}});
+                    checker.exec({{3, 3, 17, 19}, {}});
+                    //! nchw44, the pack dim is merged into the copy block
+                    checker.exec({{2, 3, 9, 11, 4}, {}});
+                }
+            }
+            param.front_offset_dim2 = param.back_offset_dim2 = 0;
+            param.front_offset_dim3 = param.back_offset_dim3 = 0;
+            param.front_offset_dim1 = 1;
+            param.back_offset_dim1 = 2;
+            checker.set_param(param);
+            checker.exec({{2, 4, 5, 6}, {}});
+            param.front_offset_dim0 = 1;
+            checker.set_param(param);
+            checker.exec({{2, 4, 5, 6}, {}});
+        }
+    };
+    UniformIntRNG seq(0, 255);
+    checker.set_rng(0, &seq);
+    checker.set_dtype(0, dtype::Uint8());
+    checker.set_dtype(1, dtype::Uint8());
+    run(2.f);
+
+    UniformIntRNG int8_rng(-128, 127);
+    checker.set_rng(0, &int8_rng);
+    checker.set_dtype(0, dtype::Int8());
+    checker.set_dtype(1, dtype::Int8());
+    run(-2.f);
+
+    megcc::test::UniformRNG rng(-30, 30);
+    checker.set_rng(0, &rng);
+    checker.set_dtype(0, dtype::Float32());
+    checker.set_dtype(1, dtype::Float32());
+    run(-1.5f);
+}
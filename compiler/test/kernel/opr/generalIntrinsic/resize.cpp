@@ -16,4 +16,36 @@ TEST(GI, Resize) {
     checker.execs({{1, 1, 5, 6}, {1, 1, 7, 13}});
     checker.execs({{1, 4, 5, 6}, {1, 4, 9, 12}});
     checker.execs({{2, 3, 15, 16}, {2, 3, 9, 12}});
-}
\ No newline at end of file
+}
+
+TEST(GI, ResizeNearest) {
+    Checker<ResizeForward> checker(Arch::BAREMETAL);
+    checker.set_kernel_symbol("GI_kernel_resize_.*");
+    using Param = megdnn::ResizeForward::Param;
+    Param param;
+    param.imode = Param::InterpolationMode::NEAREST;
+    megcc::test::UniformRNG rng(-30, 30);
+    checker.set_rng(0, &rng);
+    param.format = Param::Format::NCHW;
+    checker.set_param(param);
+    checker.execs({{1, 3, 5, 22}, {1, 3, 10, 44}});
+    checker.execs({{1, 3, 5, 22}, {1, 3, 15, 66}});
+    checker.execs({{2, 3, 15, 16}, {2, 3, 9, 12}});
+    param.format = Param::Format::NHWC;
+    checker.set_param(param);
+    checker.execs({{1, 5, 22, 3}, {1, 10, 44, 3}});
+    checker.execs({{1, 15, 16, 2}, {1, 9, 12, 2}});
+    param.format = Param::Format::NCHW44;
+    checker.set_param(param);
+    checker.execs({{1, 2, 5, 22, 4}, {1, 2, 10, 44, 4}});
+    checker.execs({{1, 2, 15, 16, 4}, {1, 2, 9, 12, 4}});
+
+    megcc::test::UniformIntRNG int_rng(-128, 127);
+    checker.set_rng(0, &int_rng);
+    checker.set_dtype(0, dtype::Int8()).set_dtype(1, dtype::Int8());
+    param.format = Param::Format::NCHW;
+    checker.set_param(param);
+    checker.execs({{1, 3, 5, 37}, {1, 3, 10, 74}});
+    checker.execs({{1, 3, 5, 37}, {1, 3, 10, 111}});
+    checker.execs({{2, 3, 15, 16}, {2, 3, 9, 12}});
+}
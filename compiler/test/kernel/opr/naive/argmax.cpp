@@ -6,7 +6,9 @@ using namespace megcc::KernelGen;
 TEST(NAIVE, Argmax) {
     Checker<Argmax> checker(Arch::BAREMETAL);
     checker.set_kernel_symbol("kernel_.*");
-    for (DType dtype : {(DType)dtype::Float32()}) {
+    UniformIntRNG int_rng(-128, 127);
+    checker.set_rng(0, &int_rng);
+    for (DType dtype : {(DType)dtype::Float32(), (DType)dtype::Int8()}) {
         checker.set_dtype(0, dtype);
         for (auto src :
              {TensorShape{2, 3}, TensorShape{3, 4, 5}, TensorShape{4, 5, 6, 7}})
@@ -20,3 +22,23 @@ TEST(NAIVE, Argmax) {
             }
     }
 }
+
+TEST(NAIVE, Argmin) {
+    Checker<Argmin> checker(Arch::BAREMETAL);
+    checker.set_kernel_symbol("kernel_.*");
+    UniformIntRNG int_rng(-128, 127);
+    checker.set_rng(0, &int_rng);
+    for (DType dtype : {(DType)dtype::Float32(), (DType)dtype::Int8()}) {
+        checker.set_dtype(0, dtype);
+        for (auto src :
+             {TensorShape{2, 3}, TensorShape{3, 4, 5}, TensorShape{4, 5, 6, 7}})
+            for (size_t axis = 0; axis < 4; ++axis) {
+                if (axis < src.ndim) {
+                    ArgminForward::Param param;
+                    param.axis = axis;
+                    checker.set_param(param);
+                    checker.execs({src, {}});
+                }
+            }
+    }
+}
@@ -1,4 +1,5 @@
 #include "test/kernel/common/checker.h"
+#include "test/kernel/common/quant_conv_reference.h"
 using namespace megdnn;
 using namespace megcc::test;
 using namespace megcc::KernelGen;
@@ -104,6 +105,40 @@ TEST(NAIVE, ConvBiasNCHWQS8) {
                                 }
 }
 
+TEST(NAIVE, ConvBiasNCHWQS8PerChannel) {
+    Checker<ConvBiasForward> checker(Arch::BAREMETAL);
+    checker.set_kernel_symbol("kernel_.*");
+    UniformIntRNG qint_rng(-3, 3);
+    checker.set_rng(0, &qint_rng);
+    checker.set_rng(1, &qint_rng);
+    checker.set_rng(2, &qint_rng);
+    checker.set_epsilon(1 + 1e-3);
+    //! the filter dtype scale is ignored by the kernel reading the scales
+    checker.set_dtype(0, dtype::QuantizedS8(0.5f));
+    checker.set_dtype(1, dtype::QuantizedS8(3.0f));
+    checker.set_dtype(2, dtype::QuantizedS32(1.5f));
+    checker.set_dtype(4, dtype::QuantizedS8(2.0f));
+    std::vector<float> scales{0.25f, 1.5f, 0.75f, 2.0f};
+    checker.set_scales(1, scales);
+    checker.set_reference(per_channel_conv_reference(scales));
+    ConvBiasForward::Param param;
+    param.compute_mode = ConvBiasForward::Param::ComputeMode::DEFAULT;
+    param.format = ConvBiasForward::Param::Format::NCHW;
+    param.pad_h = 1;
+    param.pad_w = 1;
+    for (auto noline :
+         {ConvBiasForward::Param::NonlineMode::IDENTITY,
+          ConvBiasForward::Param::NonlineMode::RELU}) {
+        param.nonlineMode = noline;
+        param.sparse = ConvBiasForward::Param::Sparse::DENSE;
+        checker.set_param(param);
+        checker.execs({{2, 3, 7, 9}, {4, 3, 3, 3}, {1, 4, 1, 1}, {}, {}});
+        param.sparse = ConvBiasForward::Param::Sparse::GROUP;
+        checker.set_param(param);
+        checker.execs({{2, 4, 7, 9}, {2, 2, 2, 3, 3}, {1, 4, 1, 1}, {}, {}});
+    }
+}
+
 TEST(NAIVE, ConvBiasNCHWQS8Overflow) {
     Checker<ConvBiasForward> checker(Arch::BAREMETAL);
     checker.set_kernel_symbol("kernel_.*");
@@ -134,6 +134,7 @@ TEST(NAIVE, CVWarpAffine) {
 
 TEST(NAIVE, CVGaussianBlur) {
     Checker<megdnn::CVGaussianBlur> checker;
+    checker.set_kernel_symbol("naive_tinycv_gaussian_blur.+");
     megdnn::CVGaussianBlur::Param param;
     using BorderMode = megdnn::CVGaussianBlur::Param::BorderMode;
     auto run = [&checker, &param]() {
@@ -178,3 +179,48 @@ TEST(NAIVE, CVGaussianBlur) {
     checker.set_epsilon(1e-4);
     run();
 }
+
+TEST(NAIVE, CVSepFilter) {
+    Checker<megdnn::CVSepFilter> checker;
+    checker.set_kernel_symbol("naive_tinycv_sep_filter.+");
+    megdnn::CVSepFilter::Param param;
+    using BorderMode = megdnn::CVSepFilter::Param::BorderMode;
+    param.is_symm_kernel = false;
+    auto run = [&checker, &param]() {
+        for (auto mode :
+             {BorderMode::CONSTANT, BorderMode::REFLECT, BorderMode::REFLECT_101,
+              BorderMode::REPLICATE}) {
+            for (size_t kh : {1, 3, 5, 7}) {
+                for (size_t kw : {1, 3, 5, 9}) {
+                    param.borderMode = mode;
+                    param.ksize_h = kh;
+                    param.ksize_w = kw;
+                    checker.set_param(param);
+                    for (size_t c : {1, 3}) {
+                        checker.execs({{1, 3, 5, c}, {1, 1, 1, kw}, {1, 1, 1, kh}, {}});
+                        checker.execs(
+                                {{1, 16, 19, c}, {1, 1, 1, kw}, {1, 1, 1, kh}, {}});
+                    }
+                }
+            }
+        }
+    };
+    UniformIntRNG seq(0, 255);
+    megcc::test::UniformRNG kernel_rng(-0.5, 0.5);
+    checker.set_rng(0, &seq);
+    checker.set_rng(1, &kernel_rng);
+    checker.set_rng(2, &kernel_rng);
+    checker.set_dtype(0, dtype::Uint8());
+    checker.set_dtype(1, dtype::Float32());
+    checker.set_dtype(2, dtype::Float32());
+    checker.set_dtype(3, dtype::Uint8());
+    checker.set_epsilon(1 + 1e-4);
+    run();
+
+    megcc::test::UniformRNG rng(-30, 30);
+    checker.set_rng(0, &rng);
+    checker.set_dtype(0, dtype::Float32());
+    checker.set_dtype(3, dtype::Float32());
+    checker.set_epsilon(1e-4);
+    run();
+}
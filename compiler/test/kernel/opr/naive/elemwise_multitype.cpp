@@ -35,4 +35,67 @@ TEST(NAIVE, ElementwiseMultitypeBinary) {
         checker.execs({{1, 10}, {1, 10}, {}});
         checker.execs({{2, 3, 4, 5}, {2, 3, 4, 5}, {}});
     }
-}
\ No newline at end of file
+}
+
+TEST(NAIVE, ElementwiseMultitypeUnaryScalar) {
+    Checker<ElemwiseMultiType> checker;
+    checker.set_kernel_symbol("kernel_.*");
+    checker.set_epsilon(1e-4);
+    checker.set_dtype(0, dtype::QuantizedS8(0.05f));
+    checker.set_dtype(1, dtype::QuantizedS8(0.03f));
+    ElemwiseMultiType::Param param;
+    for (auto mode :
+         {MODE::QABS, MODE::QNEGATE, MODE::QSIGMOID, MODE::QEXP, MODE::QTANH,
+          MODE::QFAST_TANH, MODE::QH_SWISH, MODE::QCEIL, MODE::QCOS, MODE::QEXPM1,
+          MODE::QFLOOR, MODE::QLOG1P, MODE::QSIN, MODE::QROUND, MODE::QERF,
+          MODE::QERFC}) {
+        param.mode = mode;
+        checker.set_param(param);
+        checker.execs({{1}, {}});
+        checker.execs({{1, 10, 12, 13}, {}});
+    }
+}
+
+TEST(NAIVE, ElementwiseMultitypeBinaryBroadcast) {
+    Checker<ElemwiseMultiType> checker;
+    checker.set_kernel_symbol("kernel_.*");
+    checker.set_epsilon(1e-4);
+    checker.set_dtype(0, dtype::QuantizedS8(0.05f));
+    checker.set_dtype(1, dtype::QuantizedS8(0.07f));
+    checker.set_dtype(2, dtype::QuantizedS8(0.05f));
+    UniformIntRNG nonzero_rng(1, 127);
+    checker.set_rng(1, &nonzero_rng);
+    ElemwiseMultiType::Param param;
+    for (auto mode :
+         {MODE::QADD, MODE::QSUB, MODE::QMUL, MODE::QMIN, MODE::QMAX,
+          MODE::QTRUE_DIV, MODE::QFUSE_ADD_RELU, MODE::QFUSE_ADD_SIGMOID,
+          MODE::QFUSE_ADD_TANH, MODE::QFUSE_ADD_H_SWISH, MODE::QABS_GRAD,
+          MODE::QFLOOR_DIV, MODE::QMOD, MODE::QSIGMOID_GRAD, MODE::QSWITCH_GT0,
+          MODE::QTANH_GRAD, MODE::QLT, MODE::QLEQ, MODE::QEQ, MODE::QLOG_SUM_EXP,
+          MODE::QATAN2, MODE::QH_SWISH_GRAD}) {
+        param.mode = mode;
+        checker.set_param(param);
+        checker.execs({{2, 8, 5, 7}, {2, 8, 5, 7}, {}});
+        checker.execs({{2, 8, 5, 7}, {1, 8, 1, 1}, {}});
+        checker.execs({{2, 8, 5, 7}, {1}, {}});
+        checker.execs({{1, 8, 1, 1}, {2, 8, 5, 7}, {}});
+        checker.execs({{2, 4, 3, 6, 4}, {1, 4, 1, 1, 4}, {}});
+    }
+}
+
+TEST(NAIVE, ElementwiseMultitypeTernary) {
+    Checker<ElemwiseMultiType> checker;
+    checker.set_kernel_symbol("kernel_.*");
+    checker.set_epsilon(1e-4);
+    checker.set_dtype(0, dtype::QuantizedS8(0.05f));
+    checker.set_dtype(1, dtype::QuantizedS8(0.07f));
+    checker.set_dtype(2, dtype::QuantizedS8(0.03f));
+    checker.set_dtype(3, dtype::QuantizedS8(0.05f));
+    ElemwiseMultiType::Param param;
+    for (auto mode : {MODE::QFUSE_MUL_ADD3, MODE::QCOND_LEQ_MOV}) {
+        param.mode = mode;
+        checker.set_param(param);
+        checker.execs({{2, 8, 5, 7}, {2, 8, 5, 7}, {2, 8, 5, 7}, {}});
+        checker.execs({{2, 8, 5, 7}, {1, 8, 1, 1}, {1}, {}});
+    }
+}
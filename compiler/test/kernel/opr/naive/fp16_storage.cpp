@@ -0,0 +1,152 @@
+#include <random>
+#include "compiler/Target/MGB/fp16_storage.h"
+#include "gtest/gtest.h"
+#include "megbrain/opr/io.h"
+#if ENABLE_KERNEL_FP16
+using namespace mgb;
+using namespace mlir::MGB;
+
+namespace {
+struct Fp16StorageGraph {
+    std::shared_ptr<ComputingGraph> graph;
+    std::shared_ptr<HostTensorND> host_x;
+    SymbolVarArray dest_vars;
+    std::vector<cg::OperatorNodeBase*> convs;
+    Fp16CalibTensorMap tensor_map;
+};
+
+std::shared_ptr<HostTensorND> make_host(
+        const TensorShape& shape, std::mt19937& rng) {
+    auto host = std::make_shared<HostTensorND>(
+            CompNode::load("cpu0"), shape, dtype::Float32());
+    std::uniform_real_distribution<float> dist(-1.f, 1.f);
+    auto ptr = host->ptr<float>();
+    for (size_t i = 0; i < shape.total_nr_elems(); ++i) {
+        ptr[i] = dist(rng);
+    }
+    return host;
+}
+
+//! conv -> relu -> conv -> channel wise conv -> conv
+Fp16StorageGraph make_graph() {
+    std::mt19937 rng(0x3c00);
+    Fp16StorageGraph ret;
+    ret.graph = ComputingGraph::make();
+    ret.graph->options().graph_opt_level = 0;
+    ret.host_x = make_host({1, 8, 8, 8}, rng);
+    ret.tensor_map["x"] = ret.host_x;
+    auto x = opr::Host2DeviceCopy::make(
+            *ret.graph, ret.host_x, OperatorNodeConfig{"x"});
+    auto w = [&](const TensorShape& shape) {
+        return opr::ImmutableTensor::make(*ret.graph, *make_host(shape, rng));
+    };
+    opr::Convolution::Param param;
+    param.pad_h = param.pad_w = 1;
+    auto conv0 = opr::Convolution::make(x, w({8, 8, 3, 3}), param);
+    auto relu = opr::Elemwise::make({conv0}, opr::Elemwise::Mode::RELU);
+    auto conv1 = opr::Convolution::make(relu, w({8, 8, 3, 3}), param);
+    param.sparse = opr::Convolution::Param::Sparse::GROUP;
+    auto conv2 = opr::Convolution::make(conv1, w({8, 1, 1, 3, 3}), param);
+    param.sparse = opr::Convolution::Param::Sparse::DENSE;
+    param.pad_h = param.pad_w = 0;
+    auto conv3 = opr::Convolution::make(conv2, w({4, 8, 1, 1}), param);
+    ret.dest_vars = {conv3};
+    for (auto&& conv : {conv0, conv1, conv2, conv3}) {
+        ret.convs.push_back(conv.node()->owner_opr());
+    }
+    return ret;
+}
+
+std::vector<cg::OperatorNodeBase*> get_oprs(const SymbolVarArray& vars) {
+    std::vector<cg::OperatorNodeBase*> ret;
+    cg::DepOprIter dep([&](cg::OperatorNodeBase* opr) { ret.push_back(opr); });
+    for (auto&& i : vars)
+        dep.add(i);
+    return ret;
+}
+
+size_t get_nr_fp16_oprs(const SymbolVarArray& vars) {
+    size_t ret = 0;
+    for (auto opr : get_oprs(vars)) {
+        ret += !opr->same_type<opr::TypeCvt>() &&
+               opr->output(0)->dtype() == dtype::Float16();
+    }
+    return ret;
+}
+
+std::vector<char> to_raw(const HostTensorND& tensor) {
+    auto ptr = tensor.raw_ptr();
+    return std::vector<char>(ptr, ptr + tensor.layout().span().dist_byte());
+}
+}  // namespace
+
+TEST(NAIVE, Fp16StorageCandidates) {
+    auto g = make_graph();
+    auto candidates = get_fp16_storage_candidates(g.dest_vars);
+    auto has = [&](cg::OperatorNodeBase* opr) {
+        return std::find(candidates.begin(), candidates.end(), opr) !=
+               candidates.end();
+    };
+    ASSERT_EQ(candidates.size(), 3u);
+    EXPECT_FALSE(has(g.convs[0]));
+    EXPECT_TRUE(has(g.convs[1]));
+    EXPECT_TRUE(has(g.convs[2]));
+    EXPECT_FALSE(has(g.convs[3]));
+}
+
+TEST(NAIVE, Fp16StorageConvert) {
+    auto g = make_graph();
+    auto candidates = get_fp16_storage_candidates(g.dest_vars);
+    auto vars = convert_to_fp16_storage(
+            g.dest_vars, ThinHashSet<cg::OperatorNodeBase*>(
+                                 candidates.begin(), candidates.end()));
+    ASSERT_EQ(vars.size(), 1u);
+    EXPECT_EQ(vars[0].dtype(), dtype::Float32());
+    EXPECT_EQ(get_nr_fp16_oprs(vars), 3u);
+    using ComputeMode = opr::Convolution::Param::ComputeMode;
+    using Sparse = opr::Convolution::Param::Sparse;
+    size_t nr_fp16_conv = 0;
+    for (auto opr : get_oprs(vars)) {
+        auto conv = opr->try_cast_final<opr::Convolution>();
+        if (!conv) {
+            continue;
+        }
+        if (conv->output(0)->dtype() != dtype::Float16()) {
+            EXPECT_EQ(conv->param().compute_mode, ComputeMode::DEFAULT);
+            continue;
+        }
+        ++nr_fp16_conv;
+        //! the dense conv accumulates in fp32, the channel wise one in fp16
+        EXPECT_EQ(
+                conv->param().compute_mode, conv->param().sparse == Sparse::GROUP
+                                                    ? ComputeMode::DEFAULT
+                                                    : ComputeMode::FLOAT32);
+    }
+    EXPECT_EQ(nr_fp16_conv, 2u);
+}
+
+TEST(NAIVE, Fp16StorageCalib) {
+    auto g = make_graph();
+    std::mt19937 rng(0x1234);
+    Fp16CalibData calib_data;
+    for (int i = 0; i < 2; ++i) {
+        calib_data.push_back({{"x", to_raw(*make_host({1, 8, 8, 8}, rng))}});
+    }
+    auto ref = run_fp16_calib(g.dest_vars, calib_data, g.tensor_map);
+    ASSERT_EQ(ref.size(), 2u);
+    //! every set keeps its own outputs
+    EXPECT_GT(get_fp16_calib_error(ref, {ref[1], ref[0]}), 0.1f);
+    auto set0 = run_fp16_calib(g.dest_vars, {calib_data[0]}, g.tensor_map);
+    EXPECT_EQ(get_fp16_calib_error({ref[0]}, set0), 0.f);
+
+    auto vars = fp16_storage(g.dest_vars, calib_data, 0.f, g.tensor_map);
+    EXPECT_EQ(get_nr_fp16_oprs(vars), 0u);
+    vars = fp16_storage(g.dest_vars, calib_data, 1e-2f, g.tensor_map);
+    EXPECT_EQ(get_nr_fp16_oprs(vars), 3u);
+    EXPECT_LT(
+            get_fp16_calib_error(
+                    ref, run_fp16_calib(vars, calib_data, g.tensor_map)),
+            1e-2f);
+}
+#endif
+// vim: syntax=cpp.doxygen
@@ -1,4 +1,5 @@
 #include "test/kernel/common/checker.h"
+#include "test/kernel/common/weight_quant_matmul_reference.h"
 using namespace megdnn;
 using namespace megcc::test;
 TEST(NAIVE, MatMul) {
@@ -127,4 +128,42 @@ TEST(NAIVE, BatchedMatMulFp16) {
                         }
 }
 
-#endif
\ No newline at end of file
+#endif
+
+TEST(NAIVE, WeightQuantMatMul) {
+    //! megdnn has no weight quantized MatrixMul, the outputs are checked against
+    //! the matmul of the dequantized weight
+    UniformIntRNG int8_rng(-127, 127);
+    UniformIntRNG int4_rng(-128, 127);
+    Checker<MatrixMulForward> checker(Arch::BAREMETAL);
+    checker.set_kernel_symbol("kernel_weight_quant_matmul_nt_.*");
+    checker.set_epsilon(1e-3);
+    MatrixMulForward::Param param;
+    param.transposeB = true;
+    checker.set_param(param);
+    checker.set_dtype(1, dtype::QuantizedS8(1.f));
+    auto run = [&](size_t m, size_t n, size_t k, size_t group, bool int4) {
+        size_t nr_group = (k + group - 1) / group;
+        std::vector<float> scales(n * nr_group);
+        for (size_t i = 0; i < scales.size(); ++i) {
+            scales[i] = 0.005f + 0.0075f * (i % 7);
+        }
+        checker.set_rng(1, int4 ? &int4_rng : &int8_rng);
+        checker.set_scales(1, scales);
+        checker.set_reference(weight_quant_matmul_reference(scales, int4));
+        checker.execs({{m, k}, {n, int4 ? k / 2 : k}, {m, n}});
+    };
+    //! M = 1 is the gemv, odd K and K not a multiple of the group leave a
+    //! shorter last group
+    for (size_t m : {1, 3, 4, 9})
+        for (size_t n : {1, 7, 16}) {
+            for (size_t k : {1, 7, 17, 33, 64})
+                for (size_t group : {4, 16, 32}) {
+                    run(m, n, k, group, false);
+                }
+            for (size_t k : {32, 96, 160})
+                for (size_t group : {32, 64}) {
+                    run(m, n, k, group, true);
+                }
+        }
+}
@@ -5,6 +5,7 @@ using namespace megcc::KernelGen;
 
 TEST(NAIVE, Padding) {
     Checker<megdnn::Padding> checker;
+    checker.set_kernel_symbol("kernel_.*");
     megdnn::Padding::Param param;
     using PaddingMode = megdnn::Padding::Param::PaddingMode;
     auto run = [&checker, &param]() {
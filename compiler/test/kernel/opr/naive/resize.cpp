@@ -30,4 +30,54 @@ TEST(NAIVE, Resize) {
     checker.execs({{1, 1, 5, 6}, {1, 1, 7, 13}});
     checker.execs({{1, 4, 5, 6}, {1, 4, 9, 12}});
     checker.execs({{2, 3, 15, 16}, {2, 3, 9, 12}});
-}
\ No newline at end of file
+}
+
+TEST(NAIVE, ResizeQuantized) {
+    Checker<ResizeForward> checker;
+    checker.set_kernel_symbol("kernel_.*");
+    using Param = megdnn::ResizeForward::Param;
+    megcc::test::UniformIntRNG rng(-128, 127);
+    checker.set_rng(0, &rng);
+    checker.set_epsilon(1 + 1e-4);
+    Param param;
+    for (auto imode :
+         {Param::InterpolationMode::NEAREST, Param::InterpolationMode::LINEAR}) {
+        param.format = Param::Format::NCHW;
+        param.imode = imode;
+        checker.set_param(param);
+        for (DType dtype : std::vector<DType>{
+                     dtype::Int8(), dtype::QuantizedS8(0.5f)}) {
+            checker.set_dtype(0, dtype).set_dtype(1, dtype);
+            checker.execs({{1, 4, 5, 6}, {1, 4, 10, 12}});
+            checker.execs({{2, 3, 15, 16}, {2, 3, 9, 12}});
+            checker.execs({{1, 1, 1, 1}, {1, 1, 3, 3}});
+        }
+    }
+    megcc::test::UniformIntRNG urng(0, 255);
+    checker.set_rng(0, &urng);
+    checker.set_dtype(0, dtype::Uint8()).set_dtype(1, dtype::Uint8());
+    param.format = Param::Format::NCHW;
+    param.imode = Param::InterpolationMode::NEAREST;
+    checker.set_param(param);
+    checker.execs({{1, 4, 5, 6}, {1, 4, 10, 12}});
+    checker.execs({{1, 4, 5, 6}, {1, 4, 15, 18}});
+    checker.execs({{2, 3, 15, 16}, {2, 3, 9, 12}});
+}
+
+TEST(NAIVE, ResizeNHWCAndNCHW44Nearest) {
+    Checker<ResizeForward> checker;
+    checker.set_kernel_symbol("kernel_.*");
+    using Param = megdnn::ResizeForward::Param;
+    megcc::test::UniformRNG rng(-30, 30);
+    checker.set_rng(0, &rng);
+    Param param;
+    param.format = Param::Format::NHWC;
+    param.imode = Param::InterpolationMode::NEAREST;
+    checker.set_param(param);
+    checker.execs({{1, 5, 6, 3}, {1, 10, 12, 3}});
+    checker.execs({{2, 5, 6, 1}, {2, 15, 12, 1}});
+    param.format = Param::Format::NCHW44;
+    checker.set_param(param);
+    checker.execs({{1, 1, 5, 6, 4}, {1, 1, 10, 12, 4}});
+    checker.execs({{2, 3, 15, 16, 4}, {2, 3, 9, 12, 4}});
+}
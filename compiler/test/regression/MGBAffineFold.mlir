@@ -0,0 +1,90 @@
+// RUN: megcc-opt --mgb-affine-fold %s | FileCheck %s
+
+module {
+  // CHECK-NOT: sym_name = "s0"
+  // CHECK-NOT: sym_name = "d0"
+  // CHECK-DAG: sym_name = "k0_affine", sym_visibility = "private", type = tensor<2x1x1x1xf32>, user_count = 1 : i32, value = dense<{{\[\[\[\[}}2.000000e+00]]], {{\[\[\[}}6.000000e+00]]]]>
+  // CHECK-DAG: sym_name = "b0_affine{{[0-9]*}}", sym_visibility = "private", type = tensor<1x2x1x1xf32>, user_count = 1 : i32, value = dense<{{\[\[\[\[}}3.000000e+00]], {{\[\[}}4.000000e+00]]]]>
+  // CHECK-DAG: sym_name = "k1_bias", sym_visibility = "private", type = tensor<1x2x1x1xf32>
+  // CHECK-DAG: sym_name = "w_affine", sym_visibility = "private", type = tensor<3x2xf32>, user_count = 1 : i32, value = dense<{{\[\[}}2.000000e+00, 3.000000e+00], [2.000000e+00, 3.000000e+00], [2.000000e+00, 3.000000e+00]]>
+  // CHECK-DAG: sym_name = "a_affine", sym_visibility = "private", type = tensor<1x4x1x1xf32>, user_count = 1 : i32, value = dense<6.000000e+00>
+  "MGB.ParamStorage"() {sym_name = "k0", sym_visibility = "private", type = tensor<2x1x1x1xf32>, user_count = 1 : i32, value = dense<[[[[1.000000e+00]]], [[[2.000000e+00]]]]> : tensor<2x1x1x1xf32>} : () -> ()
+  "MGB.ParamStorage"() {sym_name = "b0", sym_visibility = "private", type = tensor<1x2x1x1xf32>, user_count = 1 : i32, value = dense<1.000000e+00> : tensor<1x2x1x1xf32>} : () -> ()
+  "MGB.ParamStorage"() {sym_name = "s0", sym_visibility = "private", type = tensor<1x2x1x1xf32>, user_count = 1 : i32, value = dense<[[[[2.000000e+00]], [[3.000000e+00]]]]> : tensor<1x2x1x1xf32>} : () -> ()
+  "MGB.ParamStorage"() {sym_name = "d0", sym_visibility = "private", type = tensor<1xf32>, user_count = 1 : i32, value = dense<1.000000e+00> : tensor<1xf32>} : () -> ()
+  "MGB.ParamStorage"() {sym_name = "k1", sym_visibility = "private", type = tensor<2x4x3x3xf32>, user_count = 1 : i32, value = dense<1.000000e+00> : tensor<2x4x3x3xf32>} : () -> ()
+  "MGB.ParamStorage"() {sym_name = "c1", sym_visibility = "private", type = tensor<1x2x1x1xf32>, user_count = 1 : i32, value = dense<5.000000e-01> : tensor<1x2x1x1xf32>} : () -> ()
+  "MGB.ParamStorage"() {sym_name = "x1", sym_visibility = "private", type = tensor<1x4x1x1xf32>, user_count = 1 : i32, value = dense<2.000000e+00> : tensor<1x4x1x1xf32>} : () -> ()
+  "MGB.ParamStorage"() {sym_name = "w", sym_visibility = "private", type = tensor<3x2xf32>, user_count = 1 : i32, value = dense<1.000000e+00> : tensor<3x2xf32>} : () -> ()
+  "MGB.ParamStorage"() {sym_name = "n", sym_visibility = "private", type = tensor<2xf32>, user_count = 1 : i32, value = dense<[2.000000e+00, 3.000000e+00]> : tensor<2xf32>} : () -> ()
+  "MGB.ParamStorage"() {sym_name = "a", sym_visibility = "private", type = tensor<1x4x1x1xf32>, user_count = 1 : i32, value = dense<2.000000e+00> : tensor<1x4x1x1xf32>} : () -> ()
+  "MGB.ParamStorage"() {sym_name = "t", sym_visibility = "private", type = tensor<1xf32>, user_count = 1 : i32, value = dense<3.000000e+00> : tensor<1xf32>} : () -> ()
+
+  // CHECK-LABEL: func @scale_shift_after_conv
+  func @scale_shift_after_conv(%arg0: tensor<1x1x4x4xf32>) -> tensor<1x2x4x4xf32> {
+    // CHECK: %[[CONV:.+]] = "MGB.ConvBias"(%arg0
+    //    CHECK-SAME: -> tensor<1x2x4x4xf32>
+    // CHECK-NEXT: return %[[CONV]]
+    %0 = "MGB.ParamProvider"() {name = @k0} : () -> tensor<2x1x1x1xf32>
+    %1 = "MGB.ParamProvider"() {name = @b0} : () -> tensor<1x2x1x1xf32>
+    %2 = "MGB.ParamProvider"() {name = @s0} : () -> tensor<1x2x1x1xf32>
+    %3 = "MGB.ParamProvider"() {name = @d0} : () -> tensor<1xf32>
+    %4 = "MGB.ConvBias"(%arg0, %0, %1) {compute_mode = 0 : i32, dilate_h = 1 : ui32, dilate_w = 1 : ui32, format = 0 : i32, mode = 0 : i32, nonlineMode = 0 : i32, pad_h = 0 : ui32, pad_w = 0 : ui32, sparse = 0 : i32, strategy = 1 : i32, stride_h = 1 : ui32, stride_w = 1 : ui32, workspace_limit = 18446744073709551615 : ui64} : (tensor<1x1x4x4xf32>, tensor<2x1x1x1xf32>, tensor<1x2x1x1xf32>) -> tensor<1x2x4x4xf32>
+    %5 = "MGB.Elemwise"(%4, %2) {mode = 21 : i32} : (tensor<1x2x4x4xf32>, tensor<1x2x1x1xf32>) -> tensor<1x2x4x4xf32>
+    %6 = "MGB.Elemwise"(%5, %3) {mode = 16 : i32} : (tensor<1x2x4x4xf32>, tensor<1xf32>) -> tensor<1x2x4x4xf32>
+    return %6 : tensor<1x2x4x4xf32>
+  }
+
+  // CHECK-LABEL: func @shift_after_convolution
+  func @shift_after_convolution(%arg0: tensor<1x4x8x8xf32>) -> tensor<1x2x8x8xf32> {
+    // CHECK: %[[BIAS:.+]] = "MGB.ParamProvider"() {name = @k1_bias}
+    // CHECK-NEXT: %[[CONV:.+]] = "MGB.ConvBias"(%arg0, %{{.+}}, %[[BIAS]])
+    //    CHECK-SAME: pad_h = 1 : ui32
+    // CHECK-NEXT: return %[[CONV]]
+    %0 = "MGB.ParamProvider"() {name = @k1} : () -> tensor<2x4x3x3xf32>
+    %1 = "MGB.ParamProvider"() {name = @c1} : () -> tensor<1x2x1x1xf32>
+    %2 = "MGB.Convolution"(%arg0, %0) {compute_mode = 0 : i32, dilate_h = 1 : ui32, dilate_w = 1 : ui32, format = 0 : i32, mode = 0 : i32, pad_h = 1 : ui32, pad_w = 1 : ui32, sparse = 0 : i32, strategy = 1 : i32, stride_h = 1 : ui32, stride_w = 1 : ui32, workspace_limit = 0 : ui64} : (tensor<1x4x8x8xf32>, tensor<2x4x3x3xf32>) -> tensor<1x2x8x8xf32>
+    %3 = "MGB.Elemwise"(%2, %1) {mode = 16 : i32} : (tensor<1x2x8x8xf32>, tensor<1x2x1x1xf32>) -> tensor<1x2x8x8xf32>
+    return %3 : tensor<1x2x8x8xf32>
+  }
+
+  // CHECK-LABEL: func @shift_before_padded_conv
+  func @shift_before_padded_conv(%arg0: tensor<1x4x8x8xf32>) -> tensor<1x2x8x8xf32> {
+    // CHECK: %[[SHIFT:.+]] = "MGB.Elemwise"(%arg0
+    //    CHECK-SAME: mode = 16
+    // CHECK: "MGB.Convolution"(%[[SHIFT]]
+    %0 = "MGB.ParamProvider"() {name = @k1} : () -> tensor<2x4x3x3xf32>
+    %1 = "MGB.ParamProvider"() {name = @x1} : () -> tensor<1x4x1x1xf32>
+    %2 = "MGB.Elemwise"(%arg0, %1) {mode = 16 : i32} : (tensor<1x4x8x8xf32>, tensor<1x4x1x1xf32>) -> tensor<1x4x8x8xf32>
+    %3 = "MGB.Convolution"(%2, %0) {compute_mode = 0 : i32, dilate_h = 1 : ui32, dilate_w = 1 : ui32, format = 0 : i32, mode = 0 : i32, pad_h = 1 : ui32, pad_w = 1 : ui32, sparse = 0 : i32, strategy = 1 : i32, stride_h = 1 : ui32, stride_w = 1 : ui32, workspace_limit = 0 : ui64} : (tensor<1x4x8x8xf32>, tensor<2x4x3x3xf32>) -> tensor<1x2x8x8xf32>
+    return %3 : tensor<1x2x8x8xf32>
+  }
+
+  // CHECK-LABEL: func @scale_after_matmul
+  func @scale_after_matmul(%arg0: tensor<4x3xf32>) -> tensor<4x2xf32> {
+    // CHECK: %[[W:.+]] = "MGB.ParamProvider"() {name = @w_affine}
+    // CHECK-NEXT: %[[MM:.+]] = "MGB.MatrixMul"(%arg0, %[[W]])
+    // CHECK-NEXT: return %[[MM]]
+    %0 = "MGB.ParamProvider"() {name = @w} : () -> tensor<3x2xf32>
+    %1 = "MGB.ParamProvider"() {name = @n} : () -> tensor<2xf32>
+    %2 = "MGB.MatrixMul"(%arg0, %0) {compute_mode = 0 : i32, format = 0 : i32, strategy = 1 : i32, transposeA = false, transposeB = false, workspace_limit = 0 : ui64} : (tensor<4x3xf32>, tensor<3x2xf32>) -> tensor<4x2xf32>
+    %3 = "MGB.Elemwise"(%2, %1) {mode = 21 : i32} : (tensor<4x2xf32>, tensor<2xf32>) -> tensor<4x2xf32>
+    return %3 : tensor<4x2xf32>
+  }
+
+  // CHECK-LABEL: func @merge_and_cancel
+  func @merge_and_cancel(%arg0: tensor<1x4x8x8xf32>) -> (tensor<1x4x8x8xf32>, tensor<1x4x8x8xf32>) {
+    // CHECK: %[[A:.+]] = "MGB.ParamProvider"() {name = @a_affine}
+    // CHECK-NEXT: %[[MUL:.+]] = "MGB.Elemwise"(%arg0, %[[A]]) {mode = 21 : i32}
+    // CHECK-NEXT: return %[[MUL]], %arg0
+    %0 = "MGB.ParamProvider"() {name = @a} : () -> tensor<1x4x1x1xf32>
+    %1 = "MGB.ParamProvider"() {name = @t} : () -> tensor<1xf32>
+    %2 = "MGB.Elemwise"(%arg0, %0) {mode = 21 : i32} : (tensor<1x4x8x8xf32>, tensor<1x4x1x1xf32>) -> tensor<1x4x8x8xf32>
+    %3 = "MGB.Elemwise"(%2, %1) {mode = 21 : i32} : (tensor<1x4x8x8xf32>, tensor<1xf32>) -> tensor<1x4x8x8xf32>
+    %4 = "MGB.ParamProvider"() {name = @t} : () -> tensor<1xf32>
+    %5 = "MGB.ParamProvider"() {name = @t} : () -> tensor<1xf32>
+    %6 = "MGB.Elemwise"(%arg0, %4) {mode = 16 : i32} : (tensor<1x4x8x8xf32>, tensor<1xf32>) -> tensor<1x4x8x8xf32>
+    %7 = "MGB.Elemwise"(%6, %5) {mode = 24 : i32} : (tensor<1x4x8x8xf32>, tensor<1xf32>) -> tensor<1x4x8x8xf32>
+    return %3, %7 : tensor<1x4x8x8xf32>, tensor<1x4x8x8xf32>
+  }
+}
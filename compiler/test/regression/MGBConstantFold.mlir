@@ -0,0 +1,90 @@
+// RUN: megcc-opt --mgb-constant-fold %s | FileCheck %s
+
+module {
+  // CHECK-NOT: sym_name = "w"
+  // CHECK-NOT: sym_name = "b"
+  // CHECK-NOT: sym_name = "s"
+  // CHECK-DAG: sym_name = "w_fold", sym_visibility = "private", type = tensor<3x2xf32>, user_count = 1 : i32, value = dense<{{\[\[}}1.000000e+00, 4.000000e+00], [2.000000e+00, 5.000000e+00], [3.000000e+00, 6.000000e+00]]> : tensor<3x2xf32>
+  // CHECK-DAG: sym_name = "b_fold{{[0-9]*}}", sym_visibility = "private", type = tensor<4xf32>, user_count = 1 : i32, value = dense<[2.000000e+00, 4.000000e+00, 6.000000e+00, 8.000000e+00]> : tensor<4xf32>
+  // CHECK-DAG: sym_name = "q_fold", sym_visibility = "private", type = tensor<4xqsi8<1056964608:5.000000e-01>>, user_count = 1 : i32, value = dense<[2, -4, 127, 1]>
+  // CHECK-DAG: sym_name = "q16_fold", sym_visibility = "private", type = tensor<3xqsi16<1056964608:5.000000e-01>>, user_count = 1 : i32, value = dense<[32767, -32768, 6]>
+  // CHECK-DAG: sym_name = "q32_fold", sym_visibility = "private", type = tensor<3xqsi32<1056964608:5.000000e-01>>, user_count = 1 : i32, value = dense<[2147483647, -2147483648, 2]>
+  // CHECK-DAG: sym_name = "shape_fold{{[0-9]*}}", sym_visibility = "private", type = tensor<2xsi32>, user_count = 1 : i32, value = dense<[6, 4]> : tensor<2xsi32>
+  "MGB.ParamStorage"() {sym_name = "w", sym_visibility = "private", type = tensor<2x3xf32>, user_count = 1 : i32, value = dense<[[1.000000e+00, 2.000000e+00, 3.000000e+00], [4.000000e+00, 5.000000e+00, 6.000000e+00]]> : tensor<2x3xf32>} : () -> ()
+  "MGB.ParamStorage"() {sym_name = "b", sym_visibility = "private", type = tensor<1x4x1x1xf32>, user_count = 1 : i32, value = dense<[[[[1.000000e+00]], [[2.000000e+00]], [[3.000000e+00]], [[4.000000e+00]]]]> : tensor<1x4x1x1xf32>} : () -> ()
+  "MGB.ParamStorage"() {sym_name = "s", sym_visibility = "private", type = tensor<1xf32>, user_count = 1 : i32, value = dense<2.000000e+00> : tensor<1xf32>} : () -> ()
+  "MGB.ParamStorage"() {sym_name = "q", sym_visibility = "private", type = tensor<4xf32>, user_count = 1 : i32, value = dense<[1.000000e+00, -2.000000e+00, 1.000000e+02, 2.500000e-01]> : tensor<4xf32>} : () -> ()
+  "MGB.ParamStorage"() {sym_name = "q16", sym_visibility = "private", type = tensor<3xf32>, user_count = 1 : i32, value = dense<[1.000000e+05, -1.000000e+05, 3.000000e+00]> : tensor<3xf32>} : () -> ()
+  "MGB.ParamStorage"() {sym_name = "q32", sym_visibility = "private", type = tensor<3xf32>, user_count = 1 : i32, value = dense<[3.000000e+09, -3.000000e+09, 1.000000e+00]> : tensor<3xf32>} : () -> ()
+
+  // CHECK-LABEL: func @weight_dimshuffle
+  func @weight_dimshuffle(%arg0: tensor<4x3xf32>) -> tensor<4x2xf32> {
+    // CHECK-NEXT: %[[W:.+]] = "MGB.ParamProvider"() {name = @w_fold} : () -> tensor<3x2xf32>
+    // CHECK-NEXT: "MGB.MatrixMul"(%arg0, %[[W]])
+    %0 = "MGB.ParamProvider"() {name = @w} : () -> tensor<2x3xf32>
+    %1 = "MGB.Dimshuffle"(%0) {pattern = [1 : i32, 0 : i32]} : (tensor<2x3xf32>) -> tensor<3x2xf32>
+    %2 = "MGB.MatrixMul"(%arg0, %1) {compute_mode = 0 : i32, format = 0 : i32, strategy = 1 : i32, transposeA = false, transposeB = false, workspace_limit = 0 : ui64} : (tensor<4x3xf32>, tensor<3x2xf32>) -> tensor<4x2xf32>
+    return %2 : tensor<4x2xf32>
+  }
+
+  // CHECK-LABEL: func @bias_chain
+  func @bias_chain(%arg0: tensor<2x4xf32>) -> tensor<2x4xf32> {
+    // CHECK-NEXT: %[[B:.+]] = "MGB.ParamProvider"() {name = @b_fold{{[0-9]*}}} : () -> tensor<4xf32>
+    // CHECK-NEXT: "MGB.Elemwise"(%arg0, %[[B]]) {mode = 16 : i32}
+    // CHECK-NEXT: return
+    %0 = "MGB.ParamProvider"() {name = @b} : () -> tensor<1x4x1x1xf32>
+    %1 = "MGB.ParamProvider"() {name = @s} : () -> tensor<1xf32>
+    %2 = "MGB.Elemwise"(%0, %1) {mode = 21 : i32} : (tensor<1x4x1x1xf32>, tensor<1xf32>) -> tensor<1x4x1x1xf32>
+    %3 = "MGB.Reshape"(%2) {axis = 7 : i32} : (tensor<1x4x1x1xf32>) -> tensor<4xf32>
+    %4 = "MGB.Elemwise"(%arg0, %3) {mode = 16 : i32} : (tensor<2x4xf32>, tensor<4xf32>) -> tensor<2x4xf32>
+    return %4 : tensor<2x4xf32>
+  }
+
+  // CHECK-LABEL: func @quantize
+  func @quantize() -> tensor<4xqsi8<1056964608:5.000000e-01>> {
+    // CHECK-NEXT: %[[Q:.+]] = "MGB.ParamProvider"() {name = @q_fold}
+    // CHECK-NEXT: return %[[Q]]
+    %0 = "MGB.ParamProvider"() {name = @q} : () -> tensor<4xf32>
+    %1 = "MGB.TypeCvt"(%0) {i_dtype = f32, i_scale = 1.000000e+00 : f32, i_zero = 0 : ui8, o_dtype = qsi8<1056964608:5.000000e-01>, o_scale = 1.000000e+00 : f32, o_zero = 0 : ui8} : (tensor<4xf32>) -> tensor<4xqsi8<1056964608:5.000000e-01>>
+    return %1 : tensor<4xqsi8<1056964608:5.000000e-01>>
+  }
+
+  // CHECK-LABEL: func @quantize_16bit
+  func @quantize_16bit() -> tensor<3xqsi16<1056964608:5.000000e-01>> {
+    // CHECK-NEXT: %[[Q:.+]] = "MGB.ParamProvider"() {name = @q16_fold}
+    // CHECK-NEXT: return %[[Q]]
+    %0 = "MGB.ParamProvider"() {name = @q16} : () -> tensor<3xf32>
+    %1 = "MGB.TypeCvt"(%0) {i_dtype = f32, i_scale = 1.000000e+00 : f32, i_zero = 0 : ui8, o_dtype = qsi16<1056964608:5.000000e-01>, o_scale = 1.000000e+00 : f32, o_zero = 0 : ui8} : (tensor<3xf32>) -> tensor<3xqsi16<1056964608:5.000000e-01>>
+    return %1 : tensor<3xqsi16<1056964608:5.000000e-01>>
+  }
+
+  // CHECK-LABEL: func @quantize_32bit
+  func @quantize_32bit() -> tensor<3xqsi32<1056964608:5.000000e-01>> {
+    // CHECK-NEXT: %[[Q:.+]] = "MGB.ParamProvider"() {name = @q32_fold}
+    // CHECK-NEXT: return %[[Q]]
+    %0 = "MGB.ParamProvider"() {name = @q32} : () -> tensor<3xf32>
+    %1 = "MGB.TypeCvt"(%0) {i_dtype = f32, i_scale = 1.000000e+00 : f32, i_zero = 0 : ui8, o_dtype = qsi32<1056964608:5.000000e-01>, o_scale = 1.000000e+00 : f32, o_zero = 0 : ui8} : (tensor<3xf32>) -> tensor<3xqsi32<1056964608:5.000000e-01>>
+    return %1 : tensor<3xqsi32<1056964608:5.000000e-01>>
+  }
+
+  // CHECK-LABEL: func @shape_arith
+  func @shape_arith(%arg0: tensor<2x3x4xf32>) -> tensor<6x4xf32> {
+    // CHECK-NEXT: %[[S:.+]] = "MGB.ParamProvider"() {name = @shape_fold{{[0-9]*}}} : () -> tensor<2xsi32>
+    // CHECK-NEXT: "MGB.Reshape"(%arg0, %[[S]])
+    // CHECK-NEXT: return
+    %0 = "MGB.GetVarShape"(%arg0) {axis = 0 : i32} : (tensor<2x3x4xf32>) -> tensor<1xsi32>
+    %1 = "MGB.GetVarShape"(%arg0) {axis = 1 : i32} : (tensor<2x3x4xf32>) -> tensor<1xsi32>
+    %2 = "MGB.GetVarShape"(%arg0) {axis = 2 : i32} : (tensor<2x3x4xf32>) -> tensor<1xsi32>
+    %3 = "MGB.Elemwise"(%0, %1) {mode = 21 : i32} : (tensor<1xsi32>, tensor<1xsi32>) -> tensor<1xsi32>
+    %4 = "MGB.Concat"(%3, %2) {axis = 0 : i32, comp_node = "cpu:default"} : (tensor<1xsi32>, tensor<1xsi32>) -> tensor<2xsi32>
+    %5 = "MGB.Reshape"(%arg0, %4) {axis = 7 : i32} : (tensor<2x3x4xf32>, tensor<2xsi32>) -> tensor<6x4xf32>
+    return %5 : tensor<6x4xf32>
+  }
+
+  // CHECK-LABEL: func @runtime_input
+  func @runtime_input(%arg0: tensor<4xf32>) -> tensor<4xf32> {
+    // CHECK: "MGB.Elemwise"(%arg0
+    %0 = "MGB.Elemwise"(%arg0) {mode = 0 : i32} : (tensor<4xf32>) -> tensor<4xf32>
+    return %0 : tensor<4xf32>
+  }
+}
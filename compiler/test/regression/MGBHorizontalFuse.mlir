@@ -0,0 +1,97 @@
+// RUN: megcc-opt --mgb-horizontal-fuse %s | FileCheck %s
+
+module {
+  // CHECK-NOT: sym_name = "w0"
+  // CHECK-NOT: sym_name = "w1"
+  // CHECK-DAG: sym_name = "w0_hfuse", sym_visibility = "private", type = tensor<16x32xf32>
+  // CHECK-DAG: sym_name = "k0_hfuse", sym_visibility = "private", type = tensor<48x16x1x1xf32>
+  // CHECK-DAG: sym_name = "b0_hfuse", sym_visibility = "private", type = tensor<1x48x1x1xf32>
+  // CHECK-DAG: sym_name = "k2", sym_visibility = "private", type = tensor<8x16x3x3xf32>
+  // CHECK-DAG: sym_name = "k3", sym_visibility = "private", type = tensor<16x16x1x1xf32>
+  // CHECK-DAG: sym_name = "k4", sym_visibility = "private", type = tensor<32x16x1x1xf32>
+  // CHECK-DAG: sym_name = "k5", sym_visibility = "private", type = tensor<16x1x1x16xf32>
+  // CHECK-DAG: sym_name = "k6", sym_visibility = "private", type = tensor<32x1x1x16xf32>
+  "MGB.ParamStorage"() {sym_name = "w0", sym_visibility = "private", type = tensor<16x8xf32>, user_count = 1 : i32, value = dense<1.000000e+00> : tensor<16x8xf32>} : () -> ()
+  "MGB.ParamStorage"() {sym_name = "w1", sym_visibility = "private", type = tensor<16x24xf32>, user_count = 1 : i32, value = dense<2.000000e+00> : tensor<16x24xf32>} : () -> ()
+  "MGB.ParamStorage"() {sym_name = "k0", sym_visibility = "private", type = tensor<16x16x1x1xf32>, user_count = 1 : i32, value = dense<1.000000e+00> : tensor<16x16x1x1xf32>} : () -> ()
+  "MGB.ParamStorage"() {sym_name = "k1", sym_visibility = "private", type = tensor<32x16x1x1xf32>, user_count = 1 : i32, value = dense<2.000000e+00> : tensor<32x16x1x1xf32>} : () -> ()
+  "MGB.ParamStorage"() {sym_name = "k2", sym_visibility = "private", type = tensor<8x16x3x3xf32>, user_count = 1 : i32, value = dense<3.000000e+00> : tensor<8x16x3x3xf32>} : () -> ()
+  "MGB.ParamStorage"() {sym_name = "k3", sym_visibility = "private", type = tensor<16x16x1x1xf32>, user_count = 1 : i32, value = dense<1.000000e+00> : tensor<16x16x1x1xf32>} : () -> ()
+  "MGB.ParamStorage"() {sym_name = "k4", sym_visibility = "private", type = tensor<32x16x1x1xf32>, user_count = 1 : i32, value = dense<2.000000e+00> : tensor<32x16x1x1xf32>} : () -> ()
+  "MGB.ParamStorage"() {sym_name = "k5", sym_visibility = "private", type = tensor<16x1x1x16xf32>, user_count = 1 : i32, value = dense<1.000000e+00> : tensor<16x1x1x16xf32>} : () -> ()
+  "MGB.ParamStorage"() {sym_name = "k6", sym_visibility = "private", type = tensor<32x1x1x16xf32>, user_count = 1 : i32, value = dense<2.000000e+00> : tensor<32x1x1x16xf32>} : () -> ()
+  "MGB.ParamStorage"() {sym_name = "b0", sym_visibility = "private", type = tensor<1x16x1x1xf32>, user_count = 1 : i32, value = dense<1.000000e+00> : tensor<1x16x1x1xf32>} : () -> ()
+  "MGB.ParamStorage"() {sym_name = "b1", sym_visibility = "private", type = tensor<1x32x1x1xf32>, user_count = 1 : i32, value = dense<2.000000e+00> : tensor<1x32x1x1xf32>} : () -> ()
+  "MGB.ParamStorage"() {sym_name = "b2", sym_visibility = "private", type = tensor<1x8x1x1xf32>, user_count = 1 : i32, value = dense<3.000000e+00> : tensor<1x8x1x1xf32>} : () -> ()
+
+  // CHECK-LABEL: func @matmul
+  func @matmul(%arg0: tensor<4x16xf32>) -> (tensor<4x8xf32>, tensor<4x24xf32>) {
+    // CHECK-NEXT: %[[W:.+]] = "MGB.ParamProvider"() {name = @w0_hfuse}
+    // CHECK-NEXT: %[[MM:.+]] = "MGB.MatrixMul"(%arg0, %[[W]])
+    //    CHECK-SAME: -> tensor<4x32xf32>
+    // CHECK-NEXT: %[[S0:.+]] = "MGB.Subtensor"(%[[MM]])
+    //    CHECK-SAME: descs = {{\[\[}}1 : i32, 0 : i32, 8 : i32, 1 : i32, -1 : i32]]
+    //    CHECK-SAME: -> tensor<4x8xf32>
+    // CHECK-NEXT: %[[S1:.+]] = "MGB.Subtensor"(%[[MM]])
+    //    CHECK-SAME: descs = {{\[\[}}1 : i32, 8 : i32, 32 : i32, 1 : i32, -1 : i32]]
+    //    CHECK-SAME: -> tensor<4x24xf32>
+    // CHECK-NEXT: return %[[S0]], %[[S1]]
+    %0 = "MGB.ParamProvider"() {name = @w0} : () -> tensor<16x8xf32>
+    %1 = "MGB.ParamProvider"() {name = @w1} : () -> tensor<16x24xf32>
+    %2 = "MGB.MatrixMul"(%arg0, %0) {compute_mode = 0 : i32, format = 0 : i32, strategy = 1 : i32, transposeA = false, transposeB = false, workspace_limit = 0 : ui64} : (tensor<4x16xf32>, tensor<16x8xf32>) -> tensor<4x8xf32>
+    %3 = "MGB.MatrixMul"(%arg0, %1) {compute_mode = 0 : i32, format = 0 : i32, strategy = 1 : i32, transposeA = false, transposeB = false, workspace_limit = 0 : ui64} : (tensor<4x16xf32>, tensor<16x24xf32>) -> tensor<4x24xf32>
+    return %2, %3 : tensor<4x8xf32>, tensor<4x24xf32>
+  }
+
+  // CHECK-LABEL: func @conv_bias
+  func @conv_bias(%arg0: tensor<1x16x8x8xf32>) -> (tensor<1x16x8x8xf32>, tensor<1x32x8x8xf32>, tensor<1x8x8x8xf32>) {
+    // CHECK: %[[CONV:.+]] = "MGB.ConvBias"(%arg0
+    //    CHECK-SAME: -> tensor<1x48x8x8xf32>
+    // CHECK: "MGB.Subtensor"(%[[CONV]])
+    //    CHECK-SAME: -> tensor<1x16x8x8xf32>
+    // CHECK: "MGB.Subtensor"(%[[CONV]])
+    //    CHECK-SAME: -> tensor<1x32x8x8xf32>
+    // CHECK: "MGB.ConvBias"(%arg0
+    //    CHECK-SAME: -> tensor<1x8x8x8xf32>
+    %0 = "MGB.ParamProvider"() {name = @k0} : () -> tensor<16x16x1x1xf32>
+    %1 = "MGB.ParamProvider"() {name = @b0} : () -> tensor<1x16x1x1xf32>
+    %2 = "MGB.ParamProvider"() {name = @k1} : () -> tensor<32x16x1x1xf32>
+    %3 = "MGB.ParamProvider"() {name = @b1} : () -> tensor<1x32x1x1xf32>
+    %4 = "MGB.ParamProvider"() {name = @k2} : () -> tensor<8x16x3x3xf32>
+    %5 = "MGB.ParamProvider"() {name = @b2} : () -> tensor<1x8x1x1xf32>
+    %6 = "MGB.ConvBias"(%arg0, %0, %1) {compute_mode = 0 : i32, dilate_h = 1 : ui32, dilate_w = 1 : ui32, format = 0 : i32, mode = 0 : i32, nonlineMode = 1 : i32, pad_h = 0 : ui32, pad_w = 0 : ui32, sparse = 0 : i32, strategy = 1 : i32, stride_h = 1 : ui32, stride_w = 1 : ui32, workspace_limit = 18446744073709551615 : ui64} : (tensor<1x16x8x8xf32>, tensor<16x16x1x1xf32>, tensor<1x16x1x1xf32>) -> tensor<1x16x8x8xf32>
+    %7 = "MGB.ConvBias"(%arg0, %2, %3) {compute_mode = 0 : i32, dilate_h = 1 : ui32, dilate_w = 1 : ui32, format = 0 : i32, mode = 0 : i32, nonlineMode = 1 : i32, pad_h = 0 : ui32, pad_w = 0 : ui32, sparse = 0 : i32, strategy = 1 : i32, stride_h = 1 : ui32, stride_w = 1 : ui32, workspace_limit = 18446744073709551615 : ui64} : (tensor<1x16x8x8xf32>, tensor<32x16x1x1xf32>, tensor<1x32x1x1xf32>) -> tensor<1x32x8x8xf32>
+    %8 = "MGB.ConvBias"(%arg0, %4, %5) {compute_mode = 0 : i32, dilate_h = 1 : ui32, dilate_w = 1 : ui32, format = 0 : i32, mode = 0 : i32, nonlineMode = 1 : i32, pad_h = 1 : ui32, pad_w = 1 : ui32, sparse = 0 : i32, strategy = 1 : i32, stride_h = 1 : ui32, stride_w = 1 : ui32, workspace_limit = 18446744073709551615 : ui64} : (tensor<1x16x8x8xf32>, tensor<8x16x3x3xf32>, tensor<1x8x1x1xf32>) -> tensor<1x8x8x8xf32>
+    return %6, %7, %8 : tensor<1x16x8x8xf32>, tensor<1x32x8x8xf32>, tensor<1x8x8x8xf32>
+  }
+
+  // the channel split of a batched result is not contiguous
+  // CHECK-LABEL: func @conv_batched
+  func @conv_batched(%arg0: tensor<2x16x8x8xf32>) -> (tensor<2x16x8x8xf32>, tensor<2x32x8x8xf32>) {
+    // CHECK-NOT: "MGB.Subtensor"
+    // CHECK: "MGB.ConvBias"(%arg0
+    //    CHECK-SAME: -> tensor<2x16x8x8xf32>
+    // CHECK: "MGB.ConvBias"(%arg0
+    //    CHECK-SAME: -> tensor<2x32x8x8xf32>
+    %0 = "MGB.ParamProvider"() {name = @k3} : () -> tensor<16x16x1x1xf32>
+    %1 = "MGB.ParamProvider"() {name = @k4} : () -> tensor<32x16x1x1xf32>
+    %2 = "MGB.ConvBias"(%arg0, %0) {compute_mode = 0 : i32, dilate_h = 1 : ui32, dilate_w = 1 : ui32, format = 0 : i32, mode = 0 : i32, nonlineMode = 1 : i32, pad_h = 0 : ui32, pad_w = 0 : ui32, sparse = 0 : i32, strategy = 1 : i32, stride_h = 1 : ui32, stride_w = 1 : ui32, workspace_limit = 18446744073709551615 : ui64} : (tensor<2x16x8x8xf32>, tensor<16x16x1x1xf32>) -> tensor<2x16x8x8xf32>
+    %3 = "MGB.ConvBias"(%arg0, %1) {compute_mode = 0 : i32, dilate_h = 1 : ui32, dilate_w = 1 : ui32, format = 0 : i32, mode = 0 : i32, nonlineMode = 1 : i32, pad_h = 0 : ui32, pad_w = 0 : ui32, sparse = 0 : i32, strategy = 1 : i32, stride_h = 1 : ui32, stride_w = 1 : ui32, workspace_limit = 18446744073709551615 : ui64} : (tensor<2x16x8x8xf32>, tensor<32x16x1x1xf32>) -> tensor<2x32x8x8xf32>
+    return %2, %3 : tensor<2x16x8x8xf32>, tensor<2x32x8x8xf32>
+  }
+
+  // the output channel of NHWC is not axis 1
+  // CHECK-LABEL: func @conv_nhwc
+  func @conv_nhwc(%arg0: tensor<1x8x8x16xf32>) -> (tensor<1x8x8x16xf32>, tensor<1x8x8x32xf32>) {
+    // CHECK-NOT: "MGB.Subtensor"
+    // CHECK: "MGB.ConvBias"(%arg0
+    //    CHECK-SAME: -> tensor<1x8x8x16xf32>
+    // CHECK: "MGB.ConvBias"(%arg0
+    //    CHECK-SAME: -> tensor<1x8x8x32xf32>
+    %0 = "MGB.ParamProvider"() {name = @k5} : () -> tensor<16x1x1x16xf32>
+    %1 = "MGB.ParamProvider"() {name = @k6} : () -> tensor<32x1x1x16xf32>
+    %2 = "MGB.ConvBias"(%arg0, %0) {compute_mode = 0 : i32, dilate_h = 1 : ui32, dilate_w = 1 : ui32, format = 1 : i32, mode = 0 : i32, nonlineMode = 1 : i32, pad_h = 0 : ui32, pad_w = 0 : ui32, sparse = 0 : i32, strategy = 1 : i32, stride_h = 1 : ui32, stride_w = 1 : ui32, workspace_limit = 18446744073709551615 : ui64} : (tensor<1x8x8x16xf32>, tensor<16x1x1x16xf32>) -> tensor<1x8x8x16xf32>
+    %3 = "MGB.ConvBias"(%arg0, %1) {compute_mode = 0 : i32, dilate_h = 1 : ui32, dilate_w = 1 : ui32, format = 1 : i32, mode = 0 : i32, nonlineMode = 1 : i32, pad_h = 0 : ui32, pad_w = 0 : ui32, sparse = 0 : i32, strategy = 1 : i32, stride_h = 1 : ui32, stride_w = 1 : ui32, workspace_limit = 18446744073709551615 : ui64} : (tensor<1x8x8x16xf32>, tensor<32x1x1x16xf32>) -> tensor<1x8x8x32xf32>
+    return %2, %3 : tensor<1x8x8x16xf32>, tensor<1x8x8x32xf32>
+  }
+}
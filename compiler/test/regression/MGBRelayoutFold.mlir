@@ -0,0 +1,64 @@
+// RUN: megcc-opt --mgb-relayout-fold %s | FileCheck %s
+
+module {
+  // CHECK-LABEL: func @nchw44_roundtrip
+  func @nchw44_roundtrip(%arg0: tensor<1x8x3x5xf32>) -> tensor<1x8x3x5xf32> {
+    // CHECK-NEXT: return %arg0
+    %0 = "MGB.Reshape"(%arg0) {axis = 7 : i32} : (tensor<1x8x3x5xf32>) -> tensor<1x2x4x3x5xf32>
+    %1 = "MGB.Dimshuffle"(%0) {pattern = [0 : i32, 1 : i32, 3 : i32, 4 : i32, 2 : i32]} : (tensor<1x2x4x3x5xf32>) -> tensor<1x2x3x5x4xf32>
+    %2 = "MGB.Dimshuffle"(%1) {pattern = [0 : i32, 1 : i32, 4 : i32, 2 : i32, 3 : i32]} : (tensor<1x2x3x5x4xf32>) -> tensor<1x2x4x3x5xf32>
+    %3 = "MGB.Reshape"(%2) {axis = 7 : i32} : (tensor<1x2x4x3x5xf32>) -> tensor<1x8x3x5xf32>
+    return %3 : tensor<1x8x3x5xf32>
+  }
+
+  // CHECK-LABEL: func @transpose_pair
+  func @transpose_pair(%arg0: tensor<3x4x5xf32>) -> tensor<3x4x5xf32> {
+    // CHECK-NEXT: return %arg0
+    %0 = "MGB.Dimshuffle"(%arg0) {pattern = [2 : i32, 0 : i32, 1 : i32]} : (tensor<3x4x5xf32>) -> tensor<5x3x4xf32>
+    %1 = "MGB.Dimshuffle"(%0) {pattern = [1 : i32, 2 : i32, 0 : i32]} : (tensor<5x3x4xf32>) -> tensor<3x4x5xf32>
+    return %1 : tensor<3x4x5xf32>
+  }
+
+  // CHECK-LABEL: func @nchw44_to_nchw88
+  func @nchw44_to_nchw88(%arg0: tensor<1x4x3x5x4xf32>) -> tensor<1x2x3x5x8xf32> {
+    // CHECK-NEXT: %[[SRC:.+]] = "MGB.Reshape"(%arg0) {{.+}} -> tensor<2x2x15x4xf32>
+    // CHECK-NEXT: %[[SHUFFLE:.+]] = "MGB.Dimshuffle"(%[[SRC]]) {pattern = [0 : i32, 2 : i32, 1 : i32, 3 : i32]} {{.+}} -> tensor<2x15x2x4xf32>
+    // CHECK-NEXT: %[[DST:.+]] = "MGB.Reshape"(%[[SHUFFLE]]) {{.+}} -> tensor<1x2x3x5x8xf32>
+    // CHECK-NEXT: return %[[DST]]
+    %0 = "MGB.Dimshuffle"(%arg0) {pattern = [0 : i32, 1 : i32, 4 : i32, 2 : i32, 3 : i32]} : (tensor<1x4x3x5x4xf32>) -> tensor<1x4x4x3x5xf32>
+    %1 = "MGB.Reshape"(%0) {axis = 7 : i32} : (tensor<1x4x4x3x5xf32>) -> tensor<1x16x3x5xf32>
+    %2 = "MGB.Reshape"(%1) {axis = 7 : i32} : (tensor<1x16x3x5xf32>) -> tensor<1x2x8x3x5xf32>
+    %3 = "MGB.Dimshuffle"(%2) {pattern = [0 : i32, 1 : i32, 3 : i32, 4 : i32, 2 : i32]} : (tensor<1x2x8x3x5xf32>) -> tensor<1x2x3x5x8xf32>
+    return %3 : tensor<1x2x3x5x8xf32>
+  }
+
+  // CHECK-LABEL: func @channel_shuffle
+  func @channel_shuffle(%arg0: tensor<1x12x3x3xf32>) -> tensor<1x12x3x3xf32> {
+    // CHECK-NEXT: %[[SRC:.+]] = "MGB.Reshape"(%arg0) {{.+}} -> tensor<3x4x9xf32>
+    // CHECK-NEXT: %[[SHUFFLE:.+]] = "MGB.Dimshuffle"(%[[SRC]]) {pattern = [1 : i32, 0 : i32, 2 : i32]} {{.+}} -> tensor<4x3x9xf32>
+    // CHECK-NEXT: %[[DST:.+]] = "MGB.Reshape"(%[[SHUFFLE]]) {{.+}} -> tensor<1x12x3x3xf32>
+    // CHECK-NEXT: return %[[DST]]
+    %0 = "MGB.Reshape"(%arg0) {axis = 7 : i32} : (tensor<1x12x3x3xf32>) -> tensor<1x3x4x3x3xf32>
+    %1 = "MGB.Dimshuffle"(%0) {pattern = [0 : i32, 2 : i32, 1 : i32, 3 : i32, 4 : i32]} : (tensor<1x3x4x3x3xf32>) -> tensor<1x4x3x3x3xf32>
+    %2 = "MGB.Reshape"(%1) {axis = 7 : i32} : (tensor<1x4x3x3x3xf32>) -> tensor<1x12x3x3xf32>
+    return %2 : tensor<1x12x3x3xf32>
+  }
+
+  // CHECK-LABEL: func @single_transpose
+  func @single_transpose(%arg0: tensor<1x4x3x5xf32>) -> tensor<1x3x5x4xf32> {
+    // CHECK-NEXT: %[[SHUFFLE:.+]] = "MGB.Dimshuffle"(%arg0) {pattern = [0 : i32, 2 : i32, 3 : i32, 1 : i32]}
+    // CHECK-NEXT: return %[[SHUFFLE]]
+    %0 = "MGB.Dimshuffle"(%arg0) {pattern = [0 : i32, 2 : i32, 3 : i32, 1 : i32]} : (tensor<1x4x3x5xf32>) -> tensor<1x3x5x4xf32>
+    return %0 : tensor<1x3x5x4xf32>
+  }
+
+  // CHECK-LABEL: func @matmul_transpose
+  func @matmul_transpose(%arg0: tensor<4x3xf32>, %arg1: tensor<3x2xf32>) -> tensor<4x2xf32> {
+    // CHECK-NEXT: %[[MM:.+]] = "MGB.MatrixMul"(%arg0, %arg1)
+    //    CHECK-SAME: transposeB = false
+    // CHECK-NEXT: return %[[MM]]
+    %0 = "MGB.Dimshuffle"(%arg1) {pattern = [1 : i32, 0 : i32]} : (tensor<3x2xf32>) -> tensor<2x3xf32>
+    %1 = "MGB.MatrixMul"(%arg0, %0) {compute_mode = 0 : i32, format = 0 : i32, strategy = 1 : i32, transposeA = false, transposeB = true, workspace_limit = 0 : ui64} : (tensor<4x3xf32>, tensor<2x3xf32>) -> tensor<4x2xf32>
+    return %1 : tensor<4x2xf32>
+  }
+}
@@ -927,6 +927,31 @@ std::vector<megcc::CodeGenContext> config_attr(
             megcc::CodeGenContext ctx(attr_map);
             ret.push_back(ctx);
         } break;
+        case KPT::ArgminKernel: {
+            auto&& m_helper = ParamHelper<megdnn::ArgminForward>();
+            auto param = m_helper.create_param();
+            megcc::CCOperand res;
+            megcc::CCOperand index;
+            index.dtype = "i32";
+            if (use_default_attr) {
+                res.dtype = "f32";
+                param.axis = 1;
+            } else {
+                DEC_DTYPE();
+                res.dtype = dtype_input;
+
+                llvm::outs() << "please config \"axis\" "
+                             << "\n";
+                int int_input = get_int();
+                param.axis = int32_t(int_input);
+            }
+            attr_map["nr_operands"] = megcc::CCAttr(2);
+            attr_map["operand:0"] = megcc::CCAttr(res);
+            attr_map["operand:1"] = megcc::CCAttr(index);
+            FILL_MAP(attr_map, param, axis);
+            megcc::CodeGenContext ctx(attr_map);
+            ret.push_back(ctx);
+        } break;
         case KPT::ConcatKernel: {
             auto&& m_helper = ParamHelper<megdnn::ConcatForward>();
             auto param = m_helper.create_param();
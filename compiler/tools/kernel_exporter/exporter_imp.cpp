@@ -124,6 +124,7 @@ std::map<std::string, KPT> KernelExporter::m_kern_name2type{
         {"CvtColorKernel", KPT::CvtColorKernel},
         {"ArgSortKernel", KPT::ArgSortKernel},
         {"ArgmaxKernel", KPT::ArgmaxKernel},
+        {"ArgminKernel", KPT::ArgminKernel},
         {"ConcatKernel", KPT::ConcatKernel},
         {"ConvBackDataKernel", KPT::ConvBackDataKernel}
 
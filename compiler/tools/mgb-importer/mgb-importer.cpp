@@ -21,6 +21,32 @@ cl::opt<bool> Enable_nchw44_dot(
         "enable_nchw44_dot", cl::desc("enable nchw44-dot trans"));
 cl::opt<bool> Add_nhwc2nchw_to_input(
         "add_nhwc2nchw_to_input", cl::desc("add nhwc2nchw dimshuffle to input"));
+cl::opt<std::string> InputMean(
+        "input-mean", cl::Optional, cl::desc("per channel mean of the 4-dim inputs"),
+        cl::value_desc("mean0,mean1,mean2"));
+cl::opt<std::string> InputStd(
+        "input-std", cl::Optional, cl::desc("per channel std of the 4-dim inputs"),
+        cl::value_desc("std0,std1,std2"));
+cl::opt<bool> InputUint8("input_uint8", cl::desc("feed the 4-dim inputs as uint8"));
+cl::opt<bool> QuantizeFakeQuant(
+        "quantize_fake_quant", cl::desc("convert the FakeQuant convolutions to int8"));
+cl::opt<std::string> WeightQuant(
+        "weight_quant", cl::Optional,
+        cl::desc("store the MatrixMul weights as int8 or int4"),
+        cl::value_desc("int8|int4"));
+cl::opt<int> WeightQuantGroup(
+        "weight_quant_group", cl::init(32),
+        cl::desc("the number of weights sharing a scale along K"));
+cl::opt<bool> EnableFp16Storage(
+        "enable_fp16_storage",
+        cl::desc("store the activations of the insensitive oprs as fp16"));
+cl::opt<std::string> Fp16CalibData(
+        "fp16_calib_data", cl::Optional,
+        cl::desc("raw binary calibration inputs to select the fp16 oprs"),
+        cl::value_desc("name0=file0;name1=file1:name0=file2;name1=file3"));
+cl::opt<float> Fp16ErrorBudget(
+        "fp16_error_budget", cl::init(1e-3f),
+        cl::desc("the max relative error of the outputs with fp16 storage"));
 cl::opt<bool> Enable_convbias_fusez(
         "enable_convbias_fusez", cl::desc("enable convbias_fusez trans"));
 cl::opt<bool> EnableIoc16("enable_ioc16", cl::desc("enable ioc16 trans"));
@@ -39,6 +65,13 @@ int main(int argc, char** argv) {
     options.enable_nchw44 = Enable_nchw44;
     options.enable_nchw44_dot = Enable_nchw44_dot;
     options.add_nhwc2nchw_to_input = Add_nhwc2nchw_to_input;
+    options.input_uint8 = InputUint8;
+    options.quantize_fake_quant = QuantizeFakeQuant;
+    options.weight_quant = WeightQuant;
+    options.weight_quant_group = WeightQuantGroup;
+    options.enable_fp16_storage = EnableFp16Storage;
+    options.fp16_calib_data = Fp16CalibData;
+    options.fp16_error_budget = Fp16ErrorBudget;
     options.enable_fuse_conv_bias_nonlinearity_z = Enable_convbias_fusez;
     options.enable_ioc16 = EnableIoc16;
     options.enable_nchw88 = EnableNchw88;
@@ -46,6 +79,11 @@ int main(int argc, char** argv) {
         CC_ABORT << "parseInputShapes error\n";
         return -1;
     }
+    if (failed(parseInputNormalize(
+                InputMean.getValue(), InputStd.getValue(), options))) {
+        CC_ABORT << "parseInputNormalize error\n";
+        return -1;
+    }
     llvm::SmallVector<llvm::StringRef> names;
     llvm::SplitString(OutputFile, names, ".");
     options.module_name = names[0].str();
@@ -45,9 +45,51 @@ cl::opt<bool> Verbose(
 cl::opt<bool> EnableNchw44("enable_nchw44", cl::desc("enable nchw44 trans"));
 cl::opt<bool> EnableNchw44Dot("enable_nchw44_dot", cl::desc("enable nchw44-dot trans"));
 cl::opt<bool> MGBFuseKernel("mgb_fuse_kernel", cl::desc("fuse mgb kernel as possible"));
+cl::opt<bool> MGBGraphOpt(
+        "mgb_graph_opt", cl::init(true),
+        cl::desc("fold the constants, the affine and the layout oprs and fuse the "
+                 "parallel oprs of the mgb graph, default true, disable it by "
+                 "--mgb_graph_opt=false"));
 cl::opt<bool> SaveModel("save-model", cl::desc("save model to c"));
 cl::opt<bool> Add_nhwc2nchw_to_input(
         "add_nhwc2nchw_to_input", cl::desc("add nhwc2nchw dimshuffle to input"));
+cl::opt<std::string> InputMean(
+        "input-mean", cl::Optional,
+        cl::desc("per channel mean of the 4-dim inputs, folded into the first "
+                 "convolution"),
+        cl::value_desc("mean0,mean1,mean2"));
+cl::opt<std::string> InputStd(
+        "input-std", cl::Optional,
+        cl::desc("per channel std of the 4-dim inputs, folded into the first "
+                 "convolution"),
+        cl::value_desc("std0,std1,std2"));
+cl::opt<bool> InputUint8(
+        "input_uint8", cl::desc("feed the 4-dim float inputs as uint8"));
+cl::opt<bool> QuantizeFakeQuant(
+        "quantize_fake_quant",
+        cl::desc("convert the float convolutions of a QAT model with FakeQuant to "
+                 "int8 with per output channel filter scales"));
+cl::opt<std::string> WeightQuant(
+        "weight_quant", cl::Optional,
+        cl::desc("store the MatrixMul weights as int8 or int4 with per group "
+                 "scales, dequantized in the kernels"),
+        cl::value_desc("int8|int4"));
+cl::opt<int> WeightQuantGroup(
+        "weight_quant_group", cl::init(32),
+        cl::desc("the number of MatrixMul weights sharing a scale along K"));
+cl::opt<bool> EnableFp16Storage(
+        "enable_fp16_storage",
+        cl::desc("store the activations of the precision insensitive oprs as fp16, "
+                 "the others and the first and the last convolution stay in fp32"));
+cl::opt<std::string> Fp16CalibData(
+        "fp16_calib_data", cl::Optional,
+        cl::desc("raw binary calibration inputs to select the fp16 oprs within "
+                 "fp16_error_budget"),
+        cl::value_desc("name0=file0;name1=file1:name0=file2;name1=file3"));
+cl::opt<float> Fp16ErrorBudget(
+        "fp16_error_budget", cl::init(1e-3f),
+        cl::desc("the max relative l2 error of the outputs on the calibration "
+                 "inputs with fp16 storage"));
 
 cl::opt<std::string> JsonFile(
         "json", cl::Optional, cl::desc("config app by json"),
@@ -114,6 +156,30 @@ public:
                 GenKerns::CVGaussianBlur, 2, {{"border_mode", "REFLECT"}}};
         m_name2gen["gaussian_blur_reflect_101"] = {
                 GenKerns::CVGaussianBlur, 2, {{"border_mode", "REFLECT_101"}}};
+        m_name2gen["sep_filter_constant"] = {
+                GenKerns::CVSepFilterKernel, 2, {{"border_mode", "CONSTANT"}}};
+        m_name2gen["sep_filter_replicate"] = {
+                GenKerns::CVSepFilterKernel, 2, {{"border_mode", "REPLICATE"}}};
+        m_name2gen["sep_filter_reflect"] = {
+                GenKerns::CVSepFilterKernel, 2, {{"border_mode", "REFLECT"}}};
+        m_name2gen["sep_filter_reflect_101"] = {
+                GenKerns::CVSepFilterKernel, 2, {{"border_mode", "REFLECT_101"}}};
+        m_name2gen["preprocess_bgr_nchw"] = {
+                GenKerns::CVPreprocessKernel,
+                2,
+                {{"src_format", "BGR"}, {"dst_format", "NCHW"}}};
+        m_name2gen["preprocess_bgr_nchw44"] = {
+                GenKerns::CVPreprocessKernel,
+                2,
+                {{"src_format", "BGR"}, {"dst_format", "NCHW44"}}};
+        m_name2gen["preprocess_nv21_nchw"] = {
+                GenKerns::CVPreprocessKernel,
+                2,
+                {{"src_format", "NV21"}, {"dst_format", "NCHW"}}};
+        m_name2gen["preprocess_nv21_nchw44"] = {
+                GenKerns::CVPreprocessKernel,
+                2,
+                {{"src_format", "NV21"}, {"dst_format", "NCHW44"}}};
     }
 
     Kerns get_kerns(const std::string& cv_name, megcc::KernelGen::Arch arch) {
@@ -167,6 +233,43 @@ struct DumpJson {
                     "[Optional], modify the input shape",
                     "data=(1,1,384,288):data=(1,1,288,384)");
 
+            str_options["input_mean"] = "";
+            str_options_template["input_mean"] = std::make_pair(
+                    "[Optional], per channel mean of the 4-dim inputs, the input "
+                    "normalize (x - mean) / std is folded into the first convolution",
+                    "123.675,116.28,103.53");
+
+            str_options["input_std"] = "";
+            str_options_template["input_std"] = std::make_pair(
+                    "[Optional], per channel std of the 4-dim inputs, must be given "
+                    "with input_mean",
+                    "58.395,57.12,57.375");
+
+            str_options["weight_quant"] = "";
+            str_options_template["weight_quant"] = std::make_pair(
+                    "[Optional], store the MatrixMul weights as int8 or int4 with "
+                    "per group scales, dequantized in the kernels",
+                    "int8");
+
+            str_options["weight_quant_group"] = "32";
+            str_options_template["weight_quant_group"] = std::make_pair(
+                    "[Optional], the number of MatrixMul weights sharing a scale "
+                    "along K, default 32",
+                    "32");
+
+            str_options["fp16_calib_data"] = "";
+            str_options_template["fp16_calib_data"] = std::make_pair(
+                    "[Optional], raw binary calibration inputs to select the fp16 "
+                    "oprs of enable_fp16_storage within fp16_error_budget, every "
+                    "group separated by colon is an input set",
+                    "data=calib0.bin:data=calib1.bin");
+
+            str_options["fp16_error_budget"] = "0.001";
+            str_options_template["fp16_error_budget"] = std::make_pair(
+                    "[Optional], the max relative l2 error of the outputs on the "
+                    "calibration inputs with fp16 storage, default 0.001",
+                    "0.001");
+
             str_options["extern_opr_output_shape"] = "";
             str_options_template["extern_opr_output_shape"] = std::make_pair(
                     "[Optional], specific extern opr output shapes",
@@ -207,10 +310,36 @@ struct DumpJson {
             bool_options_template["add_nhwc2nchw_to_input"] = std::make_pair(
                     "[Optional], add nhwc2nchw dimshuffle to input", false);
 
+            bool_options["input_uint8"] = false;
+            bool_options_template["input_uint8"] = std::make_pair(
+                    "[Optional], feed the 4-dim float inputs as uint8, the conversion "
+                    "to float is done in the model",
+                    false);
+
+            bool_options["quantize_fake_quant"] = false;
+            bool_options_template["quantize_fake_quant"] = std::make_pair(
+                    "[Optional], convert the float convolutions of a QAT model with "
+                    "FakeQuant to int8, the filters keep their per output channel "
+                    "scales",
+                    false);
+
+            bool_options["enable_fp16_storage"] = false;
+            bool_options_template["enable_fp16_storage"] = std::make_pair(
+                    "[Optional], store the activations of the precision insensitive "
+                    "oprs as fp16 with fp32 accumulation, the others and the first "
+                    "and the last convolution stay in fp32",
+                    false);
+
             bool_options["mgb_fuse_kernel"] = false;
             bool_options_template["mgb_fuse_kernel"] =
                     std::make_pair("[Optional], fuse mgb kernel as possible", false);
 
+            bool_options["mgb_graph_opt"] = true;
+            bool_options_template["mgb_graph_opt"] = std::make_pair(
+                    "[Optional], fold the constants, the affine and the layout oprs "
+                    "and fuse the parallel oprs of the mgb graph, default true",
+                    true);
+
             bool_options["enable_compress_fp16"] = false;
             bool_options_template["enable_compress_fp16"] = std::make_pair(
                     "[Optional], whether to enable the optimization of using float16 "
@@ -355,11 +484,20 @@ struct DumpJson {
         auto&& cv_names = DumpCVHelper().get_all_cv_name();
         for (auto&& cv_name : cv_names) {
             auto cv_opr_dtype = llvm::json::Array();
+            //! the dtype of preprocess is the output dtype, the input is always ui8
+            if (cv_name.find("preprocess") != std::string::npos) {
+                cv_opr_dtype.push_back(llvm::json::Value("f32"));
+                cv_opr_dtype.push_back(llvm::json::Value("i8"));
+                cv_oprs[cv_name] =
+                        llvm::json::Value(llvm::json::Value(std::move(cv_opr_dtype)));
+                continue;
+            }
             cv_opr_dtype.push_back(llvm::json::Value("ui8"));
             //! TODO: Automatically determine if dtype float32 is supported. Hard code
             //! for now.
             if (cv_name.find("resize") != std::string::npos ||
                 cv_name.find("gaussian_blur") != std::string::npos ||
+                cv_name.find("sep_filter") != std::string::npos ||
                 cv_name.find("gray2rgb") != std::string::npos)
                 cv_opr_dtype.push_back(llvm::json::Value("f32"));
             cv_oprs[cv_name] =
@@ -492,7 +630,19 @@ int main(int argc, char** argv) {
         model_json.bool_options["enable_nchw44_dot"] = EnableNchw44Dot.getValue();
         model_json.bool_options["add_nhwc2nchw_to_input"] =
                 Add_nhwc2nchw_to_input.getValue();
+        model_json.str_options["input_mean"] = InputMean.getValue();
+        model_json.str_options["input_std"] = InputStd.getValue();
+        model_json.bool_options["input_uint8"] = InputUint8.getValue();
+        model_json.bool_options["quantize_fake_quant"] = QuantizeFakeQuant.getValue();
+        model_json.str_options["weight_quant"] = WeightQuant.getValue();
+        model_json.str_options["weight_quant_group"] =
+                std::to_string(WeightQuantGroup.getValue());
+        model_json.bool_options["enable_fp16_storage"] = EnableFp16Storage.getValue();
+        model_json.str_options["fp16_calib_data"] = Fp16CalibData.getValue();
+        model_json.str_options["fp16_error_budget"] =
+                std::to_string(Fp16ErrorBudget.getValue());
         model_json.bool_options["mgb_fuse_kernel"] = MGBFuseKernel.getValue();
+        model_json.bool_options["mgb_graph_opt"] = MGBGraphOpt.getValue();
         model_json.bool_options["enable_compress_fp16"] =
                 EnableCompressWeightToFp16.getValue();
         model_json.bool_options["enable_nchw88"] = EnableNchw88.getValue();
@@ -551,6 +701,15 @@ int main(int argc, char** argv) {
             options.enable_nchw44_dot = model.bool_options.at("enable_nchw44_dot");
             options.add_nhwc2nchw_to_input =
                     model.bool_options.at("add_nhwc2nchw_to_input");
+            options.input_uint8 = model.bool_options.at("input_uint8");
+            options.quantize_fake_quant = model.bool_options.at("quantize_fake_quant");
+            options.weight_quant = model.str_options.at("weight_quant");
+            options.weight_quant_group =
+                    std::stoi(model.str_options.at("weight_quant_group"));
+            options.enable_fp16_storage = model.bool_options.at("enable_fp16_storage");
+            options.fp16_calib_data = model.str_options.at("fp16_calib_data");
+            options.fp16_error_budget =
+                    std::stof(model.str_options.at("fp16_error_budget"));
             options.enable_nchw88 = model.bool_options.at("enable_nchw88");
             options.enable_ioc16 = model.bool_options.at("enable_ioc16");
             options.extern_opr_output_shape =
@@ -562,11 +721,17 @@ int main(int argc, char** argv) {
             options.extern_opr_loader_path_with_interface =
                     model.str_options.at("extern_opr_loader_path_with_interface");
             bool model_mgb_fuse_kernel = model.bool_options.at("mgb_fuse_kernel");
+            bool model_mgb_graph_opt = model.bool_options.at("mgb_graph_opt");
 
             if (failed(parseInputShapes(
                         model.str_options["input_shape_str"], options))) {
                 return -1;
             }
+            if (failed(parseInputNormalize(
+                        model.str_options.at("input_mean"),
+                        model.str_options.at("input_std"), options))) {
+                return -1;
+            }
             auto model_name = model.str_options.at("model_name");
             if (model_name.size() > 0) {
                 options.module_name = model_name;
@@ -589,9 +754,20 @@ int main(int argc, char** argv) {
                 return -1;
             }
             mlir::PassManager pm(&ctx);
+            if (model_mgb_graph_opt) {
+                pm.addPass(mlir::createMGBConstantFoldPass());
+                pm.addPass(mlir::createMGBAffineFoldPass());
+                pm.addNestedPass<mlir::FuncOp>(mlir::createMGBRelayoutFoldPass());
+            }
             if (model_mgb_fuse_kernel) {
                 pm.addNestedPass<mlir::FuncOp>(mlir::createMGBFuseKernelPass());
             }
+            //! the horizontal fusion splits the conv results with Subtensor,
+            //! which breaks the conv patterns of the kernel fusion, such as
+            //! conv -> TypeCvt -> H_SWISH -> TypeCvt, so it runs after that
+            if (model_mgb_graph_opt) {
+                pm.addPass(mlir::createMGBHorizontalFusePass());
+            }
             pm.addPass(mlir::createMGBToKernelPass());
             pm.addNestedPass<mlir::FuncOp>(mlir::createMemoryForwardingPass());
             pm.addPass(mlir::createKernelMaterializationPass());
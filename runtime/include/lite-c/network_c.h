@@ -489,6 +489,17 @@ LITE_API int LITE_set_memory_allocator(
 LITE_API int LITE_share_runtime_memroy(
         LiteNetwork src_network, LiteNetwork dst_network);
 
+/**
+ * \brief get the memory used by the loaded network
+ * \param[in] network The loaded model
+ * \param[out] tensor_memory The size in bytes of the runtime tensor memory
+ * shared by all the tensors, it is allocated at the first forward
+ * \param[out] weight_memory The size in bytes of the weights, including the
+ * weights produced by the weight preprocess
+ */
+LITE_API int LITE_get_network_memory_usage(
+        const LiteNetwork network, size_t* tensor_memory, size_t* weight_memory);
+
 /**
  * \brief enable profile the network, a JSON format file will be generated
  * \param[in] network The loaded model
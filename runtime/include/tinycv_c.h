@@ -18,6 +18,28 @@ typedef struct TinyMat {
     void* data;
 } TinyMat;
 
+/*!
+ * \brief the param of the fused preprocess
+ *
+ * The source is resized to resize_rows x resize_cols and placed at (top, left)
+ * of dst, the rest of dst is the letterbox border filled with pad_value.
+ * mean and std are in dst channel order and the output is
+ * (x - mean) / std, int8 output is further divided by dst_scale.
+ */
+typedef struct TinyPreprocessParam {
+    size_t resize_rows;
+    size_t resize_cols;
+    size_t top;
+    size_t left;
+    uint8_t pad_value;
+    float mean[3];
+    float std[3];
+    //! output RGB instead of BGR
+    bool swap_rb;
+    //! quantization scale of int8 output, unused by float output
+    float dst_scale;
+} TinyPreprocessParam;
+
 /**
  * \fn tinycv_transpose_ui8
  * \brief Transpose image.
@@ -220,6 +242,121 @@ void tinycv_gaussian_blur_replicate_f32(
         const TinyMat* src, const TinyMat* dst, int kernel_h, int kernel_w,
         double sigma_x, double sigma_y);
 
+/**
+ * \fn tinycv_sep_filter_constant_ui8
+ * \brief Separable filter on src and store to dst, the row is filtered by kx
+ * and then the column by ky, both kernels are anchored at the center. A box
+ * filter is kx and ky filled with 1 / ksize.
+ *
+ *  boarder type constant  `000000|abcdefgh|000000`
+ *
+ * \param[in] src Input mat ptr.
+ * \param[out] dst Ouput mat ptr.
+ * \param[in] kx Float horizontal kernel of 1 x ksize_w x 1.
+ * \param[in] ky Float vertical kernel of 1 x ksize_h x 1.
+ */
+void tinycv_sep_filter_constant_ui8(
+        const TinyMat* src, const TinyMat* dst, const TinyMat* kx, const TinyMat* ky);
+
+void tinycv_sep_filter_constant_f32(
+        const TinyMat* src, const TinyMat* dst, const TinyMat* kx, const TinyMat* ky);
+
+/**
+ * \fn tinycv_sep_filter_reflect_ui8
+ * \brief Separable filter on src and store to dst, the row is filtered by kx
+ * and then the column by ky, both kernels are anchored at the center. A box
+ * filter is kx and ky filled with 1 / ksize.
+ *
+ *  boarder type reflect  `hgfedcba|abcdefgh|hgfedcba`
+ *
+ * \param[in] src Input mat ptr.
+ * \param[out] dst Ouput mat ptr.
+ * \param[in] kx Float horizontal kernel of 1 x ksize_w x 1.
+ * \param[in] ky Float vertical kernel of 1 x ksize_h x 1.
+ */
+void tinycv_sep_filter_reflect_ui8(
+        const TinyMat* src, const TinyMat* dst, const TinyMat* kx, const TinyMat* ky);
+
+void tinycv_sep_filter_reflect_f32(
+        const TinyMat* src, const TinyMat* dst, const TinyMat* kx, const TinyMat* ky);
+
+/**
+ * \fn tinycv_sep_filter_reflect_101_ui8
+ * \brief Separable filter on src and store to dst, the row is filtered by kx
+ * and then the column by ky, both kernels are anchored at the center. A box
+ * filter is kx and ky filled with 1 / ksize.
+ *
+ *  boarder type reflect_101  `hgfedcb|abcdefgh|gfedcba`
+ *
+ * \param[in] src Input mat ptr.
+ * \param[out] dst Ouput mat ptr.
+ * \param[in] kx Float horizontal kernel of 1 x ksize_w x 1.
+ * \param[in] ky Float vertical kernel of 1 x ksize_h x 1.
+ */
+void tinycv_sep_filter_reflect_101_ui8(
+        const TinyMat* src, const TinyMat* dst, const TinyMat* kx, const TinyMat* ky);
+
+void tinycv_sep_filter_reflect_101_f32(
+        const TinyMat* src, const TinyMat* dst, const TinyMat* kx, const TinyMat* ky);
+
+/**
+ * \fn tinycv_sep_filter_replicate_ui8
+ * \brief Separable filter on src and store to dst, the row is filtered by kx
+ * and then the column by ky, both kernels are anchored at the center. A box
+ * filter is kx and ky filled with 1 / ksize.
+ *
+ *  boarder type replicate  `aaaaaaa|abcdefgh|hhhhhhhh`
+ *
+ * \param[in] src Input mat ptr.
+ * \param[out] dst Ouput mat ptr.
+ * \param[in] kx Float horizontal kernel of 1 x ksize_w x 1.
+ * \param[in] ky Float vertical kernel of 1 x ksize_h x 1.
+ */
+void tinycv_sep_filter_replicate_ui8(
+        const TinyMat* src, const TinyMat* dst, const TinyMat* kx, const TinyMat* ky);
+
+void tinycv_sep_filter_replicate_f32(
+        const TinyMat* src, const TinyMat* dst, const TinyMat* kx, const TinyMat* ky);
+
+/**
+ * \fn tinycv_preprocess_bgr_nchw_f32
+ * \brief Letterbox resize, color convert, normalize and relayout an image to
+ * the network input in one pass. The interpolation mode is linear.
+ *
+ * src is an uint8 BGR image, or a NV21 image of (rows * 3 / 2) x cols x 1 for
+ * the nv21 variants. dst is the network input of rows x cols with 3 channels,
+ * in NCHW layout or NCHW44 layout with the 4th channel zeroed.
+ *
+ * \param[in] src Input mat ptr.
+ * \param[out] dst Output mat ptr.
+ * \param[in] param The preprocess param.
+ *
+ * \warning The resized region must be inside dst.
+ */
+void tinycv_preprocess_bgr_nchw_f32(
+        const TinyMat* src, const TinyMat* dst, const TinyPreprocessParam* param);
+
+void tinycv_preprocess_bgr_nchw44_f32(
+        const TinyMat* src, const TinyMat* dst, const TinyPreprocessParam* param);
+
+void tinycv_preprocess_nv21_nchw_f32(
+        const TinyMat* src, const TinyMat* dst, const TinyPreprocessParam* param);
+
+void tinycv_preprocess_nv21_nchw44_f32(
+        const TinyMat* src, const TinyMat* dst, const TinyPreprocessParam* param);
+
+void tinycv_preprocess_bgr_nchw_i8(
+        const TinyMat* src, const TinyMat* dst, const TinyPreprocessParam* param);
+
+void tinycv_preprocess_bgr_nchw44_i8(
+        const TinyMat* src, const TinyMat* dst, const TinyPreprocessParam* param);
+
+void tinycv_preprocess_nv21_nchw_i8(
+        const TinyMat* src, const TinyMat* dst, const TinyPreprocessParam* param);
+
+void tinycv_preprocess_nv21_nchw44_i8(
+        const TinyMat* src, const TinyMat* dst, const TinyPreprocessParam* param);
+
 #ifdef __cplusplus
 }
 #endif
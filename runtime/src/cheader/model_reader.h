@@ -663,6 +663,7 @@ __flatbuffers_table_as_root(MegCC_DTypeParam)
 
 __flatbuffers_define_scalar_field(0, MegCC_DTypeParam, scale, flatbuffers_float, float, 1.00000000f)
 __flatbuffers_define_scalar_field(1, MegCC_DTypeParam, zero_point, flatbuffers_uint8, uint8_t, UINT8_C(0))
+__flatbuffers_define_vector_field(2, MegCC_DTypeParam, scales, flatbuffers_float_vec_t, 0)
 
 struct MegCC_DType_table { uint8_t unused__; };
 
@@ -807,6 +808,8 @@ __flatbuffers_define_vector_field(0, MegCC_BroadCast, inputs, flatbuffers_int32_
 /**  input tensor type */
 __flatbuffers_define_vector_field(1, MegCC_BroadCast, input_types, MegCC_TensorType_vec_t, 0)
 __flatbuffers_define_scalar_field(2, MegCC_BroadCast, output, flatbuffers_int32, int32_t, INT32_C(0))
+/**  if true, the output is a stride 0 view of the input, no data is copied */
+__flatbuffers_define_scalar_field(3, MegCC_BroadCast, as_view, flatbuffers_bool, flatbuffers_bool_t, UINT8_C(0))
 
 struct MegCC_Reshape_table { uint8_t unused__; };
 
@@ -949,6 +952,9 @@ __flatbuffers_define_vector_field(1, MegCC_SetSubTensor, flags, MegCC_IndexDesc_
 __flatbuffers_define_vector_field(2, MegCC_SetSubTensor, inputs, flatbuffers_int32_vec_t, 0)
 __flatbuffers_define_vector_field(3, MegCC_SetSubTensor, input_types, MegCC_TensorType_vec_t, 0)
 __flatbuffers_define_scalar_field(4, MegCC_SetSubTensor, output, flatbuffers_int32, int32_t, INT32_C(0))
+/**  if true, the src tensor is not used after this instruction, the value
+ *  is written into the src memory which becomes the output */
+__flatbuffers_define_scalar_field(5, MegCC_SetSubTensor, in_place, flatbuffers_bool, flatbuffers_bool_t, UINT8_C(0))
 
 struct MegCC_WarpPerspective_table { uint8_t unused__; };
 
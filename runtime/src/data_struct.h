@@ -12,6 +12,10 @@ struct Instruction;
 typedef struct {
     float scale;
     uint8_t zero_point;
+    //! the per output channel scales of the quantized weights, NULL for the
+    //! per tensor quantization
+    int nr_scale;
+    float* scales;
 } DTypeParam;
 
 typedef struct {
@@ -114,6 +118,9 @@ typedef struct {
     struct ComboIOTensorS* combo_iotensor;
     //! make CombineModel(always user network) bind with vm
     void* vm;
+    //! the kernel profile result file written when destroy the network, only
+    //! used with TINYNN_PROFILE_KERNEL
+    char* profile_file;
 } CombineModel;
 
 typedef struct ComboIOTensorS {
@@ -206,7 +206,7 @@ int LITE_forward(const LiteNetwork network) {
             LOG_INFO(
                     " instruction: %s \nuse %fms \t"
                     "[%d(%d), %d(%d), %d(%d), %d(%d), %d(%d)] \t"
-                    "[%d(%d), %d(%d), %d(%d), %d(%d), %d(%d)]\n",
+                    "[%d(%d), %d(%d), %d(%d), %d(%d), %d(%d)] \t%s\n",
                     opr->type, inst->time_ms / inst->time_count, in_layout.dims[0],
                     in_layout.stride[0], in_layout.dims[1], in_layout.stride[1],
                     in_layout.dims[2], in_layout.stride[2], in_layout.dims[3],
@@ -214,7 +214,7 @@ int LITE_forward(const LiteNetwork network) {
                     out_layout.dims[0], out_layout.stride[0], out_layout.dims[1],
                     out_layout.stride[1], out_layout.dims[2], out_layout.stride[2],
                     out_layout.dims[3], out_layout.stride[3], out_layout.dims[4],
-                    out_layout.stride[4]);
+                    out_layout.stride[4], opr->name ? opr->name : "");
 
         } else {
             LOG_INFO(
@@ -302,17 +302,132 @@ int LITE_share_runtime_memroy(LiteNetwork src_network, LiteNetwork dst_network)
     return TinyNN_SUCCESS;
 }
 
+#if TINYNN_PROFILE_KERNEL
+static void write_layout_json(FILE* fout, const Layout* layout) {
+    char buffer[128];
+    int len = snprintf(buffer, sizeof(buffer), "[");
+    for (int i = 0; i < layout->nr_dim; ++i) {
+        len += snprintf(
+                buffer + len, sizeof(buffer) - len, "%s%d", i ? ", " : "",
+                layout->dims[i]);
+    }
+    len += snprintf(buffer + len, sizeof(buffer) - len, "]");
+    tinynn_fwrite(buffer, 1, len, fout);
+}
+
+//! write the average time of every kernel instruction as JSON, the name is
+//! the operator name in the origin model
+static void dump_profile(CombineModel* cb_model) {
+    FILE* fout = tinynn_fopen(cb_model->profile_file, "w");
+    if (!fout) {
+        LOG_ERROR("open profile file %s failed\n", cb_model->profile_file);
+        return;
+    }
+    DeviceModel* model = get_active_device_model(cb_model);
+    char buffer[1024];
+    int len = snprintf(buffer, sizeof(buffer), "{\n    \"oprs\": [");
+    tinynn_fwrite(buffer, 1, len, fout);
+    int nr_dumped = 0;
+    for (int i = 0; i < model->nr_instruction; i++) {
+        Instruction* inst = model->instructions + i;
+        if (inst->tag != TinyNN_INST_OPR || inst->time_count == 0) {
+            continue;
+        }
+        Opr* opr = &inst->workload.opr;
+        len = snprintf(
+                buffer, sizeof(buffer),
+                "%s\n        {\"name\": \"%s\", \"type\": \"%s\", "
+                "\"time_ms\": %f, \"count\": %d, \"inputs\": [",
+                nr_dumped ? "," : "", opr->name ? opr->name : "", opr->type,
+                inst->time_ms / inst->time_count, inst->time_count);
+        tinynn_fwrite(buffer, 1, len, fout);
+        for (int j = 0; j < opr->nr_input; ++j) {
+            if (j) {
+                tinynn_fwrite(", ", 1, 2, fout);
+            }
+            write_layout_json(fout, &opr->inputs[j]->layout);
+        }
+        tinynn_fwrite("], \"outputs\": [", 1, 15, fout);
+        for (int j = 0; j < opr->nr_output; ++j) {
+            if (j) {
+                tinynn_fwrite(", ", 1, 2, fout);
+            }
+            write_layout_json(fout, &opr->outputs[j]->layout);
+        }
+        tinynn_fwrite("]}", 1, 2, fout);
+        nr_dumped++;
+    }
+    tinynn_fwrite("\n    ]\n}\n", 1, 9, fout);
+    tinynn_fclose(fout);
+}
+#endif
+
+int LITE_enable_profile_performance(
+        LiteNetwork network, const char* profile_json_file_path) {
+    if (!network || !profile_json_file_path) {
+        LOG_ERROR("input pointer is NULL\n");
+        return TinyNN_ERROR_NULL_PTR;
+    }
+#if TINYNN_PROFILE_KERNEL
+    CombineModel* cb_model = (CombineModel*)network;
+    FREE(cb_model->profile_file);
+    cb_model->profile_file = get_string(profile_json_file_path);
+    return TinyNN_SUCCESS;
+#else
+    LOG_ERROR("profile performance needs runtime built with TINYNN_PROFILE_KERNEL\n");
+    return TinyNN_ERROR_NO_IMPLEMENT;
+#endif
+}
+
+int LITE_get_network_memory_usage(
+        const LiteNetwork network, size_t* tensor_memory, size_t* weight_memory) {
+    if (!network || !tensor_memory || !weight_memory) {
+        LOG_ERROR("input pointer is NULL\n");
+        return TinyNN_ERROR_NULL_PTR;
+    }
+    CombineModel* cb_model = (CombineModel*)network;
+    *tensor_memory = cb_model->max_tensor_memroy
+                           ? cb_model->max_tensor_memroy->length_in_byte
+                           : 0;
+    size_t weight_size = 0;
+    for (int i = 0; i < cb_model->nr_origin_weight; i++) {
+        Tensor* weight = cb_model->weights + i;
+        //! the weights without user are freed after the weight preprocess
+        if (weight->use_count > 0) {
+            weight_size += weight->size;
+        }
+    }
+    for (int model_idx = 0; model_idx < cb_model->nr_device_model; ++model_idx) {
+        DeviceModel* model = cb_model->device_models[model_idx];
+        for (int i = 0; i < model->nr_processed_weight; i++) {
+            Tensor* weight = model->processed_weights + i;
+            if (!weight->is_shared) {
+                weight_size += weight->size;
+            }
+        }
+    }
+    *weight_memory = weight_size;
+    return TinyNN_SUCCESS;
+}
+
 int LITE_destroy_network(LiteNetwork network) {
     LOG_DEBUG("delete model\n");
     if (!network) {
         return TinyNN_ERROR_NULL_PTR;
     }
     CombineModel* cb_model = (CombineModel*)network;
+#if TINYNN_PROFILE_KERNEL
+    if (cb_model->profile_file) {
+        dump_profile(cb_model);
+    }
+#endif
+    FREE(cb_model->profile_file);
     FREE(cb_model->model_ptr);
     //! origin weight
     for (int i = 0; i < cb_model->nr_origin_weight; i++) {
         Tensor* weight = cb_model->weights + i;
         FREE(weight->name);
+        FREE(weight->dtype.param.scales);
         //! only the use count>0, the memory is not free
         if (weight->use_count > 0 && !weight->is_shared) {
             cb_model->host_dev.free(weight->ptr);
@@ -96,12 +96,23 @@ static TinyNNDevice device_from_fbs(ns(Device_enum_t) fbs_device) {
     tinynn_trap();
 }
 
-static DTypeParam dtype_param_from_fbs(ns(DType_table_t) fbs_dtype) {
-    DTypeParam param = {0.0f, 0};
+//! only the weights own the per channel scales, the tensors may share the
+//! dtype of the weights by memory forward
+static DTypeParam dtype_param_from_fbs(ns(DType_table_t) fbs_dtype, bool with_scales) {
+    DTypeParam param = {0.0f, 0, 0, NULL};
     if (ns(DType_param_is_present(fbs_dtype))) {
         ns(DTypeParam_table_t) fbs_param = ns(DType_param(fbs_dtype));
         param.scale = ns(DTypeParam_scale(fbs_param));
         param.zero_point = ns(DTypeParam_zero_point(fbs_param));
+        //! copy the scales, the model buffer may be freed after init
+        if (with_scales && ns(DTypeParam_scales_is_present(fbs_param))) {
+            flatbuffers_float_vec_t fbs_scales = ns(DTypeParam_scales(fbs_param));
+            param.nr_scale = flatbuffers_float_vec_len(fbs_scales);
+            param.scales = tinynn_malloc(param.nr_scale * sizeof(float));
+            for (int i = 0; i < param.nr_scale; i++) {
+                param.scales[i] = flatbuffers_float_vec_at(fbs_scales, i);
+            }
+        }
     }
     return param;
 }
@@ -111,7 +122,7 @@ TinyNNStatus parse_tensor(
     //! dtype
     ns(DType_table_t) fbs_dtype = ns(Tensor_dtype(fbs_tensor));
     tensor->dtype.type_enum = dtype_from_fbs(ns(DType_type(fbs_dtype)));
-    tensor->dtype.param = dtype_param_from_fbs(fbs_dtype);
+    tensor->dtype.param = dtype_param_from_fbs(fbs_dtype, false);
 
     //! name
     const char* name = ns(Tensor_name(fbs_tensor));
@@ -158,7 +169,7 @@ TinyNNStatus parse_weight(
     //! dtype
     ns(DType_table_t) fbs_dtype = ns(Weight_dtype(fbs_weight));
     weight->dtype.type_enum = dtype_from_fbs(ns(DType_type(fbs_dtype)));
-    weight->dtype.param = dtype_param_from_fbs(fbs_dtype);
+    weight->dtype.param = dtype_param_from_fbs(fbs_dtype, true);
 
     //! name
     weight->name = get_string(ns(Weight_name(fbs_weight)));
@@ -543,6 +554,8 @@ exit:
             }
             if (weight->name)
                 tinynn_free(weight->name);
+            if (weight->dtype.param.scales)
+                tinynn_free(weight->dtype.param.scales);
         }
         tinynn_free(model->weights);
     }
@@ -22,6 +22,7 @@ static TinyNNStatus load_broadcast(
             broadcast->inputs, nr_input, model, vm->model, fbs_inputs, fbs_input_types);
     int32_t output_idx = ns(BroadCast_output(fbs_broadcast));
     broadcast->output = model->tensors + output_idx;
+    broadcast->as_view = ns(BroadCast_as_view(fbs_broadcast));
     return TinyNN_SUCCESS;
 }
 
@@ -44,8 +45,6 @@ static TinyNNStatus execute_broadcast(Instruction* inst, VM* vm) {
         output->layout.stride[index] =
                 output->layout.dims[index + 1] * output->layout.stride[index + 1];
     }
-    //! alloc output
-    alloc_tensor(output, vm);
     //! broadcast input
     TINYNN_ASSERT_MSG(
             output->layout.nr_dim >= input.layout.nr_dim,
@@ -59,47 +58,25 @@ static TinyNNStatus execute_broadcast(Instruction* inst, VM* vm) {
         in_layout.stride[i] = 0;
     }
     for (; i < output->layout.nr_dim; i++) {
-        if (input.layout.dims[i] == 1 && output->layout.dims[i] != 1) {
+        if (input.layout.dims[i - dim_diff] == 1 && output->layout.dims[i] != 1) {
             in_layout.stride[i] = 0;
         } else {
             in_layout.stride[i] = input.layout.stride[i - dim_diff];
         }
         in_layout.dims[i] = output->layout.dims[i];
     }
-    input.layout = in_layout;
-
-    //! do broadcast copy
-    size_t nr_elem = 1;
-    for (int i = 0; i < output->layout.nr_dim; ++i) {
-        nr_elem *= output->layout.dims[i];
+    //! the output shares the input memory, the broadcast dims have stride 0
+    if (broadcast->as_view) {
+        output->layout = in_layout;
+        output->ptr = input.ptr;
+        return TinyNN_SUCCESS;
     }
-    NoconIter src_iter = init_iter(input.layout);
-    NoconIter dst_iter = init_iter(output->layout);
-    if (dtype_length((input).dtype.type_enum, NULL) == 1) {
-        char* dst_data = output->ptr;
-        char* src_data = input.ptr;
-        for (size_t i = 0; i < nr_elem; ++i) {
-            dst_data[dst_iter.offset] = src_data[src_iter.offset];
-            inc_iter(input.layout, &src_iter);
-            inc_iter(output->layout, &dst_iter);
-        }
-    } else if (dtype_length((input).dtype.type_enum, NULL) == 2) {
-        int16_t* dst_data = output->ptr;
-        int16_t* src_data = input.ptr;
-        for (size_t i = 0; i < nr_elem; ++i) {
-            dst_data[dst_iter.offset] = src_data[src_iter.offset];
-            inc_iter(input.layout, &src_iter);
-            inc_iter(output->layout, &dst_iter);
-        }
-    } else if (dtype_length(input.dtype.type_enum, NULL) == 4) {
-        int32_t* dst_data = output->ptr;
-        int32_t* src_data = input.ptr;
-        for (size_t i = 0; i < nr_elem; ++i) {
-            dst_data[dst_iter.offset] = src_data[src_iter.offset];
-            inc_iter(input.layout, &src_iter);
-            inc_iter(output->layout, &dst_iter);
-        }
-    } else {
+    //! alloc output
+    alloc_tensor(output, vm);
+    //! do broadcast copy
+    if (copy_tensor_data(
+                output->ptr, output->layout, input.ptr, in_layout,
+                dtype_length(input.dtype.type_enum, NULL)) != TinyNN_SUCCESS) {
         LOG_ERROR("unsupport dtype in broadcast.\n");
         return TinyNN_ERROR_UNSUPPORTED_DTYPE_TYPE;
     }
@@ -155,7 +132,9 @@ static TinyNNStatus execute_shape_of(Instruction* inst, VM* vm) {
 }
 
 static TinyNNStatus destruct_broadcast(VM* vm, Instruction* inst) {
-    if (inst->workload.broadcast.output->is_dynamic) {
+    //! the memory of a view is owned by the input
+    if (inst->workload.broadcast.output->is_dynamic &&
+        !inst->workload.broadcast.as_view) {
         DEV_FREE(inst->workload.broadcast.output->ptr, vm);
     }
     return TinyNN_SUCCESS;
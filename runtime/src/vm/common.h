@@ -59,6 +59,103 @@ static TinyNNStatus parase_inputs(
     return TinyNN_SUCCESS;
 }
 
+//! drop the dims of size 1 which do not move any pointer, keep at least 1 dim
+static inline Layout squeeze_layout(Layout layout) {
+    int nr_dim = 0;
+    for (int i = 0; i < layout.nr_dim; ++i) {
+        if (layout.dims[i] != 1) {
+            layout.dims[nr_dim] = layout.dims[i];
+            layout.stride[nr_dim] = layout.stride[i];
+            ++nr_dim;
+        }
+    }
+    if (nr_dim == 0) {
+        layout.dims[0] = 1;
+        layout.stride[0] = 1;
+        nr_dim = 1;
+    }
+    layout.nr_dim = nr_dim;
+    return layout;
+}
+
+//! copy the elements of src to dst in the order of their layouts, when both
+//! have the same dims the inner dims contiguous in both are merged into one
+//! run which is copied by memcpy, otherwise the elements are copied one by one
+static inline TinyNNStatus copy_tensor_data(
+        void* dst, Layout dst_layout, const void* src, Layout src_layout,
+        int elem_bytes) {
+    dst_layout = squeeze_layout(dst_layout);
+    src_layout = squeeze_layout(src_layout);
+    int nr_dim = dst_layout.nr_dim;
+    bool same_dims = src_layout.nr_dim == nr_dim;
+    for (int i = 0; same_dims && i < nr_dim; ++i) {
+        same_dims = src_layout.dims[i] == dst_layout.dims[i];
+    }
+    char* dst_data = (char*)dst;
+    const char* src_data = (const char*)src;
+    //! find the contiguous run
+    int run = 1;
+    int outer_dim = nr_dim;
+    while (same_dims && outer_dim > 0 && dst_layout.stride[outer_dim - 1] == run &&
+           src_layout.stride[outer_dim - 1] == run) {
+        run *= dst_layout.dims[--outer_dim];
+    }
+    if (run > 1) {
+        size_t run_bytes = (size_t)run * elem_bytes;
+        if (outer_dim == 0) {
+            memcpy(dst_data, src_data, run_bytes);
+            return TinyNN_SUCCESS;
+        }
+        size_t nr_run = 1;
+        for (int i = 0; i < outer_dim; ++i) {
+            nr_run *= dst_layout.dims[i];
+        }
+        dst_layout.nr_dim = outer_dim;
+        src_layout.nr_dim = outer_dim;
+        NoconIter src_iter = init_iter(src_layout);
+        NoconIter dst_iter = init_iter(dst_layout);
+        for (size_t i = 0; i < nr_run; ++i) {
+            memcpy(dst_data + (ptrdiff_t)dst_iter.offset * elem_bytes,
+                   src_data + (ptrdiff_t)src_iter.offset * elem_bytes, run_bytes);
+            inc_iter(src_layout, &src_iter);
+            inc_iter(dst_layout, &dst_iter);
+        }
+        return TinyNN_SUCCESS;
+    }
+    size_t nr_elem = 1;
+    for (int i = 0; i < nr_dim; ++i) {
+        nr_elem *= dst_layout.dims[i];
+    }
+    NoconIter src_iter = init_iter(src_layout);
+    NoconIter dst_iter = init_iter(dst_layout);
+    if (elem_bytes == 1) {
+        for (size_t i = 0; i < nr_elem; ++i) {
+            dst_data[dst_iter.offset] = src_data[src_iter.offset];
+            inc_iter(src_layout, &src_iter);
+            inc_iter(dst_layout, &dst_iter);
+        }
+    } else if (elem_bytes == 2) {
+        int16_t* dst_ptr = (int16_t*)dst;
+        const int16_t* src_ptr = (const int16_t*)src;
+        for (size_t i = 0; i < nr_elem; ++i) {
+            dst_ptr[dst_iter.offset] = src_ptr[src_iter.offset];
+            inc_iter(src_layout, &src_iter);
+            inc_iter(dst_layout, &dst_iter);
+        }
+    } else if (elem_bytes == 4) {
+        int32_t* dst_ptr = (int32_t*)dst;
+        const int32_t* src_ptr = (const int32_t*)src;
+        for (size_t i = 0; i < nr_elem; ++i) {
+            dst_ptr[dst_iter.offset] = src_ptr[src_iter.offset];
+            inc_iter(src_layout, &src_iter);
+            inc_iter(dst_layout, &dst_iter);
+        }
+    } else {
+        return TinyNN_ERROR_UNSUPPORTED_DTYPE_TYPE;
+    }
+    return TinyNN_SUCCESS;
+}
+
 static inline void print_tensor_layout(Layout layout) {
     LOG_DEBUG_NO_PREFIX("layout is [");
     for (int i = 0; i < layout.nr_dim; ++i) {
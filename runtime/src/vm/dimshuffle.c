@@ -51,38 +51,10 @@ static TinyNNStatus execute(Instruction* inst, VM* vm) {
                 output->layout.dims[index + 1] * output->layout.stride[index + 1];
     }
     alloc_tensor(output, vm);
-    //! do dimshuffle naive
-    size_t nr_elem = 1;
-    for (int i = 0; i < output->layout.nr_dim; ++i) {
-        nr_elem *= output->layout.dims[i];
-    }
-    NoconIter src_iter = init_iter(input.layout);
-    NoconIter dst_iter = init_iter(output->layout);
-    if (dtype_length((input).dtype.type_enum, NULL) == 1) {
-        char* dst_data = output->ptr;
-        char* src_data = input.ptr;
-        for (size_t i = 0; i < nr_elem; ++i) {
-            dst_data[dst_iter.offset] = src_data[src_iter.offset];
-            inc_iter(input.layout, &src_iter);
-            inc_iter(output->layout, &dst_iter);
-        }
-    } else if (dtype_length((input).dtype.type_enum, NULL) == 2) {
-        int16_t* dst_data = output->ptr;
-        int16_t* src_data = input.ptr;
-        for (size_t i = 0; i < nr_elem; ++i) {
-            dst_data[dst_iter.offset] = src_data[src_iter.offset];
-            inc_iter(input.layout, &src_iter);
-            inc_iter(output->layout, &dst_iter);
-        }
-    } else if (dtype_length(input.dtype.type_enum, NULL) == 4) {
-        int32_t* dst_data = output->ptr;
-        int32_t* src_data = input.ptr;
-        for (size_t i = 0; i < nr_elem; ++i) {
-            dst_data[dst_iter.offset] = src_data[src_iter.offset];
-            inc_iter(input.layout, &src_iter);
-            inc_iter(output->layout, &dst_iter);
-        }
-    } else {
+    //! do dimshuffle
+    if (copy_tensor_data(
+                output->ptr, output->layout, input.ptr, input.layout,
+                dtype_length(input.dtype.type_enum, NULL)) != TinyNN_SUCCESS) {
         LOG_ERROR("unsupport dtype in dimshuffle.\n");
         return TinyNN_ERROR_UNSUPPORTED_DTYPE_TYPE;
     }
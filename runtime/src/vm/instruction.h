@@ -106,6 +106,8 @@ typedef struct {
 typedef struct {
     Tensor* inputs[2];
     Tensor* output;
+    //! the output is a stride 0 view of inputs[0] which owns the memory
+    int as_view;
 } BroadCast;
 
 typedef struct {
@@ -152,6 +154,8 @@ typedef struct {
     int32_t nr_input;
     Tensor** inputs;
     Tensor* output;
+    //! the output takes over the memory of inputs[0] which dies here
+    int in_place;
 } SetSubTensor;
 
 typedef struct {
@@ -145,38 +145,9 @@ static TinyNNStatus execute_subtensor(Instruction* inst, VM* vm) {
     TINYNN_ASSERT_MSG(output->is_dynamic, "Subtensor output tensor should be dynamic.");
     alloc_tensor(output, vm);
     //! do subtensor
-    size_t nr_elem = 1;
-    for (int i = 0; i < output->layout.nr_dim; ++i) {
-        nr_elem *= output->layout.dims[i];
-    }
-
-    NoconIter src_iter = init_iter(input_copy.layout);
-    NoconIter dst_iter = init_iter(output->layout);
-    if (dtype_length((input_copy).dtype.type_enum, NULL) == 1) {
-        char* dst_data = output->ptr;
-        char* src_data = input_copy.ptr;
-        for (size_t i = 0; i < nr_elem; ++i) {
-            dst_data[dst_iter.offset] = src_data[src_iter.offset];
-            inc_iter(input_copy.layout, &src_iter);
-            inc_iter(output->layout, &dst_iter);
-        }
-    } else if (dtype_length((input_copy).dtype.type_enum, NULL) == 2) {
-        int16_t* dst_data = output->ptr;
-        int16_t* src_data = input_copy.ptr;
-        for (size_t i = 0; i < nr_elem; ++i) {
-            dst_data[dst_iter.offset] = src_data[src_iter.offset];
-            inc_iter(input_copy.layout, &src_iter);
-            inc_iter(output->layout, &dst_iter);
-        }
-    } else if (dtype_length((input_copy).dtype.type_enum, NULL) == 4) {
-        int32_t* dst_data = output->ptr;
-        int32_t* src_data = input_copy.ptr;
-        for (size_t i = 0; i < nr_elem; ++i) {
-            dst_data[dst_iter.offset] = src_data[src_iter.offset];
-            inc_iter(input_copy.layout, &src_iter);
-            inc_iter(output->layout, &dst_iter);
-        }
-    } else {
+    if (copy_tensor_data(
+                output->ptr, output->layout, input_copy.ptr, input_copy.layout,
+                dtype_length(input_copy.dtype.type_enum, NULL)) != TinyNN_SUCCESS) {
         LOG_ERROR("unsupport dtype in subtensor.\n");
         return TinyNN_ERROR_UNSUPPORTED_DTYPE_TYPE;
     }
@@ -225,6 +196,7 @@ static TinyNNStatus load_setsubtensor(
 
     int32_t output_idx = ns(SetSubTensor_output(fbs_set_subtensor));
     set_subtensor->output = model->tensors + output_idx;
+    set_subtensor->in_place = ns(SetSubTensor_in_place(fbs_set_subtensor));
 
     ns(IndexDesc_vec_t) fbs_descs = ns(SetSubTensor_descs(fbs_set_subtensor));
     ns(IndexDesc_vec_t) fbs_flags = ns(SetSubTensor_flags(fbs_set_subtensor));
@@ -247,56 +219,35 @@ static TinyNNStatus execute_setsubtensor(Instruction* inst, VM* vm) {
     Tensor* value = inputs[1];
     const int elem_bytes = dtype_length(value->dtype.type_enum, NULL);
     output->layout = inputs[0]->layout;
-    //! alloc output
     size_t length_in_byte = tensor_length_in_byte(src);
-    alloc_tensor(output, vm);
-    //! if src_len == value_len and contig, fast forward
     bool is_src_contig = is_contiguous(src->layout);
     bool is_value_contig = is_contiguous(value->layout);
     size_t length_of_value = tensor_length_in_byte(value);
+    if (set_subtensor->in_place) {
+        //! src dies here, the output takes over its memory and only the slice
+        //! is written
+        TINYNN_ASSERT_MSG(is_src_contig, "in place setsubtensor src must be contig.");
+        output->ptr = src->ptr;
+    } else {
+        alloc_tensor(output, vm);
+    }
+    //! if src_len == value_len and contig, fast forward
     if (is_src_contig && is_value_contig && length_of_value == length_in_byte) {
         memcpy(output->ptr, value->ptr, length_of_value);
         return TinyNN_SUCCESS;
     }
     //! copy all memory to dst
-    memcpy(output->ptr, src->ptr, length_in_byte);
+    if (!set_subtensor->in_place) {
+        memcpy(output->ptr, src->ptr, length_in_byte);
+    }
     //! deduce output shape, and modify the input stride
     uint32_t offset = update_layout(
             inputs, output, &dymmy_src, set_subtensor->descs, set_subtensor->flags,
             set_subtensor->nr_descs);
     //! do set_subtensor
-    size_t nr_elem = 1;
-    for (int i = 0; i < output->layout.nr_dim; ++i) {
-        nr_elem *= output->layout.dims[i];
-    }
-
-    NoconIter src_iter = init_iter(value->layout);
-    NoconIter dst_iter = init_iter(output->layout);
-    if (elem_bytes == 1) {
-        char* dst_data = output->ptr;
-        char* src_data = value->ptr;
-        for (size_t i = 0; i < nr_elem; ++i) {
-            dst_data[dst_iter.offset] = src_data[src_iter.offset];
-            inc_iter(value->layout, &src_iter);
-            inc_iter(output->layout, &dst_iter);
-        }
-    } else if (elem_bytes == 2) {
-        int16_t* dst_data = output->ptr;
-        int16_t* src_data = value->ptr;
-        for (size_t i = 0; i < nr_elem; ++i) {
-            dst_data[dst_iter.offset] = src_data[src_iter.offset];
-            inc_iter(value->layout, &src_iter);
-            inc_iter(output->layout, &dst_iter);
-        }
-    } else if (elem_bytes == 4) {
-        int32_t* dst_data = output->ptr;
-        int32_t* src_data = value->ptr;
-        for (size_t i = 0; i < nr_elem; ++i) {
-            dst_data[dst_iter.offset] = src_data[src_iter.offset];
-            inc_iter(value->layout, &src_iter);
-            inc_iter(output->layout, &dst_iter);
-        }
-    } else {
+    if (copy_tensor_data(
+                output->ptr, output->layout, value->ptr, value->layout, elem_bytes) !=
+        TinyNN_SUCCESS) {
         LOG_ERROR("unsupport dtype in set_subtensor.\n");
         return TinyNN_ERROR_UNSUPPORTED_DTYPE_TYPE;
     }
@@ -313,7 +264,9 @@ static TinyNNStatus destruct_setsubtensor(VM* vm, Instruction* inst) {
     FREE(inst->workload.set_subtensor.inputs);
     FREE(inst->workload.set_subtensor.descs);
     FREE(inst->workload.set_subtensor.flags);
-    if (inst->workload.set_subtensor.output->is_dynamic) {
+    //! the memory of an in place output is owned by the src
+    if (inst->workload.set_subtensor.output->is_dynamic &&
+        !inst->workload.set_subtensor.in_place) {
         DEV_FREE(inst->workload.set_subtensor.output->ptr, vm);
     }
     return TinyNN_SUCCESS;
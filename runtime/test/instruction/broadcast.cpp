@@ -30,9 +30,10 @@ TEST(INSTRUCTION, BroadCast) {
     VM* vm = create_vm();
     auto test_broadcast = [&](std::vector<Tensor*> inputs, const Tensor& expect) {
         auto broadcast = create_broadcast(inputs);
-        Instruction inst;
+        Instruction inst{};
         inst.tag = TinyNN_INST_BROADCAST;
         inst.workload.broadcast = *broadcast;
+        inst.workload.broadcast.as_view = 0;
         vm_instruction_call(vm, &inst);
         check_tensor(*broadcast->output, expect);
         vm->model->host_dev.free(broadcast->output->ptr);
@@ -81,4 +82,39 @@ TEST(INSTRUCTION, BroadCast) {
     test_case({1, 10, 1}, {5, 10, 34});
 }
 
+TEST(INSTRUCTION, BroadCastView) {
+    std::vector<int> data0(34);
+    for (size_t i = 0; i < data0.size(); i++) {
+        data0[i] = i;
+    }
+    std::vector<int> shape{10, 34};
+    auto src0 = create_tensor({1, 34}, TinyNNDType::TinyNN_INT, data0.data());
+    auto src1 = create_tensor({2}, TinyNNDType::TinyNN_INT, shape.data());
+    Tensor output{};
+    output.is_dynamic = true;
+
+    Instruction inst{};
+    inst.tag = TinyNN_INST_BROADCAST;
+    inst.workload.broadcast.inputs[0] = src0.get();
+    inst.workload.broadcast.inputs[1] = src1.get();
+    inst.workload.broadcast.output = &output;
+    inst.workload.broadcast.as_view = 1;
+    VM* vm = create_vm();
+    vm_instruction_call(vm, &inst);
+
+    //! the output shares the input memory with stride 0 on the broadcast dim
+    ASSERT_EQ(output.ptr, src0->ptr);
+    ASSERT_EQ(output.layout.nr_dim, 2);
+    ASSERT_EQ(output.layout.dims[0], 10);
+    ASSERT_EQ(output.layout.dims[1], 34);
+    ASSERT_EQ(output.layout.stride[0], 0);
+    ASSERT_EQ(output.layout.stride[1], 1);
+    NoconIter iter = init_iter(output.layout);
+    const int* ptr = static_cast<const int*>(output.ptr);
+    for (int i = 0; i < 10 * 34; ++i) {
+        ASSERT_EQ(ptr[iter.offset], i % 34);
+        inc_iter(output.layout, &iter);
+    }
+}
+
 // vim: syntax=cpp.doxygen
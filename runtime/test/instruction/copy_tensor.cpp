@@ -0,0 +1,75 @@
+#include <string.h>
+#include <vector>
+#include "./common/common.h"
+using namespace test;
+
+namespace {
+Layout make_layout(std::vector<int> dims, std::vector<int> stride) {
+    Layout layout{};
+    layout.nr_dim = dims.size();
+    for (size_t i = 0; i < dims.size(); ++i) {
+        layout.dims[i] = dims[i];
+        layout.stride[i] = stride[i];
+    }
+    return layout;
+}
+
+Layout contiguous_layout(std::vector<int> dims) {
+    std::vector<int> stride(dims.size(), 1);
+    for (int i = (int)dims.size() - 2; i >= 0; --i) {
+        stride[i] = stride[i + 1] * dims[i + 1];
+    }
+    return make_layout(dims, stride);
+}
+
+//! copy src to a contiguous dst and check it against the element by element
+//! copy through the layouts
+template <typename T>
+void run_copy(Layout src_layout, size_t src_len) {
+    std::vector<T> src(src_len);
+    for (size_t i = 0; i < src_len; ++i) {
+        src[i] = static_cast<T>(i * 7 + 3);
+    }
+    std::vector<int> dims(src_layout.dims, src_layout.dims + src_layout.nr_dim);
+    Layout dst_layout = contiguous_layout(dims);
+    size_t nr_elem = 1;
+    for (auto dim : dims) {
+        nr_elem *= dim;
+    }
+    std::vector<T> dst(nr_elem), expect(nr_elem);
+    NoconIter iter = init_iter(src_layout);
+    for (size_t i = 0; i < nr_elem; ++i) {
+        expect[i] = src[iter.offset];
+        inc_iter(src_layout, &iter);
+    }
+    ASSERT_EQ(
+            copy_tensor_data(
+                    dst.data(), dst_layout, src.data(), src_layout, sizeof(T)),
+            TinyNN_SUCCESS);
+    ASSERT_EQ(dst, expect);
+}
+}  // namespace
+
+TEST(INSTRUCTION, CopyTensorData) {
+    //! contiguous, one memcpy
+    run_copy<float>(contiguous_layout({2, 3, 5}), 30);
+    //! the outer dim is padded, the inner two dims are merged into runs
+    run_copy<float>(make_layout({4, 3, 5}, {20, 5, 1}), 80);
+    //! the last dim is strided, no run, element by element
+    run_copy<int16_t>(make_layout({4, 3, 5}, {30, 10, 2}), 120);
+    //! transposed
+    run_copy<int32_t>(make_layout({5, 4}, {1, 5}), 20);
+    //! broadcast outer dim with stride 0
+    run_copy<int8_t>(make_layout({3, 4}, {0, 1}), 4);
+    //! size 1 dims with arbitrary stride are dropped
+    run_copy<float>(make_layout({1, 3, 1, 4}, {100, 8, 100, 1}), 24);
+    //! element size without the typed copy
+    std::vector<double> src(8), dst(4);
+    ASSERT_EQ(
+            copy_tensor_data(
+                    dst.data(), contiguous_layout({4}), src.data(),
+                    make_layout({4}, {2}), sizeof(double)),
+            TinyNN_ERROR_UNSUPPORTED_DTYPE_TYPE);
+}
+
+// vim: syntax=cpp.doxygen
@@ -68,9 +68,10 @@ TEST(INSTRUCTION, SetSubTensorTest) {
                               const Tensor& expect,
                               std::vector<uint32_t> input_idx = {}) {
         auto subtensor = create_setsubtensor(value, index, flag, input_idx);
-        Instruction inst;
+        Instruction inst{};
         inst.tag = TinyNN_INST_SETSUBTENSOR;
         inst.workload.subtensor = *subtensor;
+        inst.workload.set_subtensor.in_place = 0;
         vm_instruction_call(vm, &inst);
         check_tensor(*subtensor->output, expect);
         vm->model->host_dev.free(subtensor->output->ptr);
@@ -161,4 +162,46 @@ TEST(INSTRUCTION, SetSubTensorTest) {
     }
 }
 
+TEST(INSTRUCTION, SetSubTensorInPlace) {
+    //! src shape = [4, 6, 5], set [:, 1:4] of it
+    std::vector<float> data(4 * 6 * 5), expect(4 * 6 * 5), v(4 * 3 * 5);
+    for (size_t i = 0; i < data.size(); i++) {
+        data[i] = i;
+        expect[i] = i;
+    }
+    for (size_t i = 0; i < 4; i++) {
+        for (size_t j = 1; j < 4; j++) {
+            for (size_t k = 0; k < 5; k++) {
+                v[i * 3 * 5 + (j - 1) * 5 + k] = -1.f * (i * 100 + j * 10 + k);
+                expect[i * 6 * 5 + j * 5 + k] = -1.f * (i * 100 + j * 10 + k);
+            }
+        }
+    }
+    auto src = create_tensor({4, 6, 5}, TinyNN_FLOAT, data.data());
+    auto value = create_tensor({4, 3, 5}, TinyNN_FLOAT, v.data());
+    auto expect_tensor = create_tensor({4, 6, 5}, TinyNN_FLOAT, expect.data());
+    std::vector<Tensor*> inputs{src.get(), value.get()};
+    IndexDesc index{1, 1, 4, 1, -1}, flag{0, 0, 0, 0, -1};
+    Tensor output{};
+    output.is_dynamic = true;
+    output.dtype = src->dtype;
+
+    Instruction inst{};
+    inst.tag = TinyNN_INST_SETSUBTENSOR;
+    SetSubTensor& set_subtensor = inst.workload.set_subtensor;
+    set_subtensor.nr_descs = 1;
+    set_subtensor.descs = &index;
+    set_subtensor.flags = &flag;
+    set_subtensor.nr_input = inputs.size();
+    set_subtensor.inputs = inputs.data();
+    set_subtensor.output = &output;
+    set_subtensor.in_place = 1;
+    VM* vm = create_vm();
+    vm_instruction_call(vm, &inst);
+
+    //! the output takes over the src memory, only the slice is written
+    ASSERT_EQ(output.ptr, src->ptr);
+    check_tensor(output, *expect_tensor);
+}
+
 // vim: syntax=cpp.doxygen